@@ -0,0 +1,152 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/IndexTestHelpers.h"
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "index/ConstantsIndexBuilding.h"
+#include "parser/SparqlParser.h"
+#include "util/Exception.h"
+
+namespace ad_benchmark {
+
+// Measure the quality of the size estimates of the query planner on a
+// synthetic knowledge graph with skewed (Zipf-like) distributions, once with
+// the column statistics (histograms and distinct-value sketches) and once
+// with only the multiplicities of the relations. The quality is measured as
+// the q-error `max(estimate / actual, actual / estimate)` of the size
+// estimate of the complete query.
+class CardinalityEstimationBenchmark : public BenchmarkInterface {
+  size_t numEntities_;
+
+ public:
+  CardinalityEstimationBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-entities",
+                      "The number of entities of the knowledge graph.",
+                      &numEntities_, size_t{20'000});
+  }
+
+  std::string name() const final {
+    return "Q-errors of the size estimates with and without column statistics";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    // Also compute the statistics for the smaller relations of the benchmark.
+    COLUMN_STATISTICS_MIN_NUM_ROWS = 1'000;
+    // Only measure the estimates, not the sizes that were observed when
+    // computing the actual sizes of the previous queries.
+    RuntimeParameters().set<"use-observed-sizes">(false);
+    using namespace ad_utility::memory_literals;
+    auto* qec = ad_utility::testing::getQec(createTurtle(), true, true, true,
+                                            1_MB);
+
+    const std::vector<std::string> queries{
+        "SELECT * WHERE { ?x <age> ?a FILTER(?a < 10) }",
+        "SELECT * WHERE { ?x <age> ?a FILTER(?a >= 60) }",
+        "SELECT * WHERE { ?x <age> ?a FILTER(?a = 3) }",
+        "SELECT * WHERE { ?x <age> ?a FILTER(?a != 0) }",
+        "SELECT * WHERE { ?x <knows> ?y . ?y <knows> ?z }",
+        "SELECT * WHERE { ?x <knows> ?y . ?y <age> ?a }",
+        "SELECT * WHERE { ?x <knows> ?y . ?y <member> ?c }",
+        "SELECT * WHERE { ?x <member> ?c . ?x <age> ?a }"};
+    auto& table = results.addTable(
+        "Size estimates", queries,
+        {"Query", "Actual size", "Estimate (multiplicities)",
+         "Q-error (multiplicities)", "Estimate (statistics)",
+         "Q-error (statistics)"});
+
+    std::vector<double> qErrorsWithout;
+    std::vector<double> qErrorsWith;
+    for (size_t row = 0; row < queries.size(); ++row) {
+      auto estimate = [&](bool useStatistics) {
+        RuntimeParameters().set<"use-column-statistics">(useStatistics);
+        // A cached result would replace the estimate by the actual size.
+        qec->clearCacheUnpinnedOnly();
+        ParsedQuery pq = SparqlParser::parseQuery(queries[row]);
+        return QueryPlanner{qec}.createExecutionTree(pq).getSizeEstimate();
+      };
+      size_t estimateWithout = estimate(false);
+      size_t estimateWith = estimate(true);
+      ParsedQuery pq = SparqlParser::parseQuery(queries[row]);
+      size_t actual =
+          QueryPlanner{qec}.createExecutionTree(pq).getResult()->size();
+      qErrorsWithout.push_back(qError(estimateWithout, actual));
+      qErrorsWith.push_back(qError(estimateWith, actual));
+      table.setEntry(row, 1, actual);
+      table.setEntry(row, 2, estimateWithout);
+      table.setEntry(row, 3, static_cast<float>(qErrorsWithout.back()));
+      table.setEntry(row, 4, estimateWith);
+      table.setEntry(row, 5, static_cast<float>(qErrorsWith.back()));
+    }
+    RuntimeParameters().set<"use-column-statistics">(true);
+    table.metadata().addKeyValuePair("num-entities", numEntities_);
+    table.metadata().addKeyValuePair("median-q-error-multiplicities",
+                                     median(qErrorsWithout));
+    table.metadata().addKeyValuePair("max-q-error-multiplicities",
+                                     std::ranges::max(qErrorsWithout));
+    table.metadata().addKeyValuePair("median-q-error-statistics",
+                                     median(qErrorsWith));
+    table.metadata().addKeyValuePair("max-q-error-statistics",
+                                     std::ranges::max(qErrorsWith));
+    return results;
+  }
+
+ private:
+  static double qError(size_t estimate, size_t actual) {
+    double e = static_cast<double>(std::max(estimate, size_t{1}));
+    double a = static_cast<double>(std::max(actual, size_t{1}));
+    return std::max(e / a, a / e);
+  }
+
+  static double median(std::vector<double> values) {
+    AD_CONTRACT_CHECK(!values.empty());
+    std::ranges::sort(values);
+    return values[values.size() / 2];
+  }
+
+  // Create a knowledge graph with `numEntities_` entities, each of which
+  // has an age (most ages are small), knows three other entities (a few of
+  // which are known by very many), and, for every fourth entity, is a member
+  // of one of a few hundred groups (the sizes of which are skewed, too).
+  std::string createTurtle() const {
+    std::mt19937_64 randomEngine{42};
+    auto zipf = [](size_t n) {
+      std::vector<double> weights;
+      for (size_t i = 0; i < n; ++i) {
+        weights.push_back(1.0 / static_cast<double>(i + 1));
+      }
+      return std::discrete_distribution<size_t>{weights.begin(),
+                                                weights.end()};
+    };
+    auto age = zipf(100);
+    auto entity = zipf(numEntities_);
+    auto group = zipf(300);
+    std::string turtle;
+    for (size_t i = 0; i < numEntities_; ++i) {
+      auto subject = absl::StrCat("<e", i, ">");
+      absl::StrAppend(&turtle, subject, " <age> ", age(randomEngine), " .\n");
+      for (size_t j = 0; j < 3; ++j) {
+        absl::StrAppend(&turtle, subject, " <knows> <e", entity(randomEngine),
+                        "> .\n");
+      }
+      if (i % 4 == 0) {
+        absl::StrAppend(&turtle, subject, " <member> <g", group(randomEngine),
+                        "> .\n");
+      }
+    }
+    return turtle;
+  }
+};
+
+AD_REGISTER_BENCHMARK(CardinalityEstimationBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,114 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/IndexTestHelpers.h"
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "parser/SparqlParser.h"
+#include "util/Exception.h"
+
+namespace ad_benchmark {
+
+// Measure the time of geographic filters (distance, latitude and longitude) on
+// a synthetic knowledge graph of points, once with the restriction of the
+// index scans to the bounding box of the filter (see
+// `Filter::restrictScanToGeoBoundingBox`) and once without it. The points are
+// clustered around a few cities, s.t. the filters around a city are selective
+// but not empty.
+class GeoFilterBenchmark : public BenchmarkInterface {
+  size_t numPoints_;
+
+ public:
+  GeoFilterBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-points", "The number of points of the graph.",
+                      &numPoints_, size_t{200'000});
+  }
+
+  std::string name() const final {
+    return "Geographic filters with and without the bounding box restriction";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    using namespace ad_utility::memory_literals;
+    auto* qec = ad_utility::testing::getQec(createTurtle(), true, true, true,
+                                            16_kB);
+
+    const std::string prefixes = absl::StrCat(
+        "PREFIX geof: ", GEOF_PREFIX.second,
+        "> PREFIX geo: <http://www.opengis.net/ont/geosparql#> ");
+    const std::vector<std::string> filters{
+        "geof:distance(?p, \"POINT(7.85 47.99)\"^^geo:wktLiteral) <= 10",
+        "geof:distance(?p, \"POINT(7.85 47.99)\"^^geo:wktLiteral) <= 200",
+        "geof:distance(\"POINT(-73.98 40.75)\"^^geo:wktLiteral, ?p) < 50",
+        "geof:latitude(?p) > 47 && geof:latitude(?p) < 49 && "
+        "geof:longitude(?p) > 7 && geof:longitude(?p) < 9",
+        "geof:latitude(?p) >= 60"};
+    auto& table = results.addTable(
+        "Filters on all points", filters,
+        {"Filter", "Result size", "Full scan (s)", "Bounding box (s)"});
+    for (size_t row = 0; row < filters.size(); ++row) {
+      const std::string query = absl::StrCat(
+          prefixes, "SELECT ?x ?p WHERE { ?x <location> ?p FILTER(",
+          filters[row], ") }");
+      auto run = [&](size_t maxNumRanges) {
+        RuntimeParameters().set<"geo-filter-max-num-ranges">(maxNumRanges);
+        // The results of the scans and filters must not be reused.
+        qec->clearCacheUnpinnedOnly();
+        ParsedQuery pq = SparqlParser::parseQuery(query);
+        return QueryPlanner{qec}.createExecutionTree(pq).getResult()->size();
+      };
+      size_t sizeFullScan = 0;
+      size_t size = 0;
+      table.addMeasurement(row, 2, [&]() { sizeFullScan = run(0); });
+      table.addMeasurement(row, 3, [&]() { size = run(64); });
+      AD_CORRECTNESS_CHECK(size == sizeFullScan);
+      table.setEntry(row, 1, size);
+    }
+    RuntimeParameters().set<"geo-filter-max-num-ranges">(64);
+    table.metadata().addKeyValuePair("num-points", numPoints_);
+    return results;
+  }
+
+ private:
+  // Create `numPoints_` subjects with a location each, most of which are
+  // normally distributed around a few cities and the rest of which are
+  // distributed uniformly over the map.
+  std::string createTurtle() const {
+    std::mt19937_64 randomEngine{42};
+    const std::vector<std::pair<double, double>> cities{
+        {47.99, 7.85}, {52.52, 13.40}, {40.75, -73.98}, {35.68, 139.69},
+        {-33.87, 151.21}};
+    std::normal_distribution<double> offset{0.0, 1.0};
+    std::uniform_real_distribution<double> lat{-90.0, 90.0};
+    std::uniform_real_distribution<double> lng{-180.0, 180.0};
+    std::string turtle;
+    for (size_t i = 0; i < numPoints_; ++i) {
+      double pointLat;
+      double pointLng;
+      if (i % 10 == 0) {
+        pointLat = lat(randomEngine);
+        pointLng = lng(randomEngine);
+      } else {
+        auto [cityLat, cityLng] = cities[randomEngine() % cities.size()];
+        pointLat = std::clamp(cityLat + offset(randomEngine), -90.0, 90.0);
+        pointLng = std::clamp(cityLng + offset(randomEngine), -180.0, 180.0);
+      }
+      absl::StrAppend(&turtle, "<x", i, "> <location> \"POINT(", pointLng, " ",
+                      pointLat, ")\"^^<", GEO_WKT_LITERAL, "> .\n");
+    }
+    return turtle;
+  }
+};
+
+AD_REGISTER_BENCHMARK(GeoFilterBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,326 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/IndexTestHelpers.h"
+#include "engine/CallFixedSize.h"
+#include "engine/Join.h"
+#include "engine/Minus.h"
+#include "engine/MultiColumnJoin.h"
+#include "engine/OptionalJoin.h"
+#include "engine/idTable/IdTable.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/Exception.h"
+#include "util/JoinAlgorithms/FindUndefRanges.h"
+#include "util/JoinAlgorithms/JoinAlgorithms.h"
+
+namespace ad_benchmark {
+
+// Measure the join kernels of `util/JoinAlgorithms/JoinAlgorithms.h` and the
+// join operations that are built on top of them (`Join`, `MultiColumnJoin`,
+// `OptionalJoin`, `Minus`) on generated inputs. The first table varies the
+// ratio of the sizes of the two inputs (which is what the choice between the
+// zipper and the galloping join in `Join::join` and `OptionalJoin` depends on,
+// see `GALLOP_THRESHOLD`), the second table varies the density of UNDEF
+// values in the left input. The distribution of the join values (uniform or
+// Zipf), the number of columns, and the block size of the block-wise join are
+// configurable.
+class JoinAlgorithmsBenchmark : public BenchmarkInterface {
+  size_t smallerSize_;
+  std::vector<size_t> sizeRatios_;
+  float skew_;
+  size_t numColumns_;
+  size_t blockSize_;
+  size_t undefInputSize_;
+  std::vector<float> undefDensities_;
+
+  using JoinColumns = std::vector<std::array<ColumnIndex, 2>>;
+
+ public:
+  JoinAlgorithmsBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("smaller-size",
+                      "The number of rows of the smaller input when varying "
+                      "the size ratio.",
+                      &smallerSize_, size_t{1'000});
+    manager.addOption("size-ratios",
+                      "The ratios of the size of the larger input to the size "
+                      "of the smaller input.",
+                      &sizeRatios_,
+                      std::vector<size_t>{1, 4, 16, 64, 256, 1024, 4096});
+    manager.addOption("skew",
+                      "The exponent of the Zipf distribution of the join "
+                      "values. 0 means uniformly distributed.",
+                      &skew_, 0.0f);
+    manager.addOption("num-columns",
+                      "The number of columns of each input (at least 2).",
+                      &numColumns_, size_t{3});
+    manager.addOption("block-size",
+                      "The number of rows per block for the block-wise zipper "
+                      "join.",
+                      &blockSize_, size_t{10'000});
+    manager.addOption("undef-input-size",
+                      "The number of rows of both inputs when varying the "
+                      "density of UNDEF values.",
+                      &undefInputSize_, size_t{100'000});
+    manager.addOption("undef-densities",
+                      "The fractions of UNDEF values in the last join column "
+                      "of the left input.",
+                      &undefDensities_,
+                      std::vector<float>{0.0f, 0.001f, 0.01f, 0.1f, 0.5f});
+  }
+
+  std::string name() const final {
+    return "Join algorithms for different size ratios and UNDEF densities";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    AD_CONTRACT_CHECK(numColumns_ >= 2 && smallerSize_ > 0 && blockSize_ > 0);
+    BenchmarkResults results{};
+    measureSizeRatios(results);
+    measureUndefDensities(results);
+    return results;
+  }
+
+ private:
+  // A block for `zipperJoinForBlocksWithoutUndef` that refers to a part of a
+  // column without owning it (the join algorithm requires the nested iterator
+  // types, which `std::span` doesn't have in C++20).
+  struct IdBlock {
+    std::span<const Id> ids_;
+    using iterator = std::span<const Id>::iterator;
+    using const_iterator = iterator;
+    iterator begin() const { return ids_.begin(); }
+    iterator end() const { return ids_.end(); }
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+    const Id& operator[](size_t i) const { return ids_[i]; }
+  };
+
+  // The `compatibleRowAction` for `zipperJoinForBlocksWithoutUndef`, which
+  // only counts the result rows.
+  struct CountingRowAdder {
+    size_t numRows_ = 0;
+    void setInput(const IdBlock&, const IdBlock&) {}
+    void addRow(size_t, size_t) { ++numRows_; }
+    void flush() {}
+  };
+
+  // Create an input with `numRows` rows and `numColumns_` columns, which is
+  // sorted by its first `numJoinColumns` (1 or 2) columns. The values of the
+  // first column are drawn from `[0, numDistinct)` according to the
+  // configured skew, the values of the second join column from `[0, 4)`, and
+  // the second join column is UNDEF with probability `undefDensity`. All
+  // other columns contain random values.
+  IdTable makeInput(size_t numRows, size_t numJoinColumns, size_t numDistinct,
+                    float undefDensity, std::mt19937_64& randomEngine) const {
+    std::vector<double> weights;
+    weights.reserve(numDistinct);
+    for (size_t i = 0; i < numDistinct; ++i) {
+      weights.push_back(1.0 / std::pow(static_cast<double>(i + 1), skew_));
+    }
+    std::discrete_distribution<size_t> firstValue{weights.begin(),
+                                                  weights.end()};
+    std::uniform_int_distribution<size_t> secondValue{0, 3};
+    std::bernoulli_distribution isUndef{undefDensity};
+    std::uniform_int_distribution<size_t> otherValue{0, 1'000'000};
+    auto makeId = [](size_t i) {
+      return Id::makeFromVocabIndex(VocabIndex::make(i));
+    };
+
+    std::vector<std::array<Id, 2>> joinValues;
+    joinValues.reserve(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+      Id second = numJoinColumns == 1 || isUndef(randomEngine)
+                      ? Id::makeUndefined()
+                      : makeId(secondValue(randomEngine));
+      joinValues.push_back({makeId(firstValue(randomEngine)), second});
+    }
+    // UNDEF is the smallest `Id`, so this is the order that the join
+    // algorithms expect.
+    std::ranges::sort(joinValues);
+
+    IdTable result{numColumns_, ad_utility::makeUnlimitedAllocator<Id>()};
+    result.resize(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+      for (size_t col = 0; col < numColumns_; ++col) {
+        result(i, col) = col < numJoinColumns
+                             ? joinValues[i][col]
+                             : makeId(otherValue(randomEngine));
+      }
+    }
+    return result;
+  }
+
+  // Split the `column` into blocks of `blockSize_` rows.
+  std::vector<IdBlock> makeBlocks(std::span<const Id> column) const {
+    std::vector<IdBlock> blocks;
+    for (size_t i = 0; i < column.size(); i += blockSize_) {
+      blocks.push_back(
+          IdBlock{column.subspan(i, std::min(blockSize_, column.size() - i))});
+    }
+    return blocks;
+  }
+
+  // Measure the operations on `left` and `right`, which are joined on the
+  // `joinColumns`, and write the times to the `row` of the `table`, starting
+  // at `firstColumn` in the order `MultiColumnJoin`, `OptionalJoin`, `Minus`.
+  static void measureOperations(ResultTable& table, size_t row,
+                                size_t firstColumn, const IdTable& left,
+                                const IdTable& right,
+                                const JoinColumns& joinColumns) {
+    auto allocator = ad_utility::makeUnlimitedAllocator<Id>();
+    size_t resultWidth =
+        left.numColumns() + right.numColumns() - joinColumns.size();
+    table.addMeasurement(row, firstColumn, [&]() {
+      IdTable result{resultWidth, allocator};
+      MultiColumnJoin::computeMultiColumnJoin(left, right, joinColumns,
+                                              &result);
+    });
+    table.addMeasurement(row, firstColumn + 1, [&]() {
+      IdTable result{resultWidth, allocator};
+      OptionalJoin::optionalJoin(left, right, joinColumns, &result);
+    });
+    table.addMeasurement(row, firstColumn + 2, [&]() {
+      IdTable result{left.numColumns(), allocator};
+      Minus minus{Minus::OnlyForTestingTag{}};
+      int leftWidth = static_cast<int>(left.numColumns());
+      int rightWidth = static_cast<int>(right.numColumns());
+      CALL_FIXED_SIZE((std::array{leftWidth, rightWidth}),
+                      &Minus::computeMinus, minus, left, right, joinColumns,
+                      &result);
+    });
+  }
+
+  // The joins of inputs with a single join column and without UNDEF values,
+  // for each of the `sizeRatios_`.
+  void measureSizeRatios(BenchmarkResults& results) const {
+    std::vector<std::string> rowNames;
+    for (size_t ratio : sizeRatios_) {
+      rowNames.push_back(absl::StrCat("1:", ratio));
+    }
+    auto& table = results.addTable(
+        "Size ratios", rowNames,
+        {"Larger / smaller size", "Result size", "zipperJoinWithUndef",
+         "gallopingJoin", "zipperJoinForBlocksWithoutUndef", "Join::join",
+         "MultiColumnJoin", "OptionalJoin", "Minus"});
+    Join join{Join::InvalidOnlyForTestingJoinTag{},
+              ad_utility::testing::getQec()};
+    std::mt19937_64 randomEngine{42};
+    for (size_t row = 0; row < sizeRatios_.size(); ++row) {
+      size_t largerSize = smallerSize_ * sizeRatios_[row];
+      // On average, each value occurs once in the larger input.
+      IdTable left = makeInput(smallerSize_, 1, largerSize, 0, randomEngine);
+      IdTable right = makeInput(largerSize, 1, largerSize, 0, randomEngine);
+      std::span<const Id> leftColumn = left.getColumn(0);
+      std::span<const Id> rightColumn = right.getColumn(0);
+      // Replace the row name by the ratio as a number.
+      table.setEntry(row, 0, sizeRatios_[row]);
+
+      // The kernels only count the matching pairs of rows.
+      size_t resultSize = 0;
+      table.addMeasurement(row, 2, [&]() {
+        resultSize = 0;
+        [[maybe_unused]] auto numOutOfOrder = ad_utility::zipperJoinWithUndef(
+            leftColumn, rightColumn, std::ranges::less{},
+            [&resultSize](auto, auto) { ++resultSize; }, ad_utility::noop,
+            ad_utility::noop);
+      });
+      table.setEntry(row, 1, resultSize);
+      table.addMeasurement(row, 3, [&]() {
+        size_t numRows = 0;
+        ad_utility::gallopingJoin(leftColumn, rightColumn, std::ranges::less{},
+                                  [&numRows](auto, auto) { ++numRows; });
+        AD_CORRECTNESS_CHECK(numRows == resultSize);
+      });
+      auto leftBlocks = makeBlocks(leftColumn);
+      auto rightBlocks = makeBlocks(rightColumn);
+      table.addMeasurement(row, 4, [&]() {
+        CountingRowAdder adder;
+        ad_utility::zipperJoinForBlocksWithoutUndef(
+            leftBlocks, rightBlocks, std::ranges::less{}, adder);
+        AD_CORRECTNESS_CHECK(adder.numRows_ == resultSize);
+      });
+      table.addMeasurement(row, 5, [&]() {
+        IdTable result{left.numColumns() + right.numColumns() - 1,
+                       ad_utility::makeUnlimitedAllocator<Id>()};
+        join.join(left, 0, right, 0, &result);
+      });
+      measureOperations(table, row, 6, left, right, {{0, 0}});
+    }
+    table.metadata().addKeyValuePair("smaller-size", smallerSize_);
+    table.metadata().addKeyValuePair("skew", skew_);
+    table.metadata().addKeyValuePair("num-columns", numColumns_);
+    table.metadata().addKeyValuePair("block-size", blockSize_);
+    table.metadata().addKeyValuePair("gallop-threshold", GALLOP_THRESHOLD);
+  }
+
+  // The joins of inputs of the same size with two join columns, where the
+  // second join column of the left input contains UNDEF values, for each of
+  // the `undefDensities_`.
+  void measureUndefDensities(BenchmarkResults& results) const {
+    std::vector<std::string> rowNames;
+    for (float density : undefDensities_) {
+      rowNames.push_back(absl::StrCat(density));
+    }
+    auto& table = results.addTable(
+        "UNDEF densities", rowNames,
+        {"UNDEF density", "Result size", "zipperJoinWithUndef",
+         "specialOptionalJoin", "MultiColumnJoin", "OptionalJoin", "Minus"});
+    std::mt19937_64 randomEngine{4242};
+    for (size_t row = 0; row < undefDensities_.size(); ++row) {
+      IdTable left = makeInput(undefInputSize_, 2, undefInputSize_,
+                               undefDensities_[row], randomEngine);
+      IdTable right =
+          makeInput(undefInputSize_, 2, undefInputSize_, 0, randomEngine);
+      std::vector<ColumnIndex> joinColumnIndices{0, 1};
+      IdTableView<0> leftJoinColumns =
+          left.asColumnSubsetView(joinColumnIndices);
+      IdTableView<0> rightJoinColumns =
+          right.asColumnSubsetView(joinColumnIndices);
+      auto findUndef = [](const auto& row, auto begin, auto end,
+                          bool& outOfOrder) {
+        return ad_utility::findSmallerUndefRanges(row, begin, end, outOfOrder);
+      };
+      // Replace the row name by the density as a number.
+      table.setEntry(row, 0, undefDensities_[row]);
+
+      size_t resultSize = 0;
+      table.addMeasurement(row, 2, [&]() {
+        resultSize = 0;
+        [[maybe_unused]] auto numOutOfOrder = ad_utility::zipperJoinWithUndef(
+            leftJoinColumns, rightJoinColumns,
+            std::ranges::lexicographical_compare,
+            [&resultSize](auto, auto) { ++resultSize; }, findUndef, findUndef);
+      });
+      table.setEntry(row, 1, resultSize);
+      // The OPTIONAL join additionally yields the rows from the left without a
+      // match.
+      table.addMeasurement(row, 3, [&]() {
+        size_t numRows = 0;
+        ad_utility::specialOptionalJoin(
+            leftJoinColumns, rightJoinColumns,
+            [&numRows](auto, auto) { ++numRows; },
+            [&numRows](auto) { ++numRows; });
+        AD_CORRECTNESS_CHECK(numRows >= resultSize);
+      });
+      measureOperations(table, row, 4, left, right, {{0, 0}, {1, 1}});
+    }
+    table.metadata().addKeyValuePair("input-size", undefInputSize_);
+    table.metadata().addKeyValuePair("skew", skew_);
+    table.metadata().addKeyValuePair("num-columns", numColumns_);
+  }
+};
+
+AD_REGISTER_BENCHMARK(JoinAlgorithmsBenchmark);
+}  // namespace ad_benchmark
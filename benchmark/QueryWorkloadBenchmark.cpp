@@ -0,0 +1,412 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/strip.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/IndexTestHelpers.h"
+#include "engine/QueryPlanner.h"
+#include "index/Index.h"
+#include "parser/SparqlParser.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/Exception.h"
+#include "util/Timer.h"
+#include "util/jthread.h"
+
+namespace ad_benchmark {
+
+// Replay a suite of SPARQL queries against an index and report the latency
+// percentiles per query and for the complete suite as well as the throughput.
+// Each query is run several times with a "cold" cache and then several times
+// with a warm cache. For the cold runs, only the query result cache is cleared
+// before each run, the page cache of the operating system (which holds the
+// blocks of the permutations and the vocabulary) is not, so the cold runs
+// don't necessarily include the time for reading the index from disk. For the warm runs,
+// the runs can be executed by several threads concurrently to simulate a
+// server under load. The index is either an existing on-disk index, or it
+// is built from a Turtle file (e.g. the `scientists` dataset of the e2e
+// tests), or it is built from a small generated dataset. The query suite is
+// read from a YAML file in the format of `e2e/scientists_queries.yaml`; if no
+// file is given, a built-in suite for the generated dataset is used. The
+// queries that use the text index (`ql:contains-word` or `ql:contains-entity`)
+// are skipped unless the text index of an on-disk index is loaded (the text
+// index of the e2e tests is built from a separate words file, so it can't be
+// built from the Turtle file alone).
+class QueryWorkloadBenchmark : public BenchmarkInterface {
+  std::string indexBasename_;
+  bool useText_;
+  std::string turtleFile_;
+  size_t numEntities_;
+  std::string queryFile_;
+  size_t numColdRuns_;
+  size_t numWarmRuns_;
+  size_t concurrency_;
+
+  struct Query {
+    std::string name_;
+    std::string sparql_;
+  };
+
+  // The latencies of all the runs of a single query, or the error message if
+  // the query failed.
+  struct QueryMeasurements {
+    std::vector<double> latenciesInMs_;
+    size_t numRows_ = 0;
+    std::optional<std::string> error_;
+  };
+
+ public:
+  QueryWorkloadBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("index-basename",
+                      "The basename of an existing index. If empty, an index "
+                      "is built from the `turtle-file`.",
+                      &indexBasename_, std::string{});
+    manager.addOption("use-text",
+                      "Also load the text index of the `index-basename`. "
+                      "Otherwise, the queries that use the text index are "
+                      "skipped.",
+                      &useText_, false);
+    manager.addOption("turtle-file",
+                      "A Turtle file from which a (small) index is built. If "
+                      "empty, a dataset with `num-entities` entities is "
+                      "generated.",
+                      &turtleFile_, std::string{});
+    manager.addOption("num-entities",
+                      "The number of entities of the generated dataset.",
+                      &numEntities_, size_t{10'000});
+    manager.addOption("query-file",
+                      "A YAML file with the queries in the format of the e2e "
+                      "tests. If empty, a built-in suite for the generated "
+                      "dataset is used.",
+                      &queryFile_, std::string{});
+    manager.addOption("num-cold-runs",
+                      "The number of runs of each query with a cold cache.",
+                      &numColdRuns_, size_t{3});
+    manager.addOption("num-warm-runs",
+                      "The number of runs of each query with a warm cache.",
+                      &numWarmRuns_, size_t{10});
+    manager.addOption("concurrency",
+                      "The number of threads that execute the warm runs "
+                      "concurrently.",
+                      &concurrency_, size_t{1});
+  }
+
+  std::string name() const final {
+    return "Latencies and throughput of a query workload";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    AD_CONTRACT_CHECK(concurrency_ > 0);
+    BenchmarkResults results{};
+    auto queries = queryFile_.empty() ? builtInQueries()
+                                      : readQueriesFromYaml(queryFile_);
+    size_t numSkippedTextQueries = 0;
+    if (indexBasename_.empty() || !useText_) {
+      numSkippedTextQueries = std::erase_if(queries, [](const Query& q) {
+        return q.sparql_.find("ql:contains-") != std::string::npos;
+      });
+    }
+    AD_CONTRACT_CHECK(!queries.empty());
+
+    // The `Index` and the cache for an on-disk index. For an index that is
+    // built from Turtle, they are owned by the `QueryExecutionContext` that
+    // is returned by `getQec`.
+    std::optional<Index> index;
+    std::optional<QueryResultCache> cache;
+    std::optional<QueryExecutionContext> loadedQec;
+    QueryExecutionContext* qec = [&]() {
+      if (!indexBasename_.empty()) {
+        index.emplace(ad_utility::makeUnlimitedAllocator<Id>());
+        index->createFromOnDiskIndex(indexBasename_);
+        if (useText_) {
+          index->addTextFromOnDiskIndex();
+        }
+        cache.emplace();
+        return &loadedQec.emplace(*index, &cache.value(),
+                                  ad_utility::makeUnlimitedAllocator<Id>(),
+                                  SortPerformanceEstimator{});
+      }
+      using namespace ad_utility::memory_literals;
+      return ad_utility::testing::getQec(
+          turtleFile_.empty() ? createTurtle() : readFile(turtleFile_), true,
+          true, true, 1_MB);
+    }();
+
+    std::vector<std::string> queryNames;
+    std::ranges::transform(queries, std::back_inserter(queryNames),
+                           &Query::name_);
+
+    // The cold runs. They are executed sequentially, because clearing the
+    // cache would interfere with concurrent queries. Only the query result
+    // cache is cleared (see above).
+    std::vector<QueryMeasurements> cold(queries.size());
+    ad_utility::Timer coldTimer{ad_utility::Timer::Started};
+    for (size_t run = 0; run < numColdRuns_; ++run) {
+      for (size_t i = 0; i < queries.size(); ++i) {
+        qec->clearCacheUnpinnedOnly();
+        runQuery(*qec, queries[i], cold[i]);
+      }
+    }
+    addResultTable(results, "Cold cache", queryNames, cold,
+                   coldTimer.value(), 1)
+        .metadata()
+        .addKeyValuePair("num-skipped-text-queries", numSkippedTextQueries);
+
+    // The warm runs. Each query is run once to fill the cache, then the runs
+    // are distributed among `concurrency_` threads.
+    std::vector<QueryMeasurements> warm(queries.size());
+    std::vector<char> failedInWarmup(queries.size(), false);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      runQuery(*qec, queries[i], warm[i]);
+      failedInWarmup[i] = warm[i].error_.has_value();
+      warm[i].latenciesInMs_.clear();
+    }
+    std::mutex mutex;
+    std::atomic<size_t> nextRun = 0;
+    const size_t numRuns = numWarmRuns_ * queries.size();
+    ad_utility::Timer warmTimer{ad_utility::Timer::Started};
+    {
+      std::vector<ad_utility::JThread> threads;
+      for (size_t t = 0; t < concurrency_; ++t) {
+        threads.emplace_back([&]() {
+          // Each thread has its own context, but they all share the index
+          // and the cache, like the queries that are processed by the server.
+          QueryExecutionContext threadQec{
+              qec->getIndex(), &qec->getQueryTreeCache(), qec->getAllocator(),
+              qec->getSortPerformanceEstimator()};
+          std::vector<QueryMeasurements> local(queries.size());
+          for (size_t run = nextRun++; run < numRuns; run = nextRun++) {
+            size_t i = run % queries.size();
+            if (!failedInWarmup[i]) {
+              runQuery(threadQec, queries[i], local[i]);
+            }
+          }
+          std::lock_guard lock{mutex};
+          for (size_t i = 0; i < queries.size(); ++i) {
+            auto& latencies = warm[i].latenciesInMs_;
+            std::ranges::copy(local[i].latenciesInMs_,
+                              std::back_inserter(latencies));
+            warm[i].numRows_ = std::max(warm[i].numRows_, local[i].numRows_);
+            if (!warm[i].error_.has_value()) {
+              warm[i].error_ = std::move(local[i].error_);
+            }
+          }
+        });
+      }
+    }
+    addResultTable(results,
+                   absl::StrCat("Warm cache, concurrency ", concurrency_),
+                   queryNames, warm, warmTimer.value(), concurrency_)
+        .metadata()
+        .addKeyValuePair("num-skipped-text-queries", numSkippedTextQueries);
+    return results;
+  }
+
+ private:
+  // Parse, plan, and compute the `query` and add the time (in milliseconds)
+  // and the result size to the `measurements`, or the error message if the
+  // query fails.
+  static void runQuery(QueryExecutionContext& qec, const Query& query,
+                       QueryMeasurements& measurements) {
+    try {
+      ad_utility::Timer timer{ad_utility::Timer::Started};
+      ParsedQuery pq = SparqlParser::parseQuery(query.sparql_);
+      QueryPlanner qp{&qec};
+      auto qet = qp.createExecutionTree(pq);
+      size_t numRows = qet.getResult()->size();
+      measurements.latenciesInMs_.push_back(
+          std::chrono::duration<double, std::milli>(timer.value()).count());
+      measurements.numRows_ = numRows;
+    } catch (const std::exception& e) {
+      measurements.error_ = e.what();
+    }
+  }
+
+  // The value at the `percentile` (between 0 and 100) of the `values` by the
+  // nearest-rank method.
+  static float getPercentile(std::vector<double> values, double percentile) {
+    AD_CONTRACT_CHECK(!values.empty());
+    std::ranges::sort(values);
+    auto rank = static_cast<size_t>(std::ceil(
+        percentile / 100.0 * static_cast<double>(values.size())));
+    return static_cast<float>(values[std::max(rank, size_t{1}) - 1]);
+  }
+
+  // Add a table with the latency percentiles (in milliseconds) of each query,
+  // and the percentiles of all the runs and the throughput as metadata. Return
+  // the table.
+  static ResultTable& addResultTable(BenchmarkResults& results,
+                             const std::string& descriptor,
+                             const std::vector<std::string>& queryNames,
+                             const std::vector<QueryMeasurements>& measurements,
+                             ad_utility::Timer::Duration totalTime,
+                             size_t concurrency) {
+    auto& table = results.addTable(
+        descriptor, queryNames,
+        {"Query", "Result rows", "Median (ms)", "p90 (ms)", "p99 (ms)",
+         "Max (ms)"});
+    std::vector<double> allLatencies;
+    size_t numFailedQueries = 0;
+    for (size_t row = 0; row < measurements.size(); ++row) {
+      const auto& m = measurements[row];
+      if (m.error_.has_value() || m.latenciesInMs_.empty()) {
+        ++numFailedQueries;
+        table.setEntry(row, 1, absl::StrCat("failed: ", m.error_.value_or("")));
+        continue;
+      }
+      table.setEntry(row, 1, m.numRows_);
+      table.setEntry(row, 2, getPercentile(m.latenciesInMs_, 50));
+      table.setEntry(row, 3, getPercentile(m.latenciesInMs_, 90));
+      table.setEntry(row, 4, getPercentile(m.latenciesInMs_, 99));
+      table.setEntry(row, 5, getPercentile(m.latenciesInMs_, 100));
+      std::ranges::copy(m.latenciesInMs_, std::back_inserter(allLatencies));
+    }
+    auto& metadata = table.metadata();
+    metadata.addKeyValuePair("concurrency", concurrency);
+    metadata.addKeyValuePair("num-failed-queries", numFailedQueries);
+    metadata.addKeyValuePair("num-runs", allLatencies.size());
+    if (allLatencies.empty()) {
+      return table;
+    }
+    metadata.addKeyValuePair("median-ms", getPercentile(allLatencies, 50));
+    metadata.addKeyValuePair("p90-ms", getPercentile(allLatencies, 90));
+    metadata.addKeyValuePair("p99-ms", getPercentile(allLatencies, 99));
+    metadata.addKeyValuePair("max-ms", getPercentile(allLatencies, 100));
+    double seconds = std::chrono::duration<double>(totalTime).count();
+    metadata.addKeyValuePair(
+        "queries-per-second",
+        static_cast<double>(allLatencies.size()) / std::max(seconds, 1e-9));
+    return table;
+  }
+
+  static std::string readFile(const std::string& filename) {
+    std::ifstream file{filename};
+    if (!file.is_open()) {
+      throw std::runtime_error{absl::StrCat("Could not open file ", filename)};
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return std::move(buffer).str();
+  }
+
+  // Read the name and the SPARQL query of each entry of a query suite in the
+  // YAML format of the e2e tests. Only the subset of YAML that is used there
+  // is supported: Each entry starts with `- query: <name>`, and its `sparql`
+  // key holds either the query itself or a block scalar (`|`) with the query
+  // on the following, more deeply indented, lines. All other keys (e.g. the
+  // `checks`) are ignored.
+  static std::vector<Query> readQueriesFromYaml(const std::string& filename) {
+    std::istringstream input{readFile(filename)};
+    std::vector<Query> queries;
+    std::string line;
+    auto indentation = [](std::string_view s) {
+      return s.find_first_not_of(' ');
+    };
+    // The indentation of the `sparql` key if we are inside its block scalar.
+    std::optional<size_t> sparqlIndentation;
+    while (std::getline(input, line)) {
+      std::string_view view = line;
+      size_t indent = indentation(view);
+      if (sparqlIndentation.has_value()) {
+        if (indent == std::string_view::npos) {
+          absl::StrAppend(&queries.back().sparql_, "\n");
+          continue;
+        }
+        if (indent > sparqlIndentation.value()) {
+          absl::StrAppend(&queries.back().sparql_, view.substr(indent), "\n");
+          continue;
+        }
+        sparqlIndentation.reset();
+      }
+      if (indent == std::string_view::npos) {
+        continue;
+      }
+      view.remove_prefix(indent);
+      if (absl::ConsumePrefix(&view, "- query:")) {
+        queries.push_back(Query{std::string{absl::StripAsciiWhitespace(view)},
+                                std::string{}});
+      } else if (absl::ConsumePrefix(&view, "sparql:") && !queries.empty()) {
+        view = absl::StripAsciiWhitespace(view);
+        if (view.starts_with('|')) {
+          sparqlIndentation = indent;
+        } else {
+          queries.back().sparql_ = std::string{view};
+        }
+      }
+    }
+    std::erase_if(queries, [](const Query& q) { return q.sparql_.empty(); });
+    return queries;
+  }
+
+  // A small suite of typical queries for the generated dataset: scans,
+  // joins, filters, aggregations, and ordering.
+  static std::vector<Query> builtInQueries() {
+    return {
+        {"scientists", "SELECT ?x WHERE { ?x <is-a> <Scientist> }"},
+        {"scientists-with-field",
+         "SELECT ?x ?f WHERE { ?x <is-a> <Scientist> . ?x <field> ?f }"},
+        {"born-before-1900",
+         "SELECT ?x ?y WHERE { ?x <year-of-birth> ?y FILTER(?y < 1900) }"},
+        {"count-per-field",
+         "SELECT ?f (COUNT(?x) AS ?count) WHERE { ?x <field> ?f } "
+         "GROUP BY ?f ORDER BY DESC(?count)"},
+        {"advisors-same-field",
+         "SELECT ?x ?a WHERE { ?x <advisor> ?a . ?x <field> ?f . "
+         "?a <field> ?f }"},
+        {"advisor-chains",
+         "SELECT ?x ?b WHERE { ?x <advisor> ?a . ?a <advisor> ?b }"},
+        {"oldest-per-place",
+         "SELECT ?p (MIN(?y) AS ?oldest) WHERE { ?x <place-of-birth> ?p . "
+         "?x <year-of-birth> ?y } GROUP BY ?p"},
+        {"youngest-100",
+         "SELECT ?x ?y WHERE { ?x <is-a> <Scientist> . ?x <year-of-birth> ?y "
+         "} ORDER BY DESC(?y) LIMIT 100"}};
+  }
+
+  // A dataset that resembles the `scientists` dataset: Each entity is a
+  // scientist with a field, a year and a place of birth, and (except for the
+  // first ones) an advisor. The fields and places are Zipf-distributed.
+  std::string createTurtle() const {
+    std::mt19937_64 randomEngine{42};
+    auto zipf = [](size_t n) {
+      std::vector<double> weights;
+      for (size_t i = 0; i < n; ++i) {
+        weights.push_back(1.0 / static_cast<double>(i + 1));
+      }
+      return std::discrete_distribution<size_t>{weights.begin(),
+                                                weights.end()};
+    };
+    auto field = zipf(50);
+    auto place = zipf(1000);
+    std::uniform_int_distribution<int> year{1600, 2000};
+    std::string turtle;
+    for (size_t i = 0; i < numEntities_; ++i) {
+      auto subject = absl::StrCat("<s", i, ">");
+      absl::StrAppend(&turtle, subject, " <is-a> <Scientist> .\n", subject,
+                      " <field> <f", field(randomEngine), "> .\n", subject,
+                      " <year-of-birth> ", year(randomEngine), " .\n", subject,
+                      " <place-of-birth> <p", place(randomEngine), "> .\n");
+      if (i >= 10) {
+        std::uniform_int_distribution<size_t> advisor{0, i - 1};
+        absl::StrAppend(&turtle, subject, " <advisor> <s",
+                        advisor(randomEngine), "> .\n");
+      }
+    }
+    return turtle;
+  }
+};
+
+AD_REGISTER_BENCHMARK(QueryWorkloadBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,103 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "util/Exception.h"
+#include "util/Simple8bCode.h"
+
+namespace ad_benchmark {
+
+// Compare the decoders of `ad_utility::Simple8bCode` on lists with different
+// distributions of values: the generic decoder that looks up the selector
+// table for each codeword, the decoder that is specialized for each selector,
+// and (for gap encoded lists like the context lists of the text index) the
+// decoding followed by a scalar prefix sum vs. the fused `decodeGaps`.
+class Simple8bBenchmark : public BenchmarkInterface {
+  size_t numElements_;
+
+  using Code = ad_utility::Simple8bCode;
+
+ public:
+  Simple8bBenchmark() {
+    getConfigManager().addOption("num-elements",
+                                 "The number of elements of each list.",
+                                 &numElements_, size_t{50'000'000});
+  }
+
+  std::string name() const final { return "Decoding of Simple8b lists"; }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    // The maximal number of bits of the values, 0 stands for a list where
+    // most values are 0 (like the scores of the text index).
+    const std::vector<size_t> maxBits{0, 2, 6, 12, 30};
+    std::vector<std::string> rowNames;
+    for (size_t bits : maxBits) {
+      rowNames.push_back(bits == 0 ? "mostly zeros"
+                                   : absl::StrCat("up to ", bits, " bits"));
+    }
+    auto& table = results.addTable(
+        "Decoding time (s)", rowNames,
+        {"Values", "Selector table", "Specialized", "Gaps: table + scalar sum",
+         "Gaps: fused (decodeGaps)"});
+    table.metadata().addKeyValuePair("num-elements", numElements_);
+
+    for (size_t row = 0; row < maxBits.size(); ++row) {
+      auto plain = createList(maxBits[row]);
+      std::vector<uint64_t> encoded(plain.size());
+      Code::encode(plain.data(), plain.size(), encoded.data());
+      std::vector<uint64_t> decoded(plain.size() + 250);
+
+      table.addMeasurement(row, 1, [&]() {
+        Code::decodeWithSelectorTable(encoded.data(), plain.size(),
+                                      decoded.data());
+      });
+      table.addMeasurement(row, 2, [&]() {
+        Code::decode(encoded.data(), plain.size(), decoded.data());
+      });
+      AD_CORRECTNESS_CHECK(
+          std::equal(plain.begin(), plain.end(), decoded.begin()));
+      table.addMeasurement(row, 3, [&]() {
+        Code::decodeWithSelectorTable(encoded.data(), plain.size(),
+                                      decoded.data());
+        uint64_t sum = 0;
+        for (size_t i = 0; i < plain.size(); ++i) {
+          sum += decoded[i];
+          decoded[i] = sum;
+        }
+      });
+      table.addMeasurement(row, 4, [&]() {
+        Code::decodeGaps(encoded.data(), plain.size(), decoded.data());
+      });
+    }
+    return results;
+  }
+
+ private:
+  // Create a list of `numElements_` random values with at most `maxBits` bits.
+  std::vector<uint64_t> createList(size_t maxBits) const {
+    std::mt19937_64 randomEngine{42};
+    std::vector<uint64_t> result(numElements_);
+    for (auto& value : result) {
+      if (maxBits == 0) {
+        value = randomEngine() % 64 == 0 ? randomEngine() % 8 : 0;
+      } else {
+        // Mostly small values with a few large ones, like the gaps between
+        // the contexts of a word.
+        size_t bits = 1 + randomEngine() % maxBits;
+        value = randomEngine() & ((uint64_t{1} << bits) - 1);
+      }
+    }
+    return result;
+  }
+};
+
+AD_REGISTER_BENCHMARK(Simple8bBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,194 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "index/FTSAlgorithms.h"
+#include "index/TextMetaData.h"
+
+namespace ad_benchmark {
+
+// Measure the text search algorithms on the postings lists of a synthetic
+// corpus whose word frequencies follow Zipf's law, like those of natural
+// language. Compares
+// - the intersection of the postings lists of a frequent and a rare word
+//   (which profits from galloping) with the intersection of two frequent words,
+// - the top-k postings of a word computed with the block-max scores of the
+//   chunks of its list with a full scan that scores every posting.
+class TextIndexBenchmark : public BenchmarkInterface {
+  size_t numContexts_;
+  size_t numWordsPerContext_;
+  size_t vocabularySize_;
+  size_t k_;
+
+  using WordEntityPostings = Index::WordEntityPostings;
+
+ public:
+  TextIndexBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-contexts", "The number of contexts of the corpus.",
+                      &numContexts_, size_t{2'000'000});
+    manager.addOption("num-words-per-context",
+                      "The number of words in each context.",
+                      &numWordsPerContext_, size_t{20});
+    manager.addOption("vocabulary-size",
+                      "The number of distinct words of the corpus.",
+                      &vocabularySize_, size_t{100'000});
+    manager.addOption("k", "The number of postings for the top-k queries.",
+                      &k_, size_t{10});
+  }
+
+  std::string name() const final {
+    return "Text search on a synthetic Zipf-distributed corpus";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    std::vector<WordEntityPostings> lists = createPostingsLists();
+
+    // The words are numbered by decreasing frequency.
+    std::vector<size_t> words{0, 10, 100, 1000, 10'000};
+    std::erase_if(words, [this](size_t w) { return w >= vocabularySize_; });
+
+    // Intersections.
+    std::vector<std::string> rowNames;
+    for (size_t w : words) {
+      rowNames.push_back(absl::StrCat("word 0 AND word ", w));
+    }
+    auto& intersections = results.addTable(
+        "Intersection of two postings lists", rowNames,
+        {"Query", "Size of the lists", "Result size", "Time (s)"});
+    const WordEntityPostings frequent = toEntityList(lists[0]);
+    for (size_t row = 0; row < words.size(); ++row) {
+      const auto& other = lists[words[row]];
+      intersections.setEntry(
+          row, 1,
+          absl::StrCat(frequent.cids_.size(), " and ", other.cids_.size()));
+      size_t resultSize = 0;
+      intersections.addMeasurement(row, 3, [&]() {
+        resultSize =
+            FTSAlgorithms::crossIntersect(other, frequent).cids_.size();
+      });
+      intersections.setEntry(row, 2, resultSize);
+    }
+
+    // Top-k.
+    rowNames.clear();
+    for (size_t w : words) {
+      rowNames.push_back(absl::StrCat("top-", k_, " of word ", w));
+    }
+    auto& topK = results.addTable(
+        "Top-k postings of a single word", rowNames,
+        {"Query", "List size", "Full scan (s)", "Block-max (s)",
+         "Chunks read by block-max"});
+    for (size_t row = 0; row < words.size(); ++row) {
+      const auto& list = lists[words[row]];
+      topK.setEntry(row, 1, list.cids_.size());
+      topK.addMeasurement(row, 2, [&]() { fullScanTopK(list); });
+      // Like in the text index, the block-max scores are precomputed.
+      std::vector<Score> maxScores = computeMaxScores(list);
+      size_t nofChunksRead = 0;
+      topK.addMeasurement(row, 3, [&]() {
+        nofChunksRead = 0;
+        blockMaxTopK(list, maxScores, nofChunksRead);
+      });
+      topK.setEntry(row, 4, nofChunksRead);
+    }
+    return results;
+  }
+
+ private:
+  // Create the postings list of each word. The score of a posting is the
+  // number of occurrences of the word in the context.
+  std::vector<WordEntityPostings> createPostingsLists() const {
+    std::vector<WordEntityPostings> lists(vocabularySize_);
+    std::vector<double> weights(vocabularySize_);
+    for (size_t i = 0; i < vocabularySize_; ++i) {
+      weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    std::mt19937_64 randomEngine{42};
+    std::discrete_distribution<size_t> zipf{weights.begin(), weights.end()};
+    std::vector<size_t> wordsOfContext;
+    for (size_t context = 0; context < numContexts_; ++context) {
+      wordsOfContext.clear();
+      for (size_t i = 0; i < numWordsPerContext_; ++i) {
+        wordsOfContext.push_back(zipf(randomEngine));
+      }
+      std::ranges::sort(wordsOfContext);
+      for (auto it = wordsOfContext.begin(); it != wordsOfContext.end();) {
+        auto next = std::ranges::find_if(
+            it, wordsOfContext.end(), [&it](size_t w) { return w != *it; });
+        auto& list = lists[*it];
+        list.cids_.push_back(TextRecordIndex::make(context));
+        list.wids_.at(0).push_back(*it);
+        list.scores_.push_back(static_cast<Score>(next - it));
+        it = next;
+      }
+    }
+    return lists;
+  }
+
+  // `crossIntersect` expects the second list to be an entity list.
+  static WordEntityPostings toEntityList(const WordEntityPostings& list) {
+    WordEntityPostings result;
+    result.cids_ = list.cids_;
+    result.scores_ = list.scores_;
+    result.eids_.resize(list.cids_.size(), Id::makeFromInt(0));
+    return result;
+  }
+
+  // Score every posting and keep the best `k_`.
+  size_t fullScanTopK(const WordEntityPostings& list) const {
+    std::vector<std::pair<Score, size_t>> scored;
+    scored.reserve(list.scores_.size());
+    for (size_t i = 0; i < list.scores_.size(); ++i) {
+      scored.emplace_back(list.scores_[i], i);
+    }
+    size_t k = std::min(k_, scored.size());
+    std::ranges::partial_sort(scored, scored.begin() + k, std::greater{});
+    return k;
+  }
+
+  static constexpr size_t chunkSize = TextPostingChunkMetaData::CHUNK_SIZE;
+
+  // Divide the list into chunks like in the text index and return the maximal
+  // score of each chunk.
+  static std::vector<Score> computeMaxScores(const WordEntityPostings& list) {
+    std::vector<Score> maxScores((list.cids_.size() + chunkSize - 1) /
+                                 chunkSize);
+    for (size_t i = 0; i < list.scores_.size(); ++i) {
+      maxScores[i / chunkSize] =
+          std::max(maxScores[i / chunkSize], list.scores_[i]);
+    }
+    return maxScores;
+  }
+
+  // Use the block-max scores of the chunks to only look at the chunks that
+  // can contribute to the result.
+  size_t blockMaxTopK(const WordEntityPostings& list,
+                      const std::vector<Score>& maxScores,
+                      size_t& nofChunksRead) const {
+    auto readChunk = [&](size_t chunk) {
+      ++nofChunksRead;
+      size_t begin = chunk * chunkSize;
+      size_t end = std::min(begin + chunkSize, list.cids_.size());
+      WordEntityPostings result;
+      result.cids_.assign(list.cids_.begin() + begin, list.cids_.begin() + end);
+      result.wids_.at(0).assign(list.wids_.at(0).begin() + begin,
+                                list.wids_.at(0).begin() + end);
+      result.scores_.assign(list.scores_.begin() + begin,
+                            list.scores_.begin() + end);
+      return result;
+    };
+    return FTSAlgorithms::blockMaxTopK(maxScores, k_, readChunk).cids_.size();
+  }
+};
+
+AD_REGISTER_BENCHMARK(TextIndexBenchmark);
+}  // namespace ad_benchmark
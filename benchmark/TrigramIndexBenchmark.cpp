@@ -0,0 +1,167 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "engine/sparqlExpressions/RegexExpression.h"
+#include "index/TrigramIndex.h"
+#include "parser/RdfEscaping.h"
+#include "re2/re2.h"
+#include "util/Exception.h"
+#include "util/File.h"
+
+namespace ad_benchmark {
+
+// Measure the time to build the `TrigramIndex` on a synthetic vocabulary of
+// labels (literals with language tags), its size, and the time to evaluate
+// regexes on all the labels, once by matching all the labels and once by
+// only matching the candidates from the trigram index (which is how
+// `IndexImpl::getVocabularyMatches` uses the index).
+class TrigramIndexBenchmark : public BenchmarkInterface {
+  size_t numWords_;
+
+ public:
+  TrigramIndexBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-words", "The number of labels of the vocabulary.",
+                      &numWords_, size_t{2'000'000});
+  }
+
+  std::string name() const final {
+    return "Build time, size, and regex filters with the trigram index";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    const std::vector<std::string> words = createWords();
+    size_t numBytes = 0;
+    for (const auto& word : words) {
+      numBytes += word.size();
+    }
+
+    // Build the index, which writes it to disk, and measure its size.
+    auto& buildTable = results.addTable(
+        "Build", {"Trigram index"},
+        {"Index", "Build (s)", "Size (MB)", "Bytes per word"});
+    buildTable.metadata().addKeyValuePair("num-words", words.size());
+    buildTable.metadata().addKeyValuePair("uncompressed-size-in-bytes",
+                                          numBytes);
+    buildTable.setEntry(0, 0, "TrigramIndex");
+    const std::string filename = "trigramIndexBenchmark.tmp.dat";
+    buildTable.addMeasurement(0, 1, [&]() {
+      using namespace ad_utility::memory_literals;
+      TrigramIndex::Builder builder{filename, 1_GB,
+                                    ad_utility::makeUnlimitedAllocator<Id>()};
+      for (const auto& word : words) {
+        builder.push(word);
+      }
+      std::move(builder).finish();
+    });
+    TrigramIndex index;
+    index.readFromFile(filename);
+    size_t sizeInBytes = ad_utility::File{filename, "r"}.sizeOfFile();
+    // The index can still be used, as its file stays open.
+    ad_utility::deleteFile(filename);
+    buildTable.setEntry(0, 2, static_cast<float>(sizeInBytes) / 1'000'000);
+    buildTable.setEntry(
+        0, 3,
+        static_cast<float>(sizeInBytes) / static_cast<float>(words.size()));
+
+    // The regexes, from very selective to not selective at all.
+    const std::vector<std::string> regexes{
+        "zorbaxil", "lindemar", "berg.*stad", "(?i)KORVAN", "tor", "an"};
+    std::vector<std::string> rowNames;
+    for (const auto& regex : regexes) {
+      rowNames.push_back(absl::StrCat("REGEX \"", regex, "\""));
+    }
+    auto& queryTable = results.addTable(
+        "Regex filters on all labels", rowNames,
+        {"Regex", "Matches", "Candidates", "Full scan (s)", "Trigram index (s)"});
+    for (size_t row = 0; row < regexes.size(); ++row) {
+      RE2 regex{regexes[row]};
+      AD_CORRECTNESS_CHECK(regex.ok());
+      queryTable.setEntry(row, 0, rowNames[row]);
+      auto matches = [&regex, &words](size_t i) {
+        return RE2::PartialMatch(
+            RdfEscaping::normalizedContentFromLiteralOrIri(
+                std::string{words[i]}),
+            regex);
+      };
+      size_t numMatchesFullScan = 0;
+      queryTable.addMeasurement(row, 3, [&]() {
+        for (size_t i = 0; i < words.size(); ++i) {
+          numMatchesFullScan += matches(i);
+        }
+      });
+      size_t numMatches = 0;
+      size_t numCandidates = 0;
+      queryTable.addMeasurement(row, 4, [&]() {
+        auto candidates = index.getCandidates(
+            sparqlExpression::detail::getRequiredSubstrings(regexes[row],
+                                                            false));
+        if (!candidates.has_value()) {
+          // Without trigrams, all the words have to be matched.
+          numCandidates = words.size();
+          for (size_t i = 0; i < words.size(); ++i) {
+            numMatches += matches(i);
+          }
+          return;
+        }
+        numCandidates = candidates->size();
+        for (uint64_t i : candidates.value()) {
+          numMatches += matches(i);
+        }
+      });
+      AD_CORRECTNESS_CHECK(numMatches == numMatchesFullScan);
+      queryTable.setEntry(row, 1, numMatches);
+      queryTable.setEntry(row, 2, numCandidates);
+    }
+    return results;
+  }
+
+ private:
+  // Create `numWords_` labels that consist of one to four random words, which
+  // in turn consist of random syllables, s.t. the distribution of the trigrams
+  // is skewed like in natural language.
+  std::vector<std::string> createWords() const {
+    std::mt19937_64 randomEngine{42};
+    const std::vector<std::string> syllables{
+        "an",  "ber", "dor", "el",  "gar", "stad", "in",  "kor",
+        "lin", "ma",  "de",  "ri",  "ton", "van",  "zor", "ba",
+        "xil", "mar", "sen", "tor", "ul",  "we",   "ha",  "ne"};
+    const std::vector<std::string> languages{"en", "de", "fr", "es", "ja"};
+    // Zipf-like distribution of the syllables.
+    std::vector<double> weights;
+    for (size_t i = 0; i < syllables.size(); ++i) {
+      weights.push_back(1.0 / static_cast<double>(i + 1));
+    }
+    std::discrete_distribution<size_t> syllable{weights.begin(),
+                                                weights.end()};
+    std::vector<std::string> words;
+    words.reserve(numWords_);
+    for (size_t i = 0; i < numWords_; ++i) {
+      std::string label;
+      size_t numLabelWords = 1 + randomEngine() % 4;
+      for (size_t j = 0; j < numLabelWords; ++j) {
+        if (j > 0) {
+          label.push_back(' ');
+        }
+        size_t numSyllables = 2 + randomEngine() % 3;
+        for (size_t k = 0; k < numSyllables; ++k) {
+          absl::StrAppend(&label, syllables[syllable(randomEngine)]);
+        }
+      }
+      words.push_back(absl::StrCat("\"", label, "\"@",
+                                   languages[randomEngine() % 5]));
+    }
+    return words;
+  }
+};
+
+AD_REGISTER_BENCHMARK(TrigramIndexBenchmark);
+}  // namespace ad_benchmark
@@ -0,0 +1,120 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <string>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "parser/TurtleParser.h"
+#include "util/File.h"
+#include "util/Random.h"
+
+namespace ad_benchmark {
+
+// Measure the throughput (in MB/s) of the different tokenizers of the
+// `TurtleParser` and of its N-Triples fast path on a synthetic N-Triples file.
+class TurtleParserBenchmark : public BenchmarkInterface {
+  size_t numTriples_;
+  std::string filename_;
+
+ public:
+  TurtleParserBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-triples",
+                      "The number of triples in the generated input file.",
+                      &numTriples_, size_t{5'000'000});
+    manager.addOption("filename", "The name of the generated input file.",
+                      &filename_,
+                      std::string{"turtleParserBenchmark.nt.tmp"});
+  }
+
+  std::string name() const final {
+    return "Throughput of the Turtle parser on N-Triples input";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    size_t numBytes = writeInputFile();
+    BenchmarkResults results{};
+
+    auto parseAll = [this]<typename Parser>(bool parseAsNTriples) {
+      Parser parser{filename_, parseAsNTriples};
+      size_t numParsedTriples = 0;
+      while (auto batch = parser.getBatch()) {
+        numParsedTriples += batch.value().size();
+      }
+      AD_CORRECTNESS_CHECK(numParsedTriples == numTriples_);
+    };
+
+    auto& table = results.addTable(
+        "Parsing an N-Triples file",
+        {"Re2 tokenizer", "CTRE tokenizer", "Re2 tokenizer + N-Triples",
+         "CTRE tokenizer + N-Triples"},
+        {"Parser", "Sequential (s)", "Sequential (MB/s)", "Parallel (s)",
+         "Parallel (MB/s)"});
+    table.metadata().addKeyValuePair("num-triples", numTriples_);
+    table.metadata().addKeyValuePair("num-bytes", numBytes);
+
+    auto measureRow = [&]<typename Tokenizer_T>(size_t row,
+                                                bool parseAsNTriples) {
+      auto measureColumn = [&]<typename Parser>(size_t column) {
+        table.addMeasurement(row, column, [&]() {
+          parseAll.template operator()<Parser>(parseAsNTriples);
+        });
+        float seconds = table.getEntry<float>(row, column);
+        table.setEntry(row, column + 1,
+                       static_cast<float>(numBytes) / 1'000'000 / seconds);
+      };
+      measureColumn.template operator()<TurtleStreamParser<Tokenizer_T>>(1);
+      measureColumn.template operator()<TurtleParallelParser<Tokenizer_T>>(3);
+    };
+    measureRow.template operator()<Tokenizer>(0, false);
+    measureRow.template operator()<TokenizerCtre>(1, false);
+    measureRow.template operator()<Tokenizer>(2, true);
+    measureRow.template operator()<TokenizerCtre>(3, true);
+
+    ad_utility::deleteFile(filename_);
+    return results;
+  }
+
+ private:
+  // Write `numTriples_` triples that resemble a typical knowledge graph dump
+  // (IRIs, plain literals, literals with language tags and typed literals) to
+  // `filename_`. Return the size of the file in bytes.
+  size_t writeInputFile() const {
+    ad_utility::FastRandomIntGenerator<size_t> randomInt;
+    auto out = ad_utility::makeOfstream(filename_);
+    size_t numBytes = 0;
+    for (size_t i = 0; i < numTriples_; ++i) {
+      auto subject =
+          absl::StrCat("<http://www.wikidata.org/entity/Q", i / 10, ">");
+      auto predicate = absl::StrCat(
+          "<http://www.wikidata.org/prop/direct/P", randomInt() % 1000, ">");
+      std::string object;
+      switch (i % 4) {
+        case 0:
+          object = absl::StrCat("<http://www.wikidata.org/entity/Q",
+                                randomInt() % 100'000'000, ">");
+          break;
+        case 1:
+          object = absl::StrCat("\"some label with an \\\"escaped\\\" quote ",
+                                randomInt() % 1000, "\"@en");
+          break;
+        case 2:
+          object = absl::StrCat(
+              "\"", randomInt() % 1'000'000,
+              "\"^^<http://www.w3.org/2001/XMLSchema#integer>");
+          break;
+        default:
+          object = absl::StrCat("\"a plain literal ", randomInt(), "\"");
+      }
+      auto line = absl::StrCat(subject, " ", predicate, " ", object, " .\n");
+      numBytes += line.size();
+      out << line;
+    }
+    return numBytes;
+  }
+};
+
+AD_REGISTER_BENCHMARK(TurtleParserBenchmark);
+}  // namespace ad_benchmark
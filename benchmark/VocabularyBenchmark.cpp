@@ -0,0 +1,187 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "global/Constants.h"
+#include "index/PrefixHeuristic.h"
+#include "index/vocabulary/CompressedVocabulary.h"
+#include "index/vocabulary/FrontCodedVocabulary.h"
+#include "index/vocabulary/FsstCompressor.h"
+#include "index/vocabulary/PrefixCompressor.h"
+#include "index/vocabulary/VocabularyInMemory.h"
+#include "util/Exception.h"
+#include "util/File.h"
+
+namespace ad_benchmark {
+
+// Compare the representations of the internal vocabulary on a synthetic
+// vocabulary with IRIs and literals like those of Wikidata: the current
+// `CompressedVocabulary` with a `PrefixCompressor` (with the prefixes that the
+// index builder would choose), and the `FrontCodedVocabulary` with and without
+// an `FsstCompressor`. Measures the size (which is the same on disk and in
+// RAM), the time to write the vocabulary, and the time for random accesses via
+// `operator[]` and `lower_bound`.
+class VocabularyBenchmark : public BenchmarkInterface {
+  size_t numWords_;
+  size_t numLookups_;
+
+  using PrefixCompressedVocabulary =
+      CompressedVocabulary<VocabularyInMemory, PrefixCompressor>;
+
+ public:
+  VocabularyBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-words", "The number of words of the vocabulary.",
+                      &numWords_, size_t{2'000'000});
+    manager.addOption("num-lookups",
+                      "The number of random lookups for each measurement.",
+                      &numLookups_, size_t{1'000'000});
+  }
+
+  std::string name() const final {
+    return "Memory and lookup throughput of the internal vocabulary";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    const std::vector<std::string> words = createWords();
+    size_t numBytes = 0;
+    for (const auto& word : words) {
+      numBytes += word.size();
+    }
+
+    auto& table = results.addTable(
+        "Internal vocabulary",
+        {"Prefix compressed", "Front coded", "Front coded + FSST"},
+        {"Vocabulary", "Size (MB)", "Bytes per word", "Write (s)",
+         "operator[] (s)", "lower_bound (s)"});
+    table.metadata().addKeyValuePair("num-words", words.size());
+    table.metadata().addKeyValuePair("num-lookups", numLookups_);
+    table.metadata().addKeyValuePair("uncompressed-size-in-bytes", numBytes);
+
+    // The random IDs and words for the lookups.
+    std::mt19937_64 randomEngine{42};
+    std::vector<uint64_t> ids(numLookups_);
+    std::vector<std::string> lookupWords;
+    for (auto& id : ids) {
+      id = randomEngine() % words.size();
+      lookupWords.push_back(words[randomEngine() % words.size()]);
+    }
+
+    // Write the vocabulary with the `writeVocabulary` function, then measure
+    // the size and the lookups of the vocabulary that is read from the file.
+    const std::string filename = "vocabularyBenchmark.tmp.dat";
+    auto measure = [&](size_t row, auto writeVocabulary, auto vocabulary) {
+      table.addMeasurement(row, 3, [&]() { writeVocabulary(filename); });
+      size_t sizeInBytes = ad_utility::File{filename, "r"}.sizeOfFile();
+      table.setEntry(row, 1, static_cast<float>(sizeInBytes) / 1'000'000);
+      table.setEntry(row, 2,
+                     static_cast<float>(sizeInBytes) /
+                         static_cast<float>(words.size()));
+      vocabulary.open(filename);
+      ad_utility::deleteFile(filename);
+      AD_CORRECTNESS_CHECK(vocabulary.size() == words.size());
+
+      size_t checksum = 0;
+      table.addMeasurement(row, 4, [&]() {
+        for (uint64_t id : ids) {
+          checksum += vocabulary[id].size();
+        }
+      });
+      table.addMeasurement(row, 5, [&]() {
+        for (const auto& word : lookupWords) {
+          checksum += vocabulary.lower_bound(word, std::less<>{})._index;
+        }
+      });
+      // Prevent the compiler from optimizing the lookups away.
+      AD_CORRECTNESS_CHECK(checksum > 0);
+    };
+
+    // Prefix compression.
+    table.setEntry(0, 0, "CompressedVocabulary<PrefixCompressor>");
+    PrefixCompressor prefixCompressor;
+    prefixCompressor.buildCodebook(
+        calculatePrefixes(words, NUM_COMPRESSION_PREFIXES, 1));
+    measure(
+        0,
+        [&](const std::string& file) {
+          PrefixCompressedVocabulary::DiskWriterFromUncompressedWords writer{
+              prefixCompressor, file};
+          for (const auto& word : words) {
+            writer.push(word);
+          }
+          writer.finish();
+        },
+        PrefixCompressedVocabulary{prefixCompressor});
+
+    // Front coding with and without FSST. The time for writing includes the
+    // training of the symbol table.
+    for (bool useFsst : {false, true}) {
+      size_t row = useFsst ? 2 : 1;
+      table.setEntry(row, 0,
+                     absl::StrCat("FrontCodedVocabulary (",
+                                  FrontCodedVocabulary::BLOCK_SIZE,
+                                  " words per block)"));
+      measure(
+          row,
+          [&](const std::string& file) {
+            std::optional<FsstCompressor> compressor;
+            if (useFsst) {
+              compressor = FsstCompressor::trainOnSample(words);
+            }
+            FrontCodedVocabulary::WordWriter writer{file,
+                                                    std::move(compressor)};
+            for (const auto& word : words) {
+              writer.push(word);
+            }
+            writer.finish();
+          },
+          FrontCodedVocabulary{});
+    }
+    return results;
+  }
+
+ private:
+  // Create `numWords_` sorted and distinct words: entity, property, and
+  // statement IRIs and literals with language tags.
+  std::vector<std::string> createWords() const {
+    std::mt19937_64 randomEngine{42};
+    std::vector<std::string> words;
+    words.reserve(numWords_);
+    const std::vector<std::string> languages{"en", "de", "fr", "es", "ja"};
+    for (size_t i = 0; i < numWords_; ++i) {
+      uint64_t entity = randomEngine() % (10 * numWords_);
+      switch (randomEngine() % 4) {
+        case 0:
+          words.push_back(
+              absl::StrCat("<http://www.wikidata.org/entity/Q", entity, ">"));
+          break;
+        case 1:
+          words.push_back(absl::StrCat("<http://www.wikidata.org/prop/direct/P",
+                                       entity % 10'000, ">"));
+          break;
+        case 2:
+          words.push_back(absl::StrCat(
+              "<http://www.wikidata.org/entity/statement/Q", entity, "-",
+              absl::Hex(randomEngine()), ">"));
+          break;
+        default:
+          words.push_back(absl::StrCat("\"Label of item ", entity, "\"@",
+                                       languages[entity % languages.size()]));
+      }
+    }
+    std::ranges::sort(words);
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    return words;
+  }
+};
+
+AD_REGISTER_BENCHMARK(VocabularyBenchmark);
+}  // namespace ad_benchmark
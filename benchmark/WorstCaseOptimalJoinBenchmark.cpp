@@ -0,0 +1,171 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "../test/IndexTestHelpers.h"
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "parser/SparqlParser.h"
+#include "util/Exception.h"
+#include "util/Timer.h"
+
+namespace ad_benchmark {
+
+// Compare the plans of the query planner when it may choose the worst-case
+// optimal join with the binary joins that it uses when the worst-case
+// optimal join is disabled (`wcoj-min-num-triples` = 0) on cyclic
+// queries over a synthetic graph with many triangles. The nodes of the graph
+// are partitioned into communities, and most of the edges of a node go to
+// other nodes of its community, the rest to random nodes. Dense communities
+// contain many triangles, and the random edges make the intermediate results
+// of the binary joins (all the paths of length two) large compared to the
+// result.
+class WorstCaseOptimalJoinBenchmark : public BenchmarkInterface {
+  size_t numNodes_;
+  size_t numEdgesPerNode_;
+  size_t communitySize_;
+  float randomEdgeFraction_;
+  size_t numRuns_;
+
+  struct Query {
+    std::string name_;
+    std::string sparql_;
+  };
+
+ public:
+  WorstCaseOptimalJoinBenchmark() {
+    ad_utility::ConfigManager& manager = getConfigManager();
+    manager.addOption("num-nodes", "The number of nodes of the graph.",
+                      &numNodes_, size_t{20'000});
+    manager.addOption("num-edges-per-node",
+                      "The number of outgoing `<knows>` edges of each node.",
+                      &numEdgesPerNode_, size_t{10});
+    manager.addOption("community-size",
+                      "The number of nodes of each community.",
+                      &communitySize_, size_t{50});
+    manager.addOption("random-edge-fraction",
+                      "The fraction of the edges that go to a random node "
+                      "instead of a node of the same community.",
+                      &randomEdgeFraction_, 0.2f);
+    manager.addOption("num-runs",
+                      "The number of runs of each query with each strategy. "
+                      "The cache is cleared before each run.",
+                      &numRuns_, size_t{3});
+  }
+
+  std::string name() const final {
+    return "Worst-case optimal join vs. binary joins on cyclic queries";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    AD_CONTRACT_CHECK(numNodes_ > 0 && communitySize_ > 0 && numRuns_ > 0);
+    BenchmarkResults results{};
+    using namespace ad_utility::memory_literals;
+    auto* qec =
+        ad_utility::testing::getQec(createTurtle(), true, true, true, 1_MB);
+
+    auto queries = cyclicQueries();
+    std::vector<std::string> rowNames;
+    std::ranges::transform(queries, std::back_inserter(rowNames),
+                           &Query::name_);
+    auto& table = results.addTable(
+        "Cyclic queries", rowNames,
+        {"Query", "Result rows", "WCOJ (ms)", "Binary joins (ms)", "Speedup"});
+
+    const size_t minNumTriples =
+        RuntimeParameters().get<"wcoj-min-num-triples">();
+    for (size_t row = 0; row < queries.size(); ++row) {
+      // The minimum over all the runs, which is the least noisy.
+      auto measure = [&](size_t minNumTriplesForRun) {
+        RuntimeParameters().set<"wcoj-min-num-triples">(minNumTriplesForRun);
+        double best = std::numeric_limits<double>::max();
+        size_t numRows = 0;
+        for (size_t run = 0; run < numRuns_; ++run) {
+          qec->clearCacheUnpinnedOnly();
+          ad_utility::Timer timer{ad_utility::Timer::Started};
+          ParsedQuery pq = SparqlParser::parseQuery(queries[row].sparql_);
+          QueryPlanner qp{qec};
+          auto qet = qp.createExecutionTree(pq);
+          numRows = qet.getResult()->size();
+          best = std::min(best, std::chrono::duration<double, std::milli>(
+                                    timer.value())
+                                    .count());
+        }
+        return std::pair{best, numRows};
+      };
+      auto [wcojTime, wcojRows] = measure(3);
+      auto [binaryTime, binaryRows] = measure(0);
+      // Both strategies must compute the same result.
+      AD_CORRECTNESS_CHECK(wcojRows == binaryRows);
+      table.setEntry(row, 1, wcojRows);
+      table.setEntry(row, 2, static_cast<float>(wcojTime));
+      table.setEntry(row, 3, static_cast<float>(binaryTime));
+      table.setEntry(row, 4,
+                     static_cast<float>(binaryTime / std::max(wcojTime, 1e-9)));
+    }
+    RuntimeParameters().set<"wcoj-min-num-triples">(minNumTriples);
+
+    auto& metadata = table.metadata();
+    metadata.addKeyValuePair("num-nodes", numNodes_);
+    metadata.addKeyValuePair("num-edges", numNodes_ * numEdgesPerNode_);
+    metadata.addKeyValuePair("community-size", communitySize_);
+    metadata.addKeyValuePair("random-edge-fraction", randomEdgeFraction_);
+    return results;
+  }
+
+ private:
+  static std::vector<Query> cyclicQueries() {
+    return {
+        {"triangles",
+         "SELECT ?a ?b ?c WHERE { ?a <knows> ?b . ?b <knows> ?c . "
+         "?a <knows> ?c }"},
+        {"triangle-count",
+         "SELECT (COUNT(?a) AS ?count) WHERE { ?a <knows> ?b . "
+         "?b <knows> ?c . ?c <knows> ?a }"},
+        {"triangles-two-predicates",
+         "SELECT ?a ?b ?c WHERE { ?a <knows> ?b . ?b <knows> ?c . "
+         "?a <likes> ?c }"},
+        {"four-cycles-with-chord",
+         "SELECT ?a ?b ?c ?d WHERE { ?a <knows> ?b . ?b <knows> ?c . "
+         "?c <knows> ?d . ?a <knows> ?d . ?a <knows> ?c }"},
+        {"four-cliques",
+         "SELECT ?a ?b ?c ?d WHERE { ?a <knows> ?b . ?a <knows> ?c . "
+         "?a <knows> ?d . ?b <knows> ?c . ?b <knows> ?d . ?c <knows> ?d }"}};
+  }
+
+  // The `<knows>` edges as described above, and one `<likes>` edge per node
+  // (to a node of the same community).
+  std::string createTurtle() const {
+    std::mt19937_64 randomEngine{42};
+    std::uniform_int_distribution<size_t> randomNode{0, numNodes_ - 1};
+    std::uniform_int_distribution<size_t> communityOffset{0,
+                                                          communitySize_ - 1};
+    std::bernoulli_distribution isRandomEdge{randomEdgeFraction_};
+    auto nodeInCommunityOf = [&](size_t node) {
+      size_t first = node - node % communitySize_;
+      return std::min(first + communityOffset(randomEngine), numNodes_ - 1);
+    };
+    std::string turtle;
+    for (size_t node = 0; node < numNodes_; ++node) {
+      for (size_t i = 0; i < numEdgesPerNode_; ++i) {
+        size_t target = isRandomEdge(randomEngine) ? randomNode(randomEngine)
+                                                   : nodeInCommunityOf(node);
+        absl::StrAppend(&turtle, "<n", node, "> <knows> <n", target, "> .\n");
+      }
+      absl::StrAppend(&turtle, "<n", node, "> <likes> <n",
+                      nodeInCommunityOf(node), "> .\n");
+    }
+    return turtle;
+  }
+};
+
+AD_REGISTER_BENCHMARK(WorstCaseOptimalJoinBenchmark);
+}  // namespace ad_benchmark
@@ -22,10 +22,12 @@ using std::endl;
  * @param out the parsed triples are written to this file
  * @param filename the filename from which the triples are parsed, can be
  * "/dev/stdin"
+ * @param parseAsNTriples Use the fast path for N-Triples input
  */
 template <class Parser>
-void writeNTImpl(std::ostream& out, const std::string& filename) {
-  Parser p(filename);
+void writeNTImpl(std::ostream& out, const std::string& filename,
+                 bool parseAsNTriples) {
+  Parser p(filename, parseAsNTriples);
   TurtleTriple triple;
   size_t numTriples = 0;
   while (p.getLine(triple)) {
@@ -49,7 +51,8 @@ template <class Tokenizer_T>
 void writeNT(std::ostream& out, const string& fileFormat,
              const std::string& filename) {
   if (fileFormat == "ttl" || fileFormat == "nt") {
-    writeNTImpl<TurtleStreamParser<Tokenizer_T>>(out, filename);
+    writeNTImpl<TurtleStreamParser<Tokenizer_T>>(out, filename,
+                                                 fileFormat == "nt");
   } else {
     LOG(ERROR) << "writeNT was called with unknown file format " << fileFormat
                << ". This should never happen, terminating" << std::endl;
@@ -6,6 +6,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/sparqlExpressions/ParallelEvaluation.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "util/Exception.h"
@@ -113,20 +114,55 @@ ResultTable Bind::computeResult() {
   return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
 }
 
+namespace {
+// The local vocabulary for the words that are added by the evaluation of one
+// chunk of the input of a BIND. The indices of these words start at the size
+// of the local vocabulary of the input (`offset`), s.t. they can be told apart
+// from the indices of the input when the chunks are merged.
+class ChunkLocalVocab {
+  LocalVocab words_;
+  size_t offset_;
+
+ public:
+  explicit ChunkLocalVocab(size_t offset) : offset_{offset} {}
+
+  template <typename Word>
+  LocalVocabIndex getIndexAndAddIfNotContained(Word&& word) {
+    return LocalVocabIndex::make(
+        offset_ +
+        words_.getIndexAndAddIfNotContained(std::forward<Word>(word)).get());
+  }
+
+  // Add the words of this chunk to the `target` (a copy of the local
+  // vocabulary of the input) and replace the indices of the words of this
+  // chunk in the `ids` by their indices in the `target`.
+  void mergeInto(LocalVocab& target, std::span<Id> ids) const {
+    if (words_.empty()) {
+      return;
+    }
+    std::vector<LocalVocabIndex> targetIndices;
+    targetIndices.reserve(words_.size());
+    for (size_t i = 0; i < words_.size(); ++i) {
+      targetIndices.push_back(target.getIndexAndAddIfNotContained(
+          words_.getWord(LocalVocabIndex::make(i))));
+    }
+    for (Id& id : ids) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex &&
+          id.getLocalVocabIndex().get() >= offset_) {
+        id = Id::makeFromLocalVocabIndex(
+            targetIndices.at(id.getLocalVocabIndex().get() - offset_));
+      }
+    }
+  }
+};
+}  // namespace
+
 // _____________________________________________________________________________
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
 void Bind::computeExpressionBind(
     IdTable* outputIdTable, LocalVocab* outputLocalVocab,
     const ResultTable& inputResultTable,
     sparqlExpression::SparqlExpression* expression) const {
-  sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      inputResultTable.idTable(), getExecutionContext()->getAllocator(),
-      inputResultTable.localVocab());
-
-  sparqlExpression::ExpressionResult expressionResult =
-      expression->evaluate(&evaluationContext);
-
   const auto input = inputResultTable.idTable().asStaticView<IN_WIDTH>();
   auto output = std::move(*outputIdTable).toStatic<OUT_WIDTH>();
 
@@ -142,51 +178,83 @@ void Bind::computeExpressionBind(
     }
   }
 
-  auto visitor = [&]<sparqlExpression::SingleExpressionResult T>(
-                     T&& singleResult) mutable {
-    constexpr static bool isVariable = std::is_same_v<T, ::Variable>;
-    constexpr static bool isStrongId = std::is_same_v<T, Id>;
+  // Evaluate the expression on the rows `[beginIndex, endIndex)` of the input
+  // and write the result to the same rows of the last column of the `output`.
+  // The chunks of a large input are evaluated concurrently (see
+  // `evaluateInChunks`), each with its own local vocabulary.
+  AD_CORRECTNESS_CHECK(outputLocalVocab->size() ==
+                       inputResultTable.localVocab().size());
+  auto bindChunk = [&](size_t beginIndex, size_t endIndex) {
+    checkCancellation();
+    sparqlExpression::EvaluationContext evaluationContext(
+        *getExecutionContext(), _subtree->getVariableColumns(),
+        inputResultTable.idTable(), beginIndex, endIndex,
+        getExecutionContext()->getAllocator(), inputResultTable.localVocab());
+    evaluationContext._cancellationHandle = cancellationHandle_;
 
-    if constexpr (isVariable) {
-      auto column =
-          getInternallyVisibleVariableColumns().at(singleResult).columnIndex_;
-      for (size_t i = 0; i < inSize; ++i) {
-        output(i, inCols) = output(i, column);
-      }
-    } else if constexpr (isStrongId) {
-      for (size_t i = 0; i < inSize; ++i) {
-        output(i, inCols) = singleResult;
-      }
-    } else {
-      bool isConstant = sparqlExpression::isConstantResult<T>;
-
-      auto resultGenerator = sparqlExpression::detail::makeGenerator(
-          std::forward<T>(singleResult), inSize, &evaluationContext);
-
-      if (isConstant) {
-        auto it = resultGenerator.begin();
-        if (it != resultGenerator.end()) {
-          Id constantId =
-              sparqlExpression::detail::constantExpressionResultToId(
-                  std::move(*it), *outputLocalVocab);
-          for (size_t i = 0; i < inSize; ++i) {
-            output(i, inCols) = constantId;
-          }
+    sparqlExpression::ExpressionResult expressionResult =
+        expression->evaluate(&evaluationContext);
+
+    ChunkLocalVocab localVocab{outputLocalVocab->size()};
+    const size_t chunkSize = endIndex - beginIndex;
+
+    auto visitor = [&]<sparqlExpression::SingleExpressionResult T>(
+                       T&& singleResult) mutable {
+      constexpr static bool isVariable = std::is_same_v<T, ::Variable>;
+      constexpr static bool isStrongId = std::is_same_v<T, Id>;
+
+      if constexpr (isVariable) {
+        auto column =
+            getInternallyVisibleVariableColumns().at(singleResult).columnIndex_;
+        for (size_t i = beginIndex; i < endIndex; ++i) {
+          output(i, inCols) = output(i, column);
+        }
+      } else if constexpr (isStrongId) {
+        for (size_t i = beginIndex; i < endIndex; ++i) {
+          output(i, inCols) = singleResult;
         }
       } else {
-        size_t i = 0;
-        // We deliberately move the values from the generator.
-        for (auto& resultValue : resultGenerator) {
-          output(i, inCols) =
-              sparqlExpression::detail::constantExpressionResultToId(
-                  std::move(resultValue), *outputLocalVocab);
-          i++;
+        bool isConstant = sparqlExpression::isConstantResult<T>;
+
+        auto resultGenerator = sparqlExpression::detail::makeGenerator(
+            std::forward<T>(singleResult), chunkSize, &evaluationContext);
+
+        if (isConstant) {
+          auto it = resultGenerator.begin();
+          if (it != resultGenerator.end()) {
+            Id constantId =
+                sparqlExpression::detail::constantExpressionResultToId(
+                    std::move(*it), localVocab);
+            for (size_t i = beginIndex; i < endIndex; ++i) {
+              output(i, inCols) = constantId;
+            }
+          }
+        } else {
+          size_t i = beginIndex;
+          // We deliberately move the values from the generator.
+          for (auto& resultValue : resultGenerator) {
+            output(i, inCols) =
+                sparqlExpression::detail::constantExpressionResultToId(
+                    std::move(resultValue), localVocab);
+            i++;
+          }
         }
       }
-    }
+    };
+
+    std::visit(visitor, std::move(expressionResult));
+    return std::pair{std::move(localVocab), beginIndex};
   };
 
-  std::visit(visitor, std::move(expressionResult));
+  auto chunks = sparqlExpression::detail::evaluateInChunks(inSize, bindChunk);
+  // Merge the local vocabularies of the chunks in order.
+  auto boundColumn = output.getColumn(inCols);
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const auto& [localVocab, beginIndex] = chunks[i];
+    size_t endIndex = i + 1 < chunks.size() ? chunks[i + 1].second : inSize;
+    localVocab.mergeInto(*outputLocalVocab,
+                         boundColumn.subspan(beginIndex, endIndex - beginIndex));
+  }
 
   *outputIdTable = std::move(output).toDynamic();
 }
@@ -65,5 +65,11 @@ class Distinct : public Operation {
  private:
   virtual ResultTable computeResult() override;
 
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override {
+    return _subtree->getRootOperation()->pushDownSemiJoinFilter(variable,
+                                                                values);
+  }
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 };
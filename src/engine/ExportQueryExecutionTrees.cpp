@@ -21,8 +21,94 @@ auto getRowIndices(const LimitOffsetClause& limitOffset,
   return std::views::iota(limitOffset.actualOffset(idTable.size()),
                           limitOffset.upperBound(idTable.size()));
 }
+
+// Prefetch the strings of the exported rows (see `PrefetchedStrings`) in
+// batches of `PREFETCH_BATCH_SIZE` rows, so that the memory for the strings
+// stays bounded for large results.
+class PrefetchedStringsForRows {
+  static constexpr size_t PREFETCH_BATCH_SIZE = 10'000;
+  const Index& index_;
+  const IdTable& idTable_;
+  const QueryExecutionTree::ColumnIndicesAndTypes& columns_;
+  size_t endRow_;
+  size_t endOfBatch_ = 0;
+  ExportQueryExecutionTrees::PrefetchedStrings strings_;
+
+ public:
+  PrefetchedStringsForRows(
+      const Index& index, const IdTable& idTable,
+      const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+      const LimitOffsetClause& limitOffset)
+      : index_{index},
+        idTable_{idTable},
+        columns_{columns},
+        endRow_{limitOffset.upperBound(idTable.size())} {}
+
+  // Return the strings of a batch of rows that contains the `row`. The rows
+  // have to be requested in increasing order.
+  const ExportQueryExecutionTrees::PrefetchedStrings& get(size_t row) {
+    if (row >= endOfBatch_) {
+      endOfBatch_ = std::min(row + PREFETCH_BATCH_SIZE, endRow_);
+      strings_ = ExportQueryExecutionTrees::prefetchStrings(
+          index_, idTable_, columns_, row, endOfBatch_);
+    }
+    return strings_;
+  }
+};
+
+// Sort and deduplicate the `ids`.
+template <typename T>
+void sortAndRemoveDuplicates(std::vector<T>& ids) {
+  std::ranges::sort(ids);
+  auto duplicates = std::ranges::unique(ids);
+  ids.erase(duplicates.begin(), duplicates.end());
+}
 }  // namespace
 
+// _____________________________________________________________________________
+ExportQueryExecutionTrees::PrefetchedStrings
+ExportQueryExecutionTrees::prefetchStrings(
+    const Index& index, const IdTable& idTable,
+    const QueryExecutionTree::ColumnIndicesAndTypes& columns, size_t beginRow,
+    size_t endRow) {
+  std::vector<VocabIndex> vocabIndices;
+  std::vector<TextRecordIndex> cids;
+  for (const auto& column : columns) {
+    if (!column.has_value()) {
+      continue;
+    }
+    decltype(auto) col = idTable.getColumn(column->columnIndex_);
+    for (size_t row = beginRow; row < endRow; ++row) {
+      Id id = col[row];
+      if (id.getDatatype() == Datatype::VocabIndex) {
+        vocabIndices.push_back(id.getVocabIndex());
+      } else if (id.getDatatype() == Datatype::TextRecordIndex) {
+        cids.push_back(id.getTextRecordIndex());
+      }
+    }
+  }
+  PrefetchedStrings result;
+  if (!vocabIndices.empty()) {
+    sortAndRemoveDuplicates(vocabIndices);
+    std::vector<std::optional<std::string>> words =
+        index.idsToOptionalStrings(vocabIndices);
+    result.words_.reserve(vocabIndices.size());
+    for (size_t i = 0; i < vocabIndices.size(); ++i) {
+      if (words[i].has_value()) {
+        result.words_.emplace(vocabIndices[i], std::move(words[i].value()));
+      }
+    }
+  }
+  if (!cids.empty()) {
+    sortAndRemoveDuplicates(cids);
+    std::vector<std::string> excerpts = index.getTextExcerpts(cids);
+    for (size_t i = 0; i < cids.size(); ++i) {
+      result.textExcerpts_.emplace(cids[i], std::move(excerpts[i]));
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 cppcoro::generator<QueryExecutionTree::StringTriple>
 ExportQueryExecutionTrees::constructQueryResultToTriples(
@@ -108,17 +194,22 @@ nlohmann::json ExportQueryExecutionTrees::idTableToQLeverJSONArray(
   const IdTable& data = resultTable->idTable();
   nlohmann::json json = nlohmann::json::array();
 
+  const Index& index = qet.getQec()->getIndex();
+  PrefetchedStringsForRows prefetchedStrings{index, data, columns,
+                                             limitAndOffset};
   for (size_t rowIndex : getRowIndices(limitAndOffset, data)) {
     json.emplace_back();
     auto& row = json.back();
+    const auto& strings = prefetchedStrings.get(rowIndex);
     for (const auto& opt : columns) {
       if (!opt) {
         row.emplace_back(nullptr);
         continue;
       }
       const auto& currentId = data(rowIndex, opt->columnIndex_);
-      const auto& optionalStringAndXsdType = idToStringAndType(
-          qet.getQec()->getIndex(), currentId, resultTable->localVocab());
+      const auto& optionalStringAndXsdType =
+          idToStringAndType(index, currentId, resultTable->localVocab(),
+                            std::identity{}, &strings);
       if (!optionalStringAndXsdType.has_value()) {
         row.emplace_back(nullptr);
         continue;
@@ -164,6 +255,10 @@ ExportQueryExecutionTrees::idToStringAndTypeForEncodedValue(Id id) {
       return std::pair{std::to_string(id.getInt()), XSD_INT_TYPE};
     case Date:
       return id.getDate().toStringAndType();
+    case GeoPoint:
+      return id.getGeoPoint().toStringAndType();
+    case Decimal:
+      return id.getDecimal().toStringAndType();
     default:
       AD_FAIL();
   }
@@ -173,13 +268,15 @@ ExportQueryExecutionTrees::idToStringAndTypeForEncodedValue(Id id) {
 template <bool removeQuotesAndAngleBrackets, bool onlyReturnLiterals,
           typename EscapeFunction>
 std::optional<std::pair<std::string, const char*>>
-ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
-                                             const LocalVocab& localVocab,
-                                             EscapeFunction&& escapeFunction) {
+ExportQueryExecutionTrees::idToStringAndType(
+    const Index& index, Id id, const LocalVocab& localVocab,
+    EscapeFunction&& escapeFunction,
+    const PrefetchedStrings* prefetchedStrings) {
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (onlyReturnLiterals) {
-    if (!(datatype == VocabIndex || datatype == LocalVocabIndex)) {
+    if (!(datatype == VocabIndex || datatype == LocalVocabIndex ||
+          datatype == ShortString)) {
       return std::nullopt;
     }
   }
@@ -189,7 +286,16 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
     case Bool:
     case Int:
     case Date:
+    case GeoPoint:
+    case Decimal:
       return idToStringAndTypeForEncodedValue(id);
+    case ShortString: {
+      // Same as for the `VocabIndex` below, but without the vocabulary.
+      std::string word = removeQuotesAndAngleBrackets
+                             ? id.getShortString().getContent()
+                             : id.getShortString().toLiteral();
+      return std::pair{escapeFunction(std::move(word)), nullptr};
+    }
     case Datatype::WordVocabIndex: {
       std::optional<string> entity =
           index.idToOptionalString(id.getWordVocabIndex());
@@ -199,8 +305,16 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
     case VocabIndex: {
       // TODO<joka921> As soon as we get rid of the special encoding of date
       // values, we can use `index.getVocab().indexToOptionalString()` directly.
-      std::optional<string> entity =
-          index.idToOptionalString(id.getVocabIndex());
+      std::optional<string> entity;
+      if (prefetchedStrings != nullptr) {
+        if (auto it = prefetchedStrings->words_.find(id.getVocabIndex());
+            it != prefetchedStrings->words_.end()) {
+          entity = it->second;
+        }
+      }
+      if (!entity.has_value()) {
+        entity = index.idToOptionalString(id.getVocabIndex());
+      }
       AD_CONTRACT_CHECK(entity.has_value());
       if constexpr (onlyReturnLiterals) {
         if (!entity.value().starts_with('"')) {
@@ -225,10 +339,16 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
       }
       return std::pair{escapeFunction(std::move(word)), nullptr};
     }
-    case TextRecordIndex:
-      return std::pair{
-          escapeFunction(index.getTextExcerpt(id.getTextRecordIndex())),
-          nullptr};
+    case TextRecordIndex: {
+      auto cid = id.getTextRecordIndex();
+      if (prefetchedStrings != nullptr) {
+        const auto& excerpts = prefetchedStrings->textExcerpts_;
+        if (auto it = excerpts.find(cid); it != excerpts.end()) {
+          return std::pair{escapeFunction(std::string{it->second}), nullptr};
+        }
+      }
+      return std::pair{escapeFunction(index.getTextExcerpt(cid)), nullptr};
+    }
   }
   AD_FAIL();
 }
@@ -236,22 +356,25 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, false, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction,
+    const PrefetchedStrings* prefetchedStrings);
 
 // ___________________________________________________________________________
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, true, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction,
+    const PrefetchedStrings* prefetchedStrings);
 
 // This explicit instantiation is necessary because the `Variable` class
 // currently still uses it.
 // TODO<joka921> Refactor the CONSTRUCT export, then this is no longer
 // needed
 template std::optional<std::pair<std::string, const char*>>
-ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
-                                             const LocalVocab& localVocab,
-                                             std::identity&& escapeFunction);
+ExportQueryExecutionTrees::idToStringAndType(
+    const Index& index, Id id, const LocalVocab& localVocab,
+    std::identity&& escapeFunction,
+    const PrefetchedStrings* prefetchedStrings);
 
 // _____________________________________________________________________________
 nlohmann::json ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
@@ -341,14 +464,19 @@ nlohmann::json ExportQueryExecutionTrees::selectQueryResultToSparqlJSON(
     return b;
   };
 
+  const Index& index = qet.getQec()->getIndex();
+  PrefetchedStringsForRows prefetchedStrings{index, idTable, columns,
+                                             limitAndOffset};
   for (size_t rowIndex : getRowIndices(limitAndOffset, idTable)) {
     // TODO: ordered_json` entries are ordered alphabetically, but insertion
     // order would be preferable.
     nlohmann::ordered_json binding;
+    const auto& strings = prefetchedStrings.get(rowIndex);
     for (const auto& column : columns) {
       const auto& currentId = idTable(rowIndex, column->columnIndex_);
-      const auto& optionalValue = idToStringAndType(
-          qet.getQec()->getIndex(), currentId, resultTable->localVocab());
+      const auto& optionalValue =
+          idToStringAndType(index, currentId, resultTable->localVocab(),
+                            std::identity{}, &strings);
       if (!optionalValue.has_value()) {
         continue;
       }
@@ -452,15 +580,18 @@ ExportQueryExecutionTrees::selectQueryResultToStream(
   constexpr auto& escapeFunction = format == MediaType::tsv
                                        ? RdfEscaping::escapeForTsv
                                        : RdfEscaping::escapeForCsv;
+  const Index& index = qet.getQec()->getIndex();
+  PrefetchedStringsForRows prefetchedStrings{
+      index, idTable, selectedColumnIndices, limitAndOffset};
   for (size_t i : getRowIndices(limitAndOffset, idTable)) {
+    const auto& strings = prefetchedStrings.get(i);
     for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
       if (selectedColumnIndices[j].has_value()) {
         const auto& val = selectedColumnIndices[j].value();
         Id id = idTable(i, val.columnIndex_);
         auto optionalStringAndType =
             idToStringAndType<format == MediaType::csv>(
-                qet.getQec()->getIndex(), id, resultTable->localVocab(),
-                escapeFunction);
+                index, id, resultTable->localVocab(), escapeFunction, &strings);
         if (optionalStringAndType.has_value()) [[likely]] {
           co_yield optionalStringAndType.value().first;
         }
@@ -472,12 +603,14 @@ ExportQueryExecutionTrees::selectQueryResultToStream(
 }
 
 // Convert a single ID to an XML binding of the given `variable`.
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const auto& index, const auto& localVocab) {
+static std::string idToXMLBinding(
+    std::string_view variable, Id id, const auto& index,
+    const auto& localVocab,
+    const ExportQueryExecutionTrees::PrefetchedStrings& prefetchedStrings) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ExportQueryExecutionTrees::idToStringAndType(index, id, localVocab);
+  const auto& optionalValue = ExportQueryExecutionTrees::idToStringAndType(
+      index, id, localVocab, std::identity{}, &prefetchedStrings);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -573,15 +706,19 @@ ad_utility::streams::stream_generator ExportQueryExecutionTrees::
   const auto& idTable = resultTable->idTable();
   auto selectedColumnIndices =
       qet.selectedVariablesToColumnIndices(selectClause, false);
+  const Index& index = qet.getQec()->getIndex();
+  PrefetchedStringsForRows prefetchedStrings{
+      index, idTable, selectedColumnIndices, limitAndOffset};
   // TODO<joka921> we could prefilter for the nonexisting variables.
   for (size_t i : getRowIndices(limitAndOffset, idTable)) {
     co_yield "\n  <result>";
+    const auto& strings = prefetchedStrings.get(i);
     for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
       if (selectedColumnIndices[j].has_value()) {
         const auto& val = selectedColumnIndices[j].value();
         Id id = idTable(i, val.columnIndex_);
-        co_yield idToXMLBinding(val.variable_, id, qet.getQec()->getIndex(),
-                                resultTable->localVocab());
+        co_yield idToXMLBinding(val.variable_, id, index,
+                                resultTable->localVocab(), strings);
       }
     }
     co_yield "\n  </result>";
@@ -6,6 +6,7 @@
 
 #include "engine/QueryExecutionTree.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/HashMap.h"
 #include "util/http/MediaTypes.h"
 #include "util/json.h"
 
@@ -57,6 +58,25 @@ class ExportQueryExecutionTrees {
                                             uint64_t maxSend,
                                             MediaType mediaType);
 
+  // The strings of the `Id`s in (a part of) an exported result that are
+  // expensive to resolve one at a time. The `VocabIndex`es are collected,
+  // sorted, and deduplicated, and then resolved with a single call to
+  // `Index::idsToOptionalStrings` (which reads the externalized vocabulary
+  // sequentially). The texts of the `TextRecordIndex`es are resolved with a
+  // single call to `Index::getTextExcerpts` (which decompresses each block of
+  // the DocsDB only once).
+  struct PrefetchedStrings {
+    ad_utility::HashMap<VocabIndex, std::string> words_;
+    ad_utility::HashMap<TextRecordIndex, std::string> textExcerpts_;
+  };
+
+  // Prefetch the strings of all the `VocabIndex`es and `TextRecordIndex`es in
+  // the `columns` of the rows `[beginRow, endRow)` of the `idTable`.
+  static PrefetchedStrings prefetchStrings(
+      const Index& index, const IdTable& idTable,
+      const QueryExecutionTree::ColumnIndicesAndTypes& columns, size_t beginRow,
+      size_t endRow);
+
   // Convert the `id` to a human-readable string. The `index` is used to resolve
   // `Id`s with datatype `VocabIndex` or `TextRecordIndex`. The `localVocab` is
   // used to resolve `Id`s with datatype `LocalVocabIndex`. The `escapeFunction`
@@ -75,12 +95,17 @@ class ExportQueryExecutionTrees {
   //
   // TODO<joka921> Make it private again as soon as the evaluation of construct
   // queries is completely performed inside this module.
+  //
+  // If `prefetchedStrings` is given, the strings of `Id`s with datatype
+  // `VocabIndex` or `TextRecordIndex` are looked up there first (see
+  // `PrefetchedStrings` above).
   template <bool removeQuotesAndAngleBrackets = false,
             bool returnOnlyLiterals = false,
             typename EscapeFunction = std::identity>
   static std::optional<std::pair<std::string, const char*>> idToStringAndType(
       const Index& index, Id id, const LocalVocab& localVocab,
-      EscapeFunction&& escapeFunction = EscapeFunction{});
+      EscapeFunction&& escapeFunction = EscapeFunction{},
+      const PrefetchedStrings* prefetchedStrings = nullptr);
 
   // Same as the previous function, but only handles the datatypes for which the
   // value is encoded directly in the ID. For other datatypes an exception is
@@ -0,0 +1,126 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/FactorizedStarJoin.h"
+
+#include <algorithm>
+
+#include "engine/Join.h"
+
+namespace {
+// The implementation of `getInputs`, which returns false if the `tree` is not
+// a star join on the `center`.
+bool collectInputs(QueryExecutionTree& tree, const Variable& center,
+                   std::vector<FactorizedStarJoin::Input>& inputs,
+                   std::vector<Join*>& joins) {
+  auto* join = dynamic_cast<Join*>(tree.getRootOperation().get());
+  if (join != nullptr && join->getJoinVariable() == center) {
+    for (auto* child : join->getChildren()) {
+      if (!collectInputs(*child, center, inputs, joins)) {
+        return false;
+      }
+    }
+    joins.push_back(join);
+    return true;
+  }
+  // The three-variable scans of a `Join` with a full scan dummy are never
+  // computed.
+  if (tree.getType() == QueryExecutionTree::SCAN &&
+      tree.getResultWidth() == 3) {
+    return false;
+  }
+  const auto& varCols = tree.getVariableColumns();
+  auto it = varCols.find(center);
+  if (it == varCols.end() ||
+      it->second.mightContainUndef_ !=
+          ColumnIndexAndTypeInfo::AlwaysDefined) {
+    return false;
+  }
+  ColumnIndex column = it->second.columnIndex_;
+  const auto& sortedOn = tree.getRootOperation()->getResultSortedOn();
+  if (sortedOn.empty() || sortedOn.front() != column) {
+    return false;
+  }
+  inputs.push_back({&tree, column});
+  return true;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<std::vector<FactorizedStarJoin::Input>>
+FactorizedStarJoin::getInputs(QueryExecutionTree& tree, const Variable& center,
+                              std::vector<Join*>* joins) {
+  std::vector<Input> inputs;
+  std::vector<Join*> joinsOfTree;
+  if (!collectInputs(tree, center, inputs, joinsOfTree) || inputs.size() < 2) {
+    return std::nullopt;
+  }
+  if (joins != nullptr) {
+    joins->insert(joins->end(), joinsOfTree.begin(), joinsOfTree.end());
+  }
+  return inputs;
+}
+
+// _____________________________________________________________________________
+FactorizedStarJoin::FactorizedStarJoin(
+    std::vector<Input> inputs, const std::function<void()>& checkCancellation)
+    : inputs_{std::move(inputs)} {
+  AD_CONTRACT_CHECK(!inputs_.empty());
+  std::vector<std::span<const Id>> columns;
+  for (const auto& input : inputs_) {
+    results_.push_back(input.tree_->getResult());
+    columns.push_back(
+        results_.back()->idTable().getColumn(input.centerColumn_));
+  }
+
+  // Intersect the sorted center columns: Move each input to the first row
+  // that is not smaller than the largest current value, until all the inputs
+  // are at the same value, which is then the center of the next group.
+  std::vector<size_t> positions(inputs_.size(), 0);
+  auto atEnd = [&](size_t i) { return positions[i] == columns[i].size(); };
+  while (!std::ranges::any_of(std::views::iota(0UL, inputs_.size()), atEnd)) {
+    checkCancellation();
+    Id maxValue = columns[0][positions[0]];
+    for (size_t i = 1; i < inputs_.size(); ++i) {
+      maxValue = std::max(maxValue, columns[i][positions[i]]);
+    }
+    bool allEqual = true;
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      auto column = columns[i];
+      positions[i] = std::ranges::lower_bound(column.subspan(positions[i]),
+                                              maxValue) -
+                     column.begin();
+      allEqual = allEqual && !atEnd(i) && column[positions[i]] == maxValue;
+    }
+    if (!allEqual) {
+      continue;
+    }
+    centers_.push_back(maxValue);
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      auto column = columns[i];
+      size_t end = std::ranges::upper_bound(column.subspan(positions[i]),
+                                            maxValue) -
+                   column.begin();
+      ranges_.push_back({positions[i], end});
+      positions[i] = end;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::multiplicity(size_t group, size_t input) const {
+  size_t result = 1;
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (i != input) {
+      const auto& [begin, end] = range(group, i);
+      result *= end - begin;
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+size_t FactorizedStarJoin::numRowsFlattened(size_t group) const {
+  const auto& [begin, end] = range(group, 0);
+  return multiplicity(group, 0) * (end - begin);
+}
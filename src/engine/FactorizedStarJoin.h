@@ -0,0 +1,78 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "engine/QueryExecutionTree.h"
+#include "engine/ResultTable.h"
+
+class Join;
+
+// The result of a join of several inputs on a single variable (the "center"),
+// for example the star `?s <p1> ?a . ?s <p2> ?b . ?s <p3> ?c`, in a factorized
+// representation. A `Join` computes the cross product of the matching rows of
+// the inputs for each value of the center, which explodes if the properties
+// have many values. Instead, there is one group per value of the center that
+// is contained in all the inputs, and the group consists of one range of rows
+// of each input. The rows of the flattened join result for a group are all the
+// combinations of one row from each of its ranges.
+class FactorizedStarJoin {
+ public:
+  struct Input {
+    QueryExecutionTree* tree_;
+    ColumnIndex centerColumn_;
+  };
+
+ private:
+  std::vector<Input> inputs_;
+  // The (materialized) results of the `inputs_`, each sorted by its center
+  // column.
+  std::vector<std::shared_ptr<const ResultTable>> results_;
+  // The value of the center for each group.
+  std::vector<Id> centers_;
+  // The range of rows `[begin, end)` of input `i` for group `g` is
+  // `ranges_[g * inputs_.size() + i]`.
+  std::vector<std::array<size_t, 2>> ranges_;
+
+ public:
+  // If the `tree` is a star join on the `center`, that is a tree of `Join`s on
+  // the `center` the leaves of which are sorted by the `center` and never have
+  // an undefined value in its column, return the leaves (the inputs of the
+  // star join). The `Join`s are appended to the `joins` in postorder. Else
+  // return `std::nullopt`. Nothing is computed by this function.
+  static std::optional<std::vector<Input>> getInputs(
+      QueryExecutionTree& tree, const Variable& center,
+      std::vector<Join*>* joins = nullptr);
+
+  // Compute the results of the `inputs` (see `getInputs`) and the groups. The
+  // `checkCancellation` function is called regularly.
+  FactorizedStarJoin(std::vector<Input> inputs,
+                     const std::function<void()>& checkCancellation);
+
+  size_t numGroups() const { return centers_.size(); }
+  size_t numInputs() const { return inputs_.size(); }
+  const Input& input(size_t i) const { return inputs_.at(i); }
+  const ResultTable& result(size_t i) const { return *results_.at(i); }
+
+  // The value of the center of the `group`.
+  Id center(size_t group) const { return centers_.at(group); }
+
+  // The rows `[begin, end)` of the result of the `input` for the `group`.
+  const std::array<size_t, 2>& range(size_t group, size_t input) const {
+    return ranges_.at(group * inputs_.size() + input);
+  }
+
+  // The number of rows of the flattened join result of the `group` that
+  // contain a given row of the `input`, which is the product of the sizes of
+  // the ranges of the other inputs.
+  size_t multiplicity(size_t group, size_t input) const;
+
+  // The number of rows of the flattened join result of the `group`.
+  size_t numRowsFlattened(size_t group) const;
+};
@@ -7,14 +7,18 @@
 #include "./Filter.h"
 
 #include <algorithm>
+#include <cmath>
 #include <optional>
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
+#include "engine/IndexScan.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/sparqlExpressions/ParallelEvaluation.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "index/ColumnStatistics.h"
 
 using std::endl;
 using std::string;
@@ -44,6 +48,7 @@ string Filter::getDescriptor() const {
 
 // _____________________________________________________________________________
 ResultTable Filter::computeResult() {
+  restrictScanToGeoBoundingBox();
   LOG(DEBUG) << "Getting sub-result for Filter result computation..." << endl;
   shared_ptr<const ResultTable> subRes = _subtree->getResult();
   LOG(DEBUG) << "Filter result computation..." << endl;
@@ -58,77 +63,197 @@ ResultTable Filter::computeResult() {
   return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
 
+// _____________________________________________________________________________
+void Filter::restrictScanToGeoBoundingBox() {
+  const size_t maxNumRanges =
+      RuntimeParameters().get<"geo-filter-max-num-ranges">();
+  auto box = _expression.getGeoBoundingBox();
+  auto* scan = dynamic_cast<IndexScan*>(_subtree->getRootOperation().get());
+  if (maxNumRanges == 0 || !box.has_value() || scan == nullptr) {
+    return;
+  }
+  // Don't replace a result from the cache by a restricted result that has to
+  // be computed.
+  if (getExecutionContext()->getQueryTreeCache().cacheContains(
+          _subtree->getCacheKey())) {
+    return;
+  }
+  // The `GeoPoint` with the given bits. For `2^60` this is the smallest `Id`
+  // of the next datatype.
+  const uint64_t firstPointBits =
+      Id::makeFromGeoPoint(GeoPoint::fromBits(0)).getBits();
+  auto toId = [firstPointBits](uint64_t bits) {
+    return Id::fromBits(firstPointBits + bits);
+  };
+  // The values that are not points are kept, because literals that were not
+  // folded into `GeoPoint`s (for example WKT points without the datatype
+  // `geo:wktLiteral`) may match as well.
+  auto zOrderRanges = box.value().box_.zOrderRanges(maxNumRanges);
+  std::vector<std::pair<Id, Id>> ranges{{Id::min(), toId(0)}};
+  for (auto [first, second] : zOrderRanges) {
+    ranges.emplace_back(toId(first), toId(second));
+  }
+  ranges.emplace_back(toId(uint64_t{1} << GeoPoint::numDataBits), Id::max());
+  if (scan->restrictFirstColumnToRanges(box.value().variable_,
+                                        std::move(ranges))) {
+    runtimeInfo().addDetail("num-geo-ranges", zOrderRanges.size());
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t WIDTH>
 void Filter::computeFilterImpl(IdTable* outputIdTable,
                                const ResultTable& inputResultTable) {
-  sparqlExpression::EvaluationContext evaluationContext(
-      *getExecutionContext(), _subtree->getVariableColumns(),
-      inputResultTable.idTable(), getExecutionContext()->getAllocator(),
-      inputResultTable.localVocab());
+  const auto input = inputResultTable.idTable().asStaticView<WIDTH>();
 
-  // TODO<joka921> This should be a mandatory argument to the EvaluationContext
-  // constructor.
-  evaluationContext._columnsByWhichResultIsSorted = inputResultTable.sortedBy();
+  // Evaluate the expression on the rows `[beginIndex, endIndex)` of the input
+  // and return the rows for which it is true. The chunks of a large input are
+  // evaluated concurrently (see `evaluateInChunks`).
+  auto filterChunk = [&](size_t beginIndex, size_t endIndex) {
+    checkCancellation();
+    sparqlExpression::EvaluationContext evaluationContext(
+        *getExecutionContext(), _subtree->getVariableColumns(),
+        inputResultTable.idTable(), beginIndex, endIndex,
+        getExecutionContext()->getAllocator(), inputResultTable.localVocab());
 
-  sparqlExpression::ExpressionResult expressionResult =
-      _expression.getPimpl()->evaluate(&evaluationContext);
+    // TODO<joka921> This should be a mandatory argument to the
+    // EvaluationContext constructor.
+    evaluationContext._columnsByWhichResultIsSorted =
+        inputResultTable.sortedBy();
+    evaluationContext._cancellationHandle = cancellationHandle_;
 
-  const auto input = inputResultTable.idTable().asStaticView<WIDTH>();
-  auto output = std::move(*outputIdTable).toStatic<WIDTH>();
+    sparqlExpression::ExpressionResult expressionResult =
+        _expression.getPimpl()->evaluate(&evaluationContext);
 
-  auto visitor =
-      [&]<sparqlExpression::SingleExpressionResult T>(T&& singleResult) {
-        if constexpr (std::is_same_v<T, ad_utility::SetOfIntervals>) {
-          auto totalSize = std::accumulate(
-              singleResult._intervals.begin(), singleResult._intervals.end(),
-              0ul, [](const auto& sum, const auto& interval) {
-                return sum + (interval.second - interval.first);
-              });
-          output.reserve(totalSize);
-          for (auto [beg, end] : singleResult._intervals) {
-            AD_CONTRACT_CHECK(end <= input.size());
-            output.insertAtEnd(input.cbegin() + beg, input.cbegin() + end);
-          }
-          AD_CONTRACT_CHECK(output.size() == totalSize);
-        } else {
-          // All other results are converted to boolean values via the
-          // `EffectiveBooleanValueGetter`. This means for example, that zero,
-          // UNDEF, and empty strings are filtered out.
-          // TODO<joka921> Check whether it's feasible to precompute and reserve
-          // the total size. This depends on the expensiveness of the
-          // `EffectiveBooleanValueGetter`.
-          auto resultGenerator = sparqlExpression::detail::makeGenerator(
-              std::forward<T>(singleResult), input.size(), &evaluationContext);
-          size_t i = 0;
-
-          using EBV = sparqlExpression::detail::EffectiveBooleanValueGetter;
-          for (auto&& resultValue : resultGenerator) {
-            if (EBV{}(resultValue, &evaluationContext) == EBV::Result::True) {
-              output.push_back(input[i]);
+    IdTable chunkOutput{input.numColumns(),
+                        getExecutionContext()->getAllocator()};
+    auto output = std::move(chunkOutput).toStatic<WIDTH>();
+    const size_t chunkSize = endIndex - beginIndex;
+
+    auto visitor =
+        [&]<sparqlExpression::SingleExpressionResult T>(T&& singleResult) {
+          if constexpr (std::is_same_v<T, ad_utility::SetOfIntervals>) {
+            // The intervals are relative to the `beginIndex`.
+            auto totalSize = std::accumulate(
+                singleResult._intervals.begin(), singleResult._intervals.end(),
+                0ul, [](const auto& sum, const auto& interval) {
+                  return sum + (interval.second - interval.first);
+                });
+            output.reserve(totalSize);
+            for (auto [beg, end] : singleResult._intervals) {
+              AD_CONTRACT_CHECK(end <= chunkSize);
+              output.insertAtEnd(input.cbegin() + beginIndex + beg,
+                                 input.cbegin() + beginIndex + end);
+            }
+            AD_CONTRACT_CHECK(output.size() == totalSize);
+          } else {
+            // All other results are converted to boolean values via the
+            // `EffectiveBooleanValueGetter`. This means for example, that zero,
+            // UNDEF, and empty strings are filtered out.
+            // TODO<joka921> Check whether it's feasible to precompute and
+            // reserve the total size. This depends on the expensiveness of the
+            // `EffectiveBooleanValueGetter`.
+            auto resultGenerator = sparqlExpression::detail::makeGenerator(
+                std::forward<T>(singleResult), chunkSize, &evaluationContext);
+            size_t i = beginIndex;
+
+            using EBV = sparqlExpression::detail::EffectiveBooleanValueGetter;
+            for (auto&& resultValue : resultGenerator) {
+              if (EBV{}(resultValue, &evaluationContext) ==
+                  EBV::Result::True) {
+                output.push_back(input[i]);
+              }
+              ++i;
             }
-            ++i;
           }
-        }
-      };
+        };
 
-  std::visit(visitor, std::move(expressionResult));
+    std::visit(visitor, std::move(expressionResult));
+    return output;
+  };
 
+  auto chunks =
+      sparqlExpression::detail::evaluateInChunks(input.size(), filterChunk);
+  if (chunks.size() == 1) {
+    *outputIdTable = std::move(chunks.front()).toDynamic();
+    return;
+  }
+  // Concatenate the results of the chunks in order.
+  auto output = std::move(*outputIdTable).toStatic<WIDTH>();
+  size_t totalSize = 0;
+  for (const auto& chunk : chunks) {
+    totalSize += chunk.size();
+  }
+  output.reserve(totalSize);
+  for (auto& chunk : chunks) {
+    checkCancellation();
+    // Move the chunk, s.t. its memory is released early.
+    auto rows = std::move(chunk);
+    output.insertAtEnd(rows.cbegin(), rows.cend());
+  }
   *outputIdTable = std::move(output).toDynamic();
 }
 
 // _____________________________________________________________________________
 uint64_t Filter::getSizeEstimateBeforeLimit() {
-  return _expression
-      .getEstimatesForFilterExpression(
-          _subtree->getSizeEstimate(),
-          _subtree->getRootOperation()->getPrimarySortKeyVariable())
-      .sizeEstimate;
+  uint64_t inputSize = _subtree->getSizeEstimate();
+  uint64_t sizeEstimate =
+      _expression
+          .getEstimatesForFilterExpression(
+              inputSize,
+              _subtree->getRootOperation()->getPrimarySortKeyVariable())
+          .sizeEstimate;
+  // For substring filters, the trigram index (if it exists) yields the
+  // fraction of the vocabulary that can possibly match, which is typically
+  // much smaller than the generic estimate.
+  auto selectivity =
+      getIndex().getSubstringSelectivity(_expression.getRequiredSubstrings());
+  if (selectivity.has_value()) {
+    sizeEstimate = std::min(
+        sizeEstimate, static_cast<uint64_t>(std::ceil(
+                          selectivity.value() * static_cast<double>(inputSize))));
+  }
+  // For a comparison of a variable with a constant, the histogram of the
+  // column of the variable (if it is known) yields the fraction of the matching
+  // rows. Like for the substring filters, the smaller estimate is used.
+  if (auto comparison = _expression.getVariableComparison()) {
+    const auto& columns = _subtree->getVariableColumns();
+    auto it = columns.find(comparison->variable_);
+    auto statistics =
+        it != columns.end()
+            ? _subtree->getRootOperation()->getColumnStatistics(
+                  it->second.columnIndex_)
+            : nullptr;
+    if (statistics != nullptr) {
+      sizeEstimate = std::min(
+          sizeEstimate, static_cast<uint64_t>(std::ceil(
+                            statistics->estimateSelectivity(
+                                comparison->comparison_, comparison->constant_) *
+                            static_cast<double>(inputSize))));
+    }
+  }
+  return sizeEstimate;
 }
 
 // _____________________________________________________________________________
 size_t Filter::getCostEstimate() {
-  return _subtree->getCostEstimate() +
+  size_t subtreeCost = _subtree->getCostEstimate();
+  // Only the blocks of a scan that can contain points in the bounding box are
+  // read (see `restrictScanToGeoBoundingBox`). Their fraction is estimated by
+  // the fraction of the area of the map that is covered by the box.
+  auto box = _expression.getGeoBoundingBox();
+  auto* scan = dynamic_cast<IndexScan*>(_subtree->getRootOperation().get());
+  if (RuntimeParameters().get<"geo-filter-max-num-ranges">() > 0 &&
+      box.has_value() && scan != nullptr &&
+      scan->canBeRestrictedToRanges(box.value().variable_)) {
+    const auto& b = box.value().box_;
+    double fraction = b.isEmpty() ? 0.0
+                                  : (b.maxLat_ - b.minLat_) / 180.0 *
+                                        (b.maxLng_ - b.minLng_) / 360.0;
+    subtreeCost = static_cast<size_t>(
+        std::ceil(std::min(fraction, 1.0) * static_cast<double>(subtreeCost)));
+  }
+  return subtreeCost +
          _expression
              .getEstimatesForFilterExpression(
                  _subtree->getSizeEstimate(),
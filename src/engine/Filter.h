@@ -45,6 +45,9 @@ class Filter : public Operation {
   size_t getCostEstimate() override;
 
   std::shared_ptr<QueryExecutionTree> getSubtree() const { return _subtree; };
+  const sparqlExpression::SparqlExpressionPimpl& getExpression() const {
+    return _expression;
+  }
   std::vector<QueryExecutionTree*> getChildren() override {
     return {_subtree.get()};
   }
@@ -62,6 +65,18 @@ class Filter : public Operation {
 
   ResultTable computeResult() override;
 
+  // If the `_expression` can only be true for the points in a bounding box
+  // (see `SparqlExpression::getGeoBoundingBox`) and the `_subtree` is a scan
+  // that is sorted by the variable of the box, only read the blocks of the
+  // scan that can contain such points (see `GeoPoint`).
+  void restrictScanToGeoBoundingBox();
+
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override {
+    return _subtree->getRootOperation()->pushDownSemiJoinFilter(variable,
+                                                                values);
+  }
+
   template <size_t WIDTH>
   void computeFilterImpl(IdTable* outputIdTable,
                          const ResultTable& inputResultTable);
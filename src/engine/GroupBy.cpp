@@ -8,6 +8,8 @@
 
 #include "absl/strings/str_join.h"
 #include "engine/CallFixedSize.h"
+#include "engine/FactorizedStarJoin.h"
+#include "engine/Filter.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/Sort.h"
@@ -15,6 +17,7 @@
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/SampleExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "index/Index.h"
@@ -250,6 +253,7 @@ void GroupBy::doGroupBy(const IdTable& dynInput,
   // result variable from a previous alias as an input.
   evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
       _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._cancellationHandle = cancellationHandle_;
   evaluationContext._variableToColumnMapPreviousResults =
       getInternallyVisibleVariableColumns();
   evaluationContext._previousResultsFromSameGroup.resize(getResultWidth());
@@ -316,6 +320,10 @@ ResultTable GroupBy::computeResult() {
     return {std::move(idTable), resultSortedOn(), LocalVocab{}};
   }
 
+  if (auto result = computeGroupByForStarJoin()) {
+    return std::move(result).value();
+  }
+
   std::vector<Aggregate> aggregates;
   aggregates.reserve(_aliases.size() + _groupByVariables.size());
 
@@ -447,6 +455,123 @@ bool GroupBy::computeGroupByForSingleIndexScan(IdTable* result) {
   return true;
 }
 
+// _____________________________________________________________________________
+bool GroupBy::computeGroupByFromIndexSummaries(IdTable* result) {
+  if (!RuntimeParameters().get<"use-index-aggregate-summaries">() ||
+      !_groupByVariables.empty() || _aliases.size() != 1) {
+    return false;
+  }
+  using namespace sparqlExpression;
+  enum struct Aggregate { Count, CountDistinct, Min, Max };
+  auto* expr = _aliases.front()._expression.getPimpl();
+  std::optional<Variable> variable;
+  Aggregate aggregate = Aggregate::Count;
+  if (auto count = expr->getVariableForCount()) {
+    variable = std::move(count->variable_);
+    aggregate =
+        count->isDistinct_ ? Aggregate::CountDistinct : Aggregate::Count;
+  } else if (hasAnyType<MinExpression, MaxExpression>(expr)) {
+    auto* child =
+        dynamic_cast<const VariableExpression*>(expr->children()[0].get());
+    if (child == nullptr) {
+      return false;
+    }
+    variable = child->value();
+    aggregate = hasType<MinExpression>(expr) ? Aggregate::Min : Aggregate::Max;
+  } else {
+    return false;
+  }
+
+  // Collect the comparisons of the `Filter`s on top of the `IndexScan`.
+  std::vector<Permutation::ValueComparison> comparisons;
+  QueryExecutionTree* tree = _subtree.get();
+  while (auto* filter =
+             dynamic_cast<Filter*>(tree->getRootOperation().get())) {
+    auto comparison = filter->getExpression().getVariableComparison();
+    if (!comparison.has_value() || comparison->variable_ != variable ||
+        !RelationSummary::isNumeric(comparison->constant_)) {
+      return false;
+    }
+    comparisons.push_back({comparison->comparison_, comparison->constant_});
+    tree = filter->getSubtree().get();
+  }
+  auto* indexScan = dynamic_cast<IndexScan*>(tree->getRootOperation().get());
+  if (indexScan == nullptr) {
+    return false;
+  }
+
+  // The predicate must be fixed, and the variable must be the only variable
+  // or the other variable of the triple. The permutation is chosen s.t. the
+  // variable is its last column.
+  const auto& subject = indexScan->getSubject();
+  const auto& predicate = indexScan->getPredicate();
+  const auto& object = indexScan->getObject();
+  auto isVariable = [&variable](const TripleComponent& component) {
+    return component.isVariable() && component.getVariable() == variable;
+  };
+  if (predicate.isVariable() || isVariable(subject) == isVariable(object) ||
+      indexScan->getResultWidth() !=
+          static_cast<size_t>(subject.isVariable() + object.isVariable())) {
+    return false;
+  }
+  bool isSubject = isVariable(subject);
+  const auto& other = isSubject ? object : subject;
+  const auto& vocab = getIndex().getVocab();
+  auto col0Id = predicate.toValueId(vocab);
+  std::optional<Id> col1Id;
+  if (!other.isVariable()) {
+    col1Id = other.toValueId(vocab);
+    if (!col1Id.has_value()) {
+      return false;
+    }
+  }
+  if (!col0Id.has_value()) {
+    return false;
+  }
+  // For a fixed `col1`, the variable is the `col2` of the permutation, and
+  // else its `col1`.
+  using enum Permutation::Enum;
+  auto permutation = isSubject == col1Id.has_value() ? POS : PSO;
+  const auto& impl = getIndex().getImpl();
+  if (!impl.getPermutation(permutation).isLoaded_) {
+    return false;
+  }
+
+  auto aggregates = impl.getPermutation(permutation)
+                        .aggregateColumn(col0Id.value(), col1Id, comparisons,
+                                         cancellationHandle_);
+  bool isMinOrMax = aggregate == Aggregate::Min || aggregate == Aggregate::Max;
+  if (isMinOrMax && !aggregates.allValuesAreNumeric_) {
+    return false;
+  }
+  // Like `doGroupBy`, the result is empty if there are no values.
+  auto& table = *result;
+  table.setNumColumns(1);
+  if (aggregates.count_ != 0) {
+    Id value = Id::makeUndefined();
+    switch (aggregate) {
+      case Aggregate::Count:
+        value = Id::makeFromInt(static_cast<int64_t>(aggregates.count_));
+        break;
+      case Aggregate::CountDistinct:
+        value = Id::makeFromInt(static_cast<int64_t>(aggregates.numDistinct_));
+        break;
+      case Aggregate::Min:
+        value = aggregates.min_;
+        break;
+      case Aggregate::Max:
+        value = aggregates.max_;
+        break;
+    }
+    table.emplace_back();
+    table(0, 0) = value;
+  }
+
+  // The `IndexScan` and the `Filter`s were not computed.
+  _subtree->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+  return true;
+}
+
 // _____________________________________________________________________________
 bool GroupBy::computeGroupByForFullIndexScan(IdTable* result) {
   if (_groupByVariables.size() != 1) {
@@ -692,12 +817,184 @@ bool GroupBy::computeGroupByForJoinWithFullScan(IdTable* result) {
   return true;
 }
 
+// _____________________________________________________________________________
+std::optional<ResultTable> GroupBy::computeGroupByForStarJoin() {
+  if (!RuntimeParameters().get<"use-group-by-factorized-star-join">() ||
+      _groupByVariables.size() != 1) {
+    return std::nullopt;
+  }
+  const Variable& center = _groupByVariables.front();
+  std::vector<Join*> joins;
+  auto inputs = FactorizedStarJoin::getInputs(*_subtree, center, &joins);
+  if (!inputs.has_value()) {
+    return std::nullopt;
+  }
+  // Without a large blow-up, the `Join` (which may read its inputs lazily and
+  // skip the blocks of a scan that have no match in the other inputs) is
+  // cheaper. With a large blow-up, most of the rows of each input have a
+  // match, so there is not much to skip.
+  size_t sizeOfInputs = 0;
+  for (const auto& input : inputs.value()) {
+    sizeOfInputs += input.tree_->getSizeEstimate();
+  }
+  if (static_cast<double>(_subtree->getSizeEstimate()) <
+      RuntimeParameters().get<"group-by-star-join-min-blow-up">() *
+          static_cast<double>(sizeOfInputs)) {
+    return std::nullopt;
+  }
+
+  // How the value of an aggregate on the range of rows of its input has to
+  // be adapted to the multiplicity of these rows in the flattened join result.
+  enum struct Adaptation { None, MultiplyCount, RepeatGroupConcat };
+  struct StarJoinAggregate {
+    sparqlExpression::SparqlExpression* expression_;
+    size_t outCol_;
+    size_t input_;
+    Adaptation adaptation_;
+    std::string separator_;
+  };
+  std::vector<StarJoinAggregate> aggregates;
+  const auto& varColMap = getInternallyVisibleVariableColumns();
+  for (Alias& alias : _aliases) {
+    using namespace sparqlExpression;
+    auto* expr = alias._expression.getPimpl();
+    if (!expr->isAggregate() ||
+        std::ranges::any_of(expr->children(), [](const auto& child) {
+          return child->containsAggregate();
+        })) {
+      return std::nullopt;
+    }
+    Adaptation adaptation = Adaptation::None;
+    std::string separator;
+    if (hasAnyType<SampleExpression, MinExpression, MaxExpression,
+                   AvgExpression>(expr)) {
+      // These don't depend on the multiplicities.
+    } else if (hasType<CountExpression>(expr)) {
+      if (!expr->isDistinct()) {
+        adaptation = Adaptation::MultiplyCount;
+      }
+    } else if (auto groupConcat = hasType<GroupConcatExpression>(expr)) {
+      if (!expr->isDistinct()) {
+        adaptation = Adaptation::RepeatGroupConcat;
+        separator = groupConcat.value()->separator();
+      }
+    } else {
+      return std::nullopt;
+    }
+    auto variables = expr->containedVariables();
+    auto input = std::ranges::find_if(inputs.value(), [&](const auto& input) {
+      const auto& columns = input.tree_->getVariableColumns();
+      return std::ranges::all_of(variables, [&columns](const Variable* v) {
+        return columns.contains(*v);
+      });
+    });
+    if (input == inputs->end()) {
+      return std::nullopt;
+    }
+    aggregates.push_back(StarJoinAggregate{
+        expr, varColMap.at(alias._target).columnIndex_,
+        static_cast<size_t>(input - inputs->begin()), adaptation,
+        std::move(separator)});
+  }
+
+  FactorizedStarJoin starJoin{std::move(inputs).value(),
+                              [this]() { checkCancellation(); }};
+  // Like for a `Join`, at most one of the inputs may have a local vocab.
+  std::optional<size_t> inputWithLocalVocab;
+  for (size_t i = 0; i < starJoin.numInputs(); ++i) {
+    if (!starJoin.result(i).localVocab().empty()) {
+      if (inputWithLocalVocab.has_value()) {
+        return std::nullopt;
+      }
+      inputWithLocalVocab = i;
+    }
+  }
+  LocalVocab localVocab =
+      inputWithLocalVocab.has_value()
+          ? starJoin.result(inputWithLocalVocab.value()).getCopyOfLocalVocab()
+          : LocalVocab{};
+  for (Join* join : joins) {
+    std::vector<std::shared_ptr<RuntimeInformation>> children;
+    for (auto* child : join->getChildren()) {
+      children.push_back(child->getRootOperation()->getRuntimeInfoPointer());
+    }
+    join->updateRuntimeInformationWhenOptimizedOut(std::move(children));
+  }
+
+  // One evaluation context for each input that is read by an aggregate.
+  std::vector<std::optional<sparqlExpression::EvaluationContext>> contexts(
+      starJoin.numInputs());
+  for (const auto& aggregate : aggregates) {
+    size_t i = aggregate.input_;
+    if (contexts.at(i).has_value()) {
+      continue;
+    }
+    auto& context = contexts.at(i).emplace(
+        *getExecutionContext(), starJoin.input(i).tree_->getVariableColumns(),
+        starJoin.result(i).idTable(), getExecutionContext()->getAllocator(),
+        starJoin.result(i).localVocab());
+    context._groupedVariables = ad_utility::HashSet<Variable>{center};
+    context._cancellationHandle = cancellationHandle_;
+    context._variableToColumnMapPreviousResults = varColMap;
+    context._previousResultsFromSameGroup.resize(getResultWidth());
+    context._isPartOfGroupBy = true;
+  }
+
+  IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
+  result.resize(starJoin.numGroups());
+  for (size_t group = 0; group < starJoin.numGroups(); ++group) {
+    checkCancellation();
+    result(group, 0) = starJoin.center(group);
+    for (const auto& aggregate : aggregates) {
+      auto& context = contexts.at(aggregate.input_).value();
+      const auto& [begin, end] = starJoin.range(group, aggregate.input_);
+      context._beginIndex = begin;
+      context._endIndex = end;
+      size_t multiplicity = starJoin.multiplicity(group, aggregate.input_);
+      auto toId = [&]<sparqlExpression::SingleExpressionResult T>(
+                      T&& singleResult) -> Id {
+        using V = std::decay_t<T>;
+        if constexpr (std::is_same_v<V, Id>) {
+          if (aggregate.adaptation_ == Adaptation::MultiplyCount &&
+              singleResult.getDatatype() == Datatype::Int) {
+            return Id::makeFromInt(singleResult.getInt() *
+                                   static_cast<int64_t>(multiplicity));
+          }
+          return singleResult;
+        } else if constexpr (sparqlExpression::isConstantResult<V>) {
+          auto* concatenated = std::get_if<std::string>(&singleResult);
+          if (aggregate.adaptation_ == Adaptation::RepeatGroupConcat &&
+              concatenated != nullptr && !concatenated->empty()) {
+            // Each value occurs `multiplicity` times.
+            std::string repeated = *concatenated;
+            for (size_t i = 1; i < multiplicity; ++i) {
+              absl::StrAppend(&repeated, aggregate.separator_, *concatenated);
+            }
+            *concatenated = std::move(repeated);
+          }
+          return sparqlExpression::detail::constantExpressionResultToId(
+              AD_FWD(singleResult), localVocab);
+        } else {
+          // Aggregates always return constants.
+          AD_FAIL();
+        }
+      };
+      result(group, aggregate.outCol_) =
+          std::visit(toId, aggregate.expression_->evaluate(&context));
+    }
+  }
+  return ResultTable{std::move(result), resultSortedOn(),
+                     std::move(localVocab)};
+}
+
 // _____________________________________________________________________________
 bool GroupBy::computeOptimizedGroupByIfPossible(IdTable* result) {
   if (computeGroupByForSingleIndexScan(result)) {
     return true;
   } else if (computeGroupByForFullIndexScan(result)) {
     return true;
+  } else if (computeGroupByFromIndexSummaries(result)) {
+    return true;
   } else {
     return computeGroupByForJoinWithFullScan(result);
   }
@@ -1087,6 +1384,7 @@ void GroupBy::createResultFromHashMap(
 
   evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
       _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._cancellationHandle = cancellationHandle_;
   evaluationContext._variableToColumnMapPreviousResults =
       getInternallyVisibleVariableColumns();
   evaluationContext._previousResultsFromSameGroup.resize(getResultWidth());
@@ -1153,6 +1451,7 @@ void GroupBy::computeGroupByForHashMapOptimization(
 
   evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
       _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._cancellationHandle = cancellationHandle_;
   evaluationContext._isPartOfGroupBy = true;
 
   size_t blockSize = 65536;
@@ -156,6 +156,35 @@ class GroupBy : public Operation {
   // `?z`.
   bool computeGroupByForJoinWithFullScan(IdTable* result);
 
+  // Check if the query represented by this GROUP BY is of the following form:
+  //  SELECT (MAX(?x) AS ?max) WHERE {
+  //    ?s <somePredicate> ?x FILTER(?x >= 10) FILTER (?x < 100)
+  //  }
+  // The single alias must be a COUNT, COUNT(DISTINCT), MIN, or MAX of a
+  // variable, and the subtree an `IndexScan` with a fixed predicate, in which
+  // the variable is the subject or the object, with zero or more `Filter`s
+  // that compare the variable with a numeric constant on top. If the query has
+  // that form, the aggregate is computed from the metadata of the index and
+  // its `RelationSummary`s (see `Permutation::aggregateColumn`) and `true` is
+  // returned. MIN and MAX are only computed that way if all the values are
+  // numbers, because other values would have to be compared by their strings.
+  // If not, the `result` is left untouched, and `false` is returned.
+  bool computeGroupByFromIndexSummaries(IdTable* result);
+
+  // Check if the query represented by this GROUP BY is of the following form:
+  //  SELECT ?x (COUNT(?a) AS ?cnt) (GROUP_CONCAT(?b) AS ?bs) WHERE {
+  //    ?x <p1> ?a . ?x <p2> ?b . ?x <p3> ?c
+  //  } GROUP BY ?x
+  // The subtree must be a star join on the single grouped variable (see
+  // `FactorizedStarJoin`), the result of which is much larger than its inputs
+  // (see the runtime parameter `group-by-star-join-min-blow-up`).
+  // Each alias must be a single COUNT, GROUP_CONCAT, SAMPLE, MIN, MAX, or AVG,
+  // all the variables of which are contained in the same input of the star
+  // join. If the query has that form, the aggregates are computed for each
+  // group from the ranges of rows of this input without computing the cross
+  // products, and the result is returned. Else return `std::nullopt`.
+  std::optional<ResultTable> computeGroupByForStarJoin();
+
   // Data to perform the AVG aggregation using the HashMap optimization.
   struct AverageAggregationData {
     using ValueGetter = sparqlExpression::detail::NumericValueGetter;
@@ -4,9 +4,12 @@
 
 #include "engine/IndexScan.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <string>
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "index/IndexImpl.h"
 #include "index/TriplesView.h"
@@ -72,6 +75,21 @@ string IndexScan::getCacheKeyImpl() const {
     os << " Additional Columns: ";
     os << absl::StrJoin(additionalColumns(), " ");
   }
+  // The semi-join filter and the ranges are part of the key with all their
+  // values, because the results of scans with different restrictions have to
+  // be distinguished, and a hash of the values could collide.
+  auto appendBits = [](std::string* out, Id id) {
+    absl::StrAppend(out, id.getBits());
+  };
+  if (semiJoinFilter_) {
+    os << " SEMI-JOIN FILTER of size " << semiJoinFilter_->size() << ": "
+       << absl::StrJoin(*semiJoinFilter_, " ", appendBits);
+  }
+  if (!firstColumnRanges_.empty()) {
+    os << " RANGES of size " << firstColumnRanges_.size() << ": "
+       << absl::StrJoin(firstColumnRanges_, " ",
+                        absl::PairFormatter(appendBits, "-", appendBits));
+  }
   return std::move(os).str();
 }
 
@@ -127,7 +145,9 @@ ResultTable IndexScan::computeResult() {
   idTable.setNumColumns(numVariables_);
   const auto& index = _executionContext->getIndex();
   const auto permutedTriple = getPermutedTriple();
-  if (numVariables_ == 2) {
+  if (isRestricted()) {
+    idTable = computeRestrictedResult();
+  } else if (numVariables_ == 2) {
     idTable = index.scan(*permutedTriple[0], std::nullopt, permutation_,
                          additionalColumns(), cancellationHandle_);
   } else if (numVariables_ == 1) {
@@ -143,6 +163,92 @@ ResultTable IndexScan::computeResult() {
   return {std::move(idTable), resultSortedOn(), LocalVocab{}};
 }
 
+// _____________________________________________________________________________
+IdTable IndexScan::computeRestrictedResult() const {
+  IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
+  auto metaBlocks = getMetadataForScan(*this);
+  if (!metaBlocks.has_value()) {
+    return result;
+  }
+  const auto& allBlocks = metaBlocks.value().blockMetadata_;
+  // The blocks and rows are restricted by `getLazyScan`.
+  auto blocks = getLazyScan(*this, {allBlocks.begin(), allBlocks.end()});
+  for (const IdTable& block : blocks) {
+    result.insertAtEnd(block.begin(), block.end());
+  }
+  if (semiJoinFilter_) {
+    runtimeInfo().addDetail("semi-join-filter-size", semiJoinFilter_->size());
+  }
+  if (!firstColumnRanges_.empty()) {
+    runtimeInfo().addDetail("num-ranges", firstColumnRanges_.size());
+  }
+  runtimeInfo().addDetail("num-blocks-read", blocks.details().numBlocksRead_);
+  runtimeInfo().addDetail("num-blocks-all", allBlocks.size());
+  return result;
+}
+
+// _____________________________________________________________________________
+bool IndexScan::pushDownSemiJoinFilterImpl(const Variable& variable,
+                                           const SemiJoinFilter& values) {
+  if (numVariables_ == 3) {
+    return false;
+  }
+  const TripleComponent& firstVariable =
+      *getPermutedTriple()[3 - numVariables_];
+  if (firstVariable != TripleComponent{variable}) {
+    return false;
+  }
+  if (semiJoinFilter_) {
+    // The scan is restricted by two joins.
+    auto intersection = std::make_shared<std::vector<Id>>();
+    std::ranges::set_intersection(*semiJoinFilter_, *values,
+                                  std::back_inserter(*intersection));
+    semiJoinFilter_ = std::move(intersection);
+  } else {
+    semiJoinFilter_ = values;
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+bool IndexScan::canBeRestrictedToRanges(const Variable& variable) const {
+  // With a LIMIT or OFFSET, a restricted scan would yield different rows.
+  return numVariables_ == 2 &&
+         *getPermutedTriple()[1] == TripleComponent{variable} &&
+         !getLimit()._limit.has_value() && getLimit()._offset == 0;
+}
+
+// _____________________________________________________________________________
+bool IndexScan::restrictFirstColumnToRanges(
+    const Variable& variable, std::vector<std::pair<Id, Id>> ranges) {
+  if (!canBeRestrictedToRanges(variable)) {
+    return false;
+  }
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(ranges));
+  if (!firstColumnRanges_.empty()) {
+    // The scan is restricted by two filters.
+    std::vector<std::pair<Id, Id>> intersection;
+    auto it = firstColumnRanges_.begin();
+    auto jt = ranges.begin();
+    while (it != firstColumnRanges_.end() && jt != ranges.end()) {
+      Id first = std::max(it->first, jt->first);
+      Id second = std::min(it->second, jt->second);
+      if (first < second) {
+        intersection.emplace_back(first, second);
+      }
+      it->second < jt->second ? ++it : ++jt;
+    }
+    ranges = std::move(intersection);
+  }
+  firstColumnRanges_ = std::move(ranges);
+  // Empty ranges must still restrict the result to no rows.
+  if (firstColumnRanges_.empty()) {
+    firstColumnRanges_.emplace_back(Id::min(), Id::min());
+  }
+  wasRestrictedAfterPlanning_ = true;
+  return true;
+}
+
 // _____________________________________________________________________________
 size_t IndexScan::computeSizeEstimate() const {
   if (_executionContext) {
@@ -213,6 +319,17 @@ size_t IndexScan::getCostEstimate() {
   }
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const ColumnStatistics> IndexScan::getColumnStatistics(
+    size_t col) const {
+  if (!_executionContext || numVariables_ != 2 || col >= 2 ||
+      !RuntimeParameters().get<"use-column-statistics">()) {
+    return nullptr;
+  }
+  return getIndex().getColumnStatistics(*getPermutedTriple()[0], permutation_,
+                                        col + 1);
+}
+
 // _____________________________________________________________________________
 void IndexScan::determineMultiplicities() {
   multiplicity_.clear();
@@ -292,6 +409,50 @@ std::array<const TripleComponent* const, 3> IndexScan::getPermutedTriple()
           triple[permutation[2]]};
 }
 
+// ___________________________________________________________________________
+namespace {
+// Return true iff `id` is contained in one of the sorted and disjoint
+// half-open `ranges`.
+bool isInRanges(const std::vector<std::pair<Id, Id>>& ranges, Id id) {
+  auto it = std::ranges::upper_bound(ranges, id, {}, &std::pair<Id, Id>::first);
+  return it != ranges.begin() && id < std::prev(it)->second;
+}
+
+// Yield only the rows of the `blocks` (which are sorted by their first column)
+// with one of the sorted `values` (if not null) in their first column and a
+// value in one of the `ranges` (if not empty).
+Permutation::IdTableGenerator filterRows(
+    Permutation::IdTableGenerator blocks, SemiJoinFilter values,
+    std::vector<std::pair<Id, Id>> ranges) {
+  auto& details = co_await cppcoro::getDetails;
+  blocks.setDetailsPointer(&details);
+  std::vector<Id>::const_iterator it;
+  if (values) {
+    it = values->begin();
+  }
+  auto isMatch = [&](Id id) {
+    if (values) {
+      it = std::lower_bound(it, values->end(), id);
+      if (it == values->end() || *it != id) {
+        return false;
+      }
+    }
+    return ranges.empty() || isInRanges(ranges, id);
+  };
+  for (const IdTable& block : blocks) {
+    IdTable filtered{block.numColumns(), block.getAllocator()};
+    for (const auto& row : block) {
+      if (isMatch(row[0])) {
+        filtered.push_back(row);
+      }
+    }
+    if (!filtered.empty()) {
+      co_yield filtered;
+    }
+  }
+}
+}  // namespace
+
 // ___________________________________________________________________________
 Permutation::IdTableGenerator IndexScan::getLazyScan(
     const IndexScan& s, std::vector<CompressedBlockMetadata> blocks) {
@@ -301,11 +462,55 @@ Permutation::IdTableGenerator IndexScan::getLazyScan(
   if (s.numVariables_ == 1) {
     col1Id = s.getPermutedTriple()[1]->toValueId(index.getVocab()).value();
   }
-  return index.getPermutation(s.permutation())
-      .lazyScan(col0Id, col1Id, std::move(blocks), s.additionalColumns(),
-                s.cancellationHandle_);
+  const auto& permutation = index.getPermutation(s.permutation());
+  if (!s.isRestricted()) {
+    return permutation.lazyScan(col0Id, col1Id, std::move(blocks),
+                                s.additionalColumns(), s.cancellationHandle_);
+  }
+  // Additionally skip the blocks without any matching values.
+  auto metaBlocks = getMetadataForScan(s);
+  AD_CORRECTNESS_CHECK(metaBlocks.has_value());
+  auto filteredBlocks = restrictBlocks(
+      s, {metaBlocks.value().relationMetadata_, blocks,
+          metaBlocks.value().col1Id_, metaBlocks.value().firstAndLastTriple_});
+  return filterRows(
+      permutation.lazyScan(col0Id, col1Id, std::move(filteredBlocks),
+                           s.additionalColumns(), s.cancellationHandle_),
+      s.semiJoinFilter_, s.firstColumnRanges_);
 };
 
+// ________________________________________________________________
+std::vector<CompressedBlockMetadata> IndexScan::restrictBlocks(
+    const IndexScan& s, const Permutation::MetadataAndBlocks& metaBlocks) {
+  std::vector<CompressedBlockMetadata> blocks =
+      s.semiJoinFilter_ ? CompressedRelationReader::getBlocksForJoin(
+                              *s.semiJoinFilter_, metaBlocks)
+                        : std::vector<CompressedBlockMetadata>(
+                              metaBlocks.blockMetadata_.begin(),
+                              metaBlocks.blockMetadata_.end());
+  if (s.firstColumnRanges_.empty()) {
+    return blocks;
+  }
+  // The ranges only exist for scans with two variables, so the first column
+  // of the result is the second column of the permutation. The first and the
+  // last block of the relation can also contain other relations, for which
+  // the bounds of the second column are meaningless.
+  AD_CORRECTNESS_CHECK(s.numVariables_ == 2);
+  Id col0Id = metaBlocks.relationMetadata_.col0Id_;
+  const auto& ranges = s.firstColumnRanges_;
+  std::erase_if(blocks, [&](const CompressedBlockMetadata& block) {
+    Id first = block.firstTriple_.col0Id_ == col0Id ? block.firstTriple_.col1Id_
+                                                    : Id::min();
+    Id last = block.lastTriple_.col0Id_ == col0Id ? block.lastTriple_.col1Id_
+                                                  : Id::max();
+    // The first range that ends after `first`.
+    auto it =
+        std::ranges::upper_bound(ranges, first, {}, &std::pair<Id, Id>::second);
+    return it == ranges.end() || it->first > last;
+  });
+  return blocks;
+}
+
 // ________________________________________________________________
 std::optional<Permutation::MetadataAndBlocks> IndexScan::getMetadataForScan(
     const IndexScan& s) {
@@ -347,8 +552,15 @@ IndexScan::lazyScanForJoinOfTwoScans(const IndexScan& s1, const IndexScan& s2) {
   if (!metaBlocks1.has_value() || !metaBlocks2.has_value()) {
     return {{}};
   }
+  // The blocks that are excluded by a semi-join filter or by the ranges don't
+  // have to be matched with the blocks of the other scan.
+  auto restricted1 = restrictBlocks(s1, metaBlocks1.value());
+  auto restricted2 = restrictBlocks(s2, metaBlocks2.value());
   auto [blocks1, blocks2] = CompressedRelationReader::getBlocksForJoin(
-      metaBlocks1.value(), metaBlocks2.value());
+      {metaBlocks1.value().relationMetadata_, restricted1,
+       metaBlocks1.value().col1Id_, metaBlocks1.value().firstAndLastTriple_},
+      {metaBlocks2.value().relationMetadata_, restricted2,
+       metaBlocks2.value().col1Id_, metaBlocks2.value().firstAndLastTriple_});
 
   std::array result{getLazyScan(s1, blocks1), getLazyScan(s2, blocks2)};
   result[0].details().numBlocksAll_ = metaBlocks1.value().blockMetadata_.size();
@@ -356,6 +568,92 @@ IndexScan::lazyScanForJoinOfTwoScans(const IndexScan& s1, const IndexScan& s2) {
   return result;
 }
 
+// ________________________________________________________________
+std::optional<size_t> IndexScan::estimateJoinSizeBySampling(
+    const IndexScan& s1, const IndexScan& s2) {
+  const size_t maxNumBlocks =
+      RuntimeParameters().get<"join-sampling-num-blocks">();
+  if (maxNumBlocks == 0 || !s1._executionContext || s1.numVariables_ == 3 ||
+      s2.numVariables_ == 3) {
+    return std::nullopt;
+  }
+  // The join is symmetric, so is the key.
+  auto key = std::minmax(s1.getCacheKey(), s2.getCacheKey());
+  const auto cacheKey = absl::StrCat("JOIN SAMPLE ", key.first, " AND ",
+                                     key.second, " BLOCKS ", maxNumBlocks);
+  auto& cache = s1.getExecutionContext()->getQueryTreeCache();
+  if (auto size = cache.getSampledJoinSize(cacheKey)) {
+    return size;
+  }
+
+  // Sample the larger scan. Its blocks typically span a smaller range of
+  // values of the join column, so fewer blocks of the other scan match.
+  const bool sampleFirst = s1.getExactSize() >= s2.getExactSize();
+  const IndexScan& sampled = sampleFirst ? s1 : s2;
+  const IndexScan& other = sampleFirst ? s2 : s1;
+  auto sampledMetaBlocks = getMetadataForScan(sampled);
+  auto otherMetaBlocks = getMetadataForScan(other);
+  if (!sampledMetaBlocks.has_value() || !otherMetaBlocks.has_value()) {
+    cache.addSampledJoinSize(cacheKey, 0);
+    return 0;
+  }
+  const auto& blocks = sampledMetaBlocks.value().blockMetadata_;
+  const size_t numBlocks = std::min(maxNumBlocks, blocks.size());
+
+  const std::chrono::milliseconds timeBudget =
+      RuntimeParameters().get<"join-sampling-time-budget">();
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  size_t numSampledRows = 0;
+  double sampledJoinSize = 0;
+  // At least one block is sampled, even if the time budget is exceeded.
+  for (size_t i = 0; i < numBlocks && (i == 0 || timer.msecs() < timeBudget);
+       ++i) {
+    sampled.checkCancellation();
+    const auto& block = blocks[(2 * i + 1) * blocks.size() / (2 * numBlocks)];
+    std::vector<Id> joinColumn;
+    for (const IdTable& table : getLazyScan(sampled, {block})) {
+      std::ranges::copy(table.getColumn(0), std::back_inserter(joinColumn));
+    }
+    numSampledRows += joinColumn.size();
+    if (joinColumn.empty()) {
+      continue;
+    }
+    // A single block of the sampled scan can match arbitrarily many blocks of
+    // the `other` scan (if it has many rows for the same value). Therefore at
+    // most `maxNumBlocks` evenly spaced ones of them are read, and the number
+    // of matching rows is extrapolated to all of them.
+    auto otherBlocks = CompressedRelationReader::getBlocksForJoin(
+        joinColumn, otherMetaBlocks.value());
+    if (otherBlocks.empty()) {
+      continue;
+    }
+    const size_t numOtherBlocks = std::min(maxNumBlocks, otherBlocks.size());
+    std::vector<CompressedBlockMetadata> otherSample;
+    for (size_t j = 0; j < numOtherBlocks; ++j) {
+      otherSample.push_back(otherBlocks[(2 * j + 1) * otherBlocks.size() /
+                                        (2 * numOtherBlocks)]);
+    }
+    size_t joinSizeOfSample = 0;
+    for (const IdTable& table : getLazyScan(other, std::move(otherSample))) {
+      other.checkCancellation();
+      for (Id id : table.getColumn(0)) {
+        joinSizeOfSample += std::ranges::equal_range(joinColumn, id).size();
+      }
+    }
+    sampledJoinSize += static_cast<double>(joinSizeOfSample) *
+                       static_cast<double>(otherBlocks.size()) /
+                       static_cast<double>(numOtherBlocks);
+  }
+  size_t result = 0;
+  if (numSampledRows > 0) {
+    result = static_cast<size_t>(sampledJoinSize *
+                                 static_cast<double>(sampled.getExactSize()) /
+                                 static_cast<double>(numSampledRows));
+  }
+  cache.addSampledJoinSize(cacheKey, result);
+  return result;
+}
+
 // ________________________________________________________________
 Permutation::IdTableGenerator IndexScan::lazyScanForJoinOfColumnWithScan(
     std::span<const Id> joinColumn, const IndexScan& s) {
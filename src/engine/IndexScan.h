@@ -27,6 +27,15 @@ class IndexScan : public Operation {
   std::vector<ColumnIndex> additionalColumns_;
   std::vector<Variable> additionalVariables_;
 
+  // If set, only the rows with one of these values in the first column are
+  // part of the result (see `pushDownSemiJoinFilter`).
+  SemiJoinFilter semiJoinFilter_;
+
+  // If not empty, only the rows with a value in one of these sorted and
+  // disjoint half-open ranges `[first, second)` in the first column are part
+  // of the result (see `restrictFirstColumnToRanges`).
+  std::vector<std::pair<Id, Id>> firstColumnRanges_;
+
  public:
   IndexScan(QueryExecutionContext* qec, Permutation::Enum permutation,
             const SparqlTriple& triple);
@@ -68,6 +77,18 @@ class IndexScan : public Operation {
   static Permutation::IdTableGenerator lazyScanForJoinOfColumnWithScan(
       std::span<const Id> joinColumn, const IndexScan& s);
 
+  // Estimate the size of the join of `s1` and `s2` on the first column of
+  // both results (the same kind of join as for `lazyScanForJoinOfTwoScans`).
+  // A few evenly spaced blocks of the larger scan are joined with (a sample of)
+  // the matching blocks of the other scan, and the size of the join is
+  // extrapolated from the fraction of the rows that were sampled. The number of
+  // blocks of both scans and the time are bounded by the runtime parameters
+  // `join-sampling-num-blocks` and `join-sampling-time-budget`. Return
+  // `nullopt` if the sampling is disabled or one of the scans is a full index
+  // scan. The estimates are cached in the `QueryResultCache`.
+  static std::optional<size_t> estimateJoinSizeBySampling(const IndexScan& s1,
+                                                          const IndexScan& s2);
+
  private:
   // TODO<joka921> Make the `getSizeEstimateBeforeLimit()` function `const` for
   // ALL the `Operations`.
@@ -78,6 +99,11 @@ class IndexScan : public Operation {
 
   void determineMultiplicities();
 
+  // The statistics are only known for the two columns of a scan with two
+  // variables.
+  std::shared_ptr<const ColumnStatistics> getColumnStatistics(
+      size_t col) const override;
+
   float getMultiplicity(size_t col) override {
     if (multiplicity_.empty()) {
       determineMultiplicities();
@@ -95,6 +121,27 @@ class IndexScan : public Operation {
 
   Permutation::Enum permutation() const { return permutation_; }
 
+  // Return the metadata of the relation that is scanned and of its blocks, or
+  // `nullopt` if the result is empty because one of the fixed components is
+  // not contained in the index. Together with the `permutation()`, this allows
+  // other operations to read only some of the blocks of the scan (see
+  // `WorstCaseOptimalJoin`).
+  std::optional<Permutation::MetadataAndBlocks> getMetadataAndBlocks() const {
+    return getMetadataForScan(*this);
+  }
+
+  // Restrict the result to the rows in which the `variable` has a value in one
+  // of the sorted and disjoint half-open `ranges`. Only the blocks that
+  // overlap with one of the ranges are read. This is used for the bounding
+  // boxes of geographic filters, the ranges of which are ranges of `GeoPoint`
+  // values (see `Filter::restrictScanToGeoBoundingBox`). It is currently only
+  // done for the first column of a scan with two variables, which is sorted
+  // across all the blocks of the relation. Return true iff the restriction was
+  // applied. Has to be called before the result is computed.
+  bool restrictFirstColumnToRanges(const Variable& variable,
+                                   std::vector<std::pair<Id, Id>> ranges);
+  bool canBeRestrictedToRanges(const Variable& variable) const;
+
  private:
   ResultTable computeResult() override;
 
@@ -102,6 +149,20 @@ class IndexScan : public Operation {
 
   void computeFullScan(IdTable* result, Permutation::Enum permutation) const;
 
+  // Compute the result if there is a `semiJoinFilter_` or there are
+  // `firstColumnRanges_`. Only the blocks that can contain a matching value are
+  // read.
+  IdTable computeRestrictedResult() const;
+
+  bool isRestricted() const {
+    return semiJoinFilter_ != nullptr || !firstColumnRanges_.empty();
+  }
+
+  // Only the first column can be restricted, because the blocks that have no
+  // match can only be determined for that column.
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override;
+
   size_t computeSizeEstimate() const;
 
   string getCacheKeyImpl() const override;
@@ -118,4 +179,9 @@ class IndexScan : public Operation {
       const IndexScan& s, std::vector<CompressedBlockMetadata> blocks);
   static std::optional<Permutation::MetadataAndBlocks> getMetadataForScan(
       const IndexScan& s);
+  // The blocks of the `metaBlocks` of `s` that can contain one of the values
+  // of the `semiJoinFilter_` of `s` and a value in one of the
+  // `firstColumnRanges_` (all the blocks if there are no restrictions).
+  static std::vector<CompressedBlockMetadata> restrictBlocks(
+      const IndexScan& s, const Permutation::MetadataAndBlocks& metaBlocks);
 };
@@ -10,6 +10,7 @@
 #include <engine/Join.h>
 #include <global/Constants.h>
 #include <global/Id.h>
+#include <index/ColumnStatistics.h>
 #include <util/Exception.h>
 #include <util/HashMap.h>
 
@@ -150,9 +151,28 @@ ResultTable Join::computeResult() {
     }
   }
 
+  // Sideways information passing: If the result of one side is (probably)
+  // much smaller, compute it first and restrict the index scans of the other
+  // side to the values of the join column of this result. Note that a right
+  // child that is an `IndexScan` is already restricted by the lazy scan below.
+  shared_ptr<const ResultTable> rightRes = rightResIfCached;
+  if (!leftResIfCached && !rightRes &&
+      _right->getType() != QueryExecutionTree::SCAN &&
+      _right->getSizeEstimate() < _left->getSizeEstimate()) {
+    rightRes = _right->getResult();
+  }
+  if (!leftResIfCached && rightRes) {
+    passSemiJoinFilterSideways(rightRes->idTable(), _rightJoinCol, _joinVar,
+                               *_left);
+  }
+
   shared_ptr<const ResultTable> leftRes =
       leftResIfCached ? leftResIfCached : _left->getResult();
   if (leftRes->size() == 0) {
+    if (rightRes && !rightResIfCached) {
+      // The right side was already computed.
+      return {std::move(idTable), resultSortedOn(), LocalVocab()};
+    }
     _right->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
     // TODO<joka921, hannahbast, SPARQL update> When we add triples to the
     // index, the vocabularies of index scans will not necessarily be empty and
@@ -167,7 +187,7 @@ ResultTable Join::computeResult() {
   const auto& leftIdTable = leftRes->idTable();
   auto leftHasUndef =
       !leftIdTable.empty() && leftIdTable.at(0, _leftJoinCol).isUndefined();
-  if (_right->getType() == QueryExecutionTree::SCAN && !rightResIfCached &&
+  if (_right->getType() == QueryExecutionTree::SCAN && !rightRes &&
       !leftHasUndef) {
     idTable = computeResultForIndexScanAndIdTable<false>(
         leftRes->idTable(), _leftJoinCol,
@@ -176,8 +196,11 @@ ResultTable Join::computeResult() {
             leftRes->getSharedLocalVocab()};
   }
 
-  shared_ptr<const ResultTable> rightRes =
-      rightResIfCached ? rightResIfCached : _right->getResult();
+  if (!rightRes) {
+    passSemiJoinFilterSideways(leftRes->idTable(), _leftJoinCol, _joinVar,
+                               *_right);
+    rightRes = _right->getResult();
+  }
   join(leftRes->idTable(), _leftJoinCol, rightRes->idTable(), _rightJoinCol,
        &idTable);
 
@@ -187,6 +210,16 @@ ResultTable Join::computeResult() {
           ResultTable::getSharedLocalVocabFromNonEmptyOf(*leftRes, *rightRes)};
 }
 
+// _____________________________________________________________________________
+bool Join::pushDownSemiJoinFilterImpl(const Variable& variable,
+                                      const SemiJoinFilter& values) {
+  bool appliedLeft =
+      _left->getRootOperation()->pushDownSemiJoinFilter(variable, values);
+  bool appliedRight =
+      _right->getRootOperation()->pushDownSemiJoinFilter(variable, values);
+  return appliedLeft || appliedRight;
+}
+
 // _____________________________________________________________________________
 VariableToColumnMap Join::computeVariableToColumnMap() const {
   AD_CORRECTNESS_CHECK(!isFullScanDummy(_left));
@@ -360,6 +393,23 @@ void Join::computeSizeEstimateAndMultiplicities() {
 
   size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
 
+  // If the statistics of both join columns are known, the histograms and
+  // sketches yield better estimates for skewed or hardly overlapping columns.
+  // They are then used instead of the average multiplicities (with the same
+  // correction factor).
+  auto statisticsLeft =
+      _left->getRootOperation()->getColumnStatistics(_leftJoinCol);
+  auto statisticsRight =
+      _right->getRootOperation()->getColumnStatistics(_rightJoinCol);
+  std::optional<ColumnStatistics::JoinEstimate> statisticsEstimate;
+  if (statisticsLeft != nullptr && statisticsRight != nullptr) {
+    statisticsEstimate =
+        ColumnStatistics::estimateJoin(*statisticsLeft, *statisticsRight);
+    nofDistinctInResult = std::clamp(
+        static_cast<size_t>(statisticsEstimate->numDistinct_), size_t{1},
+        std::min(nofDistinctLeft, nofDistinctRight));
+  }
+
   double adaptSizeLeft =
       _left->getSizeEstimate() *
       (static_cast<double>(nofDistinctInResult) / nofDistinctLeft);
@@ -376,11 +426,34 @@ void Join::computeSizeEstimateAndMultiplicities() {
                        "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"))
           : 1;
 
-  double jcMultiplicityInResult = _left->getMultiplicity(_leftJoinCol) *
-                                  _right->getMultiplicity(_rightJoinCol);
+  double jcMultiplicityInResult =
+      statisticsEstimate.has_value()
+          ? statisticsEstimate->size_ / static_cast<double>(nofDistinctInResult)
+          : _left->getMultiplicity(_leftJoinCol) *
+                _right->getMultiplicity(_rightJoinCol);
+
+  // For a join of two index scans, joining samples of the scans yields an
+  // estimate that also captures correlations between the scans (for example,
+  // two predicates that mostly have the same subjects). This estimate is used
+  // as is (without the correction factor).
+  std::optional<size_t> sampledSize;
+  if (_left->getType() == QueryExecutionTree::SCAN &&
+      _right->getType() == QueryExecutionTree::SCAN && _leftJoinCol == 0 &&
+      _rightJoinCol == 0) {
+    sampledSize = IndexScan::estimateJoinSizeBySampling(
+        dynamic_cast<const IndexScan&>(*_left->getRootOperation()),
+        dynamic_cast<const IndexScan&>(*_right->getRootOperation()));
+  }
+  if (sampledSize.has_value()) {
+    jcMultiplicityInResult = static_cast<double>(sampledSize.value()) /
+                             (corrFactor * nofDistinctInResult);
+  }
   _sizeEstimate = std::max(
       size_t(1), static_cast<size_t>(corrFactor * jcMultiplicityInResult *
                                      nofDistinctInResult));
+  if (sampledSize.has_value()) {
+    _sizeEstimate = std::max(size_t(1), sampledSize.value());
+  }
 
   LOG(TRACE) << "Estimated size as: " << _sizeEstimate << " := " << corrFactor
              << " * " << jcMultiplicityInResult << " * " << nofDistinctInResult
@@ -395,6 +468,9 @@ void Join::computeSizeEstimateAndMultiplicities() {
       double oldDist = _left->getSizeEstimate() / oldMult;
       double newDist = std::min(oldDist, adaptSizeLeft);
       m = (_sizeEstimate / corrFactor) / newDist;
+    } else if (i == _leftJoinCol &&
+               (statisticsEstimate.has_value() || sampledSize.has_value())) {
+      m = std::max(1.0, corrFactor * jcMultiplicityInResult);
     }
     _multiplicities.emplace_back(m);
   }
@@ -87,6 +87,9 @@ class Join : public Operation {
     return {_left.get(), _right.get()};
   }
 
+  // The variable on which the two children are joined.
+  const Variable& getJoinVariable() const { return _joinVar; }
+
   /**
    * @brief Joins IdTables a and b on join column jc2, returning
    * the result in dynRes. Creates a cross product for matching rows.
@@ -134,6 +137,10 @@ class Join : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // The `variable` may be bound by either of the children (or both).
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override;
+
   ResultTable computeResultForJoinWithFullScanDummy();
 
   // A special implementation that is called when both children are
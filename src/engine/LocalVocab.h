@@ -6,11 +6,14 @@
 
 #include <cstdlib>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "absl/container/node_hash_map.h"
 #include "global/Id.h"
+#include "util/ShortString.h"
 
 // A class for maintaing a local vocabulary with contiguous (local) IDs. This is
 // meant for words that are not part of the normal vocabulary (constructed from
@@ -79,3 +82,27 @@ class LocalVocab {
   template <typename WordT>
   LocalVocabIndex getIndexAndAddIfNotContainedImpl(WordT&& word);
 };
+
+// Return the `Id` of a `word` that is not part of the vocabulary of the index.
+// The `word` is either an IRI or a literal in the format of the vocabulary
+// (e.g. `<x>` or `"abc"`), or the content of a plain literal without quotes as
+// it is computed by the string functions of the `SparqlExpression`s. A plain
+// literal that fits into a `ShortString` is inlined into the `Id` like by
+// `TripleComponent::toValueId`, s.t. equal literals always get the same `Id`.
+// All other words are added to the `localVocab`, which can also be another
+// class with a `getIndexAndAddIfNotContained` method.
+template <typename LocalVocabT, typename Word>
+Id getIdOfWordNotInVocabulary(Word&& word, LocalVocabT& localVocab) {
+  std::string_view view{word};
+  std::optional<ShortString> shortString;
+  if (view.starts_with('"')) {
+    shortString = ShortString::fromLiteral(view);
+  } else if (!view.starts_with('<') && !view.starts_with("_:")) {
+    shortString = ShortString::fromContent(view);
+  }
+  if (shortString.has_value()) {
+    return Id::makeFromShortString(shortString.value());
+  }
+  return Id::makeFromLocalVocabIndex(
+      localVocab.getIndexAndAddIfNotContained(std::forward<Word>(word)));
+}
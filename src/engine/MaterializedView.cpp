@@ -0,0 +1,234 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/MaterializedView.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/Exception.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/json.h"
+
+namespace {
+// The version of the file format, which has to be increased whenever the
+// format changes.
+constexpr uint64_t FORMAT_VERSION = 2;
+
+// Only letters, digits, `-`, and `_` are allowed in the names of views. In
+// particular, the name of the temporary file that is written by `writeToFile`
+// is not the name of a view.
+bool isValidName(std::string_view name) {
+  return !name.empty() && std::ranges::all_of(name, [](char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '-' ||
+           c == '_';
+  });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MaterializedView MaterializedView::compute(std::string name, std::string query,
+                                           QueryExecutionTree& qet) {
+  if (!isValidName(name)) {
+    throw std::runtime_error{absl::StrCat(
+        "\"", name,
+        "\" is not a valid name for a materialized view (only letters, "
+        "digits, '-', and '_' are allowed)")};
+  }
+  MaterializedView view;
+  view.name_ = std::move(name);
+  view.query_ = std::move(query);
+  view.cacheKey_ = qet.getCacheKey();
+  AD_CONTRACT_CHECK(qet.getQec() != nullptr);
+  const Index& index = qet.getQec()->getIndex();
+  view.indexBuildId_ = index.getBuildId();
+  view.indexFormatVersion_ = qlever::indexFormatVersion;
+  view.numTriplesOfIndex_ = index.numTriples().normalAndInternal_();
+  view.variableColumns_ = qet.getVariableColumns();
+  view.result_ = qet.getResult();
+  return view;
+}
+
+// _____________________________________________________________________________
+void MaterializedView::writeToFile(const std::string& filename) const {
+  // A server that is started while the view is written (or after the writing
+  // has failed) still reads the previous version of the view.
+  const std::string temporaryFilename = absl::StrCat(filename, ".tmp");
+  ad_utility::serialization::FileWriteSerializer serializer{temporaryFilename};
+  serializer << FORMAT_VERSION;
+  serializer << name_;
+  serializer << query_;
+  serializer << cacheKey_;
+  serializer << indexBuildId_;
+  serializer << nlohmann::json(indexFormatVersion_).dump();
+  serializer << numTriplesOfIndex_;
+
+  // The variables, ordered by their columns to make the file deterministic.
+  std::vector<std::pair<Variable, ColumnIndexAndTypeInfo>> variables(
+      variableColumns_.begin(), variableColumns_.end());
+  std::ranges::sort(variables, {}, [](const auto& variableAndColumn) {
+    return variableAndColumn.second.columnIndex_;
+  });
+  serializer << variables.size();
+  for (const auto& [variable, info] : variables) {
+    serializer << variable.name();
+    serializer << info.columnIndex_;
+    serializer << static_cast<bool>(info.mightContainUndef_);
+  }
+
+  // The `LocalVocabIndex`es are contiguous, so the words can be written in
+  // the order of their indices and be added in the same order when reading.
+  const auto& localVocab = result_->localVocab();
+  std::vector<std::string> words;
+  for (size_t i = 0; i < localVocab.size(); ++i) {
+    words.push_back(localVocab.getWord(LocalVocabIndex::make(i)));
+  }
+  serializer << words;
+  serializer << result_->sortedBy();
+
+  const IdTable& idTable = result_->idTable();
+  serializer << idTable.numRows();
+  serializer << idTable.numColumns();
+  for (size_t i = 0; i < idTable.numColumns(); ++i) {
+    auto column = idTable.getColumn(i);
+    serializer << ZstdWrapper::compress(column.data(),
+                                        column.size() * sizeof(Id));
+  }
+  serializer.close();
+  std::filesystem::rename(temporaryFilename, filename);
+}
+
+// _____________________________________________________________________________
+MaterializedView MaterializedView::readFromFile(
+    const std::string& filename,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  uint64_t version;
+  serializer >> version;
+  if (version != FORMAT_VERSION) {
+    throw std::runtime_error{absl::StrCat(
+        "The materialized view in file \"", filename, "\" has format version ",
+        version, ", but the current version is ", FORMAT_VERSION,
+        ". Please compute the view again")};
+  }
+  MaterializedView view;
+  serializer >> view.name_;
+  serializer >> view.query_;
+  serializer >> view.cacheKey_;
+  serializer >> view.indexBuildId_;
+  std::string indexFormatVersion;
+  serializer >> indexFormatVersion;
+  view.indexFormatVersion_ = nlohmann::json::parse(indexFormatVersion)
+                                .get<qlever::IndexFormatVersion>();
+  serializer >> view.numTriplesOfIndex_;
+
+  size_t numVariables;
+  serializer >> numVariables;
+  for (size_t i = 0; i < numVariables; ++i) {
+    std::string name;
+    ColumnIndex column;
+    bool possiblyUndefined;
+    serializer >> name;
+    serializer >> column;
+    serializer >> possiblyUndefined;
+    view.variableColumns_[Variable{std::move(name)}] =
+        ColumnIndexAndTypeInfo{
+            column, possiblyUndefined
+                        ? ColumnIndexAndTypeInfo::PossiblyUndefined
+                        : ColumnIndexAndTypeInfo::AlwaysDefined};
+  }
+
+  std::vector<std::string> words;
+  serializer >> words;
+  LocalVocab localVocab;
+  for (auto& word : words) {
+    localVocab.getIndexAndAddIfNotContained(std::move(word));
+  }
+  AD_CORRECTNESS_CHECK(localVocab.size() == words.size());
+  std::vector<ColumnIndex> sortedBy;
+  serializer >> sortedBy;
+
+  size_t numRows;
+  size_t numColumns;
+  serializer >> numRows;
+  serializer >> numColumns;
+  IdTable idTable{numColumns, allocator};
+  idTable.resize(numRows);
+  std::vector<char> compressed;
+  for (size_t i = 0; i < numColumns; ++i) {
+    serializer >> compressed;
+    auto column = idTable.getColumn(i);
+    size_t numBytes = column.size() * sizeof(Id);
+    AD_CORRECTNESS_CHECK(ZstdWrapper::decompressToBuffer(
+                             compressed.data(), compressed.size(),
+                             column.data(), numBytes) == numBytes);
+  }
+  view.result_ = std::make_shared<const ResultTable>(
+      std::move(idTable), std::move(sortedBy), std::move(localVocab));
+  return view;
+}
+
+// _____________________________________________________________________________
+std::string MaterializedView::getFilename(std::string_view indexBasename,
+                                          std::string_view name) {
+  return absl::StrCat(indexBasename, FILE_INFIX, name);
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> MaterializedView::findNames(
+    std::string_view indexBasename) {
+  std::filesystem::path basename{indexBasename};
+  auto directory = basename.parent_path();
+  if (directory.empty()) {
+    directory = ".";
+  }
+  std::string prefix =
+      absl::StrCat(basename.filename().string(), FILE_INFIX);
+  std::vector<std::string> names;
+  for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+    std::string filename = entry.path().filename().string();
+    if (entry.is_regular_file() && filename.starts_with(prefix) &&
+        isValidName(std::string_view{filename}.substr(prefix.size()))) {
+      names.push_back(filename.substr(prefix.size()));
+    }
+  }
+  std::ranges::sort(names);
+  return names;
+}
+
+// _____________________________________________________________________________
+void MaterializedView::pinInCache(QueryResultCache& cache) const {
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.descriptor_ = absl::StrCat("Materialized view ", name_);
+  runtimeInfo.numRows_ = result_->size();
+  runtimeInfo.numCols_ = result_->width();
+  runtimeInfo.status_ = RuntimeInformation::Status::fullyMaterialized;
+  runtimeInfo.setColumnNames(variableColumns_);
+  cache.insertOrReplacePinned(
+      cacheKey_, std::make_shared<CacheValue>(result_, std::move(runtimeInfo)));
+}
+
+// _____________________________________________________________________________
+bool MaterializedView::isValidForIndex(const Index& index) const {
+  return indexBuildId_ == index.getBuildId() &&
+         indexFormatVersion_ == qlever::indexFormatVersion &&
+         numTriplesOfIndex_ == index.numTriples().normalAndInternal_();
+}
+
+// _____________________________________________________________________________
+nlohmann::json MaterializedView::toJson() const {
+  nlohmann::json result;
+  result["name"] = name_;
+  result["query"] = query_;
+  result["num-rows"] = result_->size();
+  result["num-cols"] = result_->width();
+  std::vector<std::string> variables(result_->width());
+  for (const auto& [variable, info] : variableColumns_) {
+    variables.at(info.columnIndex_) = variable.name();
+  }
+  result["variables"] = variables;
+  return result;
+}
@@ -0,0 +1,94 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/ResultTable.h"
+#include "engine/VariableToColumnMap.h"
+#include "index/IndexFormatVersion.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/json.h"
+
+// A named materialized view: the result of a SPARQL query (for example, an
+// expensive subquery that many queries share), which is stored in a file next
+// to the index, such that it survives a restart of the server. When the server
+// starts, the views are read and their results are pinned in the cache with
+// the cache key of the query's execution tree. The query planner then uses the
+// result of a view for each subtree with the same cache key, exactly like for
+// results that were pinned with `pinsubtrees=true` (see
+// `QueryExecutionTree::readFromCache`).
+class MaterializedView {
+ public:
+  // The name of the file of a view is the basename of the index, followed by
+  // this infix and the name of the view.
+  static constexpr std::string_view FILE_INFIX = ".materialized-view.";
+
+ private:
+  std::string name_;
+  std::string query_;
+  std::string cacheKey_;
+  // The index the result was computed on, identified by its build id, its
+  // format version, and its number of triples. The `Id`s of a view are only
+  // valid for this index.
+  uint64_t indexBuildId_ = 0;
+  qlever::IndexFormatVersion indexFormatVersion_{};
+  uint64_t numTriplesOfIndex_ = 0;
+  VariableToColumnMap variableColumns_;
+  std::shared_ptr<const ResultTable> result_;
+
+  MaterializedView() = default;
+
+ public:
+  // Compute the view with the given `name` for the `query`, the execution
+  // tree of which is `qet`. Throw if the `name` is not a valid name for a view
+  // (only letters, digits, `-`, and `_` are allowed).
+  static MaterializedView compute(std::string name, std::string query,
+                                  QueryExecutionTree& qet);
+
+  // Write the view to the given file. The columns of the result are
+  // compressed. The view is first written to a temporary file, which then
+  // replaces the file, s.t. a view that is read is always complete.
+  void writeToFile(const std::string& filename) const;
+
+  // Read a view that was written by `writeToFile`. The memory for the result
+  // is allocated with the `allocator`.
+  static MaterializedView readFromFile(
+      const std::string& filename,
+      const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  // The file for the view with the given `name` next to the index with the
+  // given basename.
+  static std::string getFilename(std::string_view indexBasename,
+                                 std::string_view name);
+
+  // The names of all the views that are stored next to the index with the
+  // given basename, sorted alphabetically.
+  static std::vector<std::string> findNames(std::string_view indexBasename);
+
+  // Pin the result in the `cache` with the cache key of the view. An entry
+  // with the same key that is already contained (for example, the result of an
+  // earlier version of the view) is replaced.
+  void pinInCache(QueryResultCache& cache) const;
+
+  // Return true iff the view was computed on the given index (the same build
+  // of the index, see `indexBuildId_`).
+  bool isValidForIndex(const Index& index) const;
+
+  const std::string& name() const { return name_; }
+  const std::string& query() const { return query_; }
+  const std::string& cacheKey() const { return cacheKey_; }
+  const VariableToColumnMap& variableColumns() const {
+    return variableColumns_;
+  }
+  const ResultTable& result() const { return *result_; }
+
+  // A short summary of the view for the responses of the server.
+  nlohmann::json toJson() const;
+};
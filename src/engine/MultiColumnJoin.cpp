@@ -67,8 +67,28 @@ ResultTable MultiColumnJoin::computeResult() {
 
   AD_CONTRACT_CHECK(idTable.numColumns() >= _joinColumns.size());
 
-  const auto leftResult = _left->getResult();
-  const auto rightResult = _right->getResult();
+  // Sideways information passing: Compute the side that is estimated to be
+  // smaller first and restrict the index scans of the other side to the values
+  // of the first join column (by which both sides are sorted).
+  const bool leftIsSmaller =
+      _left->getSizeEstimate() <= _right->getSizeEstimate();
+  auto computeBothResults = [this](QueryExecutionTree& first,
+                                   ColumnIndex firstJoinColumn,
+                                   QueryExecutionTree& second) {
+    auto firstResult = first.getResult();
+    passSemiJoinFilterSideways(
+        firstResult->idTable(), firstJoinColumn,
+        first.getVariableAndInfoByColumnIndex(firstJoinColumn).first, second);
+    return std::pair{firstResult, second.getResult()};
+  };
+  const auto [leftResult, rightResult] = [&]() {
+    if (leftIsSmaller) {
+      return computeBothResults(*_left, _joinColumns[0][0], *_right);
+    }
+    auto [right, left] =
+        computeBothResults(*_right, _joinColumns[0][1], *_left);
+    return std::pair{left, right};
+  }();
 
   LOG(DEBUG) << "MultiColumnJoin subresult computation done." << std::endl;
 
@@ -86,6 +106,16 @@ ResultTable MultiColumnJoin::computeResult() {
                                                          *rightResult)};
 }
 
+// _____________________________________________________________________________
+bool MultiColumnJoin::pushDownSemiJoinFilterImpl(
+    const Variable& variable, const SemiJoinFilter& values) {
+  bool appliedLeft =
+      _left->getRootOperation()->pushDownSemiJoinFilter(variable, values);
+  bool appliedRight =
+      _right->getRootOperation()->pushDownSemiJoinFilter(variable, values);
+  return appliedLeft || appliedRight;
+}
+
 // _____________________________________________________________________________
 VariableToColumnMap MultiColumnJoin::computeVariableToColumnMap() const {
   return makeVarToColMapForJoinOperation(
@@ -72,5 +72,9 @@ class MultiColumnJoin : public Operation {
 
   VariableToColumnMap computeVariableToColumnMap() const override;
 
+  // The `variable` may be bound by either of the children (or both).
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override;
+
   void computeSizeEstimateAndMultiplicities();
 };
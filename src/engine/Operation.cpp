@@ -4,6 +4,8 @@
 
 #include "engine/Operation.h"
 
+#include <boost/core/demangle.hpp>
+
 #include "engine/QueryExecutionTree.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/TransparentFunctors.h"
@@ -124,8 +126,15 @@ shared_ptr<const ResultTable> Operation::getResult(bool isRoot,
     auto computeLambda = [this, &timer] {
       checkCancellation([this]() { return "Before " + getDescriptor(); });
       runtimeInfo().status_ = RuntimeInformation::Status::inProgress;
+      // Account for the resources used by this operation. The resources used
+      // by the children are accounted for in their own (nested) scopes.
+      auto resourceTracker = std::make_shared<ad_utility::ResourceTracker>();
+      runtimeInfo().resourceTracker_ = resourceTracker;
       signalQueryUpdate();
-      ResultTable result = computeResult();
+      ResultTable result = [this, &resourceTracker]() {
+        ad_utility::ResourceTracker::Scope scope{resourceTracker};
+        return computeResult();
+      }();
 
       checkCancellation([this]() { return "After " + getDescriptor(); });
       // Compute the datatypes that occur in each column of the result.
@@ -181,6 +190,11 @@ shared_ptr<const ResultTable> Operation::getResult(bool isRoot,
     runtimeInfo().status_ =
         RuntimeInformation::Status::failedBecauseChildFailed;
     throw;
+  } catch (const ResultSizeDeviatesFromEstimateException&) {
+    // The query is going to be planned again, this is not an error.
+    runtimeInfo().status_ =
+        RuntimeInformation::Status::failedBecauseChildFailed;
+    throw;
   } catch (const ad_utility::WaitedForResultWhichThenFailedException& e) {
     // Here and in the following, show the detailed information (it's the
     // runtime info) only in the DEBUG log. Note that the exception will be
@@ -216,6 +230,50 @@ std::chrono::milliseconds Operation::remainingTime() const {
       0ms, std::chrono::duration_cast<std::chrono::milliseconds>(interval));
 }
 
+// _____________________________________________________________________________
+bool Operation::pushDownSemiJoinFilter(const Variable& variable,
+                                       const SemiJoinFilter& values) {
+  // With a LIMIT or OFFSET, a restricted input would yield different rows. A
+  // variable that is not visible belongs to a subquery and is a different
+  // variable with the same name.
+  if (_limit._limit.has_value() || _limit._offset != 0 ||
+      !getExternallyVisibleVariableColumns().contains(variable)) {
+    return false;
+  }
+  bool applied = pushDownSemiJoinFilterImpl(variable, values);
+  wasRestrictedAfterPlanning_ |= applied;
+  return applied;
+}
+
+// _____________________________________________________________________________
+bool Operation::passSemiJoinFilterSideways(const IdTable& buildSide,
+                                           ColumnIndex joinColumn,
+                                           const Variable& variable,
+                                           QueryExecutionTree& probeSide) {
+  const size_t maxSize = RuntimeParameters().get<"semi-join-filter-max-size">();
+  std::span<const Id> column = buildSide.getColumn(joinColumn);
+  // An UNDEF value matches all the values of the other side. The UNDEF values
+  // are at the beginning of the sorted column.
+  if (maxSize == 0 || column.size() > maxSize ||
+      (!column.empty() && column.front().isUndefined())) {
+    return false;
+  }
+  // Don't replace a result from the cache by a filtered result that has to be
+  // computed.
+  if (_executionContext->getQueryTreeCache().cacheContains(
+          probeSide.getCacheKey())) {
+    return false;
+  }
+  auto values = std::make_shared<std::vector<Id>>();
+  std::ranges::unique_copy(column, std::back_inserter(*values));
+  bool applied =
+      probeSide.getRootOperation()->pushDownSemiJoinFilter(variable, values);
+  if (applied) {
+    runtimeInfo().addDetail("semi-join-filter-size", values->size());
+  }
+  return applied;
+}
+
 // _______________________________________________________________________
 void Operation::updateRuntimeInformationOnSuccess(
     const ResultTable& resultTable, ad_utility::CacheStatus cacheStatus,
@@ -236,6 +294,8 @@ void Operation::updateRuntimeInformationOnSuccess(
       _runtimeInfo->originalTotalTime_ = runtimeInfo->totalTime_;
       _runtimeInfo->originalOperationTime_ = runtimeInfo->getOperationTime();
       _runtimeInfo->details_ = std::move(runtimeInfo->details_);
+      // Reading a result from the cache uses no resources.
+      _runtimeInfo->resourceTracker_.reset();
     }
     // Only the result that was actually computed (or read from cache) knows
     // the correct information about the children computations.
@@ -319,6 +379,7 @@ void Operation::createRuntimeInfoFromEstimates(
   const auto numCols = getResultWidth();
   _runtimeInfo->numCols_ = numCols;
   _runtimeInfo->descriptor_ = getDescriptor();
+  _runtimeInfo->operationType_ = boost::core::demangle(typeid(*this).name());
 
   for (const auto& child : getChildren()) {
     AD_CONTRACT_CHECK(child);
@@ -25,6 +25,12 @@
 
 // forward declaration needed to break dependencies
 class QueryExecutionTree;
+class ColumnStatistics;
+
+// The sorted and distinct values of the join column of one side of a join,
+// with which the other side of the join can be restricted (see
+// `Operation::pushDownSemiJoinFilter`).
+using SemiJoinFilter = std::shared_ptr<const std::vector<Id>>;
 
 class Operation {
   using SharedCancellationHandle = ad_utility::SharedCancellationHandle;
@@ -109,6 +115,14 @@ class Operation {
   virtual float getMultiplicity(size_t col) = 0;
   virtual bool knownEmptyResult() = 0;
 
+  // Return the statistics of the values in the `col`-th column of the result
+  // (see `ColumnStatistics`), or `nullptr` if they are not known. They are
+  // used for more accurate size estimates of filters and joins.
+  virtual std::shared_ptr<const ColumnStatistics> getColumnStatistics(
+      [[maybe_unused]] size_t col) const {
+    return nullptr;
+  }
+
   // Get the mapping from variables to columns but without the variables that
   // are not visible to the outside because they were not selected by a
   // subquery.
@@ -170,6 +184,7 @@ class Operation {
   void setLimit(const LimitOffsetClause& limitOffsetClause) {
     _limit = limitOffsetClause;
   }
+  const auto& getLimit() const { return _limit; }
 
   // Create and return the runtime information wrt the size and cost estimates
   // without actually executing the query.
@@ -190,6 +205,24 @@ class Operation {
   // return nullopt.
   virtual std::optional<Variable> getPrimarySortKeyVariable() const final;
 
+  // Restrict the result of this operation to the rows in which the `variable`
+  // has one of the `values`. This is used for sideways information passing
+  // between the two sides of a join, so it is only done where it doesn't
+  // change the result of the join with the `values` and where it is cheap
+  // (currently only in index scans, which then skip the blocks and rows
+  // without a match). Return true iff the filter was applied somewhere in this
+  // subtree. Has to be called before the result is computed.
+  bool pushDownSemiJoinFilter(const Variable& variable,
+                              const SemiJoinFilter& values);
+
+  // True iff the result of this operation was restricted after the query was
+  // planned (by `pushDownSemiJoinFilter` or by the bounding box of a
+  // geographic filter). The size of the result is then expected to be smaller
+  // than the estimate that the query planner used.
+  bool wasRestrictedAfterPlanning() const {
+    return wasRestrictedAfterPlanning_;
+  }
+
   // Direct access to the `computeResult()` method. This should be only used for
   // testing, otherwise the `getResult()` function should be used which also
   // sets the runtime info and uses the cache.
@@ -208,8 +241,6 @@ class Operation {
    */
   [[nodiscard]] virtual vector<ColumnIndex> resultSortedOn() const = 0;
 
-  const auto& getLimit() const { return _limit; }
-
   /// interface to the generated warnings of this operation
   std::vector<std::string>& getWarnings() { return _warnings; }
   [[nodiscard]] const std::vector<std::string>& getWarnings() const {
@@ -235,6 +266,16 @@ class Operation {
 
   std::chrono::milliseconds remainingTime() const;
 
+  // Push the values of the (sorted) `joinColumn` of the `buildSide` of a join
+  // down into the `probeSide` (see `pushDownSemiJoinFilter`), unless the
+  // `buildSide` has more than `semi-join-filter-max-size` rows or UNDEF values,
+  // or the result of the `probeSide` is already cached. Return true iff the
+  // filter was applied.
+  bool passSemiJoinFilterSideways(const IdTable& buildSide,
+                                  ColumnIndex joinColumn,
+                                  const Variable& variable,
+                                  QueryExecutionTree& probeSide);
+
   /// Pointer to the cancellation handle of this operation.
   SharedCancellationHandle cancellationHandle_ =
       std::make_shared<SharedCancellationHandle::element_type>();
@@ -242,6 +283,9 @@ class Operation {
   std::chrono::steady_clock::time_point deadline_ =
       std::chrono::steady_clock::time_point::max();
 
+  // See `wasRestrictedAfterPlanning`.
+  bool wasRestrictedAfterPlanning_ = false;
+
   // Get the mapping from variables to column indices. This mapping may only be
   // used internally, because the actually visible variables might be different
   // in case of a subquery.
@@ -252,6 +296,17 @@ class Operation {
   //! Compute the result of the query-subtree rooted at this element..
   virtual ResultTable computeResult() = 0;
 
+  // The implementation of `pushDownSemiJoinFilter`. Operations may only
+  // override this if the rows of their result that depend on a row of a child
+  // in which the `variable` is bound to a value that is not in the `values`
+  // are bound to such a value as well (like for joins and filters, but not for
+  // the right side of an OPTIONAL).
+  virtual bool pushDownSemiJoinFilterImpl(
+      [[maybe_unused]] const Variable& variable,
+      [[maybe_unused]] const SemiJoinFilter& values) {
+    return false;
+  }
+
   // Create and store the complete runtime information for this operation after
   // it has either been succesfully computed or read from the cache.
   virtual void updateRuntimeInformationOnSuccess(
@@ -11,10 +11,71 @@
 #include "engine/Comparators.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/ValueIdComparators.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
 
 using std::endl;
 using std::string;
 
+namespace {
+// The rank of each `VocabIndex`, `LocalVocabIndex`, and `ShortString` of a
+// column in the order of their strings.
+using StringRanks = ad_utility::HashMap<Id, size_t>;
+
+// ____________________________________________________________________________
+bool isString(Id id) {
+  auto type = id.getDatatype();
+  return type == Datatype::VocabIndex || type == Datatype::LocalVocabIndex ||
+         type == Datatype::ShortString;
+}
+
+// `ShortString`s are not part of the vocabulary, so the order of their bits is
+// not the order of the vocabulary. If the `column` contains `ShortString`s,
+// resolve the strings of all the distinct `VocabIndex`, `LocalVocabIndex`, and
+// `ShortString` IDs of the column once and return their ranks in the order of
+// the vocabulary (ties are broken by the bits of the IDs). Otherwise, return
+// `std::nullopt`.
+std::optional<StringRanks> computeStringRanks(std::span<const Id> column,
+                                              const Index& index,
+                                              const LocalVocab& localVocab) {
+  if (std::ranges::none_of(column, [](Id id) {
+        return id.getDatatype() == Datatype::ShortString;
+      })) {
+    return std::nullopt;
+  }
+  ad_utility::HashSet<Id> distinctIds;
+  std::vector<std::pair<std::string, Id>> strings;
+  for (Id id : column) {
+    if (!isString(id) || !distinctIds.insert(id).second) {
+      continue;
+    }
+    switch (id.getDatatype()) {
+      case Datatype::ShortString:
+        strings.emplace_back(id.getShortString().toLiteral(), id);
+        break;
+      case Datatype::VocabIndex:
+        strings.emplace_back(
+            index.idToOptionalString(id.getVocabIndex()).value_or(""), id);
+        break;
+      default:
+        AD_CORRECTNESS_CHECK(id.getDatatype() == Datatype::LocalVocabIndex);
+        strings.emplace_back(localVocab.getWord(id.getLocalVocabIndex()), id);
+    }
+  }
+  const auto& comparator = index.getVocab().getCaseComparator();
+  std::ranges::sort(strings, [&comparator](const auto& a, const auto& b) {
+    int cmp = comparator.compare(a.first, b.first,
+                                 TripleComponentComparator::Level::QUARTERNARY);
+    return cmp != 0 ? cmp < 0 : a.second < b.second;
+  });
+  StringRanks ranks;
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ranks[strings[i].second] = i;
+  }
+  return ranks;
+}
+}  // namespace
+
 // _____________________________________________________________________________
 size_t OrderBy::getResultWidth() const { return subtree_->getResultWidth(); }
 
@@ -107,18 +168,40 @@ ResultTable OrderBy::computeResult() {
   // only contains a single datatype, then we can use more efficient
   // implementations here.
 
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
+  // For the columns that contain `ShortString`s, the strings are compared via
+  // their ranks (see `computeStringRanks`). The strings then take the place of
+  // the `VocabIndex`es in the order of the datatypes, s.t. the order is a
+  // total order.
+  std::vector<std::optional<StringRanks>> stringRanks;
+  for (ColumnIndex column : sortIndices_ | std::views::keys) {
+    stringRanks.push_back(computeStringRanks(
+        idTable.getColumn(column), getIndex(), subRes->localVocab()));
+  }
+  Id someVocabId = Id::makeFromVocabIndex(VocabIndex::make(0));
+
+  // Return true iff `row1` comes before `row2` in the sort order specified by
   // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
+  auto comparison = [this, &stringRanks, someVocabId](
+                        const auto& row1, const auto& row2) -> bool {
+    using namespace valueIdComparators;
+    for (size_t i = 0; i < sortIndices_.size(); ++i) {
+      const auto& [column, isDescending] = sortIndices_[i];
+      Id a = row1[column];
+      Id b = row2[column];
+      if (a == b) {
         continue;
       }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
+      if (stringRanks[i].has_value() && (isString(a) || isString(b))) {
+        if (isString(a) && isString(b)) {
+          const auto& ranks = stringRanks[i].value();
+          return (ranks.at(a) < ranks.at(b)) != isDescending;
+        }
+        a = isString(a) ? someVocabId : a;
+        b = isString(b) ? someVocabId : b;
+      }
+      bool isLessThan = toBoolNotUndef(
+          compareIds<ComparisonForIncompatibleTypes::CompareByType>(
+              a, b, Comparison::LT));
       return isLessThan != isDescending;
     }
     return false;
@@ -40,6 +40,15 @@ class CacheValue {
             std::make_shared<const ResultTable>(std::move(resultTable))),
         _runtimeInfo(std::move(runtimeInfo)) {}
 
+  // Share a `resultTable` that is already owned elsewhere (for example, by a
+  // `MaterializedView`).
+  explicit CacheValue(std::shared_ptr<const ResultTable> resultTable,
+                      RuntimeInformation runtimeInfo)
+      : _resultTable(std::move(resultTable)),
+        _runtimeInfo(std::move(runtimeInfo)) {
+    AD_CONTRACT_CHECK(_resultTable != nullptr);
+  }
+
   const shared_ptr<const ResultTable>& resultTable() const {
     return _resultTable;
   }
@@ -67,9 +76,27 @@ using ConcurrentLruCache = ad_utility::ConcurrentCache<
 using PinnedSizes =
     ad_utility::Synchronized<ad_utility::HashMap<std::string, size_t>,
                              std::shared_mutex>;
+// The sizes of the results of operations that were observed when the
+// operations were executed, identified by their cache key. The entries are
+// tiny compared to the results themselves, so they are kept much longer than
+// the results, and the query planner uses them instead of the estimates for
+// subtrees that were already executed (for example, by an earlier run of the
+// same query). The number of entries is bounded by the runtime parameter
+// `observed-sizes-max-num-entries`, the least recently used are evicted.
+using ObservedSizes = ad_utility::Synchronized<
+    ad_utility::LRUCache<std::string, size_t,
+                         ad_utility::DefaultValueSizeGetter<size_t>>,
+    std::mutex>;
 class QueryResultCache : public ConcurrentLruCache {
  private:
   PinnedSizes _pinnedSizes;
+  ObservedSizes observedSizes_{
+      RuntimeParameters().get<"observed-sizes-max-num-entries">()};
+  // The sizes of joins of two index scans that were estimated by sampling
+  // (see `IndexScan::estimateJoinSizeBySampling`), identified by the cache
+  // keys of the two scans. They are bounded like the observed sizes.
+  ObservedSizes sampledJoinSizes_{
+      RuntimeParameters().get<"observed-sizes-max-num-entries">()};
 
  public:
   virtual ~QueryResultCache() = default;
@@ -79,6 +106,8 @@ class QueryResultCache : public ConcurrentLruCache {
     auto lock = _pinnedSizes.wlock();
     ConcurrentLruCache::clearAll();
     lock->clear();
+    observedSizes_.wlock()->clearAll();
+    sampledJoinSizes_.wlock()->clearAll();
   }
   // Inherit the constructor.
   using ConcurrentLruCache::ConcurrentLruCache;
@@ -92,6 +121,46 @@ class QueryResultCache : public ConcurrentLruCache {
       return std::nullopt;
     }
   }
+
+  // Store the observed size of the result of the operation with the given
+  // cache `key` (see `ObservedSizes` above).
+  void addObservedSize(const std::string& key, size_t size) {
+    addSize(observedSizes_, key, size);
+  }
+  std::optional<size_t> getObservedSize(const std::string& key) {
+    return getSize(observedSizes_, key);
+  }
+  size_t numObservedSizes() const {
+    return observedSizes_.wlock()->numNonPinnedEntries();
+  }
+  void setMaxNumObservedSizes(size_t maxNumEntries) {
+    observedSizes_.wlock()->setMaxNumEntries(maxNumEntries);
+    sampledJoinSizes_.wlock()->setMaxNumEntries(maxNumEntries);
+  }
+
+  // Store and look up the sampled size of the join with the given `key`.
+  void addSampledJoinSize(const std::string& key, size_t size) {
+    addSize(sampledJoinSizes_, key, size);
+  }
+  std::optional<size_t> getSampledJoinSize(const std::string& key) {
+    return getSize(sampledJoinSizes_, key);
+  }
+
+ private:
+  static void addSize(ObservedSizes& sizes, const std::string& key,
+                      size_t size) {
+    auto lock = sizes.wlock();
+    lock->erase(key);
+    lock->insert(key, size);
+  }
+  static std::optional<size_t> getSize(ObservedSizes& sizes,
+                                       const std::string& key) {
+    auto size = (*sizes.wlock())[key];
+    if (size == nullptr) {
+      return std::nullopt;
+    }
+    return *size;
+  }
 };
 
 // Execution context for queries.
@@ -144,6 +213,12 @@ class QueryExecutionContext {
 
   bool _pinSubtrees;
   bool _pinResult;
+  // If true, the execution of the query is aborted with a
+  // `ResultSizeDeviatesFromEstimateException` when the size of the result of a
+  // subtree deviates from its estimate by more than the factor
+  // `replanning-min-deviation-factor`, s.t. the rest of the query can be
+  // planned again (see `QueryExecutionTree::getResult`).
+  bool _replanOnSizeDeviation = false;
 
  private:
   const Index& _index;
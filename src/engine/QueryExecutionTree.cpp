@@ -11,6 +11,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/strings/str_cat.h"
 #include "engine/Bind.h"
 #include "engine/CartesianProductJoin.h"
 #include "engine/CountAvailablePredicates.h"
@@ -36,6 +37,7 @@
 #include "engine/Union.h"
 #include "engine/Values.h"
 #include "engine/ValuesForTesting.h"
+#include "engine/WorstCaseOptimalJoin.h"
 #include "parser/RdfEscaping.h"
 
 using std::string;
@@ -108,6 +110,12 @@ size_t QueryExecutionTree::getSizeEstimate() {
   if (!sizeEstimate_.has_value()) {
     if (cachedResult_) {
       sizeEstimate_ = cachedResult_->size();
+    } else if (observedSize_.has_value()) {
+      // The observed size already includes the LIMIT of the operation, unless
+      // the limit was set after the tree was created.
+      sizeEstimate_ = std::min(
+          observedSize_.value(),
+          rootOperation_->getLimit()._limit.value_or(observedSize_.value()));
     } else {
       // if we are in a unit test setting and there is no QueryExecutionContest
       // specified it is the rootOperation_'s obligation to handle this case
@@ -138,12 +146,48 @@ void QueryExecutionTree::readFromCache() {
     return;
   }
   auto& cache = qec_->getQueryTreeCache();
-  auto res = cache.getIfContained(getCacheKey());
+  const auto cacheKey = getCacheKey();
+  auto res = cache.getIfContained(cacheKey);
   if (res.has_value()) {
     cachedResult_ = res->_resultPointer->resultTable();
+  } else if (RuntimeParameters().get<"use-observed-sizes">()) {
+    observedSize_ = cache.getObservedSize(cacheKey);
   }
 }
 
+// _____________________________________________________________________________
+shared_ptr<const ResultTable> QueryExecutionTree::getResult() const {
+  auto result = rootOperation_->getResult(isRoot());
+  if (!qec_) {
+    return result;
+  }
+  qec_->getQueryTreeCache().addObservedSize(getCacheKey(), result->size());
+
+  // The estimate that was used by the query planner is `sizeEstimate_`. If
+  // the size of the result is far off, the plan for the rest of the query is
+  // probably bad, so we abort its execution, s.t. it can be planned again. The
+  // computations of the parent operations are given up, other queries that
+  // wait for them compute them themselves (see `ConcurrentCache`). A result
+  // that was restricted after the planning (for example by a semi-join filter)
+  // is smaller than the estimate on purpose.
+  const double factor =
+      RuntimeParameters().get<"replanning-min-deviation-factor">();
+  if (isRoot() || !qec_->_replanOnSizeDeviation || factor <= 0 ||
+      !sizeEstimate_.has_value() ||
+      rootOperation_->wasRestrictedAfterPlanning()) {
+    return result;
+  }
+  auto estimate =
+      static_cast<double>(std::max(sizeEstimate_.value(), size_t{1}));
+  auto actual = static_cast<double>(std::max(result->size(), size_t{1}));
+  if (std::max(estimate / actual, actual / estimate) >= factor) {
+    throw ResultSizeDeviatesFromEstimateException{absl::StrCat(
+        "The result of \"", rootOperation_->getDescriptor(), "\" has ",
+        result->size(), " rows, but the estimate was ", sizeEstimate_.value())};
+  }
+  return result;
+}
+
 template <typename Op>
 void QueryExecutionTree::setOperation(std::shared_ptr<Op> operation) {
   if constexpr (std::is_same_v<Op, IndexScan>) {
@@ -195,6 +239,8 @@ void QueryExecutionTree::setOperation(std::shared_ptr<Op> operation) {
     type_ = DUMMY;
   } else if constexpr (std::is_same_v<Op, CartesianProductJoin>) {
     type_ = CARTESIAN_PRODUCT_JOIN;
+  } else if constexpr (std::is_same_v<Op, WorstCaseOptimalJoin>) {
+    type_ = WORST_CASE_OPTIMAL_JOIN;
   } else {
     static_assert(ad_utility::alwaysFalse<Op>,
                   "New type of operation that was not yet registered");
@@ -239,6 +285,8 @@ template void QueryExecutionTree::setOperation(
     std::shared_ptr<ValuesForTestingNoKnownEmptyResult>);
 template void QueryExecutionTree::setOperation(
     std::shared_ptr<CartesianProductJoin>);
+template void QueryExecutionTree::setOperation(
+    std::shared_ptr<WorstCaseOptimalJoin>);
 
 // ________________________________________________________________________________________________________________
 std::shared_ptr<QueryExecutionTree> QueryExecutionTree::createSortedTree(
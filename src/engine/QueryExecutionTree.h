@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -23,6 +24,19 @@
 using std::shared_ptr;
 using std::string;
 
+// Thrown by `QueryExecutionTree::getResult` when the size of the result of a
+// subtree deviates strongly from its estimate. The results that were computed
+// so far are in the cache, and their sizes are stored as observed sizes, so
+// when the query is planned again, the new plan uses these exact sizes and
+// reuses the results. Other queries that wait for the results of the
+// operations that are given up compute these results themselves.
+class ResultSizeDeviatesFromEstimateException
+    : public ad_utility::ComputationWasGivenUpException {
+ public:
+  using ad_utility::ComputationWasGivenUpException::
+      ComputationWasGivenUpException;
+};
+
 // A query execution tree. Processed bottom up, which gives an ordering to the
 // operations needed to solve a query.
 class QueryExecutionTree {
@@ -60,7 +74,8 @@ class QueryExecutionTree {
     MINUS,
     NEUTRAL_ELEMENT,
     DUMMY,
-    CARTESIAN_PRODUCT_JOIN
+    CARTESIAN_PRODUCT_JOIN,
+    WORST_CASE_OPTIMAL_JOIN
   };
 
   template <typename Op>
@@ -95,9 +110,13 @@ class QueryExecutionTree {
 
   size_t getResultWidth() const { return rootOperation_->getResultWidth(); }
 
-  shared_ptr<const ResultTable> getResult() const {
-    return rootOperation_->getResult(isRoot());
-  }
+  // Compute the result of the root operation (or read it from the cache). The
+  // size of the result is stored as an observed size in the cache of the
+  // `QueryExecutionContext`. If this tree is not the root of the query, and
+  // the size deviates strongly from the size estimate, a
+  // `ResultSizeDeviatesFromEstimateException` may be thrown (see
+  // `QueryExecutionContext::_replanOnSizeDeviation`).
+  shared_ptr<const ResultTable> getResult() const;
 
   // A variable, its column index in the Id space result, and the `ResultType`
   // of this column.
@@ -121,6 +140,7 @@ class QueryExecutionTree {
   void setTextLimit(size_t limit) {
     rootOperation_->setTextLimit(limit);
     sizeEstimate_ = std::nullopt;
+    observedSize_ = std::nullopt;
   }
 
   size_t getCostEstimate();
@@ -242,6 +262,9 @@ class QueryExecutionTree {
                          // operations/subtrees when pinning only the result.
 
   std::shared_ptr<const ResultTable> cachedResult_ = nullptr;
+  // The size of the result of an earlier execution of the same tree, if it
+  // is not cached, but its size is stored as an observed size.
+  std::optional<size_t> observedSize_ = std::nullopt;
 
  public:
   // Helper class to avoid bug in g++ that leads to memory corruption when
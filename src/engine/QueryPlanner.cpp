@@ -7,6 +7,7 @@
 #include "engine/QueryPlanner.h"
 
 #include <algorithm>
+#include <bit>
 #include <ctime>
 
 #include "engine/Bind.h"
@@ -33,6 +34,7 @@
 #include "engine/TransitivePath.h"
 #include "engine/Union.h"
 #include "engine/Values.h"
+#include "engine/WorstCaseOptimalJoin.h"
 #include "parser/Alias.h"
 #include "parser/SparqlParserHelpers.h"
 
@@ -1307,7 +1309,8 @@ void QueryPlanner::applyFiltersIfPossible(
 std::vector<QueryPlanner::SubtreePlan>
 QueryPlanner::runDynamicProgrammingOnConnectedComponent(
     std::vector<SubtreePlan> connectedComponent,
-    const vector<SparqlFilter>& filters, const TripleGraph& tg) const {
+    const vector<SparqlFilter>& filters, const TripleGraph& tg,
+    const std::vector<SubtreePlan>& alternativePlans) const {
   vector<vector<QueryPlanner::SubtreePlan>> dpTab;
   // find the unique number of nodes in the current connected component
   // (there might be duplicates because we already have multiple candidates
@@ -1319,6 +1322,10 @@ QueryPlanner::runDynamicProgrammingOnConnectedComponent(
       dpTab.back() | std::views::transform(&SubtreePlan::_idsOfIncludedNodes),
       std::inserter(uniqueNodeIds, uniqueNodeIds.end()));
   size_t numSeeds = uniqueNodeIds.size();
+  uint64_t nodesOfComponent = 0;
+  for (uint64_t nodes : uniqueNodeIds) {
+    nodesOfComponent |= nodes;
+  }
 
   for (size_t k = 2; k <= numSeeds; ++k) {
     LOG(TRACE) << "Producing plans that unite " << k << " triples."
@@ -1329,6 +1336,17 @@ QueryPlanner::runDynamicProgrammingOnConnectedComponent(
       dpTab[k - 1].insert(dpTab[k - 1].end(), newPlans.begin(), newPlans.end());
       applyFiltersIfPossible(dpTab.back(), filters, false);
     }
+    // The alternative plans for the sets of `k` nodes of this component
+    // compete with the joins from above in the following merges.
+    for (const auto& plan : alternativePlans) {
+      uint64_t nodes = plan._idsOfIncludedNodes;
+      if (static_cast<size_t>(std::popcount(nodes)) == k &&
+          (nodes & ~nodesOfComponent) == 0) {
+        std::vector<SubtreePlan> plans{plan};
+        applyFiltersIfPossible(plans, filters, false);
+        std::ranges::move(plans, std::back_inserter(dpTab[k - 1]));
+      }
+    }
     // As we only passed in connected components, we expect the result to always
     // be nonempty.
     AD_CORRECTNESS_CHECK(!dpTab[k - 1].empty());
@@ -1336,6 +1354,174 @@ QueryPlanner::runDynamicProgrammingOnConnectedComponent(
   return std::move(dpTab.back());
 }
 
+// _____________________________________________________________________________
+std::vector<QueryPlanner::SubtreePlan>
+QueryPlanner::runGreedyPlanningOnConnectedComponent(
+    std::vector<SubtreePlan> connectedComponent,
+    const vector<SparqlFilter>& filters, const TripleGraph& tg,
+    const std::vector<SubtreePlan>& alternativePlans) const {
+  applyFiltersIfPossible(connectedComponent, filters, false);
+  // The plans for the same set of nodes (for example, the scans with
+  // different permutations) form one set. The sets are sorted by their nodes
+  // to make the result deterministic.
+  std::ranges::stable_sort(connectedComponent, std::less{},
+                           &SubtreePlan::_idsOfIncludedNodes);
+  std::vector<std::vector<SubtreePlan>> sets;
+  for (auto& plan : connectedComponent) {
+    if (sets.empty() || sets.back().front()._idsOfIncludedNodes !=
+                            plan._idsOfIncludedNodes) {
+      sets.emplace_back();
+    }
+    sets.back().push_back(std::move(plan));
+  }
+
+  // The merged plans for pairs of sets, identified by their nodes.
+  ad_utility::HashMap<std::pair<uint64_t, uint64_t>, std::vector<SubtreePlan>>
+      mergedPlans;
+  auto getMergedPlans = [&](const std::vector<SubtreePlan>& a,
+                            const std::vector<SubtreePlan>& b)
+      -> std::vector<SubtreePlan>& {
+    std::pair key{a.front()._idsOfIncludedNodes, b.front()._idsOfIncludedNodes};
+    auto it = mergedPlans.find(key);
+    if (it == mergedPlans.end()) {
+      std::vector<SubtreePlan> plans;
+      if (connected(a.front(), b.front(), tg)) {
+        plans = merge(a, b, tg);
+        // The alternative plans for exactly the merged nodes compete with the
+        // joins.
+        for (const auto& plan : alternativePlans) {
+          if (plan._idsOfIncludedNodes == (key.first | key.second)) {
+            plans.push_back(plan);
+          }
+        }
+        applyFiltersIfPossible(plans, filters, false);
+      }
+      it = mergedPlans.emplace(key, std::move(plans)).first;
+    }
+    return it->second;
+  };
+
+  while (sets.size() > 1) {
+    std::optional<std::pair<size_t, size_t>> best;
+    size_t bestCost = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < sets.size(); ++i) {
+      for (size_t j = i + 1; j < sets.size(); ++j) {
+        const auto& plans = getMergedPlans(sets[i], sets[j]);
+        if (plans.empty()) {
+          continue;
+        }
+        size_t cost = plans[findCheapestExecutionTree(plans)].getCostEstimate();
+        if (!best.has_value() || cost < bestCost) {
+          best = std::pair{i, j};
+          bestCost = cost;
+        }
+      }
+    }
+    // As we only passed in connected components, there always is a pair of
+    // sets that can be merged.
+    AD_CORRECTNESS_CHECK(best.has_value());
+    auto [i, j] = best.value();
+    uint64_t nodesI = sets[i].front()._idsOfIncludedNodes;
+    uint64_t nodesJ = sets[j].front()._idsOfIncludedNodes;
+    sets[i] = std::move(getMergedPlans(sets[i], sets[j]));
+    sets.erase(sets.begin() + j);
+    // The merged plans for the two sets that no longer exist are not needed
+    // anymore.
+    for (auto it = mergedPlans.begin(); it != mergedPlans.end();) {
+      auto [a, b] = it->first;
+      if (a == nodesI || a == nodesJ || b == nodesI || b == nodesJ) {
+        mergedPlans.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+  AD_CORRECTNESS_CHECK(!sets.empty());
+  return std::move(sets.front());
+}
+
+// _____________________________________________________________________________
+size_t QueryPlanner::countConnectedSubgraphs(
+    const std::vector<SubtreePlan>& plans, const TripleGraph& tg,
+    size_t budget) const {
+  // One plan for each node.
+  std::vector<const SubtreePlan*> nodes;
+  ad_utility::HashSet<uint64_t> nodeIds;
+  for (const auto& plan : plans) {
+    if (nodeIds.insert(plan._idsOfIncludedNodes).second) {
+      nodes.push_back(&plan);
+    }
+  }
+  // The subgraphs are represented as bitmasks of the indices in `nodes`.
+  AD_CORRECTNESS_CHECK(nodes.size() <= 64);
+  std::vector<uint64_t> neighbors(nodes.size(), 0);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (size_t j = i + 1; j < nodes.size(); ++j) {
+      if (connected(*nodes[i], *nodes[j], tg)) {
+        neighbors[i] |= uint64_t{1} << j;
+        neighbors[j] |= uint64_t{1} << i;
+      }
+    }
+  }
+
+  // Breadth-first search over the connected subgraphs, each of which is
+  // extended by one of its neighbors in each step.
+  ad_utility::HashSet<uint64_t> subgraphs;
+  std::vector<uint64_t> queue;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    subgraphs.insert(uint64_t{1} << i);
+    queue.push_back(uint64_t{1} << i);
+  }
+  for (size_t next = 0; next < queue.size() && subgraphs.size() <= budget;
+       ++next) {
+    uint64_t subgraph = queue[next];
+    uint64_t extensions = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if ((subgraph >> i) & 1) {
+        extensions |= neighbors[i];
+      }
+    }
+    extensions &= ~subgraph;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (((extensions >> i) & 1) &&
+          subgraphs.insert(subgraph | (uint64_t{1} << i)).second) {
+        queue.push_back(subgraph | (uint64_t{1} << i));
+      }
+    }
+  }
+  return subgraphs.size();
+}
+
+// _____________________________________________________________________________
+std::vector<QueryPlanner::SubtreePlan>
+QueryPlanner::createWorstCaseOptimalJoins(const TripleGraph& tg) const {
+  std::vector<SubtreePlan> plans;
+  const size_t minNumTriples =
+      RuntimeParameters().get<"wcoj-min-num-triples">();
+  if (minNumTriples == 0) {
+    return plans;
+  }
+  auto components =
+      tg.getCyclicComponents([](const TripleGraph::Node& node) {
+        return WorstCaseOptimalJoin::isSupportedTriple(node.triple_);
+      });
+  for (const auto& component : components) {
+    if (component.size() < minNumTriples) {
+      continue;
+    }
+    std::vector<SparqlTriple> triples;
+    uint64_t nodes = 0;
+    for (size_t node : component) {
+      triples.push_back(tg._nodeMap.find(node)->second->triple_);
+      nodes |= uint64_t{1} << node;
+    }
+    auto plan = makeSubtreePlan<WorstCaseOptimalJoin>(_qec, triples);
+    plan._idsOfIncludedNodes = nodes;
+    plans.push_back(std::move(plan));
+  }
+  return plans;
+}
+
 // _____________________________________________________________________________
 vector<vector<QueryPlanner::SubtreePlan>> QueryPlanner::fillDpTab(
     const QueryPlanner::TripleGraph& tg, const vector<SparqlFilter>& filters,
@@ -1344,15 +1530,31 @@ vector<vector<QueryPlanner::SubtreePlan>> QueryPlanner::fillDpTab(
     AD_THROW("At most 64 filters allowed at the moment.");
   }
   auto initialPlans = seedWithScansAndText(tg, children);
+  // The worst-case optimal joins are alternatives to the joins of the scans
+  // of their triples, which are planned as usual.
+  auto alternativePlans = createWorstCaseOptimalJoins(tg);
   auto componentIndices = QueryGraph::computeConnectedComponents(initialPlans);
   ad_utility::HashMap<size_t, std::vector<SubtreePlan>> components;
   for (size_t i = 0; i < componentIndices.size(); ++i) {
     components[componentIndices.at(i)].push_back(std::move(initialPlans.at(i)));
   }
   vector<vector<SubtreePlan>> lastDpRowFromComponents;
+  // The dynamic programming creates plans for all the connected subgraphs of
+  // a component, the number of which grows exponentially with the size of
+  // the component. Large components are therefore planned greedily.
+  const size_t budget = RuntimeParameters().get<"query-planning-budget">();
   for (auto& component : components | std::views::values) {
-    lastDpRowFromComponents.push_back(runDynamicProgrammingOnConnectedComponent(
-        std::move(component), filters, tg));
+    if (countConnectedSubgraphs(component, tg, budget) > budget) {
+      LOG(DEBUG) << "Using greedy query planning for a connected component "
+                    "with more than "
+                 << budget << " connected subgraphs" << std::endl;
+      lastDpRowFromComponents.push_back(runGreedyPlanningOnConnectedComponent(
+          std::move(component), filters, tg, alternativePlans));
+    } else {
+      lastDpRowFromComponents.push_back(
+          runDynamicProgrammingOnConnectedComponent(
+              std::move(component), filters, tg, alternativePlans));
+    }
   }
   size_t numConnectedComponents = lastDpRowFromComponents.size();
   if (numConnectedComponents == 0) {
@@ -1492,6 +1694,79 @@ vector<size_t> QueryPlanner::TripleGraph::bfsLeaveOut(
   return res;
 }
 
+// _____________________________________________________________________________
+vector<vector<size_t>> QueryPlanner::TripleGraph::getCyclicComponents(
+    const std::function<bool(const Node&)>& isEdge) const {
+  // For each variable the edges that contain it and have not been removed.
+  ad_utility::HashMap<Variable, ad_utility::HashSet<size_t>> edgesOfVariable;
+  auto getVariables = [this](size_t edge) {
+    const auto& triple = _nodeMap.find(edge)->second->triple_;
+    return std::array{triple._s.getVariable(), triple._o.getVariable()};
+  };
+  for (const auto& node : _nodeStorage) {
+    if (!node.isTextNode() && isEdge(node)) {
+      for (const auto& variable : getVariables(node.id_)) {
+        edgesOfVariable[variable].insert(node.id_);
+      }
+    }
+  }
+
+  // Compute the 2-core by repeatedly removing the variables with only one
+  // edge left.
+  std::vector<Variable> variablesToRemove;
+  for (const auto& [variable, edges] : edgesOfVariable) {
+    if (edges.size() == 1) {
+      variablesToRemove.push_back(variable);
+    }
+  }
+  while (!variablesToRemove.empty()) {
+    Variable variable = std::move(variablesToRemove.back());
+    variablesToRemove.pop_back();
+    auto& edges = edgesOfVariable.at(variable);
+    if (edges.size() != 1) {
+      // The last edge was already removed via the other variable.
+      continue;
+    }
+    size_t edge = *edges.begin();
+    for (const auto& edgeVariable : getVariables(edge)) {
+      auto& otherEdges = edgesOfVariable.at(edgeVariable);
+      otherEdges.erase(edge);
+      if (otherEdges.size() == 1) {
+        variablesToRemove.push_back(edgeVariable);
+      }
+    }
+  }
+
+  // The connected components of the remaining edges.
+  std::set<size_t> remainingEdges;
+  for (const auto& edges : edgesOfVariable | std::views::values) {
+    remainingEdges.insert(edges.begin(), edges.end());
+  }
+  vector<vector<size_t>> components;
+  ad_utility::HashSet<size_t> visited;
+  for (size_t start : remainingEdges) {
+    if (!visited.insert(start).second) {
+      continue;
+    }
+    auto& component = components.emplace_back();
+    std::vector<size_t> stack{start};
+    while (!stack.empty()) {
+      size_t edge = stack.back();
+      stack.pop_back();
+      component.push_back(edge);
+      for (const auto& variable : getVariables(edge)) {
+        for (size_t neighbor : edgesOfVariable.at(variable)) {
+          if (visited.insert(neighbor).second) {
+            stack.push_back(neighbor);
+          }
+        }
+      }
+    }
+    std::ranges::sort(component);
+  }
+  return components;
+}
+
 // _____________________________________________________________________________
 vector<SparqlFilter> QueryPlanner::TripleGraph::pickFilters(
     const vector<SparqlFilter>& origFilters,
@@ -1737,16 +2012,26 @@ std::vector<QueryPlanner::SubtreePlan> QueryPlanner::createJoinCandidates(
     return {makeSubtreePlan<OptionalJoin>(_qec, a._qet, b._qet)};
   }
 
+  // Test if one of `a` or `b` is a SERVICE that can be evaluated as a bind
+  // join with the other one.
+  if (auto opt = createJoinWithService(a, b, jcs)) {
+    candidates.push_back(std::move(opt.value()));
+  }
+
   if (jcs.size() >= 2) {
     // If there are two or more join columns and we are not using the
     // TwoColumnJoin (the if part before this comment), use a multiColumnJoin.
     try {
       SubtreePlan plan = makeSubtreePlan<MultiColumnJoin>(_qec, a._qet, b._qet);
       mergeSubtreePlanIds(plan, a, b);
-      return {plan};
+      candidates.push_back(std::move(plan));
     } catch (const std::exception& e) {
+      // The bind join with a SERVICE (see above) also uses a
+      // `MultiColumnJoin`, so it is not possible either.
+      LOG(DEBUG) << "No MultiColumnJoin possible: " << e.what() << std::endl;
       return {};
     }
+    return candidates;
   }
 
   // CASE: JOIN ON ONE COLUMN ONLY.
@@ -1836,6 +2121,55 @@ auto QueryPlanner::createJoinWithTransitivePath(
   return plan;
 }
 
+// _____________________________________________________________________________
+auto QueryPlanner::createJoinWithService(
+    SubtreePlan a, SubtreePlan b,
+    const std::vector<std::array<ColumnIndex, 2>>& jcs)
+    -> std::optional<SubtreePlan> {
+  using enum QueryExecutionTree::OperationType;
+  auto getUnboundService = [](const SubtreePlan& plan) {
+    auto service =
+        plan._qet->getType() == SERVICE
+            ? std::dynamic_pointer_cast<Service>(plan._qet->getRootOperation())
+            : nullptr;
+    return service && !service->hasSiblingTree() ? service : nullptr;
+  };
+  // If both are SERVICEs, the result of `a` is sent to the SERVICE `b`.
+  auto service = getUnboundService(b);
+  const bool aIsService = !service;
+  if (aIsService) {
+    service = getUnboundService(a);
+  }
+  if (!service) {
+    return std::nullopt;
+  }
+  std::shared_ptr<QueryExecutionTree> otherTree = aIsService ? b._qet : a._qet;
+  auto* qec = otherTree->getRootOperation()->getExecutionContext();
+  try {
+    auto boundService = std::make_shared<QueryExecutionTree>(
+        qec, service->createCopyWithSiblingTree(otherTree));
+    // The `Join` and `MultiColumnJoin` take care of sorting their inputs.
+    SubtreePlan plan = [&]() {
+      if (jcs.size() == 1) {
+        const size_t otherCol = aIsService ? jcs[0][1] : jcs[0][0];
+        const size_t serviceCol = aIsService ? jcs[0][0] : jcs[0][1];
+        return makeSubtreePlan<Join>(qec, otherTree, std::move(boundService),
+                                     otherCol, serviceCol);
+      }
+      return makeSubtreePlan<MultiColumnJoin>(qec, otherTree,
+                                              std::move(boundService));
+    }();
+    mergeSubtreePlanIds(plan, a, b);
+    return plan;
+  } catch (const std::exception& e) {
+    // The same conditions as for the regular join apply, see
+    // `createJoinCandidates`.
+    LOG(DEBUG) << "No bind join with the SERVICE possible: " << e.what()
+               << std::endl;
+    return std::nullopt;
+  }
+}
+
 // ______________________________________________________________________________________
 auto QueryPlanner::createJoinWithHasPredicateScan(
     SubtreePlan a, SubtreePlan b,
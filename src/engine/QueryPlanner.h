@@ -5,6 +5,9 @@
 //   2018-     Johannes Kalmbach (kalmbach@informatik.uni-freiburg.de)
 
 #pragma once
+#include <gtest/gtest_prod.h>
+
+#include <functional>
 #include <set>
 #include <vector>
 
@@ -106,6 +109,16 @@ class QueryPlanner {
     vector<size_t> bfsLeaveOut(size_t startNode,
                                ad_utility::HashSet<size_t> leaveOut) const;
 
+    // The nodes for which `isEdge` returns true must have two different
+    // variables as subject and object, and are the edges of a graph with the
+    // variables as vertices. Return the connected components of the 2-core of
+    // this graph (which remains when the variables that are contained in at
+    // most one edge are removed repeatedly, together with their edges). These
+    // are the cyclic parts of the graph. The ids of the nodes of each
+    // component are sorted.
+    vector<vector<size_t>> getCyclicComponents(
+        const std::function<bool(const Node&)>& isEdge) const;
+
    private:
     vector<std::pair<TripleGraph, vector<SparqlFilter>>> splitAtContextVars(
         const vector<SparqlFilter>& origFilters,
@@ -315,6 +328,14 @@ class QueryPlanner {
       SubtreePlan a, SubtreePlan b,
       const std::vector<std::array<ColumnIndex, 2>>& jcs);
 
+  // Used internally by `createJoinCandidates`. If `a` or `b` is a SERVICE
+  // that is not yet bound, returns a join of the other one with a copy of the
+  // SERVICE that is evaluated as a bind join (see `Service.h`). Else returns
+  // `std::nullopt`.
+  [[nodiscard]] static std::optional<SubtreePlan> createJoinWithService(
+      SubtreePlan a, SubtreePlan b,
+      const std::vector<std::array<ColumnIndex, 2>>& jcs);
+
   // Used internally by `createJoinCandidates`. If  `a` or `b` is a
   // `HasPredicateScan` with a variable as a subject (`?x ql:has-predicate
   // <VariableOrIri>`) and `a` and `b` can be joined on that subject variable,
@@ -431,14 +452,45 @@ class QueryPlanner {
 
   // Internal subroutine of `fillDpTab` that  only works on a single connected
   // component of the input. Throws if the subtrees in the `connectedComponent`
-  // are not in fact connected (via their variables).
+  // are not in fact connected (via their variables). The `alternativePlans`
+  // (see `createWorstCaseOptimalJoins`) are added to the plans for their sets
+  // of nodes, if these sets are part of the component.
   runDynamicProgrammingOnConnectedComponent(
       std::vector<SubtreePlan> connectedComponent,
-      const vector<SparqlFilter>& filters, const TripleGraph& tg) const;
+      const vector<SparqlFilter>& filters, const TripleGraph& tg,
+      const std::vector<SubtreePlan>& alternativePlans) const;
+
+  // Alternative to `runDynamicProgrammingOnConnectedComponent` for large
+  // connected components. Start with one set of plans per node and
+  // repeatedly merge the two sets for which the cheapest plan of the join is
+  // cheapest, until only one set is left. The merged sets are cached, so that
+  // the number of calls to `merge` is quadratic in the number of nodes. The
+  // `alternativePlans` are only considered if the merge of two sets yields
+  // exactly their nodes.
+  std::vector<QueryPlanner::SubtreePlan> runGreedyPlanningOnConnectedComponent(
+      std::vector<SubtreePlan> connectedComponent,
+      const vector<SparqlFilter>& filters, const TripleGraph& tg,
+      const std::vector<SubtreePlan>& alternativePlans) const;
+
+  // Return the number of connected subgraphs of the graph that has the
+  // distinct `_idsOfIncludedNodes` of the `plans` as its nodes. This is the
+  // number of sets for which `runDynamicProgrammingOnConnectedComponent`
+  // creates plans. The counting stops as soon as the result is larger than
+  // the `budget`.
+  size_t countConnectedSubgraphs(const std::vector<SubtreePlan>& plans,
+                                 const TripleGraph& tg, size_t budget) const;
+  FRIEND_TEST(QueryPlannerTest, countConnectedSubgraphs);
 
   [[nodiscard]] SubtreePlan getTextLeafPlan(
       const TripleGraph::Node& node) const;
 
+  // Return a `WorstCaseOptimalJoin` of the triples of each cyclic component of
+  // the `tg` (see `TripleGraph::getCyclicComponents`) with at least
+  // `wcoj-min-num-triples` triples. These plans are alternatives to the joins
+  // of the scans of these triples, the cheaper plans are chosen.
+  std::vector<SubtreePlan> createWorstCaseOptimalJoins(
+      const TripleGraph& tg) const;
+
   /**
    * @brief return the index of the cheapest execution tree in the argument.
    *
@@ -133,6 +133,26 @@ std::chrono::milliseconds RuntimeInformation::getOperationTime() const {
   }
 }
 
+// __________________________________________________________________________
+ad_utility::ResourceUsage RuntimeInformation::getResourceUsage() const {
+  return resourceTracker_ ? resourceTracker_->getUsage()
+                          : ad_utility::ResourceUsage{};
+}
+
+// __________________________________________________________________________
+ad_utility::ResourceUsage RuntimeInformation::getTotalResourceUsage() const {
+  auto result = getResourceUsage();
+  // The children of a result that was read from the cache were computed for
+  // an earlier query.
+  if (cacheStatus_ != ad_utility::CacheStatus::computed) {
+    return result;
+  }
+  for (const auto& child : children_) {
+    result.addChildUsage(child->getTotalResourceUsage());
+  }
+  return result;
+}
+
 // __________________________________________________________________________
 size_t RuntimeInformation::getOperationCostEstimate() const {
   size_t result = costEstimate_;
@@ -163,6 +183,34 @@ std::string_view RuntimeInformation::toString(Status status) {
   AD_FAIL();
 }
 
+namespace ad_utility {
+// __________________________________________________________________________
+void to_json(nlohmann::ordered_json& j, const ResourceUsage& usage) {
+  j = nlohmann::ordered_json{
+      {"peak_allocated_bytes", usage.peakAllocatedBytes_},
+      {"total_allocated_bytes", usage.totalAllocatedBytes_},
+      {"bytes_read", usage.bytesRead_},
+      {"blocks_read", usage.numBlocksRead_},
+      {"blocks_decompressed", usage.numBlocksDecompressed_},
+      {"cpu_time", std::chrono::duration_cast<std::chrono::milliseconds>(
+                       usage.cpuTime_)
+                       .count()},
+      {"num_threads", usage.numThreads_}};
+}
+}  // namespace ad_utility
+
+namespace {
+// Remove the resource usage from the JSON of the `children` and their
+// descendants, see `getTotalResourceUsage` above.
+void removeResourceUsage(nlohmann::ordered_json& children) {
+  for (auto& child : children) {
+    child.erase("resource_usage");
+    child.erase("total_resource_usage");
+    removeResourceUsage(child["children"]);
+  }
+}
+}  // namespace
+
 // ________________________________________________________________________________________________________________
 void to_json(nlohmann::ordered_json& j,
              const std::shared_ptr<RuntimeInformation>& rti) {
@@ -189,6 +237,13 @@ void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
       {"estimated_size", rti.sizeEstimate_},
       {"status", RuntimeInformation::toString(rti.status_)},
       {"children", rti.children_}};
+  if (rti.resourceTracker_) {
+    j["resource_usage"] = rti.getResourceUsage();
+    j["total_resource_usage"] = rti.getTotalResourceUsage();
+  }
+  if (rti.cacheStatus_ != ad_utility::CacheStatus::computed) {
+    removeResourceUsage(j["children"]);
+  }
 }
 
 // __________________________________________________________________________
@@ -213,6 +268,7 @@ void RuntimeInformation::addLimitOffsetRow(const LimitOffsetClause& l,
   const auto& actualOperation = children_.at(0);
   numRows_ = l.actualSize(actualOperation->numRows_);
   details_.clear();
+  resourceTracker_.reset();
   cacheStatus_ = ad_utility::CacheStatus::computed;
   totalTime_ += timeForLimit;
   actualOperation->addDetail("not-written-to-cache-because-child-of-limit",
@@ -220,6 +276,7 @@ void RuntimeInformation::addLimitOffsetRow(const LimitOffsetClause& l,
   sizeEstimate_ = l.actualSize(sizeEstimate_);
 
   // Update the descriptor.
+  operationType_ = "LimitOffset";
   descriptor_.clear();
   if (hasLimit) {
     descriptor_ = absl::StrCat("LIMIT ", l._limit.value());
@@ -16,6 +16,7 @@
 #include "parser/data/Variable.h"
 #include "util/ConcurrentCache.h"
 #include "util/HashMap.h"
+#include "util/ResourceTracker.h"
 #include "util/json.h"
 
 /// A class to store information about the status of an operation (result size,
@@ -71,6 +72,10 @@ class RuntimeInformation {
   /// A short human-readable string that identifies the operation.
   std::string descriptor_;
 
+  /// The type of the operation (the name of its class, e.g. `IndexScan`),
+  /// which is used to aggregate the metrics of the server per operation type.
+  std::string operationType_;
+
   /// The names of the variables that are stored in the columns of the result.
   std::vector<std::string> columnNames_;
 
@@ -81,6 +86,12 @@ class RuntimeInformation {
   /// different types of operations.
   nlohmann::json details_;
 
+  /// The tracker of the resources (memory, I/O, CPU time) that were used to
+  /// compute this operation (without its children). It is only set if the
+  /// operation was actually computed and may still be updated while the
+  /// computation is in progress.
+  std::shared_ptr<const ad_utility::ResourceTracker> resourceTracker_;
+
   // Default constructor.
   RuntimeInformation() = default;
 
@@ -100,6 +111,12 @@ class RuntimeInformation {
   /// the time spent computing the children, but always positive.
   [[nodiscard]] Milliseconds getOperationTime() const;
 
+  /// Get the resources used for computing this operation (without its
+  /// children), and the resources used for the complete subtree. The subtree
+  /// of a result that was read from the cache used no resources.
+  [[nodiscard]] ad_utility::ResourceUsage getResourceUsage() const;
+  [[nodiscard]] ad_utility::ResourceUsage getTotalResourceUsage() const;
+
   /// Get the cost estimate for this operation. This is the total cost estimate
   /// minus the sum of the cost estimates of all children.
   [[nodiscard]] size_t getOperationCostEstimate() const;
@@ -19,6 +19,7 @@
 #include "util/ParseableDuration.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/websocket/MessageSender.h"
+#include "util/http/websocket/WebSocketSession.h"
 
 template <typename T>
 using Awaitable = Server::Awaitable<T>;
@@ -30,6 +31,7 @@ Server::Server(unsigned short port, size_t numThreads,
     : numThreads_(numThreads),
       port_(port),
       accessToken_(std::move(accessToken)),
+      maxMemory_(maxMem),
       allocator_{ad_utility::makeAllocationMemoryLeftThreadsafeObject(maxMem),
                  [this](ad_utility::MemorySize numMemoryToAllocate) {
                    cache_.makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
@@ -50,6 +52,8 @@ Server::Server(unsigned short port, size_t numThreads,
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  RuntimeParameters().setOnUpdateAction<"observed-sizes-max-num-entries">(
+      [this](size_t newValue) { cache_.setMaxNumObservedSizes(newValue); });
 }
 
 // __________________________________________________________________________
@@ -70,6 +74,9 @@ void Server::initialize(const string& indexBaseName, bool useText,
       allocator_, index_.numTriples().normalAndInternal_() *
                       PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
 
+  indexBaseName_ = indexBaseName;
+  loadMaterializedViews();
+
   LOG(INFO) << "Access token for restricted API calls is \"" << accessToken_
             << "\"" << std::endl;
   LOG(INFO) << "The server is ready, listening for requests on port "
@@ -308,6 +315,7 @@ Awaitable<void> Server::process(
                  checkParameter("cmd", "clear-cache-complete", accessTokenOk)) {
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache_.clearAll();
+    pinMaterializedViews();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "get-settings")) {
     logCommand(cmd, "get server settings");
@@ -316,6 +324,22 @@ Awaitable<void> Server::process(
                  checkParameter("cmd", "dump-active-queries", accessTokenOk)) {
     logCommand(cmd, "dump active queries");
     response = createJsonResponse(queryRegistry_.getActiveQueries(), request);
+  } else if (auto cmd = checkParameter("cmd", "refresh-view", accessTokenOk)) {
+    logCommand(cmd, "compute a materialized view and write it to disk");
+    auto name = checkParameter("view-name", std::nullopt);
+    if (!name.has_value()) {
+      throw std::runtime_error(
+          "The command \"refresh-view\" requires the parameter \"view-name\"");
+    }
+    std::optional<std::string> viewQuery;
+    if (auto value = checkParameter("view-query", std::nullopt)) {
+      viewQuery = std::string{value.value()};
+    }
+    auto viewJson = co_await computeInNewThread([&]() {
+      return refreshMaterializedView(std::string{name.value()},
+                                     std::move(viewQuery));
+    });
+    response = createJsonResponse(viewJson, request);
   }
 
   // Ping with or without messsage.
@@ -330,6 +354,18 @@ Awaitable<void> Server::process(
                                 request, ad_utility::MediaType::textPlain);
   }
 
+  // Metrics in the text format of Prometheus.
+  if (urlPathAndParameters._path == "/metrics") {
+    LOG(DEBUG) << "Metrics requested" << std::endl;
+    auto allocatedBytes =
+        maxMemory_.getBytes() - allocator_.amountMemoryLeft().getBytes();
+    response = createOkResponse(
+        metrics_.toPrometheusFormat(
+            allocatedBytes,
+            ad_utility::websocket::WebSocketSession::getNumActiveSessions()),
+        request, ad_utility::MediaType::textPlain);
+  }
+
   // Set description of KB index.
   if (auto description =
           checkParameter("index-description", std::nullopt, accessTokenOk)) {
@@ -463,6 +499,75 @@ nlohmann::json Server::composeCacheStatsJson() const {
   result["non-pinned-size"] = cache_.nonPinnedSize().getBytes();
   result["pinned-size"] = cache_.pinnedSize().getBytes();
   result["num-pinned-index-scan-sizes"] = cache_.pinnedSizes().rlock()->size();
+  result["num-observed-sizes"] = cache_.numObservedSizes();
+  result["num-materialized-views"] = materializedViews_.rlock()->size();
+  return result;
+}
+
+// _____________________________________________________________________________
+void Server::loadMaterializedViews() {
+  for (const auto& name : MaterializedView::findNames(indexBaseName_)) {
+    auto filename = MaterializedView::getFilename(indexBaseName_, name);
+    try {
+      auto view = MaterializedView::readFromFile(filename, allocator_);
+      if (!view.isValidForIndex(index_)) {
+        LOG(WARN) << "The materialized view \"" << name
+                  << "\" was computed for a different index and is ignored, "
+                     "please refresh it"
+                  << std::endl;
+        continue;
+      }
+      view.pinInCache(cache_);
+      LOG(INFO) << "Loaded materialized view \"" << name << "\" with "
+                << view.result().size() << " rows" << std::endl;
+      materializedViews_.wlock()->insert_or_assign(name, std::move(view));
+    } catch (const std::exception& e) {
+      LOG(WARN) << "Could not load the materialized view from \"" << filename
+                << "\": " << e.what() << std::endl;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void Server::pinMaterializedViews() {
+  for (const auto& view : *materializedViews_.rlock() | std::views::values) {
+    view.pinInCache(cache_);
+  }
+}
+
+// _____________________________________________________________________________
+json Server::refreshMaterializedView(const std::string& name,
+                                     std::optional<std::string> query) {
+  std::optional<std::string> oldCacheKey;
+  {
+    auto lock = materializedViews_.rlock();
+    if (auto it = lock->find(name); it != lock->end()) {
+      oldCacheKey = it->second.cacheKey();
+      query = query.value_or(it->second.query());
+    }
+  }
+  if (!query.has_value()) {
+    throw std::runtime_error(absl::StrCat(
+        "There is no materialized view with name \"", name,
+        "\", please specify its query with the parameter \"view-query\""));
+  }
+  QueryExecutionContext qec{index_, &cache_, allocator_,
+                            sortPerformanceEstimator_};
+  auto plannedQuery = planQuery(query.value(), qec);
+  auto& qet = plannedQuery.queryExecutionTree_;
+  // Compute the result from scratch, and not take the (pinned) result of the
+  // previous version of the view from the cache.
+  cache_.erase(qet.getCacheKey());
+  if (oldCacheKey.has_value()) {
+    cache_.erase(oldCacheKey.value());
+  }
+  auto view = MaterializedView::compute(name, std::move(query.value()), qet);
+  view.pinInCache(cache_);
+  view.writeToFile(MaterializedView::getFilename(indexBaseName_, name));
+  LOG(INFO) << "Materialized view \"" << name << "\" with "
+            << view.result().size() << " rows written to disk" << std::endl;
+  auto result = view.toJson();
+  materializedViews_.wlock()->insert_or_assign(name, std::move(view));
   return result;
 }
 
@@ -557,6 +662,7 @@ boost::asio::awaitable<void> Server::processQuery(
   };
 
   http::status responseStatus = http::status::ok;
+  using QueryOutcome = ServerMetrics::QueryOutcome;
 
   // Put the whole query processing in a try-catch block. If any exception
   // occurs, log the error message and send a JSON response with all the details
@@ -612,6 +718,7 @@ boost::asio::awaitable<void> Server::processQuery(
     }
 
     if (!mediaType.has_value()) {
+      metrics_.recordQuery(QueryOutcome::badRequest);
       co_return co_await send(createBadRequestResponse(
           absl::StrCat("Did not find any supported media type "
                        "in this \'Accept:\' header field: \"",
@@ -651,6 +758,7 @@ boost::asio::awaitable<void> Server::processQuery(
     LOG(INFO) << "Query planning done in " << timeForQueryPlanning.count()
               << " ms" << std::endl;
     LOG(TRACE) << qet.getCacheKey() << std::endl;
+    ad_utility::Timer executionTimer{ad_utility::Timer::Started};
 
     // Common code for sending responses for the streamable media types
     // (tsv, csv, octet-stream, turtle).
@@ -695,11 +803,35 @@ boost::asio::awaitable<void> Server::processQuery(
       } break;
       case qleverJson:
       case sparqlJson: {
-        // Normal case: JSON response
+        // Normal case: JSON response. If the size of an intermediate result
+        // deviates strongly from its estimate, the query is planned again
+        // (once). The new plan reuses the results that were already computed
+        // because they are in the cache.
+        qec._replanOnSizeDeviation = true;
         auto responseString = co_await computeInNewThread([&, maxSend] {
-          return ExportQueryExecutionTrees::computeResultAsJSON(
-              plannedQuery.value().parsedQuery_, qet, requestTimer, maxSend,
-              mediaType.value());
+          auto compute = [&] {
+            return ExportQueryExecutionTrees::computeResultAsJSON(
+                plannedQuery.value().parsedQuery_, qet, requestTimer, maxSend,
+                mediaType.value());
+          };
+          try {
+            return compute();
+          } catch (const ResultSizeDeviatesFromEstimateException& e) {
+            LOG(INFO) << e.what() << ", planning the query again" << std::endl;
+            qec._replanOnSizeDeviation = false;
+            ad_utility::Timer replanningTimer{ad_utility::Timer::Started};
+            plannedQuery = planQuery(query, qec);
+            qet.isRoot() = true;
+            auto rootOperation = qet.getRootOperation();
+            rootOperation->recursivelySetCancellationHandle(
+                queryRegistry_.getCancellationHandle(
+                    messageSender.getQueryId()));
+            rootOperation->recursivelySetTimeConstraint(timeLimit -
+                                                        requestTimer.msecs());
+            rootOperation->getRuntimeInfoWholeQuery().timeQueryPlanning =
+                timeForQueryPlanning + replanningTimer.msecs();
+            return compute();
+          }
         });
         co_await sendJson(std::move(responseString), responseStatus);
       } break;
@@ -708,6 +840,16 @@ boost::asio::awaitable<void> Server::processQuery(
         // subset of mediaTypes that can occur here.
         AD_FAIL();
     }
+    // The time for the execution is the time of the root operation, the rest
+    // of the time since the query planning was spent for the export.
+    auto timeForExecution =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            qet.getRootOperation()->runtimeInfo().totalTime_);
+    metrics_.recordPhase(ServerMetrics::Phase::execute, timeForExecution);
+    metrics_.recordPhase(ServerMetrics::Phase::export_,
+                         executionTimer.value() - timeForExecution);
+    metrics_.recordQuery(QueryOutcome::ok);
+
     // Print the runtime info. This needs to be done after the query
     // was computed.
 
@@ -728,12 +870,22 @@ boost::asio::awaitable<void> Server::processQuery(
     responseStatus = http::status::bad_request;
     exceptionErrorMsg = e.errorMessageWithoutPositionalInfo();
     metadata = e.metadata();
+    metrics_.recordQuery(QueryOutcome::badRequest);
   } catch (const QueryAlreadyInUseError& e) {
     responseStatus = http::status::conflict;
     exceptionErrorMsg = e.what();
+    metrics_.recordQuery(QueryOutcome::conflict);
   } catch (const std::exception& e) {
     responseStatus = http::status::internal_server_error;
     exceptionErrorMsg = e.what();
+    bool wasCancelled =
+        dynamic_cast<const ad_utility::CancellationException*>(&e) != nullptr;
+    metrics_.recordQuery(wasCancelled ? QueryOutcome::cancelled
+                                      : QueryOutcome::failed);
+  }
+  if (plannedQuery.has_value()) {
+    const auto& qet = plannedQuery.value().queryExecutionTree_;
+    metrics_.recordRuntimeInformation(qet.getRootOperation()->runtimeInfo());
   }
   // TODO<qup42> at this stage should probably have a wrapper that takes
   //  optional<errorMsg> and optional<metadata> and does this logic
@@ -781,13 +933,22 @@ Awaitable<T> Server::computeInNewThread(Function function) const {
 net::awaitable<Server::PlannedQuery> Server::parseAndPlan(
     const std::string& query, QueryExecutionContext& qec) const {
   return computeInNewThread(
-      [&query, &qec, enablePatternTrick = enablePatternTrick_]() {
-        auto pq = SparqlParser::parseQuery(query);
-        QueryPlanner qp(&qec);
-        qp.setEnablePatternTrick(enablePatternTrick);
-        auto qet = qp.createExecutionTree(pq);
-        return PlannedQuery{std::move(pq), std::move(qet)};
-      });
+      [this, &query, &qec]() { return planQuery(query, qec); });
+}
+
+// _____________________________________________________________________________
+Server::PlannedQuery Server::planQuery(const std::string& query,
+                                       QueryExecutionContext& qec) const {
+  using Phase = ServerMetrics::Phase;
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  auto pq = SparqlParser::parseQuery(query);
+  metrics_.recordPhase(Phase::parse, timer.value());
+  timer.start();
+  QueryPlanner qp(&qec);
+  qp.setEnablePatternTrick(enablePatternTrick_);
+  auto qet = qp.createExecutionTree(pq);
+  metrics_.recordPhase(Phase::plan, timer.value());
+  return PlannedQuery{std::move(pq), std::move(qet)};
 }
 
 // _____________________________________________________________________________
@@ -10,8 +10,10 @@
 #include <vector>
 
 #include "engine/Engine.h"
+#include "engine/MaterializedView.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/ServerMetrics.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/Index.h"
 #include "parser/SparqlParser.h"
@@ -62,6 +64,7 @@ class Server {
   const size_t numThreads_;
   unsigned short port_;
   std::string accessToken_;
+  ad_utility::MemorySize maxMemory_;
   QueryResultCache cache_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
   SortPerformanceEstimator sortPerformanceEstimator_;
@@ -70,6 +73,18 @@ class Server {
 
   bool enablePatternTrick_;
 
+  /// The basename of the index, which is also the prefix of the files of the
+  /// materialized views.
+  std::string indexBaseName_;
+  /// The materialized views by name. Their results are pinned in the
+  /// `cache_`.
+  ad_utility::Synchronized<ad_utility::HashMap<std::string, MaterializedView>>
+      materializedViews_;
+
+  /// The metrics that are exposed on the `/metrics` endpoint. They are also
+  /// recorded from `const` member functions like `planQuery`.
+  mutable ServerMetrics metrics_;
+
   /// Non-owning reference to the `QueryHub` instance living inside
   /// the `WebSocketHandler` created for `HttpServer`.
   std::weak_ptr<ad_utility::websocket::QueryHub> queryHub_;
@@ -120,6 +135,22 @@ class Server {
 
   json composeCacheStatsJson() const;
 
+  /// Read the materialized views that are stored next to the index and pin
+  /// their results in the cache. Views that cannot be read or that were
+  /// computed for a different index are skipped with a warning.
+  void loadMaterializedViews();
+
+  /// Pin the results of all the materialized views in the cache again (after
+  /// the cache was cleared completely).
+  void pinMaterializedViews();
+
+  /// Compute the materialized view with the given `name` for the `query`,
+  /// write it to disk, and pin its result in the cache. If no `query` is
+  /// given, the query of the existing view with this name is used. Return a
+  /// summary of the view.
+  json refreshMaterializedView(const std::string& name,
+                               std::optional<std::string> query);
+
   // Perform the following steps: Acquire a token from the
   // queryProcessingSemaphore_, run `function`, and release the token. These
   // steps are performed on a new thread (not one of the server threads).
@@ -166,6 +197,10 @@ class Server {
   net::awaitable<PlannedQuery> parseAndPlan(const std::string& query,
                                             QueryExecutionContext& qec) const;
 
+  /// Parse and plan the `query` in the current thread.
+  PlannedQuery planQuery(const std::string& query,
+                         QueryExecutionContext& qec) const;
+
   /// Check if the access token is valid. Return true if the access token
   /// exists and is valid. Return false if there's no access token passed.
   /// Throw an exception if there is a token passed but it doesn't match,
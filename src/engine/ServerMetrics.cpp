@@ -0,0 +1,140 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "engine/ServerMetrics.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+constexpr std::array<std::string_view, ServerMetrics::numQueryOutcomes>
+    queryOutcomeNames{"ok", "bad_request", "conflict", "cancelled", "failed"};
+constexpr std::array<std::string_view, ServerMetrics::numPhases> phaseNames{
+    "parse", "plan", "execute", "export"};
+constexpr std::array cacheStatuses{
+    ad_utility::CacheStatus::cachedNotPinned,
+    ad_utility::CacheStatus::cachedPinned, ad_utility::CacheStatus::computed,
+    ad_utility::CacheStatus::notInCacheAndNotComputed};
+// The durations are recorded in microseconds and exported in seconds.
+constexpr double secondsPerMicrosecond = 1e-6;
+}  // namespace
+
+// _____________________________________________________________________________
+auto ServerMetrics::getOperationMetrics(const std::string& operationType)
+    -> OperationMetrics& {
+  {
+    auto lock = operations_.rlock();
+    if (auto it = lock->find(operationType); it != lock->end()) {
+      return *it->second;
+    }
+  }
+  auto lock = operations_.wlock();
+  auto& metrics = (*lock)[operationType];
+  if (!metrics) {
+    metrics = std::make_unique<OperationMetrics>();
+  }
+  // The `OperationMetrics` are never erased and their address is stable.
+  return *metrics;
+}
+
+// _____________________________________________________________________________
+void ServerMetrics::recordRuntimeInformation(
+    const RuntimeInformation& runtimeInfo) {
+  using enum RuntimeInformation::Status;
+  // Operations that haven't been started (for example, because a sibling was
+  // empty) neither have a cache status nor children that have been started.
+  if (runtimeInfo.status_ == notStarted) {
+    return;
+  }
+  cacheStatuses_.at(static_cast<size_t>(runtimeInfo.cacheStatus_)).increment();
+  bool wasComputed =
+      (runtimeInfo.status_ == fullyMaterialized ||
+       runtimeInfo.status_ == lazilyMaterialized) &&
+      runtimeInfo.cacheStatus_ == ad_utility::CacheStatus::computed;
+  if (wasComputed && !runtimeInfo.operationType_.empty()) {
+    auto& metrics = getOperationMetrics(runtimeInfo.operationType_);
+    metrics.computeTime_.record(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            runtimeInfo.getOperationTime())
+            .count());
+    metrics.numRows_.increment(runtimeInfo.numRows_);
+  }
+  // The children of a cached result are those of the query that computed it,
+  // so they have already been recorded for that query.
+  if (runtimeInfo.cacheStatus_ != ad_utility::CacheStatus::computed) {
+    return;
+  }
+  for (const auto& child : runtimeInfo.children_) {
+    recordRuntimeInformation(*child);
+  }
+}
+
+// _____________________________________________________________________________
+std::string ServerMetrics::toPrometheusFormat(
+    size_t allocatedBytes, size_t numActiveWebSocketSessions) const {
+  ad_utility::metrics::PrometheusWriter writer;
+
+  writer.addMetric("qlever_queries_total",
+                   "The number of processed queries by outcome.", "counter");
+  for (size_t i = 0; i < numQueryOutcomes; ++i) {
+    writer.addSample("qlever_queries_total",
+                     {{"outcome", queryOutcomeNames[i]}}, queries_[i].get());
+  }
+
+  writer.addMetric("qlever_query_phase_duration_seconds",
+                   "The time spent in the phases of the query processing.",
+                   "histogram");
+  for (size_t i = 0; i < numPhases; ++i) {
+    writer.addHistogram("qlever_query_phase_duration_seconds",
+                        {{"phase", phaseNames[i]}}, phaseDurations_[i],
+                        secondsPerMicrosecond);
+  }
+
+  writer.addMetric("qlever_operation_cache_status_total",
+                   "The number of operations by their cache status.",
+                   "counter");
+  for (auto status : cacheStatuses) {
+    writer.addSample("qlever_operation_cache_status_total",
+                     {{"status", ad_utility::toString(status)}},
+                     cacheStatuses_[static_cast<size_t>(status)].get());
+  }
+
+  {
+    auto lock = operations_.rlock();
+    std::vector<const std::string*> operationTypes;
+    for (const auto& [operationType, metrics] : *lock) {
+      operationTypes.push_back(&operationType);
+    }
+    std::ranges::sort(operationTypes, std::less{},
+                      [](const std::string* s) { return *s; });
+    writer.addMetric("qlever_operation_compute_duration_seconds",
+                     "The time spent computing operations (without their "
+                     "children) by operation type.",
+                     "histogram");
+    for (const auto* operationType : operationTypes) {
+      writer.addHistogram("qlever_operation_compute_duration_seconds",
+                          {{"operation", *operationType}},
+                          lock->at(*operationType)->computeTime_,
+                          secondsPerMicrosecond);
+    }
+    writer.addMetric("qlever_operation_result_rows_total",
+                     "The number of rows computed by operation type.",
+                     "counter");
+    for (const auto* operationType : operationTypes) {
+      writer.addSample("qlever_operation_result_rows_total",
+                       {{"operation", *operationType}},
+                       lock->at(*operationType)->numRows_.get());
+    }
+  }
+
+  writer.addMetric("qlever_allocated_memory_bytes",
+                   "The memory that is currently allocated for query results.",
+                   "gauge");
+  writer.addSample("qlever_allocated_memory_bytes", {}, allocatedBytes);
+
+  writer.addMetric("qlever_active_websocket_sessions",
+                   "The number of currently open websocket sessions.", "gauge");
+  writer.addSample("qlever_active_websocket_sessions", {},
+                   numActiveWebSocketSessions);
+  return std::move(writer).get();
+}
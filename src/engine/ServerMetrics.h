@@ -0,0 +1,82 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+#include "engine/RuntimeInformation.h"
+#include "util/HashMap.h"
+#include "util/Metrics.h"
+#include "util/Synchronized.h"
+
+// The metrics of the `Server` that are exposed on the `/metrics` endpoint in
+// the text format of Prometheus. Recording a metric is a relaxed atomic
+// increment. The only exception are the metrics per operation type, which are
+// recorded once per query after the query has been computed and which require
+// a lookup in a hash map under a shared lock.
+class ServerMetrics {
+ public:
+  // The possible outcomes of a query.
+  enum struct QueryOutcome { ok, badRequest, conflict, cancelled, failed };
+  static constexpr size_t numQueryOutcomes = 5;
+
+  // The phases of the processing of a query.
+  enum struct Phase { parse, plan, execute, export_ };
+  static constexpr size_t numPhases = 4;
+
+  // The durations are recorded in microseconds, durations of more than about
+  // two hours are in the last bucket of the histograms.
+  static constexpr uint64_t maxDurationInMicroseconds = uint64_t{1} << 33;
+
+ private:
+  using Histogram = ad_utility::metrics::Histogram;
+  using Counter = ad_utility::metrics::Counter;
+
+  std::array<Counter, numQueryOutcomes> queries_;
+  std::array<Histogram, numPhases> phaseDurations_{
+      Histogram{maxDurationInMicroseconds},
+      Histogram{maxDurationInMicroseconds},
+      Histogram{maxDurationInMicroseconds},
+      Histogram{maxDurationInMicroseconds}};
+  // One counter per `ad_utility::CacheStatus`.
+  std::array<Counter, 4> cacheStatuses_;
+
+  struct OperationMetrics {
+    Histogram computeTime_{maxDurationInMicroseconds};
+    Counter numRows_;
+  };
+  ad_utility::Synchronized<
+      ad_utility::HashMap<std::string, std::unique_ptr<OperationMetrics>>,
+      std::shared_mutex>
+      operations_;
+
+ public:
+  void recordQuery(QueryOutcome outcome) {
+    queries_.at(static_cast<size_t>(outcome)).increment();
+  }
+
+  void recordPhase(Phase phase, std::chrono::microseconds duration) {
+    phaseDurations_.at(static_cast<size_t>(phase))
+        .record(std::max(duration.count(), int64_t{0}));
+  }
+
+  // Record the compute time and the number of rows of each operation and the
+  // cache status of each operation in the tree of the `runtimeInfo`. The
+  // operations that were not started and the subtrees below cached results
+  // are skipped.
+  void recordRuntimeInformation(const RuntimeInformation& runtimeInfo);
+
+  // Export all the metrics. The values of the gauges which are not stored in
+  // this class are passed in as arguments.
+  std::string toPrometheusFormat(size_t allocatedBytes,
+                                 size_t numActiveWebSocketSessions) const;
+
+ private:
+  OperationMetrics& getOperationMetrics(const std::string& operationType);
+};
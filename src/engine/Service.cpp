@@ -4,25 +4,72 @@
 
 #include "engine/Service.h"
 
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <future>
+
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "engine/CallFixedSize.h"
+#include "engine/ExportQueryExecutionTrees.h"
+#include "engine/LocalVocab.h"
 #include "engine/Values.h"
 #include "engine/VariableToColumnMap.h"
+#include "global/Constants.h"
+#include "parser/RdfEscaping.h"
 #include "parser/TokenizerCtre.h"
 #include "parser/TurtleParser.h"
 #include "util/Exception.h"
+#include "util/HashMap.h"
 #include "util/HashSet.h"
 #include "util/http/HttpClient.h"
 #include "util/http/HttpUtils.h"
 
+namespace {
+// Split the chunks of a TSV result into lines. A line can span several chunks.
+// The yielded views are only valid until the next line is requested.
+cppcoro::generator<std::string_view> splitIntoLines(
+    cppcoro::generator<std::string> chunks) {
+  std::string partialLine;
+  for (const std::string& chunk : chunks) {
+    std::string_view rest = chunk;
+    for (size_t pos = rest.find('\n'); pos != std::string_view::npos;
+         pos = rest.find('\n')) {
+      if (partialLine.empty()) {
+        co_yield rest.substr(0, pos);
+      } else {
+        partialLine.append(rest.substr(0, pos));
+        co_yield std::string_view{partialLine};
+        partialLine.clear();
+      }
+      rest.remove_prefix(pos + 1);
+    }
+    partialLine.append(rest);
+  }
+  if (!partialLine.empty()) {
+    co_yield std::string_view{partialLine};
+  }
+}
+}  // namespace
+
 // ____________________________________________________________________________
 Service::Service(QueryExecutionContext* qec,
                  parsedQuery::Service parsedServiceClause,
-                 GetTsvFunction getTsvFunction)
+                 GetTsvFunction getTsvFunction,
+                 std::shared_ptr<QueryExecutionTree> siblingTree)
     : Operation{qec},
       parsedServiceClause_{std::move(parsedServiceClause)},
-      getTsvFunction_{std::move(getTsvFunction)} {}
+      getTsvFunction_{std::move(getTsvFunction)},
+      siblingTree_{std::move(siblingTree)} {}
+
+// ____________________________________________________________________________
+std::shared_ptr<Service> Service::createCopyWithSiblingTree(
+    std::shared_ptr<QueryExecutionTree> siblingTree) const {
+  AD_CONTRACT_CHECK(siblingTree != nullptr);
+  return std::make_shared<Service>(getExecutionContext(), parsedServiceClause_,
+                                   getTsvFunction_, std::move(siblingTree));
+}
 
 // ____________________________________________________________________________
 std::string Service::getCacheKeyImpl() const {
@@ -31,15 +78,18 @@ std::string Service::getCacheKeyImpl() const {
   os << "SERVICE " << parsedServiceClause_.serviceIri_.toSparql() << " {\n"
      << parsedServiceClause_.prologue_ << "\n"
      << parsedServiceClause_.graphPatternAsString_ << "\n}\n";
+  if (siblingTree_) {
+    os << "BIND JOIN WITH {\n" << siblingTree_->getCacheKey() << "\n}\n";
+  }
   return std::move(os).str();
 }
 
 // ____________________________________________________________________________
 std::string Service::getDescriptor() const {
   return absl::StrCat("Service with IRI ",
-                      parsedServiceClause_.serviceIri_.toSparql());
+                      parsedServiceClause_.serviceIri_.toSparql(),
+                      siblingTree_ ? " (bind join)" : "");
 }
-
 // ____________________________________________________________________________
 size_t Service::getResultWidth() const {
   return parsedServiceClause_.visibleVariables_.size();
@@ -69,60 +119,341 @@ float Service::getMultiplicity([[maybe_unused]] size_t col) {
 // ____________________________________________________________________________
 uint64_t Service::getSizeEstimateBeforeLimit() {
   // TODO: For now, we don't have any information about the result size at
-  // query planning time, so we just return `100'000`.
-  return 100'000;
+  // query planning time, so we just return `100'000`. For a bind join, we
+  // assume that the result is not larger than that of the sibling.
+  uint64_t estimate = 100'000;
+  if (siblingTree_) {
+    estimate = std::min(estimate, siblingTree_->getSizeEstimate());
+  }
+  return estimate;
 }
 
 // ____________________________________________________________________________
 size_t Service::getCostEstimate() {
   // TODO: For now, we don't have any information about the cost at query
-  // planning time, so we just return ten times the estimated size.
+  // planning time, so we just return ten times the estimated size. For a bind
+  // join, the cost of the sibling is not added, because the sibling is also
+  // a child of the join with this SERVICE (see
+  // `QueryPlanner::createJoinWithService`), which already accounts for it.
   return 10 * getSizeEstimateBeforeLimit();
 }
 
 // ____________________________________________________________________________
-ResultTable Service::computeResult() {
-  // Get the URL of the SPARQL endpoint.
+ad_utility::httpUtils::Url Service::getServiceUrl() const {
   std::string_view serviceIriString = parsedServiceClause_.serviceIri_.iri();
   AD_CONTRACT_CHECK(serviceIriString.starts_with("<") &&
                     serviceIriString.ends_with(">"));
   serviceIriString.remove_prefix(1);
   serviceIriString.remove_suffix(1);
-  ad_utility::httpUtils::Url serviceUrl{serviceIriString};
+  return ad_utility::httpUtils::Url{serviceIriString};
+}
 
-  // Construct the query to be sent to the SPARQL endpoint.
+// ____________________________________________________________________________
+std::string Service::getServiceQuery(std::string_view valuesClause) const {
   std::string variablesForSelectClause = absl::StrJoin(
       parsedServiceClause_.visibleVariables_, " ", Variable::AbslFormatter);
-  std::string serviceQuery = absl::StrCat(
-      parsedServiceClause_.prologue_, "\nSELECT ", variablesForSelectClause,
-      " WHERE ", parsedServiceClause_.graphPatternAsString_);
+  if (valuesClause.empty()) {
+    return absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
+                        variablesForSelectClause, " WHERE ",
+                        parsedServiceClause_.graphPatternAsString_);
+  }
+  return absl::StrCat(parsedServiceClause_.prologue_, "\nSELECT ",
+                      variablesForSelectClause, " WHERE {\n", valuesClause,
+                      "\n", parsedServiceClause_.graphPatternAsString_, "\n}");
+}
+
+namespace {
+// The canonical lexical form of the `xsd:double` `d` (e.g. `1.5E0`, `-1.0E-3`,
+// `INF`, or `NaN`), with the shortest mantissa that identifies `d`.
+std::string toCanonicalXsdDouble(double d) {
+  if (std::isnan(d)) {
+    return "NaN";
+  } else if (std::isinf(d)) {
+    return d > 0 ? "INF" : "-INF";
+  }
+  // The format of `std::to_chars` is e.g. `1.5e+00` or `1e-03`.
+  std::array<char, 32> buffer;
+  auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(),
+                                    d, std::chars_format::scientific);
+  AD_CORRECTNESS_CHECK(error == std::errc{});
+  std::string_view formatted{buffer.data(), end};
+  size_t exponentStart = formatted.find('e');
+  AD_CORRECTNESS_CHECK(exponentStart != std::string_view::npos);
+  std::string_view mantissa = formatted.substr(0, exponentStart);
+  int exponent = 0;
+  std::string_view exponentString = formatted.substr(exponentStart + 1);
+  if (exponentString.starts_with('+')) {
+    exponentString.remove_prefix(1);
+  }
+  std::from_chars(exponentString.data(),
+                  exponentString.data() + exponentString.size(), exponent);
+  return absl::StrCat(mantissa,
+                      mantissa.find('.') == std::string_view::npos ? ".0" : "",
+                      "E", exponent);
+}
+}  // namespace
+
+// ____________________________________________________________________________
+std::optional<std::vector<std::string>> Service::getBindJoinValuesClauses() {
+  if (!siblingTree_) {
+    return std::nullopt;
+  }
+  // The variables of the SERVICE that are bound by the sibling, and their
+  // columns in the result of the sibling.
+  std::vector<Variable> joinVariables;
+  std::vector<ColumnIndex> siblingColumns;
+  const auto& siblingColumnMap = siblingTree_->getVariableColumns();
+  for (const auto& variable : parsedServiceClause_.visibleVariables_) {
+    if (auto it = siblingColumnMap.find(variable);
+        it != siblingColumnMap.end()) {
+      joinVariables.push_back(variable);
+      siblingColumns.push_back(it->second.columnIndex_);
+    }
+  }
+  if (joinVariables.empty()) {
+    return std::nullopt;
+  }
+
+  // The distinct bindings of the join variables. Give up if there are too
+  // many of them.
+  const size_t maxRows =
+      RuntimeParameters().get<"service-bind-join-max-rows">();
+  std::shared_ptr<const ResultTable> siblingResult = siblingTree_->getResult();
+  const IdTable& siblingTable = siblingResult->idTable();
+  std::vector<std::vector<Id>> bindings;
+  ad_utility::HashSet<std::vector<Id>> distinctBindings;
+  std::vector<Id> binding(siblingColumns.size());
+  for (size_t row = 0; row < siblingTable.numRows(); ++row) {
+    for (size_t i = 0; i < siblingColumns.size(); ++i) {
+      binding[i] = siblingTable(row, siblingColumns[i]);
+    }
+    if (distinctBindings.insert(binding).second) {
+      if (distinctBindings.size() > maxRows) {
+        return std::nullopt;
+      }
+      bindings.push_back(binding);
+    }
+  }
+
+  // The SPARQL representation of an `Id`, or `std::nullopt` if it cannot be
+  // sent to the remote endpoint (for example, a blank node, which has a
+  // different meaning there).
+  ad_utility::HashMap<Id, std::optional<std::string>> representations;
+  auto toSparql = [this, &siblingResult](Id id) -> std::optional<std::string> {
+    auto fromWord = [](std::string_view word) -> std::optional<std::string> {
+      if (word.starts_with('<')) {
+        return std::string{word};
+      } else if (word.starts_with('"')) {
+        return RdfEscaping::validRDFLiteralFromNormalized(word);
+      }
+      return std::nullopt;
+    };
+    switch (id.getDatatype()) {
+      case Datatype::Undefined:
+        return "UNDEF";
+      case Datatype::VocabIndex: {
+        std::optional<std::string> word =
+            getIndex().idToOptionalString(id.getVocabIndex());
+        return word.has_value() ? fromWord(word.value()) : std::nullopt;
+      }
+      case Datatype::LocalVocabIndex:
+        return fromWord(
+            siblingResult->localVocab().getWord(id.getLocalVocabIndex()));
+      case Datatype::ShortString:
+        return fromWord(id.getShortString().toLiteral());
+      // The values that are folded into the `Id` have lost their original
+      // lexical form, so the canonical form of their datatype is sent.
+      case Datatype::Bool:
+        return id.getBool() ? "true" : "false";
+      case Datatype::Int:
+        // An integer without quotes has the datatype `xsd:integer`.
+        return std::to_string(id.getInt());
+      case Datatype::Double:
+        return absl::StrCat("\"", toCanonicalXsdDouble(id.getDouble()),
+                            "\"^^<", XSD_DOUBLE_TYPE, ">");
+      case Datatype::Date:
+      case Datatype::GeoPoint:
+      case Datatype::Decimal: {
+        auto [value, xsdType] =
+            ExportQueryExecutionTrees::idToStringAndTypeForEncodedValue(id)
+                .value();
+        return absl::StrCat("\"", value, "\"^^<", xsdType, ">");
+      }
+      default:
+        return std::nullopt;
+    }
+  };
+
+  // Split the bindings into batches.
+  const size_t batchSize = std::max(
+      size_t{1}, RuntimeParameters().get<"service-bind-join-batch-size">());
+  std::string variables =
+      absl::StrJoin(joinVariables, " ", Variable::AbslFormatter);
+  std::vector<std::string> valuesClauses;
+  std::string rows;
+  for (size_t i = 0; i < bindings.size(); ++i) {
+    absl::StrAppend(&rows, "(");
+    for (Id id : bindings[i]) {
+      auto it = representations.find(id);
+      if (it == representations.end()) {
+        it = representations.emplace(id, toSparql(id)).first;
+      }
+      if (!it->second.has_value()) {
+        return std::nullopt;
+      }
+      absl::StrAppend(&rows, " ", it->second.value());
+    }
+    absl::StrAppend(&rows, " )\n");
+    if ((i + 1) % batchSize == 0 || i + 1 == bindings.size()) {
+      valuesClauses.push_back(
+          absl::StrCat("VALUES ( ", variables, " ) {\n", rows, "}"));
+      rows.clear();
+    }
+  }
+  return valuesClauses;
+}
+
+// ____________________________________________________________________________
+ResultTable Service::computeResult() {
+  // The deadline for the remote requests.
+  std::chrono::steady_clock::time_point deadline = deadline_;
+  std::chrono::seconds timeout = RuntimeParameters().get<"service-timeout">();
+  if (timeout > std::chrono::seconds::zero()) {
+    deadline = std::min(deadline, std::chrono::steady_clock::now() + timeout);
+  }
+
+  IdTable idTable{getExecutionContext()->getAllocator()};
+  idTable.setNumColumns(getResultWidth());
+  LocalVocab localVocab{};
+
+  // Without a bind join (or if the result of the sibling is too large for
+  // one), send the SERVICE query as it is.
+  std::optional<std::vector<std::string>> valuesClauses =
+      getBindJoinValuesClauses();
+  if (!valuesClauses.has_value()) {
+    fetchResult(getServiceQuery(""), &idTable, &localVocab, deadline);
+    return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+  }
+  // If the result of the sibling is empty, so is the result of the join.
+  if (valuesClauses->empty()) {
+    return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+  }
+  LOG(INFO) << "Evaluating SERVICE as a bind join with "
+            << valuesClauses->size() << " VALUES batch(es)" << std::endl;
+
+  // Send the batches concurrently. Each worker has its own result and local
+  // vocabulary, which are merged afterwards.
+  const size_t numBatches = valuesClauses->size();
+  const size_t numThreads =
+      RuntimeParameters().get<"service-bind-join-num-threads">();
+  const size_t numWorkers =
+      std::min(numBatches, std::max(size_t{1}, numThreads));
+  std::atomic<size_t> nextBatch = 0;
+  auto processBatches = [&](IdTable& workerTable, LocalVocab& workerVocab) {
+    try {
+      for (size_t i = nextBatch++; i < numBatches; i = nextBatch++) {
+        checkCancellation();
+        fetchResult(getServiceQuery(valuesClauses->at(i)), &workerTable,
+                    &workerVocab, deadline);
+      }
+    } catch (...) {
+      // Stop the other workers as soon as possible.
+      nextBatch = numBatches;
+      throw;
+    }
+  };
+  std::vector<IdTable> workerTables;
+  std::vector<LocalVocab> workerVocabs(numWorkers);
+  for (size_t i = 0; i < numWorkers; ++i) {
+    workerTables.emplace_back(getResultWidth(),
+                              getExecutionContext()->getAllocator());
+  }
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < numWorkers; ++i) {
+    futures.push_back(std::async(std::launch::async, processBatches,
+                                 std::ref(workerTables[i]),
+                                 std::ref(workerVocabs[i])));
+  }
+  // The first worker is the current thread. The futures are waited for before
+  // an exception is propagated, because they refer to the local variables.
+  std::exception_ptr exception;
+  try {
+    processBatches(workerTables[0], workerVocabs[0]);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+
+  // Merge the results of the workers.
+  for (size_t i = 0; i < numWorkers; ++i) {
+    for (auto column : workerTables[i].getColumns()) {
+      for (Id& id : column) {
+        if (id.getDatatype() == Datatype::LocalVocabIndex) {
+          id = getIdOfWordNotInVocabulary(
+              workerVocabs[i].getWord(id.getLocalVocabIndex()), localVocab);
+        }
+      }
+    }
+    idTable.insertAtEnd(workerTables[i].begin(), workerTables[i].end());
+  }
+  LOG(INFO) << "Number of rows in result of SERVICE: " << idTable.size()
+            << std::endl;
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// ____________________________________________________________________________
+void Service::fetchResult(const std::string& serviceQuery, IdTable* idTable,
+                          LocalVocab* localVocab,
+                          std::chrono::steady_clock::time_point deadline) {
+  ad_utility::httpUtils::Url serviceUrl = getServiceUrl();
   LOG(INFO) << "Sending SERVICE query to remote endpoint "
             << "(protocol: " << serviceUrl.protocolAsString()
             << ", host: " << serviceUrl.host()
             << ", port: " << serviceUrl.port()
-            << ", target: " << serviceUrl.target() << ")" << std::endl
-            << serviceQuery << std::endl;
+            << ", target: " << serviceUrl.target() << ")" << std::endl;
+  LOG(DEBUG) << serviceQuery << std::endl;
 
   // Send the query to the remote SPARQL endpoint via a POST request and get the
-  // result as TSV.
-  //
-  // TODO: We should support a timeout here.
+  // result as TSV. The result is parsed while it is still being received.
   //
   // TODO: We ask for the result as TSV because that is a compact and
   // easy-to-parse format. It might not be the best choice regarding robustness
   // and portability though. In particular, we are not sure how deterministic
   // the TSV output is with respect to the precise encoding of literals.
-  std::istringstream tsvResult =
+  cppcoro::generator<std::string_view> tsvLines = splitIntoLines(
       getTsvFunction_(serviceUrl, boost::beast::http::verb::post, serviceQuery,
-                      "application/sparql-query", "text/tab-separated-values");
+                      "application/sparql-query", "text/tab-separated-values",
+                      deadline));
+
+  // Fill the result table using the `writeTsvResult` method below.
+  size_t resWidth = getResultWidth();
+  CALL_FIXED_SIZE(resWidth, &Service::writeTsvResult, this, std::move(tsvLines),
+                  idTable, localVocab);
+}
 
+// ____________________________________________________________________________
+template <size_t I>
+void Service::writeTsvResult(cppcoro::generator<std::string_view> tsvLines,
+                             IdTable* idTablePtr, LocalVocab* localVocab) {
   // The first line of the TSV result contains the variable names.
-  std::string tsvHeaderRow;
-  if (!std::getline(tsvResult, tsvHeaderRow)) {
+  auto it = tsvLines.begin();
+  if (it == tsvLines.end()) {
     throw std::runtime_error(absl::StrCat("Response from SPARQL endpoint ",
-                                          serviceUrl.host(), " is empty"));
+                                          getServiceUrl().host(), " is empty"));
   }
-  LOG(INFO) << "Header row of TSV result: " << tsvHeaderRow << std::endl;
+  std::string_view tsvHeaderRow = *it;
+  LOG(DEBUG) << "Header row of TSV result: " << tsvHeaderRow << std::endl;
 
   // Check that the variables in the header row agree with those requested by
   // the SERVICE query.
@@ -134,37 +465,21 @@ ResultTable Service::computeResult() {
         "\", but expected \"", expectedHeaderRow, "\""));
   }
 
-  // Set basic properties of the result table.
-  IdTable idTable{getExecutionContext()->getAllocator()};
-  idTable.setNumColumns(getResultWidth());
-  LocalVocab localVocab{};
-  // Fill the result table using the `writeTsvResult` method below.
-  size_t resWidth = getResultWidth();
-  CALL_FIXED_SIZE(resWidth, &Service::writeTsvResult, this,
-                  std::move(tsvResult), &idTable, &localVocab);
-
-  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
-}
-
-// ____________________________________________________________________________
-template <size_t I>
-void Service::writeTsvResult(std::istringstream tsvResult, IdTable* idTablePtr,
-                             LocalVocab* localVocab) {
   IdTableStatic<I> idTable = std::move(*idTablePtr).toStatic<I>();
-  size_t rowIdx = 0;
+  size_t rowIdx = idTable.size();
+  size_t numRows = 0;
   std::vector<size_t> numLocalVocabPerColumn(idTable.numColumns());
-  std::string line;
-  std::string lastLine;
   const size_t numVariables = parsedServiceClause_.visibleVariables_.size();
-  while (lastLine = std::move(line), std::getline(tsvResult, line)) {
+  for (++it; it != tsvLines.end(); ++it) {
+    std::string_view line = *it;
     // Print first line.
-    if (rowIdx == 0) {
-      LOG(INFO) << "First non-header row of TSV result: " << line << std::endl;
+    if (numRows == 0) {
+      LOG(DEBUG) << "First non-header row of TSV result: " << line << std::endl;
     }
     std::vector<std::string_view> valueStrings = absl::StrSplit(line, "\t");
     if (valueStrings.size() != numVariables) {
       throw std::runtime_error(absl::StrCat(
-          "Number of columns in ", rowIdx + 1, " of TSV result is ",
+          "Number of columns in ", numRows + 1, " of TSV result is ",
           valueStrings.size(), "but number of variables in header row is ",
           numVariables));
     }
@@ -179,13 +494,11 @@ void Service::writeTsvResult(std::istringstream tsvResult, IdTable* idTablePtr,
       }
     }
     rowIdx++;
-  }
-  if (idTable.size() > 1) {
-    LOG(INFO) << "Last non-header row of TSV result: " << lastLine << std::endl;
+    numRows++;
   }
   AD_CORRECTNESS_CHECK(rowIdx == idTable.size());
-  LOG(INFO) << "Number of rows in result: " << idTable.size() << std::endl;
-  LOG(INFO) << "Number of entries in local vocabulary per column: "
-            << absl::StrJoin(numLocalVocabPerColumn, ", ") << std::endl;
+  LOG(INFO) << "Number of rows in result: " << numRows << std::endl;
+  LOG(DEBUG) << "Number of entries in local vocabulary per column: "
+             << absl::StrJoin(numLocalVocabPerColumn, ", ") << std::endl;
   *idTablePtr = std::move(idTable).toDynamic();
 }
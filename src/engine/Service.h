@@ -4,16 +4,26 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 
 #include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
 #include "engine/Values.h"
 #include "parser/ParsedQuery.h"
+#include "util/Generator.h"
 #include "util/http/HttpClient.h"
 
 // The SERVICE operation. Sends a query to the remote endpoint specified by the
-// service IRI, gets the result as TSV, parses it, and writes it into a result
-// table.
+// service IRI, gets the result as TSV, parses it (while it is still being
+// received), and writes it into a result table.
+//
+// If the SERVICE has a "sibling tree" (the operation it is joined with, see
+// `createCopyWithSiblingTree`), and the result of the sibling is small, then
+// the distinct bindings of the join variables are sent to the remote endpoint
+// as VALUES clauses (bind join), so that only the matching part of the remote
+// result is transferred. The bindings are split into batches that are sent
+// concurrently. The join itself is still done by the `Join` operation.
 //
 // TODO: The current implementation works, but is preliminary in several
 // respects:
@@ -21,21 +31,21 @@
 // 1. Reading the result as TSV has potential problems (see comment in
 // `computeResult` for details).
 //
-// 2. There should be a timeout.
-//
-// 3. A variable in place of the IRI is not yet supported (see comment in
+// 2. A variable in place of the IRI is not yet supported (see comment in
 // `computeResult` for details).
 //
-// 4. The SERVICE is currently executed *after* the query planning. The
+// 3. The SERVICE is currently executed *after* the query planning. The
 // estimates of the result size, cost, and multiplicities are therefore dummy
 // values.
 //
 class Service : public Operation {
  public:
-  // The type of the function used to obtain the results, see below.
-  using GetTsvFunction = std::function<std::istringstream(
-      ad_utility::httpUtils::Url, const boost::beast::http::verb&,
-      std::string_view, std::string_view, std::string_view)>;
+  // The type of the function used to obtain the results, see below. It gets
+  // the URL, the method, the POST data, the content-type and accept headers,
+  // and the deadline of the request, and yields the TSV result in chunks.
+  using GetTsvFunction = std::function<cppcoro::generator<std::string>(
+      ad_utility::httpUtils::Url, boost::beast::http::verb, std::string,
+      std::string, std::string, std::chrono::steady_clock::time_point)>;
 
  private:
   // The parsed SERVICE clause.
@@ -44,6 +54,10 @@ class Service : public Operation {
   // The function used to obtain the result from the remote endpoint.
   GetTsvFunction getTsvFunction_;
 
+  // The operation that this SERVICE is joined with, if the SERVICE is
+  // evaluated as a bind join (see above), else `nullptr`.
+  std::shared_ptr<QueryExecutionTree> siblingTree_;
+
  public:
   // Construct from parsed Service clause.
   //
@@ -52,7 +66,16 @@ class Service : public Operation {
   // but in our tests (`ServiceTest`) we use a mock function that does not
   // require a running `HttpServer`.
   Service(QueryExecutionContext* qec, parsedQuery::Service parsedServiceClause,
-          GetTsvFunction getTsvFunction = sendHttpOrHttpsRequest);
+          GetTsvFunction getTsvFunction = sendHttpOrHttpsRequestStreaming,
+          std::shared_ptr<QueryExecutionTree> siblingTree = nullptr);
+
+  // Return a copy of this SERVICE that is evaluated as a bind join with the
+  // `siblingTree`. The result of the copy has to be joined with the result of
+  // the `siblingTree` afterwards.
+  std::shared_ptr<Service> createCopyWithSiblingTree(
+      std::shared_ptr<QueryExecutionTree> siblingTree) const;
+
+  bool hasSiblingTree() const { return siblingTree_ != nullptr; }
 
   // Methods inherited from base class `Operation`.
   std::string getDescriptor() const override;
@@ -73,8 +96,14 @@ class Service : public Operation {
   // We know nothing about the result at query planning time.
   bool knownEmptyResult() override { return false; }
 
-  // A SERVICE clause has no children.
-  vector<QueryExecutionTree*> getChildren() override { return {}; }
+  // A SERVICE clause has no children, except for the sibling tree of a bind
+  // join.
+  vector<QueryExecutionTree*> getChildren() override {
+    if (siblingTree_) {
+      return {siblingTree_.get()};
+    }
+    return {};
+  }
 
  private:
   // The string returned by this function is used as cache key.
@@ -83,14 +112,32 @@ class Service : public Operation {
   // Compute the result using `getTsvFunction_`.
   ResultTable computeResult() override;
 
-  // Write the given TSV result to the given result object. The `I` is the width
-  // of the result table.
+  // Get the URL of the remote endpoint from the SERVICE IRI.
+  ad_utility::httpUtils::Url getServiceUrl() const;
+
+  // The query that is sent to the remote endpoint. The `valuesClause` (which
+  // may be empty) is prepended to the graph pattern of the SERVICE.
+  std::string getServiceQuery(std::string_view valuesClause) const;
+
+  // If this SERVICE has a sibling tree and the result of the sibling is small
+  // enough, return the VALUES clauses for the bind join (one per batch).
+  // Otherwise, return `std::nullopt`.
+  std::optional<std::vector<std::string>> getBindJoinValuesClauses();
+
+  // Send the `serviceQuery` to the remote endpoint and append the rows of its
+  // result to the `idTable`. Throw if the result is not complete at the
+  // `deadline`.
+  void fetchResult(const std::string& serviceQuery, IdTable* idTable,
+                   LocalVocab* localVocab,
+                   std::chrono::steady_clock::time_point deadline);
+
+  // Append the rows of the given TSV result (the lines of which are yielded by
+  // `tsvLines`, starting with the header row) to the given result object. The
+  // `I` is the width of the result table.
   //
   // NOTE: This is similar to `Values::writeValues`, except that we have to
-  // parse TSV here and not a VALUES clause. Note that the only reason that
-  // `tsvResult` is not `const` here is because the method iterates over the
-  // `std::istringstream` and thus changes it.
+  // parse TSV here and not a VALUES clause.
   template <size_t I>
-  void writeTsvResult(std::istringstream tsvResult, IdTable* idTable,
-                      LocalVocab* localVocab);
+  void writeTsvResult(cppcoro::generator<std::string_view> tsvLines,
+                      IdTable* idTable, LocalVocab* localVocab);
 };
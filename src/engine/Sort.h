@@ -46,6 +46,12 @@ class Sort : public Operation {
     return subtree_->getMultiplicity(col);
   }
 
+  // Sorting doesn't change the values of the columns.
+  std::shared_ptr<const ColumnStatistics> getColumnStatistics(
+      size_t col) const override {
+    return subtree_->getRootOperation()->getColumnStatistics(col);
+  }
+
   std::shared_ptr<QueryExecutionTree> getSubtree() const { return subtree_; }
 
   virtual size_t getCostEstimate() override {
@@ -73,6 +79,12 @@ class Sort : public Operation {
  private:
   virtual ResultTable computeResult() override;
 
+  bool pushDownSemiJoinFilterImpl(const Variable& variable,
+                                  const SemiJoinFilter& values) override {
+    return subtree_->getRootOperation()->pushDownSemiJoinFilter(variable,
+                                                                values);
+  }
+
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap()
       const override {
     return subtree_->getVariableColumns();
@@ -105,7 +105,8 @@ ResultTable TextOperationWithoutFilter::computeResult() {
 // _____________________________________________________________________________
 void TextOperationWithoutFilter::computeResultNoVar(IdTable* idTable) const {
   idTable->setNumColumns(2 + getNofPrefixedTerms());
-  getExecutionContext()->getIndex().getContextListForWords(_words, idTable);
+  getExecutionContext()->getIndex().getContextListForWords(_words, _textLimit,
+                                                           idTable);
 }
 
 // _____________________________________________________________________________
@@ -0,0 +1,492 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include "engine/WorstCaseOptimalJoin.h"
+
+#include <absl/strings/str_join.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <sstream>
+
+#include "engine/IndexScan.h"
+#include "index/IndexImpl.h"
+#include "parser/ParsedQuery.h"
+#include "util/JoinAlgorithms/LeapfrogTriejoin.h"
+
+namespace {
+// A trie iterator (see `ad_utility::TrieIterator`) for the col1 (first level)
+// and col2 (second level) of a relation of a permutation. The blocks of the
+// relation are only read when one of their rows is needed, and each block is
+// read at most once. A seek on the first level finds the next block that can
+// contain the key via the `lastTriple_` of the blocks, so the blocks in
+// between are skipped without being read.
+class RelationTrieIterator {
+  const CompressedRelationReader* reader_;
+  CompressedRelationMetadata relation_;
+  std::span<const CompressedBlockMetadata> blocks_;
+  // The blocks that have been read (col1 and col2) and not yet evicted, and
+  // their indices.
+  std::vector<std::optional<IdTable>> readBlocks_;
+  std::vector<size_t> indicesOfReadBlocks_;
+
+  // The current position on the first level is the row `row_` of the block
+  // `blockIndex_`, which is the first row with the current key in that block.
+  size_t blockIndex_ = 0;
+  size_t row_ = 0;
+  std::span<const Id> col1_;
+  bool atEnd_ = false;
+
+  // The values of the second level for the current key of the first level,
+  // and the current position in them. If they are stored in more than one
+  // block, they are copied to the `col2Buffer_`.
+  std::span<const Id> col2_;
+  std::vector<Id> col2Buffer_;
+  size_t col2Position_ = 0;
+
+  // -1 above the root, 0 on the first level, 1 on the second level.
+  int depth_ = -1;
+
+  size_t numRowsRead_ = 0;
+  size_t numBlocksRead_ = 0;
+
+ public:
+  RelationTrieIterator(const CompressedRelationReader& reader,
+                       const CompressedRelationReader::MetadataAndBlocks&
+                           metadataAndBlocks)
+      : reader_{&reader},
+        relation_{metadataAndBlocks.relationMetadata_},
+        blocks_{metadataAndBlocks.blockMetadata_},
+        readBlocks_(blocks_.size()) {}
+
+  // Note: The `readBlocks_` are referenced by the spans, so the iterator must
+  // not be copied, but moving is fine because the blocks are not moved.
+  RelationTrieIterator(const RelationTrieIterator&) = delete;
+  RelationTrieIterator(RelationTrieIterator&&) = default;
+
+  size_t numRowsRead() const { return numRowsRead_; }
+  size_t numBlocksRead() const { return numBlocksRead_; }
+  size_t numBlocks() const { return blocks_.size(); }
+
+  void open() {
+    ++depth_;
+    AD_CORRECTNESS_CHECK(depth_ == 0 || depth_ == 1);
+    if (depth_ == 0) {
+      atEnd_ = blocks_.empty();
+      if (!atEnd_) {
+        setBlock(0);
+        skipToNonEmptyBlock();
+      }
+    } else {
+      AD_CORRECTNESS_CHECK(!atEnd_);
+      openSecondLevel();
+    }
+  }
+
+  void up() {
+    AD_CORRECTNESS_CHECK(depth_ >= 0);
+    --depth_;
+  }
+
+  bool atEnd() const {
+    return depth_ == 0 ? atEnd_ : col2Position_ == col2_.size();
+  }
+
+  Id key() const {
+    return depth_ == 0 ? col1_[row_] : col2_[col2Position_];
+  }
+
+  void next() {
+    if (depth_ == 1) {
+      ++col2Position_;
+      return;
+    }
+    // Skip all the rows with the current key, which may continue in the next
+    // blocks.
+    Id current = key();
+    row_ = std::ranges::upper_bound(col1_.subspan(row_), current) -
+           col1_.begin();
+    while (row_ == col1_.size()) {
+      if (blockIndex_ + 1 == blocks_.size()) {
+        atEnd_ = true;
+        return;
+      }
+      setBlock(blockIndex_ + 1);
+      row_ = std::ranges::upper_bound(col1_, current) - col1_.begin();
+    }
+  }
+
+  void seek(Id target) {
+    if (depth_ == 1) {
+      col2Position_ =
+          std::ranges::lower_bound(col2_.subspan(col2Position_), target) -
+          col2_.begin();
+      return;
+    }
+    // Skip the blocks that only contain smaller keys, using the metadata.
+    if (lastTripleIsSmaller(blocks_[blockIndex_], target)) {
+      auto it = std::ranges::partition_point(
+          blocks_.subspan(blockIndex_ + 1),
+          [this, target](const CompressedBlockMetadata& block) {
+            return lastTripleIsSmaller(block, target);
+          });
+      if (it == blocks_.end()) {
+        atEnd_ = true;
+        return;
+      }
+      setBlock(it - blocks_.begin());
+    }
+    row_ = std::ranges::lower_bound(col1_.subspan(row_), target) -
+           col1_.begin();
+    skipToNonEmptyBlock();
+  }
+
+ private:
+  // Return true iff all the rows of the relation in the `block` have a col1
+  // that is smaller than the `target`. The last triple of a block can belong
+  // to a later relation if the block contains several relations, so the col0
+  // has to be compared as well.
+  bool lastTripleIsSmaller(const CompressedBlockMetadata& block,
+                           Id target) const {
+    const auto& last = block.lastTriple_;
+    return std::tie(last.col0Id_, last.col1Id_) <
+           std::tie(relation_.col0Id_, target);
+  }
+
+  // Make the block with the given index the current block and read it if
+  // this hasn't happened yet.
+  void setBlock(size_t blockIndex) {
+    blockIndex_ = blockIndex;
+    row_ = 0;
+    col1_ = readBlock(blockIndex).getColumn(0);
+    evictPassedBlocks();
+  }
+
+  const IdTable& readBlock(size_t blockIndex) {
+    auto& block = readBlocks_.at(blockIndex);
+    if (!block.has_value()) {
+      block = reader_->readBlockOfRelation(relation_, blocks_[blockIndex]);
+      indicesOfReadBlocks_.push_back(blockIndex);
+      ++numBlocksRead_;
+      numRowsRead_ += block->numRows();
+    }
+    return block.value();
+  }
+
+  // Free the blocks before the current block, which are only needed again
+  // when the iterator is opened again. The first block is kept, because each
+  // `open` starts with it.
+  void evictPassedBlocks() {
+    std::erase_if(indicesOfReadBlocks_, [this](size_t blockIndex) {
+      if (blockIndex == 0 || blockIndex >= blockIndex_) {
+        return false;
+      }
+      readBlocks_[blockIndex].reset();
+      return true;
+    });
+  }
+
+  // If the current row is behind the end of the current block, go to the
+  // first row of the next block (repeatedly), or to the end.
+  void skipToNonEmptyBlock() {
+    while (row_ == col1_.size()) {
+      if (blockIndex_ + 1 == blocks_.size()) {
+        atEnd_ = true;
+        return;
+      }
+      setBlock(blockIndex_ + 1);
+    }
+  }
+
+  // Set the `col2_` to the col2 of all the rows with the current key of the
+  // first level.
+  void openSecondLevel() {
+    Id current = key();
+    col2Position_ = 0;
+    size_t end = std::ranges::upper_bound(col1_.subspan(row_), current) -
+                 col1_.begin();
+    std::span<const Id> col2 =
+        readBlock(blockIndex_).getColumn(1).subspan(row_, end - row_);
+    auto continuesInBlock = [this, current](size_t blockIndex) {
+      if (blockIndex >= blocks_.size()) {
+        return false;
+      }
+      const auto& first = blocks_[blockIndex].firstTriple_;
+      return std::tie(first.col0Id_, first.col1Id_) ==
+             std::tie(relation_.col0Id_, current);
+    };
+    if (end < col1_.size() || !continuesInBlock(blockIndex_ + 1)) {
+      col2_ = col2;
+      return;
+    }
+    // The rows with the current key continue in the next block(s).
+    col2Buffer_.assign(col2.begin(), col2.end());
+    for (size_t i = blockIndex_ + 1; continuesInBlock(i); ++i) {
+      const IdTable& block = readBlock(i);
+      auto col1 = block.getColumn(0);
+      auto numRows = std::ranges::upper_bound(col1, current) - col1.begin();
+      auto blockCol2 = block.getColumn(1).subspan(0, numRows);
+      col2Buffer_.insert(col2Buffer_.end(), blockCol2.begin(),
+                         blockCol2.end());
+    }
+    col2_ = col2Buffer_;
+  }
+};
+static_assert(ad_utility::TrieIterator<RelationTrieIterator>);
+
+// Choose the order in which the variables of the `triples` are bound. The
+// first variable is the one that occurs in the most triples, and each of the
+// following variables is the one that occurs in the most triples among those
+// that share a triple with one of the previous variables, so that the
+// iterators on the second level are restricted as early as possible. Ties are
+// broken by the order of the first occurrence.
+std::vector<Variable> computeVariableOrder(
+    const std::vector<SparqlTriple>& triples) {
+  std::vector<Variable> variables;
+  ad_utility::HashMap<Variable, size_t> numOccurrences;
+  for (const auto& triple : triples) {
+    for (const auto* component : {&triple._s, &triple._o}) {
+      const auto& variable = component->getVariable();
+      if (numOccurrences[variable]++ == 0) {
+        variables.push_back(variable);
+      }
+    }
+  }
+  std::vector<Variable> order;
+  ad_utility::HashSet<Variable> isChosen;
+  auto isAdjacentToChosen = [&](const Variable& variable) {
+    return std::ranges::any_of(triples, [&](const SparqlTriple& triple) {
+      const auto& s = triple._s.getVariable();
+      const auto& o = triple._o.getVariable();
+      return (s == variable && isChosen.contains(o)) ||
+             (o == variable && isChosen.contains(s));
+    });
+  };
+  while (order.size() < variables.size()) {
+    const Variable* best = nullptr;
+    bool bestIsAdjacent = false;
+    for (const auto& variable : variables) {
+      if (isChosen.contains(variable)) {
+        continue;
+      }
+      bool isAdjacent = isAdjacentToChosen(variable);
+      if (best == nullptr || (isAdjacent && !bestIsAdjacent) ||
+          (isAdjacent == bestIsAdjacent &&
+           numOccurrences[variable] > numOccurrences[*best])) {
+        best = &variable;
+        bestIsAdjacent = isAdjacent;
+      }
+    }
+    order.push_back(*best);
+    isChosen.insert(*best);
+  }
+  return order;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+WorstCaseOptimalJoin::WorstCaseOptimalJoin(
+    QueryExecutionContext* qec, const std::vector<SparqlTriple>& triples)
+    : Operation{qec} {
+  AD_CONTRACT_CHECK(!triples.empty());
+  AD_CONTRACT_CHECK(std::ranges::all_of(triples, &isSupportedTriple));
+  variables_ = computeVariableOrder(triples);
+  ad_utility::HashMap<Variable, size_t> variableIndex;
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    variableIndex[variables_[i]] = i;
+  }
+  for (const auto& triple : triples) {
+    size_t s = variableIndex.at(triple._s.getVariable());
+    size_t o = variableIndex.at(triple._o.getVariable());
+    // The first column of the scan must be the variable that is bound first.
+    auto permutation =
+        s < o ? Permutation::Enum::PSO : Permutation::Enum::POS;
+    children_.push_back(
+        ad_utility::makeExecutionTree<IndexScan>(qec, permutation, triple));
+    childVariables_.push_back({std::min(s, o), std::max(s, o)});
+  }
+}
+
+// _____________________________________________________________________________
+bool WorstCaseOptimalJoin::isSupportedTriple(const SparqlTriple& triple) {
+  return triple._p._operation == PropertyPath::Operation::IRI &&
+         !isVariable(triple._p) &&
+         !triple._p._iri.starts_with(INTERNAL_ENTITIES_URI_PREFIX) &&
+         triple._s.isVariable() && triple._o.isVariable() &&
+         triple._s != triple._o && triple._additionalScanColumns.empty();
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> WorstCaseOptimalJoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  std::ranges::transform(children_, std::back_inserter(result),
+                         [](auto& child) { return child.get(); });
+  return result;
+}
+
+// _____________________________________________________________________________
+string WorstCaseOptimalJoin::getCacheKeyImpl() const {
+  std::ostringstream os;
+  os << "WORST CASE OPTIMAL JOIN of " << variables_.size() << " variables";
+  for (size_t i = 0; i < children_.size(); ++i) {
+    os << "\n"
+       << children_[i]->getCacheKey() << " columns: ["
+       << childVariables_[i][0] << " " << childVariables_[i][1] << "]";
+  }
+  return std::move(os).str();
+}
+
+// _____________________________________________________________________________
+string WorstCaseOptimalJoin::getDescriptor() const {
+  return "WorstCaseOptimalJoin on " +
+         absl::StrJoin(variables_, " ",
+                       [](std::string* out, const Variable& variable) {
+                         out->append(variable.name());
+                       });
+}
+
+// _____________________________________________________________________________
+size_t WorstCaseOptimalJoin::getCostEstimate() {
+  // Each of the scans is read at most once, and the intermediate results are
+  // never larger than the result.
+  size_t cost = getSizeEstimateBeforeLimit();
+  for (auto& child : children_) {
+    cost += child->getCostEstimate();
+  }
+  return cost;
+}
+
+// _____________________________________________________________________________
+uint64_t WorstCaseOptimalJoin::getSizeEstimateBeforeLimit() {
+  if (!multiplicitiesComputed_) {
+    computeSizeEstimateAndMultiplicities();
+  }
+  return sizeEstimate_;
+}
+
+// _____________________________________________________________________________
+float WorstCaseOptimalJoin::getMultiplicity(size_t col) {
+  if (!multiplicitiesComputed_) {
+    computeSizeEstimateAndMultiplicities();
+  }
+  return multiplicities_.at(col);
+}
+
+// _____________________________________________________________________________
+void WorstCaseOptimalJoin::computeSizeEstimateAndMultiplicities() {
+  // The size of the Cartesian product of the children is divided, for each
+  // variable that occurs in `k` children, by the `(k-1)`-th power of the
+  // number of its distinct values, which is estimated as the largest number of
+  // distinct values in one of these children. The number of distinct values in
+  // the result is the smallest number of distinct values in these children.
+  size_t numVariables = variables_.size();
+  std::vector<double> maxDistinct(numVariables, 1.0);
+  std::vector<double> minDistinct(numVariables,
+                                  std::numeric_limits<double>::max());
+  std::vector<size_t> numOccurrences(numVariables, 0);
+  double size = 1.0;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    auto& child = *children_[i];
+    double childSize = static_cast<double>(child.getSizeEstimate());
+    size *= childSize;
+    for (size_t col = 0; col < 2; ++col) {
+      double numDistinct =
+          std::max(1.0, childSize / child.getMultiplicity(col));
+      size_t variable = childVariables_[i][col];
+      maxDistinct[variable] = std::max(maxDistinct[variable], numDistinct);
+      minDistinct[variable] = std::min(minDistinct[variable], numDistinct);
+      ++numOccurrences[variable];
+    }
+  }
+  for (size_t i = 0; i < numVariables; ++i) {
+    size /= std::pow(maxDistinct[i], static_cast<double>(numOccurrences[i]) -
+                                         1.0);
+  }
+  // Don't estimate 0, because parent operations would then assume that the
+  // result is empty (see `MultiColumnJoin`).
+  sizeEstimate_ = static_cast<size_t>(
+                      std::min(size, static_cast<double>(uint64_t{1} << 62))) +
+                  1;
+  multiplicities_.clear();
+  for (size_t i = 0; i < numVariables; ++i) {
+    multiplicities_.push_back(static_cast<float>(
+        std::max(1.0, static_cast<double>(sizeEstimate_) / minDistinct[i])));
+  }
+  multiplicitiesComputed_ = true;
+}
+
+// _____________________________________________________________________________
+bool WorstCaseOptimalJoin::knownEmptyResult() {
+  return std::ranges::any_of(
+      children_, [](auto& child) { return child->knownEmptyResult(); });
+}
+
+// _____________________________________________________________________________
+vector<ColumnIndex> WorstCaseOptimalJoin::resultSortedOn() const {
+  vector<ColumnIndex> result(variables_.size());
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap WorstCaseOptimalJoin::computeVariableToColumnMap() const {
+  VariableToColumnMap result;
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    result[variables_[i]] = makeAlwaysDefinedColumn(i);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+ResultTable WorstCaseOptimalJoin::computeResult() {
+  IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
+  auto getScan = [](auto& child) -> IndexScan& {
+    return dynamic_cast<IndexScan&>(*child->getRootOperation());
+  };
+  std::vector<RelationTrieIterator> tries;
+  tries.reserve(children_.size());
+  for (auto& child : children_) {
+    const IndexScan& scan = getScan(child);
+    auto metadataAndBlocks = scan.getMetadataAndBlocks();
+    if (!metadataAndBlocks.has_value()) {
+      // One of the predicates doesn't occur in the index.
+      for (auto& c : children_) {
+        c->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+      }
+      return {std::move(result), resultSortedOn(), LocalVocab{}};
+    }
+    tries.emplace_back(
+        getIndex().getImpl().getPermutation(scan.permutation()).reader(),
+        metadataAndBlocks.value());
+  }
+
+  std::vector<std::vector<size_t>> triesPerVariable(variables_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    for (size_t variable : childVariables_[i]) {
+      triesPerVariable[variable].push_back(i);
+    }
+  }
+  ad_utility::leapfrogTriejoin(
+      std::span{tries}, triesPerVariable,
+      [&result](std::span<const Id> row) { result.push_back(row); },
+      [this]() { checkCancellation(); });
+
+  // The scans were only read partially, similar to the lazy scans of a
+  // `Join` of two index scans.
+  size_t numBlocksRead = 0;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    IndexScan& scan = getScan(children_[i]);
+    scan.updateRuntimeInformationWhenOptimizedOut(
+        RuntimeInformation::Status::lazilyMaterialized);
+    auto& runtimeInfo = scan.runtimeInfo();
+    runtimeInfo.numRows_ = tries[i].numRowsRead();
+    runtimeInfo.addDetail("num-blocks-read", tries[i].numBlocksRead());
+    runtimeInfo.addDetail("num-blocks-all", tries[i].numBlocks());
+    numBlocksRead += tries[i].numBlocksRead();
+  }
+  runtimeInfo().addDetail("num-blocks-read", numBlocksRead);
+  return {std::move(result), resultSortedOn(), LocalVocab{}};
+}
@@ -0,0 +1,88 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+class SparqlTriple;
+
+// The join of several triples that each have a fixed predicate and two
+// different variables as subject and object, which is computed in one step by
+// the Leapfrog Triejoin (see `util/JoinAlgorithms/LeapfrogTriejoin.h`). The
+// runtime of this algorithm is bounded by the largest possible size of the
+// result, while the intermediate results of a sequence of binary joins can be
+// much larger than the result for cyclic patterns (for example triangles).
+//
+// The variables are bound one after the other in a fixed order. Each triple is
+// an `IndexScan` of the PSO or the POS permutation (such that its first
+// column is the variable that is bound first) and is used as a trie with two
+// levels. The blocks of the scans are only read when they are needed: A seek
+// on the first level skips all the blocks the last triple of which (see
+// `CompressedBlockMetadata`) is smaller than the key, without reading them.
+class WorstCaseOptimalJoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+ private:
+  // The variables in the order in which they are bound, which is also the
+  // order of the columns of the result.
+  std::vector<Variable> variables_;
+  // One `IndexScan` for each triple.
+  Children children_;
+  // The indices (in `variables_`) of the variables of the first and the second
+  // column of each of the `children_`. The first is always smaller.
+  std::vector<std::array<size_t, 2>> childVariables_;
+
+  std::vector<float> multiplicities_;
+  size_t sizeEstimate_ = 0;
+  bool multiplicitiesComputed_ = false;
+
+ public:
+  // Create the join of the `triples`, each of which must be supported (see
+  // `isSupportedTriple`). The triples must be connected via their variables.
+  WorstCaseOptimalJoin(QueryExecutionContext* qec,
+                       const std::vector<SparqlTriple>& triples);
+
+  // Return true iff the `triple` has a fixed IRI as predicate (which is not
+  // one of the special predicates of QLever) and two different variables as
+  // subject and object.
+  static bool isSupportedTriple(const SparqlTriple& triple);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+
+  string getDescriptor() const override;
+
+  size_t getResultWidth() const override { return variables_.size(); }
+
+  size_t getCostEstimate() override;
+
+  float getMultiplicity(size_t col) override;
+
+  bool knownEmptyResult() override;
+
+  // The variables in the order of the result columns.
+  const std::vector<Variable>& variables() const { return variables_; }
+
+ private:
+  string getCacheKeyImpl() const override;
+
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  // The result is sorted by all columns, because the Leapfrog Triejoin
+  // produces the tuples in lexicographical order.
+  vector<ColumnIndex> resultSortedOn() const override;
+
+  ResultTable computeResult() override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Estimate the size of the result and the multiplicities of its columns
+  // under the assumption that the values of the variables are independent.
+  void computeSizeEstimateAndMultiplicities();
+};
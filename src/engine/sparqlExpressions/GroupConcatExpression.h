@@ -67,6 +67,9 @@ class GroupConcatExpression : public SparqlExpression {
 
   bool isDistinct() const override { return distinct_; }
 
+  // The separator between the concatenated values.
+  const std::string& separator() const { return separator_; }
+
   [[nodiscard]] string getCacheKey(
       const VariableToColumnMap& varColMap) const override {
     return absl::StrCat("[ GROUP_CONCAT", distinct_ ? " DISTINCT " : "",
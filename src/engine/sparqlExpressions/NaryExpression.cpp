@@ -4,20 +4,23 @@
 
 #include "engine/sparqlExpressions/NaryExpression.h"
 
+#include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "util/GeoSparqlHelpers.h"
 
 namespace sparqlExpression {
 namespace detail {
+// The points that were folded into the `ValueId`s are used directly, without
+// parsing the WKT strings.
 NARY_EXPRESSION(LongitudeExpression, 1,
                 FV<NumericIdWrapper<decltype(ad_utility::wktLongitude), true>,
-                   LiteralFromIdGetter>);
+                   GeoPointValueGetter>);
 NARY_EXPRESSION(LatitudeExpression, 1,
                 FV<NumericIdWrapper<decltype(ad_utility::wktLatitude), true>,
-                   LiteralFromIdGetter>);
+                   GeoPointValueGetter>);
 NARY_EXPRESSION(DistExpression, 2,
                 FV<NumericIdWrapper<decltype(ad_utility::wktDist), true>,
-                   LiteralFromIdGetter>);
+                   GeoPointValueGetter>);
 
 }  // namespace detail
 
@@ -34,4 +37,68 @@ SparqlExpression::Ptr makeLongitudeExpression(SparqlExpression::Ptr child) {
   return std::make_unique<LongitudeExpression>(std::move(child));
 }
 
+// _____________________________________________________________________________
+std::optional<SparqlExpression::GeoBoundingBoxOfVariable>
+getGeoBoundingBoxOfComparison(const SparqlExpression& expression,
+                              valueIdComparators::Comparison comparison,
+                              double value) {
+  using enum valueIdComparators::Comparison;
+  if (std::isnan(value) || comparison == NE) {
+    return std::nullopt;
+  }
+  auto children = expression.children();
+  auto getVariable = [](const SparqlExpression::Ptr& child) {
+    return child->getVariableOrNullopt();
+  };
+  // The box of the values of a coordinate for which `coordinate comparison
+  // value` is true.
+  auto getRange = [comparison, value](double min, double max) {
+    switch (comparison) {
+      case LT:
+      case LE:
+        return std::pair{min, value};
+      case GT:
+      case GE:
+        return std::pair{value, max};
+      default:
+        return std::pair{value, value};
+    }
+  };
+  GeoBoundingBox box;
+  std::optional<Variable> variable;
+  if (dynamic_cast<const LatitudeExpression*>(&expression)) {
+    variable = getVariable(children[0]);
+    std::tie(box.minLat_, box.maxLat_) = getRange(-90.0, 90.0);
+  } else if (dynamic_cast<const LongitudeExpression*>(&expression)) {
+    variable = getVariable(children[0]);
+    std::tie(box.minLng_, box.maxLng_) = getRange(-180.0, 180.0);
+  } else if (dynamic_cast<const DistExpression*>(&expression)) {
+    // Only an upper bound for the distance restricts the points.
+    if (comparison == GT || comparison == GE) {
+      return std::nullopt;
+    }
+    auto getPoint = [](const SparqlExpression::Ptr& child) {
+      auto idPtr = dynamic_cast<const IdExpression*>(child.get());
+      return idPtr && idPtr->value().getDatatype() == Datatype::GeoPoint
+                 ? std::optional{idPtr->value().getGeoPoint()}
+                 : std::nullopt;
+    };
+    // The distance is symmetric.
+    for (size_t i = 0; i < 2 && !variable.has_value(); ++i) {
+      auto point = getPoint(children[1 - i]);
+      variable = getVariable(children[i]);
+      if (variable.has_value() && point.has_value()) {
+        box = GeoBoundingBox::aroundPoint(point.value(), value);
+      } else {
+        variable.reset();
+      }
+    }
+  }
+  if (!variable.has_value()) {
+    return std::nullopt;
+  }
+  return SparqlExpression::GeoBoundingBoxOfVariable{std::move(variable.value()),
+                                                    box};
+}
+
 }  // namespace sparqlExpression
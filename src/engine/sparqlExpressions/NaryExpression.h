@@ -48,6 +48,15 @@ SparqlExpression::Ptr makeDistExpression(SparqlExpression::Ptr child1,
 SparqlExpression::Ptr makeLatitudeExpression(SparqlExpression::Ptr child);
 SparqlExpression::Ptr makeLongitudeExpression(SparqlExpression::Ptr child);
 
+// If `expression` is `geof:latitude(?x)`, `geof:longitude(?x)`, or
+// `geof:distance` of `?x` and a constant point, return `?x` and the bounding
+// box of the points for which `expression comparison value` can be true, else
+// `std::nullopt` (see `SparqlExpression::getGeoBoundingBox`).
+std::optional<SparqlExpression::GeoBoundingBoxOfVariable>
+getGeoBoundingBoxOfComparison(const SparqlExpression& expression,
+                              valueIdComparators::Comparison comparison,
+                              double value);
+
 SparqlExpression::Ptr makeSecondsExpression(SparqlExpression::Ptr child);
 SparqlExpression::Ptr makeMinutesExpression(SparqlExpression::Ptr child);
 SparqlExpression::Ptr makeHoursExpression(SparqlExpression::Ptr child);
@@ -60,9 +60,25 @@ inline auto andLambda = [](TernaryBool a, TernaryBool b) {
   }
   return Id::makeUndefined();
 };
-NARY_EXPRESSION(AndExpression, 2,
-                FV<decltype(andLambda), EffectiveBooleanValueGetter>,
-                SET<SetOfIntervals::Intersection>);
+using AndOperation =
+    Operation<2, FV<decltype(andLambda), EffectiveBooleanValueGetter>,
+              SET<SetOfIntervals::Intersection>>;
+class AndExpression : public NaryExpression<AndOperation> {
+ public:
+  using NaryExpression<AndOperation>::NaryExpression;
+
+  // A conjunction can only be true within the bounding boxes of both of its
+  // operands.
+  std::optional<GeoBoundingBoxOfVariable> getGeoBoundingBox() const override {
+    auto box1 = children()[0]->getGeoBoundingBox();
+    auto box2 = children()[1]->getGeoBoundingBox();
+    if (box1.has_value() && box2.has_value() &&
+        box1->variable_ == box2->variable_) {
+      box1->box_ = box1->box_.intersect(box2->box_);
+    }
+    return box1.has_value() ? box1 : box2;
+  }
+};
 
 }  // namespace detail
 
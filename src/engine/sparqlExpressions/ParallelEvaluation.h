@@ -0,0 +1,97 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "global/Constants.h"
+#include "util/Exception.h"
+
+namespace sparqlExpression::detail {
+
+// Split the rows `[0, numRows)` of the input of an expression into consecutive
+// chunks and return the results of `evaluateChunk(beginIndex, endIndex)` for
+// all the chunks in the order of the chunks. If `numRows` is at least the
+// runtime parameter `parallel-expression-min-input-size`, the chunks are
+// evaluated concurrently by `parallel-expression-num-threads` threads (one of
+// which is the calling thread), else there is only a single chunk that is
+// evaluated by the calling thread. The additional threads are started for each
+// call and are not counted by the limit of the server on the number of
+// concurrent queries (see the description of the runtime parameter).
+//
+// The calls to `evaluateChunk` must be safe to run concurrently. If one of
+// them throws (for example, because the query was cancelled), no further
+// chunks are started, and the first exception is rethrown once all the
+// threads have finished.
+template <typename EvaluateChunk>
+auto evaluateInChunks(size_t numRows, const EvaluateChunk& evaluateChunk) {
+  using Result = std::invoke_result_t<EvaluateChunk, size_t, size_t>;
+  std::vector<Result> results;
+  const size_t numThreads = std::max(
+      size_t{1}, RuntimeParameters().get<"parallel-expression-num-threads">());
+  const size_t minNumRows =
+      RuntimeParameters().get<"parallel-expression-min-input-size">();
+  if (numThreads == 1 || numRows == 0 || numRows < minNumRows) {
+    results.push_back(evaluateChunk(size_t{0}, numRows));
+    return results;
+  }
+
+  // Use several chunks per thread, s.t. the threads are busy until the end
+  // even if some of the chunks are more expensive than others.
+  const size_t numChunksTarget = 4 * numThreads;
+  const size_t chunkSize = (numRows + numChunksTarget - 1) / numChunksTarget;
+  const size_t numChunks = (numRows + chunkSize - 1) / chunkSize;
+  std::vector<std::optional<Result>> chunkResults(numChunks);
+  std::atomic<size_t> nextChunk = 0;
+  auto evaluateChunks = [&]() {
+    try {
+      for (size_t i = nextChunk++; i < numChunks; i = nextChunk++) {
+        size_t begin = i * chunkSize;
+        chunkResults[i].emplace(
+            evaluateChunk(begin, std::min(begin + chunkSize, numRows)));
+      }
+    } catch (...) {
+      // Stop the other threads as soon as possible.
+      nextChunk = numChunks;
+      throw;
+    }
+  };
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < std::min(numThreads, numChunks); ++i) {
+    futures.push_back(std::async(std::launch::async, evaluateChunks));
+  }
+  // The futures are waited for before an exception is propagated, because
+  // they refer to the local variables.
+  std::exception_ptr exception;
+  try {
+    evaluateChunks();
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+  results.reserve(numChunks);
+  for (auto& chunkResult : chunkResults) {
+    AD_CORRECTNESS_CHECK(chunkResult.has_value());
+    results.push_back(std::move(chunkResult.value()));
+  }
+  return results;
+}
+
+}  // namespace sparqlExpression::detail
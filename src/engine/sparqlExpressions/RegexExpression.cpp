@@ -4,9 +4,12 @@
 
 #include "./RegexExpression.h"
 
+#include <cctype>
+
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/StringFilterOnVocabulary.h"
 #include "global/ValueIdComparators.h"
 #include "re2/re2.h"
 
@@ -65,6 +68,141 @@ std::optional<std::string> getPrefixRegex(std::string regex) {
   return regex;
 }
 
+// ____________________________________________________________________________
+std::vector<std::string> getRequiredSubstrings(std::string_view regex,
+                                               bool caseInsensitive) {
+  // Inline flags like `(?i)` can make the rest of the regex case-insensitive.
+  if (regex.find("(?") != std::string_view::npos) {
+    caseInsensitive = true;
+  }
+  std::vector<std::string> result;
+  std::string current;
+  auto finishCurrent = [&result, &current]() {
+    if (!current.empty()) {
+      result.push_back(std::move(current));
+      current.clear();
+    }
+  };
+  auto appendLiteral = [&](char c) {
+    auto byte = static_cast<unsigned char>(c);
+    bool hasNonAsciiCaseVariant =
+        byte >= 0x80 || c == 'k' || c == 'K' || c == 's' || c == 'S';
+    if (caseInsensitive && hasNonAsciiCaseVariant) {
+      finishCurrent();
+    } else {
+      current.push_back(c);
+    }
+  };
+  // Remove the last (possibly multi-byte) character from `current`, which is
+  // made optional by a quantifier.
+  auto dropLastCharacter = [&current]() {
+    while (!current.empty() && (current.back() & 0xC0) == 0x80) {
+      current.pop_back();
+    }
+    if (!current.empty()) {
+      current.pop_back();
+    }
+  };
+  // Return the index of the first `closing` character at or after `i`, or the
+  // end of the `regex`.
+  auto skipTo = [&regex](size_t i, char closing) {
+    return std::min(regex.find(closing, i), regex.size());
+  };
+
+  size_t depth = 0;
+  for (size_t i = 0; i < regex.size(); ++i) {
+    char c = regex[i];
+    if (c == '\\') {
+      if (++i == regex.size()) {
+        break;
+      }
+      char escaped = regex[i];
+      if (std::ispunct(static_cast<unsigned char>(escaped))) {
+        if (depth == 0) {
+          appendLiteral(escaped);
+        }
+        continue;
+      }
+      // An escape sequence like `\d`, `\pL`, `\p{Greek}`, `\x41`, or
+      // `\x{41}`, the characters of which are not literals.
+      finishCurrent();
+      if (escaped == 'p' || escaped == 'P' || escaped == 'x') {
+        if (i + 1 < regex.size() && regex[i + 1] == '{') {
+          i = skipTo(i + 1, '}');
+        } else {
+          i = std::min(i + (escaped == 'x' ? 2 : 1), regex.size());
+        }
+      } else if (std::isdigit(static_cast<unsigned char>(escaped))) {
+        while (i + 1 < regex.size() &&
+               std::isdigit(static_cast<unsigned char>(regex[i + 1]))) {
+          ++i;
+        }
+      }
+      continue;
+    }
+    switch (c) {
+      case '[': {
+        // Skip the character class, which may start with `]` or `^]` and may
+        // contain escaped characters and classes like `[:alpha:]`.
+        finishCurrent();
+        size_t j = i + 1;
+        if (j < regex.size() && regex[j] == '^') {
+          ++j;
+        }
+        if (j < regex.size() && regex[j] == ']') {
+          ++j;
+        }
+        while (j < regex.size() && regex[j] != ']') {
+          if (regex[j] == '\\') {
+            j += 2;
+          } else if (regex.substr(j).starts_with("[:")) {
+            j = std::min(regex.find(":]", j + 2), regex.size()) + 2;
+          } else {
+            ++j;
+          }
+        }
+        i = j;
+        break;
+      }
+      case '(':
+        finishCurrent();
+        ++depth;
+        break;
+      case ')':
+        finishCurrent();
+        depth -= depth > 0 ? 1 : 0;
+        break;
+      case '|':
+        if (depth == 0) {
+          return {};
+        }
+        break;
+      case '?':
+      case '*':
+        dropLastCharacter();
+        finishCurrent();
+        break;
+      case '{':
+        dropLastCharacter();
+        finishCurrent();
+        i = skipTo(i, '}');
+        break;
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        finishCurrent();
+        break;
+      default:
+        if (depth == 0) {
+          appendLiteral(c);
+        }
+    }
+  }
+  finishCurrent();
+  return result;
+}
+
 // Assert that `input` starts and ends with double quotes `"` and remove those
 // quotes.
 std::string removeQuotes(std::string_view input) {
@@ -101,6 +239,7 @@ RegexExpression::RegexExpression(
           "regular expression) must not contain a language tag or a datatype");
     }
     regexString = detail::removeQuotes(originalRegexString);
+    requiredSubstrings_ = detail::getRequiredSubstrings(regexString, false);
   } else {
     throw std::runtime_error(
         "The second argument to the REGEX function must be a "
@@ -127,6 +266,9 @@ RegexExpression::RegexExpression(
             "combination of them")};
       }
 
+      if (flags.find('i') != std::string::npos) {
+        requiredSubstrings_ = detail::getRequiredSubstrings(regexString, true);
+      }
       // In Google RE2 the flags are directly part of the regex.
       if (!flags.empty()) {
         regexString = absl::StrCat("(?", flags, ":", regexString + ")");
@@ -176,7 +318,7 @@ ExpressionResult RegexExpression::evaluatePrefixRegex(
   // If the STR function was applied, we also look for prefix matches for IRIs.
   // TODO<joka921> prefix filters currently never find numbers or local vocab
   // entries, numbers, or other datatypes that are encoded directly inside the
-  // IDs.
+  // IDs (except for the `ShortString`s, see below).
   if (childIsStrExpression_) {
     actualPrefixes.push_back("<" + prefixRegex);
   }
@@ -187,6 +329,12 @@ ExpressionResult RegexExpression::evaluatePrefixRegex(
     lowerAndUpperIds.emplace_back(
         context->_qec.getIndex().prefix_range(prefix));
   }
+  // Literals that are stored directly in the IDs are sorted bytewise.
+  if (auto range = ShortString::getPrefixRange(prefixRegex)) {
+    auto lower = Id::makeFromShortString(ShortString::fromBits(range->first));
+    lowerAndUpperIds.emplace_back(
+        lower, Id::fromBits(lower.getBits() + (range->second - range->first)));
+  }
   auto beg = context->_inputTable.begin() + context->_beginIndex;
   auto end = context->_inputTable.begin() + context->_endIndex;
   AD_CONTRACT_CHECK(end <= context->_inputTable.end());
@@ -234,27 +382,11 @@ ExpressionResult RegexExpression::evaluateNonPrefixRegex(
     const Variable& variable,
     sparqlExpression::EvaluationContext* context) const {
   AD_CONTRACT_CHECK(std::holds_alternative<RE2>(regex_));
-  auto resultSize = context->size();
-  VectorWithMemoryLimit<Id> result{context->_allocator};
-  result.reserve(resultSize);
-
-  auto impl = [&]<typename ValueGetter>(const ValueGetter& getter) {
-    for (auto id : detail::makeGenerator(variable, resultSize, context)) {
-      auto str = getter(id, context);
-      if (!str.has_value()) {
-        result.push_back(Id::makeUndefined());
-      } else {
-        result.push_back(Id::makeFromBool(
-            RE2::PartialMatch(str.value(), std::get<RE2>(regex_))));
-      }
-    }
-  };
-  if (childIsStrExpression_) {
-    impl(detail::StringValueGetter{});
-  } else {
-    impl(detail::LiteralFromIdGetter{});
-  }
-  return result;
+  const auto& regex = std::get<RE2>(regex_);
+  return detail::evaluateStringFilter(
+      variable, context, absl::StrCat("REGEX ", regexAsString_),
+      !childIsStrExpression_, requiredSubstrings_,
+      [&regex](std::string_view s) { return RE2::PartialMatch(s, regex); });
 }
 
 // ___________________________________________________________________________
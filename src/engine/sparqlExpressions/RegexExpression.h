@@ -5,6 +5,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
@@ -24,6 +26,10 @@ class RegexExpression : public SparqlExpression {
   // the regex.
   bool childIsStrExpression_ = false;
 
+  // The literal parts of the regex that each match must contain, see
+  // `detail::getRequiredSubstrings`.
+  std::vector<std::string> requiredSubstrings_;
+
  public:
   // `child` must be a `VariableExpression` and `regex` must be a
   // `LiteralExpression` that stores a string, else an exception will be thrown.
@@ -44,6 +50,11 @@ class RegexExpression : public SparqlExpression {
       uint64_t inputSize,
       const std::optional<Variable>& firstSortedVariable) const override;
 
+  // _________________________________________________________________________
+  std::vector<std::string> getRequiredSubstrings() const override {
+    return requiredSubstrings_;
+  }
+
  private:
   std::span<SparqlExpression::Ptr> childrenImpl() override;
   // Internal implementations that are called by `evaluate`.
@@ -60,5 +71,16 @@ namespace detail {
 // suceeds, the prefix is returned without the leading `^` and with all escaping
 // undone. Else, `std::nullopt` is returned.
 std::optional<std::string> getPrefixRegex(std::string regex);
+
+// Return strings that each match of the `regex` must contain (for example,
+// "berlin" and "germany" for the regex `^berlin.*germany`). The analysis is
+// conservative: Only the literal characters outside of groups and character
+// classes are considered, and nothing is returned if the regex contains an
+// alternative (`|`). If `caseInsensitive` is true, the strings are also split
+// at characters that have non-ASCII case variants in Unicode (`k`, `s`, and
+// all non-ASCII characters), so that they are required when ignoring the case
+// of ASCII letters.
+std::vector<std::string> getRequiredSubstrings(std::string_view regex,
+                                               bool caseInsensitive);
 }  // namespace detail
 }  // namespace sparqlExpression
@@ -160,6 +160,55 @@ auto makeValueId(const S& value, const EvaluationContext* context) {
   }
 };
 
+// `ShortString`s are not part of the vocabulary, so their order relative to
+// other strings can only be determined via the strings themselves (see
+// `Index::compareWithShortString`). Return the result of comparing `a` and `b`
+// if one of them is a `ShortString` and the other one is a string, and
+// `std::nullopt` otherwise.
+template <Comparison Comp, StoresStringOrId T, StoresStringOrId U>
+std::optional<valueIdComparators::ComparisonResult> compareWithShortString(
+    const T& a, const U& b, const EvaluationContext* context) {
+  using valueIdComparators::fromBool;
+  auto isShortString = [](Id id) {
+    return id.getDatatype() == Datatype::ShortString;
+  };
+  if constexpr (ad_utility::isSimilar<T, IdOrString>) {
+    return a.visit([&b, context](const auto& x) {
+      return compareWithShortString<Comp>(x, b, context);
+    });
+  } else if constexpr (ad_utility::isSimilar<U, IdOrString>) {
+    return b.visit([&a, context](const auto& y) {
+      return compareWithShortString<Comp>(a, y, context);
+    });
+  } else if constexpr (ad_utility::isSimilar<T, Id> &&
+                       ad_utility::isSimilar<U, Id>) {
+    if (!isShortString(a) && !isShortString(b)) {
+      return std::nullopt;
+    }
+    auto cmp = context->_qec.getIndex().compareWithShortString(
+        a, b, context->_localVocab);
+    if (!cmp.has_value()) {
+      return std::nullopt;
+    }
+    return fromBool(applyComparison<Comp>(cmp.value(), 0));
+  } else if constexpr (ad_utility::isSimilar<T, Id> &&
+                       ad_utility::isSimilar<U, std::string>) {
+    if (!isShortString(a)) {
+      return std::nullopt;
+    }
+    int cmp = context->_qec.getIndex().getVocab().getCaseComparator().compare(
+        a.getShortString().toLiteral(), b,
+        TripleComponentComparator::Level::QUARTERNARY);
+    return fromBool(applyComparison<Comp>(cmp, 0));
+  } else if constexpr (ad_utility::isSimilar<T, std::string> &&
+                       ad_utility::isSimilar<U, Id>) {
+    return compareWithShortString<getComparisonForSwappedArguments(Comp)>(
+        b, a, context);
+  } else {
+    return std::nullopt;
+  }
+}
+
 // Compare two elements that are either strings or IDs in some way (see the
 // `StoresStringOrId` concept) according to the sepcified comparison (see
 // `ValueIdComparators.h` for details). The `EvaluationContext` is required to
@@ -177,6 +226,10 @@ inline const auto compareIdsOrStrings =
     // IRIs/ Literals/etc.
     return valueIdComparators::fromBool(applyComparison<Comp>(a, b));
   } else {
+    if (auto result = compareWithShortString<Comp>(a, b, ctx);
+        result.has_value()) {
+      return result.value();
+    }
     auto x = makeValueId(a, ctx);
     auto y = makeValueId(b, ctx);
     if constexpr (requires { valueIdComparators::compareIds(x, y, Comp); }) {
@@ -6,6 +6,7 @@
 
 #include "engine/sparqlExpressions/LangExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "util/LambdaHelpers.h"
@@ -84,9 +85,12 @@ auto getGenerators(S1 value1, S2 value2, size_t targetSize,
 // valueId` for each `ValueId` that the Variable `variable` is bound to. This
 // only works, if the input (as stored in the `context`) is sorted by the
 // Variable `variable`. If `valueIdUpper` is nullopt, we only have a single
-// `valueId`, otherwise we have a range, [`valueId`, `valueIdUpper`).
+// `valueId`, otherwise we have a range, [`valueId`, `valueIdUpper`). Return
+// `std::nullopt` if the comparison involves strings that are inlined into the
+// `ValueId` (`ShortString`s), which are not sorted in the order of the
+// vocabulary.
 template <Comparison Comp>
-ad_utility::SetOfIntervals evaluateWithBinarySearch(
+std::optional<ad_utility::SetOfIntervals> evaluateWithBinarySearch(
     const Variable& variable, ValueId valueId,
     std::optional<ValueId> valueIdUpper, const EvaluationContext* context) {
   // Set up iterators into the `IdTable` that only access the column where the
@@ -105,6 +109,20 @@ ad_utility::SetOfIntervals evaluateWithBinarySearch(
   auto end =
       Iterator{&context->_inputTable, context->_endIndex, getIdFromColumn};
 
+  auto type = valueId.getDatatype();
+  bool isStringComparison = valueIdUpper.has_value() ||
+                            type == Datatype::VocabIndex ||
+                            type == Datatype::LocalVocabIndex ||
+                            type == Datatype::ShortString;
+  if (isStringComparison) {
+    auto [shortStringsBegin, shortStringsEnd] =
+        valueIdComparators::getRangeForDatatype(begin, end,
+                                                Datatype::ShortString);
+    if (type == Datatype::ShortString || shortStringsBegin != shortStringsEnd) {
+      return std::nullopt;
+    }
+  }
+
   // Perform the actual evaluation.
   const auto resultRanges = [&]() {
     if (valueIdUpper) {
@@ -345,6 +363,75 @@ RelationalExpression<comp>::getEstimatesForFilterExpression(
   return {sizeEstimate, costEstimate};
 }
 
+// _____________________________________________________________________________
+namespace {
+// The comparison with swapped operands, for example `GT` for `LT`.
+constexpr Comparison mirrorComparison(Comparison comparison) {
+  using enum Comparison;
+  switch (comparison) {
+    case LT:
+      return GT;
+    case LE:
+      return GE;
+    case GE:
+      return LE;
+    case GT:
+      return LT;
+    default:
+      return comparison;
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+template <Comparison comp>
+auto RelationalExpression<comp>::getVariableComparison() const
+    -> std::optional<VariableComparison> {
+  auto getComparison = [](const Ptr& left, const Ptr& right,
+                          Comparison comparison)
+      -> std::optional<VariableComparison> {
+    auto varPtr = dynamic_cast<const VariableExpression*>(left.get());
+    auto idPtr = dynamic_cast<const IdExpression*>(right.get());
+    if (!varPtr || !idPtr) {
+      return std::nullopt;
+    }
+    return VariableComparison{varPtr->value(), comparison, idPtr->value()};
+  };
+  // For `42 > ?x`, the variable is on the right, so we have to mirror the
+  // comparison (`?x < 42`).
+  if (auto comparison = getComparison(children_[0], children_[1], comp)) {
+    return comparison;
+  }
+  return getComparison(children_[1], children_[0], mirrorComparison(comp));
+}
+
+// _____________________________________________________________________________
+template <Comparison comp>
+auto RelationalExpression<comp>::getGeoBoundingBox() const
+    -> std::optional<GeoBoundingBoxOfVariable> {
+  auto getBox = [](const Ptr& left, const Ptr& right, Comparison comparison)
+      -> std::optional<GeoBoundingBoxOfVariable> {
+    auto idPtr = dynamic_cast<const IdExpression*>(right.get());
+    if (!idPtr) {
+      return std::nullopt;
+    }
+    Id constant = idPtr->value();
+    if (constant.getDatatype() == Datatype::Int) {
+      return getGeoBoundingBoxOfComparison(
+          *left, comparison, static_cast<double>(constant.getInt()));
+    } else if (constant.getDatatype() == Datatype::Double) {
+      return getGeoBoundingBoxOfComparison(*left, comparison,
+                                           constant.getDouble());
+    }
+    return std::nullopt;
+  };
+  if (auto box = getBox(children_[0], children_[1], comp)) {
+    return box;
+  }
+  // For `10 > geof:latitude(?x)`, the function is on the right.
+  return getBox(children_[1], children_[0], mirrorComparison(comp));
+}
+
 // Explicit instantiations
 template class RelationalExpression<Comparison::LT>;
 template class RelationalExpression<Comparison::LE>;
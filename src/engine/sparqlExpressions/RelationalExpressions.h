@@ -44,6 +44,15 @@ class RelationalExpression : public SparqlExpression {
       uint64_t inputSizeEstimate,
       const std::optional<Variable>& firstSortedVariable) const override;
 
+  // Check if this expression compares a variable with a constant `Id` (for
+  // example a number or a date) and return the appropriate data.
+  std::optional<VariableComparison> getVariableComparison() const override;
+
+  // Check if this expression compares the distance of a variable to a constant
+  // point or one of the coordinates of a variable with a constant number (see
+  // `getGeoBoundingBoxOfComparison`).
+  std::optional<GeoBoundingBoxOfVariable> getGeoBoundingBox() const override;
+
  private:
   std::span<SparqlExpression::Ptr> childrenImpl() override;
 };
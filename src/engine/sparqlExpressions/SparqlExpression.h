@@ -124,11 +124,12 @@ class SparqlExpression {
     return std::nullopt;
   }
 
-  // For the following three functions (`containsLangExpression`,
-  // `getLanguageFilterExpression`, and `getEstimatesForFilterExpression`, see
-  // the documentation of the functions of the same names in
-  // `SparqlExpressionPimpl.h`. Each of them has a default implementation that
-  // is correct for most of the expressions.
+  // For the following six functions (`containsLangExpression`,
+  // `getLanguageFilterExpression`, `getEstimatesForFilterExpression`,
+  // `getRequiredSubstrings`, `getVariableComparison`, and
+  // `getGeoBoundingBox`), see the documentation of the functions of the same
+  // names in `SparqlExpressionPimpl.h`. Each of them has a default
+  // implementation that is correct for most of the expressions.
   virtual bool containsLangExpression() const {
     return std::ranges::any_of(children(),
                                [](const SparqlExpression::Ptr& child) {
@@ -153,6 +154,22 @@ class SparqlExpression {
     return {inputSizeEstimate, inputSizeEstimate};
   }
 
+  // ___________________________________________________________________________
+  virtual std::vector<std::string> getRequiredSubstrings() const { return {}; }
+
+  // ___________________________________________________________________________
+  using VariableComparison = SparqlExpressionPimpl::VariableComparison;
+  virtual std::optional<VariableComparison> getVariableComparison() const {
+    return std::nullopt;
+  }
+
+  // ___________________________________________________________________________
+  using GeoBoundingBoxOfVariable =
+      SparqlExpressionPimpl::GeoBoundingBoxOfVariable;
+  virtual std::optional<GeoBoundingBoxOfVariable> getGeoBoundingBox() const {
+    return std::nullopt;
+  }
+
   // Returns true iff this expression is a simple constant. Default
   // implementation returns `false`.
   virtual bool isConstantExpression() const { return false; }
@@ -92,6 +92,23 @@ auto SparqlExpressionPimpl::getEstimatesForFilterExpression(
                                                  primarySortKeyVariable);
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> SparqlExpressionPimpl::getRequiredSubstrings() const {
+  return _pimpl->getRequiredSubstrings();
+}
+
+// _____________________________________________________________________________
+auto SparqlExpressionPimpl::getVariableComparison() const
+    -> std::optional<VariableComparison> {
+  return _pimpl->getVariableComparison();
+}
+
+// _____________________________________________________________________________
+auto SparqlExpressionPimpl::getGeoBoundingBox() const
+    -> std::optional<GeoBoundingBoxOfVariable> {
+  return _pimpl->getGeoBoundingBox();
+}
+
 // _____________________________________________________________________________
 bool SparqlExpressionPimpl::containsLangExpression() const {
   return _pimpl->containsLangExpression();
@@ -9,7 +9,9 @@
 #include <vector>
 
 #include "engine/VariableToColumnMap.h"
+#include "global/ValueIdComparators.h"
 #include "parser/data/Variable.h"
+#include "util/GeoPoint.h"
 #include "util/HashMap.h"
 #include "util/HashSet.h"
 
@@ -111,6 +113,36 @@ class SparqlExpressionPimpl {
       uint64_t inputSizeEstimate,
       const std::optional<Variable>& primarySortKeyVariable);
 
+  // If `this` is an expression that can only be true if the string of a value
+  // contains certain substrings (ignoring the case of ASCII letters), return
+  // these substrings, else return an empty vector. For example, for
+  // `CONTAINS(?x, "berlin")` or `REGEX(?x, "berlin.*germany")`. Used to
+  // estimate the size of a `FILTER` via the trigram index of the vocabulary.
+  std::vector<std::string> getRequiredSubstrings() const;
+
+  // If `this` is a comparison of a variable with a constant, for example
+  // `?x < 42` or `42 > ?x`, return the variable, the comparison (with the
+  // variable on the left), and the constant. Used to estimate the size of a
+  // `FILTER` via the `ColumnStatistics` of the index.
+  struct VariableComparison {
+    Variable variable_;
+    valueIdComparators::Comparison comparison_;
+    Id constant_;
+  };
+  std::optional<VariableComparison> getVariableComparison() const;
+
+  // If `this` can only be true if the value of a variable is a point in a
+  // certain bounding box, return the variable and the box. For example, for
+  // `geof:distance(?x, "POINT(7.8 48.0)"^^geo:wktLiteral) < 10` or
+  // `geof:latitude(?x) > 50`, and for a conjunction of such conditions. Used
+  // to read only the blocks of an index scan with points in the box (see
+  // `GeoPoint`).
+  struct GeoBoundingBoxOfVariable {
+    Variable variable_;
+    GeoBoundingBox box_;
+  };
+  std::optional<GeoBoundingBoxOfVariable> getGeoBoundingBox() const;
+
   SparqlExpression* getPimpl() { return _pimpl.get(); }
   [[nodiscard]] const SparqlExpression* getPimpl() const {
     return _pimpl.get();
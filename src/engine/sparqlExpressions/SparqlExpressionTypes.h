@@ -6,6 +6,7 @@
 #ifndef QLEVER_SPARQLEXPRESSIONTYPES_H
 #define QLEVER_SPARQLEXPRESSIONTYPES_H
 
+#include "engine/LocalVocab.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/ResultTable.h"
 #include "engine/sparqlExpressions/SetOfIntervals.h"
@@ -13,6 +14,7 @@
 #include "parser/TripleComponent.h"
 #include "parser/data/Variable.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/CancellationHandle.h"
 #include "util/ConstexprSmallString.h"
 #include "util/Generator.h"
 #include "util/HashMap.h"
@@ -180,6 +182,13 @@ struct EvaluationContext {
   // as part of a GROUP BY clause.
   bool _isPartOfGroupBy = false;
 
+  // The cancellation handle of the operation that evaluates the expression.
+  // It is checked by long-running parts of the evaluation that are not
+  // proportional to the size of the input (for example, the scan of the
+  // vocabulary in `detail::evaluateStringFilter`).
+  ad_utility::SharedCancellationHandle _cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+
   /// Constructor for evaluating an expression on the complete input.
   EvaluationContext(const QueryExecutionContext& qec,
                     const VariableToColumnMap& variableToColumnMap,
@@ -257,8 +266,8 @@ Id constantExpressionResultToId(T&& result, LocalVocabT& localVocab) {
     return std::visit(
         [&localVocab]<typename R>(R&& el) mutable {
           if constexpr (ad_utility::isSimilar<R, string>) {
-            return Id::makeFromLocalVocabIndex(
-                localVocab.getIndexAndAddIfNotContained(std::forward<R>(el)));
+            return getIdOfWordNotInVocabulary(std::forward<R>(el),
+                                              localVocab);
           } else {
             static_assert(ad_utility::isSimilar<R, Id>);
             return el;
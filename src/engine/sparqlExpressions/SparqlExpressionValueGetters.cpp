@@ -18,6 +18,8 @@ NumericValue NumericValueGetter::operator()(
       return id.getDouble();
     case Datatype::Int:
       return id.getInt();
+    case Datatype::Decimal:
+      return id.getDecimal().toDouble();
     case Datatype::Bool:
       // TODO<joka921> Check in the specification what the correct behavior is
       // here. They probably should be UNDEF as soon as we have conversion
@@ -29,6 +31,8 @@ NumericValue NumericValueGetter::operator()(
     case Datatype::TextRecordIndex:
     case Datatype::WordVocabIndex:
     case Datatype::Date:
+    case Datatype::GeoPoint:
+    case Datatype::ShortString:
       return NotNumeric{};
   }
   AD_FAIL();
@@ -45,6 +49,8 @@ auto EffectiveBooleanValueGetter::operator()(
     }
     case Datatype::Int:
       return (id.getInt() != 0) ? True : False;
+    case Datatype::Decimal:
+      return (id.getDecimal().getUnits() != 0) ? True : False;
     case Datatype::Bool:
       return id.getBool() ? True : False;
     case Datatype::Undefined:
@@ -66,9 +72,12 @@ auto EffectiveBooleanValueGetter::operator()(
                  ? False
                  : True;
     }
+    case Datatype::ShortString:
+      return id.getShortString().getContent().empty() ? False : True;
     case Datatype::WordVocabIndex:
     case Datatype::TextRecordIndex:
     case Datatype::Date:
+    case Datatype::GeoPoint:
       return True;
   }
   AD_FAIL();
@@ -100,6 +109,18 @@ std::optional<string> LiteralFromIdGetter::operator()(
   }
 }
 
+// ____________________________________________________________________________
+auto GeoPointValueGetter::operator()(ValueId id,
+                                     const EvaluationContext* context) const
+    -> Opt {
+  if (id.getDatatype() == Datatype::GeoPoint) {
+    return id.getGeoPoint();
+  }
+  auto literal = LiteralFromIdGetter{}(id, context);
+  return literal.has_value() ? GeoPoint::parseWktPoint(literal.value())
+                             : std::nullopt;
+}
+
 // ____________________________________________________________________________
 bool IsValidValueGetter::operator()(
     ValueId id, [[maybe_unused]] const EvaluationContext* context) const {
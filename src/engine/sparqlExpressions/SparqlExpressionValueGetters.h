@@ -169,6 +169,27 @@ struct LiteralFromIdGetter {
   }
 };
 
+// Return the `GeoPoint` of a `ValueId` of type `GeoPoint`. The points of
+// other literals (for example WKT points without the `geo:wktLiteral` datatype
+// or from a `VALUES` clause) are parsed. For all other values and literals that
+// are not valid WKT points, return `std::nullopt`.
+struct GeoPointValueGetter {
+  using Opt = std::optional<GeoPoint>;
+
+  Opt operator()(ValueId id, const EvaluationContext* context) const;
+
+  Opt operator()(const std::string& s, const EvaluationContext* ctx) const {
+    auto literal = LiteralFromIdGetter{}(s, ctx);
+    return literal.has_value() ? GeoPoint::parseWktPoint(literal.value())
+                               : std::nullopt;
+  }
+
+  Opt operator()(IdOrString s, const EvaluationContext* ctx) const {
+    return std::visit([this, ctx](auto el) { return operator()(el, ctx); },
+                      std::move(s));
+  }
+};
+
 // Convert the input into a `unique_ptr<RE2>`. Return nullptr if the input is
 // not convertible to a string.
 struct RegexValueGetter {
@@ -4,8 +4,11 @@
 
 #include <boost/url.hpp>
 
+#include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
+#include "engine/sparqlExpressions/StringFilterOnVocabulary.h"
 #include "engine/sparqlExpressions/VariadicExpression.h"
+#include "parser/RdfEscaping.h"
 
 namespace sparqlExpression {
 namespace detail::string_expressions {
@@ -94,6 +97,70 @@ struct LiftStringFunction {
   }
 };
 
+// An expression like `STRSTARTS` or `CONTAINS` that filters the strings of its
+// first argument with a pattern that is given by its second argument. If the
+// first argument is a variable (possibly wrapped in `STR()`) and the pattern is
+// a constant, the filter is evaluated via `detail::evaluateStringFilter`,
+// which uses the precomputed matches of the vocabulary for large inputs. Else
+// the expression is evaluated like a `StringExpressionImpl`.
+template <typename Function, ad_utility::ConstexprSmallString<30> name>
+class StringFilterExpression
+    : public StringExpressionImpl<2, LiftStringFunction<Function>,
+                                  StringValueGetter> {
+  using Base =
+      StringExpressionImpl<2, LiftStringFunction<Function>, StringValueGetter>;
+
+ public:
+  StringFilterExpression(SparqlExpression::Ptr child,
+                         SparqlExpression::Ptr pattern)
+      : Base{std::move(child), std::move(pattern)} {}
+
+  ExpressionResult evaluate(EvaluationContext* context) const override {
+    auto children = this->children();
+    if (!children[0]->getVariableOrNullopt().has_value() ||
+        !children[1]->isConstantExpression()) {
+      return Base::evaluate(context);
+    }
+    // Note: A variable that is grouped by evaluates to a constant.
+    auto child = children[0]->evaluate(context);
+    auto* variable = std::get_if<Variable>(&child);
+    if (variable == nullptr) {
+      return Base::evaluate(context);
+    }
+    auto patternResult = children[1]->evaluate(context);
+    auto* patternIdOrString = std::get_if<IdOrString>(&patternResult);
+    if (patternIdOrString == nullptr) {
+      return Base::evaluate(context);
+    }
+    auto pattern = StringValueGetter{}(*patternIdOrString, context);
+    if (!pattern.has_value()) {
+      return Base::evaluate(context);
+    }
+    // Like the `StringValueGetter` of the `Base`, the filter is also applied
+    // to the strings of IRIs and numbers, with or without `STR()`.
+    return detail::evaluateStringFilter(
+        *variable, context,
+        absl::StrCat(std::string_view{name}, " ", pattern.value()), false,
+        {pattern.value()},
+        [&pattern](std::string_view text) {
+          return Function{}(text, pattern.value()).getBool();
+        });
+  }
+
+  // The pattern is a substring of all the strings that match.
+  std::vector<std::string> getRequiredSubstrings() const override {
+    auto children = this->children();
+    auto* pattern =
+        dynamic_cast<const StringLiteralExpression*>(children[1].get());
+    if (!children[0]->getVariableOrNullopt().has_value() ||
+        pattern == nullptr) {
+      return {};
+    }
+    return {RdfEscaping::normalizedContentFromLiteralOrIri(
+        std::string{pattern->value().normalizedLiteralContent().get()})};
+  }
+};
+
 // STRLEN
 [[maybe_unused]] auto strlen = [](std::string_view s) {
   return Id::makeFromInt(static_cast<int64_t>(s.size()));
@@ -200,8 +267,7 @@ using SubstrExpression =
 };
 
 using StrStartsExpression =
-    StringExpressionImpl<2, LiftStringFunction<decltype(strStartsImpl)>,
-                         StringValueGetter>;
+    StringFilterExpression<decltype(strStartsImpl), "STRSTARTS">;
 
 // STRENDS
 [[maybe_unused]] auto strEndsImpl = [](std::string_view text,
@@ -220,8 +286,7 @@ using StrEndsExpression =
 };
 
 using ContainsExpression =
-    StringExpressionImpl<2, LiftStringFunction<decltype(containsImpl)>,
-                         StringValueGetter>;
+    StringFilterExpression<decltype(containsImpl), "CONTAINS">;
 
 // STRAFTER / STRBEFORE
 template <bool isStrAfter>
@@ -0,0 +1,66 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "engine/sparqlExpressions/StringFilterOnVocabulary.h"
+
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "global/Constants.h"
+#include "parser/RdfEscaping.h"
+
+namespace sparqlExpression::detail {
+
+// _____________________________________________________________________________
+ExpressionResult evaluateStringFilter(
+    const Variable& variable, EvaluationContext* context,
+    const std::string& cacheKey, bool onlyLiterals,
+    std::vector<std::string> requiredSubstrings,
+    const std::function<bool(std::string_view)>& filter) {
+  const Index& index = context->_qec.getIndex();
+  auto resultSize = context->size();
+
+  // The `filter` applied to the words as they are stored in the vocabulary.
+  // This has to be consistent with the value getters.
+  auto filterOnWord = [onlyLiterals,
+                       &filter](std::string_view word) -> std::optional<bool> {
+    if (onlyLiterals && !word.starts_with('"')) {
+      return std::nullopt;
+    }
+    return filter(
+        RdfEscaping::normalizedContentFromLiteralOrIri(std::string{word}));
+  };
+  double minFraction =
+      RuntimeParameters().get<"vocabulary-matches-min-input-fraction">();
+  // The size of the complete input decides, not the size of the current
+  // chunk (see `evaluateInChunks`) or group, because the matches are computed
+  // once and then reused for all the chunks and groups.
+  bool onlyReadFromCache =
+      static_cast<double>(context->_inputTable.size()) <
+      minFraction *
+          static_cast<double>(index.getVocabularySizeIncludingExternal());
+  auto matches = index.getVocabularyMatches(
+      absl::StrCat(cacheKey, " onlyLiterals:", onlyLiterals),
+      {filterOnWord, std::move(requiredSubstrings), onlyLiterals},
+      onlyReadFromCache, context->_cancellationHandle);
+
+  auto evaluateOnString = [&filter](const std::optional<std::string>& s) {
+    return s.has_value() ? Id::makeFromBool(filter(s.value()))
+                         : Id::makeUndefined();
+  };
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(resultSize);
+  for (Id id : makeGenerator(variable, resultSize, context)) {
+    if (matches != nullptr && id.getDatatype() == Datatype::VocabIndex) {
+      auto match = (*matches)[id.getVocabIndex()];
+      result.push_back(match.has_value() ? Id::makeFromBool(match.value())
+                                         : Id::makeUndefined());
+    } else if (onlyLiterals) {
+      result.push_back(evaluateOnString(LiteralFromIdGetter{}(id, context)));
+    } else {
+      result.push_back(evaluateOnString(StringValueGetter{}(id, context)));
+    }
+  }
+  return result;
+}
+
+}  // namespace sparqlExpression::detail
@@ -0,0 +1,36 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+
+namespace sparqlExpression::detail {
+
+// Evaluate a `filter` (for example a regex or `CONTAINS` with a fixed pattern)
+// on the strings of the values that are bound to the `variable`. The result
+// is `true`, `false`, or `UNDEF` (for values that have no string) for each
+// row. If `onlyLiterals` is true, the strings are obtained like by the
+// `LiteralFromIdGetter`, else like by the `StringValueGetter`.
+//
+// For the values from the vocabulary, the filter is evaluated via
+// `Index::getVocabularyMatches` if the input is large compared to the
+// vocabulary (see the runtime parameter
+// `vocabulary-matches-min-input-fraction`) or if these matches are already
+// cached. The `cacheKey` must uniquely identify the `filter`. The
+// `requiredSubstrings` are substrings that each string for which the `filter`
+// is true must contain (ignoring the case of ASCII letters). If there is a
+// trigram index, they are used to only evaluate the `filter` on the
+// candidates from this index.
+ExpressionResult evaluateStringFilter(
+    const Variable& variable, EvaluationContext* context,
+    const std::string& cacheKey, bool onlyLiterals,
+    std::vector<std::string> requiredSubstrings,
+    const std::function<bool(std::string_view)>& filter);
+
+}  // namespace sparqlExpression::detail
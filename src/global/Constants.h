@@ -119,6 +119,8 @@ static const char XSD_POSITIVE_INTEGER_TYPE[] =
     "http://www.w3.org/2001/XMLSchema#positiveInteger";
 constexpr inline char XSD_BOOLEAN_TYPE[] =
     "http://www.w3.org/2001/XMLSchema#boolean";
+constexpr inline char GEO_WKT_LITERAL[] =
+    "http://www.opengis.net/ont/geosparql#wktLiteral";
 static const char RDF_PREFIX[] = "http://www.w3.org/1999/02/22-rdf-syntax-ns#";
 static const char VALUE_DATE_TIME_SEPARATOR[] = "T";
 static const int DEFAULT_NOF_VALUE_INTEGER_DIGITS = 50;
@@ -131,6 +133,12 @@ static const std::string EXTERNAL_VOCAB_SUFFIX = ".vocabulary.external";
 static const std::string MMAP_FILE_SUFFIX = ".meta";
 static const std::string CONFIGURATION_FILE = ".meta-data.json";
 static const std::string PREFIX_FILE = ".prefixes";
+static const std::string TRIGRAM_INDEX_SUFFIX = ".trigram-index";
+// The `ColumnStatistics` of a permutation are stored in a file with this suffix
+// next to the permutation.
+static const std::string COLUMN_STATISTICS_SUFFIX = ".column-statistics";
+// The same for the `RelationSummary`s of a permutation.
+static const std::string RELATION_SUMMARIES_SUFFIX = ".relation-summaries";
 
 static const std::string ERROR_IGNORE_CASE_UNSUPPORTED =
     "Key \"ignore-case\" is no longer supported. Please remove this key from "
@@ -232,7 +240,95 @@ inline auto& RuntimeParameters() {
             DurationParameter<std::chrono::seconds, "default-query-timeout">{
                 30s}),
         SizeT<"lazy-index-scan-max-size-materialization">{1'000'000},
-        Bool<"use-group-by-hash-map-optimization">{false}};
+        Bool<"use-group-by-hash-map-optimization">{false},
+        // Compute the aggregates of a GROUP BY over a star join (see
+        // `FactorizedStarJoin`) from the factorized join result, without
+        // computing the cross products of the matching rows of its inputs.
+        Bool<"use-group-by-factorized-star-join">{true},
+        // The factorized star join materializes its inputs, while a `Join`
+        // can read its inputs lazily and skip the blocks of a scan without a
+        // match. It is therefore only used if the estimated size of the star
+        // join is at least this factor larger than the sum of the sizes of its
+        // inputs.
+        Double<"group-by-star-join-min-blow-up">{10.0},
+        // Compute COUNT, COUNT(DISTINCT), MIN, and MAX of a variable of a
+        // single triple (optionally with FILTERs that compare the variable
+        // with numeric constants) from the metadata and the `RelationSummary`s
+        // of the index, reading only the blocks for which they don't suffice.
+        Bool<"use-index-aggregate-summaries">{true},
+        // The maximal time for a single SERVICE operation (in addition to the
+        // timeout of the whole query). Zero means no additional limit.
+        DurationParameter<std::chrono::seconds, "service-timeout">{0s},
+        // A SERVICE that is joined with a result that has at most this many
+        // distinct bindings of the join variables sends these bindings to the
+        // remote endpoint as VALUES clauses (bind join), with at most
+        // `service-bind-join-batch-size` bindings per request and at most
+        // `service-bind-join-num-threads` concurrent requests.
+        SizeT<"service-bind-join-max-rows">{100'000},
+        SizeT<"service-bind-join-batch-size">{1'000},
+        SizeT<"service-bind-join-num-threads">{4},
+        // The maximal size of the cache for the words of the externalized
+        // vocabulary that are resolved when exporting query results.
+        MemorySizeParameter<"vocabulary-cache-max-size">{100_MB},
+        // String filters like REGEX or CONTAINS on a variable are evaluated
+        // by a single scan over the complete vocabulary (the result of which
+        // is cached) if the number of rows of the input is at least this
+        // fraction of the size of the vocabulary, or if the result of the scan
+        // is already cached.
+        Double<"vocabulary-matches-min-input-fraction">{0.1},
+        MemorySizeParameter<"vocabulary-matches-cache-max-size">{1_GB},
+        // The expressions of FILTER and BIND are evaluated concurrently on
+        // chunks of the input with this many threads if the input has at
+        // least `parallel-expression-min-input-size` rows. A value of 1
+        // disables the parallel evaluation. The same number of threads is
+        // used for the scans of the vocabulary for string filters (see
+        // `vocabulary-matches-min-input-fraction`). Each such FILTER, BIND, or
+        // scan starts up to this many threads minus one in addition to the
+        // thread of the query, which are not limited by
+        // `--num-simultaneous-queries`. With `n` concurrent queries, up to `n`
+        // times as many threads can be active, so the default is conservative.
+        SizeT<"parallel-expression-num-threads">{4},
+        SizeT<"parallel-expression-min-input-size">{100'000},
+        // If the connected subgraphs of a connected component of a basic graph
+        // pattern (the sets of triples for which the dynamic programming of
+        // the query planner creates plans) are more than this many, the
+        // component is planned greedily instead.
+        SizeT<"query-planning-budget">{1500},
+        // The cyclic parts of a basic graph pattern (for example triangles)
+        // that consist of at least this many triples with a fixed predicate
+        // can be computed by a single `WorstCaseOptimalJoin`, which the query
+        // planner chooses over the binary joins if it is cheaper. Zero
+        // disables this.
+        SizeT<"wcoj-min-num-triples">{3},
+        // Use the histograms and distinct-count sketches of the index (see
+        // `ColumnStatistics`) for the size estimates of filters and joins.
+        Bool<"use-column-statistics">{true},
+        // The sizes of the results of executed subtrees are remembered (at most
+        // this many, see `ObservedSizes`) and used by the query planner instead
+        // of the estimates if `use-observed-sizes` is set.
+        SizeT<"observed-sizes-max-num-entries">{100'000},
+        Bool<"use-observed-sizes">{true},
+        // If the size of the result of a subtree deviates from its estimate by
+        // at least this factor, the rest of the query is planned again (at
+        // most once per query). Zero disables the re-planning.
+        Double<"replanning-min-deviation-factor">{100.0},
+        // The size of a join of two index scans is estimated by joining at
+        // most this many blocks of one of the scans with the other scan, as
+        // long as the time budget is not exceeded (see
+        // `IndexScan::estimateJoinSizeBySampling`). Zero disables the
+        // sampling.
+        SizeT<"join-sampling-num-blocks">{8},
+        DurationParameter<std::chrono::milliseconds,
+                          "join-sampling-time-budget">{20ms},
+        // The join column of the smaller side of a join with at most this
+        // many rows is used to restrict the index scans of the other side to
+        // the blocks and rows that can have a match (see
+        // `Operation::pushDownSemiJoinFilter`). Zero disables this.
+        SizeT<"semi-join-filter-max-size">{1'000'000},
+        // A FILTER that can only be true for the points in a bounding box
+        // restricts an index scan to at most this many ranges of `GeoPoint`
+        // values (see `GeoBoundingBox::zOrderRanges`). Zero disables this.
+        SizeT<"geo-filter-max-num-ranges">{64}};
   }();
   return params;
 }
@@ -16,8 +16,11 @@
 #include "global/IndexTypes.h"
 #include "util/BitUtils.h"
 #include "util/Date.h"
+#include "util/Decimal.h"
+#include "util/GeoPoint.h"
 #include "util/NBitInteger.h"
 #include "util/Serializer/Serializer.h"
+#include "util/ShortString.h"
 #include "util/SourceLocation.h"
 
 /// The different Datatypes that a `ValueId` (see below) can encode.
@@ -31,7 +34,10 @@ enum struct Datatype {
   TextRecordIndex,
   Date,
   WordVocabIndex,
-  MaxValue = WordVocabIndex
+  GeoPoint,
+  Decimal,
+  ShortString,
+  MaxValue = ShortString
   // Note: Unfortunately we cannot easily get the size of an enum.
   // If members are added to this enum, then the `MaxValue`
   // alias must always be equal to the last member,
@@ -59,6 +65,12 @@ constexpr std::string_view toString(Datatype type) {
       return "WordVocabIndex";
     case Datatype::Date:
       return "Date";
+    case Datatype::GeoPoint:
+      return "GeoPoint";
+    case Datatype::Decimal:
+      return "Decimal";
+    case Datatype::ShortString:
+      return "ShortString";
   }
   // This line is reachable if we cast an arbitrary invalid int to this enum
   AD_FAIL();
@@ -239,6 +251,36 @@ class ValueId {
     return std::bit_cast<DateOrLargeYear>(removeDatatypeBits(_bits));
   }
 
+  // Store or load a `GeoPoint`. The order of the `ValueId`s is the Z-order of
+  // the points (see `GeoPoint`).
+  static ValueId makeFromGeoPoint(GeoPoint p) noexcept {
+    return addDatatypeBits(p.toBits(), Datatype::GeoPoint);
+  }
+
+  GeoPoint getGeoPoint() const noexcept {
+    return GeoPoint::fromBits(removeDatatypeBits(_bits));
+  }
+
+  // Store or load a `Decimal`. The order of the `ValueId`s is the numeric
+  // order of the decimals (see `Decimal`).
+  static ValueId makeFromDecimal(Decimal d) noexcept {
+    return addDatatypeBits(d.toBits(), Datatype::Decimal);
+  }
+
+  Decimal getDecimal() const noexcept {
+    return Decimal::fromBits(removeDatatypeBits(_bits));
+  }
+
+  // Store or load a `ShortString`. The order of the `ValueId`s is the bytewise
+  // order of the contents (see `ShortString`).
+  static ValueId makeFromShortString(ShortString s) noexcept {
+    return addDatatypeBits(s.toBits(), Datatype::ShortString);
+  }
+
+  ShortString getShortString() const noexcept {
+    return ShortString::fromBits(removeDatatypeBits(_bits));
+  }
+
   // TODO<joka921> implement dates
 
   /// Return the smallest and largest possible `ValueId` wrt the underlying
@@ -291,6 +333,12 @@ class ValueId {
         return std::invoke(visitor, getWordVocabIndex());
       case Datatype::Date:
         return std::invoke(visitor, getDate());
+      case Datatype::GeoPoint:
+        return std::invoke(visitor, getGeoPoint());
+      case Datatype::Decimal:
+        return std::invoke(visitor, getDecimal());
+      case Datatype::ShortString:
+        return std::invoke(visitor, getShortString());
     }
     AD_FAIL();
   }
@@ -320,8 +368,12 @@ class ValueId {
         ostr << std::to_string(value);
       } else if constexpr (ad_utility::isSimilar<T, bool>) {
         ostr << (value ? "true" : "false");
-      } else if constexpr (ad_utility::isSimilar<T, DateOrLargeYear>) {
+      } else if constexpr (ad_utility::isSimilar<T, DateOrLargeYear> ||
+                           ad_utility::isSimilar<T, GeoPoint> ||
+                           ad_utility::isSimilar<T, Decimal>) {
         ostr << value.toStringAndType().first;
+      } else if constexpr (ad_utility::isSimilar<T, ShortString>) {
+        ostr << value.toLiteral();
       } else {
         // T is `VocabIndex || LocalVocabIndex || TextRecordIndex`
         ostr << std::to_string(value.get());
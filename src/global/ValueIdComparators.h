@@ -164,13 +164,24 @@ class RangeFilter {
   }
 };
 
+// Return true iff the numeric `value` (a `double`, `int64_t` or `Decimal`) is
+// not a number.
+template <typename Value>
+inline bool isNan(const Value& value) {
+  if constexpr (std::is_floating_point_v<Value>) {
+    return std::isnan(value);
+  } else {
+    return false;
+  }
+}
+
 // This function is part of the implementation of `getRangesForId`. See the
 // documentation there.
 template <typename RandomIt, typename Value>
 inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForDouble(
     RandomIt begin, RandomIt end, Value value, Comparison comparison) {
   std::tie(begin, end) = getRangeForDatatype(begin, end, Datatype::Double);
-  if (std::is_floating_point_v<Value> && std::isnan(value)) {
+  if (isNan(value)) {
     // NaN compares "not equal" to all values, even to NaN itself.
     if (comparison == Comparison::NE) {
       return {{begin, end}};
@@ -245,7 +256,7 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForInt(
     Comparison comparison = Comparison::EQ) {
   std::tie(begin, end) = getRangeForDatatype(begin, end, Datatype::Int);
 
-  if (std::is_floating_point_v<Value> && std::isnan(value)) {
+  if (isNan(value)) {
     // NaN compares "not equal" to all values, even to NaN itself.
     if (comparison == Comparison::NE) {
       return {{begin, end}};
@@ -289,11 +300,37 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForInt(
 // This function is part of the implementation of `getRangesForId`. See the
 // documentation there.
 template <typename RandomIt, typename Value>
-inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForIntsAndDoubles(
+inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForDecimal(
+    RandomIt begin, RandomIt end, Value value, Comparison comparison) {
+  std::tie(begin, end) = getRangeForDatatype(begin, end, Datatype::Decimal);
+  if (isNan(value)) {
+    // NaN compares "not equal" to all values, even to NaN itself.
+    if (comparison == Comparison::NE) {
+      return {{begin, end}};
+    } else {
+      return {};
+    }
+  }
+  // The order of the bits is the numeric order of the decimals.
+  RangeFilter<RandomIt> rangeFilter{comparison};
+  auto [eqBegin, eqEnd] = std::equal_range(
+      begin, end, value, makeSymmetricComparator(&ValueId::getDecimal));
+  rangeFilter.addSmaller(begin, eqBegin);
+  rangeFilter.addEqual(eqBegin, eqEnd);
+  rangeFilter.addGreater(eqEnd, end);
+  return std::move(rangeFilter).getResult();
+}
+
+// This function is part of the implementation of `getRangesForId`. See the
+// documentation there.
+template <typename RandomIt, typename Value>
+inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForNumericTypes(
     RandomIt begin, RandomIt end, Value value, Comparison comparison) {
   auto result = getRangesForDouble(begin, end, value, comparison);
   auto resultInt = getRangesForInt(begin, end, value, comparison);
+  auto resultDecimal = getRangesForDecimal(begin, end, value, comparison);
   result.insert(result.end(), resultInt.begin(), resultInt.end());
+  result.insert(result.end(), resultDecimal.begin(), resultDecimal.end());
   return result;
 }
 
@@ -377,11 +414,14 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForId(
   // This lambda enforces the invariants `non-empty` and `sorted`.
   switch (valueId.getDatatype()) {
     case Datatype::Double:
-      return detail::simplifyRanges(detail::getRangesForIntsAndDoubles(
+      return detail::simplifyRanges(detail::getRangesForNumericTypes(
           begin, end, valueId.getDouble(), comparison));
     case Datatype::Int:
-      return detail::simplifyRanges(detail::getRangesForIntsAndDoubles(
+      return detail::simplifyRanges(detail::getRangesForNumericTypes(
           begin, end, valueId.getInt(), comparison));
+    case Datatype::Decimal:
+      return detail::simplifyRanges(detail::getRangesForNumericTypes(
+          begin, end, valueId.getDecimal(), comparison));
     case Datatype::Undefined:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
@@ -389,7 +429,10 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForId(
     case Datatype::TextRecordIndex:
     case Datatype::Bool:
     case Datatype::Date:
-      // For `Date` the trivial comparison via bits is also correct.
+    case Datatype::GeoPoint:
+    case Datatype::ShortString:
+      // For `Date`, `GeoPoint` and `ShortString` the trivial comparison via
+      // bits is also correct.
       return detail::simplifyRanges(
           detail::getRangesForIndexTypes(begin, end, valueId, comparison));
   }
@@ -417,6 +460,9 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForEqualIds(
     case Datatype::Bool:
     case Datatype::Undefined:
     case Datatype::Date:
+    case Datatype::GeoPoint:
+    case Datatype::Decimal:
+    case Datatype::ShortString:
       AD_FAIL();
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
@@ -435,7 +481,8 @@ namespace detail {
 // standard) which we currently handle by all the comparisons returning `false`.
 inline bool areTypesCompatible(Datatype typeA, Datatype typeB) {
   auto isNumeric = [](Datatype type) {
-    return type == Datatype::Double || type == Datatype::Int;
+    return type == Datatype::Double || type == Datatype::Int ||
+           type == Datatype::Decimal;
   };
   auto isUndefined = [](Datatype type) { return type == Datatype::Undefined; };
   // Note: Undefined values cannot be compared to other undefined values.
@@ -443,6 +490,16 @@ inline bool areTypesCompatible(Datatype typeA, Datatype typeB) {
          ((typeA == typeB) || (isNumeric(typeA) && isNumeric(typeB)));
 }
 
+// The datatype that is used in place of `type` when comparing incompatible
+// datatypes in the `CompareByType` mode. All numeric types are compared as if
+// they were `Int`s, otherwise the order would not be transitive: a `Decimal`
+// can be smaller than an `Int` (by value), which is smaller than a
+// `VocabIndex` (by type), which is smaller than all `Decimal`s (by type).
+inline Datatype getDatatypeForOrdering(Datatype type) {
+  return type == Datatype::Double || type == Datatype::Decimal ? Datatype::Int
+                                                               : type;
+}
+
 // This function is part of the implementation of `compareIds` (see below).
 template <ComparisonForIncompatibleTypes comparisonForIncompatibleTypes =
               ComparisonForIncompatibleTypes::AlwaysUndef>
@@ -453,7 +510,8 @@ ComparisonResult compareIdsImpl(ValueId a, ValueId b, auto comparator) {
   if (!areTypesCompatible(typeA, typeB)) {
     using enum ComparisonForIncompatibleTypes;
     if constexpr (comparisonForIncompatibleTypes == CompareByType) {
-      return fromBool(comparator(a.getDatatype(), b.getDatatype()));
+      return fromBool(comparator(getDatatypeForOrdering(typeA),
+                                 getDatatypeForOrdering(typeB)));
     } else {
       static_assert(comparisonForIncompatibleTypes == AlwaysUndef);
       return ComparisonResult::Undef;
@@ -0,0 +1,290 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "index/ColumnStatistics.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "util/Exception.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/TransparentFunctors.h"
+
+using valueIdComparators::Comparison;
+using valueIdComparators::ComparisonResult;
+
+namespace {
+// The position of an `Id` on a number line for the interpolation within a
+// bucket. Numbers are placed by their value, all other `Id`s by their bits
+// (which for example for `VocabIndex`es is the order of the vocabulary).
+// Return `std::nullopt` if the `Id`s can't be placed on the same line.
+std::optional<std::pair<double, double>> getPositions(Id a, Id b) {
+  auto toNumber = [](Id id) -> std::optional<double> {
+    if (id.getDatatype() == Datatype::Int) {
+      return static_cast<double>(id.getInt());
+    } else if (id.getDatatype() == Datatype::Double) {
+      return id.getDouble();
+    }
+    return std::nullopt;
+  };
+  auto numberA = toNumber(a);
+  auto numberB = toNumber(b);
+  if (numberA.has_value() && numberB.has_value()) {
+    return std::pair{numberA.value(), numberB.value()};
+  }
+  if (a.getDatatype() == b.getDatatype()) {
+    return std::pair{static_cast<double>(a.getBits()),
+                     static_cast<double>(b.getBits())};
+  }
+  return std::nullopt;
+}
+
+// The fraction of the `bucket` with values that are at most `value`, assuming
+// that the values are uniformly distributed within the bucket. Return 0.5 if
+// that can't be determined.
+double fractionUpTo(const ColumnStatistics::Bucket& bucket, Id value) {
+  auto lower = getPositions(bucket.lowerBound_, value);
+  auto upper = getPositions(bucket.upperBound_, value);
+  if (!lower.has_value() || !upper.has_value() ||
+      lower->first >= upper->first) {
+    return 0.5;
+  }
+  double fraction =
+      (lower->second - lower->first) / (upper->first - lower->first);
+  return std::clamp(fraction, 0.0, 1.0);
+}
+
+// The fraction of the values of the `bucket` that are in the range
+// `[lowerBound, upperBound]` (by the order of the bits of the `Id`s, which is
+// the order of the permutations), assuming that the values are uniformly
+// distributed within the bucket.
+double fractionInRange(const ColumnStatistics::Bucket& bucket, Id lowerBound,
+                       Id upperBound) {
+  double lower = static_cast<double>(bucket.lowerBound_.getBits());
+  double upper = static_cast<double>(bucket.upperBound_.getBits());
+  double overlapLower =
+      std::max(lower, static_cast<double>(lowerBound.getBits()));
+  double overlapUpper =
+      std::min(upper, static_cast<double>(upperBound.getBits()));
+  return std::clamp((overlapUpper - overlapLower + 1) / (upper - lower + 1),
+                    0.0, 1.0);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+uint64_t ColumnStatistics::numRows() const {
+  uint64_t result = 0;
+  for (const auto& bucket : buckets_) {
+    result += bucket.numRows_;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+uint64_t ColumnStatistics::numDistinct() const {
+  uint64_t result = 0;
+  for (const auto& bucket : buckets_) {
+    result += bucket.numDistinct_;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+double ColumnStatistics::estimateSelectivity(Comparison comparison,
+                                             Id constant) const {
+  uint64_t totalNumRows = numRows();
+  if (totalNumRows == 0) {
+    return 0.0;
+  }
+  if (comparison == Comparison::NE) {
+    return 1.0 - estimateSelectivity(Comparison::EQ, constant);
+  }
+  using valueIdComparators::compareIds;
+  auto isTrue = [](ComparisonResult result) {
+    return result == ComparisonResult::True;
+  };
+  double numMatchingRows = 0;
+  for (const auto& bucket : buckets_) {
+    auto numRows = static_cast<double>(bucket.numRows_);
+    if (comparison == Comparison::EQ) {
+      // The constant is one of the distinct values of the bucket.
+      if (isTrue(compareIds(bucket.lowerBound_, constant, Comparison::LE)) &&
+          isTrue(compareIds(bucket.upperBound_, constant, Comparison::GE))) {
+        numMatchingRows += numRows / static_cast<double>(bucket.numDistinct_);
+      }
+      continue;
+    }
+    bool lowerMatches =
+        isTrue(compareIds(bucket.lowerBound_, constant, comparison));
+    bool upperMatches =
+        isTrue(compareIds(bucket.upperBound_, constant, comparison));
+    if (lowerMatches && upperMatches) {
+      numMatchingRows += numRows;
+    } else if (lowerMatches) {
+      numMatchingRows += numRows * fractionUpTo(bucket, constant);
+    } else if (upperMatches) {
+      numMatchingRows += numRows * (1.0 - fractionUpTo(bucket, constant));
+    }
+  }
+  return std::min(1.0, numMatchingRows / static_cast<double>(totalNumRows));
+}
+
+// _____________________________________________________________________________
+ColumnStatistics::JoinEstimate ColumnStatistics::estimateJoin(
+    const ColumnStatistics& a, const ColumnStatistics& b) {
+  JoinEstimate result{0.0, 0.0};
+  auto itA = a.buckets_.begin();
+  auto itB = b.buckets_.begin();
+  // Merge the two sorted sequences of buckets and estimate the size of the
+  // join for each overlapping pair of buckets.
+  while (itA != a.buckets_.end() && itB != b.buckets_.end()) {
+    Id lower = std::max(itA->lowerBound_, itB->lowerBound_);
+    Id upper = std::min(itA->upperBound_, itB->upperBound_);
+    if (lower <= upper) {
+      double fractionA = fractionInRange(*itA, lower, upper);
+      double fractionB = fractionInRange(*itB, lower, upper);
+      double numRowsA = static_cast<double>(itA->numRows_) * fractionA;
+      double numRowsB = static_cast<double>(itB->numRows_) * fractionB;
+      double numDistinctA =
+          std::max(1.0, static_cast<double>(itA->numDistinct_) * fractionA);
+      double numDistinctB =
+          std::max(1.0, static_cast<double>(itB->numDistinct_) * fractionB);
+      result.size_ +=
+          numRowsA * numRowsB / std::max(numDistinctA, numDistinctB);
+      result.numDistinct_ += std::min(numDistinctA, numDistinctB);
+    }
+    if (itA->upperBound_ < itB->upperBound_) {
+      ++itA;
+    } else {
+      ++itB;
+    }
+  }
+
+  // The sketches bound the number of common values independently of how the
+  // values are distributed within the buckets.
+  auto distinctUnion = a.distinctValues_;
+  distinctUnion.merge(b.distinctValues_);
+  double numCommon = a.distinctValues_.estimate() +
+                     b.distinctValues_.estimate() - distinctUnion.estimate();
+  numCommon = std::max(numCommon, 1.0);
+  if (result.numDistinct_ > numCommon) {
+    result.size_ *= numCommon / result.numDistinct_;
+    result.numDistinct_ = numCommon;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void ColumnStatistics::Builder::push(Id value) {
+  ++numRows_;
+  if (!buckets_.empty() && buckets_.back().upperBound_ == value) {
+    ++buckets_.back().numRows_;
+    return;
+  }
+  AD_EXPENSIVE_CHECK(buckets_.empty() || buckets_.back().upperBound_ < value);
+  distinctValues_.add(value.getBits());
+  if (!buckets_.empty() && buckets_.back().numRows_ < maxRowsPerBucket_) {
+    auto& bucket = buckets_.back();
+    bucket.upperBound_ = value;
+    ++bucket.numRows_;
+    ++bucket.numDistinct_;
+    return;
+  }
+  buckets_.push_back(Bucket{value, value, 1, 1});
+  if (buckets_.size() <= 2 * NUM_BUCKETS) {
+    return;
+  }
+  // Merge pairs of adjacent buckets, s.t. there are `NUM_BUCKETS + 1`
+  // buckets left, the last of which is the one that was just started.
+  for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+    const auto& first = buckets_[2 * i];
+    const auto& second = buckets_[2 * i + 1];
+    buckets_[i] =
+        Bucket{first.lowerBound_, second.upperBound_,
+               first.numRows_ + second.numRows_,
+               first.numDistinct_ + second.numDistinct_};
+  }
+  buckets_[NUM_BUCKETS] = buckets_.back();
+  buckets_.resize(NUM_BUCKETS + 1);
+  maxRowsPerBucket_ *= 2;
+}
+
+// _____________________________________________________________________________
+ColumnStatistics ColumnStatistics::Builder::finish() && {
+  ColumnStatistics result;
+  result.buckets_ = std::move(buckets_);
+  result.distinctValues_ = std::move(distinctValues_);
+  return result;
+}
+
+// _____________________________________________________________________________
+ColumnStatisticsFile::Writer::Writer(const std::string& filename)
+    : file_{filename, "w"} {}
+
+// _____________________________________________________________________________
+void ColumnStatisticsFile::Writer::add(Id col0Id,
+                                       const ColumnStatistics& statistics) {
+  // The end of the statistics of a relation is the beginning of those of the
+  // next relation in the table of contents, so they have to be added in order.
+  AD_CONTRACT_CHECK(tableOfContents_.empty() ||
+                    tableOfContents_.back().first < col0Id);
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << statistics;
+  const auto& bytes = serializer.data();
+  AD_CORRECTNESS_CHECK(file_.write(bytes.data(), bytes.size()) ==
+                       bytes.size());
+  tableOfContents_.emplace_back(col0Id, currentOffset_);
+  currentOffset_ += static_cast<off_t>(bytes.size());
+}
+
+// _____________________________________________________________________________
+void ColumnStatisticsFile::Writer::finish() {
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << tableOfContents_;
+  const auto& bytes = serializer.data();
+  AD_CORRECTNESS_CHECK(file_.write(bytes.data(), bytes.size()) ==
+                       bytes.size());
+  AD_CORRECTNESS_CHECK(file_.write(&currentOffset_, sizeof(currentOffset_)) ==
+                       sizeof(currentOffset_));
+  file_.close();
+}
+
+// _____________________________________________________________________________
+ColumnStatisticsFile::ColumnStatisticsFile(const std::string& filename)
+    : file_{filename, "r"} {
+  off_t endOfTableOfContents = file_.getLastOffset(&endOfStatistics_);
+  AD_CORRECTNESS_CHECK(endOfStatistics_ <= endOfTableOfContents);
+  std::vector<char> bytes(endOfTableOfContents - endOfStatistics_);
+  AD_CORRECTNESS_CHECK(file_.read(bytes.data(), bytes.size(),
+                                  endOfStatistics_) ==
+                       static_cast<ssize_t>(bytes.size()));
+  ad_utility::serialization::ByteBufferReadSerializer serializer{
+      std::move(bytes)};
+  serializer >> tableOfContents_;
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ColumnStatistics> ColumnStatisticsFile::get(
+    Id col0Id) const {
+  auto it = std::ranges::lower_bound(tableOfContents_, col0Id, {},
+                                     ad_utility::first);
+  if (it == tableOfContents_.end() || it->first != col0Id) {
+    return nullptr;
+  }
+  off_t end =
+      std::next(it) == tableOfContents_.end() ? endOfStatistics_
+                                              : std::next(it)->second;
+  off_t begin = it->second;
+  auto readStatistics = [this, begin, end]() {
+    std::vector<char> bytes(end - begin);
+    AD_CORRECTNESS_CHECK(file_.read(bytes.data(), bytes.size(), begin) ==
+                         static_cast<ssize_t>(bytes.size()));
+    ad_utility::serialization::ByteBufferReadSerializer serializer{
+        std::move(bytes)};
+    ColumnStatistics statistics;
+    serializer >> statistics;
+    return statistics;
+  };
+  return cache_.computeOnce(col0Id, readStatistics)._resultPointer;
+}
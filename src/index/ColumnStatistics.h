@@ -0,0 +1,165 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "global/Id.h"
+#include "global/ValueIdComparators.h"
+#include "util/Cache.h"
+#include "util/ConcurrentCache.h"
+#include "util/File.h"
+#include "util/HyperLogLog.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// Statistics about the values of one column of a relation in a permutation
+// (for example, the subjects of a predicate in PSO): an equi-depth histogram
+// (buckets with about the same number of rows, in the order of the
+// permutation) and a HyperLogLog sketch of the distinct values. They are
+// computed during the index build for relations with at least
+// `COLUMN_STATISTICS_MIN_NUM_ROWS` rows and are used by the query planner to
+// estimate the selectivity of filters and the size of joins more accurately
+// than with the average multiplicities of the `CompressedRelationMetadata`.
+class ColumnStatistics {
+ public:
+  // The (approximate) number of buckets of the histogram. The actual number is
+  // between this number and twice this number (or smaller if there are fewer
+  // distinct values).
+  static constexpr size_t NUM_BUCKETS = 64;
+
+  // The rows with values in `[lowerBound_, upperBound_]`. Equal values are
+  // always in the same bucket, so the numbers of distinct values are exact.
+  struct Bucket {
+    Id lowerBound_;
+    Id upperBound_;
+    uint64_t numRows_;
+    uint64_t numDistinct_;
+    bool operator==(const Bucket&) const = default;
+    friend std::true_type allowTrivialSerialization(Bucket, auto);
+  };
+
+  // The estimated size of a join and the estimated number of distinct values
+  // of the join column in the result.
+  struct JoinEstimate {
+    double size_;
+    double numDistinct_;
+  };
+
+ private:
+  std::vector<Bucket> buckets_;
+  ad_utility::HyperLogLog distinctValues_;
+
+ public:
+  const std::vector<Bucket>& buckets() const { return buckets_; }
+  const ad_utility::HyperLogLog& distinctValues() const {
+    return distinctValues_;
+  }
+  uint64_t numRows() const;
+  uint64_t numDistinct() const;
+
+  // The estimated fraction of the rows for which `value comparison constant`
+  // holds, where the comparison follows the semantics of SPARQL filters (see
+  // `valueIdComparators::compareIds`).
+  double estimateSelectivity(valueIdComparators::Comparison comparison,
+                             Id constant) const;
+
+  // Estimate the size of the join of two columns with the statistics `a` and
+  // `b`. Within the overlapping parts of the buckets, the values of the column
+  // with fewer distinct values are assumed to be contained in the other
+  // column. The number of common distinct values is additionally bounded by
+  // the estimate from the sketches (`|A| + |B| - |A u B|`), which captures
+  // columns whose values hardly overlap.
+  static JoinEstimate estimateJoin(const ColumnStatistics& a,
+                                   const ColumnStatistics& b);
+
+  bool operator==(const ColumnStatistics&) const = default;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(ColumnStatistics) {
+    serializer | arg.buckets_;
+    serializer | arg.distinctValues_;
+  }
+
+  // Build the statistics from the values of a column that are pushed in
+  // ascending order. The number of values doesn't have to be known in
+  // advance: the builder starts with small buckets and merges pairs of
+  // adjacent buckets whenever there are more than `2 * NUM_BUCKETS` buckets.
+  class Builder {
+   private:
+    std::vector<Bucket> buckets_;
+    ad_utility::HyperLogLog distinctValues_;
+    uint64_t maxRowsPerBucket_ = 1;
+    uint64_t numRows_ = 0;
+
+   public:
+    void push(Id value);
+    ColumnStatistics finish() &&;
+    // The number of values that were pushed.
+    uint64_t numRows() const { return numRows_; }
+  };
+};
+
+// The `ColumnStatistics` of the relations of a permutation, stored in a file
+// that consists of the serialized statistics of the relations, followed by the
+// table of contents (the `col0Id` and the offset of the statistics of each
+// relation), followed by the offset of the table of
+// contents. Only the table of contents is kept in memory, the statistics are
+// read from disk when they are requested, and the most recently used ones are
+// cached. The statistics of each relation are written as soon as the relation
+// is complete (see `Writer`), so they don't have to be kept in memory during
+// the index build either.
+class ColumnStatisticsFile {
+ public:
+  using TableOfContents = std::vector<std::pair<Id, off_t>>;
+
+  class Writer {
+   private:
+    ad_utility::File file_;
+    TableOfContents tableOfContents_;
+    off_t currentOffset_ = 0;
+
+   public:
+    explicit Writer(const std::string& filename);
+    // Add the `statistics` of the relation with the given `col0Id`, which has
+    // to be larger than the `col0Id` of all the previously added relations.
+    void add(Id col0Id, const ColumnStatistics& statistics);
+    // Write the table of contents and close the file.
+    void finish();
+  };
+
+ private:
+  // The number of `ColumnStatistics` that are cached. Each of them has a few
+  // kilobytes.
+  static constexpr size_t NUM_CACHED_STATISTICS = 1'000;
+
+  struct SizeGetter {
+    ad_utility::MemorySize operator()(const ColumnStatistics& statistics) const {
+      return ad_utility::MemorySize::bytes(
+          sizeof(ColumnStatistics) +
+          statistics.buckets().size() * sizeof(ColumnStatistics::Bucket) +
+          ad_utility::HyperLogLog::NUM_REGISTERS);
+    }
+  };
+
+  ad_utility::File file_;
+  TableOfContents tableOfContents_;
+  // The offset of the table of contents, which is the end of the statistics
+  // of the last relation.
+  off_t endOfStatistics_ = 0;
+  mutable ad_utility::ConcurrentCache<
+      ad_utility::HeapBasedLRUCache<Id, ColumnStatistics, SizeGetter>>
+      cache_{NUM_CACHED_STATISTICS};
+
+ public:
+  // Read the table of contents of the file with the given `filename`.
+  explicit ColumnStatisticsFile(const std::string& filename);
+
+  // Return the statistics of the relation with the given `col0Id`, or
+  // `nullptr` if there are none.
+  std::shared_ptr<const ColumnStatistics> get(Id col0Id) const;
+};
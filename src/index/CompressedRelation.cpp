@@ -4,6 +4,7 @@
 
 #include "CompressedRelation.h"
 
+#include <cmath>
 #include <ranges>
 
 #include "engine/idTable/IdTable.h"
@@ -13,6 +14,7 @@
 #include "util/Generator.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/OverloadCallOperator.h"
+#include "util/ResourceTracker.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -38,8 +40,12 @@ CompressedRelationReader::asyncParallelBlockGenerator(
       RuntimeParameters().get<"lazy-index-scan-queue-size">();
   auto blockIterator = beginBlock;
   std::mutex blockIteratorMutex;
+  // The blocks are read and decompressed by worker threads, the resources
+  // used by them are accounted to the consumer of this generator.
+  auto resourceTracker = ad_utility::ResourceTracker::getCurrent();
   auto readAndDecompressBlock =
       [&]() -> std::optional<std::pair<size_t, DecompressedBlock>> {
+    ad_utility::ResourceTracker::Scope resourceScope{resourceTracker};
     checkCancellation(cancellationHandle);
     std::unique_lock lock{blockIteratorMutex};
     if (blockIterator == endBlock) {
@@ -367,9 +373,14 @@ IdTable CompressedRelationReader::scan(
 
   // Insert the complete blocks from the middle in parallel
   if (beginBlock < endBlock) {
+    // The blocks are read by the thread that executes the `single` block
+    // and decompressed by the tasks, which might all be different from the
+    // calling thread, so they have to explicitly use its `ResourceTracker`.
+    auto resourceTracker = ad_utility::ResourceTracker::getCurrent();
 #pragma omp parallel
 #pragma omp single
-    for (; beginBlock < endBlock; ++beginBlock) {
+    for (ad_utility::ResourceTracker::Scope resourceScope{resourceTracker};
+         beginBlock < endBlock; ++beginBlock) {
       const auto& block = *beginBlock;
 
       // Read the block serially, only read the second column.
@@ -380,9 +391,11 @@ IdTable CompressedRelationReader::scan(
       // A lambda that owns the compressed block decompresses it to the
       // correct position in the result. It may safely be run in parallel
       auto decompressLambda = [rowIndexOfNextBlockStart, &block, &result,
+                               resourceTracker,
                                compressedBuffer =
                                    std::move(compressedBuffer)]() mutable {
         ad_utility::TimeBlockAndLog tbl{"Decompression a block"};
+        ad_utility::ResourceTracker::Scope resourceScope{resourceTracker};
 
         decompressBlockToExistingIdTable(compressedBuffer, block.numRows_,
                                          result, rowIndexOfNextBlockStart);
@@ -462,6 +475,233 @@ DecompressedBlock CompressedRelationReader::readPossiblyIncompleteBlock(
   return block;
 };
 
+// _____________________________________________________________________________
+DecompressedBlock CompressedRelationReader::readBlockOfRelation(
+    const CompressedRelationMetadata& relationMetadata,
+    const CompressedBlockMetadata& blockMetadata) const {
+  return readPossiblyIncompleteBlock(relationMetadata, std::nullopt,
+                                     blockMetadata, std::nullopt,
+                                     std::array<ColumnIndex, 2>{0, 1});
+}
+
+namespace {
+using valueIdComparators::Comparison;
+using valueIdComparators::ComparisonResult;
+using ValueComparison = CompressedRelationReader::ValueComparison;
+
+// Return true iff all the `Id`s between `first` and `last` (in the order of
+// their bits, which is the order of the permutations) are numbers that are
+// ordered by their value (ascending or descending), s.t. these numbers are
+// between `first` and `last` also by their value.
+bool isOrderedByValue(Id first, Id last) {
+  if (first.getDatatype() != last.getDatatype()) {
+    return false;
+  }
+  if (first.getDatatype() == Datatype::Int) {
+    return (first.getInt() < 0) == (last.getInt() < 0);
+  } else if (first.getDatatype() == Datatype::Double) {
+    double a = first.getDouble();
+    double b = last.getDouble();
+    return !std::isnan(a) && !std::isnan(b) &&
+           std::signbit(a) == std::signbit(b);
+  } else if (first.getDatatype() == Datatype::Decimal) {
+    // The order of the bits of decimals is their numeric order.
+    return true;
+  }
+  return false;
+}
+
+// If the `comparison` has the same result for all the `Id`s between `first`
+// and `last` (in the order of their bits), return this result, else return
+// `std::nullopt`.
+std::optional<bool> getConstantResult(Id first, Id last,
+                                      const ValueComparison& comparison) {
+  Id constant = comparison.constant_;
+  if (first.getDatatype() != last.getDatatype()) {
+    return std::nullopt;
+  }
+  // All the `Id`s in between have the same datatype, so if `first` can't be
+  // compared with the constant, then none of them can.
+  if (valueIdComparators::compareIds(first, constant, Comparison::EQ) ==
+      ComparisonResult::Undef) {
+    return false;
+  }
+  if (!isOrderedByValue(first, last)) {
+    return std::nullopt;
+  }
+  // If `first` and `last` are on the same side of the constant (or both equal
+  // to it), then so are all the values in between.
+  auto getSide = [constant](Id id) -> std::optional<Comparison> {
+    for (auto side : {Comparison::LT, Comparison::EQ, Comparison::GT}) {
+      if (valueIdComparators::compareIds(id, constant, side) ==
+          ComparisonResult::True) {
+        return side;
+      }
+    }
+    return std::nullopt;
+  };
+  auto side = getSide(first);
+  if (!side.has_value() || side != getSide(last)) {
+    return std::nullopt;
+  }
+  return valueIdComparators::compareIds(first, constant,
+                                        comparison.comparison_) ==
+         ComparisonResult::True;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+auto CompressedRelationReader::aggregateColumn(
+    const CompressedRelationMetadata& metadata, std::optional<Id> col1Id,
+    std::span<const CompressedBlockMetadata> blockMetadata,
+    const RelationSummary* summary,
+    std::span<const ValueComparison> comparisons,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const
+    -> ColumnAggregates {
+  // The summaries only exist for the `col1` of large relations, which are the
+  // only relations with blocks of their own.
+  auto relationBlocks =
+      getBlocksFromMetadata(metadata, std::nullopt, blockMetadata);
+  if (col1Id.has_value()) {
+    summary = nullptr;
+  }
+  AD_CORRECTNESS_CHECK(summary == nullptr ||
+                       summary->blocks().size() == relationBlocks.size());
+
+  ColumnAggregates result;
+  // The last value that was counted, to not count values that span several
+  // blocks more than once for the number of distinct values.
+  std::optional<Id> lastValue;
+  auto addMinAndMax = [&result](Id min, Id max) {
+    auto isLess = [](Id a, Id b) {
+      return valueIdComparators::compareIds<
+                 valueIdComparators::ComparisonForIncompatibleTypes::
+                     CompareByType>(a, b, Comparison::LT) ==
+             ComparisonResult::True;
+    };
+    if (result.min_.isUndefined() || isLess(min, result.min_)) {
+      result.min_ = min;
+    }
+    if (result.max_.isUndefined() || isLess(result.max_, max)) {
+      result.max_ = max;
+    }
+  };
+  auto addValue = [&](Id value) {
+    ++result.count_;
+    result.numDistinct_ += static_cast<uint64_t>(value != lastValue);
+    lastValue = value;
+    if (RelationSummary::isNumeric(value)) {
+      addMinAndMax(value, value);
+    } else {
+      result.allValuesAreNumeric_ = false;
+    }
+  };
+
+  // Add all the values of a block without reading it, if this is possible.
+  auto addCompleteBlock = [&](const CompressedBlockMetadata& block, Id first,
+                              Id last) {
+    const RelationSummary::BlockSummary* blockSummary =
+        summary == nullptr
+            ? nullptr
+            : &summary->blocks().at(&block - relationBlocks.data());
+    std::optional<uint64_t> numDistinct;
+    if (first == last) {
+      numDistinct = 1;
+    } else if (blockSummary != nullptr) {
+      numDistinct = blockSummary->numDistinct_;
+    }
+    // The datatypes `Int` and `Double` are adjacent in the order of the bits,
+    // but `Decimal` is not. So the block contains only numbers iff its first
+    // and last value are both an `Int` or a `Double`, or both a `Decimal`.
+    auto isIntOrDouble = [](Id id) {
+      return id.getDatatype() == Datatype::Int ||
+             id.getDatatype() == Datatype::Double;
+    };
+    bool isNumeric =
+        (isIntOrDouble(first) && isIntOrDouble(last)) ||
+        (first.getDatatype() == Datatype::Decimal &&
+         last.getDatatype() == Datatype::Decimal);
+    std::optional<std::pair<Id, Id>> minAndMax;
+    if (isNumeric && isOrderedByValue(first, last)) {
+      minAndMax = std::minmax(first, last, [](Id a, Id b) {
+        return valueIdComparators::compareIds(a, b, Comparison::LT) ==
+               ComparisonResult::True;
+      });
+    } else if (isNumeric && blockSummary != nullptr) {
+      minAndMax = std::pair{blockSummary->minNumeric_,
+                            blockSummary->maxNumeric_};
+    }
+    if (!numDistinct.has_value() || (isNumeric && !minAndMax.has_value())) {
+      return false;
+    }
+    result.count_ += block.numRows_;
+    result.numDistinct_ +=
+        numDistinct.value() - static_cast<uint64_t>(first == lastValue);
+    lastValue = last;
+    if (isNumeric) {
+      addMinAndMax(minAndMax->first, minAndMax->second);
+    } else {
+      result.allValuesAreNumeric_ = false;
+    }
+    return true;
+  };
+
+  for (const auto& block :
+       getBlocksFromMetadata(metadata, col1Id, blockMetadata)) {
+    checkCancellation(cancellationHandle);
+    const auto& firstTriple = block.firstTriple_;
+    const auto& lastTriple = block.lastTriple_;
+    bool containsOnlyRowsOfScan =
+        firstTriple.col0Id_ == metadata.col0Id_ &&
+        lastTriple.col0Id_ == metadata.col0Id_ &&
+        (!col1Id.has_value() || (firstTriple.col1Id_ == col1Id.value() &&
+                                 lastTriple.col1Id_ == col1Id.value()));
+    if (containsOnlyRowsOfScan) {
+      Id first = col1Id.has_value() ? firstTriple.col2Id_ : firstTriple.col1Id_;
+      Id last = col1Id.has_value() ? lastTriple.col2Id_ : lastTriple.col1Id_;
+      bool allHold = true;
+      bool noneHolds = false;
+      for (const auto& comparison : comparisons) {
+        auto constantResult = getConstantResult(first, last, comparison);
+        allHold = allHold && constantResult == true;
+        noneHolds = noneHolds || constantResult == false;
+      }
+      if (noneHolds) {
+        continue;
+      }
+      if (allHold && addCompleteBlock(block, first, last)) {
+        continue;
+      }
+    }
+
+    auto rows = readBlockOfRelation(metadata, block);
+    auto col1 = rows.getColumn(0);
+    auto values = col1Id.has_value() ? rows.getColumn(1) : col1;
+    size_t begin = 0;
+    size_t end = rows.numRows();
+    if (col1Id.has_value()) {
+      auto range = std::ranges::equal_range(col1, col1Id.value());
+      begin = range.begin() - col1.begin();
+      end = range.end() - col1.begin();
+    }
+    for (size_t i = begin; i < end; ++i) {
+      Id value = values[i];
+      bool allHold = std::ranges::all_of(
+          comparisons, [value](const ValueComparison& comparison) {
+            return valueIdComparators::compareIds(value, comparison.constant_,
+                                                  comparison.comparison_) ==
+                   ComparisonResult::True;
+          });
+      if (allHold) {
+        addValue(value);
+      }
+    }
+  }
+  AD_EXPENSIVE_CHECK(summary == nullptr || !comparisons.empty() ||
+                     result.numDistinct_ == summary->numDistinct());
+  return result;
+}
+
 // _____________________________________________________________________________
 size_t CompressedRelationReader::getResultSizeOfScan(
     const CompressedRelationMetadata& metadata, Id col1Id,
@@ -538,6 +778,7 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     ColumnIndicesRef columnIndices) const {
   CompressedBlock compressedBuffer;
   compressedBuffer.resize(columnIndices.size());
+  size_t numBytesRead = 0;
   // TODO<C++23> Use `std::views::zip`
   for (size_t i = 0; i < compressedBuffer.size(); ++i) {
     const auto& offset =
@@ -545,7 +786,9 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     auto& currentCol = compressedBuffer[i];
     currentCol.resize(offset.compressedSize_);
     file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+    numBytesRead += offset.compressedSize_;
   }
+  ad_utility::ResourceTracker::recordBlockRead(numBytesRead);
   return compressedBuffer;
 }
 
@@ -558,6 +801,7 @@ DecompressedBlock CompressedRelationReader::decompressBlock(
     auto col = decompressedBlock.getColumn(i);
     decompressColumn(compressedBlock[i], numRowsToRead, col.data());
   }
+  ad_utility::ResourceTracker::recordBlockDecompressed();
   return decompressedBlock;
 }
 
@@ -573,6 +817,7 @@ void CompressedRelationReader::decompressBlockToExistingIdTable(
     decompressColumn(compressedBlock[i], numRowsToRead,
                      col.data() + offsetInTable);
   }
+  ad_utility::ResourceTracker::recordBlockDecompressed();
 }
 
 // ____________________________________________________________________________
@@ -769,6 +1014,14 @@ CompressedRelationMetadata CompressedRelationWriter::addSmallRelation(
         relation.getColumn(i),
         smallRelationsBuffer_.getColumn(i).begin() + offsetInBlock);
   }
+  if (columnStatisticsWriter_.has_value() &&
+      numRows >= COLUMN_STATISTICS_MIN_NUM_ROWS) {
+    ColumnStatistics::Builder statistics;
+    std::ranges::for_each(relation.getColumn(0), [&statistics](Id id) {
+      statistics.push(id);
+    });
+    addColumnStatistics(col0Id, std::move(statistics));
+  }
   // Note: the multiplicity of the `col2` (where we set the dummy here) will be
   // set later in `createPermutationPair`.
   return {col0Id, numRows, computeMultiplicity(numRows, numDistinctC1),
@@ -785,6 +1038,11 @@ CompressedRelationMetadata CompressedRelationWriter::finishLargeRelation(
       computeMultiplicity(currentRelationPreviousSize_, numDistinctC1);
   md = CompressedRelationMetadata{currentCol0Id_, currentRelationPreviousSize_,
                                   multiplicityCol1, multiplicityCol1, offset};
+  addColumnStatistics(currentCol0Id_, std::move(currentColumnStatistics_));
+  currentColumnStatistics_ = ColumnStatistics::Builder{};
+  relationSummaries_.emplace_back(
+      currentCol0Id_, std::move(currentRelationSummary_).finish(numDistinctC1));
+  currentRelationSummary_ = RelationSummary::Builder{};
   currentRelationPreviousSize_ = 0;
   // The following is used in `addBlockForLargeRelation` to assert that
   // `finishLargeRelation` was called before a new relation was started.
@@ -792,6 +1050,15 @@ CompressedRelationMetadata CompressedRelationWriter::finishLargeRelation(
   return md;
 }
 
+// _____________________________________________________________________________
+void CompressedRelationWriter::addColumnStatistics(
+    Id col0Id, ColumnStatistics::Builder statistics) {
+  if (columnStatisticsWriter_.has_value() &&
+      statistics.numRows() >= COLUMN_STATISTICS_MIN_NUM_ROWS) {
+    columnStatisticsWriter_.value().add(col0Id, std::move(statistics).finish());
+  }
+}
+
 // _____________________________________________________________________________
 void CompressedRelationWriter::addBlockForLargeRelation(
     Id col0Id, std::shared_ptr<IdTable> relation) {
@@ -800,6 +1067,12 @@ void CompressedRelationWriter::addBlockForLargeRelation(
                        currentCol0Id_.isUndefined());
   currentCol0Id_ = col0Id;
   currentRelationPreviousSize_ += relation->numRows();
+  if (columnStatisticsWriter_.has_value()) {
+    std::ranges::for_each(relation->getColumn(0), [this](Id id) {
+      currentColumnStatistics_.push(id);
+    });
+  }
+  currentRelationSummary_.pushBlock(relation->getColumn(0));
   writeBufferedRelationsToSingleBlock();
   compressAndWriteBlock(currentCol0Id_, currentCol0Id_, std::move(relation));
 }
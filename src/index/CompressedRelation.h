@@ -11,7 +11,10 @@
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "global/ValueIdComparators.h"
+#include "index/ColumnStatistics.h"
 #include "index/ConstantsIndexBuilding.h"
+#include "index/RelationSummary.h"
 #include "util/Cache.h"
 #include "util/CancellationHandle.h"
 #include "util/ConcurrentCache.h"
@@ -20,6 +23,7 @@
 #include "util/MemorySize/MemorySize.h"
 #include "util/Serializer/ByteBufferSerializer.h"
 #include "util/Serializer/SerializeArray.h"
+#include "util/Serializer/SerializePair.h"
 #include "util/Serializer/SerializeVector.h"
 #include "util/Serializer/Serializer.h"
 #include "util/TaskQueue.h"
@@ -179,17 +183,35 @@ class CompressedRelationWriter {
 
   ad_utility::TaskQueue<false> blockWriteQueue_{20, 10};
 
+  // The statistics of the `col1` of the relation that is currently added. The
+  // statistics of the completely added relations with at least
+  // `COLUMN_STATISTICS_MIN_NUM_ROWS` rows are written to the
+  // `columnStatisticsWriter_` (if there is one, see `ColumnStatistics`).
+  ColumnStatistics::Builder currentColumnStatistics_;
+  std::optional<ColumnStatisticsFile::Writer> columnStatisticsWriter_;
+
+  // The same for the `RelationSummary`s, which exist for all large relations.
+  RelationSummary::Builder currentRelationSummary_;
+  std::vector<std::pair<Id, RelationSummary>> relationSummaries_;
+
   // A dummy value for multiplicities that can only later be determined.
   static constexpr float multiplicityDummy = 42.4242f;
 
  public:
-  /// Create using a filename, to which the relation data will be written.
+  /// Create using a filename, to which the relation data will be written. If
+  /// a `columnStatisticsFilename` is given, the `ColumnStatistics` of the large
+  /// relations are written to that file.
   explicit CompressedRelationWriter(
       size_t numColumns, ad_utility::File f,
-      ad_utility::MemorySize uncompressedBlocksizePerColumn)
+      ad_utility::MemorySize uncompressedBlocksizePerColumn,
+      std::optional<std::string> columnStatisticsFilename = std::nullopt)
       : outfile_{std::move(f)},
         numColumns_{numColumns},
-        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn} {}
+        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn} {
+    if (columnStatisticsFilename.has_value()) {
+      columnStatisticsWriter_.emplace(columnStatisticsFilename.value());
+    }
+  }
   // Two helper types used to make the interface of the function
   // `createPermutationPair` below safer and more explicit.
   using MetadataCallback =
@@ -238,6 +260,13 @@ class CompressedRelationWriter {
     return blocks;
   }
 
+  // The summaries of the `col1` of the large relations, sorted by the
+  // `col0Id`.
+  const std::vector<std::pair<Id, RelationSummary>>& relationSummaries()
+      const {
+    return relationSummaries_;
+  }
+
   // Compute the multiplicity of given the number of elements and the number of
   // distinct elements. It is basically `numElements / numDistinctElements` with
   // the following addition: the result will only be exactly `1.0` if
@@ -262,8 +291,16 @@ class CompressedRelationWriter {
     writeBufferedRelationsToSingleBlock();
     blockWriteQueue_.finish();
     outfile_.wlock()->close();
+    if (columnStatisticsWriter_.has_value()) {
+      columnStatisticsWriter_.value().finish();
+      columnStatisticsWriter_.reset();
+    }
   }
 
+  // Write the `statistics` of the relation with the given `col0Id` if they
+  // are needed (see `columnStatisticsWriter_`).
+  void addColumnStatistics(Id col0Id, ColumnStatistics::Builder statistics);
+
   // Compress the contents of `smallRelationsBuffer_` into a single
   // block and write it to outfile_. Update `currentBlockData_` with the meta
   // data of the written block. Then clear `smallRelationsBuffer_`.
@@ -469,6 +506,52 @@ class CompressedRelationReader {
   MetadataAndBlocks::FirstAndLastTriple getFirstAndLastTriple(
       const MetadataAndBlocks& metadataAndBlocks) const;
 
+  // Read and decompress the block that is identified by the `blockMetadata`,
+  // which must be one of the blocks of the relation of the `relationMetadata`
+  // (see `getBlocksFromMetadata`), and return the col1 and col2 of the triples
+  // of this relation in the block. This is used to read only some of the
+  // blocks of a relation, which are chosen while a query is processed (see
+  // `WorstCaseOptimalJoin`).
+  DecompressedBlock readBlockOfRelation(
+      const CompressedRelationMetadata& relationMetadata,
+      const CompressedBlockMetadata& blockMetadata) const;
+
+  // The comparison `value comparison_ constant_` of the values of a column
+  // with a constant, with the semantics of `valueIdComparators::compareIds`
+  // (values with a type that is incompatible with the constant never match).
+  struct ValueComparison {
+    valueIdComparators::Comparison comparison_;
+    Id constant_;
+  };
+
+  // The result of `aggregateColumn` (see below).
+  struct ColumnAggregates {
+    uint64_t count_ = 0;
+    uint64_t numDistinct_ = 0;
+    // Only if all the values are numeric (see `RelationSummary::isNumeric`),
+    // the `min_` and `max_` are the smallest and the largest value (in the
+    // order of `MIN` and `MAX` in SPARQL). They are undefined if there are no
+    // values.
+    bool allValuesAreNumeric_ = true;
+    Id min_ = Id::makeUndefined();
+    Id max_ = Id::makeUndefined();
+  };
+
+  // Compute the aggregates of the last column of the scan with the given
+  // `metadata` and `col1Id` (the same arguments as for `scan`), restricted to
+  // the values for which all the `comparisons` hold. The blocks that contain
+  // only rows of the scan are not read if the comparisons hold for all or
+  // none of their values (which can be decided from their first and last
+  // triple), and the other aggregates follow from their metadata and the
+  // `summary` of the relation (if it is not `nullptr`). All other blocks are
+  // read.
+  ColumnAggregates aggregateColumn(
+      const CompressedRelationMetadata& metadata, std::optional<Id> col1Id,
+      std::span<const CompressedBlockMetadata> blockMetadata,
+      const RelationSummary* summary,
+      std::span<const ValueComparison> comparisons,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
   // Get access to the underlying allocator
   const Allocator& allocator() const { return allocator_; }
 
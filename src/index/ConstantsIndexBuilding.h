@@ -95,3 +95,9 @@ inline size_t BUFFER_SIZE_PARTIAL_TO_GLOBAL_ID_MAPPINGS = 10'000;
 // infeasible. 250K seems to be a reasonable tradeoff here.
 constexpr ad_utility::MemorySize
     UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN = 250_kB;
+
+// The `ColumnStatistics` (histograms and distinct-count sketches) are only
+// computed for the relations of the permutations with at least this many rows.
+// Scans of smaller relations are cheap anyway. It is not const, so we can set
+// it to a much lower value for unit tests.
+inline size_t COLUMN_STATISTICS_MIN_NUM_ROWS = 10'000;
@@ -4,19 +4,192 @@
 
 #include "DocsDB.h"
 
+#include <zdict.h>
+
 #include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <limits>
+#include <numeric>
 
 #include "../global/Constants.h"
+#include "../util/Log.h"
+#include "../util/Serializer/FileSerializer.h"
+#include "../util/Serializer/SerializeVector.h"
+#include "absl/strings/str_cat.h"
+
+namespace {
+// Call `function(contextId, text)` for each line `<contextId>\t<text>` of the
+// `docsFileName`.
+void forEachDocument(const string& docsFileName, auto function) {
+  std::ifstream docsFile{docsFileName};
+  string line;
+  line.reserve(BUFFER_SIZE_DOCSFILE_LINE);
+  while (std::getline(docsFile, line)) {
+    std::string_view lineView = line;
+    size_t tab = lineView.find('\t');
+    uint64_t contextId = 0;
+    std::from_chars(lineView.data(), lineView.data() + tab, contextId);
+    function(contextId, lineView.substr(tab + 1));
+  }
+}
+
+// Train a zstd dictionary on the first documents of the `docsFileName`. Return
+// an empty dictionary if there are too few documents or the training fails.
+vector<char> trainDictionary(const string& docsFileName) {
+  string samples;
+  vector<size_t> sampleSizes;
+  forEachDocument(docsFileName, [&](uint64_t, std::string_view text) {
+    if (samples.size() < DocsDB::DICTIONARY_SAMPLE_SIZE && !text.empty()) {
+      samples.append(text);
+      sampleSizes.push_back(text.size());
+    }
+  });
+  if (samples.size() < 10 * DocsDB::MAX_DICTIONARY_SIZE) {
+    return {};
+  }
+  vector<char> dictionary(DocsDB::MAX_DICTIONARY_SIZE);
+  size_t dictionarySize =
+      ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+                            samples.data(), sampleSizes.data(),
+                            static_cast<unsigned>(sampleSizes.size()));
+  if (ZDICT_isError(dictionarySize)) {
+    LOG(INFO) << "Could not train a dictionary for the DocsDB ("
+              << ZDICT_getErrorName(dictionarySize)
+              << "), compressing without a dictionary" << std::endl;
+    return {};
+  }
+  dictionary.resize(dictionarySize);
+  return dictionary;
+}
+
+struct FreeCCtx {
+  void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+struct FreeCDict {
+  void operator()(ZSTD_CDict* dict) const { ZSTD_freeCDict(dict); }
+};
+struct FreeDCtx {
+  void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+void DocsDB::build(const string& docsFileName, const string& dbFileName) {
+  vector<char> dictionary = trainDictionary(docsFileName);
+  std::unique_ptr<ZSTD_CCtx, FreeCCtx> context{ZSTD_createCCtx()};
+  std::unique_ptr<ZSTD_CDict, FreeCDict> compressionDictionary;
+  if (!dictionary.empty()) {
+    compressionDictionary.reset(ZSTD_createCDict(
+        dictionary.data(), dictionary.size(), COMPRESSION_LEVEL));
+  }
+
+  ad_utility::File dbFile{dbFileName, "w"};
+  dbFile.write(MAGIC_BYTES.data(), MAGIC_BYTES.size());
+  if (!dictionary.empty()) {
+    dbFile.write(dictionary.data(), dictionary.size());
+  }
+  vector<off_t> blockOffsets{
+      static_cast<off_t>(MAGIC_BYTES.size() + dictionary.size())};
+  vector<off_t> blockStarts{0};
+
+  // The offsets are written to disk directly to avoid excessive use of RAM.
+  ad_utility::MmapVector<off_t> offsets(dbFileName + string{OFFSETS_SUFFIX},
+                                        ad_utility::CreateTag{});
+  off_t currentOffset = 0;
+  uint64_t currentContextId = 0;
+  string block;
+  vector<char> compressed;
+  auto writeBlock = [&]() {
+    if (block.empty()) {
+      return;
+    }
+    compressed.resize(ZSTD_compressBound(block.size()));
+    size_t compressedSize =
+        compressionDictionary
+            ? ZSTD_compress_usingCDict(context.get(), compressed.data(),
+                                       compressed.size(), block.data(),
+                                       block.size(),
+                                       compressionDictionary.get())
+            : ZSTD_compressCCtx(context.get(), compressed.data(),
+                                compressed.size(), block.data(), block.size(),
+                                COMPRESSION_LEVEL);
+    AD_CORRECTNESS_CHECK(!ZSTD_isError(compressedSize));
+    dbFile.write(compressed.data(), compressedSize);
+    blockOffsets.push_back(blockOffsets.back() +
+                           static_cast<off_t>(compressedSize));
+    blockStarts.push_back(currentOffset);
+    block.clear();
+  };
+
+  forEachDocument(docsFileName, [&](uint64_t contextId, std::string_view text) {
+    // Text records without a document get an empty text.
+    while (currentContextId < contextId) {
+      offsets.push_back(currentOffset);
+      currentContextId++;
+    }
+    offsets.push_back(currentOffset);
+    currentContextId++;
+    block.append(text);
+    currentOffset += static_cast<off_t>(text.size());
+    if (block.size() >= BLOCK_SIZE) {
+      writeBlock();
+    }
+  });
+  writeBlock();
+  offsets.push_back(currentOffset);
+
+  off_t startOfMetaData = blockOffsets.back();
+  ad_utility::serialization::FileWriteSerializer serializer{std::move(dbFile)};
+  serializer << blockOffsets;
+  serializer << blockStarts;
+  dbFile = std::move(serializer).file();
+  dbFile.write(&startOfMetaData, sizeof(startOfMetaData));
+  LOG(INFO) << "DocsDB: " << currentOffset << " bytes of text in "
+            << blockStarts.size() - 1 << " blocks, compressed to "
+            << startOfMetaData << " bytes (including a dictionary of "
+            << dictionary.size() << " bytes)" << std::endl;
+}
 
 // _____________________________________________________________________________
 void DocsDB::init(const string& fileName) {
   _dbFile.open(fileName.c_str(), "r");
   if (_dbFile.empty()) {
     _size = 0;
-  } else {
+    return;
+  }
+  string magic(MAGIC_BYTES.size(), '\0');
+  _isCompressed =
+      _dbFile.read(magic.data(), magic.size(), 0) ==
+          static_cast<ssize_t>(magic.size()) &&
+      magic == MAGIC_BYTES;
+  if (!_isCompressed) {
     off_t posLastOfft = _dbFile.getLastOffset(&_startOfOffsets);
     _size = (posLastOfft - _startOfOffsets) / sizeof(off_t);
+    return;
   }
+
+  off_t startOfMetaData;
+  _dbFile.getLastOffset(&startOfMetaData);
+  ad_utility::serialization::FileReadSerializer serializer{std::move(_dbFile)};
+  serializer.setSerializationPosition(startOfMetaData);
+  serializer >> _blockOffsets;
+  serializer >> _blockStarts;
+  _dbFile = std::move(serializer).file();
+  AD_CORRECTNESS_CHECK(!_blockOffsets.empty() &&
+                       _blockOffsets.size() == _blockStarts.size());
+
+  size_t dictionarySize = _blockOffsets.front() - MAGIC_BYTES.size();
+  if (dictionarySize > 0) {
+    vector<char> dictionary(dictionarySize);
+    _dbFile.read(dictionary.data(), dictionarySize, MAGIC_BYTES.size());
+    _dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionarySize));
+    AD_CORRECTNESS_CHECK(_dictionary != nullptr);
+  }
+  _offsets.open(fileName + string{OFFSETS_SUFFIX},
+                ad_utility::AccessPattern::Random);
+  AD_CORRECTNESS_CHECK(_offsets.size() > 0);
+  _size = _offsets.size() - 1;
 }
 
 // _____________________________________________________________________________
@@ -28,7 +201,80 @@ string DocsDB::getTextExcerpt(TextRecordIndex cid) const {
         "sure that"
         " a file .text.docsDB exists");
   }
+  if (!_isCompressed) {
+    return getTextExcerptLegacy(cid);
+  }
+  return std::move(getTextExcerpts(std::span{&cid, 1}).front());
+}
+
+// _____________________________________________________________________________
+vector<string> DocsDB::getTextExcerpts(
+    std::span<const TextRecordIndex> cids) const {
+  vector<string> result(cids.size());
+  if (!_isCompressed) {
+    for (size_t i = 0; i < cids.size(); ++i) {
+      if (cids[i].get() < _size) {
+        result[i] = getTextExcerptLegacy(cids[i]);
+      }
+    }
+    return result;
+  }
 
+  // Visit the `cids` in sorted order, then the documents from the same block
+  // are adjacent.
+  vector<size_t> order(cids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::sort(order, std::less{}, [&cids](size_t i) { return cids[i]; });
+
+  std::unique_ptr<ZSTD_DCtx, FreeDCtx> context{ZSTD_createDCtx()};
+  size_t currentBlockIndex = std::numeric_limits<size_t>::max();
+  string block;
+  for (size_t i : order) {
+    uint64_t cid = cids[i].get();
+    if (cid >= _size || _offsets[cid] == _offsets[cid + 1]) {
+      continue;
+    }
+    off_t from = _offsets[cid];
+    off_t to = _offsets[cid + 1];
+    // The block that contains `from`. Each document lies completely inside a
+    // single block.
+    size_t blockIndex = std::ranges::upper_bound(_blockStarts, from) -
+                        _blockStarts.begin() - 1;
+    if (blockIndex != currentBlockIndex) {
+      block = decompressBlock(blockIndex, context.get());
+      currentBlockIndex = blockIndex;
+    }
+    AD_CORRECTNESS_CHECK(to <= _blockStarts[blockIndex + 1]);
+    result[i] = block.substr(from - _blockStarts[blockIndex], to - from);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+string DocsDB::decompressBlock(size_t blockIndex, ZSTD_DCtx* context) const {
+  AD_CONTRACT_CHECK(blockIndex + 1 < _blockOffsets.size());
+  off_t compressedBegin = _blockOffsets[blockIndex];
+  size_t compressedSize = _blockOffsets[blockIndex + 1] - compressedBegin;
+  vector<char> compressed(compressedSize);
+  _dbFile.read(compressed.data(), compressedSize, compressedBegin);
+  string block(_blockStarts[blockIndex + 1] - _blockStarts[blockIndex], '\0');
+  size_t decompressedSize =
+      _dictionary ? ZSTD_decompress_usingDDict(context, block.data(),
+                                               block.size(), compressed.data(),
+                                               compressedSize,
+                                               _dictionary.get())
+                  : ZSTD_decompressDCtx(context, block.data(), block.size(),
+                                        compressed.data(), compressedSize);
+  if (ZSTD_isError(decompressedSize)) {
+    AD_THROW(absl::StrCat("Error while decompressing a block of the DocsDB: ",
+                          ZSTD_getErrorName(decompressedSize)));
+  }
+  AD_CORRECTNESS_CHECK(decompressedSize == block.size());
+  return block;
+}
+
+// _____________________________________________________________________________
+string DocsDB::getTextExcerptLegacy(TextRecordIndex cid) const {
   off_t ft[2];
   off_t& from = ft[0];
   off_t& to = ft[1];
@@ -3,23 +3,88 @@
 // Author: Björn Buchhold (buchhold@informatik.uni-freiburg.de)
 #pragma once
 
+#include <zstd.h>
+
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "../global/Id.h"
 #include "../util/File.h"
+#include "../util/MmapVector.h"
 
 using std::pair;
 using std::string;
 using std::vector;
 
+// The text records (documents) of the text index, stored in the file
+// `<index>.text.docsDB`. The documents are concatenated and split into blocks
+// of about `BLOCK_SIZE` bytes, each of which is compressed with zstd. As most
+// documents are short, all blocks are compressed with a shared dictionary that
+// is trained on a sample of the documents. The offsets of the documents in the
+// uncompressed text are stored in a separate file that is memory-mapped.
+//
+// Files in the legacy format (the uncompressed documents followed by their
+// offsets) can still be read.
 class DocsDB {
  public:
+  // The approximate size of the uncompressed blocks. Each block contains at
+  // least one complete document.
+  static constexpr size_t BLOCK_SIZE = 1 << 16;
+  static constexpr size_t MAX_DICTIONARY_SIZE = 110 * 1024;
+  // The dictionary is trained on (at most) this many bytes from the beginning
+  // of the documents. Smaller collections are compressed without a dictionary.
+  static constexpr size_t DICTIONARY_SAMPLE_SIZE = 100 * MAX_DICTIONARY_SIZE;
+  static constexpr int COMPRESSION_LEVEL = 9;
+  // The first bytes of a DocsDB in the compressed format.
+  static constexpr std::string_view MAGIC_BYTES = "QLDOCSZ1";
+  static constexpr std::string_view OFFSETS_SUFFIX = ".offsets";
+
+  // Build a DocsDB with the name `dbFileName` from the `docsFileName`, which
+  // contains one line `<textRecordIndex>\t<text>` per document, sorted by the
+  // text record index.
+  static void build(const string& docsFileName, const string& dbFileName);
+
   void init(const string& fileName);
+
+  // The number of text records. Records without a document have an empty text.
+  size_t size() const { return _size; }
+
   string getTextExcerpt(TextRecordIndex cid) const;
 
+  // Return the texts of all the `cids` (in the same order). Each block of the
+  // DocsDB is decompressed at most once, so this is much cheaper than calling
+  // `getTextExcerpt` for each of the `cids`. Indices that are out of range
+  // yield an empty text.
+  vector<string> getTextExcerpts(std::span<const TextRecordIndex> cids) const;
+
+ private:
+  struct FreeDDict {
+    void operator()(ZSTD_DDict* dict) const { ZSTD_freeDDict(dict); }
+  };
+
+  // Read the text of the `cid` from a DocsDB in the legacy format.
+  string getTextExcerptLegacy(TextRecordIndex cid) const;
+
+  // Decompress the block with the given index.
+  string decompressBlock(size_t blockIndex, ZSTD_DCtx* context) const;
+
   mutable ad_utility::File _dbFile;
-  off_t _startOfOffsets;
   size_t _size = 0;
+  bool _isCompressed = false;
+
+  // Only used for the legacy format.
+  off_t _startOfOffsets = 0;
+
+  // The offsets of the documents in the uncompressed text (one more than the
+  // number of text records).
+  ad_utility::MmapVectorView<off_t> _offsets;
+  // The offsets of the compressed blocks in the file, and the offsets of the
+  // blocks in the uncompressed text (one more than the number of blocks each).
+  vector<off_t> _blockOffsets;
+  vector<off_t> _blockStarts;
+  std::unique_ptr<ZSTD_DDict, FreeDDict> _dictionary;
 };
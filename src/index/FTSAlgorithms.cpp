@@ -4,8 +4,11 @@
 
 #include "./FTSAlgorithms.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
+#include <numeric>
+#include <optional>
 #include <set>
 #include <utility>
 
@@ -15,6 +18,31 @@
 
 using std::pair;
 
+namespace {
+// Return the smallest index `>= i` of an element of the sorted `v` that is not
+// less than `value` (or `v.size()` if there is no such element). First searches
+// exponentially, then binary. This is as fast as a linear search when the
+// result is close to `i`, but only logarithmic in the distance otherwise,
+// which makes intersections of lists with very different sizes much faster.
+template <typename T>
+size_t gallop(const vector<T>& v, size_t i, const T& value) {
+  if (i >= v.size() || !(v[i] < value)) {
+    return i;
+  }
+  // Invariant: `v[lower] < value`.
+  size_t lower = i;
+  size_t step = 1;
+  while (lower + step < v.size() && v[lower + step] < value) {
+    lower += step;
+    step *= 2;
+  }
+  size_t upper = std::min(lower + step, v.size());
+  return static_cast<size_t>(
+      std::lower_bound(v.begin() + lower + 1, v.begin() + upper, value) -
+      v.begin());
+}
+}  // namespace
+
 // _____________________________________________________________________________
 Index::WordEntityPostings FTSAlgorithms::filterByRangeWep(
     const IdRange<WordVocabIndex>& idRange,
@@ -133,17 +161,13 @@ Index::WordEntityPostings FTSAlgorithms::crossIntersect(
   size_t j = 0;
 
   while (i < matchingContextsWep.cids_.size() && j < eBlockWep.cids_.size()) {
-    while (matchingContextsWep.cids_[i] < eBlockWep.cids_[j]) {
-      ++i;
-      if (i >= matchingContextsWep.cids_.size()) {
-        return resultWep;
-      }
+    i = gallop(matchingContextsWep.cids_, i, eBlockWep.cids_[j]);
+    if (i >= matchingContextsWep.cids_.size()) {
+      return resultWep;
     }
-    while (eBlockWep.cids_[j] < matchingContextsWep.cids_[i]) {
-      ++j;
-      if (j >= eBlockWep.cids_.size()) {
-        return resultWep;
-      }
+    j = gallop(eBlockWep.cids_, j, matchingContextsWep.cids_[i]);
+    if (j >= eBlockWep.cids_.size()) {
+      return resultWep;
     }
     while (matchingContextsWep.cids_[i] == eBlockWep.cids_[j]) {
       size_t k = 0;
@@ -169,6 +193,165 @@ Index::WordEntityPostings FTSAlgorithms::crossIntersect(
   return resultWep;
 }
 
+// _____________________________________________________________________________
+Index::WordEntityPostings FTSAlgorithms::blockMaxTopK(
+    const vector<Score>& chunkMaxScores, size_t k,
+    const std::function<WordEntityPostings(size_t)>& readChunk) {
+  WordEntityPostings resultWep;
+  if (k == 0) {
+    return resultWep;
+  }
+  vector<size_t> chunkOrder(chunkMaxScores.size());
+  std::iota(chunkOrder.begin(), chunkOrder.end(), 0);
+  std::ranges::stable_sort(chunkOrder, std::greater{},
+                           [&](size_t i) { return chunkMaxScores[i]; });
+
+  // The chunks that have been read, and a min-heap of the best `k` postings
+  // found so far. A posting is identified by its chunk and its position in
+  // that chunk.
+  struct Candidate {
+    Score score_;
+    size_t chunk_;
+    size_t position_;
+  };
+  auto higherScore = [](const Candidate& a, const Candidate& b) {
+    return a.score_ > b.score_;
+  };
+  ad_utility::HashMap<size_t, WordEntityPostings> readChunks;
+  vector<Candidate> heap;
+  size_t nofChunksRead = 0;
+  for (size_t chunk : chunkOrder) {
+    if (heap.size() == k && heap.front().score_ >= chunkMaxScores[chunk]) {
+      // No posting of this or any of the remaining chunks can make it into
+      // the result.
+      break;
+    }
+    const auto& wep = readChunks[chunk] = readChunk(chunk);
+    ++nofChunksRead;
+    for (size_t i = 0; i < wep.scores_.size(); ++i) {
+      AD_CORRECTNESS_CHECK(wep.scores_[i] <= chunkMaxScores[chunk]);
+      if (heap.size() < k) {
+        heap.push_back({wep.scores_[i], chunk, i});
+        std::ranges::push_heap(heap, higherScore);
+      } else if (wep.scores_[i] > heap.front().score_) {
+        std::ranges::pop_heap(heap, higherScore);
+        heap.back() = {wep.scores_[i], chunk, i};
+        std::ranges::push_heap(heap, higherScore);
+      }
+    }
+  }
+  LOG(DEBUG) << "Block-max top-k: read " << nofChunksRead << " of "
+             << chunkMaxScores.size() << " chunks\n";
+
+  // The chunks and the postings within a chunk are sorted by cid.
+  std::ranges::sort(heap, [](const Candidate& a, const Candidate& b) {
+    return std::tie(a.chunk_, a.position_) < std::tie(b.chunk_, b.position_);
+  });
+  for (const Candidate& candidate : heap) {
+    const auto& wep = readChunks.at(candidate.chunk_);
+    resultWep.cids_.push_back(wep.cids_[candidate.position_]);
+    resultWep.scores_.push_back(wep.scores_[candidate.position_]);
+    if (!wep.wids_.at(0).empty()) {
+      resultWep.wids_.at(0).push_back(wep.wids_.at(0)[candidate.position_]);
+    }
+    if (!wep.eids_.empty()) {
+      resultWep.eids_.push_back(wep.eids_[candidate.position_]);
+    }
+  }
+  return resultWep;
+}
+
+// _____________________________________________________________________________
+Index::WordEntityPostings FTSAlgorithms::takeTopKContexts(
+    WordEntityPostings wep, size_t k) {
+  if (wep.cids_.size() <= k) {
+    return wep;
+  }
+  vector<size_t> positions(wep.cids_.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  std::ranges::nth_element(positions, positions.begin() + k, std::greater{},
+                           [&wep](size_t i) { return wep.scores_[i]; });
+  positions.resize(k);
+  std::ranges::sort(positions);
+
+  WordEntityPostings resultWep;
+  resultWep.wids_.resize(wep.wids_.size());
+  for (size_t i : positions) {
+    resultWep.cids_.push_back(wep.cids_[i]);
+    resultWep.scores_.push_back(wep.scores_[i]);
+    for (size_t j = 0; j < wep.wids_.size(); ++j) {
+      if (!wep.wids_[j].empty()) {
+        resultWep.wids_[j].push_back(wep.wids_[j][i]);
+      }
+    }
+    if (!wep.eids_.empty()) {
+      resultWep.eids_.push_back(wep.eids_[i]);
+    }
+  }
+  return resultWep;
+}
+
+// _____________________________________________________________________________
+Index::WordEntityPostings FTSAlgorithms::blockMaxCrossIntersect(
+    const WordEntityPostings& matchingContextsWep,
+    const vector<Score>& chunkMaxScores, size_t k,
+    const std::function<WordEntityPostings(size_t)>& readChunk,
+    const std::function<vector<Score>(size_t)>& readScores) {
+  AD_CONTRACT_CHECK(k > 0);
+  WordEntityPostings resultWep;
+  // The best (at most `k`) contexts of each entity so far, and its last
+  // context. Like in `aggScoresAndTakeTopKContexts`, a context is only counted
+  // once per entity.
+  struct TopContexts {
+    std::set<std::pair<Score, TextRecordIndex>> contexts_;
+    std::optional<TextRecordIndex> lastContext_;
+  };
+  ad_utility::HashMap<Id, TopContexts> topContexts;
+  auto scoresAreNeeded = [&](const WordEntityPostings& chunk, Score maxScore) {
+    return std::ranges::any_of(chunk.eids_, [&](Id eid) {
+      auto it = topContexts.find(eid);
+      return it == topContexts.end() || it->second.contexts_.size() < k ||
+             it->second.contexts_.begin()->first < maxScore;
+    });
+  };
+
+  size_t nofChunksWithScores = 0;
+  for (size_t chunk = 0; chunk < chunkMaxScores.size(); ++chunk) {
+    WordEntityPostings eBlockWep = readChunk(chunk);
+    if (scoresAreNeeded(eBlockWep, chunkMaxScores[chunk])) {
+      eBlockWep.scores_ = readScores(chunk);
+      AD_CORRECTNESS_CHECK(eBlockWep.scores_.size() == eBlockWep.cids_.size());
+      ++nofChunksWithScores;
+    } else {
+      eBlockWep.scores_.assign(eBlockWep.cids_.size(), 0);
+    }
+    WordEntityPostings wep = crossIntersect(matchingContextsWep, eBlockWep);
+    for (size_t i = 0; i < wep.cids_.size(); ++i) {
+      auto& [contexts, lastContext] = topContexts[wep.eids_[i]];
+      if (lastContext == wep.cids_[i]) {
+        continue;
+      }
+      lastContext = wep.cids_[i];
+      if (contexts.size() < k || contexts.begin()->first < wep.scores_[i]) {
+        if (contexts.size() == k) {
+          contexts.erase(contexts.begin());
+        }
+        contexts.emplace(wep.scores_[i], wep.cids_[i]);
+      }
+    }
+    auto append = [](auto& target, const auto& source) {
+      target.insert(target.end(), source.begin(), source.end());
+    };
+    append(resultWep.cids_, wep.cids_);
+    append(resultWep.wids_.at(0), wep.wids_.at(0));
+    append(resultWep.eids_, wep.eids_);
+    append(resultWep.scores_, wep.scores_);
+  }
+  LOG(DEBUG) << "Block-max: read the scores of " << nofChunksWithScores
+             << " of " << chunkMaxScores.size() << " chunks\n";
+  return resultWep;
+}
+
 // _____________________________________________________________________________
 Index::WordEntityPostings FTSAlgorithms::crossIntersectKWay(
     const vector<WordEntityPostings>& wepVecs, vector<Id>* lastListEids) {
@@ -241,13 +424,8 @@ Index::WordEntityPostings FTSAlgorithms::crossIntersectKWay(
     if (nextIndices[currentList] == thisListSize) {
       break;
     }
-    while (wepVecs[currentList].cids_[nextIndices[currentList]] <
-           currentContext) {
-      nextIndices[currentList] += 1;
-      if (nextIndices[currentList] == thisListSize) {
-        break;
-      }
-    }
+    nextIndices[currentList] = gallop(wepVecs[currentList].cids_,
+                                      nextIndices[currentList], currentContext);
     if (nextIndices[currentList] == thisListSize) {
       break;
     }
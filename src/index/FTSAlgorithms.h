@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <functional>
 #include <vector>
 
 #include "../engine/IndexSequence.h"
@@ -86,6 +87,40 @@ class FTSAlgorithms {
   static WordEntityPostings crossIntersectKWay(
       const vector<WordEntityPostings>& wepVecs, vector<Id>* lastListEids);
 
+  // Block-max top-k: Return the `k` postings with the highest scores (ties are
+  // broken arbitrarily) of a list that is divided into chunks, sorted by
+  // cid. `chunkMaxScores[i]` must be an upper bound for the scores in chunk
+  // `i` and `readChunk(i)` must return the postings of chunk `i`. The chunks
+  // must be sorted by cid. They are read in the order of decreasing
+  // `chunkMaxScores`, and as soon as `k` postings have been found that have at
+  // least the maximal score of all the remaining chunks, the remaining chunks
+  // are not read at all. For a single list, this is what the WAND and
+  // Block-Max WAND algorithms (Ding and Suel, 2011) do.
+  static WordEntityPostings blockMaxTopK(
+      const vector<Score>& chunkMaxScores, size_t k,
+      const std::function<WordEntityPostings(size_t)>& readChunk);
+
+  // Return the `k` postings of the `wep` with the highest scores (ties are
+  // broken arbitrarily), sorted by cid like the `wep`. This is the same as
+  // `blockMaxTopK`, but for a list that has already been read completely.
+  static WordEntityPostings takeTopKContexts(WordEntityPostings wep, size_t k);
+
+  // Block-max pruning for `aggScoresAndTakeTopKContexts` with at most `k`
+  // contexts per entity: Return `crossIntersect(matchingContextsWep,
+  // eBlockWep)` for an entity list `eBlockWep` that is divided into chunks,
+  // sorted by cid. `readChunk(i)` must return the postings of chunk `i`
+  // without their scores, `readScores(i)` the scores of chunk `i` and
+  // `chunkMaxScores[i]` must be an upper bound for these scores. The scores of
+  // a chunk are only read if one of its entities has less than `k` contexts so
+  // far or if its `k`-th best score so far is less than this upper bound. All
+  // other postings can't be among the `k` best contexts of their entity, they
+  // get the score 0 (which doesn't change that).
+  static WordEntityPostings blockMaxCrossIntersect(
+      const WordEntityPostings& matchingContextsWep,
+      const vector<Score>& chunkMaxScores, size_t k,
+      const std::function<WordEntityPostings(size_t)>& readChunk,
+      const std::function<vector<Score>(size_t)>& readScores);
+
   // Writes the wep entries to an IdTable but at most k contexts per entity. The
   // rest gets discarded. Note that the contexts with the highest score get
   // selected.
@@ -77,11 +77,64 @@ std::optional<std::string> Index::idToOptionalString(WordVocabIndex id) const {
   return pimpl_->idToOptionalString(id);
 }
 
+// ____________________________________________________________________________
+std::vector<std::optional<std::string>> Index::idsToOptionalStrings(
+    std::span<const VocabIndex> ids) const {
+  return pimpl_->idsToOptionalStrings(ids);
+}
+
+// ____________________________________________________________________________
+std::shared_ptr<const VocabularyMatches> Index::getVocabularyMatches(
+    const std::string& cacheKey, const VocabularyFilter& filter,
+    bool onlyReadFromCache,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  return pimpl_->getVocabularyMatches(cacheKey, filter, onlyReadFromCache,
+                                      cancellationHandle);
+}
+
+// ____________________________________________________________________________
+std::optional<double> Index::getSubstringSelectivity(
+    const std::vector<std::string>& requiredSubstrings) const {
+  return pimpl_->getSubstringSelectivity(requiredSubstrings);
+}
+
+// ____________________________________________________________________________
+size_t Index::getVocabularySizeIncludingExternal() const {
+  return pimpl_->getVocabularySizeIncludingExternal();
+}
+
 // ____________________________________________________________________________
 bool Index::getId(const std::string& element, Id* id) const {
   return pimpl_->getId(element, id);
 }
 
+// ____________________________________________________________________________
+std::optional<int> Index::compareWithShortString(
+    Id a, Id b, const LocalVocab& localVocab) const {
+  AD_CONTRACT_CHECK(a.getDatatype() == Datatype::ShortString ||
+                    b.getDatatype() == Datatype::ShortString);
+  auto getString = [this, &localVocab](Id id) -> std::optional<std::string> {
+    switch (id.getDatatype()) {
+      case Datatype::ShortString:
+        return id.getShortString().toLiteral();
+      case Datatype::VocabIndex:
+        return idToOptionalString(id.getVocabIndex());
+      case Datatype::LocalVocabIndex:
+        return localVocab.getWord(id.getLocalVocabIndex());
+      default:
+        return std::nullopt;
+    }
+  };
+  auto stringA = getString(a);
+  auto stringB = getString(b);
+  if (!stringA.has_value() || !stringB.has_value()) {
+    return std::nullopt;
+  }
+  return getVocab().getCaseComparator().compare(
+      stringA.value(), stringB.value(),
+      TripleComponentComparator::Level::QUARTERNARY);
+}
+
 // ____________________________________________________________________________
 std::pair<Id, Id> Index::prefix_range(const std::string& prefix) const {
   return pimpl_->prefix_range(prefix);
@@ -138,9 +191,9 @@ size_t Index::getSizeEstimate(const std::string& words) const {
 }
 
 // ____________________________________________________________________________
-void Index::getContextListForWords(const std::string& words,
+void Index::getContextListForWords(const std::string& words, size_t limit,
                                    IdTable* result) const {
-  return pimpl_->callFixedGetContextListForWords(words, result);
+  return pimpl_->callFixedGetContextListForWords(words, limit, result);
 }
 
 // ____________________________________________________________________________
@@ -192,6 +245,12 @@ Index::WordEntityPostings Index::getEntityPostingsForTerm(
   return pimpl_->getEntityPostingsForTerm(term);
 }
 
+// ____________________________________________________________________________
+Index::WordEntityPostings Index::getTopKWordPostingsForTerm(
+    const std::string& term, size_t k) const {
+  return pimpl_->getTopKWordPostingsForTerm(term, k);
+}
+
 // ____________________________________________________________________________
 IdTable Index::getEntityMentionsForWord(
     const string& term,
@@ -209,6 +268,12 @@ std::string Index::getTextExcerpt(TextRecordIndex cid) const {
   return pimpl_->getTextExcerpt(cid);
 }
 
+// ____________________________________________________________________________
+std::vector<std::string> Index::getTextExcerpts(
+    std::span<const TextRecordIndex> cids) const {
+  return pimpl_->getTextExcerpts(cids);
+}
+
 // ____________________________________________________________________________
 float Index::getAverageNofEntityContexts() const {
   return pimpl_->getAverageNofEntityContexts();
@@ -235,6 +300,11 @@ void Index::setKeepTempFiles(bool keepTempFiles) {
   return pimpl_->setKeepTempFiles(keepTempFiles);
 }
 
+// ____________________________________________________________________________
+void Index::setBuildTrigramIndex(bool buildTrigramIndex) {
+  return pimpl_->setBuildTrigramIndex(buildTrigramIndex);
+}
+
 // ____________________________________________________________________________
 ad_utility::MemorySize& Index::memoryLimitIndexBuilding() {
   return pimpl_->memoryLimitIndexBuilding();
@@ -265,6 +335,16 @@ void Index::setPrefixCompression(bool compressed) {
   return pimpl_->setPrefixCompression(compressed);
 }
 
+// ____________________________________________________________________________
+void Index::setVocabularyType(VocabularyType type) {
+  return pimpl_->setVocabularyType(type);
+}
+
+// ____________________________________________________________________________
+void Index::setInputIsNTriples(bool inputIsNTriples) {
+  return pimpl_->setInputIsNTriples(inputIsNTriples);
+}
+
 // ____________________________________________________________________________
 void Index::setNumTriplesPerBatch(uint64_t numTriplesPerBatch) {
   return pimpl_->setNumTriplesPerBatch(numTriplesPerBatch);
@@ -281,6 +361,9 @@ Index::NumNormalAndInternal Index::numTriples() const {
   return pimpl_->numTriples();
 }
 
+// ____________________________________________________________________________
+uint64_t Index::getBuildId() const { return pimpl_->getBuildId(); }
+
 // ____________________________________________________________________________
 size_t Index::getNofTextRecords() const { return pimpl_->getNofTextRecords(); }
 
@@ -323,6 +406,13 @@ vector<float> Index::getMultiplicities(const TripleComponent& key,
   return pimpl_->getMultiplicities(key, p);
 }
 
+// ____________________________________________________________________________
+std::shared_ptr<const ColumnStatistics> Index::getColumnStatistics(
+    const TripleComponent& col0, Permutation::Enum permutation,
+    size_t column) const {
+  return pimpl_->getColumnStatistics(col0, permutation, column);
+}
+
 // ____________________________________________________________________________
 IdTable Index::scan(
     const TripleComponent& col0String,
@@ -6,8 +6,12 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "global/Id.h"
@@ -15,6 +19,7 @@
 #include "index/Permutation.h"
 #include "index/StringSortComparator.h"
 #include "index/Vocabulary.h"
+#include "index/VocabularyMatches.h"
 #include "parser/TripleComponent.h"
 #include "util/CancellationHandle.h"
 
@@ -127,8 +132,55 @@ class Index {
   [[nodiscard]] std::optional<std::string> idToOptionalString(
       WordVocabIndex id) const;
 
+  // Same as `idToOptionalString` for each of the `ids`, which have to be
+  // sorted, see `IndexImpl::idsToOptionalStrings`.
+  [[nodiscard]] std::vector<std::optional<std::string>> idsToOptionalStrings(
+      std::span<const VocabIndex> ids) const;
+
+  // A filter on the words of the vocabulary (as they are stored, e.g. with
+  // quotes and language tag), see `getVocabularyMatches`.
+  struct VocabularyFilter {
+    std::function<std::optional<bool>(std::string_view word)> filter_;
+    // Substrings (of the normalized content, ignoring the case of ASCII
+    // letters) that each word for which the `filter_` is true must contain.
+    // If nonempty, only the words that contain them are passed to the
+    // `filter_` when there is a trigram index.
+    std::vector<std::string> requiredSubstrings_{};
+    // If true, the `filter_` is undefined for all the words that are not
+    // literals, else it is false for the words that don't contain the
+    // `requiredSubstrings_`.
+    bool onlyLiterals_ = false;
+  };
+
+  // Return the result of the `filter` for all the words of the vocabulary.
+  // The result is cached under the `cacheKey`, which must uniquely identify
+  // the `filter`. If `onlyReadFromCache` is true and the result is not cached,
+  // `nullptr` is returned. The computation is aborted if the
+  // `cancellationHandle` is cancelled. See `IndexImpl::getVocabularyMatches`
+  // for details.
+  [[nodiscard]] std::shared_ptr<const VocabularyMatches> getVocabularyMatches(
+      const std::string& cacheKey, const VocabularyFilter& filter,
+      bool onlyReadFromCache,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
+  // See `IndexImpl::getSubstringSelectivity`.
+  [[nodiscard]] std::optional<double> getSubstringSelectivity(
+      const std::vector<std::string>& requiredSubstrings) const;
+
+  // The number of words in the vocabulary, including the externalized words.
+  [[nodiscard]] size_t getVocabularySizeIncludingExternal() const;
+
   bool getId(const std::string& element, Id* id) const;
 
+  // Compare two `Id`s at least one of which is a `ShortString` in the order of
+  // the vocabulary (the order of the `ShortString`s themselves is the bytewise
+  // order, see `ShortString`). The result is negative, zero, or positive (like
+  // for `strcmp`), or `std::nullopt` if one of the `Id`s is not a string (a
+  // `ShortString`, a `VocabIndex`, or a `LocalVocabIndex` from the
+  // `localVocab`).
+  [[nodiscard]] std::optional<int> compareWithShortString(
+      Id a, Id b, const LocalVocab& localVocab) const;
+
   [[nodiscard]] std::pair<Id, Id> prefix_range(const std::string& prefix) const;
 
   [[nodiscard]] const vector<PatternID>& getHasPattern() const;
@@ -164,7 +216,9 @@ class Index {
 
   [[nodiscard]] size_t getSizeEstimate(const std::string& words) const;
 
-  void getContextListForWords(const std::string& words, IdTable* result) const;
+  // The `limit` contexts with the highest scores that contain all the `words`.
+  void getContextListForWords(const std::string& words, size_t limit,
+                              IdTable* result) const;
 
   void getECListForWordsOneVar(const std::string& words, size_t limit,
                                IdTable* result) const;
@@ -195,6 +249,11 @@ class Index {
 
   WordEntityPostings getEntityPostingsForTerm(const std::string& term) const;
 
+  // The `k` word postings for `term` with the highest scores, sorted by
+  // textRecord. Uses the block-max scores of the text index to skip chunks.
+  WordEntityPostings getTopKWordPostingsForTerm(const std::string& term,
+                                                size_t k) const;
+
   IdTable getEntityMentionsForWord(
       const string& term,
       const ad_utility::AllocatorWithLimit<Id>& allocator) const;
@@ -203,6 +262,10 @@ class Index {
 
   [[nodiscard]] std::string getTextExcerpt(TextRecordIndex cid) const;
 
+  // Return the text excerpts of all the `cids`, see `DocsDB::getTextExcerpts`.
+  [[nodiscard]] std::vector<std::string> getTextExcerpts(
+      std::span<const TextRecordIndex> cids) const;
+
   // Only for debug reasons and external encoding tests.
   // Supply an empty vector to dump all lists above a size threshold.
   void dumpAsciiLists(const vector<std::string>& lists,
@@ -222,6 +285,10 @@ class Index {
 
   void setKeepTempFiles(bool keepTempFiles);
 
+  // Also build a trigram index over the vocabulary, which speeds up substring
+  // and regex filters (see `TrigramIndex`).
+  void setBuildTrigramIndex(bool buildTrigramIndex);
+
   ad_utility::MemorySize& memoryLimitIndexBuilding();
   const ad_utility::MemorySize& memoryLimitIndexBuilding() const;
 
@@ -233,6 +300,14 @@ class Index {
 
   void setPrefixCompression(bool compressed);
 
+  // The type of the internal vocabulary (see `VocabularyType`), the default is
+  // `PrefixCompressed`.
+  void setVocabularyType(VocabularyType type);
+
+  // If true, the input of `createFromFile` is N-Triples and the fast path of
+  // the `TurtleParser` for N-Triples lines is used.
+  void setInputIsNTriples(bool inputIsNTriples);
+
   void setNumTriplesPerBatch(uint64_t numTriplesPerBatch);
 
   const std::string& getTextName() const;
@@ -241,6 +316,9 @@ class Index {
 
   NumNormalAndInternal numTriples() const;
 
+  // A random identifier that is created when the index is built.
+  uint64_t getBuildId() const;
+
   size_t getNofTextRecords() const;
   size_t getNofWordPostings() const;
   size_t getNofEntityPostings() const;
@@ -258,6 +336,14 @@ class Index {
   // ___________________________________________________________________
   vector<float> getMultiplicities(Permutation::Enum p) const;
 
+  // Return the statistics of the values of the `column` (1 or 2) of the
+  // relation `col0` in the `permutation` (for example, of the objects of a
+  // predicate for `PSO` and `column == 2`), or `nullptr` if there are none
+  // (for example, because the relation is small). See `ColumnStatistics`.
+  std::shared_ptr<const ColumnStatistics> getColumnStatistics(
+      const TripleComponent& col0, Permutation::Enum permutation,
+      size_t column) const;
+
   /**
    * @brief Perform a scan for one or two keys i.e. retrieve all YZ from the XYZ
    * permutation for specific key values of X if `col1String` is `nullopt`, and
@@ -69,10 +69,12 @@ int main(int argc, char** argv) {
   string settingsFile;
   string filetype;
   string inputFile;
+  string vocabularyType = "prefix-compressed";
   bool noPrefixCompression = false;
   bool noPatterns = false;
   bool onlyAddTextIndex = false;
   bool keepTemporaryFiles = false;
+  bool buildTrigramIndex = false;
   bool onlyPsoAndPos = false;
   bool addWordsFromLiterals = false;
   std::optional<ad_utility::MemorySize> stxxlMemory;
@@ -122,6 +124,16 @@ int main(int argc, char** argv) {
       "Disable the precomputation for `ql:has-predicate`.");
   add("no-compressed-vocabulary,N", po::bool_switch(&noPrefixCompression),
       "Do not apply prefix compression to the vocabulary (default: do apply).");
+  add("vocabulary-type", po::value(&vocabularyType),
+      "The representation of the internal vocabulary in RAM. Must be one of "
+      "[prefix-compressed|front-coded|front-coded-fsst] (default: "
+      "prefix-compressed). The front-coded vocabularies store blocks of "
+      "consecutive words with front coding, `front-coded-fsst` additionally "
+      "compresses them with a static symbol table.");
+  add("trigram-index", po::bool_switch(&buildTrigramIndex),
+      "Also build a trigram index over the vocabulary, which speeds up "
+      "filters with `REGEX`, `CONTAINS`, and `STRSTARTS` on large "
+      "vocabularies.");
   add("only-pso-and-pos-permutations,o", po::bool_switch(&onlyPsoAndPos),
       "Only build the PSO and POS permutations. This is faster, but then "
       "queries with predicate variables are not supported");
@@ -182,8 +194,10 @@ int main(int argc, char** argv) {
     index.usePatterns() = !noPatterns;
     index.setOnDiskBase(baseName);
     index.setKeepTempFiles(keepTemporaryFiles);
+    index.setBuildTrigramIndex(buildTrigramIndex);
     index.setSettingsFile(settingsFile);
     index.setPrefixCompression(!noPrefixCompression);
+    index.setVocabularyType(vocabularyTypeFromString(vocabularyType));
     index.loadAllPermutations() = !onlyPsoAndPos;
     // NOTE: If `onlyAddTextIndex` is true, we do not want to construct an
     // index, but we assume that it already exists. In particular, we then need
@@ -224,7 +238,9 @@ int main(int argc, char** argv) {
         index.createFromFile(inputFile);
       } else if (filetype == "nt") {
         LOG(DEBUG) << "Parsing uncompressed N-Triples from: " << inputFile
-                   << " (using the Turtle parser)" << std::endl;
+                   << " (using the N-Triples fast path of the Turtle parser)"
+                   << std::endl;
+        index.setInputIsNTriples(true);
         index.createFromFile(inputFile);
       } else {
         LOG(ERROR) << "File format must be one of: nt ttl" << std::endl;
@@ -35,6 +35,14 @@ struct LiteralsTokenizationDelimiter {
   }
 };
 
+// Return true iff the `chunk` of a context list contains at least one of the
+// `contexts`, which must be sorted.
+bool chunkContainsContext(const vector<TextRecordIndex>& contexts,
+                          const TextPostingChunkMetaData& chunk) {
+  auto it = std::ranges::lower_bound(contexts, chunk.firstContext_);
+  return it != contexts.end() && *it <= chunk.lastContext_;
+}
+
 }  // namespace
 
 // _____________________________________________________________________________
@@ -133,40 +141,7 @@ void IndexImpl::addTextFromContextFile(const string& contextFile,
 // _____________________________________________________________________________
 void IndexImpl::buildDocsDB(const string& docsFileName) const {
   LOG(INFO) << "Building DocsDB...\n";
-  std::ifstream docsFile{docsFileName};
-  std::ofstream ofs(onDiskBase_ + ".text.docsDB", std::ios_base::out);
-  // To avoid excessive use of RAM,
-  // we write the offsets to and stxxl:vector first;
-  stxxl::vector<off_t> offsets;
-  off_t currentOffset = 0;
-  uint64_t currentContextId = 0;
-  string line;
-  line.reserve(BUFFER_SIZE_DOCSFILE_LINE);
-  while (std::getline(docsFile, line)) {
-    std::string_view lineView = line;
-    size_t tab = lineView.find('\t');
-    uint64_t contextId = 0;
-    std::from_chars(lineView.data(), lineView.data() + tab, contextId);
-    lineView = lineView.substr(tab + 1);
-    ofs << lineView;
-    while (currentContextId < contextId) {
-      offsets.push_back(currentOffset);
-      currentContextId++;
-    }
-    offsets.push_back(currentOffset);
-    currentContextId++;
-    currentOffset += static_cast<off_t>(lineView.size());
-  }
-  offsets.push_back(currentOffset);
-
-  ofs.close();
-  // Now append the tmp file to the docsDB file.
-  ad_utility::File out(onDiskBase_ + ".text.docsDB", "a");
-  for (size_t i = 0; i < offsets.size(); ++i) {
-    off_t cur = offsets[i];
-    out.write(&cur, sizeof(cur));
-  }
-  out.close();
+  DocsDB::build(docsFileName, onDiskBase_ + ".text.docsDB");
   LOG(INFO) << "DocsDB done.\n";
 }
 
@@ -199,7 +174,7 @@ void IndexImpl::addTextFromOnDiskIndex() {
   if (f.good()) {
     f.close();
     docsDB_.init(string(onDiskBase_ + ".text.docsDB"));
-    LOG(INFO) << "Registered text records: #records = " << docsDB_._size
+    LOG(INFO) << "Registered text records: #records = " << docsDB_.size()
               << std::endl;
   } else {
     LOG(DEBUG) << "No file \"" << docsDbFileName
@@ -446,29 +421,66 @@ ContextListMetaData IndexImpl::writePostings(ad_utility::File& out,
   size_t bytes = 0;
 
   // Write context list:
+  vector<ad_utility::Simple8bSkipPointer> contextPointers;
   meta._startContextlist = currenttOffset_;
-  bytes = writeList(contextList, meta._nofElements, out);
+  bytes = writeList(contextList, meta._nofElements, out, &contextPointers);
   currenttOffset_ += bytes;
 
   // Write word list:
   // This can be skipped if we're writing classic lists and there
   // is only one distinct wordId in the block, since this Id is already
   // stored in the meta data.
+  vector<ad_utility::Simple8bSkipPointer> wordPointers;
   meta._startWordlist = currenttOffset_;
   if (!skipWordlistIfAllTheSame || wordCodebook.size() > 1) {
     currenttOffset_ += writeCodebook(wordCodebook, out);
-    bytes = writeList(wordList, meta._nofElements, out);
+    bytes = writeList(wordList, meta._nofElements, out, &wordPointers);
     currenttOffset_ += bytes;
   }
 
   // Write scores
+  vector<ad_utility::Simple8bSkipPointer> scorePointers;
   meta._startScorelist = currenttOffset_;
   currenttOffset_ += writeCodebook(scoreCodebook, out);
-  bytes = writeList(scoreList, meta._nofElements, out);
+  bytes = writeList(scoreList, meta._nofElements, out, &scorePointers);
   currenttOffset_ += bytes;
 
   meta._lastByte = currenttOffset_ - 1;
 
+  // Write the skip table directly after the score list.
+  constexpr size_t chunkSize = TextPostingChunkMetaData::CHUNK_SIZE;
+  vector<TextPostingChunkMetaData> skipTable(meta.getNofChunks());
+  for (size_t i = 0; i < skipTable.size(); ++i) {
+    auto& chunk = skipTable[i];
+    size_t begin = i * chunkSize;
+    size_t end = std::min(begin + chunkSize, postings.size());
+    chunk.firstContext_ = std::get<0>(postings[begin]);
+    chunk.lastContext_ = std::get<0>(postings[end - 1]);
+    chunk.contextPointer_ = contextPointers[i];
+    size_t firstInCodeword = chunk.contextPointer_.firstElementInCodeword_;
+    chunk.contextBase_ =
+        firstInCodeword == 0
+            ? 0
+            : std::get<0>(postings[firstInCodeword - 1]).get();
+    if (!wordPointers.empty()) {
+      chunk.wordPointer_ = wordPointers[i];
+    }
+    chunk.scorePointer_ = scorePointers[i];
+    for (size_t j = begin; j < end; ++j) {
+      chunk.maxScore_ = std::max(chunk.maxScore_, std::get<2>(postings[j]));
+    }
+  }
+  vector<TextPostingChunkMetaData::DiskFormat> skipTableOnDisk;
+  skipTableOnDisk.reserve(skipTable.size());
+  std::ranges::transform(skipTable, std::back_inserter(skipTableOnDisk),
+                         &TextPostingChunkMetaData::toDiskFormat);
+  size_t skipTableBytes =
+      skipTable.size() * TextPostingChunkMetaData::sizeOnDisk();
+  AD_CORRECTNESS_CHECK(out.write(skipTableOnDisk.data(), skipTableBytes) ==
+                       skipTableBytes);
+  currenttOffset_ += skipTableBytes;
+  AD_CORRECTNESS_CHECK(currenttOffset_ == meta.getOffsetAfterSkipTable());
+
   delete[] contextList;
   delete[] wordList;
   delete[] scoreList;
@@ -632,11 +644,16 @@ TextBlockIndex IndexImpl::getWordBlockId(WordIndex wordIndex) const {
 
 // _____________________________________________________________________________
 template <typename Numeric>
-size_t IndexImpl::writeList(Numeric* data, size_t nofElements,
-                            ad_utility::File& file) const {
+size_t IndexImpl::writeList(
+    Numeric* data, size_t nofElements, ad_utility::File& file,
+    vector<ad_utility::Simple8bSkipPointer>* skipPointers) const {
   if (nofElements > 0) {
     uint64_t* encoded = new uint64_t[nofElements];
     size_t size = ad_utility::Simple8bCode::encode(data, nofElements, encoded);
+    if (skipPointers != nullptr) {
+      *skipPointers = ad_utility::Simple8bCode::computeSkipPointers(
+          encoded, nofElements, TextPostingChunkMetaData::CHUNK_SIZE);
+    }
     size_t ret = file.write(encoded, size);
     AD_CONTRACT_CHECK(size == ret);
     delete[] encoded;
@@ -718,6 +735,7 @@ std::string_view IndexImpl::wordIdToString(WordIndex wordIndex) const {
 
 // ____________________________________________________________________________
 void IndexImpl::callFixedGetContextListForWords(const string& words,
+                                                size_t limit,
                                                 IdTable* result) const {
   int width = result->numColumns();
   ad_utility::callFixedSize(
@@ -725,12 +743,12 @@ void IndexImpl::callFixedGetContextListForWords(const string& words,
       [&]<int I>(auto&&... args) {
         getContextListForWords<I>(AD_FWD(args)...);
       },
-      words, result);
+      words, limit, result);
 }
 
 // _____________________________________________________________________________
 template <int WIDTH>
-void IndexImpl::getContextListForWords(const string& words,
+void IndexImpl::getContextListForWords(const string& words, size_t limit,
                                        IdTable* dynResult) const {
   LOG(DEBUG) << "In getContextListForWords...\n";
   // TODO vector can be of type std::string_view if called functions
@@ -751,6 +769,11 @@ void IndexImpl::getContextListForWords(const string& words,
       i++;
     }
     wep = FTSAlgorithms::crossIntersectKWay(wepVecs, nullptr);
+    wep = FTSAlgorithms::takeTopKContexts(std::move(wep), limit);
+  } else if (limit < TEXT_LIMIT_DEFAULT) {
+    // Only the `limit` contexts with the highest scores are needed, the
+    // block-max scores of the context list skip all the other chunks.
+    wep = getTopKWordPostingsForTerm(terms[0], limit);
   } else {
     wep = getWordPostingsForTermWep(terms[0]);
   }
@@ -876,6 +899,189 @@ IdTable IndexImpl::readWordEntityCl(
   return idTable;
 }
 
+// _____________________________________________________________________________
+vector<TextPostingChunkMetaData> IndexImpl::readSkipTable(
+    const ContextListMetaData& cl) const {
+  vector<TextPostingChunkMetaData::DiskFormat> skipTableOnDisk(
+      cl.getNofChunks());
+  size_t nofBytes =
+      skipTableOnDisk.size() * TextPostingChunkMetaData::sizeOnDisk();
+  if (nofBytes > 0) {
+    size_t ret = textIndexFile_.read(skipTableOnDisk.data(), nofBytes,
+                                     cl.getStartOfSkipTable());
+    AD_CORRECTNESS_CHECK(ret == nofBytes);
+  }
+  vector<TextPostingChunkMetaData> skipTable;
+  skipTable.reserve(skipTableOnDisk.size());
+  std::ranges::transform(skipTableOnDisk, std::back_inserter(skipTable),
+                         &TextPostingChunkMetaData::fromDiskFormat);
+  return skipTable;
+}
+
+// _____________________________________________________________________________
+vector<uint64_t> IndexImpl::readContextListChunks(
+    const ContextListMetaData& cl,
+    const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+    size_t endChunk, off_t from, off_t to,
+    ad_utility::Simple8bSkipPointer TextPostingChunkMetaData::*pointer,
+    std::optional<uint64_t> gapBase) const {
+  constexpr size_t chunkSize = TextPostingChunkMetaData::CHUNK_SIZE;
+  const size_t beginElement = beginChunk * chunkSize;
+  const size_t endElement = std::min(endChunk * chunkSize, cl._nofElements);
+  const auto& begin = skipTable[beginChunk].*pointer;
+  size_t nofCodewords = static_cast<size_t>(to - from) / sizeof(uint64_t);
+  size_t endCodeword =
+      endChunk < skipTable.size()
+          ? std::min(nofCodewords,
+                     (skipTable[endChunk].*pointer).codewordIndex_ + 1)
+          : nofCodewords;
+  auto elements =
+      readSimple8bCodewords(from, begin.codewordIndex_, endCodeword,
+                            endElement - begin.firstElementInCodeword_, gapBase);
+  // The elements of the first codeword before `beginElement` are needed to
+  // undo the gap encoding, but they are not part of the chunks.
+  elements.erase(elements.begin(),
+                 elements.begin() + static_cast<ptrdiff_t>(
+                                        beginElement -
+                                        begin.firstElementInCodeword_));
+  return elements;
+}
+
+// _____________________________________________________________________________
+Index::WordEntityPostings IndexImpl::readContextListChunksWep(
+    const TextBlockMetaData& tbmd, bool isEntityList,
+    const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+    size_t endChunk, bool readScores) const {
+  const ContextListMetaData& cl = isEntityList ? tbmd._entityCl : tbmd._cl;
+  AD_CONTRACT_CHECK(skipTable.size() == cl.getNofChunks());
+  AD_CONTRACT_CHECK(beginChunk <= endChunk && endChunk <= skipTable.size());
+  Index::WordEntityPostings wep;
+  if (beginChunk == endChunk) {
+    return wep;
+  }
+  constexpr size_t chunkSize = TextPostingChunkMetaData::CHUNK_SIZE;
+  const size_t nofElements =
+      std::min(endChunk * chunkSize, cl._nofElements) - beginChunk * chunkSize;
+
+  // Contexts: undo the gap encoding.
+  std::ranges::transform(
+      readContextListChunks(cl, skipTable, beginChunk, endChunk,
+                            cl._startContextlist, cl._startWordlist,
+                            &TextPostingChunkMetaData::contextPointer_,
+                            skipTable[beginChunk].contextBase_),
+      std::back_inserter(wep.cids_), &TextRecordIndex::make);
+
+  // Words or entities: undo the frequency encoding.
+  if (cl.hasMultipleWords()) {
+    auto [codebook, startOfCodewords] =
+        readCodebook<CompressionCode>(cl._startWordlist);
+    auto codes = readContextListChunks(
+        cl, skipTable, beginChunk, endChunk, startOfCodewords,
+        cl._startScorelist, &TextPostingChunkMetaData::wordPointer_);
+    if (isEntityList) {
+      wep.eids_.reserve(nofElements);
+      for (uint64_t code : codes) {
+        wep.eids_.push_back(
+            Id::makeFromVocabIndex(VocabIndex::make(codebook.at(code))));
+      }
+    } else {
+      auto& wids = wep.wids_.at(0);
+      wids.reserve(nofElements);
+      for (uint64_t code : codes) {
+        wids.push_back(codebook.at(code));
+      }
+    }
+  } else {
+    // The word list was skipped because all the postings have the same word.
+    AD_CORRECTNESS_CHECK(!isEntityList);
+    wep.wids_.at(0).assign(nofElements, tbmd._firstWordId);
+  }
+
+  if (readScores) {
+    wep.scores_ =
+        readContextListChunksScores(cl, skipTable, beginChunk, endChunk);
+  }
+  return wep;
+}
+
+// _____________________________________________________________________________
+vector<Score> IndexImpl::readContextListChunksScores(
+    const ContextListMetaData& cl,
+    const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+    size_t endChunk) const {
+  // Undo the frequency encoding.
+  auto [codebook, startOfCodewords] = readCodebook<Score>(cl._startScorelist);
+  auto codes = readContextListChunks(cl, skipTable, beginChunk, endChunk,
+                                     startOfCodewords, cl._lastByte + 1,
+                                     &TextPostingChunkMetaData::scorePointer_);
+  vector<Score> scores;
+  scores.reserve(codes.size());
+  for (uint64_t code : codes) {
+    scores.push_back(codebook.at(code));
+  }
+  return scores;
+}
+
+// _____________________________________________________________________________
+Index::WordEntityPostings IndexImpl::readWordEntityClWepForContexts(
+    const TextBlockMetaData& tbmd,
+    const vector<TextRecordIndex>& contexts) const {
+  Index::WordEntityPostings result;
+  if (contexts.empty()) {
+    return result;
+  }
+  auto skipTable = readSkipTable(tbmd._entityCl);
+  auto append = [&result](Index::WordEntityPostings&& wep) {
+    auto appendVector = [](auto& target, auto& source) {
+      target.insert(target.end(), source.begin(), source.end());
+    };
+    appendVector(result.cids_, wep.cids_);
+    appendVector(result.eids_, wep.eids_);
+    appendVector(result.scores_, wep.scores_);
+  };
+  // Read maximal runs of consecutive chunks that contain a matching context
+  // with a single read each.
+  size_t beginChunk = 0;
+  while (beginChunk < skipTable.size()) {
+    if (!chunkContainsContext(contexts, skipTable[beginChunk])) {
+      ++beginChunk;
+      continue;
+    }
+    size_t endChunk = beginChunk + 1;
+    while (endChunk < skipTable.size() &&
+           chunkContainsContext(contexts, skipTable[endChunk])) {
+      ++endChunk;
+    }
+    append(readContextListChunksWep(tbmd, true, skipTable, beginChunk,
+                                    endChunk));
+    beginChunk = endChunk;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+Index::WordEntityPostings IndexImpl::getTopKWordPostingsForTerm(
+    const string& wordOrPrefix, size_t k) const {
+  auto optionalTbmd = getTextBlockMetadataForWordOrPrefix(wordOrPrefix);
+  if (!optionalTbmd.has_value()) {
+    return {};
+  }
+  const auto& tbmd = optionalTbmd.value().tbmd_;
+  auto skipTable = readSkipTable(tbmd._cl);
+  vector<Score> maxScores;
+  std::ranges::transform(skipTable, std::back_inserter(maxScores),
+                         &TextPostingChunkMetaData::maxScore_);
+  auto readChunk = [&](size_t chunk) {
+    auto wep =
+        readContextListChunksWep(tbmd, false, skipTable, chunk, chunk + 1);
+    if (optionalTbmd.value().hasToBeFiltered_) {
+      wep = FTSAlgorithms::filterByRangeWep(optionalTbmd.value().idRange_, wep);
+    }
+    return wep;
+  };
+  return FTSAlgorithms::blockMaxTopK(maxScores, k, readChunk);
+}
+
 // _____________________________________________________________________________
 Index::WordEntityPostings IndexImpl::getWordPostingsForTermWep(
     const string& term) const {
@@ -991,7 +1197,14 @@ Index::WordEntityPostings IndexImpl::getContextEntityScoreListsForWords(
 void IndexImpl::getECListForWordsOneVar(const string& words, size_t limit,
                                         IdTable* result) const {
   LOG(DEBUG) << "In getECListForWords...\n";
-  Index::WordEntityPostings wep = getContextEntityScoreListsForWords(words);
+  // For a single word with a text limit, the block-max scores of the entity
+  // list are used to skip the scores that can't be among the `limit` best
+  // contexts of their entity.
+  bool useBlockMax =
+      words.find(' ') == string::npos && limit > 0 && limit < TEXT_LIMIT_DEFAULT;
+  Index::WordEntityPostings wep =
+      useBlockMax ? getTopKEntityPostingsForTerm(words, limit)
+                  : getContextEntityScoreListsForWords(words);
   int width = result->numColumns();
   CALL_FIXED_SIZE(width, FTSAlgorithms::aggScoresAndTakeTopKContexts, wep,
                   limit, result);
@@ -1106,12 +1319,47 @@ Index::WordEntityPostings IndexImpl::getEntityPostingsForTerm(
   Index::WordEntityPostings matchingContextsWep =
       getWordPostingsForTermWep(term);
 
-  // Read the full lists
-  Index::WordEntityPostings eBlockWep = readWordEntityClWep(tbmd);
+  // Only read the chunks of the entity list that contain a matching context.
+  Index::WordEntityPostings eBlockWep =
+      readWordEntityClWepForContexts(tbmd, matchingContextsWep.cids_);
   resultWep = FTSAlgorithms::crossIntersect(matchingContextsWep, eBlockWep);
   return resultWep;
 }
 
+// _____________________________________________________________________________
+Index::WordEntityPostings IndexImpl::getTopKEntityPostingsForTerm(
+    const string& term, size_t k) const {
+  auto optTbmd = getTextBlockMetadataForWordOrPrefix(term);
+  if (!optTbmd.has_value()) {
+    return {};
+  }
+  const auto& tbmd = optTbmd.value().tbmd_;
+  Index::WordEntityPostings matchingContextsWep =
+      getWordPostingsForTermWep(term);
+
+  // Like in `readWordEntityClWepForContexts`, only the chunks of the entity
+  // list that contain a matching context are read.
+  auto skipTable = readSkipTable(tbmd._entityCl);
+  vector<size_t> chunks;
+  vector<Score> maxScores;
+  for (size_t i = 0; i < skipTable.size(); ++i) {
+    if (chunkContainsContext(matchingContextsWep.cids_, skipTable[i])) {
+      chunks.push_back(i);
+      maxScores.push_back(skipTable[i].maxScore_);
+    }
+  }
+  auto readChunk = [&](size_t i) {
+    return readContextListChunksWep(tbmd, true, skipTable, chunks[i],
+                                    chunks[i] + 1, false);
+  };
+  auto readScores = [&](size_t i) {
+    return readContextListChunksScores(tbmd._entityCl, skipTable, chunks[i],
+                                       chunks[i] + 1);
+  };
+  return FTSAlgorithms::blockMaxCrossIntersect(matchingContextsWep, maxScores,
+                                               k, readChunk, readScores);
+}
+
 // _____________________________________________________________________________
 IdTable IndexImpl::getEntityMentionsForWord(
     const string& term,
@@ -1132,37 +1380,58 @@ vector<T> IndexImpl::readGapComprList(size_t nofElements, off_t from,
   LOG(DEBUG) << "Reading gap-encoded list from disk...\n";
   LOG(TRACE) << "NofElements: " << nofElements << ", from: " << from
              << ", nofBytes: " << nofBytes << '\n';
-  vector<T> result;
-  result.resize(nofElements + 250);
+  vector<uint64_t> contexts(nofElements + 250);
   uint64_t* encoded = new uint64_t[nofBytes / 8];
   textIndexFile_.read(encoded, nofBytes, from);
-  LOG(DEBUG) << "Decoding Simple8b code...\n";
-  ad_utility::Simple8bCode::decode(encoded, nofElements, result.data(),
-                                   makeFromUint64t);
-  LOG(DEBUG) << "Reverting gaps to actual IDs...\n";
-
-  // TODO<joka921> make this hack unnecessary, probably by a proper output
-  // iterator.
-  if constexpr (requires { T::make(0); }) {
-    uint64_t id = 0;
-    for (size_t i = 0; i < result.size(); ++i) {
-      id += result[i].get();
-      result[i] = T::make(id);
-    }
-  } else {
-    T id = 0;
-    for (size_t i = 0; i < result.size(); ++i) {
-      id += result[i];
-      result[i] = id;
-    }
-  }
-  result.resize(nofElements);
+  LOG(DEBUG) << "Decoding Simple8b code and reverting gaps to actual IDs...\n";
+  ad_utility::Simple8bCode::decodeGaps(encoded, nofElements, contexts.data());
+  vector<T> result;
+  result.reserve(nofElements);
+  std::transform(contexts.begin(), contexts.begin() + nofElements,
+                 std::back_inserter(result), makeFromUint64t);
   delete[] encoded;
   LOG(DEBUG) << "Done reading gap-encoded list. Size: " << result.size()
              << "\n";
   return result;
 }
 
+// _____________________________________________________________________________
+vector<uint64_t> IndexImpl::readSimple8bCodewords(
+    off_t from, size_t beginCodeword, size_t endCodeword, size_t nofElements,
+    std::optional<uint64_t> gapBase) const {
+  AD_CONTRACT_CHECK(beginCodeword <= endCodeword);
+  vector<uint64_t> encoded(endCodeword - beginCodeword);
+  size_t nofBytes = encoded.size() * sizeof(uint64_t);
+  size_t ret = textIndexFile_.read(
+      encoded.data(), nofBytes,
+      from + static_cast<off_t>(beginCodeword * sizeof(uint64_t)));
+  AD_CORRECTNESS_CHECK(ret == nofBytes);
+  // The decoding always writes complete codewords, see `Simple8bCode::decode`.
+  vector<uint64_t> result(nofElements + 250);
+  if (gapBase.has_value()) {
+    ad_utility::Simple8bCode::decodeGaps(encoded.data(), nofElements,
+                                         result.data(), gapBase.value());
+  } else {
+    ad_utility::Simple8bCode::decode(encoded.data(), nofElements,
+                                     result.data());
+  }
+  result.resize(nofElements);
+  return result;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+std::pair<vector<T>, off_t> IndexImpl::readCodebook(off_t from) const {
+  off_t nofCodebookBytes;
+  size_t ret = textIndexFile_.read(&nofCodebookBytes, sizeof(off_t), from);
+  AD_CORRECTNESS_CHECK(ret == sizeof(off_t));
+  from += sizeof(off_t);
+  vector<T> codebook(static_cast<size_t>(nofCodebookBytes) / sizeof(T));
+  ret = textIndexFile_.read(codebook.data(), nofCodebookBytes, from);
+  AD_CORRECTNESS_CHECK(ret == static_cast<size_t>(nofCodebookBytes));
+  return {std::move(codebook), from + nofCodebookBytes};
+}
+
 // _____________________________________________________________________________
 template <typename T, typename MakeFromUint64t>
 vector<T> IndexImpl::readFreqComprList(size_t nofElements, off_t from,
@@ -26,6 +26,7 @@
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/HashMap.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
+#include "util/Random.h"
 #include "util/Serializer/FileSerializer.h"
 #include "util/TupleHelpers.h"
 #include "util/TypeTraits.h"
@@ -79,19 +80,32 @@ void IndexImpl::compressInternalVocabularyIfSpecified(
   // hurt.
   string vocabFile = onDiskBase_ + INTERNAL_VOCAB_SUFFIX;
   string vocabFileTmp = onDiskBase_ + ".vocabularyTmp";
-  if (vocabPrefixCompressed_) {
+  if (usePrefixCompression()) {
     auto prefixFile = ad_utility::makeOfstream(onDiskBase_ + PREFIX_FILE);
     for (const auto& prefix : prefixes) {
       prefixFile << RdfEscaping::escapeNewlinesAndBackslashes(prefix)
                  << std::endl;
     }
   }
-  configurationJson_["prefixes"] = vocabPrefixCompressed_;
+  configurationJson_["prefixes"] = usePrefixCompression();
+  configurationJson_["vocabulary-type"] =
+      std::string{toString(vocabularyType_)};
   LOG(INFO) << "Writing compressed vocabulary to disk ..." << std::endl;
 
-  vocab_.buildCodebookForPrefixCompression(prefixes);
+  vocab_.setInternalVocabularyType(vocabularyType_);
+  std::optional<FsstCompressor> fsstCompressor;
+  if (vocabularyType_ == VocabularyType::PrefixCompressed) {
+    vocab_.buildCodebookForPrefixCompression(prefixes);
+  } else if (vocabularyType_ == VocabularyType::FrontCodedFsst) {
+    LOG(INFO) << "Training the symbol table for the compression of the "
+                 "vocabulary ..."
+              << std::endl;
+    fsstCompressor = FsstCompressor::trainOnSample(
+        RdfsVocabulary::makeUncompressedDiskIterator(vocabFile));
+  }
   auto wordReader = RdfsVocabulary::makeUncompressedDiskIterator(vocabFile);
-  auto wordWriter = vocab_.makeCompressedWordWriter(vocabFileTmp);
+  auto wordWriter =
+      vocab_.makeCompressedWordWriter(vocabFileTmp, std::move(fsstCompressor));
   for (const auto& word : wordReader) {
     wordWriter.push(word);
   }
@@ -106,15 +120,45 @@ void IndexImpl::compressInternalVocabularyIfSpecified(
   }
 }
 
+// _____________________________________________________________________________
+void IndexImpl::buildTrigramIndex() {
+  LOG(INFO) << "Building the trigram index over the vocabulary ..."
+            << std::endl;
+  vocab_.readFromFile(onDiskBase_ + INTERNAL_VOCAB_SUFFIX,
+                      onDiskBase_ + EXTERNAL_VOCAB_SUFFIX);
+  const size_t numWords = getVocabularySizeIncludingExternal();
+  TrigramIndex::Builder builder{onDiskBase_ + TRIGRAM_INDEX_SUFFIX,
+                                memoryLimitIndexBuilding(), allocator_};
+  constexpr size_t batchSize = 100'000;
+  std::vector<VocabIndex> indices;
+  for (size_t begin = 0; begin < numWords; begin += batchSize) {
+    size_t end = std::min(begin + batchSize, numWords);
+    indices.clear();
+    for (size_t i = begin; i < end; ++i) {
+      indices.push_back(VocabIndex::make(i));
+    }
+    for (const auto& word : vocab_.indicesToOptionalStrings(indices)) {
+      AD_CORRECTNESS_CHECK(word.has_value());
+      builder.push(word.value());
+    }
+  }
+  std::move(builder).finish();
+  vocab_.clear();
+  LOG(INFO) << "Done, number of words in the trigram index: " << numWords
+            << std::endl;
+}
+
 std::unique_ptr<TurtleParserBase> IndexImpl::makeTurtleParser(
     const std::string& filename) {
   auto setTokenizer = [this,
                        &filename]<template <typename> typename ParserTemplate>()
       -> std::unique_ptr<TurtleParserBase> {
     if (onlyAsciiTurtlePrefixes_) {
-      return std::make_unique<ParserTemplate<TokenizerCtre>>(filename);
+      return std::make_unique<ParserTemplate<TokenizerCtre>>(filename,
+                                                             inputIsNTriples_);
     } else {
-      return std::make_unique<ParserTemplate<Tokenizer>>(filename);
+      return std::make_unique<ParserTemplate<Tokenizer>>(filename,
+                                                         inputIsNTriples_);
     }
   };
 
@@ -292,6 +336,14 @@ void IndexImpl::createFromFile(const string& filename) {
       createIdTriplesAndVocab(makeTurtleParser(filename));
 
   compressInternalVocabularyIfSpecified(indexBuilderData.prefixes_);
+  if (buildTrigramIndex_) {
+    buildTrigramIndex();
+  }
+  configurationJson_["has-trigram-index"] = buildTrigramIndex_;
+  // A random identifier of this build of the index, s.t. files that are only
+  // valid for this index (like materialized views) can be recognized.
+  configurationJson_["index-build-id"] =
+      ad_utility::FastRandomIntGenerator<uint64_t>{}();
 
   // Write the configuration already at this point, so we have it available in
   // case any of the permutations fail.
@@ -462,7 +514,7 @@ IndexBuilderDataAsStxxlVector IndexImpl::passFileForVocabulary(
 
   size_t sizeInternalVocabulary = 0;
   std::vector<std::string> prefixes;
-  if (vocabPrefixCompressed_) {
+  if (usePrefixCompression()) {
     LOG(INFO) << "Merging partial vocabularies in byte order "
               << "(internal only) ..." << std::endl;
     VocabularyMerger m;
@@ -523,7 +575,7 @@ IndexBuilderDataAsStxxlVector IndexImpl::passFileForVocabulary(
   LOG(INFO) << "Removing temporary files ..." << std::endl;
   for (size_t n = 0; n < numFiles; ++n) {
     deleteTemporaryFile(absl::StrCat(onDiskBase_, PARTIAL_VOCAB_FILE_NAME, n));
-    if (vocabPrefixCompressed_) {
+    if (usePrefixCompression()) {
       deleteTemporaryFile(absl::StrCat(onDiskBase_, TMP_BASENAME_COMPRESSION,
                                        PARTIAL_VOCAB_FILE_NAME, n));
     }
@@ -685,12 +737,12 @@ IndexImpl::createPermutationPairImpl(size_t numColumns, const string& fileName1,
   metaData1.setup(fileName1 + MMAP_FILE_SUFFIX, ad_utility::CreateTag{});
   metaData2.setup(fileName2 + MMAP_FILE_SUFFIX, ad_utility::CreateTag{});
 
-  CompressedRelationWriter writer1{numColumns - 1,
-                                   ad_utility::File(fileName1, "w"),
-                                   blocksizePermutationPerColumn_};
-  CompressedRelationWriter writer2{numColumns - 1,
-                                   ad_utility::File(fileName2, "w"),
-                                   blocksizePermutationPerColumn_};
+  CompressedRelationWriter writer1{
+      numColumns - 1, ad_utility::File(fileName1, "w"),
+      blocksizePermutationPerColumn_, fileName1 + COLUMN_STATISTICS_SUFFIX};
+  CompressedRelationWriter writer2{
+      numColumns - 1, ad_utility::File(fileName2, "w"),
+      blocksizePermutationPerColumn_, fileName2 + COLUMN_STATISTICS_SUFFIX};
 
   // Lift a callback that works on single elements to a callback that works on
   // blocks.
@@ -718,6 +770,13 @@ IndexImpl::createPermutationPairImpl(size_t numColumns, const string& fileName1,
   AD_CORRECTNESS_CHECK(metaData1.blockData().size() ==
                        metaData2.blockData().size());
 
+  for (const auto& [fileName, writer] :
+       {std::pair{fileName1, &writer1}, std::pair{fileName2, &writer2}}) {
+    ad_utility::serialization::FileWriteSerializer summarySerializer{
+        fileName + RELATION_SUMMARIES_SUFFIX};
+    summarySerializer << writer->relationSummaries();
+  }
+
   return {std::move(metaData1), std::move(metaData2)};
 }
 
@@ -774,6 +833,13 @@ void IndexImpl::createFromOnDiskIndex(const string& onDiskBase) {
   LOG(DEBUG) << "Number of words in internal and external vocabulary: "
              << totalVocabularySize_ << std::endl;
 
+  if (buildTrigramIndex_) {
+    trigramIndex_.emplace();
+    trigramIndex_->readFromFile(onDiskBase_ + TRIGRAM_INDEX_SUFFIX);
+    AD_CORRECTNESS_CHECK(trigramIndex_->numWords() == totalVocabularySize_);
+    LOG(INFO) << "Trigram index over the vocabulary loaded" << std::endl;
+  }
+
   pso_.loadFromDisk(onDiskBase_);
   pos_.loadFromDisk(onDiskBase_);
 
@@ -909,6 +975,18 @@ void IndexImpl::setPrefixCompression(bool compressed) {
   vocabPrefixCompressed_ = compressed;
 }
 
+// ____________________________________________________________________________
+void IndexImpl::setVocabularyType(VocabularyType type) {
+  vocabularyType_ = type;
+}
+
+// ____________________________________________________________________________
+uint64_t IndexImpl::getBuildId() const {
+  // Indices that were built before the identifiers were introduced have the
+  // identifier 0.
+  return configurationJson_.value("index-build-id", uint64_t{0});
+}
+
 // ____________________________________________________________________________
 void IndexImpl::writeConfiguration() const {
   // Copy the configuration and add the current commit hash.
@@ -969,7 +1047,17 @@ void IndexImpl::readConfiguration() {
         "Incompatible index format, see log message for details"};
   }
 
-  if (configurationJson_.find("prefixes") != configurationJson_.end()) {
+  // Indices that were built before the type of the vocabulary could be chosen
+  // have a prefix-compressed vocabulary.
+  vocabularyType_ = VocabularyType::PrefixCompressed;
+  if (configurationJson_.count("vocabulary-type")) {
+    vocabularyType_ = vocabularyTypeFromString(
+        static_cast<std::string>(configurationJson_["vocabulary-type"]));
+  }
+  vocab_.setInternalVocabularyType(vocabularyType_);
+
+  if (vocabularyType_ == VocabularyType::PrefixCompressed &&
+      configurationJson_.find("prefixes") != configurationJson_.end()) {
     if (configurationJson_["prefixes"]) {
       vector<string> prefixes;
       auto prefixFile = ad_utility::makeIfstream(onDiskBase_ + PREFIX_FILE);
@@ -1034,6 +1122,7 @@ void IndexImpl::readConfiguration() {
   };
 
   loadDataMember("has-all-permutations", loadAllPermutations_, true);
+  loadDataMember("has-trigram-index", buildTrigramIndex_, false);
 
   loadDataMember("num-predicates-normal", numPredicatesNormal_);
   // These might be missing if there are only two permutations.
@@ -1053,6 +1142,11 @@ LangtagAndTriple IndexImpl::tripleToInternalRepresentation(
   // If the object of the triple can be directly folded into an ID, do so. Note
   // that the actual folding is done by the `TripleComponent`.
   std::optional<Id> idIfNotString = triple.object_.toValueIdIfNotString();
+  if (!idIfNotString.has_value() && inlineShortLiterals_) {
+    if (auto shortString = triple.object_.toShortString()) {
+      idIfNotString = Id::makeFromShortString(shortString.value());
+    }
+  }
 
   // TODO<joka921> The following statement could be simplified by a helper
   // function "optionalCast";
@@ -1153,6 +1247,11 @@ void IndexImpl::readIndexBuilderSettingsFromFile() {
     LOG(INFO) << WARNING_ASCII_ONLY_PREFIXES << std::endl;
   }
 
+  if (j.count("inline-short-literals")) {
+    inlineShortLiterals_ = static_cast<bool>(j["inline-short-literals"]);
+    configurationJson_["inline-short-literals"] = inlineShortLiterals_;
+  }
+
   if (j.count("parallel-parsing")) {
     useParallelParser_ = static_cast<bool>(j["parallel-parsing"]);
   }
@@ -1234,7 +1333,7 @@ std::future<void> IndexImpl::writeNextPartialVocabulary(
   auto lambda = [localIds = std::move(localIds), globalWritePtr,
                  items = std::move(items), vocab = &vocab_, partialFilename,
                  partialCompressionFilename, numFiles,
-                 vocabPrefixCompressed = vocabPrefixCompressed_]() mutable {
+                 vocabPrefixCompressed = usePrefixCompression()]() mutable {
     auto vec = [&]() {
       ad_utility::TimeBlockAndLog l{"vocab maps to vector"};
       return vocabMapsToVector(*items);
@@ -1422,6 +1521,159 @@ std::optional<string> IndexImpl::idToOptionalString(WordVocabIndex id) const {
   return textVocab_.indexToOptionalString(id);
 }
 
+// ___________________________________________________________________________
+std::vector<std::optional<string>> IndexImpl::idsToOptionalStrings(
+    std::span<const VocabIndex> ids) const {
+  // The internal words come first, they are not cached.
+  size_t numInternal = std::ranges::lower_bound(
+                           ids, vocab_.size(), std::less{},
+                           [](VocabIndex id) { return id.get(); }) -
+                       ids.begin();
+  std::vector<std::optional<string>> result =
+      vocab_.indicesToOptionalStrings(ids.subspan(0, numInternal));
+  result.resize(ids.size());
+
+  // Look up the externalized words in the cache, then read the missing ones
+  // from disk.
+  std::vector<size_t> missingPositions;
+  std::vector<VocabIndex> missingIds;
+  externalWordCache_.withWriteLock([&](ExternalWordCache& cache) {
+    cache.setMaxSize(RuntimeParameters().get<"vocabulary-cache-max-size">());
+    for (size_t i = numInternal; i < ids.size(); ++i) {
+      if (auto word = cache[ids[i]]) {
+        result[i] = *word;
+      } else {
+        missingPositions.push_back(i);
+        missingIds.push_back(ids[i]);
+      }
+    }
+  });
+  if (missingIds.empty()) {
+    return result;
+  }
+  std::vector<std::optional<string>> missingWords =
+      vocab_.indicesToOptionalStrings(missingIds);
+  externalWordCache_.withWriteLock([&](ExternalWordCache& cache) {
+    for (size_t i = 0; i < missingIds.size(); ++i) {
+      // The `ids` may contain duplicates, and other queries may have inserted
+      // the same words in the meantime.
+      if (missingWords[i].has_value() && !cache.contains(missingIds[i])) {
+        cache.insert(missingIds[i], missingWords[i].value());
+      }
+    }
+  });
+  for (size_t i = 0; i < missingIds.size(); ++i) {
+    result[missingPositions[i]] = std::move(missingWords[i]);
+  }
+  return result;
+}
+
+// ___________________________________________________________________________
+std::shared_ptr<const VocabularyMatches> IndexImpl::getVocabularyMatches(
+    const std::string& cacheKey, const Index::VocabularyFilter& filter,
+    bool onlyReadFromCache,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  vocabularyMatchesCache_.setMaxSize(
+      RuntimeParameters().get<"vocabulary-matches-cache-max-size">());
+  auto checkCancellation = [&cancellationHandle]() {
+    cancellationHandle->throwIfCancelled("Scanning the vocabulary");
+  };
+  auto computeMatches = [this, &filter, &checkCancellation]() {
+    checkCancellation();
+    const size_t numWords = getVocabularySizeIncludingExternal();
+    VocabularyMatches matches{numWords};
+    std::optional<std::vector<uint64_t>> candidates;
+    if (trigramIndex_.has_value() && !filter.requiredSubstrings_.empty()) {
+      candidates = trigramIndex_->getCandidates(filter.requiredSubstrings_);
+    }
+    if (candidates.has_value()) {
+      // The `filter` is false (or undefined for the words that are not
+      // literals) for all the words that are not candidates, so only the
+      // candidates have to be read.
+      if (filter.onlyLiterals_) {
+        for (size_t i = 0; i < numWords; ++i) {
+          if (!trigramIndex_->isLiteral(i)) {
+            matches.set(i, std::nullopt);
+          }
+        }
+      }
+      constexpr size_t batchSize = 100'000;
+      std::vector<VocabIndex> indices;
+      for (size_t begin = 0; begin < candidates->size(); begin += batchSize) {
+        checkCancellation();
+        size_t end = std::min(begin + batchSize, candidates->size());
+        indices.clear();
+        for (size_t i = begin; i < end; ++i) {
+          indices.push_back(VocabIndex::make(candidates.value()[i]));
+        }
+        auto words = vocab_.indicesToOptionalStrings(indices);
+        for (size_t i = 0; i < indices.size(); ++i) {
+          AD_CORRECTNESS_CHECK(words[i].has_value());
+          matches.set(indices[i].get(), filter.filter_(words[i].value()));
+        }
+      }
+      return matches;
+    }
+    // The batches are aligned to the blocks of the `matches`, so that they can
+    // be written concurrently.
+    constexpr size_t batchSize = 1024 * VocabularyMatches::BITS_PER_BLOCK;
+    std::atomic<size_t> nextBatch = 0;
+    auto scanBatches = [&]() {
+      std::vector<VocabIndex> indices;
+      for (size_t begin = batchSize * nextBatch++; begin < numWords;
+           begin = batchSize * nextBatch++) {
+        checkCancellation();
+        size_t end = std::min(begin + batchSize, numWords);
+        indices.clear();
+        for (size_t i = begin; i < end; ++i) {
+          indices.push_back(VocabIndex::make(i));
+        }
+        auto words = vocab_.indicesToOptionalStrings(indices);
+        for (size_t i = begin; i < end; ++i) {
+          const auto& word = words[i - begin];
+          AD_CORRECTNESS_CHECK(word.has_value());
+          matches.set(i, filter.filter_(word.value()));
+        }
+      }
+    };
+    // The scan is part of the evaluation of an expression, so it uses the same
+    // number of threads (one of which is the calling thread).
+    size_t numThreads = std::max(
+        size_t{1},
+        RuntimeParameters().get<"parallel-expression-num-threads">());
+    std::vector<std::future<void>> futures;
+    for (size_t i = 1; i < numThreads; ++i) {
+      futures.push_back(std::async(std::launch::async, scanBatches));
+    }
+    // If the query is cancelled, all the threads stop at their next batch, and
+    // the `CancellationException` is rethrown here (the destructors of the
+    // remaining futures wait for their threads).
+    scanBatches();
+    for (auto& future : futures) {
+      future.get();
+    }
+    return matches;
+  };
+  return vocabularyMatchesCache_
+      .computeOnce(cacheKey, computeMatches, onlyReadFromCache)
+      ._resultPointer;
+}
+
+// ___________________________________________________________________________
+std::optional<double> IndexImpl::getSubstringSelectivity(
+    const std::vector<std::string>& requiredSubstrings) const {
+  if (!trigramIndex_.has_value() || trigramIndex_->numWords() == 0) {
+    return std::nullopt;
+  }
+  auto numCandidates =
+      trigramIndex_->getNumCandidatesUpperBound(requiredSubstrings);
+  if (!numCandidates.has_value()) {
+    return std::nullopt;
+  }
+  return static_cast<double>(numCandidates.value()) /
+         static_cast<double>(trigramIndex_->numWords());
+}
+
 // ___________________________________________________________________________
 bool IndexImpl::getId(const string& element, Id* id) const {
   // TODO<joka921> we should parse doubles correctly in the SparqlParser and
@@ -1429,6 +1681,14 @@ bool IndexImpl::getId(const string& element, Id* id) const {
   VocabIndex vocabId;
   auto success = getVocab().getId(element, &vocabId);
   *id = Id::makeFromVocabIndex(vocabId);
+  if (!success) {
+    // A short literal that is not in the vocabulary might have been inlined
+    // during the index building, see `TripleComponent::toValueId`.
+    if (auto shortString = ShortString::fromLiteral(element)) {
+      *id = Id::makeFromShortString(shortString.value());
+      return true;
+    }
+  }
   return success;
 }
 
@@ -1456,6 +1716,44 @@ vector<float> IndexImpl::getMultiplicities(
   return res;
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const ColumnStatistics> IndexImpl::getColumnStatistics(
+    const TripleComponent& col0, Permutation::Enum permutation,
+    size_t column) const {
+  AD_CONTRACT_CHECK(column == 1 || column == 2);
+  std::optional<Id> col0Id = col0.toValueId(getVocab());
+  if (!col0Id.has_value()) {
+    return nullptr;
+  }
+  if (column == 2) {
+    // The `col2` of a permutation is the `col1` of its twin permutation, for
+    // which the statistics are stored.
+    using enum Permutation::Enum;
+    switch (permutation) {
+      case PSO:
+        permutation = POS;
+        break;
+      case POS:
+        permutation = PSO;
+        break;
+      case SPO:
+        permutation = SOP;
+        break;
+      case SOP:
+        permutation = SPO;
+        break;
+      case OPS:
+        permutation = OSP;
+        break;
+      case OSP:
+        permutation = OPS;
+        break;
+    }
+  }
+  const auto& p = getPermutation(permutation);
+  return p.isLoaded_ ? p.getColumnStatistics(col0Id.value()) : nullptr;
+}
+
 // ___________________________________________________________________
 vector<float> IndexImpl::getMultiplicities(
     Permutation::Enum permutation) const {
@@ -18,6 +18,7 @@
 #include <index/Permutation.h>
 #include <index/StxxlSortFunctors.h>
 #include <index/TextMetaData.h>
+#include <index/TrigramIndex.h>
 #include <index/Vocabulary.h>
 #include <index/VocabularyGenerator.h>
 #include <parser/ContextFileParser.h>
@@ -44,7 +45,11 @@
 
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "util/CancellationHandle.h"
+#include "util/Cache.h"
+#include "util/ConcurrentCache.h"
+#include "util/DefaultValueSizeGetter.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
 
 using ad_utility::BufferedVector;
 using ad_utility::MmapVector;
@@ -119,11 +124,16 @@ class IndexImpl {
   string onDiskBase_;
   string settingsFileName_;
   bool onlyAsciiTurtlePrefixes_ = false;
+  // If true, plain literals that fit into a `ValueId` are not added to the
+  // vocabulary, but stored as `ShortString`s.
+  bool inlineShortLiterals_ = false;
   bool useParallelParser_ = true;
+  bool inputIsNTriples_ = false;
   TurtleParserIntegerOverflowBehavior turtleParserIntegerOverflowBehavior_ =
       TurtleParserIntegerOverflowBehavior::Error;
   bool turtleParserSkipIllegalLiterals_ = false;
   bool keepTempFiles_ = false;
+  bool buildTrigramIndex_ = false;
   ad_utility::MemorySize memoryLimitIndexBuilding_ =
       DEFAULT_MEMORY_LIMIT_INDEX_BUILDING;
   ad_utility::MemorySize blocksizePermutationPerColumn_ =
@@ -132,8 +142,32 @@ class IndexImpl {
   Index::Vocab vocab_;
   size_t totalVocabularySize_ = 0;
   bool vocabPrefixCompressed_ = true;
+  VocabularyType vocabularyType_ = VocabularyType::PrefixCompressed;
   Index::TextVocab textVocab_;
 
+  // A cache for the words of the externalized vocabulary that are resolved by
+  // `idsToOptionalStrings`. It is shared by all queries, so that frequently
+  // exported IRIs and literals (for example, labels) are only read from disk
+  // once. The words of the internal vocabulary are not cached, as they are
+  // already in memory.
+  using ExternalWordCache =
+      ad_utility::LRUCache<VocabIndex, std::string,
+                           ad_utility::StringSizeGetter<std::string>>;
+  mutable ad_utility::Synchronized<ExternalWordCache> externalWordCache_;
+
+  // A cache for the results of `getVocabularyMatches`. The key identifies the
+  // filter (for example, a regex), so that the vocabulary is only scanned once
+  // per filter, also across queries.
+  using VocabularyMatchesCache =
+      ad_utility::ConcurrentCache<ad_utility::LRUCache<
+          std::string, VocabularyMatches, VocabularyMatches::SizeGetter>>;
+  mutable VocabularyMatchesCache vocabularyMatchesCache_;
+
+  // The trigram index over the vocabulary, if it was built (see
+  // `buildTrigramIndex_`). It is used to restrict the words on which the
+  // filters of `getVocabularyMatches` are evaluated.
+  std::optional<TrigramIndex> trigramIndex_;
+
   TextMetaData textMeta_;
   DocsDB docsDB_;
   vector<WordIndex> blockBoundaries_;
@@ -273,6 +307,38 @@ class IndexImpl {
 
   std::optional<string> idToOptionalString(WordVocabIndex id) const;
 
+  // Same as `idToOptionalString` for each of the `ids`, which have to be
+  // sorted. The words of the externalized vocabulary are taken from the
+  // `externalWordCache_` if possible, and else read in the order in which
+  // they are stored on disk.
+  std::vector<std::optional<string>> idsToOptionalStrings(
+      std::span<const VocabIndex> ids) const;
+
+  // Evaluate the `filter` on all the words of the vocabulary (including the
+  // externalized words). If there is a trigram index and the `filter` has
+  // `requiredSubstrings_`, only the candidates from the trigram index are
+  // read. Else the vocabulary is split into ranges that are scanned
+  // concurrently, and the words of each range are read in the order in which
+  // they are stored. The result is stored in the `vocabularyMatchesCache_`
+  // with the given `cacheKey`, the size of which is bounded by the runtime
+  // parameter `vocabulary-matches-cache-max-size`.
+  std::shared_ptr<const VocabularyMatches> getVocabularyMatches(
+      const std::string& cacheKey, const Index::VocabularyFilter& filter,
+      bool onlyReadFromCache,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
+  // Return the fraction of the words of the vocabulary that contain all the
+  // `requiredSubstrings` according to the trigram index (an upper bound).
+  // Return `std::nullopt` if there is no trigram index or if the
+  // `requiredSubstrings` have no trigrams.
+  std::optional<double> getSubstringSelectivity(
+      const std::vector<std::string>& requiredSubstrings) const;
+
+  // ___________________________________________________________________________
+  size_t getVocabularySizeIncludingExternal() const {
+    return vocab_.size() + vocab_.getExternalVocab().size();
+  }
+
   // ___________________________________________________________________________
   bool getId(const string& element, Id* id) const;
 
@@ -318,11 +384,13 @@ class IndexImpl {
 
   size_t getSizeEstimate(const string& words) const;
 
-  void callFixedGetContextListForWords(const string& words,
+  // Only the `limit` contexts with the highest scores are returned.
+  void callFixedGetContextListForWords(const string& words, size_t limit,
                                        IdTable* result) const;
 
   template <int WIDTH>
-  void getContextListForWords(const string& words, IdTable* result) const;
+  void getContextListForWords(const string& words, size_t limit,
+                              IdTable* result) const;
 
   void getECListForWordsOneVar(const string& words, size_t limit,
                                IdTable* result) const;
@@ -361,6 +429,13 @@ class IndexImpl {
 
   Index::WordEntityPostings getEntityPostingsForTerm(const string& term) const;
 
+  // Same as `getEntityPostingsForTerm`, but only for the `k` contexts with the
+  // highest scores per entity (see `FTSAlgorithms::blockMaxCrossIntersect`).
+  // The scores of the chunks of the entity list that can't contribute to
+  // those are not decoded and are 0 in the result.
+  Index::WordEntityPostings getTopKEntityPostingsForTerm(const string& term,
+                                                         size_t k) const;
+
   // Returns a set of textRecords and their corresponding entities and
   // scores. Each textRecord contains its corresponding entity and the term.
   // Returned IdTable has columns: textRecord, entity, score. Sorted by
@@ -386,13 +461,52 @@ class IndexImpl {
       const TextBlockMetaData& tbmd,
       const ad_utility::AllocatorWithLimit<Id>& allocator) const;
 
+  // Read the skip table of the context list `cl`, one entry per chunk of
+  // `TextPostingChunkMetaData::CHUNK_SIZE` postings.
+  vector<TextPostingChunkMetaData> readSkipTable(
+      const ContextListMetaData& cl) const;
+
+  // Read only the postings of the chunks `[beginChunk, endChunk)` of the
+  // classic (`isEntityList == false`) or the entity context list of `tbmd`.
+  // `skipTable` must be the skip table of that list. If `readScores` is false,
+  // the scores are not decoded and the `scores_` of the result are empty.
+  Index::WordEntityPostings readContextListChunksWep(
+      const TextBlockMetaData& tbmd, bool isEntityList,
+      const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+      size_t endChunk, bool readScores = true) const;
+
+  // Read only the scores of the chunks `[beginChunk, endChunk)` of the context
+  // list `cl` with the `skipTable`.
+  vector<Score> readContextListChunksScores(
+      const ContextListMetaData& cl,
+      const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+      size_t endChunk) const;
+
+  // Same as `readWordEntityClWep`, but only read the chunks of the entity list
+  // that contain at least one of the `contexts`, which must be sorted. All
+  // postings of the entity list with one of the `contexts` are contained in
+  // the result.
+  Index::WordEntityPostings readWordEntityClWepForContexts(
+      const TextBlockMetaData& tbmd,
+      const vector<TextRecordIndex>& contexts) const;
+
+  // Return the `k` word postings for the `wordOrPrefix` with the highest
+  // scores, sorted by textRecord. Chunks of the context list whose maximal
+  // score can't change the result are not decoded at all.
+  Index::WordEntityPostings getTopKWordPostingsForTerm(
+      const string& wordOrPrefix, size_t k) const;
+
   string getTextExcerpt(TextRecordIndex cid) const {
-    if (cid.get() >= docsDB_._size) {
+    if (cid.get() >= docsDB_.size()) {
       return "";
     }
     return docsDB_.getTextExcerpt(cid);
   }
 
+  vector<string> getTextExcerpts(std::span<const TextRecordIndex> cids) const {
+    return docsDB_.getTextExcerpts(cids);
+  }
+
   float getAverageNofEntityContexts() const {
     return textMeta_.getAverageNofEntityContexts();
   };
@@ -407,6 +521,10 @@ class IndexImpl {
 
   void setKeepTempFiles(bool keepTempFiles);
 
+  void setBuildTrigramIndex(bool buildTrigramIndex) {
+    buildTrigramIndex_ = buildTrigramIndex;
+  }
+
   ad_utility::MemorySize& memoryLimitIndexBuilding() {
     return memoryLimitIndexBuilding_;
   }
@@ -424,6 +542,12 @@ class IndexImpl {
 
   void setPrefixCompression(bool compressed);
 
+  void setVocabularyType(VocabularyType type);
+
+  void setInputIsNTriples(bool inputIsNTriples) {
+    inputIsNTriples_ = inputIsNTriples;
+  }
+
   void setNumTriplesPerBatch(uint64_t numTriplesPerBatch) {
     numTriplesPerBatch_ = numTriplesPerBatch;
   }
@@ -444,6 +568,11 @@ class IndexImpl {
   vector<float> getMultiplicities(const TripleComponent& key,
                                   Permutation::Enum permutation) const;
 
+  // _____________________________________________________________________________
+  std::shared_ptr<const ColumnStatistics> getColumnStatistics(
+      const TripleComponent& col0, Permutation::Enum permutation,
+      size_t column) const;
+
   // ___________________________________________________________________
   vector<float> getMultiplicities(Permutation::Enum permutation) const;
 
@@ -501,6 +630,18 @@ class IndexImpl {
 
   //  Apply the prefix compression to the internal vocabulary. Is called by
   //  `createFromFile` after the vocabularies have been created and merged.
+  // The prefixes for the prefix compression are only needed for the
+  // prefix-compressed vocabulary. Front coding already removes the
+  // redundancy of common prefixes.
+  bool usePrefixCompression() const {
+    return vocabPrefixCompressed_ &&
+           vocabularyType_ == VocabularyType::PrefixCompressed;
+  }
+
+  // Build the trigram index over the (compressed) vocabulary and write it to
+  // disk. The vocabulary is temporarily loaded for this purpose.
+  void buildTrigramIndex();
+
   void compressInternalVocabularyIfSpecified(
       const std::vector<std::string>& prefixes);
 
@@ -592,6 +733,31 @@ class IndexImpl {
       size_t nofElements, off_t from, size_t nofBytes,
       MakeFromUint64t makeFromUint = MakeFromUint64t{}) const;
 
+  // Read the codewords `[beginCodeword, endCodeword)` of the Simple8b encoded
+  // list that starts at `from` and decode the first `nofElements` elements
+  // that are stored in them. If `gapBase` is set, the elements are gaps and
+  // the values (starting from `gapBase`) are returned.
+  vector<uint64_t> readSimple8bCodewords(
+      off_t from, size_t beginCodeword, size_t endCodeword, size_t nofElements,
+      std::optional<uint64_t> gapBase = std::nullopt) const;
+
+  // Decode the elements of the chunks `[beginChunk, endChunk)` of one of the
+  // Simple8b encoded lists of the context list `cl`, the codewords of which
+  // start at `from` and end at `to`. `pointer` selects the skip pointers of
+  // that list from the `skipTable`. If `gapBase` is set, the elements are gaps
+  // (see `readSimple8bCodewords`).
+  vector<uint64_t> readContextListChunks(
+      const ContextListMetaData& cl,
+      const vector<TextPostingChunkMetaData>& skipTable, size_t beginChunk,
+      size_t endChunk, off_t from, off_t to,
+      ad_utility::Simple8bSkipPointer TextPostingChunkMetaData::*pointer,
+      std::optional<uint64_t> gapBase = std::nullopt) const;
+
+  // Read the codebook of the frequency encoded list that starts at `from`.
+  // Return the codebook and the offset of the first codeword of the list.
+  template <typename T>
+  std::pair<vector<T>, off_t> readCodebook(off_t from) const;
+
   // Get the metadata for the block from the text index that contains the
   // `word`. Also works for prefixes that are terminated with `PREFIX_CHAR` like
   // "astro*". Returns `nullopt` if no suitable block was found because no
@@ -628,10 +794,13 @@ class IndexImpl {
 
   //! Writes a list of elements (have to be able to be cast to unit64_t)
   //! to file.
-  //! Returns the number of bytes written.
+  //! Returns the number of bytes written. If `skipPointers` is not null, it is
+  //! set to the skip pointers of the encoded list, one per chunk of
+  //! `TextPostingChunkMetaData::CHUNK_SIZE` elements.
   template <class Numeric>
-  size_t writeList(Numeric* data, size_t nofElements,
-                   ad_utility::File& file) const;
+  size_t writeList(
+      Numeric* data, size_t nofElements, ad_utility::File& file,
+      vector<ad_utility::Simple8bSkipPointer>* skipPointers = nullptr) const;
 
   // TODO<joka921> understand what the "codes" are, are they better just ints?
   typedef ad_utility::HashMap<WordIndex, CompressionCode> WordToCodeMap;
@@ -687,6 +856,9 @@ class IndexImpl {
   // the input).
   NumNormalAndInternal numTriples() const;
 
+  // A random identifier that is created when the index is built.
+  uint64_t getBuildId() const;
+
   // The index contains several triples that are not part of the "actual"
   // knowledge graph, but are added by QLever for internal reasons (e.g. for an
   // efficient implementation of language filters). For a given
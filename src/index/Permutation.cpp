@@ -4,7 +4,11 @@
 
 #include "index/Permutation.h"
 
+#include <filesystem>
+
 #include "absl/strings/str_cat.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializePair.h"
 #include "util/StringUtils.h"
 
 // _____________________________________________________________________
@@ -33,11 +37,59 @@ void Permutation::loadFromDisk(const std::string& onDiskBase) {
   }
   meta_.readFromFile(&file);
   reader_.emplace(allocator_, std::move(file));
+  // Indices that were built before the `ColumnStatistics` were introduced
+  // don't have them, which only affects the quality of the estimates.
+  auto statisticsFilename = filename + COLUMN_STATISTICS_SUFFIX;
+  if (std::filesystem::exists(statisticsFilename)) {
+    columnStatistics_.emplace(statisticsFilename);
+  }
+  // The same holds for the `RelationSummary`s, without which aggregates are
+  // computed by reading all the blocks (see `aggregateColumn`).
+  auto summariesFilename = filename + RELATION_SUMMARIES_SUFFIX;
+  if (std::filesystem::exists(summariesFilename)) {
+    std::vector<std::pair<Id, RelationSummary>> relationSummaries;
+    ad_utility::serialization::FileReadSerializer serializer{
+        summariesFilename};
+    serializer >> relationSummaries;
+    for (auto& [col0Id, summary] : relationSummaries) {
+      relationSummaries_.emplace(col0Id, std::move(summary));
+    }
+  }
   LOG(INFO) << "Registered " << readableName_
             << " permutation: " << meta_.statistics() << std::endl;
   isLoaded_ = true;
 }
 
+// _____________________________________________________________________
+std::shared_ptr<const ColumnStatistics> Permutation::getColumnStatistics(
+    Id col0Id) const {
+  return columnStatistics_.has_value() ? columnStatistics_->get(col0Id)
+                                       : nullptr;
+}
+
+// _____________________________________________________________________
+const RelationSummary* Permutation::getRelationSummary(Id col0Id) const {
+  auto it = relationSummaries_.find(col0Id);
+  return it == relationSummaries_.end() ? nullptr : &it->second;
+}
+
+// _____________________________________________________________________
+Permutation::ColumnAggregates Permutation::aggregateColumn(
+    Id col0Id, std::optional<Id> col1Id,
+    std::span<const ValueComparison> comparisons,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  if (!isLoaded_) {
+    throw std::runtime_error("This query requires the permutation " +
+                             readableName_ + ", which was not loaded");
+  }
+  if (!meta_.col0IdExists(col0Id)) {
+    return {};
+  }
+  return reader().aggregateColumn(meta_.getMetaData(col0Id), col1Id,
+                                  meta_.blockData(), getRelationSummary(col0Id),
+                                  comparisons, cancellationHandle);
+}
+
 // _____________________________________________________________________
 IdTable Permutation::scan(
     Id col0Id, std::optional<Id> col1Id, ColumnIndicesRef additionalColumns,
@@ -4,12 +4,17 @@
 #pragma once
 
 #include <array>
+#include <memory>
+#include <optional>
 #include <string>
 
 #include "global/Constants.h"
+#include "index/ColumnStatistics.h"
 #include "index/IndexMetaData.h"
+#include "index/RelationSummary.h"
 #include "util/CancellationHandle.h"
 #include "util/File.h"
+#include "util/HashMap.h"
 #include "util/Log.h"
 
 // Forward declaration of `IdTable`
@@ -91,6 +96,27 @@ class Permutation {
   /// result
   size_t getResultSizeOfScan(Id col0Id, Id col1Id) const;
 
+  // Return the statistics of the `col1` of the relation with the given
+  // `col0Id`, or `nullptr` if there are none (because the relation is small or
+  // because the index was built without statistics).
+  std::shared_ptr<const ColumnStatistics> getColumnStatistics(Id col0Id) const;
+
+  // Return the summary of the `col1` of the relation with the given `col0Id`,
+  // or `nullptr` if there is none (because the relation is small or because
+  // the index was built without summaries).
+  const RelationSummary* getRelationSummary(Id col0Id) const;
+
+  // Compute the aggregates of the last column of the scan with the given
+  // `col0Id` and `col1Id`, restricted to the values for which all the
+  // `comparisons` hold, without reading most of the blocks. This is a thin
+  // wrapper around `CompressedRelationReader::aggregateColumn`.
+  using ValueComparison = CompressedRelationReader::ValueComparison;
+  using ColumnAggregates = CompressedRelationReader::ColumnAggregates;
+  ColumnAggregates aggregateColumn(
+      Id col0Id, std::optional<Id> col1Id,
+      std::span<const ValueComparison> comparisons,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
   // _______________________________________________________
   void setKbName(const string& name) { meta_.setName(name); }
 
@@ -112,5 +138,10 @@ class Permutation {
   std::optional<CompressedRelationReader> reader_;
   Allocator allocator_;
 
+  // The `ColumnStatistics` of the large relations, see `getColumnStatistics`.
+  std::optional<ColumnStatisticsFile> columnStatistics_;
+  // The `RelationSummary`s of the large relations, see `getRelationSummary`.
+  ad_utility::HashMap<Id, RelationSummary> relationSummaries_;
+
   bool isLoaded_ = false;
 };
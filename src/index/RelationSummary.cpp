@@ -0,0 +1,41 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "index/RelationSummary.h"
+
+#include "global/ValueIdComparators.h"
+
+// _____________________________________________________________________________
+void RelationSummary::Builder::pushBlock(std::span<const Id> values) {
+  using namespace valueIdComparators;
+  // The same order as for `MIN` and `MAX` in SPARQL queries.
+  auto isLess = [](Id a, Id b) {
+    return toBoolNotUndef(
+        compareIds<ComparisonForIncompatibleTypes::CompareByType>(
+            a, b, Comparison::LT));
+  };
+  BlockSummary block{0, Id::makeUndefined(), Id::makeUndefined()};
+  for (size_t i = 0; i < values.size(); ++i) {
+    Id value = values[i];
+    bool isNew = i == 0 || value != values[i - 1];
+    block.numDistinct_ += static_cast<uint64_t>(isNew);
+    if (!isNumeric(value)) {
+      continue;
+    }
+    if (block.minNumeric_.isUndefined() || isLess(value, block.minNumeric_)) {
+      block.minNumeric_ = value;
+    }
+    if (block.maxNumeric_.isUndefined() || isLess(block.maxNumeric_, value)) {
+      block.maxNumeric_ = value;
+    }
+  }
+  blocks_.push_back(block);
+}
+
+// _____________________________________________________________________________
+RelationSummary RelationSummary::Builder::finish(uint64_t numDistinct) && {
+  RelationSummary result;
+  result.numDistinct_ = numDistinct;
+  result.blocks_ = std::move(blocks_);
+  return result;
+}
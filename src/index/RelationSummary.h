@@ -0,0 +1,72 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "global/Id.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// Aggregates of the `col1` of a large relation in a permutation (for example,
+// of the objects of a predicate in POS), which are computed during the index
+// build: the exact number of distinct values of the relation, and for each of
+// its blocks the number of distinct values and the smallest and largest
+// numeric value. Together with the metadata of the blocks, they are used to
+// compute `COUNT`, `COUNT(DISTINCT)`, `MIN`, and `MAX` of a column of a scan
+// without reading most of the blocks (see
+// `CompressedRelationReader::aggregateColumn`).
+class RelationSummary {
+ public:
+  struct BlockSummary {
+    uint64_t numDistinct_;
+    // The smallest and largest value with datatype `Int`, `Double` or
+    // `Decimal` (in the order of `valueIdComparators::compareIds`), undefined
+    // if there is none.
+    Id minNumeric_;
+    Id maxNumeric_;
+    bool operator==(const BlockSummary&) const = default;
+    friend std::true_type allowTrivialSerialization(BlockSummary, auto);
+  };
+
+ private:
+  uint64_t numDistinct_ = 0;
+  // One summary for each block of the relation, in the order of the blocks.
+  std::vector<BlockSummary> blocks_;
+
+ public:
+  uint64_t numDistinct() const { return numDistinct_; }
+  const std::vector<BlockSummary>& blocks() const { return blocks_; }
+
+  bool operator==(const RelationSummary&) const = default;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(RelationSummary) {
+    serializer | arg.numDistinct_;
+    serializer | arg.blocks_;
+  }
+
+  // Return true iff `id` has one of the datatypes for which the `BlockSummary`
+  // stores the smallest and largest value.
+  static bool isNumeric(Id id) {
+    return id.getDatatype() == Datatype::Int ||
+           id.getDatatype() == Datatype::Double ||
+           id.getDatatype() == Datatype::Decimal;
+  }
+
+  // Build the summary from the blocks of a relation, which are pushed in
+  // order.
+  class Builder {
+   private:
+    std::vector<BlockSummary> blocks_;
+
+   public:
+    // Add the next block, the `values` of which are the sorted `col1`.
+    void pushBlock(std::span<const Id> values);
+    // The exact number of distinct values of the relation is known to the
+    // caller (see `CompressedRelationWriter::finishLargeRelation`).
+    RelationSummary finish(uint64_t numDistinct) &&;
+  };
+};
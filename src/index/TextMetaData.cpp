@@ -7,6 +7,35 @@
 #include "../global/Constants.h"
 #include "../util/ReadableNumberFact.h"
 
+// _____________________________________________________________________________
+TextPostingChunkMetaData::DiskFormat TextPostingChunkMetaData::toDiskFormat()
+    const {
+  return {firstContext_.get(),
+          lastContext_.get(),
+          contextBase_,
+          maxScore_,
+          contextPointer_.codewordIndex_,
+          contextPointer_.firstElementInCodeword_,
+          wordPointer_.codewordIndex_,
+          wordPointer_.firstElementInCodeword_,
+          scorePointer_.codewordIndex_,
+          scorePointer_.firstElementInCodeword_};
+}
+
+// _____________________________________________________________________________
+TextPostingChunkMetaData TextPostingChunkMetaData::fromDiskFormat(
+    const DiskFormat& words) {
+  TextPostingChunkMetaData chunk;
+  chunk.firstContext_ = TextRecordIndex::make(words[0]);
+  chunk.lastContext_ = TextRecordIndex::make(words[1]);
+  chunk.contextBase_ = words[2];
+  chunk.maxScore_ = static_cast<Score>(words[3]);
+  chunk.contextPointer_ = {words[4], words[5]};
+  chunk.wordPointer_ = {words[6], words[7]};
+  chunk.scorePointer_ = {words[8], words[9]};
+  return chunk;
+}
+
 // _____________________________________________________________________________
 const TextBlockMetaData& TextMetaData::getBlockInfoByWordRange(
     const uint64_t lower, const uint64_t upper) const {
@@ -76,5 +105,5 @@ void TextMetaData::addBlock(const TextBlockMetaData& md) {
 
 // _____________________________________________________________________________
 off_t TextMetaData::getOffsetAfter() {
-  return _blocks.back()._entityCl._lastByte + 1;
+  return _blocks.back()._entityCl.getOffsetAfterSkipTable();
 }
@@ -3,6 +3,7 @@
 // Author: Björn Buchhold (buchhold@informatik.uni-freiburg.de)
 #pragma once
 
+#include <array>
 #include <cstdio>
 #include <vector>
 
@@ -10,10 +11,47 @@
 #include "../util/Exception.h"
 #include "../util/File.h"
 #include "../util/Serializer/Serializer.h"
+#include "../util/Simple8bCode.h"
 #include "../util/TypeTraits.h"
 
 using std::vector;
 
+// The postings of each context list are divided into chunks of
+// `TextPostingChunkMetaData::CHUNK_SIZE` consecutive postings. For each chunk
+// we store the range of its contexts, the maximal score, and for each of the
+// (Simple8b encoded) context, word, and score lists a pointer to the codeword
+// where the chunk starts. This allows to decode only the chunks of a list that
+// can contribute to an intersection (skip pointers) or to a top-k result
+// (block-max scores).
+struct TextPostingChunkMetaData {
+  static constexpr size_t CHUNK_SIZE = 128;
+
+  TextRecordIndex firstContext_ = TextRecordIndex::make(0);
+  TextRecordIndex lastContext_ = TextRecordIndex::make(0);
+  // The context list is gap encoded. This is the context of the posting right
+  // before the first posting of the codeword `contextPointer_` points to (or 0
+  // if there is no such posting), which is needed to undo the gap encoding
+  // when decoding starts at that codeword.
+  uint64_t contextBase_ = 0;
+  Score maxScore_ = 0;
+  ad_utility::Simple8bSkipPointer contextPointer_;
+  // Unused if the context list has no word list (see
+  // `ContextListMetaData::hasMultipleWords`).
+  ad_utility::Simple8bSkipPointer wordPointer_;
+  ad_utility::Simple8bSkipPointer scorePointer_;
+
+  bool operator==(const TextPostingChunkMetaData&) const = default;
+
+  // On disk, a chunk is stored as `NUM_WORDS_ON_DISK` integers in the order of
+  // the members above, so the format doesn't depend on the layout (and
+  // padding) of this struct.
+  static constexpr size_t NUM_WORDS_ON_DISK = 10;
+  using DiskFormat = std::array<uint64_t, NUM_WORDS_ON_DISK>;
+  static constexpr size_t sizeOnDisk() { return sizeof(DiskFormat); }
+  DiskFormat toDiskFormat() const;
+  static TextPostingChunkMetaData fromDiskFormat(const DiskFormat& words);
+};
+
 class ContextListMetaData {
  public:
   ContextListMetaData()
@@ -39,6 +77,19 @@ class ContextListMetaData {
 
   bool hasMultipleWords() const { return _startScorelist > _startWordlist; }
 
+  // The skip table (one `TextPostingChunkMetaData` per chunk) is stored
+  // directly after the score list.
+  size_t getNofChunks() const {
+    return (_nofElements + TextPostingChunkMetaData::CHUNK_SIZE - 1) /
+           TextPostingChunkMetaData::CHUNK_SIZE;
+  }
+  off_t getStartOfSkipTable() const { return _lastByte + 1; }
+  off_t getOffsetAfterSkipTable() const {
+    return getStartOfSkipTable() +
+           static_cast<off_t>(getNofChunks() *
+                              TextPostingChunkMetaData::sizeOnDisk());
+  }
+
   static constexpr size_t sizeOnDisk() {
     return sizeof(size_t) + 4 * sizeof(off_t);
   }
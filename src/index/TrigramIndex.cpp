@@ -0,0 +1,214 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "index/TrigramIndex.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "parser/RdfEscaping.h"
+#include "util/Exception.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Simple8bCode.h"
+
+namespace {
+// The number of elements by which the buffer for the decoding with the
+// `Simple8bCode` has to be larger than the number of decoded elements.
+constexpr size_t SIMPLE8B_DECODE_OVERHEAD = 239;
+
+// Convert the ASCII letters of `c` to lowercase, leave all other bytes as is
+// (in particular the bytes of multi-byte UTF-8 characters).
+uint8_t asciiToLower(char c) {
+  auto b = static_cast<uint8_t>(c);
+  return (b >= 'A' && b <= 'Z') ? b + ('a' - 'A') : b;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<TrigramIndex::Trigram> TrigramIndex::getTrigrams(
+    std::string_view text) {
+  std::vector<Trigram> result;
+  if (text.size() < 3) {
+    return result;
+  }
+  result.reserve(text.size() - 2);
+  for (size_t i = 0; i + 2 < text.size(); ++i) {
+    result.push_back((Trigram{asciiToLower(text[i])} << 16) |
+                     (Trigram{asciiToLower(text[i + 1])} << 8) |
+                     Trigram{asciiToLower(text[i + 2])});
+  }
+  std::ranges::sort(result);
+  auto duplicates = std::ranges::unique(result);
+  result.erase(duplicates.begin(), duplicates.end());
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<size_t>> TrigramIndex::findTrigrams(
+    const std::vector<std::string>& substrings) const {
+  std::vector<Trigram> trigrams;
+  for (const auto& substring : substrings) {
+    std::ranges::copy(getTrigrams(substring), std::back_inserter(trigrams));
+  }
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  std::ranges::sort(trigrams);
+  auto duplicates = std::ranges::unique(trigrams);
+  trigrams.erase(duplicates.begin(), duplicates.end());
+  std::vector<size_t> positions;
+  for (Trigram trigram : trigrams) {
+    auto it = std::ranges::lower_bound(trigrams_, trigram);
+    if (it == trigrams_.end() || *it != trigram) {
+      // No word contains this trigram.
+      return std::vector<size_t>{};
+    }
+    positions.push_back(static_cast<size_t>(it - trigrams_.begin()));
+  }
+  return positions;
+}
+
+// _____________________________________________________________________________
+std::vector<uint64_t> TrigramIndex::getPostingList(size_t i) const {
+  size_t size = listSizes_.at(i);
+  size_t numBytes = listOffsets_.at(i + 1) - listOffsets_.at(i);
+  std::vector<uint64_t> codewords(numBytes / sizeof(uint64_t));
+  auto numBytesRead =
+      file_.read(codewords.data(), numBytes, listOffsets_.at(i));
+  AD_CORRECTNESS_CHECK(numBytesRead == static_cast<ssize_t>(numBytes));
+  std::vector<uint64_t> result(size + SIMPLE8B_DECODE_OVERHEAD);
+  ad_utility::Simple8bCode::decodeGaps(codewords.data(), size, result.data());
+  result.resize(size);
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<uint64_t>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& substrings) const {
+  auto positions = findTrigrams(substrings);
+  if (!positions.has_value()) {
+    return std::nullopt;
+  }
+  if (positions->empty()) {
+    return std::vector<uint64_t>{};
+  }
+  // Intersect the posting lists, starting with the shortest one, so that the
+  // intermediate results are as small as possible.
+  std::ranges::sort(positions.value(), std::less{},
+                    [this](size_t i) { return listSizes_[i]; });
+  auto result = getPostingList(positions->front());
+  std::vector<uint64_t> intersection;
+  for (size_t i : positions.value() | std::views::drop(1)) {
+    if (result.empty()) {
+      break;
+    }
+    auto list = getPostingList(i);
+    intersection.clear();
+    std::ranges::set_intersection(result, list,
+                                  std::back_inserter(intersection));
+    std::swap(result, intersection);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<uint64_t> TrigramIndex::getNumCandidatesUpperBound(
+    const std::vector<std::string>& substrings) const {
+  auto positions = findTrigrams(substrings);
+  if (!positions.has_value()) {
+    return std::nullopt;
+  }
+  uint64_t result = numWords_;
+  for (size_t i : positions.value()) {
+    result = std::min(result, listSizes_[i]);
+  }
+  return positions->empty() ? 0 : result;
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::readFromFile(const std::string& filename) {
+  file_.open(filename, "r");
+  off_t startOfMetaData;
+  file_.getLastOffset(&startOfMetaData);
+  ad_utility::serialization::FileReadSerializer serializer{std::move(file_)};
+  serializer.setSerializationPosition(startOfMetaData);
+  serializer >> *this;
+  file_ = std::move(serializer).file();
+  AD_CORRECTNESS_CHECK(listOffsets_.size() == trigrams_.size() + 1);
+}
+
+// _____________________________________________________________________________
+TrigramIndex::Builder::Builder(std::string filename,
+                               ad_utility::MemorySize memoryLimit,
+                               ad_utility::AllocatorWithLimit<Id> allocator)
+    : filename_{std::move(filename)},
+      sorter_{filename_ + ".sorter.dat", memoryLimit, std::move(allocator)} {}
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::push(std::string_view word) {
+  uint64_t index = numWords_++;
+  if (index % 64 == 0) {
+    isLiteral_.push_back(0);
+  }
+  if (word.starts_with('"')) {
+    isLiteral_.back() |= uint64_t{1} << (index % 64);
+  }
+  auto content =
+      RdfEscaping::normalizedContentFromLiteralOrIri(std::string{word});
+  for (Trigram trigram : getTrigrams(content)) {
+    sorter_.push(std::array{Id::fromBits(trigram), Id::fromBits(index)});
+  }
+}
+
+// _____________________________________________________________________________
+void TrigramIndex::Builder::finish() && {
+  TrigramIndex result;
+  result.numWords_ = numWords_;
+  result.isLiteral_ = std::move(isLiteral_);
+  ad_utility::File file{filename_, "w"};
+  uint64_t currentOffset = 0;
+  std::vector<uint64_t> gaps;
+  std::vector<uint64_t> codewords;
+  // Encode the `gaps` of the posting list of the `trigram` and append them to
+  // the file.
+  auto writePostingList = [&](Trigram trigram) {
+    // In the worst case, each element needs its own codeword.
+    codewords.resize(gaps.size());
+    size_t numBytes = ad_utility::Simple8bCode::encode(
+        gaps.data(), gaps.size(), codewords.data());
+    file.write(codewords.data(), numBytes);
+    result.trigrams_.push_back(trigram);
+    result.listSizes_.push_back(gaps.size());
+    result.listOffsets_.push_back(currentOffset);
+    currentOffset += numBytes;
+    gaps.clear();
+  };
+
+  // The pairs are sorted by the trigram and then by the word index, so the
+  // posting lists are processed one after the other.
+  std::optional<Trigram> currentTrigram;
+  uint64_t lastIndex = 0;
+  for (const auto& row : sorter_.sortedView()) {
+    auto trigram = static_cast<Trigram>(row[0].getBits());
+    uint64_t index = row[1].getBits();
+    if (currentTrigram != trigram) {
+      if (currentTrigram.has_value()) {
+        writePostingList(currentTrigram.value());
+      }
+      currentTrigram = trigram;
+      lastIndex = 0;
+    }
+    gaps.push_back(index - lastIndex);
+    lastIndex = index;
+  }
+  if (currentTrigram.has_value()) {
+    writePostingList(currentTrigram.value());
+  }
+  result.listOffsets_.push_back(currentOffset);
+
+  off_t startOfMetaData = static_cast<off_t>(currentOffset);
+  ad_utility::serialization::FileWriteSerializer serializer{std::move(file)};
+  serializer << result;
+  file = std::move(serializer).file();
+  file.write(&startOfMetaData, sizeof(startOfMetaData));
+}
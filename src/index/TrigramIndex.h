@@ -0,0 +1,130 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// An index that maps each trigram (three consecutive bytes) of the words of the
+// vocabulary to the sorted list of the indices of the words that contain it. A
+// word can only contain a string `s` if it contains all the trigrams of `s`,
+// so the index yields a (typically small) set of candidates for substring and
+// regex filters, which then have to be verified.
+//
+// The trigrams are taken from the normalized content of the words (see
+// `RdfEscaping::normalizedContentFromLiteralOrIri`, so without the quotes and
+// the language tag or datatype of literals) after converting the ASCII letters
+// to lowercase, so that the index can also be used for case-insensitive
+// filters. The posting lists are stored as gaps using the `Simple8bCode`.
+//
+// On disk, the encoded posting lists are followed by the metadata (the members
+// below) and the offset of the metadata. Only the metadata is kept in RAM, the
+// posting lists are read from the file when they are needed.
+class TrigramIndex {
+ public:
+  using Trigram = uint32_t;
+
+ private:
+  // The distinct trigrams in ascending order. The posting list of
+  // `trigrams_[i]` has `listSizes_[i]` elements and is stored in the bytes
+  // `[listOffsets_[i], listOffsets_[i + 1])` of the file, so `listOffsets_`
+  // has one more element than `trigrams_`.
+  std::vector<Trigram> trigrams_;
+  std::vector<uint64_t> listSizes_;
+  std::vector<uint64_t> listOffsets_;
+  // Bit `i` is set iff the word with index `i` is a literal. This is needed to
+  // evaluate filters on the words that are not candidates.
+  std::vector<uint64_t> isLiteral_;
+  uint64_t numWords_ = 0;
+  mutable ad_utility::File file_;
+
+ public:
+  // Return the distinct trigrams of the `text` (after converting the ASCII
+  // letters to lowercase) in ascending order.
+  static std::vector<Trigram> getTrigrams(std::string_view text);
+
+  // Return the indices (in ascending order) of the words that contain all the
+  // trigrams of all the `substrings`. This is a superset of the words that
+  // contain all the `substrings`, ignoring the case of ASCII letters. Return
+  // `std::nullopt` if none of the `substrings` has three or more bytes.
+  std::optional<std::vector<uint64_t>> getCandidates(
+      const std::vector<std::string>& substrings) const;
+
+  // An upper bound for the size of `getCandidates(substrings)` that is much
+  // cheaper to compute (the size of the shortest posting list).
+  std::optional<uint64_t> getNumCandidatesUpperBound(
+      const std::vector<std::string>& substrings) const;
+
+  bool isLiteral(uint64_t index) const {
+    return (isLiteral_.at(index / 64) >> (index % 64)) & 1;
+  }
+
+  // The number of words that were indexed.
+  uint64_t numWords() const { return numWords_; }
+
+  // Open the index that was written to the given file by a `Builder`. Only
+  // the metadata is read.
+  void readFromFile(const std::string& filename);
+
+  // The serialization of the metadata.
+  AD_SERIALIZE_FRIEND_FUNCTION(TrigramIndex) {
+    serializer | arg.trigrams_;
+    serializer | arg.listSizes_;
+    serializer | arg.listOffsets_;
+    serializer | arg.isLiteral_;
+    serializer | arg.numWords_;
+  }
+
+  // Build a `TrigramIndex` from the words of the vocabulary that are pushed
+  // in the order of their indices and write it to a file. The pairs of trigram
+  // and word index are sorted externally, so the builder uses at most the
+  // given amount of memory (except for the bit vector `isLiteral_` and the
+  // posting list of a single trigram during `finish`).
+  class Builder {
+   private:
+    // Compare the pairs of trigram and word index, which are both stored as
+    // the bits of an `Id`.
+    struct CompareBits {
+      bool operator()(const auto& a, const auto& b) const {
+        return std::pair{a[0].getBits(), a[1].getBits()} <
+               std::pair{b[0].getBits(), b[1].getBits()};
+      }
+    };
+    std::string filename_;
+    ad_utility::CompressedExternalIdTableSorter<CompareBits, 2> sorter_;
+    std::vector<uint64_t> isLiteral_;
+    uint64_t numWords_ = 0;
+
+   public:
+    Builder(std::string filename, ad_utility::MemorySize memoryLimit,
+            ad_utility::AllocatorWithLimit<Id> allocator);
+
+    // Add the next `word`, as it is stored in the vocabulary (e.g. with quotes
+    // and language tag).
+    void push(std::string_view word);
+
+    // Write the index to the file that was given to the constructor.
+    void finish() &&;
+  };
+
+ private:
+  // Decode the posting list of `trigrams_[i]`.
+  std::vector<uint64_t> getPostingList(size_t i) const;
+
+  // Return the positions in `trigrams_` of all the trigrams of the
+  // `substrings`, or `std::nullopt` if there are no such trigrams. If one of
+  // the trigrams is not contained in the index at all, the result is empty.
+  std::optional<std::vector<size_t>> findTrigrams(
+      const std::vector<std::string>& substrings) const;
+};
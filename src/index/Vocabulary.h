@@ -11,6 +11,7 @@
 #include <fstream>
 #include <functional>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -26,6 +27,8 @@
 #include "./CompressedString.h"
 #include "./StringSortComparator.h"
 #include "./vocabulary/CompressedVocabulary.h"
+#include "./vocabulary/FsstCompressor.h"
+#include "./vocabulary/PolymorphicVocabulary.h"
 #include "./vocabulary/PrefixCompressor.h"
 #include "./vocabulary/UnicodeVocabulary.h"
 #include "./vocabulary/VocabularyInMemory.h"
@@ -133,6 +136,12 @@ class Vocabulary {
   [[nodiscard]] std::optional<string> indexToOptionalString(
       IndexType idx) const;
 
+  //! Same as `indexToOptionalString` for each of the `indices`, which have to
+  //! be sorted. The externalized words are read in the order in which they are
+  //! stored on disk (see `VocabularyOnDisk::getWords`).
+  [[nodiscard]] std::vector<std::optional<string>> indicesToOptionalStrings(
+      std::span<const IndexType> indices) const;
+
   //! Get the word with the given idx.
   //! lvalue for compressedString and const& for string-based vocabulary
   AccessReturnType_t<StringType> at(IndexType idx) const;
@@ -244,10 +253,8 @@ class Vocabulary {
   // defaults to English
   vector<std::string> internalizedLangs_{"en"};
 
-  using PrefixCompressedVocabulary =
-      CompressedVocabulary<VocabularyInMemory, PrefixCompressor>;
   using InternalCompressedVocabulary =
-      UnicodeVocabulary<PrefixCompressedVocabulary, ComparatorType>;
+      UnicodeVocabulary<PolymorphicVocabulary, ComparatorType>;
   using InternalUncompressedVocabulary =
       UnicodeVocabulary<VocabularyInMemory, ComparatorType>;
   using InternalVocabulary =
@@ -272,10 +279,23 @@ class Vocabulary {
     return VocabularyInMemory::WordWriter{filename};
   }
 
+  // Create a writer for the internal vocabulary in the format of its current
+  // type (see `setInternalVocabularyType`). The `fsstCompressor` is only used
+  // by the front-coded vocabularies.
   template <typename U = StringType, typename = enable_if_compressed<U>>
-  auto makeCompressedWordWriter(const std::string& filename) {
+  auto makeCompressedWordWriter(
+      const std::string& filename,
+      std::optional<FsstCompressor> fsstCompressor = std::nullopt) {
     return internalVocabulary_.getUnderlyingVocabulary().makeDiskWriter(
-        filename);
+        filename, std::move(fsstCompressor));
+  }
+
+  // Set the type of the internal vocabulary. This clears the internal
+  // vocabulary and has to be called before `readFromFile`,
+  // `buildCodebookForPrefixCompression`, and `makeCompressedWordWriter`.
+  template <typename U = StringType, typename = enable_if_compressed<U>>
+  void setInternalVocabularyType(VocabularyType type) {
+    internalVocabulary_.getUnderlyingVocabulary().resetToType(type);
   }
 
   static auto makeUncompressedDiskIterator(const string& filename) {
@@ -288,6 +308,32 @@ using RdfsVocabulary =
 using TextVocabulary =
     Vocabulary<std::string, SimpleStringComparator, WordVocabIndex>;
 
+// _______________________________________________________________
+template <typename S, typename C, typename I>
+std::vector<std::optional<string>>
+Vocabulary<S, C, I>::indicesToOptionalStrings(
+    std::span<const IndexType> indices) const {
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(indices));
+  std::vector<std::optional<string>> result;
+  result.reserve(indices.size());
+  // The internal words come first.
+  auto firstExternal = std::ranges::lower_bound(
+      indices, internalVocabulary_.size(), std::less{},
+      [](IndexType idx) { return idx.get(); });
+  for (auto it = indices.begin(); it != firstExternal; ++it) {
+    result.emplace_back(internalVocabulary_[it->get()]);
+  }
+  std::vector<uint64_t> externalIndices;
+  externalIndices.reserve(indices.end() - firstExternal);
+  for (auto it = firstExternal; it != indices.end(); ++it) {
+    externalIndices.push_back(it->get() - internalVocabulary_.size());
+  }
+  auto externalWords =
+      externalVocabulary_.getUnderlyingVocabulary().getWords(externalIndices);
+  std::ranges::move(externalWords, std::back_inserter(result));
+  return result;
+}
+
 // _______________________________________________________________
 template <typename S, typename C, typename I>
 template <typename>
@@ -0,0 +1,70 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "global/IndexTypes.h"
+#include "util/Exception.h"
+#include "util/MemorySize/MemorySize.h"
+
+// For each word of the vocabulary (including the externalized words) whether a
+// filter on this word (for example `CONTAINS(?x, "berlin")`) is true, false, or
+// undefined. It is computed once per filter by `Index::getVocabularyMatches`,
+// after which the filter can be evaluated for each `VocabIndex` by looking up
+// two bits.
+class VocabularyMatches {
+ public:
+  static constexpr size_t BITS_PER_BLOCK = 64;
+
+ private:
+  // Bit `i` of `matches_` is set iff the filter is true for the word with
+  // index `i`, bit `i` of `isUndefined_` is set iff the filter is undefined.
+  std::vector<uint64_t> matches_;
+  std::vector<uint64_t> isUndefined_;
+  size_t size_;
+
+ public:
+  // Create the matches for `size` words, for all of which the filter is false.
+  explicit VocabularyMatches(size_t size)
+      : matches_((size + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK),
+        isUndefined_(matches_.size()),
+        size_{size} {}
+
+  size_t size() const { return size_; }
+
+  // Set the value for the word with index `i`. Concurrent calls are safe if
+  // they are for indices in different blocks of `BITS_PER_BLOCK` words.
+  void set(size_t i, std::optional<bool> value) {
+    AD_CONTRACT_CHECK(i < size_);
+    uint64_t bit = uint64_t{1} << (i % BITS_PER_BLOCK);
+    if (value.value_or(false)) {
+      matches_[i / BITS_PER_BLOCK] |= bit;
+    }
+    if (!value.has_value()) {
+      isUndefined_[i / BITS_PER_BLOCK] |= bit;
+    }
+  }
+
+  // Get the value for the word with the given `index`.
+  std::optional<bool> operator[](VocabIndex index) const {
+    size_t i = index.get();
+    AD_CONTRACT_CHECK(i < size_);
+    uint64_t bit = uint64_t{1} << (i % BITS_PER_BLOCK);
+    if (isUndefined_[i / BITS_PER_BLOCK] & bit) {
+      return std::nullopt;
+    }
+    return static_cast<bool>(matches_[i / BITS_PER_BLOCK] & bit);
+  }
+
+  // The size of the bitmaps, used for the cache in the `IndexImpl`.
+  struct SizeGetter {
+    ad_utility::MemorySize operator()(const VocabularyMatches& m) const {
+      return ad_utility::MemorySize::bytes(
+          (m.matches_.size() + m.isUndefined_.size()) * sizeof(uint64_t));
+    }
+  };
+};
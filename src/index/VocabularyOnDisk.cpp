@@ -48,6 +48,53 @@ std::optional<string> VocabularyOnDisk::operator[](uint64_t idx) const {
   return result;
 }
 
+// _____________________________________________________________________________
+vector<std::optional<string>> VocabularyOnDisk::getWords(
+    std::span<const uint64_t> ids) const {
+  AD_CONTRACT_CHECK(std::ranges::is_sorted(ids));
+  vector<std::optional<string>> result(ids.size());
+  if (_idsAndOffsets.size() == 0) {
+    return result;
+  }
+  // The positions of the found words in the `result`, and their offsets and
+  // sizes. As the `ids` are sorted, each search starts where the previous one
+  // ended.
+  vector<std::pair<size_t, OffsetAndSize>> found;
+  auto it = _idsAndOffsets.begin();
+  const auto end = _idsAndOffsets.end() - 1;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    it = std::lower_bound(it, end, IndexAndOffset{ids[i], 0});
+    if (it != end && it->_idx == ids[i]) {
+      found.emplace_back(
+          i, getOffsetAndSizeForIthElement(it - _idsAndOffsets.begin()));
+    }
+  }
+
+  // Read the words in ranges of words that are close to each other.
+  string buffer;
+  for (size_t begin = 0; begin < found.size();) {
+    uint64_t rangeBegin = found[begin].second._offset;
+    uint64_t rangeEnd = rangeBegin + found[begin].second._size;
+    size_t endOfRange = begin + 1;
+    for (; endOfRange < found.size(); ++endOfRange) {
+      const auto& [offset, size] = found[endOfRange].second;
+      if (offset > rangeEnd + MAX_GAP_BETWEEN_WORDS_READ_TOGETHER ||
+          offset + size - rangeBegin > MAX_NUM_BYTES_PER_READ) {
+        break;
+      }
+      rangeEnd = std::max(rangeEnd, offset + size);
+    }
+    buffer.resize(rangeEnd - rangeBegin);
+    _file.read(buffer.data(), buffer.size(), rangeBegin);
+    for (; begin < endOfRange; ++begin) {
+      const auto& [position, offsetAndSize] = found[begin];
+      result[position] = buffer.substr(offsetAndSize._offset - rangeBegin,
+                                       offsetAndSize._size);
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 template <typename Iterable>
 void VocabularyOnDisk::buildFromIterable(Iterable&& it,
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
@@ -72,6 +73,17 @@ class VocabularyOnDisk {
   /// `std::nullopt`
   std::optional<string> operator[](uint64_t idx) const;
 
+  /// Same as `operator[]` for each of the `ids`, which have to be sorted. Words
+  /// that are close to each other in the underlying file are read with a
+  /// single read, so this is much cheaper than a random access per ID.
+  vector<std::optional<string>> getWords(std::span<const uint64_t> ids) const;
+
+  /// Words whose distance in the underlying file is at most this many bytes
+  /// are read together by `getWords`, as long as a single read is at most
+  /// `MAX_NUM_BYTES_PER_READ` bytes.
+  static constexpr uint64_t MAX_GAP_BETWEEN_WORDS_READ_TOGETHER = 4096;
+  static constexpr uint64_t MAX_NUM_BYTES_PER_READ = 1 << 20;
+
   /// Get the number of words in the vocabulary.
   size_t size() const { return _size; }
 
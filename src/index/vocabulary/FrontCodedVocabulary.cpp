@@ -0,0 +1,138 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "./FrontCodedVocabulary.h"
+
+#include <algorithm>
+
+#include "util/Serializer/FileSerializer.h"
+
+// _____________________________________________________________________________
+std::string FrontCodedVocabulary::operator[](uint64_t i) const {
+  std::string result;
+  forEachWordInBlock(i / BLOCK_SIZE,
+                     [&result, indexInBlock = i % BLOCK_SIZE](
+                         const std::string& word, size_t j) {
+                       if (j < indexInBlock) {
+                         return true;
+                       }
+                       result = word;
+                       return false;
+                     });
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string FrontCodedVocabulary::getHead(size_t blockIndex) const {
+  return operator[](blockIndex * BLOCK_SIZE);
+}
+
+// _____________________________________________________________________________
+std::string FrontCodedVocabulary::encodeBlock(
+    const std::vector<std::string>& words,
+    const std::optional<FsstCompressor>& compressor) {
+  std::string block;
+  auto appendSuffix = [&block, &compressor](std::string_view suffix) {
+    if (compressor.has_value()) {
+      auto compressed = compressor->compress(suffix);
+      ad_utility::appendVarint(block, compressed.size());
+      block.append(compressed);
+    } else {
+      ad_utility::appendVarint(block, suffix.size());
+      block.append(suffix);
+    }
+  };
+  for (size_t i = 0; i < words.size(); ++i) {
+    std::string_view word = words[i];
+    if (i == 0) {
+      appendSuffix(word);
+      continue;
+    }
+    std::string_view previous = words[i - 1];
+    size_t prefixLength =
+        std::ranges::mismatch(word, previous).in1 - word.begin();
+    ad_utility::appendVarint(block, prefixLength);
+    appendSuffix(word.substr(prefixLength));
+  }
+  return block;
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::open(const std::string& filename) {
+  close();
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  serializer >> blocks_;
+  serializer >> numWords_;
+  bool hasCompressor;
+  serializer >> hasCompressor;
+  if (hasCompressor) {
+    FsstCompressor compressor;
+    serializer >> compressor;
+    compressor_ = std::move(compressor);
+  }
+  AD_CORRECTNESS_CHECK(blocks_.size() == (numWords_ + BLOCK_SIZE - 1) /
+                                             BLOCK_SIZE);
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::build(const std::vector<std::string>& words,
+                                 std::optional<FsstCompressor> compressor) {
+  std::vector<std::string> blocks;
+  std::vector<std::string> currentBlock;
+  for (size_t i = 0; i < words.size(); i += BLOCK_SIZE) {
+    currentBlock.assign(words.begin() + i,
+                        words.begin() + std::min(i + BLOCK_SIZE, words.size()));
+    blocks.push_back(encodeBlock(currentBlock, compressor));
+  }
+  blocks_ = CompactVectorOfStrings<char>{};
+  blocks_.build(blocks);
+  numWords_ = words.size();
+  compressor_ = std::move(compressor);
+}
+
+// _____________________________________________________________________________
+FrontCodedVocabulary::WordWriter::WordWriter(
+    const std::string& filename, std::optional<FsstCompressor> compressor)
+    : blockWriter_{filename}, compressor_{std::move(compressor)} {
+  currentBlock_.reserve(BLOCK_SIZE);
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::WordWriter::push(std::string_view word) {
+  AD_CONTRACT_CHECK(!finished_);
+  currentBlock_.emplace_back(word);
+  ++numWords_;
+  if (currentBlock_.size() == BLOCK_SIZE) {
+    auto block = encodeBlock(currentBlock_, compressor_);
+    blockWriter_.push(block.data(), block.size());
+    currentBlock_.clear();
+  }
+}
+
+// _____________________________________________________________________________
+void FrontCodedVocabulary::WordWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  if (!currentBlock_.empty()) {
+    auto block = encodeBlock(currentBlock_, compressor_);
+    blockWriter_.push(block.data(), block.size());
+  }
+  // The number of words and the compressor follow the blocks.
+  ad_utility::serialization::FileWriteSerializer serializer{
+      blockWriter_.finish()};
+  serializer << numWords_;
+  serializer << compressor_.has_value();
+  if (compressor_.has_value()) {
+    serializer << compressor_.value();
+  }
+}
+
+// _____________________________________________________________________________
+FrontCodedVocabulary::WordWriter::~WordWriter() {
+  ad_utility::terminateIfThrows(
+      [this]() { finish(); },
+      "Finishing the underlying file of a `FrontCodedVocabulary::WordWriter` "
+      "during destruction failed");
+}
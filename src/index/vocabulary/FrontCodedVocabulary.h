@@ -0,0 +1,187 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_FRONTCODEDVOCABULARY_H
+#define QLEVER_FRONTCODEDVOCABULARY_H
+
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "global/Pattern.h"
+#include "index/vocabulary/FsstCompressor.h"
+#include "index/vocabulary/VocabularyTypes.h"
+#include "util/Exception.h"
+#include "util/Varint.h"
+
+/// A vocabulary of sorted words that are stored in blocks of `BLOCK_SIZE`
+/// consecutive words with front coding: The first word of each block (the
+/// "head") is stored completely, each of the following words only stores the
+/// length of the prefix it shares with its predecessor and the remaining
+/// suffix. The heads and the suffixes can additionally be compressed with an
+/// `FsstCompressor`. All lengths are stored as varints.
+///
+/// The block of a word is found in O(1) via the offsets of the blocks, and
+/// `lower_bound` and `upper_bound` do a binary search on the heads followed by
+/// a linear scan of a single block.
+class FrontCodedVocabulary {
+ public:
+  static constexpr size_t BLOCK_SIZE = 16;
+
+ private:
+  // Each element is one encoded block.
+  CompactVectorOfStrings<char> blocks_;
+  uint64_t numWords_ = 0;
+  std::optional<FsstCompressor> compressor_;
+
+ public:
+  FrontCodedVocabulary() = default;
+  FrontCodedVocabulary(FrontCodedVocabulary&&) noexcept = default;
+  FrontCodedVocabulary& operator=(FrontCodedVocabulary&&) noexcept = default;
+
+  /// Return the `i`-th word. The behavior is undefined if `i >= size()`.
+  std::string operator[](uint64_t i) const;
+
+  [[nodiscard]] uint64_t size() const { return numWords_; }
+
+  /// Return the highest ID (= index) that occurs in this vocabulary. May only
+  /// be called if size() > 0.
+  [[nodiscard]] uint64_t getHighestId() const {
+    AD_CONTRACT_CHECK(size() > 0);
+    return size() - 1;
+  }
+
+  /// Return a `WordAndIndex` that points to the first entry that is equal or
+  /// greater than `word` wrt. the `comparator`. Only works correctly if the
+  /// words are sorted according to the comparator (the semantics are the same
+  /// as for `std::lower_bound`).
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex lower_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    return boundImpl([&comparator, &word](const std::string& element) {
+      return comparator(element, word);
+    });
+  }
+
+  /// Return a `WordAndIndex` that points to the first entry that is greater
+  /// than `word` wrt. the `comparator` (the semantics are the same as for
+  /// `std::upper_bound`).
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex upper_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    return boundImpl([&comparator, &word](const std::string& element) {
+      return !comparator(word, element);
+    });
+  }
+
+  /// Read the vocabulary from a file that was written by a `WordWriter`.
+  void open(const std::string& filename);
+
+  /// Clear the vocabulary.
+  void close() { *this = FrontCodedVocabulary{}; }
+
+  /// Initialize the vocabulary from the given `words`, which have to be sorted.
+  /// The words are compressed with the `compressor` if it is set.
+  void build(const std::vector<std::string>& words,
+             std::optional<FsstCompressor> compressor = std::nullopt);
+
+  /// The compressor of the heads and suffixes, `std::nullopt` if only front
+  /// coding is applied.
+  const std::optional<FsstCompressor>& getCompressor() const {
+    return compressor_;
+  }
+
+  /// Incrementally write a `FrontCodedVocabulary` to a file, one word at a
+  /// time in sorted order, without materializing it in RAM.
+  class WordWriter {
+   private:
+    detail::CompactStringVectorWriter<char> blockWriter_;
+    std::optional<FsstCompressor> compressor_;
+    std::vector<std::string> currentBlock_;
+    uint64_t numWords_ = 0;
+    bool finished_ = false;
+
+   public:
+    explicit WordWriter(const std::string& filename,
+                        std::optional<FsstCompressor> compressor);
+    void push(std::string_view word);
+    // After calls to `finish()` no more words can be pushed. `finish()` is
+    // implicitly also called by the destructor.
+    void finish();
+    ~WordWriter();
+  };
+
+ private:
+  // Encode the `words` of a single block.
+  static std::string encodeBlock(
+      const std::vector<std::string>& words,
+      const std::optional<FsstCompressor>& compressor);
+
+  // Return the first word of the block with the given index.
+  std::string getHead(size_t blockIndex) const;
+
+  // Decode the words of the block with the given index one after the other
+  // and call `function(word, indexInBlock)` for each of them, until the
+  // function returns `false`. The `word` is only valid during the call.
+  template <typename Function>
+  void forEachWordInBlock(size_t blockIndex, Function function) const;
+
+  // Return the first word for which `isBefore` is false, where `isBefore` has
+  // to be true for a (possibly empty) prefix of the words.
+  template <typename IsBefore>
+  WordAndIndex boundImpl(IsBefore isBefore) const {
+    auto blockIndices = std::views::iota(size_t{0}, blocks_.size());
+    // The first block whose head is not before the result.
+    size_t block = *std::ranges::partition_point(
+        blockIndices, [this, &isBefore](size_t blockIndex) {
+          return isBefore(getHead(blockIndex));
+        });
+    WordAndIndex result{std::nullopt, numWords_};
+    if (block < blocks_.size()) {
+      result = WordAndIndex{getHead(block), block * BLOCK_SIZE};
+    }
+    if (block == 0) {
+      return result;
+    }
+    // The result might be one of the words in the previous block.
+    forEachWordInBlock(block - 1, [&](const std::string& word, size_t i) {
+      if (i == 0 || isBefore(word)) {
+        return true;
+      }
+      result = WordAndIndex{word, (block - 1) * BLOCK_SIZE + i};
+      return false;
+    });
+    return result;
+  }
+};
+
+// _____________________________________________________________________________
+template <typename Function>
+void FrontCodedVocabulary::forEachWordInBlock(size_t blockIndex,
+                                              Function function) const {
+  std::string_view block = blocks_[blockIndex];
+  const char* ptr = block.data();
+  const char* end = ptr + block.size();
+  std::string word;
+  for (size_t i = 0; ptr != end; ++i) {
+    size_t prefixLength = i == 0 ? 0 : ad_utility::readVarint(ptr);
+    size_t suffixLength = ad_utility::readVarint(ptr);
+    AD_CORRECTNESS_CHECK(prefixLength <= word.size());
+    word.resize(prefixLength);
+    std::string_view suffix{ptr, suffixLength};
+    if (compressor_.has_value()) {
+      compressor_->decompress(suffix, word);
+    } else {
+      word.append(suffix);
+    }
+    ptr += suffixLength;
+    if (!function(std::as_const(word), i)) {
+      return;
+    }
+  }
+}
+
+#endif  // QLEVER_FRONTCODEDVOCABULARY_H
@@ -0,0 +1,126 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "./FsstCompressor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "util/Exception.h"
+#include "util/HashMap.h"
+
+// _____________________________________________________________________________
+FsstCompressor::FsstCompressor(std::vector<std::string> symbols)
+    : symbols_{std::move(symbols)} {
+  buildLookupTables();
+}
+
+// _____________________________________________________________________________
+void FsstCompressor::buildLookupTables() {
+  AD_CONTRACT_CHECK(symbols_.size() <= MAX_NUM_SYMBOLS);
+  for (auto& codes : codesByFirstByte_) {
+    codes.clear();
+  }
+  symbolBytes_.fill(0);
+  symbolLengths_.fill(0);
+  for (size_t code = 0; code < symbols_.size(); ++code) {
+    const auto& symbol = symbols_[code];
+    AD_CONTRACT_CHECK(!symbol.empty() && symbol.size() <= MAX_SYMBOL_LENGTH);
+    std::memcpy(&symbolBytes_[code], symbol.data(), symbol.size());
+    symbolLengths_[code] = static_cast<uint8_t>(symbol.size());
+    codesByFirstByte_[static_cast<uint8_t>(symbol[0])].push_back(
+        static_cast<uint8_t>(code));
+  }
+  for (auto& codes : codesByFirstByte_) {
+    std::ranges::stable_sort(codes, std::greater{}, [this](uint8_t code) {
+      return symbolLengths_[code];
+    });
+  }
+}
+
+// _____________________________________________________________________________
+template <typename Function>
+void FsstCompressor::forEachSymbol(std::string_view word,
+                                   Function function) const {
+  size_t i = 0;
+  while (i < word.size()) {
+    auto rest = word.substr(i);
+    size_t length = 1;
+    std::optional<uint8_t> code;
+    const auto& candidates = codesByFirstByte_[static_cast<uint8_t>(rest[0])];
+    for (uint8_t candidate : candidates) {
+      if (rest.starts_with(symbols_[candidate])) {
+        code = candidate;
+        length = symbolLengths_[candidate];
+        break;
+      }
+    }
+    function(rest.substr(0, length), code);
+    i += length;
+  }
+}
+
+// _____________________________________________________________________________
+std::string FsstCompressor::compress(std::string_view word) const {
+  std::string result;
+  result.reserve(word.size());
+  auto appendCode = [&result](std::string_view symbol,
+                              std::optional<uint8_t> code) {
+    if (code.has_value()) {
+      result.push_back(static_cast<char>(code.value()));
+    } else {
+      result.push_back(static_cast<char>(ESCAPE_CODE));
+      result.push_back(symbol[0]);
+    }
+  };
+  forEachSymbol(word, appendCode);
+  return result;
+}
+
+// _____________________________________________________________________________
+FsstCompressor FsstCompressor::train(const std::vector<std::string>& sample) {
+  FsstCompressor compressor;
+  for (size_t iteration = 0; iteration < NUM_TRAINING_ITERATIONS; ++iteration) {
+    // The number of bytes that each candidate would have covered in the
+    // compression of the sample with the current table. The candidates are
+    // the symbols of the current table, the escaped bytes, and the
+    // concatenations of two adjacent symbols.
+    ad_utility::HashMap<std::string, size_t> gains;
+    std::string concatenation;
+    for (const auto& word : sample) {
+      std::string_view previous;
+      compressor.forEachSymbol(
+          word, [&](std::string_view symbol, std::optional<uint8_t>) {
+            gains[std::string{symbol}] += symbol.size();
+            if (!previous.empty() &&
+                previous.size() + symbol.size() <= MAX_SYMBOL_LENGTH) {
+              concatenation = previous;
+              concatenation.append(symbol);
+              gains[concatenation] += concatenation.size();
+            }
+            previous = symbol;
+          });
+    }
+    std::vector<std::pair<size_t, std::string>> candidates;
+    candidates.reserve(gains.size());
+    for (auto& [symbol, gain] : gains) {
+      // An escaped byte takes two bytes, so the gain of a symbol for a single
+      // byte is doubled.
+      candidates.emplace_back(symbol.size() == 1 ? 2 * gain : gain, symbol);
+    }
+    // Sort by decreasing gain, ties are broken by the symbol to make the
+    // result deterministic.
+    auto numSymbols = std::min(MAX_NUM_SYMBOLS, candidates.size());
+    std::ranges::partial_sort(
+        candidates, candidates.begin() + numSymbols,
+        [](const auto& a, const auto& b) {
+          return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+    std::vector<std::string> symbols;
+    for (size_t i = 0; i < numSymbols; ++i) {
+      symbols.push_back(std::move(candidates[i].second));
+    }
+    compressor = FsstCompressor{std::move(symbols)};
+  }
+  return compressor;
+}
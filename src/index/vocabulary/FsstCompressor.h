@@ -0,0 +1,135 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_FSSTCOMPRESSOR_H
+#define QLEVER_FSSTCOMPRESSOR_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+/// Compression and decompression of short strings with a static table of
+/// symbols, following FSST ("Fast Static Symbol Table", Boncz, Neumann and
+/// Leis, VLDB 2020). Each of the (at most 255) symbols is a string of 1 to 8
+/// bytes that is replaced by a single byte code. A byte that is not covered by
+/// a symbol is escaped by the code `ESCAPE_CODE`. The symbol table is trained
+/// on a sample of the strings that are to be compressed (see `train`).
+/// Decompression is a single table lookup and an 8-byte copy per code.
+class FsstCompressor {
+ public:
+  static constexpr size_t MAX_SYMBOL_LENGTH = 8;
+  static constexpr size_t MAX_NUM_SYMBOLS = 255;
+  static constexpr uint8_t ESCAPE_CODE = 255;
+  static constexpr size_t NUM_TRAINING_ITERATIONS = 5;
+  // The number of words that `trainOnSample` draws from its input.
+  static constexpr size_t NUM_TRAINING_WORDS = 1 << 14;
+
+ private:
+  // The symbols, the index of a symbol is its code.
+  std::vector<std::string> symbols_;
+
+  // The following members are derived from the `symbols_`.
+  // For each byte the codes of the symbols that start with this byte, the
+  // longest symbols first.
+  std::array<std::vector<uint8_t>, 256> codesByFirstByte_;
+  // The bytes of each symbol padded with zeros and the length of each symbol.
+  std::array<uint64_t, 256> symbolBytes_{};
+  std::array<uint8_t, 256> symbolLengths_{};
+
+ public:
+  /// Create a compressor without any symbols (each byte is escaped).
+  FsstCompressor() = default;
+
+  /// Create a compressor from the given `symbols`. There may be at most
+  /// `MAX_NUM_SYMBOLS` symbols, each with 1 to `MAX_SYMBOL_LENGTH` bytes.
+  explicit FsstCompressor(std::vector<std::string> symbols);
+
+  /// Build a symbol table for the `sample`. In each of the
+  /// `NUM_TRAINING_ITERATIONS` iterations, the sample is compressed with the
+  /// current table and the next table is formed by the symbols and the
+  /// concatenations of adjacent symbols that save the most bytes.
+  static FsstCompressor train(const std::vector<std::string>& sample);
+
+  /// Draw a uniform random sample of `NUM_TRAINING_WORDS` words from the
+  /// `words` (any input range of strings, e.g. a generator that reads a
+  /// vocabulary from disk) and `train` on it.
+  template <typename WordRange>
+  static FsstCompressor trainOnSample(WordRange&& words) {
+    // Reservoir sampling with a fixed seed to make the index build
+    // deterministic.
+    std::vector<std::string> sample;
+    std::mt19937_64 randomEngine{42};
+    size_t numWordsSeen = 0;
+    for (const auto& word : words) {
+      if (sample.size() < NUM_TRAINING_WORDS) {
+        sample.emplace_back(word);
+      } else {
+        size_t i = randomEngine() % (numWordsSeen + 1);
+        if (i < NUM_TRAINING_WORDS) {
+          sample[i] = std::string{word};
+        }
+      }
+      ++numWordsSeen;
+    }
+    return train(sample);
+  }
+
+  /// Compress the given `word`.
+  [[nodiscard]] std::string compress(std::string_view word) const;
+
+  /// Append the decompression of `compressed` to the `target`.
+  void decompress(std::string_view compressed, std::string& target) const {
+    size_t initialSize = target.size();
+    // Each code yields at most `MAX_SYMBOL_LENGTH` bytes, so we can always
+    // copy the full 8 bytes of a symbol.
+    target.resize(initialSize + compressed.size() * MAX_SYMBOL_LENGTH);
+    char* out = target.data() + initialSize;
+    for (size_t i = 0; i < compressed.size(); ++i) {
+      auto code = static_cast<uint8_t>(compressed[i]);
+      if (code == ESCAPE_CODE) [[unlikely]] {
+        *out++ = compressed[++i];
+      } else {
+        std::memcpy(out, &symbolBytes_[code], MAX_SYMBOL_LENGTH);
+        out += symbolLengths_[code];
+      }
+    }
+    target.resize(out - target.data());
+  }
+
+  /// Decompress the given `compressed` word.
+  [[nodiscard]] std::string decompress(std::string_view compressed) const {
+    std::string result;
+    decompress(compressed, result);
+    return result;
+  }
+
+  const std::vector<std::string>& symbols() const { return symbols_; }
+
+  AD_SERIALIZE_FRIEND_FUNCTION(FsstCompressor) {
+    serializer | arg.symbols_;
+    if constexpr (ad_utility::serialization::ReadSerializer<S>) {
+      arg.buildLookupTables();
+    }
+  }
+
+ private:
+  // Compute the lookup tables from the `symbols_`.
+  void buildLookupTables();
+
+  // Call `function(symbol, code)` for each symbol in the greedy compression of
+  // the `word` (the longest matching symbol first). For escaped bytes, the
+  // `symbol` is the byte and the `code` is `std::nullopt`.
+  template <typename Function>
+  void forEachSymbol(std::string_view word, Function function) const;
+};
+
+#endif  // QLEVER_FSSTCOMPRESSOR_H
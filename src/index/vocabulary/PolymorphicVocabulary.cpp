@@ -0,0 +1,40 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "./PolymorphicVocabulary.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <array>
+#include <utility>
+
+namespace {
+constexpr std::array<std::pair<VocabularyType, std::string_view>, 3>
+    vocabularyTypeNames{
+        {{VocabularyType::PrefixCompressed, "prefix-compressed"},
+         {VocabularyType::FrontCoded, "front-coded"},
+         {VocabularyType::FrontCodedFsst, "front-coded-fsst"}}};
+}  // namespace
+
+// _____________________________________________________________________________
+VocabularyType vocabularyTypeFromString(std::string_view name) {
+  for (const auto& [type, typeName] : vocabularyTypeNames) {
+    if (typeName == name) {
+      return type;
+    }
+  }
+  AD_THROW(absl::StrCat(
+      "\"", name,
+      "\" is not a valid vocabulary type, the valid types are "
+      "\"prefix-compressed\", \"front-coded\", and \"front-coded-fsst\""));
+}
+
+// _____________________________________________________________________________
+std::string_view toString(VocabularyType type) {
+  for (const auto& [t, typeName] : vocabularyTypeNames) {
+    if (t == type) {
+      return typeName;
+    }
+  }
+  AD_FAIL();
+}
@@ -0,0 +1,161 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_POLYMORPHICVOCABULARY_H
+#define QLEVER_POLYMORPHICVOCABULARY_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "index/vocabulary/CompressedVocabulary.h"
+#include "index/vocabulary/FrontCodedVocabulary.h"
+#include "index/vocabulary/FsstCompressor.h"
+#include "index/vocabulary/PrefixCompressor.h"
+#include "index/vocabulary/VocabularyInMemory.h"
+#include "util/Exception.h"
+
+/// The different implementations of the compressed internal vocabulary. The
+/// type is chosen when the index is built and stored in the configuration of
+/// the index.
+enum class VocabularyType { PrefixCompressed, FrontCoded, FrontCodedFsst };
+
+/// Conversion from and to the names of the `VocabularyType`s that are used in
+/// the configuration of the index and on the command line of the index
+/// builder. Throw if the name is unknown.
+VocabularyType vocabularyTypeFromString(std::string_view name);
+std::string_view toString(VocabularyType type);
+
+/// A compressed vocabulary whose implementation (see `VocabularyType`) is
+/// chosen at runtime. All calls are dispatched via `std::visit`.
+class PolymorphicVocabulary {
+ public:
+  using PrefixCompressedVocabulary =
+      CompressedVocabulary<VocabularyInMemory, PrefixCompressor>;
+
+ private:
+  std::variant<PrefixCompressedVocabulary, FrontCodedVocabulary> vocabulary_;
+
+ public:
+  /// Clear the vocabulary and change its type. The default type is
+  /// `PrefixCompressed`.
+  void resetToType(VocabularyType type) {
+    if (type == VocabularyType::PrefixCompressed) {
+      vocabulary_.emplace<PrefixCompressedVocabulary>();
+    } else {
+      vocabulary_.emplace<FrontCodedVocabulary>();
+    }
+  }
+
+  std::string operator[](uint64_t id) const {
+    return std::visit([id](const auto& v) { return std::string{v[id]}; },
+                      vocabulary_);
+  }
+
+  [[nodiscard]] uint64_t size() const {
+    return std::visit([](const auto& v) { return v.size(); }, vocabulary_);
+  }
+
+  [[nodiscard]] uint64_t getHighestId() const {
+    return std::visit([](const auto& v) { return v.getHighestId(); },
+                      vocabulary_);
+  }
+
+  /// Same as `lower_bound` of the underlying vocabularies.
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex lower_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    return std::visit(
+        [&](const auto& v) { return v.lower_bound(word, comparator); },
+        vocabulary_);
+  }
+
+  /// Same as `upper_bound` of the underlying vocabularies.
+  template <typename InternalStringType, typename Comparator>
+  WordAndIndex upper_bound(const InternalStringType& word,
+                           Comparator comparator) const {
+    return std::visit(
+        [&](const auto& v) { return v.upper_bound(word, comparator); },
+        vocabulary_);
+  }
+
+  /// Open the vocabulary from a file that was written by a `WordWriter` for
+  /// the current type of the vocabulary.
+  void open(const std::string& filename) {
+    std::visit([&filename](auto& v) { v.open(filename); }, vocabulary_);
+  }
+
+  void close() {
+    std::visit([](auto& v) { v.close(); }, vocabulary_);
+  }
+
+  void build(const std::vector<std::string>& words) {
+    std::visit([&words](auto& v) { v.build(words); }, vocabulary_);
+  }
+
+  /// The codebook of the prefix compression. May only be called if the type
+  /// of the vocabulary is `PrefixCompressed`.
+  PrefixCompressor& getCompressor() {
+    AD_CONTRACT_CHECK(
+        std::holds_alternative<PrefixCompressedVocabulary>(vocabulary_));
+    return std::get<PrefixCompressedVocabulary>(vocabulary_).getCompressor();
+  }
+  const PrefixCompressor& getCompressor() const {
+    AD_CONTRACT_CHECK(
+        std::holds_alternative<PrefixCompressedVocabulary>(vocabulary_));
+    return std::get<PrefixCompressedVocabulary>(vocabulary_).getCompressor();
+  }
+
+  /// Allows the incremental writing of the words (in sorted order) to disk in
+  /// the format of the current type of the vocabulary.
+  class WordWriter {
+   private:
+    std::variant<std::monostate,
+                 PrefixCompressedVocabulary::DiskWriterFromUncompressedWords,
+                 FrontCodedVocabulary::WordWriter>
+        writer_;
+
+   public:
+    WordWriter(const PolymorphicVocabulary& vocabulary,
+               const std::string& filename,
+               std::optional<FsstCompressor> fsstCompressor) {
+      using P = PrefixCompressedVocabulary;
+      if (const auto* v = std::get_if<P>(&vocabulary.vocabulary_)) {
+        writer_.emplace<1>(v->getCompressor(), filename);
+      } else {
+        writer_.emplace<2>(filename, std::move(fsstCompressor));
+      }
+    }
+    void push(std::string_view word) {
+      std::visit(
+          [word]<typename W>(W& writer) {
+            if constexpr (!std::is_same_v<W, std::monostate>) {
+              writer.push(word);
+            }
+          },
+          writer_);
+    }
+    void finish() {
+      std::visit(
+          []<typename W>(W& writer) {
+            if constexpr (!std::is_same_v<W, std::monostate>) {
+              writer.finish();
+            }
+          },
+          writer_);
+    }
+  };
+
+  /// Create a `WordWriter` for the current type of the vocabulary. The
+  /// `fsstCompressor` is only used by the front-coded vocabulary (if it is
+  /// `std::nullopt`, the words are only front coded).
+  WordWriter makeDiskWriter(
+      const std::string& filename,
+      std::optional<FsstCompressor> fsstCompressor = std::nullopt) const {
+    return WordWriter{*this, filename, std::move(fsstCompressor)};
+  }
+};
+
+#endif  // QLEVER_POLYMORPHICVOCABULARY_H
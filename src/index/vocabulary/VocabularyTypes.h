@@ -5,7 +5,10 @@
 #ifndef QLEVER_VOCABULARYTYPES_H
 #define QLEVER_VOCABULARYTYPES_H
 
+#include <cstdint>
 #include <optional>
+#include <ostream>
+#include <string>
 
 /// A word and its index in the vocabulary from which it was obtained. A word
 /// that is larger than all words in the vocabulary is represented by
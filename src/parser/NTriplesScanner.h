@@ -0,0 +1,277 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Helpers for the N-Triples fast path of the `TurtleParser`. The input is
+// processed in blocks of 64 bytes. For each block we compute one 64-bit mask
+// per "interesting" character (bit `i` is set iff the `i`-th byte of the block
+// is that character), using SIMD instructions when they are available. The
+// positions of the structural characters of an N-Triples line can then be
+// found with a few bit operations per block instead of a branch per byte. This
+// is the classification technique used by simdjson (Langdale and Lemire,
+// "Parsing Gigabytes of JSON per Second", 2019).
+namespace NTriplesScanner {
+
+static constexpr size_t BLOCK_SIZE = 64;
+static constexpr size_t npos = std::string_view::npos;
+
+// The character masks of a single block of (at most) 64 bytes.
+struct BlockMasks {
+  uint64_t lessThan_ = 0;
+  uint64_t greaterThan_ = 0;
+  uint64_t quote_ = 0;
+  uint64_t backslash_ = 0;
+  uint64_t newline_ = 0;
+  uint64_t carriageReturn_ = 0;
+  // Space and tab.
+  uint64_t whitespace_ = 0;
+  // The characters that must not occur unescaped inside an IRIREF, namely
+  // `<>"{}|^`, the backtick, and all the bytes <= 0x20 (which includes the
+  // whitespace and the newlines). The backslash is not contained, as it is
+  // allowed as the start of a numeric escape sequence.
+  uint64_t invalidInIri_ = 0;
+};
+
+namespace detail {
+#if defined(__AVX2__)
+// Return the mask of the bytes in `lo` (bits 0-31) and `hi` (bits 32-63) that
+// are equal to `c`.
+inline uint64_t equalMask(__m256i lo, __m256i hi, char c) {
+  const __m256i pattern = _mm256_set1_epi8(c);
+  uint64_t low = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+  uint64_t high = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern)));
+  return low | (high << 32);
+}
+
+// Return the mask of the bytes in `lo` and `hi` that are <= `c` (unsigned).
+inline uint64_t lessOrEqualMask(__m256i lo, __m256i hi, char c) {
+  const __m256i pattern = _mm256_set1_epi8(c);
+  auto mask = [&pattern](__m256i part) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_min_epu8(part, pattern), part)));
+  };
+  return static_cast<uint64_t>(mask(lo)) |
+         (static_cast<uint64_t>(mask(hi)) << 32);
+}
+#elif defined(__SSE2__)
+// Return the mask of the bytes in the four 16-byte `parts` that are equal to
+// `c`.
+inline uint64_t equalMask(const __m128i* parts, char c) {
+  const __m128i pattern = _mm_set1_epi8(c);
+  uint64_t result = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    uint64_t mask = static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(parts[i], pattern)));
+    result |= mask << (16 * i);
+  }
+  return result;
+}
+
+// Return the mask of the bytes in the four 16-byte `parts` that are <= `c`
+// (unsigned).
+inline uint64_t lessOrEqualMask(const __m128i* parts, char c) {
+  const __m128i pattern = _mm_set1_epi8(c);
+  uint64_t result = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    uint64_t mask = static_cast<uint16_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_min_epu8(parts[i], pattern), parts[i])));
+    result |= mask << (16 * i);
+  }
+  return result;
+}
+#endif
+}  // namespace detail
+
+// Classify the 64 bytes starting at `data`, which must all be readable.
+inline BlockMasks classifyFullBlock(const char* data) {
+  BlockMasks masks;
+#if defined(__AVX2__)
+  const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+  const __m256i hi =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32));
+  auto eq = [&lo, &hi](char c) { return detail::equalMask(lo, hi, c); };
+  auto le = [&lo, &hi](char c) {
+    return detail::lessOrEqualMask(lo, hi, c);
+  };
+#elif defined(__SSE2__)
+  __m128i parts[4];
+  for (size_t i = 0; i < 4; ++i) {
+    parts[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+  }
+  auto eq = [&parts](char c) { return detail::equalMask(parts, c); };
+  auto le = [&parts](char c) { return detail::lessOrEqualMask(parts, c); };
+#else
+  auto eq = [data](char c) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+      result |= static_cast<uint64_t>(data[i] == c) << i;
+    }
+    return result;
+  };
+  auto le = [data](char c) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+      result |= static_cast<uint64_t>(static_cast<unsigned char>(data[i]) <=
+                                      static_cast<unsigned char>(c))
+                << i;
+    }
+    return result;
+  };
+#endif
+  masks.lessThan_ = eq('<');
+  masks.greaterThan_ = eq('>');
+  masks.quote_ = eq('"');
+  masks.backslash_ = eq('\\');
+  masks.newline_ = eq('\n');
+  masks.carriageReturn_ = eq('\r');
+  masks.whitespace_ = eq(' ') | eq('\t');
+  masks.invalidInIri_ = masks.lessThan_ | masks.greaterThan_ | masks.quote_ |
+                        eq('{') | eq('}') | eq('|') | eq('^') | eq('`') |
+                        le(' ');
+  return masks;
+}
+
+// Classify the block of `input` that starts at `pos`. If fewer than 64 bytes
+// are left, the remainder is copied to a zero-padded buffer first, and the
+// bits that correspond to positions after the end of `input` are cleared.
+inline BlockMasks classifyBlock(std::string_view input, size_t pos) {
+  if (pos + BLOCK_SIZE <= input.size()) {
+    return classifyFullBlock(input.data() + pos);
+  }
+  char buffer[BLOCK_SIZE] = {};
+  size_t numBytes = input.size() - pos;
+  std::memcpy(buffer, input.data() + pos, numBytes);
+  BlockMasks masks = classifyFullBlock(buffer);
+  // The padding bytes are <= 0x20 and therefore set in `invalidInIri_`.
+  masks.invalidInIri_ &= (uint64_t{1} << numBytes) - 1;
+  return masks;
+}
+
+// Given the `backslash` mask of a block, return the mask of all the bytes that
+// are escaped, i.e. that are preceded by an odd number of consecutive
+// backslashes. `previousBlockEndsWithEscape` is the carry between consecutive
+// blocks; it must be `false` for the first block and is updated by this
+// function. This is the branchless algorithm from simdjson.
+inline uint64_t computeEscaped(uint64_t backslash,
+                               bool& previousBlockEndsWithEscape) {
+  constexpr uint64_t evenBits = 0x5555555555555555ULL;
+  uint64_t carry = previousBlockEndsWithEscape;
+  // A backslash that is itself escaped doesn't start a new sequence.
+  backslash &= ~carry;
+  uint64_t followsEscape = (backslash << 1) | carry;
+  uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+  uint64_t sequencesStartingOnEvenBits;
+  previousBlockEndsWithEscape = __builtin_add_overflow(
+      oddSequenceStarts, backslash, &sequencesStartingOnEvenBits);
+  uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+  return (evenBits ^ invertMask) & followsEscape;
+}
+
+// Return the position of the first byte at or after `pos` in `input` that is
+// set in the mask `getMask(BlockMasks)`, or `npos` if there is no such byte.
+template <typename GetMask>
+size_t findFirst(std::string_view input, size_t pos, GetMask getMask) {
+  while (pos < input.size()) {
+    uint64_t mask = getMask(classifyBlock(input, pos));
+    if (mask != 0) {
+      return pos + std::countr_zero(mask);
+    }
+    pos += BLOCK_SIZE;
+  }
+  return npos;
+}
+
+// Return the position of the first unescaped `"` at or after `pos` in `input`,
+// or `npos` if there is none or if there is a raw `\n` or `\r` before it (which
+// is not allowed in an N-Triples literal). The byte at `pos` must not be
+// escaped by the bytes before `pos`, which is the case directly after an
+// opening quote.
+inline size_t findClosingQuote(std::string_view input, size_t pos) {
+  bool previousBlockEndsWithEscape = false;
+  while (pos < input.size()) {
+    BlockMasks masks = classifyBlock(input, pos);
+    uint64_t escaped =
+        computeEscaped(masks.backslash_, previousBlockEndsWithEscape);
+    uint64_t quotes = masks.quote_ & ~escaped;
+    uint64_t newlines = masks.newline_ | masks.carriageReturn_;
+    if ((quotes | newlines) != 0) {
+      size_t offset = std::countr_zero(quotes | newlines);
+      return (newlines >> offset) & 1 ? npos : pos + offset;
+    }
+    pos += BLOCK_SIZE;
+  }
+  return npos;
+}
+
+// Return the position of the first byte at or after `pos` that is neither a
+// space nor a tab (the only whitespace allowed inside an N-Triples line).
+inline size_t skipWhitespace(std::string_view input, size_t pos) {
+  // The whitespace between the terms of a triple is typically a single
+  // character, so a scalar loop is cheaper than classifying a block.
+  while (pos < input.size() && (input[pos] == ' ' || input[pos] == '\t')) {
+    ++pos;
+  }
+  return pos;
+}
+
+// Return true iff `input` contains a numeric escape sequence `\uXXXX` or
+// `\UXXXXXXXX` that starts at `pos`.
+inline bool isNumericEscape(std::string_view input, size_t pos) {
+  if (pos + 1 >= input.size() || input[pos] != '\\') {
+    return false;
+  }
+  size_t numHexDigits =
+      input[pos + 1] == 'u' ? 4 : (input[pos + 1] == 'U' ? 8 : 0);
+  if (numHexDigits == 0 || pos + 2 + numHexDigits > input.size()) {
+    return false;
+  }
+  return std::ranges::all_of(input.substr(pos + 2, numHexDigits), [](char c) {
+    return std::isxdigit(static_cast<unsigned char>(c)) != 0;
+  });
+}
+
+// If `input` contains a valid IRIREF `<...>` starting at `pos`, return the
+// position of its closing `>`, else return `npos`. The IRI must not contain
+// any of the characters from `BlockMasks::invalidInIri_`, and each backslash
+// must start a numeric escape sequence. This is the `IRIREF` production of
+// the N-Triples grammar, which is also accepted by the general rules.
+inline size_t findEndOfIriref(std::string_view input, size_t pos) {
+  if (pos >= input.size() || input[pos] != '<') {
+    return npos;
+  }
+  size_t end = pos;
+  while (true) {
+    end = findFirst(input, end + 1, [](const BlockMasks& m) {
+      return m.invalidInIri_ | m.backslash_;
+    });
+    if (end == npos) {
+      return npos;
+    }
+    if (input[end] == '>') {
+      return end;
+    }
+    if (!isNumericEscape(input, end)) {
+      return npos;
+    }
+    // Continue after the `u` or `U`, the hex digits are no special
+    // characters.
+    ++end;
+  }
+}
+}  // namespace NTriplesScanner
@@ -20,6 +20,10 @@ std::ostream& operator<<(std::ostream& stream, const TripleComponent& obj) {
           stream << value.rawContent();
         } else if constexpr (std::is_same_v<T, DateOrLargeYear>) {
           stream << "DATE: " << value.toStringAndType().first;
+        } else if constexpr (std::is_same_v<T, GeoPoint>) {
+          stream << "GEOPOINT: " << value.toStringAndType().first;
+        } else if constexpr (std::is_same_v<T, Decimal>) {
+          stream << "DECIMAL: " << value.toStringAndType().first;
         } else if constexpr (std::is_same_v<T, bool>) {
           stream << (value ? "true" : "false");
         } else {
@@ -68,6 +72,10 @@ std::optional<Id> TripleComponent::toValueIdIfNotString() const {
       return Id::makeUndefined();
     } else if constexpr (std::is_same_v<T, DateOrLargeYear>) {
       return Id::makeFromDate(value);
+    } else if constexpr (std::is_same_v<T, GeoPoint>) {
+      return Id::makeFromGeoPoint(value);
+    } else if constexpr (std::is_same_v<T, Decimal>) {
+      return Id::makeFromDecimal(value);
     } else if constexpr (std::is_same_v<T, Variable>) {
       // Cannot turn a variable into a ValueId.
       AD_FAIL();
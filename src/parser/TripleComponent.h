@@ -18,12 +18,16 @@
 #include "parser/RdfEscaping.h"
 #include "parser/data/Variable.h"
 #include "util/Date.h"
+#include "util/Decimal.h"
+#include "util/GeoPoint.h"
 #include "util/Exception.h"
 #include "util/Forward.h"
+#include "util/ShortString.h"
 
 /// A wrapper around a `std::variant` that can hold the different types that the
 /// subject, predicate, or object of a triple can have in the Turtle Parser.
-/// Those currently are `double` (xsd:double and xsd:decimal), `int64_t`
+/// Those currently are `double` (xsd:double and xsd:decimal), `Decimal`
+/// (xsd:decimal with at most six fractional digits), `int64_t`
 /// (xsd:int and xsd:integer) and `std::string` (variables, IRIs, and literals
 /// of any other type).
 class TripleComponent {
@@ -86,7 +90,8 @@ class TripleComponent {
  private:
   // The underlying variant type.
   using Variant = std::variant<std::string, double, int64_t, bool, UNDEF,
-                               Variable, Literal, DateOrLargeYear>;
+                               Variable, Literal, DateOrLargeYear, GeoPoint,
+                               Decimal>;
   Variant _variant;
 
  public:
@@ -221,9 +226,21 @@ class TripleComponent {
   /// the index building when we haven't built the vocabulary yet.
   [[nodiscard]] std::optional<Id> toValueIdIfNotString() const;
 
+  // Return the `ShortString` if this is a literal without a language tag or
+  // datatype that fits into an `Id` (see `ShortString`), else `std::nullopt`.
+  std::optional<ShortString> toShortString() const {
+    if (!isLiteral() || !getLiteral().datatypeOrLangtag().empty()) {
+      return std::nullopt;
+    }
+    return ShortString::fromLiteral(
+        getLiteral().normalizedLiteralContent().get());
+  }
+
   // Convert the `TripleComponent` to an ID. If the `TripleComponent` is a
-  // string, the IDs are resolved using the `vocabulary`. If a string is not
-  // found in the vocabulary, `std::nullopt` is returned.
+  // string, the IDs are resolved using the `vocabulary`. A short literal that
+  // is not found in the vocabulary is a `ShortString` (it might have been
+  // inlined during the index building). If another string is not found in the
+  // vocabulary, `std::nullopt` is returned.
   template <typename Vocabulary>
   [[nodiscard]] std::optional<Id> toValueId(
       const Vocabulary& vocabulary) const {
@@ -235,6 +252,8 @@ class TripleComponent {
         return Id::makeFromVocabIndex(idx);
       } else if (qlever::specialIds.contains(content)) {
         return qlever::specialIds.at(content);
+      } else if (auto shortString = toShortString()) {
+        return Id::makeFromShortString(shortString.value());
       } else {
         return std::nullopt;
       }
@@ -5,8 +5,10 @@
 
 #include "parser/TurtleParser.h"
 
+#include <cctype>
 #include <cstring>
 
+#include "parser/NTriplesScanner.h"
 #include "parser/RdfEscaping.h"
 #include "util/Conversions.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
@@ -16,9 +18,111 @@ using namespace std::chrono_literals;
 template <class T>
 bool TurtleParser<T>::statement() {
   tok_.skipWhitespaceAndComments();
+  if (parseAsNTriples() && nTriple()) {
+    return true;
+  }
   return directive() || (triples() && skip<TurtleTokenId::Dot>());
 }
 
+// _______________________________________________________________
+template <class T>
+bool TurtleParser<T>::nTriple() {
+  using namespace NTriplesScanner;
+  auto view = tok_.view();
+
+  // All positions are relative to `view`. Nothing is consumed before we know
+  // that the complete line can be handled by the fast path.
+  size_t subjectEnd = findEndOfIriref(view, 0);
+  if (subjectEnd == npos) {
+    return false;
+  }
+  size_t predicateBegin = skipWhitespace(view, subjectEnd + 1);
+  size_t predicateEnd = findEndOfIriref(view, predicateBegin);
+  if (predicateEnd == npos) {
+    return false;
+  }
+  size_t objectBegin = skipWhitespace(view, predicateEnd + 1);
+  if (objectBegin >= view.size()) {
+    return false;
+  }
+
+  auto iriAt = [&view](size_t begin, size_t end) {
+    return RdfEscaping::unescapeIriref(view.substr(begin, end + 1 - begin));
+  };
+
+  size_t objectEnd;
+  if (view[objectBegin] == '<') {
+    objectEnd = findEndOfIriref(view, objectBegin);
+    if (objectEnd == npos) {
+      return false;
+    }
+    lastParseResult_ = iriAt(objectBegin, objectEnd);
+  } else if (view[objectBegin] == '"') {
+    size_t closingQuote = findClosingQuote(view, objectBegin + 1);
+    if (closingQuote == npos) {
+      return false;
+    }
+    objectEnd = closingQuote;
+    auto literalString = RdfEscaping::normalizeRDFLiteral(
+        view.substr(objectBegin, closingQuote + 1 - objectBegin));
+    if (view.substr(closingQuote + 1).starts_with('@')) {
+      // Langtag: `@[a-zA-Z]+(-[a-zA-Z0-9]+)*`.
+      size_t pos = closingQuote + 1;
+      auto isAlpha = [&view](size_t i) {
+        return i < view.size() &&
+               std::isalpha(static_cast<unsigned char>(view[i])) != 0;
+      };
+      auto isAlnum = [&view](size_t i) {
+        return i < view.size() &&
+               std::isalnum(static_cast<unsigned char>(view[i])) != 0;
+      };
+      if (!isAlpha(pos + 1)) {
+        return false;
+      }
+      pos += 2;
+      while (isAlpha(pos)) {
+        ++pos;
+      }
+      while (pos + 1 < view.size() && view[pos] == '-' && isAlnum(pos + 1)) {
+        pos += 2;
+        while (isAlnum(pos)) {
+          ++pos;
+        }
+      }
+      objectEnd = pos - 1;
+      lastParseResult_ = TripleComponent::Literal{
+          literalString,
+          view.substr(closingQuote + 1, objectEnd - closingQuote)};
+    } else if (view.substr(closingQuote + 1).starts_with("^^")) {
+      size_t typeBegin = closingQuote + 3;
+      objectEnd = findEndOfIriref(view, typeBegin);
+      if (objectEnd == npos) {
+        return false;
+      }
+      typedLiteral(std::move(literalString), iriAt(typeBegin, objectEnd));
+    } else {
+      lastParseResult_ = TripleComponent::Literal{literalString, ""};
+    }
+  } else {
+    // Blank nodes and everything else that is not a plain N-Triples object
+    // is handled by the general rules.
+    return false;
+  }
+
+  size_t dot = skipWhitespace(view, objectEnd + 1);
+  if (dot >= view.size() || view[dot] != '.') {
+    // The call to `typedLiteral` might already have marked the triple as
+    // ignored, reset this s.t. the general rules start from a clean state.
+    currentTripleIgnoredBecauseOfInvalidLiteral_ = false;
+    return false;
+  }
+  activeSubject_ = iriAt(0, subjectEnd);
+  activePredicate_ = iriAt(predicateBegin, predicateEnd);
+  emitTriple();
+  tok_.remove_prefix(dot + 1);
+  return true;
+}
+
 // ______________________________________________________________
 template <class T>
 bool TurtleParser<T>::directive() {
@@ -292,6 +396,16 @@ void TurtleParser<T>::parseDoubleConstant(const std::string& input) {
   lastParseResult_ = result;
 }
 
+// ____________________________________________________________________________
+template <class T>
+void TurtleParser<T>::parseDecimalConstant(const std::string& input) {
+  if (auto decimal = Decimal::parse(input); decimal.has_value()) {
+    lastParseResult_ = decimal.value();
+  } else {
+    parseDoubleConstant(input);
+  }
+}
+
 // ____________________________________________________________________________
 template <class T>
 void TurtleParser<T>::parseIntegerConstant(const std::string& input) {
@@ -351,7 +465,7 @@ bool TurtleParser<T>::integer() {
 template <class T>
 bool TurtleParser<T>::decimal() {
   if (parseTerminal<TurtleTokenId::Decimal>()) {
-    parseDoubleConstant(lastParseResult_.getString());
+    parseDecimalConstant(lastParseResult_.getString());
     return true;
   } else {
     return false;
@@ -384,76 +498,91 @@ bool TurtleParser<T>::rdfLiteral() {
     // TODO<joka921> this allows spaces here since the ^^ is unique in the
     // sparql syntax. is this correct?
   } else if (skip<TurtleTokenId::DoubleCircumflex>() && check(iri())) {
-    const auto typeIri = std::move(lastParseResult_.getString());
-    auto type = stripAngleBrackets(typeIri);
-    std::string strippedLiteral{stripDoubleQuotes(literalString.get())};
-    try {
-      // TODO<joka921> clean this up by moving the check for the types to a
-      // separate module.
-      if (type == XSD_INT_TYPE || type == XSD_INTEGER_TYPE ||
-          type == XSD_NON_POSITIVE_INTEGER_TYPE ||
-          type == XSD_NEGATIVE_INTEGER_TYPE || type == XSD_LONG_TYPE ||
-          type == XSD_SHORT_TYPE || type == XSD_BYTE_TYPE ||
-          type == XSD_NON_NEGATIVE_INTEGER_TYPE ||
-          type == XSD_UNSIGNED_LONG_TYPE || type == XSD_UNSIGNED_INT_TYPE ||
-          type == XSD_UNSIGNED_SHORT_TYPE ||
-          type == XSD_POSITIVE_INTEGER_TYPE) {
-        parseIntegerConstant(strippedLiteral);
-      } else if (type == XSD_BOOLEAN_TYPE) {
-        if (strippedLiteral == "true") {
-          lastParseResult_ = true;
-        } else if (strippedLiteral == "false") {
-          lastParseResult_ = false;
-        } else {
-          LOG(DEBUG)
-              << literalString.get()
-              << " could not be parsed as a boolean object of type " << typeIri
-              << ". It is treated as a plain string literal without datatype "
-                 "instead"
-              << std::endl;
-          lastParseResult_ = TripleComponent::Literal{literalString};
-        }
-      } else if (type == XSD_DECIMAL_TYPE || type == XSD_DOUBLE_TYPE ||
-                 type == XSD_FLOAT_TYPE) {
-        parseDoubleConstant(strippedLiteral);
-      } else if (type == XSD_DATETIME_TYPE) {
-        lastParseResult_ = DateOrLargeYear::parseXsdDatetime(strippedLiteral);
-      } else if (type == XSD_DATE_TYPE) {
-        lastParseResult_ = DateOrLargeYear::parseXsdDate(strippedLiteral);
-      } else if (type == XSD_GYEARMONTH_TYPE) {
-        lastParseResult_ = DateOrLargeYear::parseGYearMonth(strippedLiteral);
-      } else if (type == XSD_GYEAR_TYPE) {
-        lastParseResult_ = DateOrLargeYear::parseGYear(strippedLiteral);
+    typedLiteral(std::move(literalString),
+                 std::move(lastParseResult_.getString()));
+    return true;
+  } else {
+    // It is okay to neither have a langtag nor an XSD datatype.
+    return true;
+  }
+}
+
+// ______________________________________________________________________
+template <class T>
+void TurtleParser<T>::typedLiteral(
+    RdfEscaping::NormalizedRDFString literalString, std::string typeIri) {
+  auto type = stripAngleBrackets(typeIri);
+  std::string strippedLiteral{stripDoubleQuotes(literalString.get())};
+  try {
+    // TODO<joka921> clean this up by moving the check for the types to a
+    // separate module.
+    if (type == XSD_INT_TYPE || type == XSD_INTEGER_TYPE ||
+        type == XSD_NON_POSITIVE_INTEGER_TYPE ||
+        type == XSD_NEGATIVE_INTEGER_TYPE || type == XSD_LONG_TYPE ||
+        type == XSD_SHORT_TYPE || type == XSD_BYTE_TYPE ||
+        type == XSD_NON_NEGATIVE_INTEGER_TYPE ||
+        type == XSD_UNSIGNED_LONG_TYPE || type == XSD_UNSIGNED_INT_TYPE ||
+        type == XSD_UNSIGNED_SHORT_TYPE ||
+        type == XSD_POSITIVE_INTEGER_TYPE) {
+      parseIntegerConstant(strippedLiteral);
+    } else if (type == XSD_BOOLEAN_TYPE) {
+      if (strippedLiteral == "true") {
+        lastParseResult_ = true;
+      } else if (strippedLiteral == "false") {
+        lastParseResult_ = false;
+      } else {
+        LOG(DEBUG)
+            << literalString.get()
+            << " could not be parsed as a boolean object of type " << typeIri
+            << ". It is treated as a plain string literal without datatype "
+               "instead"
+            << std::endl;
+        lastParseResult_ = TripleComponent::Literal{literalString};
+      }
+    } else if (type == XSD_DECIMAL_TYPE) {
+      parseDecimalConstant(strippedLiteral);
+    } else if (type == XSD_DOUBLE_TYPE || type == XSD_FLOAT_TYPE) {
+      parseDoubleConstant(strippedLiteral);
+    } else if (type == XSD_DATETIME_TYPE) {
+      lastParseResult_ = DateOrLargeYear::parseXsdDatetime(strippedLiteral);
+    } else if (type == XSD_DATE_TYPE) {
+      lastParseResult_ = DateOrLargeYear::parseXsdDate(strippedLiteral);
+    } else if (type == XSD_GYEARMONTH_TYPE) {
+      lastParseResult_ = DateOrLargeYear::parseGYearMonth(strippedLiteral);
+    } else if (type == XSD_GYEAR_TYPE) {
+      lastParseResult_ = DateOrLargeYear::parseGYear(strippedLiteral);
+    } else if (type == GEO_WKT_LITERAL) {
+      // Points are folded into the `ValueId`, all other geometries remain
+      // literals.
+      if (auto point = GeoPoint::parseWktPoint(strippedLiteral)) {
+        lastParseResult_ = point.value();
       } else {
         lastParseResult_ = TripleComponent::Literal{
             literalString, absl::StrCat("^^", typeIri)};
       }
-      return true;
-    } catch (const DateParseException&) {
-      LOG(DEBUG)
-          << literalString.get()
-          << " could not be parsed as a date object of type " << typeIri
-          << ". It is treated as a plain string literal without datatype "
-             "instead"
-          << std::endl;
-      lastParseResult_ = TripleComponent::Literal{literalString};
-      return true;
-    } catch (const DateOutOfRangeException& ex) {
-      LOG(DEBUG)
-          << literalString.get()
-          << " could not be parsed as a date object for the following reason: "
-          << ex.what()
-          << ". It is treated as a plain string literal without datatype "
-             "instead"
-          << std::endl;
-      lastParseResult_ = TripleComponent::Literal{literalString};
-      return true;
-    } catch (const std::exception& e) {
-      raise(e.what());
+    } else {
+      lastParseResult_ = TripleComponent::Literal{
+          literalString, absl::StrCat("^^", typeIri)};
     }
-  } else {
-    // It is okay to neither have a langtag nor an XSD datatype.
-    return true;
+  } catch (const DateParseException&) {
+    LOG(DEBUG)
+        << literalString.get()
+        << " could not be parsed as a date object of type " << typeIri
+        << ". It is treated as a plain string literal without datatype "
+           "instead"
+        << std::endl;
+    lastParseResult_ = TripleComponent::Literal{literalString};
+  } catch (const DateOutOfRangeException& ex) {
+    LOG(DEBUG)
+        << literalString.get()
+        << " could not be parsed as a date object for the following reason: "
+        << ex.what()
+        << ". It is treated as a plain string literal without datatype "
+           "instead"
+        << std::endl;
+    lastParseResult_ = TripleComponent::Literal{literalString};
+  } catch (const std::exception& e) {
+    raise(e.what());
   }
 }
 
@@ -843,6 +972,7 @@ void TurtleParallelParser<Tokenizer_T>::parseBatch(size_t parsePosition,
   try {
     TurtleStringParser<Tokenizer_T> parser;
     parser.prefixMap_ = this->prefixMap_;
+    parser.parseAsNTriples() = this->parseAsNTriples();
     parser.setPositionOffset(parsePosition);
     parser.setInputStream(std::move(batch));
     // TODO: raise error message if a prefix parsing fails;
@@ -67,6 +67,7 @@ class TurtleParserBase {
   TurtleParserIntegerOverflowBehavior integerOverflowBehavior_ =
       TurtleParserIntegerOverflowBehavior::Error;
   bool invalidLiteralsAreSkipped_ = false;
+  bool parseAsNTriples_ = false;
 
  public:
   virtual ~TurtleParserBase() = default;
@@ -84,6 +85,13 @@ class TurtleParserBase {
     return invalidLiteralsAreSkipped_;
   }
 
+  // If true, then the input is expected to consist (mostly) of N-Triples, i.e.
+  // one triple per line with IRIs in angle brackets and without prefixes. Such
+  // lines are then handled by a SIMD-based fast path (see
+  // `NTriplesScanner.h`). All other statements are still parsed by the full
+  // Turtle grammar, so this setting never changes the result of the parser.
+  bool& parseAsNTriples() { return parseAsNTriples_; }
+
   virtual void printAndResetQueueStatistics() {
     // This function only does something for the parallel parser (where it is
     // overridden).
@@ -220,6 +228,12 @@ class TurtleParser : public TurtleParserBase {
 
   bool statement();
 
+  // The fast path for a statement that is a single N-Triples line, see
+  // `parseAsNTriples()` above. If the next statement is not a line that the
+  // fast path can handle, return false without consuming any input, s.t. the
+  // statement can then be parsed by the general rules.
+  bool nTriple();
+
   // Log error message (with parse position) and throw parse exception.
   [[noreturn]] void raise(std::string_view error_message) {
     auto d = tok_.view();
@@ -273,6 +287,12 @@ class TurtleParser : public TurtleParserBase {
   bool prefixedName();
   bool stringParse();
 
+  // Set `lastParseResult_` to the literal `literalString^^typeIri`. Literals
+  // with a numeric, boolean or date datatype are converted to the
+  // corresponding value.
+  void typedLiteral(RdfEscaping::NormalizedRDFString literalString,
+                    std::string typeIri);
+
   // Terminal symbols from the grammar
   // Behavior of the functions is similar to the nonterminals (see above)
   bool iriref();
@@ -281,8 +301,10 @@ class TurtleParser : public TurtleParserBase {
   // The grammar rule is called "double" but this is a reserved name in C++.
   bool doubleParse();
 
-  // Two helper functions for the actual conversion from strings to numbers.
+  // Helper functions for the actual conversion from strings to numbers.
+  // Decimals that cannot be represented as a `Decimal` become doubles.
   void parseDoubleConstant(const std::string& input);
+  void parseDecimalConstant(const std::string& input);
   void parseIntegerConstant(const std::string& input);
 
   // This version only works if no escape sequences were used.
@@ -374,6 +396,7 @@ class TurtleParser : public TurtleParserBase {
   FRIEND_TEST(TurtleParserTest, booleanLiteral);
   FRIEND_TEST(TurtleParserTest, booleanLiteralLongForm);
   FRIEND_TEST(TurtleParserTest, collection);
+  FRIEND_TEST(TurtleParserTest, nTriple);
 };
 
 /**
@@ -506,9 +529,11 @@ class TurtleStreamParser : public TurtleParser<Tokenizer_T> {
  public:
   // Default construction needed for tests
   TurtleStreamParser() = default;
-  explicit TurtleStreamParser(const string& filename) {
+  explicit TurtleStreamParser(const string& filename,
+                              bool parseAsNTriples = false) {
     LOG(DEBUG) << "Initialize turtle parsing from uncompressed file or stream "
                << filename << std::endl;
+    this->parseAsNTriples() = parseAsNTriples;
     initialize(filename);
   }
 
@@ -568,8 +593,11 @@ class TurtleParallelParser : public TurtleParser<Tokenizer_T> {
 
   // If the `sleepTimeForTesting` is set, then after the initialization the
   // parser will sleep for the specified time before parsing each batch s.t.
-  // certain corner cases can be tested.
+  // certain corner cases can be tested. The `parseAsNTriples` flag has to be
+  // passed to the constructor (and not set later) because the parsing starts
+  // in the background as soon as the parser has been constructed.
   explicit TurtleParallelParser(const string& filename,
+                                bool parseAsNTriples = false,
                                 std::chrono::milliseconds sleepTimeForTesting =
                                     std::chrono::milliseconds{0})
       : sleepTimeForTesting_(sleepTimeForTesting) {
@@ -577,6 +605,7 @@ class TurtleParallelParser : public TurtleParser<Tokenizer_T> {
         << "Initialize parallel Turtle Parsing from uncompressed file or "
            "stream "
         << filename << std::endl;
+    this->parseAsNTriples() = parseAsNTriples;
     initialize(filename);
   }
 
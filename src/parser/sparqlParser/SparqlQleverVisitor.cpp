@@ -826,9 +826,17 @@ TripleComponent Visitor::visit(Parser::DataBlockValueContext* ctx) {
     return TurtleStringParser<TokenizerCtre>::parseTripleObject(
         visit(ctx->rdfLiteral()));
   } else if (ctx->numericLiteral()) {
+    auto value = visit(ctx->numericLiteral());
+    // Decimals are represented as in the index (see
+    // `TurtleParser::parseDecimalConstant`), s.t. the values are found.
+    if (std::holds_alternative<double>(value)) {
+      // Doubles like `1e3` are rejected by `Decimal::parse`.
+      if (auto decimal = Decimal::parse(ctx->numericLiteral()->getText())) {
+        return TripleComponent{decimal.value()};
+      }
+    }
     return std::visit(
-        [](auto intOrDouble) { return TripleComponent{intOrDouble}; },
-        visit(ctx->numericLiteral()));
+        [](auto intOrDouble) { return TripleComponent{intOrDouble}; }, value);
   } else if (ctx->UNDEF()) {
     return TripleComponent::UNDEF{};
   } else {
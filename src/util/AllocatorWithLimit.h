@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "util/MemorySize/MemorySize.h"
+#include "util/ResourceTracker.h"
 #include "util/Synchronized.h"
 
 namespace ad_utility {
@@ -218,6 +219,18 @@ class AllocatorWithLimit {
     return *this;
   }
 
+ private:
+  // Each allocation is preceded by the `ResourceTracker` for which it was
+  // recorded (see `ResourceTracker::recordAllocation`), s.t. the deallocation
+  // is recorded for the same tracker, no matter which operation or thread
+  // frees the memory. The tracker is stored at the beginning of the memory
+  // that is obtained from the `std::allocator`, which is suitably aligned.
+  using TrackerPtr = std::shared_ptr<ResourceTracker>;
+  static_assert(alignof(TrackerPtr) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  static constexpr size_t numHeaderElements =
+      (sizeof(TrackerPtr) + sizeof(T) - 1) / sizeof(T);
+
+ public:
   // An allocator must have a function "allocate" with exactly this signature.
   // TODO<C++20> : the exact signature of allocate changes
   T* allocate(std::size_t n) {
@@ -233,13 +246,21 @@ class AllocatorWithLimit {
       memoryLeft_.ptr()->wlock()->decrease_if_enough_left_or_throw(bytesNeeded);
     }
     // the actual allocation
-    return allocator_.allocate(n);
+    T* result = allocator_.allocate(n + numHeaderElements);
+    std::construct_at(
+        reinterpret_cast<TrackerPtr*>(result),
+        ResourceTracker::recordAllocation(bytesNeeded.getBytes()));
+    return result + numHeaderElements;
   }
 
   // An allocator must have a function "deallocate" with exactly this signature.
   void deallocate(T* p, std::size_t n) {
     // free the memory
-    allocator_.deallocate(p, n);
+    T* allocation = p - numHeaderElements;
+    auto* tracker = std::launder(reinterpret_cast<TrackerPtr*>(allocation));
+    ResourceTracker::recordDeallocation(tracker->get(), n * sizeof(T));
+    std::destroy_at(tracker);
+    allocator_.deallocate(allocation, n + numHeaderElements);
     // Update the amount of memory left.
     memoryLeft_.ptr()->wlock()->increase(MemorySize::bytes(n * sizeof(T)));
   }
@@ -8,6 +8,7 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <utility>
 
 #include "util/Forward.h"
@@ -31,6 +32,16 @@ class WaitedForResultWhichThenFailedException : public std::exception {
   }
 };
 
+// If the computation of a result throws an exception that is derived from this
+// class, the computation was given up on purpose and not because of an error
+// (for example, because the query is going to be planned again). The other
+// threads that wait for this result then compute it themselves instead of
+// failing with a `WaitedForResultWhichThenFailedException`.
+class ComputationWasGivenUpException : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
 // A strongly typed enum to differentiate the following cases:
 // a result was stored in the cache, but not cachedPinned. A result was stored
 // in the cache and cachedPinned, a result was not in the cache and therefore
@@ -86,7 +97,9 @@ namespace ConcurrentCacheDetail {
  *        may only call getResult(). This call blocks, until finish() or
  *        abort() is called from the computing threads. If the result is
  *        aborted, the call to getResult() will throw an
- *        WaitedForResultWhichThenFailedException
+ *        WaitedForResultWhichThenFailedException. If the computing thread
+ *        has given up the computation (see giveUp()), getResult() returns
+ *        nullptr.
  *
  *       This class is thread-safe
  */
@@ -117,9 +130,20 @@ class ResultInProgress {
     _conditionVariable.notify_all();
   }
 
+  // Signal to all the threads that at some point have called or will call
+  // getResult() that the computation was given up on purpose (see
+  // `ComputationWasGivenUpException`).
+  void giveUp() {
+    std::lock_guard lockGuard(_mutex);
+    AD_CONTRACT_CHECK(_status == Status::IN_PROGRESS);
+    _status = Status::GIVEN_UP;
+    _conditionVariable.notify_all();
+  }
+
   // Wait for another thread to finish the computation and obtain the result.
   // If the computation is aborted, this function throws an
-  // AbortedInOtherThreadException
+  // AbortedInOtherThreadException. If the computation was given up, nullptr
+  // is returned.
   shared_ptr<const Value> getResult() {
     std::unique_lock uniqueLock(_mutex);
     _conditionVariable.wait(uniqueLock,
@@ -131,7 +155,7 @@ class ResultInProgress {
   }
 
  private:
-  enum class Status { IN_PROGRESS, FINISHED, ABORTED };
+  enum class Status { IN_PROGRESS, FINISHED, ABORTED, GIVEN_UP };
   shared_ptr<const Value> _result;
   // See this SO answer for why mutable is ok here
   // https://stackoverflow.com/questions/3239905/c-mutex-and-const-correctness
@@ -200,6 +224,20 @@ class ConcurrentCache {
                            onlyReadFromCache);
   }
 
+  /// Erase the entry for the `key` from the cache, even if it is pinned. A
+  /// computation of the `key` that is currently in progress is not affected.
+  void erase(const Key& key) {
+    _cacheAndInProgressMap.wlock()->_cache.erase(key);
+  }
+
+  /// Insert the `value` for the `key` and pin it. An entry for the `key` that
+  /// is already contained is replaced, even if it is pinned.
+  void insertOrReplacePinned(const Key& key, shared_ptr<Value> value) {
+    auto lockPtr = _cacheAndInProgressMap.wlock();
+    lockPtr->_cache.erase(key);
+    lockPtr->_cache.insertPinned(key, std::move(value));
+  }
+
   /// Clear the cache (but not the pinned entries)
   void clearUnpinnedOnly() {
     _cacheAndInProgressMap.wlock()->_cache.clearUnpinnedOnly();
@@ -361,6 +399,11 @@ class ConcurrentCache {
         resultInProgress->finish(result);
         // result was not cached
         return {std::move(result), CacheStatus::computed};
+      } catch (const ComputationWasGivenUpException&) {
+        _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
+        // The other threads compute the result themselves.
+        resultInProgress->giveUp();
+        throw;
       } catch (...) {
         // Other threads may try this computation again in the future
         _cacheAndInProgressMap.wlock()->_inProgress.erase(key);
@@ -372,7 +415,14 @@ class ConcurrentCache {
       // someone else is computing the result, wait till it is finished and
       // return the result, we do not count this case as "cached" as we had to
       // wait.
-      return {resultInProgress->getResult(), CacheStatus::computed};
+      auto result = resultInProgress->getResult();
+      if (result == nullptr) {
+        // The other thread has given up the computation, so we have to
+        // compute the result ourselves.
+        return computeOnceImpl(pinned, key, std::move(computeFunction),
+                               onlyReadFromCache);
+      }
+      return {std::move(result), CacheStatus::computed};
     }
   }
 
@@ -0,0 +1,77 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "util/Decimal.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <algorithm>
+
+#include "global/Constants.h"
+
+// _____________________________________________________________________________
+std::optional<Decimal> Decimal::parse(std::string_view input) {
+  bool isNegative = false;
+  if (input.starts_with('+') || input.starts_with('-')) {
+    isNegative = input.front() == '-';
+    input.remove_prefix(1);
+  }
+  auto dot = input.find('.');
+  std::string_view integerPart = input.substr(0, dot);
+  std::string_view fractionalPart =
+      dot == std::string_view::npos ? "" : input.substr(dot + 1);
+  auto isDigits = [](std::string_view s) {
+    return std::ranges::all_of(s, [](char c) { return c >= '0' && c <= '9'; });
+  };
+  if ((integerPart.empty() && fractionalPart.empty()) ||
+      !isDigits(integerPart) || !isDigits(fractionalPart)) {
+    return std::nullopt;
+  }
+  // Trailing zeros beyond the precision are fine, other digits are not.
+  if (fractionalPart.size() > numFractionalDigits) {
+    if (fractionalPart.find_first_not_of('0', numFractionalDigits) !=
+        std::string_view::npos) {
+      return std::nullopt;
+    }
+    fractionalPart = fractionalPart.substr(0, numFractionalDigits);
+  }
+  while (integerPart.starts_with('0')) {
+    integerPart.remove_prefix(1);
+  }
+  // The largest representable value has 12 digits before the decimal point,
+  // so the following computation of the units cannot overflow.
+  if (integerPart.size() > 12) {
+    return std::nullopt;
+  }
+  int64_t units = 0;
+  for (char c : integerPart) {
+    units = 10 * units + (c - '0');
+  }
+  for (size_t i = 0; i < numFractionalDigits; ++i) {
+    units = 10 * units + (i < fractionalPart.size() ? fractionalPart[i] - '0'
+                                                    : 0);
+  }
+  if (isNegative) {
+    units = -units;
+  }
+  if (units < minUnits || units > maxUnits) {
+    return std::nullopt;
+  }
+  return Decimal{units};
+}
+
+// _____________________________________________________________________________
+std::pair<std::string, const char*> Decimal::toStringAndType() const {
+  uint64_t absoluteUnits = units_ < 0 ? -static_cast<uint64_t>(units_)
+                                      : static_cast<uint64_t>(units_);
+  std::string fraction =
+      absl::StrFormat("%06d", absoluteUnits % unitsPerOne);
+  // The canonical form has at least one digit after the decimal point.
+  while (fraction.size() > 1 && fraction.ends_with('0')) {
+    fraction.pop_back();
+  }
+  return {absl::StrCat(units_ < 0 ? "-" : "", absoluteUnits / unitsPerOne,
+                       ".", fraction),
+          XSD_DECIMAL_TYPE};
+}
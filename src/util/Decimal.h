@@ -0,0 +1,105 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "util/Exception.h"
+
+// A `xsd:decimal` value with a fixed precision of `numFractionalDigits`
+// digits after the decimal point that fits into the 60 data bits of a
+// `ValueId`. The value is stored as an integral number of "units" (millionths),
+// which is offset by `2^59` in the bit representation s.t. the order of the
+// bits is the numeric order of the values. Decimals with more significant
+// fractional digits or a too large absolute value (more than about `5.7e11`)
+// cannot be represented and are stored as doubles instead.
+class Decimal {
+ public:
+  static constexpr int64_t numFractionalDigits = 6;
+  static constexpr int64_t unitsPerOne = 1'000'000;
+  static constexpr uint64_t numDataBits = 60;
+  static constexpr int64_t minUnits = -(int64_t{1} << (numDataBits - 1));
+  static constexpr int64_t maxUnits = (int64_t{1} << (numDataBits - 1)) - 1;
+
+ private:
+  int64_t units_;
+
+  constexpr explicit Decimal(int64_t units) : units_{units} {}
+
+ public:
+  // Construct from the number of units (the value times `unitsPerOne`), which
+  // must be in the range `[minUnits, maxUnits]`.
+  static Decimal fromUnits(int64_t units) {
+    AD_CONTRACT_CHECK(units >= minUnits && units <= maxUnits);
+    return Decimal{units};
+  }
+  constexpr int64_t getUnits() const { return units_; }
+
+  // Conversion from and to the 60 bits of the representation.
+  static Decimal fromBits(uint64_t bits) {
+    AD_CORRECTNESS_CHECK(bits >> numDataBits == 0);
+    return Decimal{static_cast<int64_t>(bits) + minUnits};
+  }
+  constexpr uint64_t toBits() const {
+    return static_cast<uint64_t>(units_ - minUnits);
+  }
+
+  // Parse the lexical form of a `xsd:decimal` (e.g. `-12.50`, `+.5`, `3`).
+  // Return `std::nullopt` if the `input` is not a decimal or cannot be
+  // represented exactly.
+  static std::optional<Decimal> parse(std::string_view input);
+
+  double toDouble() const {
+    return static_cast<double>(units_) / static_cast<double>(unitsPerOne);
+  }
+
+  // The canonical representation (e.g. `-12.5` or `3.0`) and the datatype
+  // `xsd:decimal`.
+  std::pair<std::string, const char*> toStringAndType() const;
+
+  // The value as a double with the precision of a double in a `ValueId` (the
+  // lowest four bits of the mantissa are zero, see `ValueId::makeFromDouble`).
+  double toTruncatedDouble() const {
+    return std::bit_cast<double>(std::bit_cast<uint64_t>(toDouble()) &
+                                 ~uint64_t{0xF});
+  }
+
+  // The comparison of two decimals is the comparison of the units, which is
+  // exact, as is the comparison with an integer. The comparison with a
+  // floating point number is done via `toTruncatedDouble`, s.t. a decimal is
+  // equal to a double in a `ValueId` with the same lexical form.
+  constexpr auto operator<=>(const Decimal&) const = default;
+  constexpr bool operator==(const Decimal&) const = default;
+
+  template <std::integral I>
+  constexpr std::strong_ordering operator<=>(I i) const {
+    return static_cast<__int128>(units_) <=>
+           static_cast<__int128>(i) * unitsPerOne;
+  }
+  template <std::integral I>
+  constexpr bool operator==(I i) const {
+    return (*this <=> i) == 0;
+  }
+  template <std::floating_point F>
+  std::partial_ordering operator<=>(F f) const {
+    return toTruncatedDouble() <=> static_cast<double>(f);
+  }
+  template <std::floating_point F>
+  bool operator==(F f) const {
+    return toTruncatedDouble() == static_cast<double>(f);
+  }
+
+  // Bitwise hashing.
+  template <typename H>
+  friend H AbslHashValue(H h, const Decimal& d) {
+    return H::combine(std::move(h), d.units_);
+  }
+};
@@ -0,0 +1,152 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include "util/GeoPoint.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include "global/Constants.h"
+#include "util/GeoSparqlHelpers.h"
+
+// _____________________________________________________________________________
+std::optional<GeoPoint> GeoPoint::parseWktPoint(std::string_view wkt) {
+  auto [lng, lat] = ad_utility::detail::parseWktPoint(wkt);
+  // The comparisons are false for NaN, which is returned for invalid points.
+  if (!(lat >= -90.0 && lat <= 90.0 && lng >= -180.0 && lng <= 180.0)) {
+    return std::nullopt;
+  }
+  return GeoPoint{lat, lng};
+}
+
+// _____________________________________________________________________________
+std::pair<std::string, const char*> GeoPoint::toStringAndType() const {
+  // Six decimal places are more precise than the quantization, so the
+  // coordinates of points that were parsed with at most six decimal places
+  // are printed exactly as they were parsed.
+  auto format = [](double coordinate) {
+    std::string result = absl::StrFormat("%.6f", coordinate);
+    while (result.ends_with('0')) {
+      result.pop_back();
+    }
+    if (result.ends_with('.')) {
+      result.pop_back();
+    }
+    return result == "-0" ? std::string{"0"} : result;
+  };
+  return {absl::StrCat("POINT(", format(getLng()), " ", format(getLat()), ")"),
+          GEO_WKT_LITERAL};
+}
+
+// _____________________________________________________________________________
+GeoBoundingBox GeoBoundingBox::aroundPoint(GeoPoint center, double km) {
+  if (!(km >= 0)) {
+    return {90.0, -90.0, 180.0, -180.0};
+  }
+  // Lower bounds for the factors `k1` and `k2` of `geoDistanceInKm`, which
+  // yield upper bounds for the differences of the latitudes and longitudes.
+  constexpr double minK1 = 110.56;
+  double lat = center.getLat();
+  double lng = center.getLng();
+  double deltaLat = km / minK1;
+  GeoBoundingBox box{std::max(-90.0, lat - deltaLat),
+                     std::min(90.0, lat + deltaLat)};
+  // The factor `k2` decreases with the absolute value of the mean latitude of
+  // the two points, the maximum of which is reached at one of the borders.
+  double maxAbsMeanLat = std::max(std::abs(lat + box.minLat_) / 2.0,
+                                  std::abs(lat + box.maxLat_) / 2.0);
+  double minK2 =
+      111.41513 * std::cos(std::numbers::pi / 180.0 * maxAbsMeanLat) - 0.0947;
+  if (minK2 > 0) {
+    box.minLng_ = std::max(-180.0, lng - km / minK2);
+    box.maxLng_ = std::min(180.0, lng + km / minK2);
+  }
+  return box;
+}
+
+// _____________________________________________________________________________
+std::vector<std::pair<uint64_t, uint64_t>> GeoBoundingBox::zOrderRanges(
+    size_t maxNumRanges) const {
+  AD_CONTRACT_CHECK(maxNumRanges > 0);
+  std::vector<std::pair<uint64_t, uint64_t>> result;
+  if (isEmpty()) {
+    return result;
+  }
+  // The box in quantized coordinates, rounded outwards.
+  auto scale = [](double value, double maxValue) {
+    return (value + maxValue) / (2 * maxValue) *
+           static_cast<double>(GeoPoint::maxQuantized);
+  };
+  auto quantizeDown = [&scale](double value, double maxValue) {
+    return static_cast<uint64_t>(
+        std::max(0.0, std::floor(scale(value, maxValue))));
+  };
+  auto quantizeUp = [&scale](double value, double maxValue) {
+    return std::min(GeoPoint::maxQuantized, static_cast<uint64_t>(std::ceil(
+                                                scale(value, maxValue))));
+  };
+  const uint64_t minLat = quantizeDown(minLat_, 90.0);
+  const uint64_t maxLat = quantizeUp(maxLat_, 90.0);
+  const uint64_t minLng = quantizeDown(minLng_, 180.0);
+  const uint64_t maxLng = quantizeUp(maxLng_, 180.0);
+
+  // A cell of the quadtree on level `level` contains the quantized latitudes
+  // and longitudes the first `level` bits of which are `lat` and `lng`. Its
+  // points form a single range of the Z-order curve.
+  struct Cell {
+    uint64_t lat_;
+    uint64_t lng_;
+  };
+  auto toRange = [](const Cell& cell, size_t level) {
+    size_t numFreeBits = 2 * (GeoPoint::numBitsPerCoordinate - level);
+    uint64_t first = GeoPoint::interleave(cell.lat_, cell.lng_) << numFreeBits;
+    return std::pair{first, first + (uint64_t{1} << numFreeBits)};
+  };
+  std::vector<Cell> borderCells{Cell{0, 0}};
+  for (size_t level = 0; !borderCells.empty(); ++level) {
+    // Each of the border cells yields at least one range, and at most four
+    // if it is split.
+    bool split = level < GeoPoint::numBitsPerCoordinate &&
+                 result.size() + 4 * borderCells.size() <= maxNumRanges;
+    if (!split) {
+      for (const Cell& cell : borderCells) {
+        result.push_back(toRange(cell, level));
+      }
+      break;
+    }
+    std::vector<Cell> nextBorderCells;
+    size_t shift = GeoPoint::numBitsPerCoordinate - level - 1;
+    for (const Cell& cell : borderCells) {
+      for (uint64_t i = 0; i < 4; ++i) {
+        Cell child{2 * cell.lat_ + (i >> 1), 2 * cell.lng_ + (i & 1)};
+        uint64_t cellMinLat = child.lat_ << shift;
+        uint64_t cellMaxLat = cellMinLat + (uint64_t{1} << shift) - 1;
+        uint64_t cellMinLng = child.lng_ << shift;
+        uint64_t cellMaxLng = cellMinLng + (uint64_t{1} << shift) - 1;
+        if (cellMaxLat < minLat || cellMinLat > maxLat || cellMaxLng < minLng ||
+            cellMinLng > maxLng) {
+          continue;
+        }
+        if (cellMinLat >= minLat && cellMaxLat <= maxLat &&
+            cellMinLng >= minLng && cellMaxLng <= maxLng) {
+          result.push_back(toRange(child, level + 1));
+        } else {
+          nextBorderCells.push_back(child);
+        }
+      }
+    }
+    borderCells = std::move(nextBorderCells);
+  }
+
+  // Merge the adjacent ranges.
+  std::ranges::sort(result);
+  std::vector<std::pair<uint64_t, uint64_t>> merged;
+  for (const auto& range : result) {
+    if (!merged.empty() && merged.back().second == range.first) {
+      merged.back().second = range.second;
+    } else {
+      merged.push_back(range);
+    }
+  }
+  return merged;
+}
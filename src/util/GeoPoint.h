@@ -0,0 +1,174 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <numbers>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/Exception.h"
+
+// Compute the distance in km between two points (given by their latitudes and
+// longitudes in degrees) according to the formula in
+// https://en.wikipedia.org/wiki/Geographical_distance ("ellipsoidal earth
+// projected to a plane").
+inline double geoDistanceInKm(double lat1, double lng1, double lat2,
+                              double lng2) {
+  auto sqr = [](double x) { return x * x; };
+  auto m = std::numbers::pi / 180.0 * (lat1 + lat2) / 2.0;
+  auto k1 = 111.13209 - 0.56605 * cos(2 * m) + 0.00120 * cos(4 * m);
+  auto k2 = 111.41513 * cos(m) - 0.09455 * cos(3 * m) + 0.00012 * cos(5 * m);
+  return sqrt(sqr(k1 * (lat1 - lat2)) + sqr(k2 * (lng1 - lng2)));
+}
+
+// A point on the earth with a latitude in `[-90, 90]` and a longitude in
+// `[-180, 180]` (in degrees) that fits into the 60 data bits of a `ValueId`.
+// Each of the coordinates is quantized to 30 bits (a resolution of about 2 cm)
+// and the bits of the two coordinates are interleaved (the Z-order or Morton
+// code). The order of the bits thus follows a space-filling curve, on which
+// points that are close to each other are mostly close to each other, too.
+// In particular, the points of a predicate in the POS permutation form a
+// spatial index: the blocks that can contain the points of a bounding box are
+// the blocks that overlap with the `zOrderRanges` of the box.
+class GeoPoint {
+ public:
+  static constexpr uint64_t numBitsPerCoordinate = 30;
+  static constexpr uint64_t numDataBits = 2 * numBitsPerCoordinate;
+  static constexpr uint64_t maxQuantized =
+      (uint64_t{1} << numBitsPerCoordinate) - 1;
+
+ private:
+  uint64_t bits_;
+
+  constexpr explicit GeoPoint(uint64_t bits) : bits_{bits} {}
+
+ public:
+  // Construct from a latitude and a longitude in degrees. The coordinates must
+  // be in the valid ranges (see above).
+  GeoPoint(double lat, double lng)
+      : GeoPoint{interleave(quantize(lat, 90.0), quantize(lng, 180.0))} {
+    AD_CONTRACT_CHECK(lat >= -90.0 && lat <= 90.0);
+    AD_CONTRACT_CHECK(lng >= -180.0 && lng <= 180.0);
+  }
+
+  // Conversion from and to the 60 bits of the representation.
+  static GeoPoint fromBits(uint64_t bits) {
+    AD_CORRECTNESS_CHECK(bits >> numDataBits == 0);
+    return GeoPoint{bits};
+  }
+  constexpr uint64_t toBits() const { return bits_; }
+
+  // The coordinates in degrees (after the quantization).
+  double getLat() const { return dequantize(compact(bits_ >> 1), 90.0); }
+  double getLng() const { return dequantize(compact(bits_), 180.0); }
+
+  // The order of the Z-order curve, which is also the order of the `ValueId`s.
+  constexpr auto operator<=>(const GeoPoint&) const = default;
+
+  // Bitwise hashing.
+  template <typename H>
+  friend H AbslHashValue(H h, const GeoPoint& p) {
+    return H::combine(std::move(h), p.bits_);
+  }
+
+  // Parse a WKT point `POINT(<lng> <lat>)` (note the order of the
+  // coordinates). Return `std::nullopt` if the `wkt` is not a point or the
+  // coordinates are out of range.
+  static std::optional<GeoPoint> parseWktPoint(std::string_view wkt);
+
+  // The WKT point and the datatype `geo:wktLiteral`.
+  std::pair<std::string, const char*> toStringAndType() const;
+
+  // The quantized coordinate for a `value` in `[-maxValue, maxValue]`, and
+  // back.
+  static uint64_t quantize(double value, double maxValue) {
+    double fraction = (value + maxValue) / (2 * maxValue);
+    return static_cast<uint64_t>(
+        std::llround(fraction * static_cast<double>(maxQuantized)));
+  }
+  static double dequantize(uint64_t quantized, double maxValue) {
+    return static_cast<double>(quantized) /
+               static_cast<double>(maxQuantized) * 2 * maxValue -
+           maxValue;
+  }
+
+  // Spread the 30 bits of `lat` and `lng` to the odd and even bits of the
+  // result, and back.
+  static constexpr uint64_t interleave(uint64_t lat, uint64_t lng) {
+    return (spread(lat) << 1) | spread(lng);
+  }
+  static constexpr uint64_t spread(uint64_t x) {
+    x &= maxQuantized;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+  }
+  static constexpr uint64_t compact(uint64_t x) {
+    x &= 0x5555555555555555ULL;
+    x = (x | (x >> 1)) & 0x3333333333333333ULL;
+    x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+    return x;
+  }
+};
+
+// The distance in km between two `GeoPoint`s (see `geoDistanceInKm`).
+inline double geoDistanceInKm(GeoPoint a, GeoPoint b) {
+  return geoDistanceInKm(a.getLat(), a.getLng(), b.getLat(), b.getLng());
+}
+
+// A rectangle of latitudes and longitudes in degrees (including the border).
+// The default is the whole earth.
+struct GeoBoundingBox {
+  double minLat_ = -90.0;
+  double maxLat_ = 90.0;
+  double minLng_ = -180.0;
+  double maxLng_ = 180.0;
+
+  // The maximal number of ranges that `zOrderRanges` returns by default. More
+  // ranges approximate the box better, but the blocks of the index have to be
+  // intersected with more ranges.
+  static constexpr size_t defaultMaxNumRanges = 64;
+
+  bool isEmpty() const { return minLat_ > maxLat_ || minLng_ > maxLng_; }
+
+  bool contains(GeoPoint point) const {
+    double lat = point.getLat();
+    double lng = point.getLng();
+    return lat >= minLat_ && lat <= maxLat_ && lng >= minLng_ &&
+           lng <= maxLng_;
+  }
+
+  GeoBoundingBox intersect(const GeoBoundingBox& other) const {
+    return {std::max(minLat_, other.minLat_), std::min(maxLat_, other.maxLat_),
+            std::max(minLng_, other.minLng_), std::min(maxLng_, other.maxLng_)};
+  }
+
+  // A box that contains all the points that have at most distance `km` from
+  // the `center` according to `geoDistanceInKm`. The box is empty if `km` is
+  // negative or NaN.
+  static GeoBoundingBox aroundPoint(GeoPoint center, double km);
+
+  // Sorted and disjoint half-open ranges `[first, second)` of the bits of the
+  // `GeoPoint`s, which contain the bits of all the points in this box (and
+  // possibly some more). The ranges are the cells of a quadtree that are
+  // contained in the box, where the cells at the border of the box are split
+  // further as long as there are at most `maxNumRanges` ranges.
+  std::vector<std::pair<uint64_t, uint64_t>> zOrderRanges(
+      size_t maxNumRanges = defaultMaxNumRanges) const;
+
+  bool operator==(const GeoBoundingBox&) const = default;
+};
@@ -9,10 +9,10 @@
 #include <cmath>
 #include <ctre-unicode.hpp>
 #include <limits>
-#include <numbers>
 #include <string_view>
 
 #include "util/Exception.h"
+#include "util/GeoPoint.h"
 
 namespace ad_utility {
 
@@ -22,7 +22,7 @@ static constexpr auto wktPointRegex = ctll::fixed_string(
     "^\\s*[Pp][Oo][Ii][Nn][Tt]\\s*\\(\\s*"
     "(-?[0-9]+|-?[0-9]+\\.[0-9]+)"
     "\\s+"
-    "(-?[0-9+]|-?[0-9]+\\.[0-9]+)"
+    "(-?[0-9]+|-?[0-9]+\\.[0-9]+)"
     "\\s*\\)\\s*$");
 
 static constexpr double invalidCoordinate =
@@ -73,11 +73,7 @@ double wktDistImpl(const std::string_view point1,
                    const std::string_view point2) {
   auto [lng1, lat1] = parseWktPoint(point1);
   auto [lng2, lat2] = parseWktPoint(point2);
-  auto sqr = [](double x) { return x * x; };
-  auto m = std::numbers::pi / 180.0 * (lat1 + lat2) / 2.0;
-  auto k1 = 111.13209 - 0.56605 * cos(2 * m) + 0.00120 * cos(4 * m);
-  auto k2 = 111.41513 * cos(m) - 0.09455 * cos(3 * m) + 0.00012 * cos(5 * m);
-  return sqrt(sqr(k1 * (lat1 - lat2)) + sqr(k2 * (lng1 - lng2)));
+  return geoDistanceInKm(lat1, lng1, lat2, lng2);
 }
 
 }  // namespace detail
@@ -9,6 +9,9 @@
 #include <optional>
 #include <string>
 
+#include "util/GeoPoint.h"
+#include "util/OverloadCallOperator.h"
+
 namespace ad_utility {
 
 namespace detail {
@@ -27,32 +30,54 @@ double wktDistImpl(const std::string_view point1,
 }  // namespace detail
 
 // Parse the longitude coordinate from a WKT point (it's the first coordinate).
-inline auto wktLongitude = [](const std::optional<std::string>& point) {
-  if (!point.has_value()) {
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  return detail::wktLongitudeImpl(point.value());
-};
+// The overload for a `GeoPoint` is used for the points that were already
+// parsed when building the index (see `Datatype::GeoPoint`).
+inline auto wktLongitude = OverloadCallOperator{
+    [](const std::optional<std::string>& point) {
+      if (!point.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return detail::wktLongitudeImpl(point.value());
+    },
+    [](const std::optional<GeoPoint>& point) {
+      if (!point.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return point.value().getLng();
+    }};
 
 // Parse the latitude coordinate from a WKT point (it's the second coordinate).
-inline auto wktLatitude = [](const std::optional<std::string>& point) {
-  if (!point.has_value()) {
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  return detail::wktLatitudeImpl(point.value());
-};
-
-// Compute the distance in km between two WKT points according to the formula in
-// https://en.wikipedia.org/wiki/Geographical_distance ("ellipsoidal earth
-// projected to a plane"). A more precise way is the Haversine formula, which we
-// save for when we compute this at indexing time.
-inline auto wktDist = [](const std::optional<std::string>& point1,
-                         const std::optional<std::string>& point2) {
-  if (!point1.has_value() || !point2.has_value()) {
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  return detail::wktDistImpl(point1.value(), point2.value());
-};
+inline auto wktLatitude = OverloadCallOperator{
+    [](const std::optional<std::string>& point) {
+      if (!point.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return detail::wktLatitudeImpl(point.value());
+    },
+    [](const std::optional<GeoPoint>& point) {
+      if (!point.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return point.value().getLat();
+    }};
+
+// Compute the distance in km between two WKT points (see `geoDistanceInKm`).
+// A more precise way is the Haversine formula.
+inline auto wktDist = OverloadCallOperator{
+    [](const std::optional<std::string>& point1,
+       const std::optional<std::string>& point2) {
+      if (!point1.has_value() || !point2.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return detail::wktDistImpl(point1.value(), point2.value());
+    },
+    [](const std::optional<GeoPoint>& point1,
+       const std::optional<GeoPoint>& point2) {
+      if (!point1.has_value() || !point2.has_value()) {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      return geoDistanceInKm(point1.value(), point2.value());
+    }};
 
 }  // namespace ad_utility
 
@@ -0,0 +1,90 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "util/Exception.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+namespace ad_utility {
+
+// A HyperLogLog sketch (Flajolet et al., 2007) that estimates the number of
+// distinct 64-bit values that were added to it, using `2^PRECISION` bytes. The
+// standard error of the estimate is about `1.04 / sqrt(2^PRECISION)`, so about
+// 3% for the default precision. Two sketches can be merged, which yields the
+// sketch of the union of the two sets of values.
+//
+// The values are hashed with a fixed function (not with `absl::Hash`, which is
+// seeded per process), so sketches can be stored on disk.
+class HyperLogLog {
+ public:
+  static constexpr size_t PRECISION = 10;
+  static constexpr size_t NUM_REGISTERS = size_t{1} << PRECISION;
+
+ private:
+  // For each register the maximal rank (the number of leading zeros plus one
+  // of the remaining bits of the hash) of the values that were hashed to it.
+  std::vector<uint8_t> registers_ = std::vector<uint8_t>(NUM_REGISTERS, 0);
+
+ public:
+  // The finalizer of MurmurHash3, which mixes all the bits of the value.
+  static constexpr uint64_t hash(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  void add(uint64_t value) {
+    uint64_t h = hash(value);
+    size_t index = h >> (64 - PRECISION);
+    // The sentinel bit bounds the rank in case all the remaining bits are 0.
+    uint64_t remainingBits =
+        (h << PRECISION) | (uint64_t{1} << (PRECISION - 1));
+    auto rank = static_cast<uint8_t>(std::countl_zero(remainingBits) + 1);
+    registers_[index] = std::max(registers_[index], rank);
+  }
+
+  // Merge the `other` sketch into this one.
+  void merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < NUM_REGISTERS; ++i) {
+      registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+  }
+
+  // The estimated number of distinct values.
+  double estimate() const {
+    constexpr double m = static_cast<double>(NUM_REGISTERS);
+    constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double sum = 0;
+    size_t numZeros = 0;
+    for (uint8_t rank : registers_) {
+      sum += std::ldexp(1.0, -static_cast<int>(rank));
+      numZeros += static_cast<size_t>(rank == 0);
+    }
+    double estimate = alpha * m * m / sum;
+    // For small cardinalities, linear counting on the empty registers is much
+    // more accurate.
+    if (estimate <= 2.5 * m && numZeros > 0) {
+      return m * std::log(m / static_cast<double>(numZeros));
+    }
+    return estimate;
+  }
+
+  bool operator==(const HyperLogLog&) const = default;
+
+  AD_SERIALIZE_FRIEND_FUNCTION(HyperLogLog) {
+    serializer | arg.registers_;
+    AD_CORRECTNESS_CHECK(arg.registers_.size() == NUM_REGISTERS);
+  }
+};
+}  // namespace ad_utility
@@ -0,0 +1,125 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "util/Exception.h"
+#include "util/TransparentFunctors.h"
+
+namespace ad_utility {
+
+// An iterator over a trie, which is the interface that the Leapfrog Triejoin
+// (see below) requires from its inputs. The iterator starts above the root.
+// `open()` goes one level down to the first (smallest) key of the children of
+// the current key (or of the root), `up()` goes back to the parent. On each
+// level the keys are sorted and `next()` moves to the next key, `seek(key)`
+// moves to the first key that is not smaller than `key` (it is only called
+// with keys that are not smaller than the current key), and `atEnd()` is true
+// if there is no such key. `key()` must not be called when `atEnd()` is true.
+template <typename T>
+concept TrieIterator = requires(T& it, const T& constIt) {
+  it.open();
+  it.up();
+  it.next();
+  it.seek(constIt.key());
+  { constIt.atEnd() } -> std::same_as<bool>;
+  { constIt.key() < constIt.key() } -> std::convertible_to<bool>;
+  { constIt.key() == constIt.key() } -> std::convertible_to<bool>;
+};
+
+namespace detail {
+// Call `onMatch(key)` for all the keys that are contained in all the
+// `iterators`, which all must have been opened on the current level, in
+// ascending order (the "leapfrog join" from Veldhuizen's paper). The calls to
+// `onMatch` may move the iterators to deeper levels, but they must be back on
+// the current level with an unchanged key when `onMatch` returns.
+template <TrieIterator It>
+void leapfrogJoin(std::vector<It*>& iterators, const auto& onMatch) {
+  AD_CORRECTNESS_CHECK(!iterators.empty());
+  if (std::ranges::any_of(iterators, [](It* it) { return it->atEnd(); })) {
+    return;
+  }
+  std::ranges::sort(iterators,
+                    [](It* a, It* b) { return a->key() < b->key(); });
+  // Invariant: `maxKey` is the key of the iterator before the iterator at
+  // `current` (cyclically), which is the largest key of all the iterators.
+  auto maxKey = iterators.back()->key();
+  size_t current = 0;
+  while (true) {
+    It& it = *iterators[current];
+    if (it.key() == maxKey) {
+      // All the iterators are at the same key.
+      onMatch(maxKey);
+      it.next();
+    } else {
+      it.seek(maxKey);
+    }
+    if (it.atEnd()) {
+      return;
+    }
+    maxKey = it.key();
+    current = (current + 1) % iterators.size();
+  }
+}
+
+// The recursive implementation of `leapfrogTriejoin` (see below) for the
+// variable at `level`.
+template <TrieIterator It, typename Key>
+void leapfrogTriejoinImpl(
+    std::span<It> iterators,
+    const std::vector<std::vector<size_t>>& iteratorsPerLevel, size_t level,
+    std::vector<Key>& keys, const auto& onResult,
+    const auto& checkCancellation) {
+  if (level == iteratorsPerLevel.size()) {
+    onResult(std::span<const Key>{keys});
+    return;
+  }
+  checkCancellation();
+  std::vector<It*> participants;
+  for (size_t i : iteratorsPerLevel[level]) {
+    participants.push_back(&iterators[i]);
+    iterators[i].open();
+  }
+  leapfrogJoin(participants, [&](const auto& key) {
+    keys[level] = key;
+    leapfrogTriejoinImpl(iterators, iteratorsPerLevel, level + 1, keys,
+                         onResult, checkCancellation);
+  });
+  for (It* it : participants) {
+    it->up();
+  }
+}
+}  // namespace detail
+
+// The Leapfrog Triejoin by Todd L. Veldhuizen ("Leapfrog Triejoin: A Simple,
+// Worst-Case Optimal Join Algorithm", ICDT 2014). Each of the `iterators` is a
+// relation that is stored as a trie. The variables of the join are bound one
+// after the other, `iteratorsPerLevel[i]` are the indices of the iterators
+// that contain the `i`-th variable, which must be the next level of each of
+// these iterators (so the levels of a trie must be in the same order as the
+// variables). Each variable must be contained in at least one iterator. Call
+// `onResult(keys)` for each tuple of the result, where `keys[i]` is the value
+// of the `i`-th variable. The results are sorted lexicographically. The
+// `checkCancellation` function is called regularly.
+template <TrieIterator It, typename CheckCancellation = Noop>
+void leapfrogTriejoin(std::span<It> iterators,
+                      const std::vector<std::vector<size_t>>& iteratorsPerLevel,
+                      const auto& onResult,
+                      const CheckCancellation& checkCancellation = {}) {
+  AD_CONTRACT_CHECK(std::ranges::none_of(
+      iteratorsPerLevel, [](const auto& level) { return level.empty(); }));
+  using Key = std::decay_t<decltype(iterators.front().key())>;
+  std::vector<Key> keys(iteratorsPerLevel.size());
+  if (iteratorsPerLevel.empty()) {
+    return;
+  }
+  detail::leapfrogTriejoinImpl(iterators, iteratorsPerLevel, 0, keys, onResult,
+                               checkCancellation);
+}
+}  // namespace ad_utility
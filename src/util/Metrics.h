@@ -0,0 +1,171 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Simple metrics (counters and histograms) that can be recorded concurrently
+// from many threads at the cost of a single relaxed atomic increment and that
+// can be exported in the text format of Prometheus (see
+// https://prometheus.io/docs/instrumenting/exposition_formats/).
+namespace ad_utility::metrics {
+
+// A counter that is only ever increased.
+class Counter {
+  std::atomic<uint64_t> value_ = 0;
+
+ public:
+  void increment(uint64_t amount = 1) {
+    value_.fetch_add(amount, std::memory_order_relaxed);
+  }
+  uint64_t get() const { return value_.load(std::memory_order_relaxed); }
+};
+
+// A histogram of non-negative integers (e.g. durations in microseconds) with
+// logarithmic buckets like in an HDR histogram: Each power of two is split
+// into `numSubBuckets` buckets of equal width, so the relative error of the
+// quantiles that are computed from the buckets is at most `1 / numSubBuckets`.
+// For `numSubBuckets == 2`, the buckets are `[0]`, `[1]`, `[2]`, `[3]`,
+// `[4, 5]`, `[6, 7]`, `[8, 11]`, `[12, 15]`, `[16, 23]`, ... All values that
+// are larger than the `maxValue` that is passed to the constructor are counted
+// in an additional last bucket.
+class Histogram {
+ public:
+  static constexpr size_t numSubBucketBits = 1;
+  static constexpr size_t numSubBuckets = size_t{1} << numSubBucketBits;
+
+ private:
+  std::vector<std::atomic<uint64_t>> buckets_;
+  std::atomic<uint64_t> sum_ = 0;
+
+ public:
+  explicit Histogram(uint64_t maxValue)
+      : buckets_(getBucketIndex(maxValue) + 2) {}
+
+  // The index of the bucket for the `value`.
+  static constexpr size_t getBucketIndex(uint64_t value) {
+    if (value < 2 * numSubBuckets) {
+      return value;
+    }
+    size_t exponent = std::bit_width(value) - 1 - numSubBucketBits;
+    // The highest `numSubBucketBits + 1` bits of the value.
+    size_t highestBits = value >> exponent;
+    return (exponent + 1) * numSubBuckets + (highestBits - numSubBuckets);
+  }
+
+  // The largest value in the bucket with the given `index`.
+  static constexpr uint64_t getBucketUpperBound(size_t index) {
+    if (index < 2 * numSubBuckets) {
+      return index;
+    }
+    size_t exponent = index / numSubBuckets - 1;
+    uint64_t highestBits = index % numSubBuckets + numSubBuckets;
+    return ((highestBits + 1) << exponent) - 1;
+  }
+
+  void record(uint64_t value) {
+    size_t index = std::min(getBucketIndex(value), buckets_.size() - 1);
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  // The number of buckets (including the last one, which has no upper bound).
+  size_t numBuckets() const { return buckets_.size(); }
+  uint64_t getBucketCount(size_t index) const {
+    return buckets_.at(index).load(std::memory_order_relaxed);
+  }
+  uint64_t getSum() const { return sum_.load(std::memory_order_relaxed); }
+};
+
+// The labels of a single time series, e.g. `{{"outcome", "ok"}}`.
+using Labels = std::vector<std::pair<std::string_view, std::string_view>>;
+
+// Assemble metrics in the text format of Prometheus. Each metric has to be
+// declared with `addMetric` before its samples are added.
+class PrometheusWriter {
+  std::string result_;
+
+  // Format the `labels` as `{a="x",b="y"}`, including the `le` label of a
+  // histogram bucket if given.
+  static std::string formatLabels(const Labels& labels,
+                                  std::string_view le = {}) {
+    if (labels.empty() && le.empty()) {
+      return "";
+    }
+    std::string result = "{";
+    for (const auto& [key, value] : labels) {
+      absl::StrAppend(&result, result.size() > 1 ? "," : "", key, "=\"");
+      // Escape the label value as required by the format.
+      for (char c : value) {
+        if (c == '\\' || c == '"') {
+          result.push_back('\\');
+          result.push_back(c);
+        } else if (c == '\n') {
+          result.append("\\n");
+        } else {
+          result.push_back(c);
+        }
+      }
+      result.push_back('"');
+    }
+    if (!le.empty()) {
+      absl::StrAppend(&result, result.size() > 1 ? "," : "", "le=\"", le,
+                      "\"");
+    }
+    result.push_back('}');
+    return result;
+  }
+
+ public:
+  // Declare a metric with the given `type` ("counter", "gauge", or
+  // "histogram").
+  void addMetric(std::string_view name, std::string_view help,
+                 std::string_view type) {
+    absl::StrAppend(&result_, "# HELP ", name, " ", help, "\n# TYPE ", name,
+                    " ", type, "\n");
+  }
+
+  // Add a single sample of a counter or gauge.
+  template <typename T>
+  void addSample(std::string_view name, const Labels& labels, T value) {
+    absl::StrAppend(&result_, name, formatLabels(labels), " ", value, "\n");
+  }
+
+  // Add all the samples of the `histogram`. The values of the `histogram` are
+  // multiplied by the `scale` (e.g. `1e-6` for durations in microseconds that
+  // are exported in seconds, which is the convention of Prometheus).
+  void addHistogram(std::string_view name, const Labels& labels,
+                    const Histogram& histogram, double scale = 1.0) {
+    auto bucketName = absl::StrCat(name, "_bucket");
+    uint64_t cumulativeCount = 0;
+    for (size_t i = 0; i + 1 < histogram.numBuckets(); ++i) {
+      cumulativeCount += histogram.getBucketCount(i);
+      auto upperBound =
+          static_cast<double>(Histogram::getBucketUpperBound(i)) * scale;
+      absl::StrAppend(&result_, bucketName,
+                      formatLabels(labels, absl::StrCat(upperBound)), " ",
+                      cumulativeCount, "\n");
+    }
+    uint64_t totalCount =
+        cumulativeCount +
+        histogram.getBucketCount(histogram.numBuckets() - 1);
+    absl::StrAppend(&result_, bucketName, formatLabels(labels, "+Inf"), " ",
+                    totalCount, "\n");
+    addSample(absl::StrCat(name, "_sum"), labels,
+              static_cast<double>(histogram.getSum()) * scale);
+    addSample(absl::StrCat(name, "_count"), labels, totalCount);
+  }
+
+  std::string get() && { return std::move(result_); }
+};
+}  // namespace ad_utility::metrics
@@ -0,0 +1,203 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <absl/container/flat_hash_set.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "util/Synchronized.h"
+
+namespace ad_utility {
+
+// A snapshot of the resources that were used by a computation, see
+// `ResourceTracker` below.
+struct ResourceUsage {
+  // The maximal number of bytes that were allocated at the same time (the
+  // bytes allocated minus the bytes deallocated during the computation).
+  size_t peakAllocatedBytes_ = 0;
+  // The total number of bytes that were allocated.
+  size_t totalAllocatedBytes_ = 0;
+  // The number of bytes and compressed blocks read from disk.
+  size_t bytesRead_ = 0;
+  size_t numBlocksRead_ = 0;
+  size_t numBlocksDecompressed_ = 0;
+  // The CPU time summed over all threads.
+  std::chrono::microseconds cpuTime_ = std::chrono::microseconds::zero();
+  // The number of distinct threads that worked on the computation.
+  size_t numThreads_ = 0;
+
+  // Add the usage of a child computation, e.g. to obtain the usage of a
+  // complete subtree of a query. The peak memory and the number of threads are
+  // the maximum of the two values, because the children are typically computed
+  // one after the other.
+  void addChildUsage(const ResourceUsage& child) {
+    peakAllocatedBytes_ =
+        std::max(peakAllocatedBytes_, child.peakAllocatedBytes_);
+    totalAllocatedBytes_ += child.totalAllocatedBytes_;
+    bytesRead_ += child.bytesRead_;
+    numBlocksRead_ += child.numBlocksRead_;
+    numBlocksDecompressed_ += child.numBlocksDecompressed_;
+    cpuTime_ += child.cpuTime_;
+    numThreads_ = std::max(numThreads_, child.numThreads_);
+  }
+
+  bool operator==(const ResourceUsage&) const = default;
+};
+
+// Account for the resources (memory allocated via `AllocatorWithLimit`, bytes
+// and blocks read by the `CompressedRelationReader`, CPU time) that are used by
+// a computation. The tracking is scoped: A `ResourceTracker::Scope` makes a
+// tracker the current tracker of its thread until it is destroyed, and all the
+// resources that are used by this thread in the meantime are added to that
+// tracker. Scopes can be nested, the CPU time of an inner scope is then not
+// counted for the outer scope. Work that is handed to another thread has to
+// open a `Scope` for the tracker of the spawning thread (see `getCurrent`).
+// Memory is always freed for the tracker that it was allocated for, even if
+// this happens in a different scope (e.g. when a result is freed by a parent
+// operation or evicted from the cache). All the counters are relaxed atomics,
+// so the usage can be read (e.g. for a live update of the runtime information)
+// while the computation is running.
+class ResourceTracker {
+  std::atomic<int64_t> currentBytes_ = 0;
+  std::atomic<int64_t> peakBytes_ = 0;
+  std::atomic<size_t> totalAllocatedBytes_ = 0;
+  std::atomic<size_t> bytesRead_ = 0;
+  std::atomic<size_t> numBlocksRead_ = 0;
+  std::atomic<size_t> numBlocksDecompressed_ = 0;
+  std::atomic<int64_t> cpuTimeInNanoseconds_ = 0;
+  // Note: `ad_utility::HashSet` can't be used here, because its header
+  // includes the `AllocatorWithLimit`, which in turn uses this class.
+  ad_utility::Synchronized<absl::flat_hash_set<std::thread::id>> threads_;
+
+ public:
+  // Make `tracker` the current tracker of this thread for the lifetime of the
+  // `Scope`. If `tracker` is `nullptr`, the scope has no effect.
+  class Scope {
+    std::shared_ptr<ResourceTracker> tracker_;
+    Scope* parent_ = nullptr;
+    int64_t cpuStart_ = 0;
+    friend class ResourceTracker;
+
+   public:
+    explicit Scope(std::shared_ptr<ResourceTracker> tracker)
+        : tracker_{std::move(tracker)} {
+      if (tracker_ == nullptr) {
+        return;
+      }
+      tracker_->threads_.wlock()->insert(std::this_thread::get_id());
+      parent_ = currentScope_;
+      cpuStart_ = getThreadCpuTimeInNanoseconds();
+      if (parent_ != nullptr) {
+        parent_->tracker_->addCpuTime(cpuStart_ - parent_->cpuStart_);
+      }
+      currentScope_ = this;
+    }
+    ~Scope() {
+      if (tracker_ == nullptr) {
+        return;
+      }
+      auto now = getThreadCpuTimeInNanoseconds();
+      tracker_->addCpuTime(now - cpuStart_);
+      if (parent_ != nullptr) {
+        parent_->cpuStart_ = now;
+      }
+      currentScope_ = parent_;
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  // The tracker of the innermost `Scope` of this thread, `nullptr` if there is
+  // none.
+  static std::shared_ptr<ResourceTracker> getCurrent() {
+    return currentScope_ == nullptr ? nullptr : currentScope_->tracker_;
+  }
+
+  // Record the allocation of `numBytes` for the current tracker (if any) and
+  // return this tracker. The deallocation of these bytes has to be recorded
+  // for the returned tracker. Called by `AllocatorWithLimit`, which stores the
+  // tracker together with the allocated memory.
+  static std::shared_ptr<ResourceTracker> recordAllocation(size_t numBytes) {
+    auto tracker = getCurrent();
+    if (tracker != nullptr) {
+      tracker->totalAllocatedBytes_.fetch_add(numBytes,
+                                              std::memory_order_relaxed);
+      auto current = tracker->currentBytes_.fetch_add(
+                         static_cast<int64_t>(numBytes),
+                         std::memory_order_relaxed) +
+                     static_cast<int64_t>(numBytes);
+      auto peak = tracker->peakBytes_.load(std::memory_order_relaxed);
+      while (current > peak && !tracker->peakBytes_.compare_exchange_weak(
+                                   peak, current, std::memory_order_relaxed)) {
+      }
+    }
+    return tracker;
+  }
+  static void recordDeallocation(ResourceTracker* tracker, size_t numBytes) {
+    if (tracker != nullptr) {
+      tracker->currentBytes_.fetch_sub(static_cast<int64_t>(numBytes),
+                                       std::memory_order_relaxed);
+    }
+  }
+
+  // Record that a compressed block with `numBytes` bytes was read from disk.
+  static void recordBlockRead(size_t numBytes) {
+    if (auto* tracker = getCurrentUnowned()) {
+      tracker->bytesRead_.fetch_add(numBytes, std::memory_order_relaxed);
+      tracker->numBlocksRead_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Record that a block was decompressed.
+  static void recordBlockDecompressed() {
+    if (auto* tracker = getCurrentUnowned()) {
+      tracker->numBlocksDecompressed_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Get a snapshot of the resources used so far. The CPU time of scopes that
+  // are still open is not yet included.
+  ResourceUsage getUsage() const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    ResourceUsage usage;
+    usage.peakAllocatedBytes_ =
+        static_cast<size_t>(std::max(peakBytes_.load(relaxed), int64_t{0}));
+    usage.totalAllocatedBytes_ = totalAllocatedBytes_.load(relaxed);
+    usage.bytesRead_ = bytesRead_.load(relaxed);
+    usage.numBlocksRead_ = numBlocksRead_.load(relaxed);
+    usage.numBlocksDecompressed_ = numBlocksDecompressed_.load(relaxed);
+    usage.cpuTime_ = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::nanoseconds{cpuTimeInNanoseconds_.load(relaxed)});
+    usage.numThreads_ = threads_.rlock()->size();
+    return usage;
+  }
+
+ private:
+  static inline thread_local Scope* currentScope_ = nullptr;
+
+  // Same as `getCurrent`, but without the overhead of copying the
+  // `shared_ptr`.
+  static ResourceTracker* getCurrentUnowned() {
+    return currentScope_ == nullptr ? nullptr : currentScope_->tracker_.get();
+  }
+
+  void addCpuTime(int64_t nanoseconds) {
+    cpuTimeInNanoseconds_.fetch_add(std::max(nanoseconds, int64_t{0}),
+                                    std::memory_order_relaxed);
+  }
+
+  static int64_t getThreadCpuTimeInNanoseconds() {
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return int64_t{time.tv_sec} * 1'000'000'000 + time.tv_nsec;
+  }
+};
+}  // namespace ad_utility
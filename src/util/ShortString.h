@@ -0,0 +1,112 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <absl/strings/str_cat.h>
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "util/Exception.h"
+
+// The content of a plain literal (without a language tag or datatype) that
+// consists of at most `maxSize` ASCII characters other than NUL and thus fits
+// into the 60 data bits of a `ValueId`. The characters are stored in the
+// highest bits (the first character in the highest byte) and the unused
+// characters are zero, s.t. the order of the bits is the bytewise order of the
+// contents. Note that this is not the order of the vocabulary, which is
+// determined by the locale. Comparisons of `ShortString`s with other strings
+// therefore have to decode the `ShortString` first.
+class ShortString {
+ public:
+  static constexpr size_t maxSize = 7;
+  static constexpr uint64_t numDataBits = 60;
+
+ private:
+  // The characters occupy the bits `[4, 60)`, the lowest four bits are zero.
+  static constexpr uint64_t shiftOfFirstChar = numDataBits - 8;
+  uint64_t bits_;
+
+  constexpr explicit ShortString(uint64_t bits) : bits_{bits} {}
+
+ public:
+  // Return `std::nullopt` if the `content` doesn't fit (see above).
+  static constexpr std::optional<ShortString> fromContent(
+      std::string_view content) {
+    if (content.size() > maxSize) {
+      return std::nullopt;
+    }
+    uint64_t bits = 0;
+    for (size_t i = 0; i < content.size(); ++i) {
+      auto c = static_cast<unsigned char>(content[i]);
+      if (c == 0 || c >= 128) {
+        return std::nullopt;
+      }
+      bits |= uint64_t{c} << (shiftOfFirstChar - 8 * i);
+    }
+    return ShortString{bits};
+  }
+
+  // Same as `fromContent`, but for a normalized literal including the quotes
+  // (e.g. `"abc"`). Literals with a language tag or a datatype are never
+  // `ShortString`s.
+  static constexpr std::optional<ShortString> fromLiteral(
+      std::string_view literal) {
+    if (literal.size() < 2 || !literal.starts_with('"') ||
+        !literal.ends_with('"')) {
+      return std::nullopt;
+    }
+    return fromContent(literal.substr(1, literal.size() - 2));
+  }
+
+  // The range `[first, second)` of the bits of all `ShortString`s the content
+  // of which starts with the `prefix`, or `std::nullopt` if there are none.
+  static std::optional<std::pair<uint64_t, uint64_t>> getPrefixRange(
+      std::string_view prefix) {
+    auto lower = fromContent(prefix);
+    if (!lower.has_value()) {
+      return std::nullopt;
+    }
+    uint64_t numBitsAfterPrefix = numDataBits - 8 * prefix.size();
+    return std::pair{lower->bits_,
+                     lower->bits_ + (uint64_t{1} << numBitsAfterPrefix)};
+  }
+
+  // Conversion from and to the 60 bits of the representation.
+  static ShortString fromBits(uint64_t bits) {
+    AD_CORRECTNESS_CHECK(bits >> numDataBits == 0);
+    return ShortString{bits};
+  }
+  constexpr uint64_t toBits() const { return bits_; }
+
+  std::string getContent() const {
+    std::string result;
+    for (size_t i = 0; i < maxSize; ++i) {
+      auto c = static_cast<char>((bits_ >> (shiftOfFirstChar - 8 * i)) & 0xFF);
+      if (c == 0) {
+        break;
+      }
+      result.push_back(c);
+    }
+    return result;
+  }
+
+  // The normalized literal including the quotes.
+  std::string toLiteral() const {
+    return absl::StrCat("\"", getContent(), "\"");
+  }
+
+  // The bytewise order of the contents (see above).
+  constexpr auto operator<=>(const ShortString&) const = default;
+
+  // Bitwise hashing.
+  template <typename H>
+  friend H AbslHashValue(H h, const ShortString& s) {
+    return H::combine(std::move(h), s.bits_);
+  }
+};
@@ -7,16 +7,25 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace ad_utility {
 
 //! Selector mask,
 //! see: Anh & Moffat: "Index compression using 64-bit words."
-static const uint64_t SIMPLE8B_SELECTOR_MASK = 0x000000000000000F;
+static constexpr uint64_t SIMPLE8B_SELECTOR_MASK = 0x000000000000000F;
 
 //! Selectors,
 //! see: Anh & Moffat: "Index compression using 64-bit words."
-static const struct {
+static constexpr struct {
   unsigned char _itemWidth;
   unsigned char _groupSize;
   unsigned char _wastedBits;
@@ -40,6 +49,16 @@ static const struct {
     {60, 1, 0, 0x0FFFFFFFFFFFFFFF},    // selector 15
 };
 
+//! A position inside a Simple8b encoded list: the index of a codeword and the
+//! index (in the plaintext) of the first element that is stored in this
+//! codeword. Decoding can start at any codeword, so such a pointer allows to
+//! decode a part of a list without decoding everything before it.
+struct Simple8bSkipPointer {
+  uint64_t codewordIndex_ = 0;
+  uint64_t firstElementInCodeword_ = 0;
+  bool operator==(const Simple8bSkipPointer&) const = default;
+};
+
 //! Simple8b Compression Scheme.
 //! See: Anh & Moffat: Index compression using 64-bit words.
 //! Changed the following:
@@ -139,10 +158,47 @@ class Simple8bCode {
   // ! i.e. sizeof(Numeric) * (nofElements + 239).
   // ! The overhead is included so that no check for boundaries
   // ! is necessary inside the decoding of a single codeword.
+  // ! Each codeword is decoded by a function that is specialized for its
+  // ! selector, s.t. the shifts are compile-time constants and the elements of
+  // ! a codeword can be extracted with SIMD instructions (see
+  // ! `decodeCodeword`).
   template <typename Numeric, typename MakeFromUint64t = std::identity>
   static void decode(uint64_t* const encoded, size_t nofElements,
                      Numeric* decoded,
                      MakeFromUint64t makeFromUint64 = MakeFromUint64t{}) {
+    size_t nofElementsDone(0), nofCodeWordsDone(0);
+    while (nofElementsDone < nofElements) {
+      nofElementsDone += decodeCodeword(encoded[nofCodeWordsDone++],
+                                        decoded + nofElementsDone,
+                                        makeFromUint64);
+    }
+  }
+
+  // ! Same as `decode`, but the elements of the list are the gaps between
+  // ! consecutive values, and the values are returned (the first value is the
+  // ! first element plus `base`). The prefix sum is computed per codeword,
+  // ! while the decoded elements are still in the cache, and with SIMD
+  // ! instructions where available.
+  static void decodeGaps(uint64_t* const encoded, size_t nofElements,
+                         uint64_t* decoded, uint64_t base = 0) {
+    size_t nofElementsDone(0), nofCodeWordsDone(0);
+    while (nofElementsDone < nofElements) {
+      size_t nofElementsInCodeword =
+          decodeCodeword(encoded[nofCodeWordsDone++],
+                         decoded + nofElementsDone, std::identity{});
+      base = inclusivePrefixSum(decoded + nofElementsDone,
+                                nofElementsInCodeword, base);
+      nofElementsDone += nofElementsInCodeword;
+    }
+  }
+
+  // ! The straightforward decoder that looks up the selector of each codeword
+  // ! in the `SIMPLE8B_SELECTORS` table at runtime. Has the same semantics
+  // ! as `decode`. Used as a reference in tests and benchmarks.
+  template <typename Numeric, typename MakeFromUint64t = std::identity>
+  static void decodeWithSelectorTable(
+      uint64_t* const encoded, size_t nofElements, Numeric* decoded,
+      MakeFromUint64t makeFromUint64 = MakeFromUint64t{}) {
     // Handle trivial empty case
     if (!nofElements) {
       return;
@@ -164,5 +220,172 @@ class Simple8bCode {
       }
     }
   }
+
+  // ! For each element with index `0, chunkSize, 2 * chunkSize, ...` that is
+  // ! smaller than `nofElements` return a pointer to the codeword of the
+  // ! `encoded` list that contains this element. Only the selectors of the
+  // ! codewords are inspected, nothing is decoded.
+  static std::vector<Simple8bSkipPointer> computeSkipPointers(
+      const uint64_t* encoded, size_t nofElements, size_t chunkSize) {
+    assert(chunkSize > 0);
+    std::vector<Simple8bSkipPointer> result;
+    result.reserve((nofElements + chunkSize - 1) / chunkSize);
+    Simple8bSkipPointer current;
+    for (size_t element = 0; element < nofElements; element += chunkSize) {
+      while (true) {
+        size_t groupSize =
+            SIMPLE8B_SELECTORS[encoded[current.codewordIndex_] &
+                               SIMPLE8B_SELECTOR_MASK]
+                ._groupSize;
+        if (current.firstElementInCodeword_ + groupSize > element) {
+          break;
+        }
+        current.firstElementInCodeword_ += groupSize;
+        ++current.codewordIndex_;
+      }
+      result.push_back(current);
+    }
+    return result;
+  }
+
+ private:
+  // Decode all the elements of the `codeword` to `decoded` and return their
+  // number.
+  template <typename Numeric, typename MakeFromUint64t>
+  static size_t decodeCodeword(uint64_t codeword, Numeric* decoded,
+                               const MakeFromUint64t& makeFromUint64) {
+    switch (codeword & SIMPLE8B_SELECTOR_MASK) {
+      case 0:
+        return decodeCodeword<0>(codeword, decoded, makeFromUint64);
+      case 1:
+        return decodeCodeword<1>(codeword, decoded, makeFromUint64);
+      case 2:
+        return decodeCodeword<2>(codeword, decoded, makeFromUint64);
+      case 3:
+        return decodeCodeword<3>(codeword, decoded, makeFromUint64);
+      case 4:
+        return decodeCodeword<4>(codeword, decoded, makeFromUint64);
+      case 5:
+        return decodeCodeword<5>(codeword, decoded, makeFromUint64);
+      case 6:
+        return decodeCodeword<6>(codeword, decoded, makeFromUint64);
+      case 7:
+        return decodeCodeword<7>(codeword, decoded, makeFromUint64);
+      case 8:
+        return decodeCodeword<8>(codeword, decoded, makeFromUint64);
+      case 9:
+        return decodeCodeword<9>(codeword, decoded, makeFromUint64);
+      case 10:
+        return decodeCodeword<10>(codeword, decoded, makeFromUint64);
+      case 11:
+        return decodeCodeword<11>(codeword, decoded, makeFromUint64);
+      case 12:
+        return decodeCodeword<12>(codeword, decoded, makeFromUint64);
+      case 13:
+        return decodeCodeword<13>(codeword, decoded, makeFromUint64);
+      case 14:
+        return decodeCodeword<14>(codeword, decoded, makeFromUint64);
+      default:
+        return decodeCodeword<15>(codeword, decoded, makeFromUint64);
+    }
+  }
+
+  // Decode a `codeword` with the given `Selector`.
+  template <size_t Selector, typename Numeric, typename MakeFromUint64t>
+  static size_t decodeCodeword(uint64_t codeword, Numeric* decoded,
+                               const MakeFromUint64t& makeFromUint64) {
+    constexpr size_t width = SIMPLE8B_SELECTORS[Selector]._itemWidth;
+    constexpr size_t groupSize = SIMPLE8B_SELECTORS[Selector]._groupSize;
+    constexpr uint64_t mask = SIMPLE8B_SELECTORS[Selector]._mask;
+    const uint64_t word = codeword >> 4;
+    if constexpr (width == 0) {
+      std::fill(decoded, decoded + groupSize, makeFromUint64(uint64_t{0}));
+#if defined(__AVX2__)
+    } else if constexpr (groupSize >= 4 && std::is_same_v<Numeric, uint64_t> &&
+                         std::is_same_v<MakeFromUint64t, std::identity>) {
+      // Extract four elements at once by shifting four copies of the word by
+      // different amounts.
+      constexpr size_t nofVectors = groupSize / 4;
+      const __m256i words = _mm256_set1_epi64x(static_cast<int64_t>(word));
+      const __m256i masks = _mm256_set1_epi64x(static_cast<int64_t>(mask));
+      const __m256i step = _mm256_set1_epi64x(4 * width);
+      __m256i shifts = _mm256_setr_epi64x(0, width, 2 * width, 3 * width);
+      for (size_t i = 0; i < nofVectors; ++i) {
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(decoded + 4 * i),
+            _mm256_and_si256(_mm256_srlv_epi64(words, shifts), masks));
+        shifts = _mm256_add_epi64(shifts, step);
+      }
+      for (size_t i = 4 * nofVectors; i < groupSize; ++i) {
+        decoded[i] = (word >> (i * width)) & mask;
+      }
+#endif
+    } else {
+      // The compiler unrolls (and typically vectorizes) this loop, as all the
+      // shifts are known at compile time.
+      for (size_t i = 0; i < groupSize; ++i) {
+        decoded[i] = makeFromUint64((word >> (i * width)) & mask);
+      }
+    }
+    return groupSize;
+  }
+
+  // Replace `data[0], ..., data[n - 1]` by `base + data[0], base + data[0] +
+  // data[1], ...` and return the last of these values (`base` if `n == 0`).
+  static uint64_t inclusivePrefixSum(uint64_t* data, size_t n, uint64_t base) {
+    size_t i = 0;
+    // For the codewords with few (large) elements, the setup of the SIMD
+    // registers costs more than it saves.
+    if (n < 8) {
+      for (; i < n; ++i) {
+        base += data[i];
+        data[i] = base;
+      }
+      return base;
+    }
+#if defined(__AVX2__)
+    __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(base));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+      auto* address = reinterpret_cast<__m256i*>(data + i);
+      __m256i x = _mm256_loadu_si256(address);
+      // [x0, x1, x2, x3] -> [x0, x0 + x1, x1 + x2, x2 + x3]
+      x = _mm256_add_epi64(
+          x, _mm256_blend_epi32(
+                 _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero,
+                 0b00000011));
+      // -> [x0, x0 + x1, x0 + x1 + x2, x0 + x1 + x2 + x3]
+      x = _mm256_add_epi64(
+          x, _mm256_blend_epi32(
+                 _mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero,
+                 0b00001111));
+      x = _mm256_add_epi64(x, carry);
+      _mm256_storeu_si256(address, x);
+      carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    if (i > 0) {
+      base = data[i - 1];
+    }
+#elif defined(__SSE2__)
+    __m128i carry = _mm_set1_epi64x(static_cast<int64_t>(base));
+    for (; i + 2 <= n; i += 2) {
+      auto* address = reinterpret_cast<__m128i*>(data + i);
+      __m128i x = _mm_loadu_si128(address);
+      // [x0, x1] -> [x0, x0 + x1]
+      x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+      x = _mm_add_epi64(x, carry);
+      _mm_storeu_si128(address, x);
+      carry = _mm_unpackhi_epi64(x, x);
+    }
+    if (i > 0) {
+      base = data[i - 1];
+    }
+#endif
+    for (; i < n; ++i) {
+      base += data[i];
+      data[i] = base;
+    }
+    return base;
+  }
 };
 }  // namespace ad_utility
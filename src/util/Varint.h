@@ -0,0 +1,31 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ad_utility {
+// Append `value` to the `target` as a varint (7 bits per byte, the highest bit
+// is set for all bytes but the last).
+inline void appendVarint(std::string& target, uint64_t value) {
+  while (value >= 0x80) {
+    target.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  target.push_back(static_cast<char>(value));
+}
+
+// Read a varint that was written by `appendVarint` and advance the `ptr`.
+inline uint64_t readVarint(const char*& ptr) {
+  uint64_t result = 0;
+  for (size_t shift = 0;; shift += 7) {
+    auto byte = static_cast<uint8_t>(*ptr++);
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      return result;
+    }
+  }
+}
+}  // namespace ad_utility
@@ -108,6 +108,92 @@ std::istringstream HttpClientImpl<StreamType>::sendRequest(
   return responseBody;
 }
 
+// ____________________________________________________________________________
+template <typename StreamType>
+boost::system::error_code HttpClientImpl<StreamType>::runUntilDeadline(
+    const auto& startOperation,
+    std::chrono::steady_clock::time_point deadline) {
+  std::optional<boost::system::error_code> result;
+  startOperation([&result](boost::system::error_code ec, size_t) {
+    result = ec;
+  });
+  io_context_.restart();
+  io_context_.run_until(deadline);
+  if (!result.has_value()) {
+    // Cancel the operation and wait until its handler has run, it refers to
+    // `result`.
+    beast::get_lowest_layer(*stream_).cancel();
+    io_context_.restart();
+    io_context_.run();
+    throw std::runtime_error(
+        "Deadline reached before the HTTP request has completed");
+  }
+  return result.value();
+}
+
+// ____________________________________________________________________________
+template <typename StreamType>
+cppcoro::generator<std::string>
+HttpClientImpl<StreamType>::sendRequestStreaming(
+    boost::beast::http::verb method, std::string host, std::string target,
+    std::string requestBody, std::string contentTypeHeader,
+    std::string acceptHeader, std::chrono::steady_clock::time_point deadline) {
+  AD_CORRECTNESS_CHECK(stream_);
+  http::request<http::string_body> request;
+  request.method(method);
+  request.target(target);
+  request.set(http::field::host, host);
+  request.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+  request.set(http::field::accept, acceptHeader);
+  request.set(http::field::content_type, contentTypeHeader);
+  request.set(http::field::content_length, std::to_string(requestBody.size()));
+  request.body() = std::move(requestBody);
+
+  auto throwIfError = [](boost::system::error_code ec) {
+    if (ec) {
+      throw boost::system::system_error{ec};
+    }
+  };
+  throwIfError(runUntilDeadline(
+      [&](auto handler) { http::async_write(*stream_, request, handler); },
+      deadline));
+
+  // Read the header, then the body in chunks of (at most) the size of
+  // `chunk`, see
+  // https://www.boost.org/doc/libs/master/libs/beast/doc/html/beast/more_examples/http_relay.html
+  beast::flat_buffer buffer;
+  http::response_parser<http::buffer_body> parser;
+  parser.body_limit((std::numeric_limits<std::uint64_t>::max)());
+  throwIfError(runUntilDeadline(
+      [&](auto handler) {
+        http::async_read_header(*stream_, buffer, parser, handler);
+      },
+      deadline));
+  if (parser.get().result() != http::status::ok) {
+    throw std::runtime_error(absl::StrCat(
+        "HTTP request to ", host, target, " failed with status ",
+        parser.get().result_int(), " (", toStd(parser.get().reason()), ")"));
+  }
+  std::string chunk(1 << 16, '\0');
+  while (!parser.is_done()) {
+    parser.get().body().data = chunk.data();
+    parser.get().body().size = chunk.size();
+    auto ec = runUntilDeadline(
+        [&](auto handler) {
+          http::async_read(*stream_, buffer, parser, handler);
+        },
+        deadline);
+    // `need_buffer` only means that `chunk` is full.
+    if (ec != http::error::need_buffer) {
+      throwIfError(ec);
+    }
+    size_t numBytesRead = chunk.size() - parser.get().body().size;
+    if (numBytesRead > 0) {
+      co_yield chunk.substr(0, numBytesRead);
+    }
+  }
+}
+
 // ____________________________________________________________________________
 template <typename StreamType>
 http::response<http::string_body>
@@ -161,3 +247,37 @@ std::istringstream sendHttpOrHttpsRequest(
     return sendRequest.operator()<HttpsClient>();
   }
 }
+
+namespace {
+// Create a client for the `url` and send the request via
+// `sendRequestStreaming`. The client lives as long as the returned generator.
+template <typename Client>
+cppcoro::generator<std::string> sendRequestStreamingWithNewClient(
+    Url url, boost::beast::http::verb method, std::string postData,
+    std::string contentTypeHeader, std::string acceptHeader,
+    std::chrono::steady_clock::time_point deadline) {
+  Client client{url.host(), url.port()};
+  for (auto& chunk : client.sendRequestStreaming(
+           method, url.host(), url.target(), std::move(postData),
+           std::move(contentTypeHeader), std::move(acceptHeader), deadline)) {
+    co_yield chunk;
+  }
+}
+}  // namespace
+
+// ____________________________________________________________________________
+cppcoro::generator<std::string> sendHttpOrHttpsRequestStreaming(
+    ad_utility::httpUtils::Url url, boost::beast::http::verb method,
+    std::string postData, std::string contentTypeHeader,
+    std::string acceptHeader, std::chrono::steady_clock::time_point deadline) {
+  if (url.protocol() == Url::Protocol::HTTP) {
+    return sendRequestStreamingWithNewClient<HttpClient>(
+        std::move(url), method, std::move(postData),
+        std::move(contentTypeHeader), std::move(acceptHeader), deadline);
+  } else {
+    AD_CORRECTNESS_CHECK(url.protocol() == Url::Protocol::HTTPS);
+    return sendRequestStreamingWithNewClient<HttpsClient>(
+        std::move(url), method, std::move(postData),
+        std::move(contentTypeHeader), std::move(acceptHeader), deadline);
+  }
+}
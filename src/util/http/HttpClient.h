@@ -15,9 +15,11 @@
 // order of the includes should not matter, and it should certainly not cause
 // segmentation faults.
 
+#include <chrono>
 #include <sstream>
 #include <string>
 
+#include "util/Generator.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/beast.h"
 
@@ -50,12 +52,34 @@ class HttpClientImpl {
       std::string_view contentTypeHeader = "text/plain",
       std::string_view acceptHeader = "text/plain");
 
+  // Same as `sendRequest`, but yield the body of the response in chunks as
+  // soon as they arrive, so that it can be processed while it is still being
+  // received. If the request has not completed when the `deadline` is reached,
+  // the connection is closed and an exception is thrown. An exception is also
+  // thrown if the status of the response is not `200 OK`.
+  //
+  // NOTE: The returned generator refers to this client, which must therefore
+  // outlive it.
+  cppcoro::generator<std::string> sendRequestStreaming(
+      boost::beast::http::verb method, std::string host, std::string target,
+      std::string requestBody, std::string contentTypeHeader,
+      std::string acceptHeader,
+      std::chrono::steady_clock::time_point deadline);
+
   // Simple way to establish a websocket connection
   boost::beast::http::response<boost::beast::http::string_body>
   sendWebSocketHandshake(const boost::beast::http::verb& method,
                          std::string_view host, std::string_view target);
 
  private:
+  // Start the asynchronous operation `startOperation` (which is called with a
+  // completion handler) and run the `io_context_` until it has completed or
+  // the `deadline` is reached. In the latter case, the operation is cancelled
+  // and an exception is thrown. Return the error code of the operation.
+  boost::system::error_code runUntilDeadline(
+      const auto& startOperation,
+      std::chrono::steady_clock::time_point deadline);
+
   // The connection stream and associated objects. See the implementation of
   // `openStream` for why we need all of them, and not just `stream_`.
   boost::asio::io_context io_context_;
@@ -80,3 +104,10 @@ std::istringstream sendHttpOrHttpsRequest(
     std::string_view postData = "",
     std::string_view contentTypeHeader = "text/plain",
     std::string_view acceptHeader = "text/plain");
+
+// Streaming version of `sendHttpOrHttpsRequest`, see
+// `HttpClientImpl::sendRequestStreaming`.
+cppcoro::generator<std::string> sendHttpOrHttpsRequestStreaming(
+    ad_utility::httpUtils::Url url, boost::beast::http::verb method,
+    std::string postData, std::string contentTypeHeader,
+    std::string acceptHeader, std::chrono::steady_clock::time_point deadline);
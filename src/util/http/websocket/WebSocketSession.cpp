@@ -4,6 +4,7 @@
 
 #include "WebSocketSession.h"
 
+#include <absl/cleanup/cleanup.h>
 #include <boost/asio/experimental/awaitable_operators.hpp>
 #include <ctre-unicode.hpp>
 #include <optional>
@@ -129,6 +130,8 @@ net::awaitable<void> WebSocketSession::handleSession(
   UpdateFetcher fetcher{queryHub, queryId};
   WebSocketSession webSocketSession{std::move(fetcher), std::move(socket),
                                     queryRegistry, std::move(queryId)};
+  ++numActiveSessions_;
+  absl::Cleanup decrementNumActiveSessions{[]() { --numActiveSessions_; }};
   co_await webSocketSession.acceptAndWait(request);
 }
 // _____________________________________________________________________________
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <boost/beast/websocket.hpp>
 
 #include "util/CancellationHandle.h"
@@ -28,6 +29,9 @@ class WebSocketSession {
   QueryId queryId_;
   bool cancelOnClose_ = false;
 
+  /// The number of sessions that are currently open.
+  static inline std::atomic<size_t> numActiveSessions_ = 0;
+
   /// Wait for input from the client in a loop. If the client sends the string
   /// "cancel" this will attempt to cancel the current query. If the string is
   /// "cancel_on_close", it will attempt to cancel it when the websocket closes
@@ -67,5 +71,8 @@ class WebSocketSession {
   /// path is not accepted by the server.
   static std::optional<http::response<http::string_body>>
   getErrorResponseIfPathIsInvalid(const http::request<http::string_body>&);
+
+  /// The number of websocket sessions that are currently open (in any thread).
+  static size_t getNumActiveSessions() { return numActiveSessions_.load(); }
 };
 };  // namespace ad_utility::websocket
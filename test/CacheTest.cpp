@@ -139,4 +139,19 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+// _____________________________________________________________________________
+TEST(LRUCacheTest, testErase) {
+  LRUCache<string, string, StringSizeGetter<string>> cache(5);
+  cache.insert("1", "x");
+  cache.insert("2", "xx");
+  cache.erase("1");
+  cache.erase("non-existent");
+  ASSERT_FALSE(cache["1"]);
+  ASSERT_EQ(*cache["2"], "xx");
+  ASSERT_EQ(cache.numNonPinnedEntries(), 1u);
+  // An erased key can be inserted again.
+  cache.insert("1", "y");
+  ASSERT_EQ(*cache["1"], "y");
+}
 }  // namespace ad_utility
@@ -0,0 +1,199 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../src/index/ColumnStatistics.h"
+#include "../src/util/HyperLogLog.h"
+#include "../src/util/Serializer/ByteBufferSerializer.h"
+#include "./util/IdTestHelpers.h"
+
+using ad_utility::HyperLogLog;
+using valueIdComparators::Comparison;
+
+namespace {
+auto I = ad_utility::testing::IntId;
+auto V = ad_utility::testing::VocabId;
+
+// Build the statistics for the given sorted `values`.
+ColumnStatistics build(const std::vector<Id>& values) {
+  ColumnStatistics::Builder builder;
+  for (Id value : values) {
+    builder.push(value);
+  }
+  EXPECT_EQ(builder.numRows(), values.size());
+  return std::move(builder).finish();
+}
+
+// The `VocabId`s `begin, begin + step, ...` (`numValues` many), each repeated
+// `numRepetitions` times.
+std::vector<Id> vocabIds(size_t begin, size_t numValues, size_t step = 1,
+                         size_t numRepetitions = 1) {
+  std::vector<Id> result;
+  for (size_t i = 0; i < numValues; ++i) {
+    for (size_t j = 0; j < numRepetitions; ++j) {
+      result.push_back(V(begin + i * step));
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, estimate) {
+  HyperLogLog empty;
+  EXPECT_EQ(empty.estimate(), 0.0);
+  for (size_t numValues : {10u, 1'000u, 100'000u}) {
+    HyperLogLog sketch;
+    for (size_t i = 0; i < numValues; ++i) {
+      // Duplicates don't change the estimate.
+      sketch.add(i);
+      sketch.add(i);
+    }
+    EXPECT_NEAR(sketch.estimate(), static_cast<double>(numValues),
+                0.1 * static_cast<double>(numValues));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HyperLogLog, mergeAndSerialize) {
+  HyperLogLog a;
+  HyperLogLog b;
+  for (size_t i = 0; i < 20'000; ++i) {
+    a.add(i);
+    b.add(i + 10'000);
+  }
+  auto merged = a;
+  merged.merge(b);
+  EXPECT_NEAR(merged.estimate(), 30'000, 3'000);
+
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << merged;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  HyperLogLog deserialized;
+  reader >> deserialized;
+  EXPECT_EQ(deserialized, merged);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnStatistics, builder) {
+  auto empty = build({});
+  EXPECT_TRUE(empty.buckets().empty());
+  EXPECT_EQ(empty.estimateSelectivity(Comparison::LT, I(3)), 0.0);
+
+  auto small = build({V(1), V(1), V(2), V(5)});
+  EXPECT_EQ(small.numRows(), 4u);
+  EXPECT_EQ(small.numDistinct(), 3u);
+
+  // Many rows with skew: the first value is very frequent.
+  auto values = vocabIds(0, 1, 1, 50'000);
+  std::ranges::copy(vocabIds(1, 50'000), std::back_inserter(values));
+  auto statistics = build(values);
+  EXPECT_EQ(statistics.numRows(), 100'000u);
+  EXPECT_EQ(statistics.numDistinct(), 50'001u);
+  EXPECT_GE(statistics.buckets().size(), ColumnStatistics::NUM_BUCKETS / 2);
+  EXPECT_LE(statistics.buckets().size(), 2 * ColumnStatistics::NUM_BUCKETS + 1);
+  // Equal values are never split between buckets.
+  EXPECT_EQ(statistics.buckets().front().lowerBound_, V(0));
+  EXPECT_GE(statistics.buckets().front().numRows_, 50'000u);
+  EXPECT_EQ(statistics.buckets().front().numRows_,
+            statistics.buckets().front().numDistinct_ + 49'999);
+  for (size_t i = 0; i + 1 < statistics.buckets().size(); ++i) {
+    EXPECT_LT(statistics.buckets()[i].upperBound_,
+              statistics.buckets()[i + 1].lowerBound_);
+  }
+  EXPECT_NEAR(statistics.distinctValues().estimate(), 50'001, 5'000);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnStatistics, estimateSelectivity) {
+  std::vector<Id> values;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    values.push_back(I(i));
+  }
+  auto statistics = build(values);
+  EXPECT_NEAR(statistics.estimateSelectivity(Comparison::LT, I(1'000)), 0.1,
+              0.01);
+  EXPECT_NEAR(statistics.estimateSelectivity(Comparison::GE, I(2'500)), 0.75,
+              0.01);
+  EXPECT_NEAR(statistics.estimateSelectivity(Comparison::EQ, I(42)), 1e-4,
+              1e-5);
+  EXPECT_NEAR(statistics.estimateSelectivity(Comparison::NE, I(42)), 1.0, 1e-3);
+  EXPECT_EQ(statistics.estimateSelectivity(Comparison::EQ, I(-5)), 0.0);
+  EXPECT_EQ(statistics.estimateSelectivity(Comparison::GT, I(20'000)), 0.0);
+  // Doubles are compared by their value.
+  EXPECT_NEAR(statistics.estimateSelectivity(
+                  Comparison::LT, ad_utility::testing::DoubleId(500.5)),
+              0.05, 0.01);
+  // Incompatible types never match.
+  EXPECT_EQ(statistics.estimateSelectivity(Comparison::LT, V(3)), 0.0);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnStatistics, estimateJoin) {
+  // Identical columns.
+  auto a = build(vocabIds(0, 10'000));
+  auto estimate = ColumnStatistics::estimateJoin(a, a);
+  EXPECT_NEAR(estimate.size_, 10'000, 1'000);
+  EXPECT_NEAR(estimate.numDistinct_, 10'000, 1'000);
+
+  // Each value of `b` occurs ten times, but `b` only contains the even values
+  // of `a`.
+  auto b = build(vocabIds(0, 5'000, 2, 10));
+  estimate = ColumnStatistics::estimateJoin(a, b);
+  EXPECT_NEAR(estimate.size_, 50'000, 5'000);
+
+  // The ranges overlap, but the values are disjoint, which only the sketches
+  // can tell.
+  auto c = build(vocabIds(1, 5'000, 2));
+  estimate = ColumnStatistics::estimateJoin(b, c);
+  EXPECT_LT(estimate.size_, 5'000);
+
+  // Disjoint ranges.
+  auto d = build(vocabIds(20'000, 100));
+  estimate = ColumnStatistics::estimateJoin(a, d);
+  EXPECT_EQ(estimate.size_, 0.0);
+  EXPECT_EQ(estimate.numDistinct_, 0.0);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnStatistics, serialization) {
+  auto statistics = build(vocabIds(0, 1'000, 3, 2));
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << statistics;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  ColumnStatistics deserialized;
+  reader >> deserialized;
+  EXPECT_EQ(deserialized, statistics);
+}
+
+// _____________________________________________________________________________
+TEST(ColumnStatistics, file) {
+  std::string filename = "columnStatisticsTest.dat";
+  auto a = build(vocabIds(0, 1'000, 3, 2));
+  auto b = build(vocabIds(500, 100));
+  {
+    ColumnStatisticsFile::Writer writer{filename};
+    writer.add(V(3), b);
+    writer.add(V(7), a);
+    // The relations have to be added in the order of their `col0Id`.
+    EXPECT_ANY_THROW(writer.add(V(5), b));
+    writer.finish();
+  }
+  {
+    ColumnStatisticsFile file{filename};
+    for (size_t i = 0; i < 2; ++i) {
+      ASSERT_NE(file.get(V(3)), nullptr);
+      EXPECT_EQ(*file.get(V(3)), b);
+      ASSERT_NE(file.get(V(7)), nullptr);
+      EXPECT_EQ(*file.get(V(7)), a);
+    }
+    EXPECT_EQ(file.get(V(5)), nullptr);
+    EXPECT_EQ(file.get(V(8)), nullptr);
+    EXPECT_EQ(file.get(I(3)), nullptr);
+  }
+  ad_utility::deleteFile(filename);
+}
@@ -275,6 +275,35 @@ TEST(ConcurrentCache, abort) {
   ASSERT_THROW(fut.get(), std::runtime_error);
 }
 
+TEST(ConcurrentCache, computationGivenUp) {
+  auto a = SimpleConcurrentLruCache(3ul);
+  StartStopSignal signal;
+  auto giveUp = [&signal]() -> std::string {
+    signal.hasStartedSignal_.notify();
+    signal.mayFinishSignal_.wait();
+    throw ad_utility::ComputationWasGivenUpException{"given up"};
+  };
+  auto fut = std::async(std::launch::async,
+                        [&a, &giveUp]() { return a.computeOnce(3, giveUp); });
+  signal.hasStartedSignal_.wait();
+  auto waiting = std::async(std::launch::async, [&a]() {
+    return a.computeOnce(3, waiting_function("3"s, 0));
+  });
+  // Wait until the second thread waits for the computation of the first one
+  // (the entry in the map and both threads hold the `ResultInProgress`).
+  while (a.getStorage().wlock()->_inProgress.at(3).second.use_count() < 3) {
+    std::this_thread::sleep_for(1ms);
+  }
+  signal.mayFinishSignal_.notify();
+  ASSERT_THROW(fut.get(), ad_utility::ComputationWasGivenUpException);
+  // The waiting thread has computed the result itself.
+  auto result = waiting.get();
+  ASSERT_EQ(*result._resultPointer, "3");
+  ASSERT_EQ(result._cacheStatus, ad_utility::CacheStatus::computed);
+  ASSERT_EQ(1ul, a.numNonPinnedEntries());
+  ASSERT_EQ(0ul, a.getStorage().wlock()->_inProgress.size());
+}
+
 TEST(ConcurrentCache, abortPinned) {
   auto a = SimpleConcurrentLruCache(3ul);
   StartStopSignal signal;
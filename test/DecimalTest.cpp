@@ -0,0 +1,95 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "global/Constants.h"
+#include "global/ValueId.h"
+#include "util/Decimal.h"
+
+namespace {
+Decimal parse(std::string_view input) {
+  auto result = Decimal::parse(input);
+  EXPECT_TRUE(result.has_value()) << input;
+  return result.value();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(Decimal, parse) {
+  EXPECT_EQ(parse("0").getUnits(), 0);
+  EXPECT_EQ(parse("-0.0").getUnits(), 0);
+  EXPECT_EQ(parse("12.5").getUnits(), 12'500'000);
+  EXPECT_EQ(parse("+12.50").getUnits(), 12'500'000);
+  EXPECT_EQ(parse("-.5").getUnits(), -500'000);
+  EXPECT_EQ(parse("3.").getUnits(), 3'000'000);
+  EXPECT_EQ(parse("0.000001").getUnits(), 1);
+  EXPECT_EQ(parse("0.00000100").getUnits(), 1);
+  EXPECT_EQ(parse("000000000000000042").getUnits(), 42'000'000);
+  EXPECT_EQ(parse("-576460752303.423488").getUnits(), Decimal::minUnits);
+  EXPECT_EQ(parse("576460752303.423487").getUnits(), Decimal::maxUnits);
+
+  for (std::string_view input :
+       {"", "-", ".", "+.", "1.2.3", "1e3", "abc", "1,5", " 1", "0.0000001",
+        "576460752303.423488", "-576460752303.423489", "1000000000000"}) {
+    EXPECT_FALSE(Decimal::parse(input).has_value()) << input;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Decimal, toStringAndType) {
+  auto toString = [](std::string_view input) {
+    auto [string, type] = parse(input).toStringAndType();
+    EXPECT_STREQ(type, XSD_DECIMAL_TYPE);
+    return string;
+  };
+  EXPECT_EQ(toString("0"), "0.0");
+  EXPECT_EQ(toString("-0.0"), "0.0");
+  EXPECT_EQ(toString("12.50"), "12.5");
+  EXPECT_EQ(toString("-.5"), "-0.5");
+  EXPECT_EQ(toString("0.000001"), "0.000001");
+  EXPECT_EQ(toString("-42"), "-42.0");
+  EXPECT_EQ(toString("-576460752303.423488"), "-576460752303.423488");
+}
+
+// _____________________________________________________________________________
+TEST(Decimal, bitsAndOrder) {
+  std::vector<Decimal> decimals{parse("-576460752303.423488"), parse("-12.5"),
+                                parse("-0.000001"),           parse("0"),
+                                parse("0.000001"),            parse("3"),
+                                parse("576460752303.423487")};
+  for (size_t i = 0; i < decimals.size(); ++i) {
+    EXPECT_EQ(Decimal::fromBits(decimals[i].toBits()), decimals[i]);
+    EXPECT_EQ(decimals[i].toBits() >> Decimal::numDataBits, 0u);
+    if (i > 0) {
+      EXPECT_LT(decimals[i - 1], decimals[i]);
+      EXPECT_LT(decimals[i - 1].toBits(), decimals[i].toBits());
+    }
+  }
+  EXPECT_ANY_THROW(Decimal::fromUnits(Decimal::maxUnits + 1));
+  EXPECT_ANY_THROW(Decimal::fromUnits(Decimal::minUnits - 1));
+}
+
+// _____________________________________________________________________________
+TEST(Decimal, compareWithNumbers) {
+  EXPECT_EQ(parse("3.0"), 3);
+  EXPECT_LT(parse("2.999999"), 3);
+  EXPECT_GT(parse("-2.5"), -3);
+  EXPECT_GT(parse("0.5"), 0);
+  EXPECT_EQ(parse("-2.5"), -2.5);
+  EXPECT_LT(parse("0.1"), 0.2);
+  // The comparison with a double is done with the precision of the doubles in
+  // a `ValueId`.
+  EXPECT_EQ(parse("0.1"), ValueId::makeFromDouble(0.1).getDouble());
+  EXPECT_EQ(parse("1.1").toDouble(), 1.1);
+}
+
+// _____________________________________________________________________________
+TEST(Decimal, valueId) {
+  auto decimal = parse("-12.5");
+  auto id = ValueId::makeFromDecimal(decimal);
+  EXPECT_EQ(id.getDatatype(), Datatype::Decimal);
+  EXPECT_EQ(id.getDecimal(), decimal);
+  EXPECT_LT(ValueId::makeFromDecimal(parse("-13")), id);
+  EXPECT_LT(id, ValueId::makeFromDecimal(parse("0.1")));
+}
@@ -0,0 +1,112 @@
+// Copyright 2024, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "index/DocsDB.h"
+#include "util/File.h"
+
+namespace {
+// Write the `docs` (pairs of text record index and text) to a docs file and
+// build a DocsDB from it. Return the name of the DocsDB.
+std::string buildDocsDB(
+    const std::vector<std::pair<uint64_t, std::string>>& docs) {
+  std::string docsFileName = "docsDBTest.documents";
+  std::string dbFileName = "docsDBTest.text.docsDB";
+  {
+    auto out = ad_utility::makeOfstream(docsFileName);
+    for (const auto& [cid, text] : docs) {
+      out << cid << '\t' << text << '\n';
+    }
+  }
+  DocsDB::build(docsFileName, dbFileName);
+  ad_utility::deleteFile(docsFileName);
+  return dbFileName;
+}
+
+void deleteDocsDB(const std::string& dbFileName) {
+  ad_utility::deleteFile(dbFileName);
+  ad_utility::deleteFile(dbFileName + std::string{DocsDB::OFFSETS_SUFFIX});
+}
+
+auto cid = [](uint64_t i) { return TextRecordIndex::make(i); };
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DocsDB, SmallCompressedDocsDB) {
+  // Text records 1 and 4 have no document.
+  auto fileName = buildDocsDB(
+      {{0, "the first document"}, {2, "the second one"}, {3, "and a third"}});
+  DocsDB db;
+  db.init(fileName);
+  ASSERT_EQ(db.size(), 4u);
+  EXPECT_EQ(db.getTextExcerpt(cid(0)), "the first document");
+  EXPECT_EQ(db.getTextExcerpt(cid(1)), "");
+  EXPECT_EQ(db.getTextExcerpt(cid(2)), "the second one");
+  EXPECT_EQ(db.getTextExcerpt(cid(3)), "and a third");
+
+  std::vector<TextRecordIndex> cids{cid(3), cid(0), cid(17), cid(3), cid(1)};
+  EXPECT_THAT(db.getTextExcerpts(cids),
+              ::testing::ElementsAre("and a third", "the first document", "",
+                                     "and a third", ""));
+  deleteDocsDB(fileName);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, ManyBlocksWithDictionary) {
+  // Enough text for many blocks and for the training of a dictionary.
+  std::vector<std::pair<uint64_t, std::string>> docs;
+  size_t numBytes = 0;
+  for (uint64_t i = 0; numBytes < 20 * DocsDB::MAX_DICTIONARY_SIZE; ++i) {
+    std::string text = "Document number " + std::to_string(i) +
+                       " is about the entity Q" + std::to_string(i * 7919) +
+                       std::string(i % 100, 'x');
+    numBytes += text.size();
+    docs.emplace_back(2 * i, std::move(text));
+  }
+  auto fileName = buildDocsDB(docs);
+  DocsDB db;
+  db.init(fileName);
+  ASSERT_EQ(db.size(), docs.back().first + 1);
+  // The compressed file is much smaller than the text.
+  ad_utility::File dbFile{fileName, "r"};
+  EXPECT_LT(dbFile.sizeOfFile(), numBytes / 4);
+
+  std::vector<TextRecordIndex> cids;
+  std::vector<std::string> expected;
+  for (size_t i = docs.size() - 1; i > 0; i /= 2) {
+    cids.push_back(cid(docs[i].first));
+    expected.push_back(docs[i].second);
+    cids.push_back(cid(docs[i].first + 1));
+    expected.emplace_back();
+    EXPECT_EQ(db.getTextExcerpt(cid(docs[i].first)), docs[i].second);
+  }
+  EXPECT_EQ(db.getTextExcerpts(cids), expected);
+  deleteDocsDB(fileName);
+}
+
+// _____________________________________________________________________________
+TEST(DocsDB, LegacyFormat) {
+  // The uncompressed documents followed by their offsets.
+  std::string fileName = "docsDBTest.legacy.docsDB";
+  std::string text = "firstsecond";
+  std::vector<off_t> offsets{0, 5, 11};
+  {
+    ad_utility::File out{fileName, "w"};
+    out.write(text.data(), text.size());
+    out.write(offsets.data(), offsets.size() * sizeof(off_t));
+  }
+  DocsDB db;
+  db.init(fileName);
+  ASSERT_EQ(db.size(), 2u);
+  EXPECT_EQ(db.getTextExcerpt(cid(0)), "first");
+  EXPECT_EQ(db.getTextExcerpt(cid(1)), "second");
+  std::vector<TextRecordIndex> cids{cid(1), cid(2), cid(0)};
+  EXPECT_THAT(db.getTextExcerpts(cids),
+              ::testing::ElementsAre("second", "", "first"));
+  ad_utility::deleteFile(fileName);
+}
@@ -203,6 +203,200 @@ TEST(FTSAlgorithmsTest, crossIntersectKWayTest) {
   ASSERT_EQ(2u, resultWep.cids_.size());
 };
 
+TEST(FTSAlgorithmsTest, crossIntersectWithSkewedSizes) {
+  // The intersection gallops over the long list, the result must be the same
+  // as with a linear scan.
+  Index::WordEntityPostings matchingContextsWep;
+  matchingContextsWep.cids_ = {TRID(3), TRID(500), TRID(500), TRID(999),
+                               TRID(5000)};
+  matchingContextsWep.wids_ = {{1, 2, 3, 4, 5}};
+  matchingContextsWep.scores_ = {1, 1, 1, 1, 1};
+
+  Index::WordEntityPostings eBlockWep;
+  for (size_t i = 0; i < 1000; ++i) {
+    eBlockWep.cids_.push_back(TRID(i));
+    eBlockWep.eids_.push_back(V(i % 7));
+    eBlockWep.scores_.push_back(static_cast<Score>(i % 3));
+  }
+  auto resultWep =
+      FTSAlgorithms::crossIntersect(matchingContextsWep, eBlockWep);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(3), TRID(500),
+                                                      TRID(500), TRID(999)));
+  EXPECT_THAT(resultWep.eids_,
+              ::testing::ElementsAre(V(3), V(3), V(3), V(5)));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(0, 2, 2, 0));
+  EXPECT_THAT(resultWep.wids_[0], ::testing::ElementsAre(1, 2, 3, 4));
+
+  // Swap the roles of the lists.
+  matchingContextsWep.cids_ = eBlockWep.cids_;
+  matchingContextsWep.wids_ = {vector<WordIndex>(1000, 42)};
+  matchingContextsWep.scores_ = eBlockWep.scores_;
+  eBlockWep.cids_ = {TRID(17), TRID(998)};
+  eBlockWep.eids_ = {V(1), V(2)};
+  eBlockWep.scores_ = {4, 5};
+  resultWep = FTSAlgorithms::crossIntersect(matchingContextsWep, eBlockWep);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(17), TRID(998)));
+  EXPECT_THAT(resultWep.eids_, ::testing::ElementsAre(V(1), V(2)));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(4, 5));
+  EXPECT_THAT(resultWep.wids_[0], ::testing::ElementsAre(42, 42));
+}
+
+TEST(FTSAlgorithmsTest, blockMaxTopK) {
+  // Three chunks of postings, sorted by cid.
+  vector<Index::WordEntityPostings> chunks(3);
+  chunks[0].cids_ = {TRID(0), TRID(1), TRID(2)};
+  chunks[0].wids_ = {{10, 11, 12}};
+  chunks[0].scores_ = {1, 2, 1};
+  chunks[1].cids_ = {TRID(3), TRID(4), TRID(5)};
+  chunks[1].wids_ = {{13, 14, 15}};
+  chunks[1].scores_ = {9, 3, 7};
+  chunks[2].cids_ = {TRID(6), TRID(7)};
+  chunks[2].wids_ = {{16, 17}};
+  chunks[2].scores_ = {5, 6};
+  vector<Score> maxScores{2, 9, 6};
+
+  vector<size_t> readChunks;
+  auto readChunk = [&](size_t i) {
+    readChunks.push_back(i);
+    return chunks.at(i);
+  };
+
+  // The two best postings are both in the second chunk.
+  auto resultWep = FTSAlgorithms::blockMaxTopK(maxScores, 2, readChunk);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(3), TRID(5)));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(9, 7));
+  EXPECT_THAT(resultWep.wids_[0], ::testing::ElementsAre(13, 15));
+  EXPECT_THAT(resultWep.eids_, ::testing::ElementsAre());
+  EXPECT_THAT(readChunks, ::testing::ElementsAre(1));
+
+  // The third chunk has to be read, but the first one doesn't.
+  readChunks.clear();
+  resultWep = FTSAlgorithms::blockMaxTopK(maxScores, 4, readChunk);
+  EXPECT_THAT(resultWep.cids_,
+              ::testing::ElementsAre(TRID(3), TRID(5), TRID(6), TRID(7)));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(9, 7, 5, 6));
+  EXPECT_THAT(readChunks, ::testing::ElementsAre(1, 2));
+
+  // More postings than exist.
+  readChunks.clear();
+  resultWep = FTSAlgorithms::blockMaxTopK(maxScores, 100, readChunk);
+  EXPECT_EQ(resultWep.cids_.size(), 8u);
+  EXPECT_TRUE(std::ranges::is_sorted(resultWep.cids_));
+  EXPECT_THAT(readChunks, ::testing::ElementsAre(1, 2, 0));
+
+  // Entity postings and the trivial cases.
+  chunks[1].wids_ = {{}};
+  chunks[1].eids_ = {V(1), V(2), V(3)};
+  resultWep = FTSAlgorithms::blockMaxTopK(maxScores, 1, readChunk);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(3)));
+  EXPECT_THAT(resultWep.eids_, ::testing::ElementsAre(V(1)));
+  EXPECT_THAT(resultWep.wids_[0], ::testing::ElementsAre());
+  EXPECT_TRUE(FTSAlgorithms::blockMaxTopK(maxScores, 0, readChunk)
+                  .cids_.empty());
+  EXPECT_TRUE(FTSAlgorithms::blockMaxTopK({}, 3, readChunk).cids_.empty());
+}
+
+TEST(FTSAlgorithmsTest, takeTopKContexts) {
+  Index::WordEntityPostings wep;
+  wep.cids_ = {TRID(0), TRID(1), TRID(2), TRID(3)};
+  wep.wids_ = {{10, 11, 12, 13}, {20, 21, 22, 23}};
+  wep.scores_ = {3, 1, 4, 2};
+
+  auto resultWep = FTSAlgorithms::takeTopKContexts(wep, 2);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(0), TRID(2)));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(3, 4));
+  EXPECT_THAT(resultWep.wids_[0], ::testing::ElementsAre(10, 12));
+  EXPECT_THAT(resultWep.wids_[1], ::testing::ElementsAre(20, 22));
+  EXPECT_THAT(resultWep.eids_, ::testing::ElementsAre());
+
+  EXPECT_EQ(FTSAlgorithms::takeTopKContexts(wep, 4).cids_, wep.cids_);
+  EXPECT_EQ(FTSAlgorithms::takeTopKContexts(wep, 10).cids_, wep.cids_);
+  EXPECT_TRUE(FTSAlgorithms::takeTopKContexts(wep, 0).cids_.empty());
+}
+
+TEST(FTSAlgorithmsTest, blockMaxCrossIntersect) {
+  // The word postings (all contexts but 4) and three chunks of the entity
+  // list, sorted by cid.
+  Index::WordEntityPostings matchingContextsWep;
+  matchingContextsWep.cids_ = {TRID(0), TRID(1), TRID(2), TRID(3), TRID(5),
+                               TRID(6)};
+  matchingContextsWep.wids_ = {{10, 11, 12, 13, 15, 16}};
+  matchingContextsWep.scores_ = {1, 1, 1, 1, 1, 1};
+  vector<Index::WordEntityPostings> chunks(3);
+  chunks[0].cids_ = {TRID(0), TRID(1), TRID(2)};
+  chunks[0].eids_ = {V(1), V(2), V(1)};
+  chunks[0].scores_ = {5, 1, 2};
+  chunks[1].cids_ = {TRID(3), TRID(4)};
+  chunks[1].eids_ = {V(1), V(2)};
+  chunks[1].scores_ = {1, 1};
+  chunks[2].cids_ = {TRID(5), TRID(6)};
+  chunks[2].eids_ = {V(1), V(3)};
+  chunks[2].scores_ = {7, 3};
+  vector<Score> maxScores{5, 1, 7};
+
+  vector<size_t> chunksWithScores;
+  auto readChunk = [&](size_t i) {
+    auto chunk = chunks.at(i);
+    chunk.scores_.clear();
+    return chunk;
+  };
+  auto readScores = [&](size_t i) {
+    chunksWithScores.push_back(i);
+    return chunks.at(i).scores_;
+  };
+
+  // The same as intersecting with the complete entity list, but the scores of
+  // the second chunk can't change the best context of `V(1)` and `V(2)`.
+  auto resultWep = FTSAlgorithms::blockMaxCrossIntersect(
+      matchingContextsWep, maxScores, 1, readChunk, readScores);
+  EXPECT_THAT(resultWep.cids_, ::testing::ElementsAre(TRID(0), TRID(1),
+                                                      TRID(2), TRID(3),
+                                                      TRID(5), TRID(6)));
+  EXPECT_THAT(resultWep.eids_, ::testing::ElementsAre(V(1), V(2), V(1), V(1),
+                                                      V(1), V(3)));
+  EXPECT_THAT(resultWep.wids_[0],
+              ::testing::ElementsAre(10, 11, 12, 13, 15, 16));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(5, 1, 2, 0, 7, 3));
+  EXPECT_THAT(chunksWithScores, ::testing::ElementsAre(0, 2));
+
+  // The result of the aggregation is the same as without block-max pruning.
+  Index::WordEntityPostings eBlockWep;
+  for (const auto& chunk : chunks) {
+    auto append = [](auto& target, const auto& source) {
+      target.insert(target.end(), source.begin(), source.end());
+    };
+    append(eBlockWep.cids_, chunk.cids_);
+    append(eBlockWep.eids_, chunk.eids_);
+    append(eBlockWep.scores_, chunk.scores_);
+  }
+  auto fullWep = FTSAlgorithms::crossIntersect(matchingContextsWep, eBlockWep);
+  auto aggregate = [](const Index::WordEntityPostings& wep, size_t k) {
+    IdTable result{makeAllocator()};
+    result.setNumColumns(4);
+    FTSAlgorithms::aggScoresAndTakeTopKContexts<4>(wep, k, &result);
+    std::sort(std::begin(result), std::end(result),
+              [](const auto& a, const auto& b) {
+                return std::ranges::lexicographical_compare(a, b);
+              });
+    return result;
+  };
+  EXPECT_EQ(aggregate(resultWep, 1), aggregate(fullWep, 1));
+
+  // With two contexts per entity, `V(2)` only has one context when the second
+  // chunk is read.
+  chunksWithScores.clear();
+  resultWep = FTSAlgorithms::blockMaxCrossIntersect(
+      matchingContextsWep, maxScores, 2, readChunk, readScores);
+  EXPECT_THAT(chunksWithScores, ::testing::ElementsAre(0, 1, 2));
+  EXPECT_THAT(resultWep.scores_, ::testing::ElementsAre(5, 1, 2, 1, 7, 3));
+  EXPECT_EQ(aggregate(resultWep, 2), aggregate(fullWep, 2));
+
+  // No chunks.
+  EXPECT_TRUE(FTSAlgorithms::blockMaxCrossIntersect(matchingContextsWep, {}, 1,
+                                                    readChunk, readScores)
+                  .cids_.empty());
+}
+
 TEST(FTSAlgorithmsTest, aggScoresAndTakeTopKContextsTest) {
   IdTable result{makeAllocator()};
   result.setNumColumns(4);
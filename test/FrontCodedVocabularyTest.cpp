@@ -0,0 +1,152 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "../src/index/vocabulary/FrontCodedVocabulary.h"
+#include "../src/index/vocabulary/PolymorphicVocabulary.h"
+#include "../src/util/File.h"
+#include "./VocabularyTestHelpers.h"
+
+namespace {
+
+using namespace vocabulary_test;
+
+// Create a `FrontCodedVocabulary` from the `words` by writing it to disk and
+// reading it back.
+auto createVocabularyImpl(const std::vector<std::string>& words,
+                          std::optional<FsstCompressor> compressor) {
+  std::string filename = "frontCodedVocabularyTest.dat";
+  {
+    FrontCodedVocabulary::WordWriter writer{filename, std::move(compressor)};
+    for (const auto& word : words) {
+      writer.push(word);
+    }
+  }
+  FrontCodedVocabulary vocabulary;
+  vocabulary.open(filename);
+  ad_utility::deleteFile(filename);
+  return vocabulary;
+}
+
+auto createVocabulary(const std::vector<std::string>& words) {
+  return createVocabularyImpl(words, std::nullopt);
+}
+
+auto createVocabularyWithFsst(const std::vector<std::string>& words) {
+  return createVocabularyImpl(words, FsstCompressor::train(words));
+}
+
+// Sorted words that span many blocks and share long prefixes.
+std::vector<std::string> createSortedWords() {
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 1000; i += 3) {
+    std::string number = std::to_string(i);
+    words.push_back("<http://example.org/" +
+                    std::string(4 - number.size(), '0') + number + ">");
+  }
+  std::ranges::sort(words);
+  return words;
+}
+
+// Test the access operator and the bounds for `createSortedWords()` (and
+// words between them) for the vocabulary that is created by
+// `createVocabulary`.
+void testManyBlocks(auto createVocabulary) {
+  auto words = createSortedWords();
+  auto vocabulary = createVocabulary(words);
+  ASSERT_EQ(vocabulary.size(), words.size());
+  ASSERT_GT(words.size(), 10 * FrontCodedVocabulary::BLOCK_SIZE);
+  assertThatRangesAreEqual(vocabulary, words);
+  std::vector<uint64_t> ids(words.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  testUpperAndLowerBoundWithStdLessFromWordsAndIds(std::move(vocabulary),
+                                                   words, ids);
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, UpperLowerBound) {
+  testUpperAndLowerBoundWithStdLess(createVocabulary);
+  testUpperAndLowerBoundWithStdLess(createVocabularyWithFsst);
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, UpperLowerBoundAlternativeComparator) {
+  testUpperAndLowerBoundWithNumericComparator(createVocabulary);
+  testUpperAndLowerBoundWithNumericComparator(createVocabularyWithFsst);
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, AccessOperator) {
+  testAccessOperatorForUnorderedVocabulary(createVocabulary);
+  testAccessOperatorForUnorderedVocabulary(createVocabularyWithFsst);
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, EmptyVocabulary) {
+  testEmptyVocabulary(createVocabulary);
+  testEmptyVocabulary(createVocabularyWithFsst);
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, ManyBlocks) {
+  testManyBlocks(createVocabulary);
+  testManyBlocks(createVocabularyWithFsst);
+  // Building in memory gives the same result as writing to disk.
+  testManyBlocks([](const std::vector<std::string>& words) {
+    FrontCodedVocabulary vocabulary;
+    vocabulary.build(words, FsstCompressor::train(words));
+    return vocabulary;
+  });
+}
+
+// _____________________________________________________________________________
+TEST(FrontCodedVocabulary, LongWordsAndSpecialCharacters) {
+  std::vector<std::string> words{"", std::string(1, '\0'),
+                                 std::string(300, 'a'),
+                                 std::string(300, 'a') + "b", "\xff\xfe\n"};
+  for (auto create : {&createVocabulary, &createVocabularyWithFsst}) {
+    auto vocabulary = (*create)(words);
+    assertThatRangesAreEqual(vocabulary, words);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(PolymorphicVocabulary, AllTypes) {
+  auto words = createSortedWords();
+  std::string filename = "polymorphicVocabularyTest.dat";
+  for (auto type :
+       {VocabularyType::PrefixCompressed, VocabularyType::FrontCoded,
+        VocabularyType::FrontCodedFsst}) {
+    EXPECT_EQ(vocabularyTypeFromString(toString(type)), type);
+    PolymorphicVocabulary vocabulary;
+    vocabulary.resetToType(type);
+    if (type == VocabularyType::PrefixCompressed) {
+      vocabulary.getCompressor().buildCodebook(
+          std::vector<std::string>{"<http://example.org/"});
+    } else {
+      EXPECT_ANY_THROW(vocabulary.getCompressor());
+    }
+    {
+      auto writer = vocabulary.makeDiskWriter(
+          filename, type == VocabularyType::FrontCodedFsst
+                        ? std::optional{FsstCompressor::train(words)}
+                        : std::nullopt);
+      for (const auto& word : words) {
+        writer.push(word);
+      }
+      writer.finish();
+    }
+    vocabulary.open(filename);
+    assertThatRangesAreEqual(vocabulary, words);
+    std::vector<uint64_t> ids(words.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    testUpperAndLowerBoundWithStdLessFromWordsAndIds(std::move(vocabulary),
+                                                     words, ids);
+  }
+  ad_utility::deleteFile(filename);
+  EXPECT_ANY_THROW(vocabularyTypeFromString("prefix"));
+}
+}  // namespace
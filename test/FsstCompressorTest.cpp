@@ -0,0 +1,95 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "index/vocabulary/FsstCompressor.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+namespace {
+// Words with a lot of common substrings, like the IRIs of a knowledge graph.
+std::vector<std::string> createWords() {
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 1000; ++i) {
+    words.push_back("<http://www.wikidata.org/entity/Q" + std::to_string(i) +
+                    ">");
+    words.push_back("\"label number " + std::to_string(i * 17) + "\"@en");
+  }
+  return words;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(FsstCompressor, EmptySymbolTable) {
+  FsstCompressor compressor;
+  EXPECT_TRUE(compressor.symbols().empty());
+  for (std::string_view word : {"", "a", "abc", "\xff\xfe"}) {
+    auto compressed = compressor.compress(word);
+    // Each byte is escaped.
+    EXPECT_EQ(compressed.size(), 2 * word.size());
+    EXPECT_EQ(compressor.decompress(compressed), word);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(FsstCompressor, LongestSymbolIsUsed) {
+  FsstCompressor compressor{{"a", "abc", "ab", "x"}};
+  EXPECT_EQ(compressor.compress("abcab"), (std::string{'\1', '\2'}));
+  EXPECT_EQ(compressor.compress("xaz"),
+            (std::string{'\3', '\0', static_cast<char>(255), 'z'}));
+  EXPECT_EQ(compressor.decompress(compressor.compress("abcabxaz")),
+            "abcabxaz");
+
+  // Symbols must have 1 to 8 bytes, and there are at most 255 of them.
+  EXPECT_ANY_THROW(FsstCompressor({""}));
+  EXPECT_ANY_THROW(FsstCompressor({"123456789"}));
+  EXPECT_ANY_THROW(FsstCompressor(std::vector<std::string>(256, "a")));
+}
+
+// _____________________________________________________________________________
+TEST(FsstCompressor, TrainAndRoundTrip) {
+  auto words = createWords();
+  auto compressor = FsstCompressor::train(words);
+  EXPECT_FALSE(compressor.symbols().empty());
+  EXPECT_LE(compressor.symbols().size(), FsstCompressor::MAX_NUM_SYMBOLS);
+  size_t numBytes = 0;
+  size_t numBytesCompressed = 0;
+  for (const auto& word : words) {
+    auto compressed = compressor.compress(word);
+    numBytes += word.size();
+    numBytesCompressed += compressed.size();
+    ASSERT_EQ(compressor.decompress(compressed), word);
+  }
+  EXPECT_LT(numBytesCompressed, numBytes / 2);
+
+  // Words that are not part of the sample can also be compressed.
+  for (std::string_view word : {"", "\n\t", "completely different \xc3\xa4"}) {
+    EXPECT_EQ(compressor.decompress(compressor.compress(word)), word);
+  }
+
+  // Decompression appends to the target.
+  std::string target = "prefix";
+  compressor.decompress(compressor.compress(words[3]), target);
+  EXPECT_EQ(target, "prefix" + words[3]);
+
+  // Sampling is deterministic.
+  auto sampled = FsstCompressor::trainOnSample(words);
+  EXPECT_EQ(sampled.symbols(), compressor.symbols());
+}
+
+// _____________________________________________________________________________
+TEST(FsstCompressor, Serialization) {
+  auto words = createWords();
+  auto compressor = FsstCompressor::train(words);
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << compressor;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  FsstCompressor readCompressor;
+  reader >> readCompressor;
+  EXPECT_EQ(readCompressor.symbols(), compressor.symbols());
+  for (const auto& word : words) {
+    ASSERT_EQ(readCompressor.decompress(compressor.compress(word)), word);
+  }
+}
@@ -0,0 +1,164 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "global/Constants.h"
+#include "global/ValueId.h"
+#include "util/GeoPoint.h"
+
+namespace {
+// The maximal error of a coordinate because of the quantization.
+constexpr double maxError = 360.0 / GeoPoint::maxQuantized;
+
+// Random points that are distributed uniformly over the map.
+std::vector<GeoPoint> randomPoints(size_t numPoints) {
+  std::mt19937_64 randomEngine{42};
+  std::uniform_real_distribution<double> lat{-90.0, 90.0};
+  std::uniform_real_distribution<double> lng{-180.0, 180.0};
+  std::vector<GeoPoint> points;
+  for (size_t i = 0; i < numPoints; ++i) {
+    points.emplace_back(lat(randomEngine), lng(randomEngine));
+  }
+  return points;
+}
+
+// Return true iff the bits of the `point` are in one of the `ranges`.
+bool isInRanges(const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+                GeoPoint point) {
+  return std::ranges::any_of(ranges, [bits = point.toBits()](auto range) {
+    return bits >= range.first && bits < range.second;
+  });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(GeoPoint, coordinates) {
+  for (auto [lat, lng] : std::vector<std::pair<double, double>>{
+           {0, 0}, {-90, -180}, {90, 180}, {47.9957, 7.8529}, {-33.9, 151.2}}) {
+    GeoPoint point{lat, lng};
+    EXPECT_NEAR(point.getLat(), lat, maxError);
+    EXPECT_NEAR(point.getLng(), lng, maxError);
+    EXPECT_EQ(GeoPoint::fromBits(point.toBits()), point);
+    EXPECT_EQ(point.toBits() >> GeoPoint::numDataBits, 0u);
+  }
+  EXPECT_ANY_THROW(GeoPoint(90.1, 0));
+  EXPECT_ANY_THROW(GeoPoint(0, -180.1));
+
+  EXPECT_EQ(GeoPoint::interleave(0b11, 0b00), 0b1010u);
+  EXPECT_EQ(GeoPoint::interleave(0b00, 0b11), 0b0101u);
+  EXPECT_EQ(GeoPoint::compact(GeoPoint::spread(GeoPoint::maxQuantized)),
+            GeoPoint::maxQuantized);
+}
+
+// _____________________________________________________________________________
+TEST(GeoPoint, parseAndToString) {
+  auto point = GeoPoint::parseWktPoint("POINT(7.8529 47.9957)");
+  ASSERT_TRUE(point.has_value());
+  EXPECT_NEAR(point->getLat(), 47.9957, maxError);
+  EXPECT_NEAR(point->getLng(), 7.8529, maxError);
+  auto [string, type] = point->toStringAndType();
+  EXPECT_EQ(string, "POINT(7.8529 47.9957)");
+  EXPECT_STREQ(type, GEO_WKT_LITERAL);
+  EXPECT_EQ(GeoPoint::parseWktPoint("POINT(-3 0)")->toStringAndType().first,
+            "POINT(-3 0)");
+  EXPECT_EQ(GeoPoint::parseWktPoint("point(-73.985656 40.748433)")
+                ->toStringAndType()
+                .first,
+            "POINT(-73.985656 40.748433)");
+
+  EXPECT_FALSE(GeoPoint::parseWktPoint("POINT(200 10)").has_value());
+  EXPECT_FALSE(GeoPoint::parseWktPoint("POINT(10 -91)").has_value());
+  EXPECT_FALSE(GeoPoint::parseWktPoint("POINT(1)").has_value());
+  EXPECT_FALSE(GeoPoint::parseWktPoint("LINESTRING(1 2, 3 4)").has_value());
+}
+
+// _____________________________________________________________________________
+TEST(GeoPoint, valueId) {
+  GeoPoint point{48.0, 7.8};
+  ValueId id = ValueId::makeFromGeoPoint(point);
+  EXPECT_EQ(id.getDatatype(), Datatype::GeoPoint);
+  EXPECT_EQ(id.getGeoPoint(), point);
+  // The order of the `Id`s is the Z-order of the points.
+  GeoPoint southWest{-10.0, -10.0};
+  GeoPoint northEast{10.0, 10.0};
+  EXPECT_LT(southWest, northEast);
+  EXPECT_LT(ValueId::makeFromGeoPoint(southWest),
+            ValueId::makeFromGeoPoint(northEast));
+}
+
+// _____________________________________________________________________________
+TEST(GeoPoint, distance) {
+  // Eiffel Tower and the Freiburg Minster (see `GeoSparqlHelpersTest`).
+  GeoPoint eiffelTower{48.8585, 2.2945};
+  GeoPoint minster{47.9957, 7.8529};
+  EXPECT_NEAR(geoDistanceInKm(eiffelTower, minster), 422.415, 0.01);
+  EXPECT_EQ(geoDistanceInKm(eiffelTower, eiffelTower), 0.0);
+}
+
+// _____________________________________________________________________________
+TEST(GeoBoundingBox, aroundPoint) {
+  auto points = randomPoints(20'000);
+  for (GeoPoint center : randomPoints(50)) {
+    for (double km : {1.0, 100.0, 2'000.0}) {
+      auto box = GeoBoundingBox::aroundPoint(center, km);
+      EXPECT_TRUE(box.contains(center));
+      for (GeoPoint point : points) {
+        if (geoDistanceInKm(center, point) <= km) {
+          EXPECT_TRUE(box.contains(point));
+        }
+      }
+    }
+  }
+  // Close to the poles, the box contains all the longitudes.
+  auto box = GeoBoundingBox::aroundPoint(GeoPoint{89.9, 0.0}, 100.0);
+  EXPECT_EQ(box.minLng_, -180.0);
+  EXPECT_EQ(box.maxLng_, 180.0);
+  EXPECT_EQ(box.maxLat_, 90.0);
+
+  EXPECT_TRUE(GeoBoundingBox::aroundPoint(GeoPoint{0, 0}, -1.0).isEmpty());
+  EXPECT_TRUE(GeoBoundingBox::aroundPoint(GeoPoint{0, 0}, NAN).isEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(GeoBoundingBox, zOrderRanges) {
+  auto points = randomPoints(20'000);
+  std::vector<GeoBoundingBox> boxes{
+      {}, {47.0, 49.0, 7.0, 9.0}, {-90, 0, -180, 0}, {-5, 5, -170, 170},
+      {10.0, 10.0, 20.0, 20.0}};
+  for (const GeoBoundingBox& box : boxes) {
+    for (size_t maxNumRanges : {1u, 4u, 64u, 1'000u}) {
+      auto ranges = box.zOrderRanges(maxNumRanges);
+      ASSERT_FALSE(ranges.empty());
+      EXPECT_LE(ranges.size(), maxNumRanges);
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        EXPECT_LT(ranges[i].first, ranges[i].second);
+        if (i > 0) {
+          // The adjacent ranges are merged.
+          EXPECT_LT(ranges[i - 1].second, ranges[i].first);
+        }
+      }
+      for (GeoPoint point : points) {
+        if (box.contains(point)) {
+          EXPECT_TRUE(isInRanges(ranges, point));
+        }
+      }
+    }
+  }
+  // The whole map is a single range.
+  EXPECT_EQ(GeoBoundingBox{}.zOrderRanges(),
+            (std::vector<std::pair<uint64_t, uint64_t>>{
+                {0, uint64_t{1} << GeoPoint::numDataBits}}));
+
+  // A small box excludes most of the points.
+  GeoBoundingBox small{47.0, 49.0, 7.0, 9.0};
+  auto ranges = small.zOrderRanges();
+  size_t numInRanges = std::ranges::count_if(
+      points, [&](GeoPoint point) { return isInRanges(ranges, point); });
+  EXPECT_LT(numInRanges, points.size() / 100);
+
+  EXPECT_TRUE((GeoBoundingBox{1.0, 0.0, 0.0, 1.0}.zOrderRanges().empty()));
+}
@@ -44,6 +44,7 @@ TEST(GeoSparqlHelpers, ParseWktPoint) {
   testParseWktPointCorrect(" pOiNt\t(  7 \r -0.0 \n ) ", 7.0, 0.0);
   testParseWktPointCorrect("POINT(2.2945 48.8585)", 2.2945, 48.8585);
   testParseWktPointCorrect("POINT(7.8529 47.9957)", 7.8529, 47.9957);
+  testParseWktPointCorrect("POINT(7 10)", 7.0, 10.0);
 
   // Invalid WKT points because of issues unrelated to the number format (one of
   // the quotes missing, one of the parentheses missing, it must be exactly two
@@ -85,3 +86,15 @@ TEST(GeoSparqlHelpers, WktDist) {
   ASSERT_TRUE(std::isnan(wktDist("POINT", "POINT(2.0 -1.5)")));
   ASSERT_TRUE(std::isnan(wktDist("POINT", "POINT")));
 }
+
+TEST(GeoSparqlHelpers, GeoPointOverloads) {
+  GeoPoint eiffelTower{48.8585, 2.2945};
+  GeoPoint minster{47.9957, 7.8529};
+  ASSERT_NEAR(wktLatitude(eiffelTower), 48.8585, 1e-6);
+  ASSERT_NEAR(wktLongitude(eiffelTower), 2.2945, 1e-6);
+  ASSERT_NEAR(wktDist(eiffelTower, minster), 422.41514462162974, 1e-3);
+
+  ASSERT_TRUE(std::isnan(wktLatitude(std::optional<GeoPoint>{})));
+  ASSERT_TRUE(std::isnan(wktLongitude(std::optional<GeoPoint>{})));
+  ASSERT_TRUE(std::isnan(wktDist(std::optional<GeoPoint>{}, minster)));
+}
@@ -6,6 +6,9 @@
 
 #include <cstdio>
 
+#include "absl/cleanup/cleanup.h"
+#include "absl/strings/str_split.h"
+
 #include "./IndexTestHelpers.h"
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
@@ -16,6 +19,7 @@
 #include "engine/Sort.h"
 #include "engine/Values.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "gtest/gtest.h"
@@ -72,6 +76,7 @@ class GroupByTest : public ::testing::Test {
     std::remove("group_by_test.vocabulary");
     std::remove("group_by_test.text.index");
     std::remove("group_by_test.text.docsDB");
+    std::remove("group_by_test.text.docsDB.offsets");
     std::remove("group_by_test.index.pso");
     std::remove("group_by_test.index.pos");
     std::remove("group_by_test.nt");
@@ -1085,6 +1090,202 @@ TEST_F(GroupByOptimizations, computeGroupByForFullIndexScan) {
   // TODO<joka921> Add a test with only one column
 }
 
+// _____________________________________________________________________________
+TEST(GroupBy, computeGroupByForStarJoin) {
+  // `<s1>` has 6 values for each of `<p1>` and `<p2>`, so the join has 36
+  // rows for `<s1>`. `<s3>` has no `<p2>`.
+  std::string turtle;
+  for (size_t i = 1; i <= 6; ++i) {
+    absl::StrAppend(&turtle, "<s1> <p1> <a", i, "> . <s1> <p2> \"b", i,
+                    "\" . ");
+  }
+  turtle += "<s2> <p1> <a1> . <s2> <p2> \"b7\" . <s3> <p1> <a2> .";
+  auto qec = getQec(turtle);
+  Variable s{"?s"};
+  Variable a{"?a"};
+  Variable b{"?b"};
+  auto makeStarJoin = [&]() {
+    auto scan = [&](std::string predicate, const Variable& object) {
+      return ad_utility::makeExecutionTree<IndexScan>(
+          qec, Permutation::Enum::PSO,
+          SparqlTriple{s, std::move(predicate), object});
+    };
+    return ad_utility::makeExecutionTree<Join>(qec, scan("<p1>", a),
+                                               scan("<p2>", b), 0, 0);
+  };
+  using namespace sparqlExpression;
+  auto var = [](const Variable& v) -> SparqlExpression::Ptr {
+    return std::make_unique<VariableExpression>(v);
+  };
+  auto alias = [](SparqlExpression::Ptr expression, std::string target) {
+    return Alias{SparqlExpressionPimpl{std::move(expression), target},
+                 Variable{std::move(target)}};
+  };
+  auto makeAliases = [&]() {
+    std::vector<Alias> aliases;
+    aliases.push_back(
+        alias(std::make_unique<CountExpression>(false, var(a)), "?count"));
+    aliases.push_back(alias(std::make_unique<CountExpression>(true, var(a)),
+                            "?countDistinct"));
+    aliases.push_back(alias(
+        std::make_unique<GroupConcatExpression>(false, var(b), ","), "?bs"));
+    aliases.push_back(
+        alias(std::make_unique<MinExpression>(false, var(a)), "?min"));
+    return aliases;
+  };
+
+  // With the default minimal blow-up, the star join is too small for the
+  // optimization.
+  EXPECT_FALSE(GroupBy(qec, {s}, makeAliases(), makeStarJoin())
+                   .computeGroupByForStarJoin()
+                   .has_value());
+  auto previousMinBlowUp =
+      RuntimeParameters().get<"group-by-star-join-min-blow-up">();
+  auto cleanupMinBlowUp = absl::Cleanup{[previousMinBlowUp]() {
+    RuntimeParameters().set<"group-by-star-join-min-blow-up">(
+        previousMinBlowUp);
+  }};
+  RuntimeParameters().set<"group-by-star-join-min-blow-up">(0.0);
+
+  GroupBy groupBy{qec, {s}, makeAliases(), makeStarJoin()};
+  auto result = groupBy.computeGroupByForStarJoin();
+  ASSERT_TRUE(result.has_value());
+  const auto& table = result->idTable();
+  auto getId = makeGetId(qec->getIndex());
+  ASSERT_EQ(table.size(), 2u);
+  ASSERT_EQ(table.numColumns(), 5u);
+  EXPECT_EQ(table(0, 0), getId("<s1>"));
+  EXPECT_EQ(table(0, 1), I(36));
+  EXPECT_EQ(table(0, 2), I(6));
+  EXPECT_EQ(table(0, 4), getId("<a1>"));
+  EXPECT_EQ(table(1, 0), getId("<s2>"));
+  EXPECT_EQ(table(1, 1), I(1));
+  EXPECT_EQ(table(1, 2), I(1));
+  EXPECT_EQ(table(1, 4), getId("<a1>"));
+  // Each value of `?b` is contained once for each value of `?a`.
+  // Short results are inlined into the `Id` as a `ShortString`.
+  auto getWord = [&result](Id id) -> std::string {
+    if (id.getDatatype() == Datatype::ShortString) {
+      return id.getShortString().getContent();
+    }
+    return result->localVocab().getWord(id.getLocalVocabIndex());
+  };
+  std::string groupConcat = getWord(table(0, 3));
+  EXPECT_EQ(std::ranges::count(groupConcat, ','), 35);
+  EXPECT_EQ(std::vector<std::string>(absl::StrSplit(groupConcat, "b3")).size(),
+            7u)
+      << groupConcat;
+  EXPECT_EQ(getWord(table(1, 3)), "b7");
+
+  // The same result without the factorized star join.
+  {
+    auto previous =
+        RuntimeParameters().get<"use-group-by-factorized-star-join">();
+    auto cleanup = absl::Cleanup{[previous]() {
+      RuntimeParameters().set<"use-group-by-factorized-star-join">(previous);
+    }};
+    RuntimeParameters().set<"use-group-by-factorized-star-join">(false);
+    GroupBy flattened{qec, {s}, makeAliases(), makeStarJoin()};
+    ASSERT_FALSE(flattened.computeGroupByForStarJoin().has_value());
+    auto expected = flattened.getResult();
+    for (size_t col : {0, 1, 2, 4}) {
+      EXPECT_THAT(table.getColumn(col),
+                  ::testing::ElementsAreArray(
+                      expected->idTable().getColumn(col)));
+    }
+  }
+
+  // The optimization is not applied if an aggregate reads variables from
+  // different inputs or is not supported.
+  auto testNotApplied = [&](SparqlExpression::Ptr expression) {
+    std::vector<Alias> aliases;
+    aliases.push_back(alias(std::move(expression), "?x"));
+    GroupBy groupBy{qec, {s}, std::move(aliases), makeStarJoin()};
+    EXPECT_FALSE(groupBy.computeGroupByForStarJoin().has_value());
+  };
+  testNotApplied(std::make_unique<CountExpression>(
+      false, makeAddExpression(var(a), var(b))));
+  testNotApplied(std::make_unique<SumExpression>(false, var(a)));
+  testNotApplied(makeAddExpression(
+      std::make_unique<CountExpression>(false, var(a)), var(s)));
+}
+
+// _____________________________________________________________________________
+TEST(GroupBy, computeGroupByFromIndexSummaries) {
+  // With blocks of two triples, `<p>` is a large relation with several blocks,
+  // and its objects are mostly numbers.
+  std::string turtle;
+  for (int i = -3; i <= 8; ++i) {
+    absl::StrAppend(&turtle, "<s", i, "> <p> ", i, " . <s", i, "> <p> ",
+                    i * 2, ".5 . ");
+  }
+  turtle += "<t> <p> 4 . <t> <q> <x> . <u> <q> 7 .";
+  auto qec = getQec(turtle);
+  auto plan = [&qec](const std::string& query) {
+    QueryPlanner qp{qec};
+    auto pq = SparqlParser::parseQuery(query);
+    return qp.createExecutionTree(pq);
+  };
+  // Check whether the aggregate over the `triples` can be computed from the
+  // summaries, and that the result is the same as without the optimization.
+  auto check = [&](std::string_view aggregate, std::string_view triples,
+                   bool isApplied,
+                   ad_utility::source_location l =
+                       ad_utility::source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    auto query =
+        absl::StrCat("SELECT (", aggregate, " AS ?a) WHERE { ", triples, " }");
+    auto tree = plan(query);
+    auto* groupBy = dynamic_cast<GroupBy*>(tree.getRootOperation().get());
+    ASSERT_NE(groupBy, nullptr);
+    IdTable table{qec->getAllocator()};
+    ASSERT_EQ(groupBy->computeGroupByFromIndexSummaries(&table), isApplied);
+
+    qec->getQueryTreeCache().clearAll();
+    auto previous = RuntimeParameters().get<"use-index-aggregate-summaries">();
+    auto cleanup = absl::Cleanup{[previous]() {
+      RuntimeParameters().set<"use-index-aggregate-summaries">(previous);
+    }};
+    RuntimeParameters().set<"use-index-aggregate-summaries">(false);
+    auto expected = plan(query).getResult();
+    if (isApplied) {
+      EXPECT_EQ(table, expected->idTable());
+    }
+  };
+  check("COUNT(?x)", "?s <p> ?x FILTER (?x > 2)", true);
+  check("COUNT(?x)", "?s <p> ?x FILTER (?x >= 0) FILTER (?x < 5.5)", true);
+  check("COUNT(DISTINCT ?x)", "?s <p> ?x", true);
+  check("COUNT(DISTINCT ?x)", "?s <p> ?x FILTER (4 > ?x)", true);
+  check("COUNT(DISTINCT ?s)", "?s <p> ?x", true);
+  check("MIN(?x)", "?s <p> ?x", true);
+  check("MAX(?x)", "?s <p> ?x FILTER (?x != 17.5)", true);
+  check("MIN(?x)", "?s <p> ?x FILTER (?x > 1.2) FILTER (?x <= 6)", true);
+  check("COUNT(?s)", "?s <p> 4", true);
+  check("MAX(?x)", "<s2> <p> ?x", true);
+  check("COUNT(?x)", "?s <p> ?x FILTER (?x > 100)", true);
+  check("MIN(?x)", "?s <q> ?x FILTER (?x > 0)", true);
+
+  // Not applied: MIN or MAX of values that are not all numbers, FILTERs on
+  // other variables or with non-numeric constants, and other aggregates.
+  check("MIN(?x)", "?s <q> ?x", false);
+  check("MIN(?s)", "?s <p> ?x", false);
+  check("COUNT(?x)", "?s <p> ?x FILTER (?s != <t>)", false);
+  check("COUNT(?x)", "?s <q> ?x FILTER (?x != <x>)", false);
+  check("SUM(?x)", "?s <p> ?x", false);
+  check("COUNT(?x)", "?s ?p ?x FILTER (?x > 2)", false);
+
+  // The optimization can be disabled.
+  auto previous = RuntimeParameters().get<"use-index-aggregate-summaries">();
+  auto cleanup = absl::Cleanup{[previous]() {
+    RuntimeParameters().set<"use-index-aggregate-summaries">(previous);
+  }};
+  RuntimeParameters().set<"use-index-aggregate-summaries">(false);
+  auto tree = plan("SELECT (COUNT(?x) AS ?a) WHERE { ?s <p> ?x }");
+  IdTable table{qec->getAllocator()};
+  EXPECT_FALSE(dynamic_cast<GroupBy*>(tree.getRootOperation().get())
+                   ->computeGroupByFromIndexSummaries(&table));
+}
+
 namespace {
 // A helper function to set up expression trees in the following test.
 template <typename ExprT>
@@ -1250,3 +1451,23 @@ TEST(GroupBy, AddedHavingRows) {
   auto expected = makeIdTableFromVector({{i(0), i(3), Id::makeFromBool(true)}});
   EXPECT_EQ(table, expected);
 }
+
+// _____________________________________________________________________________
+TEST(GroupBy, computedAndInlinedShortLiteralsAreOneGroup) {
+  // The literal "ab" from the VALUES clause and the one computed by the BIND
+  // are both inlined as a `ShortString` and therefore form a single group.
+  auto query =
+      "SELECT ?y (COUNT(*) AS ?count) WHERE {"
+      " { VALUES ?y { \"ab\" } } UNION"
+      " { VALUES ?x { <ab> } BIND(STR(?x) AS ?y) } UNION"
+      " { BIND(CONCAT(\"a\", \"b\") AS ?y) } } GROUP BY ?y";
+  auto* qec = ad_utility::testing::getQec();
+  qec->clearCacheUnpinnedOnly();
+  QueryPlanner qp{qec};
+  auto pq = SparqlParser::parseQuery(query);
+  auto tree = qp.createExecutionTree(pq);
+  auto res = tree.getResult();
+  auto ab = Id::makeFromShortString(ShortString::fromContent("ab").value());
+  auto expected = makeIdTableFromVector({{ab, I(3)}});
+  EXPECT_EQ(res->idTable(), expected);
+}
@@ -33,6 +33,13 @@ TEST(HttpServer, HttpTest) {
           default:
             methodName = "OTHER";
         }
+        // Requests to `/slow` are answered only after a while.
+        if (toStd(request.target()) == "/slow") {
+          boost::asio::steady_timer timer{
+              co_await boost::asio::this_coro::executor,
+              std::chrono::milliseconds{500}};
+          co_await timer.async_wait(boost::asio::use_awaitable);
+        }
         std::string response = absl::StrCat(
             methodName, "\n", toStd(request.target()), "\n", request.body());
         co_return co_await send(createOkResponse(
@@ -105,6 +112,33 @@ TEST(HttpServer, HttpTest) {
               "POST\n/target\nbody");
   }
 
+  // Test the streaming version, with and without reaching the deadline.
+  {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{30};
+    Url url{absl::StrCat("http://localhost:", httpServer.getPort(), "/target")};
+    std::string result;
+    for (const std::string& chunk : sendHttpOrHttpsRequestStreaming(
+             url, verb::post, "body", "text/plain", "text/plain", deadline)) {
+      result.append(chunk);
+    }
+    ASSERT_EQ(result, "POST\n/target\nbody");
+
+    Url slowUrl{
+        absl::StrCat("http://localhost:", httpServer.getPort(), "/slow")};
+    auto consume = [&slowUrl](auto deadline) {
+      std::string result;
+      for (const std::string& chunk : sendHttpOrHttpsRequestStreaming(
+               slowUrl, verb::get, "", "text/plain", "text/plain", deadline)) {
+        result.append(chunk);
+      }
+      return result;
+    };
+    ASSERT_ANY_THROW(consume(std::chrono::steady_clock::now() +
+                             std::chrono::milliseconds{50}));
+    ASSERT_EQ(consume(deadline), "GET\n/slow\n");
+  }
+
   // Check that after shutting down, no more new connections are accepted.
   httpServer.shutDown();
   ASSERT_ANY_THROW(
@@ -17,15 +17,19 @@
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
 #include "./util/JoinHelpers.h"
+#include "absl/cleanup/cleanup.h"
+#include "absl/strings/str_cat.h"
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/OptionalJoin.h"
+#include "engine/QueryPlanner.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/Values.h"
 #include "engine/ValuesForTesting.h"
 #include "engine/idTable/IdTable.h"
+#include "parser/SparqlParser.h"
 #include "util/Forward.h"
 #include "util/Random.h"
 #include "util/SourceLocation.h"
@@ -435,6 +439,98 @@ TEST(JoinTest, joinTwoScans) {
   test(1'000'000);
 }
 
+// The smaller side of a join restricts the index scans of the other side to
+// the values of its join column (sideways information passing).
+TEST(JoinTest, joinWithSemiJoinFilter) {
+  auto previousMaxSize = RuntimeParameters().get<"semi-join-filter-max-size">();
+  auto cleanup = absl::Cleanup{[previousMaxSize]() {
+    RuntimeParameters().set<"semi-join-filter-max-size">(previousMaxSize);
+  }};
+  auto test = [](size_t maxFilterSize) {
+    auto qec = ad_utility::testing::getQec(
+        "<x> <p> 1. <x2> <p> 2. <x3> <p> 8. <x> <p2> 3 . <x2> <p2> 4. "
+        "<x3> <p2> 7. ");
+    // Results are only materialized eagerly if they are small, which all of
+    // them are in this test.
+    RuntimeParameters().set<"lazy-index-scan-max-size-materialization">(0);
+    RuntimeParameters().set<"semi-join-filter-max-size">(maxFilterSize);
+    qec->getQueryTreeCache().clearAll();
+    auto scanP = ad_utility::makeExecutionTree<IndexScan>(
+        qec, PSO, SparqlTriple{Var{"?s"}, "<p>", Var{"?o"}});
+    auto scanP2 = ad_utility::makeExecutionTree<IndexScan>(
+        qec, PSO, SparqlTriple{Var{"?s"}, "<p2>", Var{"?q"}});
+    auto scanKey = scanP->getCacheKey();
+    auto twoScans =
+        ad_utility::makeExecutionTree<Join>(qec, scanP2, scanP, 0, 0);
+    auto valuesTree = makeValuesForSingleVariable(qec, "?s", {"<x3>"});
+    auto join = Join{qec, valuesTree, twoScans, 0, 0};
+
+    auto id = ad_utility::testing::makeGetId(qec->getIndex());
+    auto expected = makeIdTableFromVector({{id("<x3>"), I(7), I(8)}});
+    VariableToColumnMap expectedVariables{
+        {Variable{"?s"}, makeAlwaysDefinedColumn(0)},
+        {Variable{"?q"}, makeAlwaysDefinedColumn(1)},
+        {Variable{"?o"}, makeAlwaysDefinedColumn(2)}};
+    testJoinOperation(join, makeExpectedColumns(expectedVariables, expected));
+    if (maxFilterSize > 0) {
+      EXPECT_EQ(join.runtimeInfo().details_["semi-join-filter-size"], 1);
+      EXPECT_THAT(scanP->getCacheKey(),
+                  ::testing::HasSubstr(absl::StrCat(
+                      "SEMI-JOIN FILTER of size 1: ", id("<x3>").getBits())));
+    } else {
+      EXPECT_EQ(scanP->getCacheKey(), scanKey);
+    }
+  };
+  test(1'000'000);
+  test(0);
+}
+
+// The result of a subtree that is restricted by a semi-join filter is smaller
+// than the estimate of the query planner, but this must not trigger the
+// planning of the query again.
+TEST(JoinTest, semiJoinFilterWithReplanning) {
+  std::string turtle;
+  for (size_t i = 0; i < 6; ++i) {
+    absl::StrAppend(&turtle, "<x", i, "> <p> ", i, " . <x", i, "> <p2> ",
+                    i + 10, " . ");
+  }
+  auto qec = ad_utility::testing::getQec(turtle);
+  auto previousFactor =
+      RuntimeParameters().get<"replanning-min-deviation-factor">();
+  auto previousMaterialization =
+      RuntimeParameters().get<"lazy-index-scan-max-size-materialization">();
+  RuntimeParameters().set<"replanning-min-deviation-factor">(2.0);
+  RuntimeParameters().set<"lazy-index-scan-max-size-materialization">(0);
+  qec->_replanOnSizeDeviation = true;
+  auto cleanup = absl::Cleanup{[&]() {
+    RuntimeParameters().set<"replanning-min-deviation-factor">(previousFactor);
+    RuntimeParameters().set<"lazy-index-scan-max-size-materialization">(
+        previousMaterialization);
+    qec->_replanOnSizeDeviation = false;
+  }};
+  qec->getQueryTreeCache().clearAll();
+  auto scanP = ad_utility::makeExecutionTree<IndexScan>(
+      qec, PSO, SparqlTriple{Var{"?s"}, "<p>", Var{"?o"}});
+  auto scanP2 = ad_utility::makeExecutionTree<IndexScan>(
+      qec, PSO, SparqlTriple{Var{"?s"}, "<p2>", Var{"?q"}});
+  auto twoScans = ad_utility::makeExecutionTree<Join>(qec, scanP2, scanP, 0, 0);
+  // The estimate of the query planner is for the complete join of the scans.
+  EXPECT_GE(twoScans->getSizeEstimate(), 2u);
+  auto valuesTree = makeValuesForSingleVariable(qec, "?s", {"<x3>"});
+  auto join = Join{qec, valuesTree, twoScans, 0, 0};
+
+  auto id = ad_utility::testing::makeGetId(qec->getIndex());
+  auto expected = makeIdTableFromVector({{id("<x3>"), I(13), I(3)}});
+  VariableToColumnMap expectedVariables{
+      {Variable{"?s"}, makeAlwaysDefinedColumn(0)},
+      {Variable{"?q"}, makeAlwaysDefinedColumn(1)},
+      {Variable{"?o"}, makeAlwaysDefinedColumn(2)}};
+  testJoinOperation(join, makeExpectedColumns(expectedVariables, expected));
+  EXPECT_EQ(join.runtimeInfo().details_["semi-join-filter-size"], 1);
+  EXPECT_TRUE(twoScans->getRootOperation()->wasRestrictedAfterPlanning());
+  EXPECT_TRUE(scanP->getRootOperation()->wasRestrictedAfterPlanning());
+}
+
 TEST(JoinTest, invalidJoinVariable) {
   auto qec = ad_utility::testing::getQec(
       "<x> <p> 1. <x2> <p> 2. <x> <p2> 3 . <x2> <p2> 4. <x3> <p2> 7. ");
@@ -443,3 +539,30 @@ TEST(JoinTest, invalidJoinVariable) {
 
   ASSERT_ANY_THROW(Join(qec, valuesTree2, valuesTree, 0, 0));
 }
+
+// A short literal that is computed by a BIND has the same `Id` as the same
+// literal from a VALUES clause (both are inlined as a `ShortString`), so the
+// two can be joined.
+TEST(JoinTest, joinComputedAndInlinedShortLiterals) {
+  auto* qec = ad_utility::testing::getQec();
+  auto test = [qec](const std::string& bindClause, const std::string& iri) {
+    qec->clearCacheUnpinnedOnly();
+    auto query = absl::StrCat(
+        "SELECT ?x WHERE { VALUES (?x ?o) { (<a> \"ab\") (<b> \"cde\") } "
+        "{ VALUES ?z { <ab> } ",
+        bindClause, " } }");
+    QueryPlanner qp{qec};
+    auto pq = SparqlParser::parseQuery(query);
+    auto tree = qp.createExecutionTree(pq);
+    auto result = tree.getResult();
+    const auto& table = result->idTable();
+    ASSERT_EQ(table.size(), 1u) << query;
+    auto expected = result->localVocab().getIndexOrNullopt(iri);
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_EQ(table(0, tree.getVariableColumn(Var{"?x"})),
+              Id::makeFromLocalVocabIndex(expected.value()));
+  };
+  test("BIND(STR(?z) AS ?o)", "<a>");
+  test("BIND(\"cde\" AS ?o)", "<b>");
+  test("BIND(CONCAT(\"c\", \"de\") AS ?o)", "<b>");
+}
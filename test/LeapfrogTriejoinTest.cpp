@@ -0,0 +1,159 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <set>
+
+#include "util/JoinAlgorithms/LeapfrogTriejoin.h"
+
+using namespace ad_utility;
+namespace {
+
+using Row = std::array<size_t, 2>;
+using Result = std::vector<std::vector<size_t>>;
+
+// A `TrieIterator` with two levels for a sorted vector of pairs.
+class PairTrieIterator {
+  const std::vector<Row>* rows_;
+  // -1 is above the root.
+  int level_ = -1;
+  // The current row and the end of the rows that have the current key on the
+  // first level (only valid on the second level).
+  size_t row_ = 0;
+  size_t end_ = 0;
+
+ public:
+  explicit PairTrieIterator(const std::vector<Row>& rows) : rows_{&rows} {}
+
+  void open() {
+    ++level_;
+    if (level_ == 0) {
+      row_ = 0;
+    } else {
+      end_ = firstRowAfter(row_, (*rows_)[row_][0]);
+    }
+  }
+
+  void up() {
+    if (level_ == 1) {
+      // Go back to the first row with the current key of the first level.
+      row_ = std::ranges::lower_bound(*rows_, (*rows_)[end_ - 1][0], {},
+                                      [](const Row& r) { return r[0]; }) -
+             rows_->begin();
+    }
+    --level_;
+  }
+
+  void next() {
+    row_ = level_ == 0 ? firstRowAfter(row_, key()) : row_ + 1;
+  }
+
+  void seek(size_t key) {
+    while (!atEnd() && this->key() < key) {
+      next();
+    }
+  }
+
+  bool atEnd() const {
+    return level_ == 0 ? row_ == rows_->size() : row_ == end_;
+  }
+
+  size_t key() const { return (*rows_)[row_][level_]; }
+
+ private:
+  size_t firstRowAfter(size_t row, size_t key) const {
+    while (row < rows_->size() && (*rows_)[row][0] == key) {
+      ++row;
+    }
+    return row;
+  }
+};
+static_assert(TrieIterator<PairTrieIterator>);
+
+// Compute the Leapfrog Triejoin of the `relations`, where
+// `variablesOfRelation[i]` are the indices of the first and the second
+// variable of the `i`-th relation.
+Result leapfrog(const std::vector<std::vector<Row>>& relations,
+                const std::vector<Row>& variablesOfRelation,
+                size_t numVariables) {
+  std::vector<PairTrieIterator> iterators;
+  std::vector<std::vector<size_t>> iteratorsPerLevel(numVariables);
+  for (size_t i = 0; i < relations.size(); ++i) {
+    iterators.emplace_back(relations[i]);
+    for (size_t variable : variablesOfRelation[i]) {
+      iteratorsPerLevel[variable].push_back(i);
+    }
+  }
+  Result result;
+  leapfrogTriejoin(std::span{iterators}, iteratorsPerLevel,
+                   [&result](std::span<const size_t> keys) {
+                     result.emplace_back(keys.begin(), keys.end());
+                   });
+  return result;
+}
+
+// Create a random sorted relation without duplicates.
+std::vector<Row> randomRelation(std::mt19937_64& gen, size_t numRows,
+                                size_t numValues) {
+  std::uniform_int_distribution<size_t> dist(0, numValues - 1);
+  std::set<Row> rows;
+  for (size_t i = 0; i < numRows; ++i) {
+    rows.insert(Row{dist(gen), dist(gen)});
+  }
+  return {rows.begin(), rows.end()};
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, singleRelation) {
+  std::vector<Row> r{{1, 2}, {1, 4}, {3, 1}};
+  EXPECT_EQ(leapfrog({r}, {{0, 1}}, 2), (Result{{1, 2}, {1, 4}, {3, 1}}));
+  EXPECT_EQ(leapfrog({{}}, {{0, 1}}, 2), Result{});
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, intersectionAndEmptyInputs) {
+  // The intersection of two relations with the same variables.
+  std::vector<Row> a{{0, 1}, {1, 2}, {1, 3}, {4, 0}, {5, 5}};
+  std::vector<Row> b{{1, 1}, {1, 3}, {4, 0}, {4, 2}, {6, 5}};
+  EXPECT_EQ(leapfrog({a, b}, {{0, 1}, {0, 1}}, 2),
+            (Result{{1, 3}, {4, 0}}));
+  EXPECT_EQ(leapfrog({a, {}}, {{0, 1}, {0, 1}}, 2), Result{});
+
+  // A join on the first variable only.
+  std::vector<Row> c{{1, 7}, {5, 8}};
+  EXPECT_EQ(leapfrog({a, c}, {{0, 1}, {0, 2}}, 3),
+            (Result{{1, 2, 7}, {1, 3, 7}, {5, 5, 8}}));
+
+  // No variables at all.
+  EXPECT_EQ(leapfrog({}, {}, 0), Result{});
+  // Each variable must be contained in some relation.
+  EXPECT_ANY_THROW(leapfrog({a}, {{0, 1}}, 3));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, triangles) {
+  std::mt19937_64 gen{42};
+  for (size_t numValues : {2, 5, 20}) {
+    auto r = randomRelation(gen, 50, numValues);
+    auto s = randomRelation(gen, 50, numValues);
+    auto t = randomRelation(gen, 50, numValues);
+    // The triangles R(x, y), S(y, z), T(x, z) computed by brute force.
+    Result expected;
+    for (const auto& [x, y] : r) {
+      for (const auto& [y2, z] : s) {
+        if (y == y2 && std::ranges::binary_search(t, Row{x, z})) {
+          expected.push_back({x, y, z});
+        }
+      }
+    }
+    std::ranges::sort(expected);
+    // The results are sorted lexicographically.
+    EXPECT_EQ(leapfrog({r, s, t}, {{0, 1}, {1, 2}, {0, 2}}, 3), expected);
+  }
+}
@@ -2,6 +2,8 @@
 //  Chair of Algorithms and Data Structures.
 //  Author: Hannah Bast <bast@cs.uni-freiburg.de>
 
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
 #include <gtest/gtest.h>
 
 #include <sstream>
@@ -12,6 +14,7 @@
 #include "engine/Bind.h"
 #include "engine/CountAvailablePredicates.h"
 #include "engine/Distinct.h"
+#include "engine/ExportQueryExecutionTrees.h"
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
@@ -21,6 +24,7 @@
 #include "engine/OptionalJoin.h"
 #include "engine/OrderBy.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanner.h"
 #include "engine/ResultTable.h"
 #include "engine/Sort.h"
 #include "engine/TextOperationWithFilter.h"
@@ -31,6 +35,7 @@
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "global/Id.h"
+#include "parser/SparqlParser.h"
 
 namespace {
 // Get test collection of words of a given size. The words are all distinct.
@@ -319,3 +324,70 @@ TEST(LocalVocab, propagation) {
                                    Variable{"?text"});
   checkLocalVocab(text2, {});
 }
+
+// _____________________________________________________________________________
+TEST(LocalVocab, bindAndFilterOnMultipleChunks) {
+  // Make BIND and FILTER split their input into several chunks that are
+  // evaluated concurrently.
+  auto previousNumThreads =
+      RuntimeParameters().get<"parallel-expression-num-threads">();
+  auto previousMinInputSize =
+      RuntimeParameters().get<"parallel-expression-min-input-size">();
+  auto cleanup =
+      absl::Cleanup{[previousNumThreads, previousMinInputSize]() {
+        RuntimeParameters().set<"parallel-expression-num-threads">(
+            previousNumThreads);
+        RuntimeParameters().set<"parallel-expression-min-input-size">(
+            previousMinInputSize);
+      }};
+  RuntimeParameters().set<"parallel-expression-num-threads">(4);
+  RuntimeParameters().set<"parallel-expression-min-input-size">(10);
+
+  // The literals of the VALUES clause are not contained in the index, so they
+  // are part of the local vocabulary of the input of the BIND. The BIND adds
+  // the same three new words in each of the chunks. All the words are too long
+  // to be inlined as a `ShortString`.
+  const size_t numRows = 50;
+  const std::string letters = "abc";
+  std::string values;
+  for (size_t i = 0; i < numRows; ++i) {
+    absl::StrAppend(&values, " \"", letters.substr(i % 3, 1), "-value-", i,
+                    "\"");
+  }
+  auto query = absl::StrCat(
+      "SELECT ?x ?y WHERE { VALUES ?x {", values,
+      " } BIND(CONCAT(SUBSTR(?x, 1, 1), \"-new-value\") AS ?y) "
+      "FILTER(!STRSTARTS(?y, \"b\")) }");
+  auto* qec = ad_utility::testing::getQec();
+  qec->clearCacheUnpinnedOnly();
+  QueryPlanner qp{qec};
+  auto pq = SparqlParser::parseQuery(query);
+  auto tree = qp.createExecutionTree(pq);
+  auto result = tree.getResult();
+
+  const auto& localVocab = result->localVocab();
+  EXPECT_EQ(localVocab.size(), numRows + 3);
+  auto toString = [&](Id id) {
+    auto stringAndType = ExportQueryExecutionTrees::idToStringAndType<true>(
+        qec->getIndex(), id, localVocab);
+    return stringAndType.has_value() ? stringAndType.value().first : "UNDEF";
+  };
+  // The rows are kept in the order of the input.
+  const auto& table = result->idTable();
+  size_t colX = tree.getVariableColumn(Variable{"?x"});
+  size_t colY = tree.getVariableColumn(Variable{"?y"});
+  std::vector<std::string> expected;
+  std::vector<std::string> actual;
+  for (size_t i = 0; i < numRows; ++i) {
+    if (i % 3 != 1) {
+      auto letter = letters.substr(i % 3, 1);
+      expected.push_back(
+          absl::StrCat(letter, "-value-", i, " ", letter, "-new-value"));
+    }
+  }
+  for (size_t i = 0; i < table.size(); ++i) {
+    actual.push_back(
+        absl::StrCat(toString(table(i, colX)), " ", toString(table(i, colY))));
+  }
+  EXPECT_EQ(actual, expected);
+}
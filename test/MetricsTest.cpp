@@ -0,0 +1,97 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/Metrics.h"
+
+using namespace ad_utility::metrics;
+
+// _____________________________________________________________________________
+TEST(Metrics, Counter) {
+  Counter counter;
+  EXPECT_EQ(counter.get(), 0u);
+  counter.increment();
+  counter.increment(41);
+  EXPECT_EQ(counter.get(), 42u);
+
+  std::vector<std::jthread> threads;
+  for (size_t i = 0; i < 4; ++i) {
+    threads.emplace_back([&counter]() {
+      for (size_t j = 0; j < 1000; ++j) {
+        counter.increment();
+      }
+    });
+  }
+  threads.clear();
+  EXPECT_EQ(counter.get(), 4042u);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, HistogramBuckets) {
+  // The buckets are [0], [1], [2], [3], [4, 5], [6, 7], [8, 11], ...
+  std::vector<uint64_t> upperBounds{0, 1, 2, 3, 5, 7, 11, 15, 23, 31, 47};
+  for (size_t i = 0; i < upperBounds.size(); ++i) {
+    EXPECT_EQ(Histogram::getBucketUpperBound(i), upperBounds[i]);
+    EXPECT_EQ(Histogram::getBucketIndex(upperBounds[i]), i);
+    EXPECT_EQ(Histogram::getBucketIndex(upperBounds[i] + 1), i + 1);
+  }
+  // The relative width of each bucket is at most `1 / numSubBuckets`.
+  for (uint64_t value : {uint64_t{1000}, uint64_t{123'456'789},
+                         uint64_t{1} << 62, ~uint64_t{0}}) {
+    auto index = Histogram::getBucketIndex(value);
+    auto upper = Histogram::getBucketUpperBound(index);
+    auto lower = Histogram::getBucketUpperBound(index - 1) + 1;
+    EXPECT_LE(lower, value);
+    EXPECT_GE(upper, value);
+    EXPECT_LE(static_cast<double>(upper - lower),
+              static_cast<double>(lower) / Histogram::numSubBuckets);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, HistogramRecord) {
+  Histogram histogram{10};
+  // The buckets up to [8, 11] and one for the larger values.
+  EXPECT_EQ(histogram.numBuckets(), 8u);
+  for (uint64_t value : {0, 1, 1, 5, 9, 12, 1000}) {
+    histogram.record(value);
+  }
+  std::vector<uint64_t> counts;
+  for (size_t i = 0; i < histogram.numBuckets(); ++i) {
+    counts.push_back(histogram.getBucketCount(i));
+  }
+  EXPECT_THAT(counts, ::testing::ElementsAre(1, 2, 0, 0, 1, 0, 1, 2));
+  EXPECT_EQ(histogram.getSum(), 1028u);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, PrometheusWriter) {
+  PrometheusWriter writer;
+  writer.addMetric("requests_total", "The number of requests.", "counter");
+  writer.addSample("requests_total", {{"code", "200"}, {"path", "/a\"b"}}, 3);
+  writer.addSample("requests_total", {}, 4);
+  Histogram histogram{2};
+  histogram.record(1);
+  histogram.record(2);
+  histogram.record(100);
+  writer.addMetric("duration_seconds", "The duration.", "histogram");
+  writer.addHistogram("duration_seconds", {{"phase", "parse"}}, histogram,
+                      0.5);
+  EXPECT_EQ(std::move(writer).get(),
+            "# HELP requests_total The number of requests.\n"
+            "# TYPE requests_total counter\n"
+            "requests_total{code=\"200\",path=\"/a\\\"b\"} 3\n"
+            "requests_total 4\n"
+            "# HELP duration_seconds The duration.\n"
+            "# TYPE duration_seconds histogram\n"
+            "duration_seconds_bucket{phase=\"parse\",le=\"0\"} 0\n"
+            "duration_seconds_bucket{phase=\"parse\",le=\"0.5\"} 1\n"
+            "duration_seconds_bucket{phase=\"parse\",le=\"1\"} 2\n"
+            "duration_seconds_bucket{phase=\"parse\",le=\"+Inf\"} 3\n"
+            "duration_seconds_sum{phase=\"parse\"} 51.5\n"
+            "duration_seconds_count{phase=\"parse\"} 3\n");
+}
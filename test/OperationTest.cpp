@@ -6,7 +6,9 @@
 #include <gtest/gtest.h>
 
 #include "IndexTestHelpers.h"
+#include "engine/Distinct.h"
 #include "engine/NeutralElementOperation.h"
+#include "engine/Sort.h"
 #include "engine/ValuesForTesting.h"
 #include "util/IdTableHelpers.h"
 #include "util/OperationTestHelpers.h"
@@ -212,3 +214,96 @@ TEST(OperationTest, estimatesForCachedResults) {
     EXPECT_EQ(qet->getCostEstimate(), 0u);
   }
 }
+
+// _____________________________________________________________________________
+TEST(OperationTest, observedSizesAndReplanning) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  // An operation with a size estimate that is far off.
+  auto makeQet = [&qec]() {
+    auto idTable = makeIdTableFromVector({{1, 2}, {3, 4}, {5, 6}});
+    auto qet = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(idTable),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    auto& op = dynamic_cast<ValuesForTesting&>(*qet->getRootOperation());
+    op.sizeEstimate() = 1000;
+    return qet;
+  };
+  {
+    auto qet = makeQet();
+    EXPECT_EQ(qet->getSizeEstimate(), 1000u);
+    [[maybe_unused]] auto res = qet->getResult();
+  }
+  // The result is not cached anymore, but its size was observed.
+  qec->clearCacheUnpinnedOnly();
+  EXPECT_EQ(qec->getQueryTreeCache().numObservedSizes(), 1u);
+  EXPECT_EQ(makeQet()->getSizeEstimate(), 3u);
+  {
+    auto previous = RuntimeParameters().get<"use-observed-sizes">();
+    absl::Cleanup cleanup{[previous] {
+      RuntimeParameters().set<"use-observed-sizes">(previous);
+    }};
+    RuntimeParameters().set<"use-observed-sizes">(false);
+    EXPECT_EQ(makeQet()->getSizeEstimate(), 1000u);
+  }
+
+  // Clearing the cache completely also clears the observed sizes.
+  qec->getQueryTreeCache().clearAll();
+  EXPECT_EQ(qec->getQueryTreeCache().numObservedSizes(), 0u);
+  auto qet = makeQet();
+  EXPECT_EQ(qet->getSizeEstimate(), 1000u);
+  qec->_replanOnSizeDeviation = true;
+  absl::Cleanup cleanup{[&qec] { qec->_replanOnSizeDeviation = false; }};
+  EXPECT_THROW(qet->getResult(), ResultSizeDeviatesFromEstimateException);
+  // The result was computed and cached nevertheless, so a new plan can use
+  // it.
+  EXPECT_EQ(makeQet()->getSizeEstimate(), 3u);
+  EXPECT_EQ(makeQet()->getCostEstimate(), 0u);
+  // The result of the complete query is never planned again.
+  qet->isRoot() = true;
+  EXPECT_NO_THROW(qet->getResult());
+}
+
+// _____________________________________________________________________________
+TEST(OperationTest, resourceUsageOfComputedAndCachedResults) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto makeSort = [&qec]() {
+    auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{3, 4}, {1, 2}, {3, 4}}),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    return ad_utility::makeExecutionTree<Sort>(qec, std::move(values),
+                                               std::vector<ColumnIndex>{0, 1});
+  };
+  auto sort = makeSort();
+  [[maybe_unused]] auto sortResult = sort->getResult();
+  const auto& sortInfo = sort->getRootOperation()->runtimeInfo();
+  // Both operations allocate their result.
+  auto sortUsage = sortInfo.getResourceUsage();
+  auto valuesUsage = sortInfo.children_.at(0)->getResourceUsage();
+  EXPECT_GT(sortUsage.totalAllocatedBytes_, 0u);
+  EXPECT_GT(valuesUsage.totalAllocatedBytes_, 0u);
+  EXPECT_EQ(sortInfo.getTotalResourceUsage().totalAllocatedBytes_,
+            sortUsage.totalAllocatedBytes_ + valuesUsage.totalAllocatedBytes_);
+
+  // The `Sort` is now read from the cache. Its runtime information still
+  // contains the `ValuesForTesting`, the resources of which are not counted
+  // again.
+  auto distinct = ad_utility::makeExecutionTree<Distinct>(
+      qec, makeSort(), std::vector<ColumnIndex>{0, 1});
+  [[maybe_unused]] auto distinctResult = distinct->getResult();
+  const auto& distinctInfo = distinct->getRootOperation()->runtimeInfo();
+  const auto& cachedSortInfo = *distinctInfo.children_.at(0);
+  EXPECT_EQ(cachedSortInfo.cacheStatus_,
+            ad_utility::CacheStatus::cachedNotPinned);
+  ASSERT_EQ(cachedSortInfo.children_.size(), 1u);
+  EXPECT_EQ(cachedSortInfo.getTotalResourceUsage(),
+            ad_utility::ResourceUsage{});
+  EXPECT_GT(distinctInfo.getResourceUsage().totalAllocatedBytes_, 0u);
+  EXPECT_EQ(distinctInfo.getTotalResourceUsage(),
+            distinctInfo.getResourceUsage());
+  nlohmann::ordered_json j = distinctInfo;
+  EXPECT_TRUE(j.contains("resource_usage"));
+  EXPECT_FALSE(j["children"][0].contains("resource_usage"));
+  EXPECT_FALSE(j["children"][0]["children"][0].contains("resource_usage"));
+}
@@ -197,6 +197,48 @@ TEST(OrderBy, mixedDatatypes) {
               {true});
 }
 
+// _____________________________________________________________________________
+TEST(OrderBy, shortStringsAndVocabulary) {
+  auto qec = ad_utility::testing::getQec(
+      "<x> <p> \"alpha\" . <x> <p> \"gamma\" .");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  auto I = ad_utility::testing::IntId;
+  auto Dec = [](std::string_view s) {
+    return Id::makeFromDecimal(Decimal::parse(s).value());
+  };
+  auto S = [](std::string_view s) {
+    return Id::makeFromShortString(ShortString::fromContent(s).value());
+  };
+  auto U = Id::makeUndefined();
+
+  // The `ShortString`s are sorted between the literals from the vocabulary,
+  // and all the numbers come before all the strings.
+  std::vector<Id> input{getId("\"gamma\""), S("beta"),   I(3), U,
+                        getId("\"alpha\""), S("delta"), Dec("-1.5")};
+  std::vector<Id> expected{U,         Dec("-1.5"), I(3),
+                           getId("\"alpha\""), S("beta"),  S("delta"),
+                           getId("\"gamma\"")};
+  auto toTable = [&qec](const std::vector<Id>& ids) {
+    IdTable table{1, qec->getAllocator()};
+    for (Id id : ids) {
+      table.push_back({id});
+    }
+    return table;
+  };
+  for (bool isDescending : {false, true}) {
+    for (size_t i = 0; i < 5; ++i) {
+      ad_utility::randomShuffle(input.begin(), input.end());
+      auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+          qec, toTable(input),
+          std::vector<std::optional<Variable>>{Variable{"?x"}});
+      OrderBy orderBy{qec, std::move(subtree),
+                      OrderBy::SortIndices{{0, isDescending}}};
+      EXPECT_EQ(orderBy.getResult()->idTable(), toTable(expected));
+    }
+    std::ranges::reverse(expected);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(OrderBy, simpleMemberFunctions) {
   {
@@ -7,6 +7,7 @@
 
 #include "./QueryPlannerTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
+#include "absl/cleanup/cleanup.h"
 #include "engine/QueryPlanner.h"
 #include "global/Constants.h"
 #include "parser/SparqlParser.h"
@@ -542,6 +543,43 @@ qet-width: 3
   }
 }
 
+// _____________________________________________________________________________
+TEST(QueryExecutionTreeTest, cyclicQueryUsesWorstCaseOptimalJoin) {
+  auto createTree = [](std::string query) {
+    ParsedQuery pq = SparqlParser::parseQuery(std::move(query));
+    return QueryPlanner{nullptr}.createExecutionTree(pq);
+  };
+  std::string triangle =
+      "SELECT ?x ?y ?z WHERE { ?x <p> ?y . ?y <p> ?z . ?z <q> ?x }";
+  auto qet = createTree(triangle);
+  ASSERT_EQ(qet.getType(), QueryExecutionTree::WORST_CASE_OPTIMAL_JOIN);
+  EXPECT_EQ(qet.getRootOperation()->getChildren().size(), 3u);
+
+  // The triple that is not part of the cycle is joined with the result of the
+  // worst-case optimal join.
+  qet = createTree(
+      "SELECT ?x ?y ?z ?a WHERE { ?x <p> ?y . ?y <p> ?z . ?z <q> ?x . "
+      "?a <r> ?x }");
+  ASSERT_EQ(qet.getType(), QueryExecutionTree::JOIN);
+
+  // Paths are not cyclic.
+  qet = createTree("SELECT ?x ?y ?z WHERE { ?x <p> ?y . ?y <p> ?z }");
+  EXPECT_NE(qet.getType(), QueryExecutionTree::WORST_CASE_OPTIMAL_JOIN);
+
+  // The worst-case optimal join is only used for cycles with at least
+  // `wcoj-min-num-triples` triples, zero disables it.
+  auto previous = RuntimeParameters().get<"wcoj-min-num-triples">();
+  auto cleanup = absl::Cleanup{[previous]() {
+    RuntimeParameters().set<"wcoj-min-num-triples">(previous);
+  }};
+  RuntimeParameters().set<"wcoj-min-num-triples">(4);
+  EXPECT_NE(createTree(triangle).getType(),
+            QueryExecutionTree::WORST_CASE_OPTIMAL_JOIN);
+  RuntimeParameters().set<"wcoj-min-num-triples">(0);
+  EXPECT_NE(createTree(triangle).getType(),
+            QueryExecutionTree::WORST_CASE_OPTIMAL_JOIN);
+}
+
 TEST(QueryExecutionTreeTest, testFormerSegfaultTriFilter) {
   ParsedQuery pq = SparqlParser::parseQuery(
       "PREFIX fb: <http://rdf.freebase.com/ns/>\n"
@@ -875,3 +913,85 @@ TEST(QueryPlannerTest, TooManyTriples) {
       qp.createExecutionTree(pq),
       ::testing::ContainsRegex("At most 64 triples allowed at the moment."));
 }
+
+// __________________________________________________________________________
+TEST(QueryPlannerTest, GreedyPlanningOfLargeComponents) {
+  auto scan = h::IndexScanFromStrings;
+  auto previousBudget = RuntimeParameters().get<"query-planning-budget">();
+  auto cleanup = absl::Cleanup{[previousBudget]() {
+    RuntimeParameters().set<"query-planning-budget">(previousBudget);
+  }};
+  // With a budget of zero, each connected component is planned greedily.
+  RuntimeParameters().set<"query-planning-budget">(0);
+  h::expect("SELECT * WHERE {?x <p> ?y . ?y <q> ?z . ?z <r> <o>}",
+            h::UnorderedJoins(scan("?x", "<p>", "?y"), scan("?y", "<q>", "?z"),
+                              scan("?z", "<r>", "<o>")));
+
+  // A chain of four triples has 10 connected subgraphs, so it is planned
+  // greedily with a budget of 9 and by the dynamic programming with a budget
+  // of 10. Both find a plan that joins the four scans.
+  std::string chain =
+      "SELECT * WHERE {?a <p> ?b . ?b <q> ?c . ?c <r> ?d . ?d <s> ?e}";
+  auto chainMatcher =
+      h::UnorderedJoins(scan("?a", "<p>", "?b"), scan("?b", "<q>", "?c"),
+                        scan("?c", "<r>", "?d"), scan("?d", "<s>", "?e"));
+  for (size_t budget : {9u, 10u}) {
+    RuntimeParameters().set<"query-planning-budget">(budget);
+    h::expect(chain, chainMatcher);
+  }
+
+  // The budget applies to each connected component separately. Here, the
+  // first component (3 connected subgraphs) is planned greedily and the
+  // second one (a single triple) by the dynamic programming.
+  RuntimeParameters().set<"query-planning-budget">(2);
+  h::expect("SELECT * WHERE {?x <p> ?y . ?y <q> ?z . ?a <r> ?b}",
+            h::CartesianProductJoin(
+                h::UnorderedJoins(scan("?x", "<p>", "?y"),
+                                  scan("?y", "<q>", "?z")),
+                scan("?a", "<r>", "?b")));
+
+  // A star with 40 triples has more than 2^40 connected subgraphs, so with
+  // the default budget it can only be planned greedily.
+  RuntimeParameters().set<"query-planning-budget">(previousBudget);
+  std::string query = "SELECT * WHERE {";
+  for (size_t i = 0; i < 40; i++) {
+    absl::StrAppend(&query, " ?x <p", i, "> ?o", i, " .");
+  }
+  absl::StrAppend(&query, "}");
+  auto qet = h::parseAndPlan(query, ad_utility::testing::getQec());
+  EXPECT_EQ(qet.getResultWidth(), 41u);
+}
+
+// __________________________________________________________________________
+TEST(QueryPlannerTest, countConnectedSubgraphs) {
+  QueryPlanner qp{ad_utility::testing::getQec()};
+  auto count = [&qp](const std::string& triples, size_t budget) {
+    ParsedQuery pq =
+        SparqlParser::parseQuery(absl::StrCat("SELECT * WHERE {", triples, "}"));
+    auto tg = qp.createTripleGraph(&pq.children()[0].getBasic());
+    // There are several scans for each triple, which are only counted once.
+    auto seeds = qp.seedWithScansAndText(tg, {});
+    return qp.countConnectedSubgraphs(seeds, tg, budget);
+  };
+  // A chain of four triples has 4 + 3 + 2 + 1 connected subgraphs.
+  std::string chain = "?a <p> ?b . ?b <p> ?c . ?c <p> ?d . ?d <p> ?e";
+  EXPECT_EQ(count(chain, 1000), 10u);
+  EXPECT_EQ(count(chain, 10), 10u);
+  // In a star, every non-empty subset of the triples is connected.
+  std::string star = "?x <p> ?a . ?x <q> ?b . ?x <r> ?c . ?x <s> ?d";
+  EXPECT_EQ(count(star, 1000), 15u);
+  // Two separate triples.
+  EXPECT_EQ(count("?x <p> ?y . ?a <p> ?b", 1000), 2u);
+
+  // The counting stops soon after the budget is exceeded, which is necessary
+  // for large stars.
+  std::string largeStar;
+  for (size_t i = 0; i < 40; i++) {
+    absl::StrAppend(&largeStar, " ?x <p", i, "> ?o", i, " .");
+  }
+  auto numSubgraphs = count(largeStar, 100);
+  EXPECT_GT(numSubgraphs, 100u);
+  EXPECT_LE(numSubgraphs, 140u);
+  EXPECT_LE(count(star, 5), 8u);
+  EXPECT_GT(count(star, 5), 5u);
+}
@@ -74,7 +74,7 @@ auto testNonPrefixRegex = [](std::string variable, std::string regex,
   testWithExplicitResult(expr, expectedResult);
 };
 
-TEST(RegexExpression, nonPrefixRegex) {
+void testNonPrefixRegexOnAllColumns() {
   // ?vocab column is `"Beta", "alpha", "älpha"
   // ?mixed column is `1, -0.1, <x>`
   auto test = testNonPrefixRegex;
@@ -100,6 +100,21 @@ TEST(RegexExpression, nonPrefixRegex) {
   test("?localVocab", "Vocab[AD]", {T, F, T}, true);
 }
 
+TEST(RegexExpression, nonPrefixRegex) { testNonPrefixRegexOnAllColumns(); }
+
+// The same tests, but for the IDs from the vocabulary, the regex is evaluated
+// via the precomputed matches of the complete vocabulary.
+TEST(RegexExpression, nonPrefixRegexWithVocabularyMatches) {
+  auto previousFraction =
+      RuntimeParameters().get<"vocabulary-matches-min-input-fraction">();
+  RuntimeParameters().set<"vocabulary-matches-min-input-fraction">(0.0);
+  testNonPrefixRegexOnAllColumns();
+  // The second time, the matches are read from the cache.
+  testNonPrefixRegexOnAllColumns();
+  RuntimeParameters().set<"vocabulary-matches-min-input-fraction">(
+      previousFraction);
+}
+
 auto testNonPrefixRegexWithFlags =
     [](std::string variable, std::string regex, std::string flags,
        const std::vector<Id>& expectedResult,
@@ -154,6 +169,36 @@ TEST(RegexExpression, getPrefixRegex) {
   ASSERT_THROW(getPrefixRegex(R"(^\")"), std::runtime_error);
 }
 
+TEST(RegexExpression, getRequiredSubstrings) {
+  using namespace sparqlExpression::detail;
+  using V = std::vector<std::string>;
+  auto get = [](std::string_view regex, bool caseInsensitive = false) {
+    return getRequiredSubstrings(regex, caseInsensitive);
+  };
+  EXPECT_EQ(get("alpha"), V{"alpha"});
+  EXPECT_EQ(get("^al.ha$"), (V{"al", "ha"}));
+  EXPECT_EQ(get("alph?a"), (V{"alp", "a"}));
+  EXPECT_EQ(get("alph*a"), (V{"alp", "a"}));
+  EXPECT_EQ(get("alph+a"), (V{"alph", "a"}));
+  EXPECT_EQ(get("alph{0,3}a"), (V{"alp", "a"}));
+  EXPECT_EQ(get("al[phx]+a"), (V{"al", "a"}));
+  EXPECT_EQ(get("al[]|)(]a"), (V{"al", "a"}));
+  EXPECT_EQ(get("al[[:alpha:]]a"), (V{"al", "a"}));
+  EXPECT_EQ(get("be(ta|x)gamma"), (V{"be", "gamma"}));
+  EXPECT_EQ(get(R"(al\.pha\d\pLx\x41y)"), (V{"al.pha", "x", "y"}));
+  // An optional multi-byte character is removed completely.
+  EXPECT_EQ(get("aä?"), V{"a"});
+  // Alternatives at the top level.
+  EXPECT_EQ(get("alpha|beta"), V{});
+  EXPECT_EQ(get(""), V{});
+
+  // When ignoring the case, `k`, `s`, and non-ASCII characters can also match
+  // non-ASCII characters.
+  EXPECT_EQ(get("AÄlphakSx", true), (V{"A", "lpha", "x"}));
+  EXPECT_EQ(get("(?i)alpha"), V{"alpha"});
+  EXPECT_EQ(get("(?i)Sun"), V{"un"});
+}
+
 auto testPrefixRegexUnorderedColumn =
     [](std::string variable, std::string regex,
        const std::vector<Id>& expectedResult, bool childAsStr = false,
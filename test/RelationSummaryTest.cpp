@@ -0,0 +1,118 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "./IndexTestHelpers.h"
+#include "./util/GTestHelpers.h"
+#include "./util/IdTestHelpers.h"
+#include "index/IndexImpl.h"
+#include "index/RelationSummary.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+
+using valueIdComparators::Comparison;
+
+namespace {
+auto I = ad_utility::testing::IntId;
+auto D = ad_utility::testing::DoubleId;
+auto V = ad_utility::testing::VocabId;
+auto Dec = [](std::string_view s) {
+  return Id::makeFromDecimal(Decimal::parse(s).value());
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(RelationSummary, builderAndSerialization) {
+  RelationSummary::Builder builder;
+  builder.pushBlock(std::vector{V(1), V(1), V(3)});
+  builder.pushBlock(std::vector{I(2), I(5), I(5), D(1.5)});
+  // Negative doubles are sorted in reverse order in the permutations.
+  builder.pushBlock(std::vector{D(-0.5), D(-2.0)});
+  builder.pushBlock(std::vector{V(7), Dec("-3.5"), Dec("0.5")});
+  auto summary = std::move(builder).finish(9);
+  EXPECT_EQ(summary.numDistinct(), 9u);
+  using Block = RelationSummary::BlockSummary;
+  Id U = Id::makeUndefined();
+  EXPECT_THAT(summary.blocks(),
+              ::testing::ElementsAre(Block{2, U, U}, Block{3, D(1.5), I(5)},
+                                     Block{2, D(-2.0), D(-0.5)},
+                                     Block{3, Dec("-3.5"), Dec("0.5")}));
+
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << summary;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  RelationSummary deserialized;
+  reader >> deserialized;
+  EXPECT_EQ(deserialized, summary);
+}
+
+// _____________________________________________________________________________
+TEST(RelationSummary, aggregateColumn) {
+  // With the default blocksize of the test indices, there are two triples per
+  // block, so `<p>` is a large relation with seven blocks in POS, some of which
+  // contain values of different datatypes. The literals `2.5` and `-1.5` are
+  // stored as decimals, which come after the IRIs in the order of the bits.
+  std::string turtle;
+  for (size_t i = 0; i < 10; ++i) {
+    absl::StrAppend(&turtle, "<s", i, "> <p> ", i, " . ");
+  }
+  turtle +=
+      "<s0> <p> 2.5 . <s1> <p> -1 . <s2> <p> -1.5 . <s3> <p> <x> . "
+      "<s0> <q> 1 . <s1> <q> 1 . <s2> <q> 1 . <s3> <q> 2 .";
+  auto qec = ad_utility::testing::getQec(turtle);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  const auto& impl = qec->getIndex().getImpl();
+  const auto& pos = impl.getPermutation(Permutation::POS);
+  const auto& pso = impl.getPermutation(Permutation::PSO);
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  ASSERT_NE(pos.getRelationSummary(getId("<p>")), nullptr);
+  EXPECT_EQ(pos.getRelationSummary(getId("<p>"))->numDistinct(), 14u);
+
+  using C = Permutation::ValueComparison;
+  auto expectAggregates =
+      [&](const Permutation& permutation, std::string_view col0,
+          std::optional<Id> col1Id, std::vector<C> comparisons,
+          uint64_t count, uint64_t numDistinct, std::optional<Id> min,
+          std::optional<Id> max,
+          ad_utility::source_location l =
+              ad_utility::source_location::current()) {
+        auto trace = generateLocationTrace(l);
+        auto result = permutation.aggregateColumn(
+            getId(std::string{col0}), col1Id, comparisons, cancellationHandle);
+        EXPECT_EQ(result.count_, count);
+        EXPECT_EQ(result.numDistinct_, numDistinct);
+        // `std::nullopt` means that not all the values are numbers.
+        EXPECT_EQ(result.allValuesAreNumeric_, min.has_value());
+        if (min.has_value() && max.has_value()) {
+          EXPECT_EQ(result.min_, min.value());
+          EXPECT_EQ(result.max_, max.value());
+        }
+      };
+  using enum Comparison;
+  auto none = std::nullopt;
+  Id U = Id::makeUndefined();
+  expectAggregates(pos, "<p>", none, {}, 14, 14, none, none);
+  expectAggregates(pos, "<p>", none, {C{GT, I(2)}}, 8, 8, Dec("2.5"),
+                   I(9));
+  expectAggregates(pos, "<p>", none, {C{GE, I(0)}, C{LT, D(5.0)}}, 6, 6, I(0),
+                   I(4));
+  expectAggregates(pos, "<p>", none, {C{LT, I(0)}}, 2, 2, Dec("-1.5"),
+                   I(-1));
+  expectAggregates(pos, "<p>", none, {C{EQ, I(4)}}, 1, 1, I(4), I(4));
+  expectAggregates(pos, "<p>", none, {C{NE, I(4)}}, 12, 12, Dec("-1.5"),
+                   I(9));
+  expectAggregates(pos, "<p>", none, {C{GT, I(100)}}, 0, 0, U, U);
+  expectAggregates(pos, "<q>", none, {}, 4, 2, I(1), I(2));
+  expectAggregates(pos, "<q>", none, {C{LE, I(1)}}, 3, 1, I(1), I(1));
+  // A fixed `col1`.
+  expectAggregates(pos, "<q>", I(1), {}, 3, 3, none, none);
+  expectAggregates(pso, "<p>", getId("<s0>"), {}, 2, 2, I(0),
+                   Dec("2.5"));
+  expectAggregates(pso, "<p>", getId("<s0>"), {C{LT, I(1)}}, 1, 1, I(0),
+                   I(0));
+  // A `col0` that doesn't exist.
+  expectAggregates(pos, "<s0>", none, {}, 0, 0, U, U);
+}
@@ -0,0 +1,164 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "util/AllocatorWithLimit.h"
+#include "util/ResourceTracker.h"
+#include "util/jthread.h"
+
+using ad_utility::ResourceTracker;
+using ad_utility::ResourceUsage;
+using namespace std::chrono_literals;
+
+namespace {
+using Vec = std::vector<int, ad_utility::AllocatorWithLimit<int>>;
+auto makeVec() {
+  return Vec{ad_utility::makeUnlimitedAllocator<int>()};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ResourceTracker, allocations) {
+  auto tracker = std::make_shared<ResourceTracker>();
+  {
+    ResourceTracker::Scope scope{tracker};
+    auto v = makeVec();
+    v.reserve(1000);
+    {
+      auto v2 = makeVec();
+      v2.reserve(500);
+    }
+    auto v3 = makeVec();
+    v3.reserve(200);
+  }
+  auto usage = tracker->getUsage();
+  EXPECT_EQ(usage.totalAllocatedBytes_, 1700 * sizeof(int));
+  EXPECT_EQ(usage.peakAllocatedBytes_, 1500 * sizeof(int));
+  EXPECT_EQ(usage.numThreads_, 1u);
+
+  // Allocations outside of a scope are not tracked.
+  EXPECT_EQ(ResourceTracker::getCurrent(), nullptr);
+  auto v = makeVec();
+  v.reserve(3000);
+  EXPECT_EQ(tracker->getUsage(), usage);
+}
+
+// _____________________________________________________________________________
+TEST(ResourceTracker, deallocationInOtherScope) {
+  auto producer = std::make_shared<ResourceTracker>();
+  auto consumer = std::make_shared<ResourceTracker>();
+  auto v = makeVec();
+  {
+    ResourceTracker::Scope scope{producer};
+    v.reserve(1000);
+  }
+  {
+    // The memory of the producer is freed by the consumer, which doesn't
+    // reduce the memory of the consumer. The allocations of the consumer
+    // therefore count for its peak.
+    ResourceTracker::Scope scope{consumer};
+    v = makeVec();
+    auto v2 = makeVec();
+    v2.reserve(300);
+  }
+  EXPECT_EQ(consumer->getUsage().peakAllocatedBytes_, 300 * sizeof(int));
+  EXPECT_EQ(consumer->getUsage().totalAllocatedBytes_, 300 * sizeof(int));
+
+  // After the memory of the producer has been freed, the producer can
+  // allocate up to its peak without increasing it.
+  {
+    ResourceTracker::Scope scope{producer};
+    auto v3 = makeVec();
+    v3.reserve(1000);
+  }
+  EXPECT_EQ(producer->getUsage().peakAllocatedBytes_, 1000 * sizeof(int));
+  EXPECT_EQ(producer->getUsage().totalAllocatedBytes_, 2000 * sizeof(int));
+
+  // A tracker stays alive as long as memory that was allocated for it exists.
+  {
+    ResourceTracker::Scope scope{producer};
+    v.reserve(100);
+  }
+  std::weak_ptr<ResourceTracker> weakProducer = producer;
+  producer.reset();
+  EXPECT_FALSE(weakProducer.expired());
+  v = makeVec();
+  EXPECT_TRUE(weakProducer.expired());
+}
+
+// _____________________________________________________________________________
+TEST(ResourceTracker, nestedScopes) {
+  auto outer = std::make_shared<ResourceTracker>();
+  auto inner = std::make_shared<ResourceTracker>();
+  {
+    ResourceTracker::Scope outerScope{outer};
+    EXPECT_EQ(ResourceTracker::getCurrent(), outer);
+    ResourceTracker::recordBlockRead(100);
+    {
+      ResourceTracker::Scope innerScope{inner};
+      EXPECT_EQ(ResourceTracker::getCurrent(), inner);
+      ResourceTracker::recordBlockRead(20);
+      ResourceTracker::recordBlockRead(30);
+      ResourceTracker::recordBlockDecompressed();
+      // A scope for `nullptr` has no effect.
+      ResourceTracker::Scope emptyScope{nullptr};
+      EXPECT_EQ(ResourceTracker::getCurrent(), inner);
+      // Spend some CPU time.
+      volatile size_t sum = 0;
+      for (size_t i = 0; i < 10'000'000; ++i) {
+        sum = sum + i;
+      }
+    }
+    EXPECT_EQ(ResourceTracker::getCurrent(), outer);
+    ResourceTracker::recordBlockDecompressed();
+  }
+  EXPECT_EQ(ResourceTracker::getCurrent(), nullptr);
+
+  auto outerUsage = outer->getUsage();
+  EXPECT_EQ(outerUsage.bytesRead_, 100u);
+  EXPECT_EQ(outerUsage.numBlocksRead_, 1u);
+  EXPECT_EQ(outerUsage.numBlocksDecompressed_, 1u);
+  auto innerUsage = inner->getUsage();
+  EXPECT_EQ(innerUsage.bytesRead_, 50u);
+  EXPECT_EQ(innerUsage.numBlocksRead_, 2u);
+  EXPECT_EQ(innerUsage.numBlocksDecompressed_, 1u);
+  // The CPU time of the inner scope is not counted for the outer scope.
+  EXPECT_GT(innerUsage.cpuTime_, 0us);
+  EXPECT_LT(outerUsage.cpuTime_, innerUsage.cpuTime_);
+}
+
+// _____________________________________________________________________________
+TEST(ResourceTracker, multipleThreads) {
+  auto tracker = std::make_shared<ResourceTracker>();
+  ResourceTracker::Scope scope{tracker};
+  auto current = ResourceTracker::getCurrent();
+  std::vector<ad_utility::JThread> threads;
+  for (size_t i = 0; i < 3; ++i) {
+    threads.emplace_back([current] {
+      // The scope is thread-local, so a new thread has no current tracker.
+      EXPECT_EQ(ResourceTracker::getCurrent(), nullptr);
+      ResourceTracker::Scope threadScope{current};
+      ResourceTracker::recordBlockRead(10);
+      auto v = makeVec();
+      v.reserve(100);
+    });
+  }
+  threads.clear();
+  auto usage = tracker->getUsage();
+  EXPECT_EQ(usage.numThreads_, 4u);
+  EXPECT_EQ(usage.bytesRead_, 30u);
+  EXPECT_EQ(usage.numBlocksRead_, 3u);
+  EXPECT_EQ(usage.totalAllocatedBytes_, 300 * sizeof(int));
+}
+
+// _____________________________________________________________________________
+TEST(ResourceTracker, addChildUsage) {
+  ResourceUsage parent{100, 200, 10, 1, 2, 5us, 1};
+  ResourceUsage child{150, 100, 20, 3, 4, 7us, 4};
+  parent.addChildUsage(child);
+  EXPECT_EQ(parent, (ResourceUsage{150, 300, 30, 4, 6, 12us, 4}));
+}
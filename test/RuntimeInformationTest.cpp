@@ -214,3 +214,47 @@ TEST(RuntimeInformation, toStringAndJson) {
 )";
   ASSERT_EQ(j, nlohmann::ordered_json::parse(expectedJson));
 }
+
+// ________________________________________________________________
+TEST(RuntimeInformation, resourceUsage) {
+  auto makeTracker = [](size_t numBytesRead) {
+    auto tracker = std::make_shared<ad_utility::ResourceTracker>();
+    ad_utility::ResourceTracker::Scope scope{tracker};
+    ad_utility::ResourceTracker::recordBlockRead(numBytesRead);
+    ad_utility::ResourceTracker::recordBlockDecompressed();
+    return tracker;
+  };
+  RuntimeInformation child;
+  child.resourceTracker_ = makeTracker(30);
+  // A child that was read from the cache used no resources. Its children
+  // were computed for an earlier query.
+  RuntimeInformation cachedChild;
+  cachedChild.cacheStatus_ = ad_utility::CacheStatus::cachedNotPinned;
+  cachedChild.children_.push_back(std::make_shared<RuntimeInformation>(child));
+  RuntimeInformation parent;
+  parent.resourceTracker_ = makeTracker(12);
+  parent.children_.push_back(std::make_shared<RuntimeInformation>(child));
+  parent.children_.push_back(std::make_shared<RuntimeInformation>(cachedChild));
+
+  EXPECT_EQ(cachedChild.getResourceUsage(), ad_utility::ResourceUsage{});
+  EXPECT_EQ(cachedChild.getTotalResourceUsage(), ad_utility::ResourceUsage{});
+  EXPECT_EQ(parent.getResourceUsage().bytesRead_, 12u);
+  auto total = parent.getTotalResourceUsage();
+  EXPECT_EQ(total.bytesRead_, 42u);
+  EXPECT_EQ(total.numBlocksRead_, 2u);
+  EXPECT_EQ(total.numBlocksDecompressed_, 2u);
+  EXPECT_EQ(total.numThreads_, 1u);
+
+  nlohmann::ordered_json j = parent;
+  EXPECT_EQ(j["resource_usage"]["bytes_read"], 12);
+  EXPECT_EQ(j["total_resource_usage"]["bytes_read"], 42);
+  EXPECT_EQ(j["total_resource_usage"]["blocks_decompressed"], 2);
+  EXPECT_EQ(j["children"][0]["resource_usage"]["bytes_read"], 30);
+  EXPECT_FALSE(j["children"][1].contains("resource_usage"));
+  EXPECT_FALSE(j["children"][1]["children"][0].contains("resource_usage"));
+
+  // The LIMIT row used no resources of its own.
+  parent.addLimitOffsetRow(LimitOffsetClause{23, 1, 0}, 2ms, true);
+  EXPECT_EQ(parent.getResourceUsage(), ad_utility::ResourceUsage{});
+  EXPECT_EQ(parent.getTotalResourceUsage().bytesRead_, 42u);
+}
@@ -0,0 +1,87 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "engine/ServerMetrics.h"
+
+using namespace std::chrono_literals;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace {
+// A `RuntimeInformation` of a computed operation.
+std::shared_ptr<RuntimeInformation> makeRuntimeInfo(
+    std::string operationType, std::chrono::milliseconds totalTime,
+    size_t numRows,
+    std::vector<std::shared_ptr<RuntimeInformation>> children = {}) {
+  auto rti = std::make_shared<RuntimeInformation>();
+  rti->operationType_ = std::move(operationType);
+  rti->totalTime_ = totalTime;
+  rti->numRows_ = numRows;
+  rti->status_ = RuntimeInformation::Status::fullyMaterialized;
+  rti->children_ = std::move(children);
+  return rti;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ServerMetrics, queriesAndPhases) {
+  ServerMetrics metrics;
+  using enum ServerMetrics::QueryOutcome;
+  metrics.recordQuery(ok);
+  metrics.recordQuery(ok);
+  metrics.recordQuery(cancelled);
+  metrics.recordPhase(ServerMetrics::Phase::parse, 3us);
+  metrics.recordPhase(ServerMetrics::Phase::execute, 2s);
+  // Negative durations (which can occur because of rounding) count as zero.
+  metrics.recordPhase(ServerMetrics::Phase::export_, -1us);
+
+  auto result = metrics.toPrometheusFormat(1024, 3);
+  EXPECT_THAT(result, HasSubstr("qlever_queries_total{outcome=\"ok\"} 2\n"));
+  EXPECT_THAT(result,
+              HasSubstr("qlever_queries_total{outcome=\"cancelled\"} 1\n"));
+  EXPECT_THAT(result,
+              HasSubstr("qlever_queries_total{outcome=\"failed\"} 0\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_query_phase_duration_seconds_count{"
+                                "phase=\"parse\"} 1\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_query_phase_duration_seconds_sum{"
+                                "phase=\"execute\"} 2\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_query_phase_duration_seconds_sum{"
+                                "phase=\"export\"} 0\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_allocated_memory_bytes 1024\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_active_websocket_sessions 3\n"));
+}
+
+// _____________________________________________________________________________
+TEST(ServerMetrics, recordRuntimeInformation) {
+  ServerMetrics metrics;
+  auto scan1 = makeRuntimeInfo("IndexScan", 10ms, 100);
+  // The children of a cached result stem from the query that computed it.
+  auto cachedChild = makeRuntimeInfo("Filter", 3ms, 70);
+  auto scan2 = makeRuntimeInfo("IndexScan", 5ms, 50, {cachedChild});
+  scan2->cacheStatus_ = ad_utility::CacheStatus::cachedPinned;
+  auto notComputed = makeRuntimeInfo("Sort", 0ms, 0);
+  notComputed->status_ = RuntimeInformation::Status::notStarted;
+  auto join = makeRuntimeInfo("Join", 20ms, 30, {scan1, scan2, notComputed});
+  metrics.recordRuntimeInformation(*join);
+
+  auto result = metrics.toPrometheusFormat(0, 0);
+  // The cached scan doesn't count for the computed rows and times.
+  EXPECT_THAT(result, HasSubstr("qlever_operation_result_rows_total{"
+                                "operation=\"IndexScan\"} 100\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_operation_result_rows_total{"
+                                "operation=\"Join\"} 30\n"));
+  EXPECT_THAT(result, Not(HasSubstr("operation=\"Sort\"")));
+  EXPECT_THAT(result, Not(HasSubstr("operation=\"Filter\"")));
+  // The operation time of the join excludes the time of its children.
+  EXPECT_THAT(result, HasSubstr("qlever_operation_compute_duration_seconds_sum{"
+                                "operation=\"Join\"} 0.005\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_operation_compute_duration_seconds_"
+                                "count{operation=\"IndexScan\"} 1\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_operation_cache_status_total{"
+                                "status=\"computed\"} 2\n"));
+  EXPECT_THAT(result, HasSubstr("qlever_operation_cache_status_total{"
+                                "status=\"cached_pinned\"} 1\n"));
+}
@@ -9,6 +9,8 @@
 
 #include "IndexTestHelpers.h"
 #include "engine/Service.h"
+#include "engine/ValuesForTesting.h"
+#include "global/Constants.h"
 #include "parser/GraphPatternOperation.h"
 #include "util/IdTableHelpers.h"
 #include "util/http/HttpUtils.h"
@@ -24,9 +26,21 @@ class ServiceTest : public ::testing::Test {
   ad_utility::AllocatorWithLimit<Id> testAllocator =
       ad_utility::testing::makeAllocator();
 
-  // Factory for generating mocks of the `sendHttpOrHttpsRequest` function that
-  // is used by default by a `Service` operation (see the constructor in
-  // `Service.h`). Each mock does the following:
+  // Replace each sequence of whitespace in `s` by a single space.
+  static std::string normalizeWhitespace(const std::string& s) {
+    return std::regex_replace(s, std::regex{"\\s+"}, " ");
+  }
+
+  // Yield the `result` in chunks of three bytes.
+  static cppcoro::generator<std::string> yieldInChunks(std::string result) {
+    for (size_t i = 0; i < result.size(); i += 3) {
+      co_yield result.substr(i, 3);
+    }
+  }
+
+  // Factory for generating mocks of the `sendHttpOrHttpsRequestStreaming`
+  // function that is used by default by a `Service` operation (see the
+  // constructor in `Service.h`). Each mock does the following:
   //
   // 1. It tests that the request method is POST, the content-type header is
   //    `application/sparql-query`, and the accept header is
@@ -36,17 +50,18 @@ class ServiceTest : public ::testing::Test {
   //
   // 3. It tests that the post data is as expected.
   //
-  // 4. It returns the specified TSV.
+  // 4. It yields the specified TSV in small chunks (so that some of the lines
+  //    are split between chunks).
   //
   // NOTE: In a previous version of this test, we set up an actual test server.
   // The code can be found in the history of this PR.
   static auto constexpr getTsvFunctionFactory =
       [](const std::string& expectedUrl, const std::string& expectedSparqlQuery,
          const std::string& predefinedResult) -> Service::GetTsvFunction {
-    return [=](ad_utility::httpUtils::Url url,
-               const boost::beast::http::verb& method,
-               std::string_view postData, std::string_view contentTypeHeader,
-               std::string_view acceptHeader) -> std::istringstream {
+    return [=](ad_utility::httpUtils::Url url, boost::beast::http::verb method,
+               std::string postData, std::string contentTypeHeader,
+               std::string acceptHeader, std::chrono::steady_clock::time_point)
+               -> cppcoro::generator<std::string> {
       // Check that the request parameters are as expected.
       //
       // NOTE: The first three are hard-coded in `Service::computeResult`, but
@@ -62,13 +77,17 @@ class ServiceTest : public ::testing::Test {
       // NOTE: a SERVICE clause specifies only the body of a SPARQL query, from
       // which `Service::computeResult` has to construct a full SPARQL query by
       // adding `SELECT ... WHERE`, so this checks something non-trivial.
-      std::string whitespaceNormalizedPostData =
-          std::regex_replace(std::string{postData}, std::regex{"\\s+"}, " ");
-      EXPECT_EQ(whitespaceNormalizedPostData, expectedSparqlQuery);
+      EXPECT_EQ(normalizeWhitespace(postData), expectedSparqlQuery);
 
-      return std::istringstream{predefinedResult};
+      return yieldInChunks(predefinedResult);
     };
   };
+
+  // A SERVICE clause with the visible variables `?x` and `?y`.
+  parsedQuery::Service parsedServiceClause_{{Variable{"?x"}, Variable{"?y"}},
+                                            Iri{"<http://localhorst/api>"},
+                                            "PREFIX doof: <http://doof.org>",
+                                            "{ }"};
 };
 
 // Test basic methods of class `Service`.
@@ -176,3 +195,143 @@ TEST_F(ServiceTest, computeResult) {
       {{idX, idY}, {idBla, idBli}, {idBlu, idBla}, {idBli, idBlu}});
   EXPECT_EQ(result->idTable(), expectedIdTable);
 }
+
+// Test the evaluation of a SERVICE as a bind join with a sibling operation.
+TEST_F(ServiceTest, bindJoin) {
+  testQec->getQueryTreeCache().clearAll();
+  Id idX, idY;
+  ASSERT_TRUE(testQec->getIndex().getId("<x>", &idX));
+  ASSERT_TRUE(testQec->getIndex().getId("<y>", &idY));
+  // The sibling binds `?x`. Duplicate bindings are sent only once. Numbers
+  // are sent in the canonical form of their datatype.
+  auto sibling = ad_utility::makeExecutionTree<ValuesForTesting>(
+      testQec,
+      makeIdTableFromVector({{idX},
+                             {idY},
+                             {Id::makeFromInt(42)},
+                             {Id::makeFromDouble(-0.25)},
+                             {idX}}),
+      std::vector<std::optional<Variable>>{Variable{"?x"}});
+  std::string expectedSparqlQuery =
+      "PREFIX doof: <http://doof.org> SELECT ?x ?y WHERE { VALUES ( ?x ) { ( "
+      "<x> ) ( <y> ) ( 42 ) ( "
+      "\"-2.5E-1\"^^<http://www.w3.org/2001/XMLSchema#double> ) } { } }";
+  Service service{testQec, parsedServiceClause_,
+                  getTsvFunctionFactory("http://localhorst:80/api",
+                                        expectedSparqlQuery,
+                                        "?x\t?y\n<x>\t<y>\n<y>\t<bla>\n")};
+  ASSERT_FALSE(service.hasSiblingTree());
+  std::shared_ptr<Service> boundService =
+      service.createCopyWithSiblingTree(sibling);
+  ASSERT_TRUE(boundService->hasSiblingTree());
+  EXPECT_EQ(boundService->getDescriptor(),
+            "Service with IRI <http://localhorst/api> (bind join)");
+  EXPECT_NE(boundService->getCacheKey(), service.getCacheKey());
+  EXPECT_THAT(boundService->getChildren(),
+              ::testing::ElementsAre(sibling.get()));
+  EXPECT_EQ(boundService->getSizeEstimate(), 5);
+  // The cost of the sibling is accounted for by the join with the sibling.
+  EXPECT_EQ(boundService->getCostEstimate(), 10 * 5);
+
+  std::shared_ptr<const ResultTable> result = boundService->getResult();
+  std::optional<LocalVocabIndex> idxBla =
+      result->localVocab().getIndexOrNullopt("<bla>");
+  ASSERT_TRUE(idxBla.has_value());
+  Id idBla = Id::makeFromLocalVocabIndex(idxBla.value());
+  EXPECT_EQ(result->idTable(), makeIdTableFromVector({{idX, idY}, {idY, idBla}}));
+}
+
+// Test that the VALUES batches of a bind join are sent concurrently and that
+// their results are merged, and that a sibling with too many rows is not used
+// for a bind join.
+TEST_F(ServiceTest, bindJoinBatches) {
+  testQec->getQueryTreeCache().clearAll();
+  auto& params = RuntimeParameters();
+  auto cleanup = absl::Cleanup{
+      [&params, maxRows = params.get<"service-bind-join-max-rows">(),
+       batchSize = params.get<"service-bind-join-batch-size">(),
+       numThreads = params.get<"service-bind-join-num-threads">()]() {
+        params.set<"service-bind-join-max-rows">(maxRows);
+        params.set<"service-bind-join-batch-size">(batchSize);
+        params.set<"service-bind-join-num-threads">(numThreads);
+      }};
+  params.set<"service-bind-join-batch-size">(1);
+  params.set<"service-bind-join-num-threads">(2);
+  Id idX, idY;
+  ASSERT_TRUE(testQec->getIndex().getId("<x>", &idX));
+  ASSERT_TRUE(testQec->getIndex().getId("<y>", &idY));
+  auto sibling = ad_utility::makeExecutionTree<ValuesForTesting>(
+      testQec, makeIdTableFromVector({{idX}, {idY}}),
+      std::vector<std::optional<Variable>>{Variable{"?x"}});
+
+  // The remote endpoint answers depending on the binding of `?x`.
+  std::atomic<size_t> numRequests = 0;
+  Service::GetTsvFunction getTsv =
+      [&numRequests](ad_utility::httpUtils::Url, boost::beast::http::verb,
+                     std::string postData, std::string, std::string,
+                     std::chrono::steady_clock::time_point) {
+        ++numRequests;
+        std::string query = normalizeWhitespace(postData);
+        if (query.find("( <x> )") != std::string::npos) {
+          return yieldInChunks("?x\t?y\n<x>\t<bla>\n");
+        } else if (query.find("( <y> )") != std::string::npos) {
+          return yieldInChunks("?x\t?y\n<y>\t<blu>\n<y>\t<bla>\n");
+        }
+        EXPECT_EQ(query.find("VALUES"), std::string::npos);
+        return yieldInChunks("?x\t?y\n<x>\t<y>\n");
+      };
+  auto boundService =
+      Service{testQec, parsedServiceClause_, getTsv}.createCopyWithSiblingTree(
+          sibling);
+  std::shared_ptr<const ResultTable> result = boundService->getResult();
+  EXPECT_EQ(numRequests, 2);
+  const auto& localVocab = result->localVocab();
+  EXPECT_EQ(localVocab.size(), 2);
+  auto bla = Id::makeFromLocalVocabIndex(
+      localVocab.getIndexOrNullopt("<bla>").value());
+  auto blu = Id::makeFromLocalVocabIndex(
+      localVocab.getIndexOrNullopt("<blu>").value());
+  std::vector<std::array<Id, 2>> rows;
+  for (const auto& row : result->idTable()) {
+    rows.push_back({row[0], row[1]});
+  }
+  EXPECT_THAT(rows, ::testing::UnorderedElementsAre(
+                        std::array{idX, bla}, std::array{idY, blu},
+                        std::array{idY, bla}));
+
+  // With too many distinct bindings, the SERVICE query is sent as it is.
+  testQec->getQueryTreeCache().clearAll();
+  params.set<"service-bind-join-max-rows">(1);
+  numRequests = 0;
+  result = boundService->getResult();
+  EXPECT_EQ(numRequests, 1);
+  EXPECT_EQ(result->idTable(), makeIdTableFromVector({{idX, idY}}));
+}
+
+// Test that the `service-timeout` limits the deadline of the request, and that
+// an error of the request (for example, because the deadline has been reached)
+// is propagated.
+TEST_F(ServiceTest, timeout) {
+  testQec->getQueryTreeCache().clearAll();
+  auto previousTimeout = RuntimeParameters().get<"service-timeout">();
+  auto cleanup = absl::Cleanup{[previousTimeout]() {
+    RuntimeParameters().set<"service-timeout">(previousTimeout);
+  }};
+  RuntimeParameters().set<"service-timeout">(std::chrono::seconds{10});
+  std::chrono::steady_clock::time_point deadline;
+  Service::GetTsvFunction getTsv =
+      [&deadline](ad_utility::httpUtils::Url, boost::beast::http::verb,
+                  std::string, std::string, std::string,
+                  std::chrono::steady_clock::time_point requestDeadline)
+      -> cppcoro::generator<std::string> {
+    deadline = requestDeadline;
+    throw std::runtime_error(
+        "Deadline reached before the HTTP request has completed");
+  };
+  Service service{testQec, parsedServiceClause_, getTsv};
+  auto before = std::chrono::steady_clock::now();
+  EXPECT_ANY_THROW(service.getResult());
+  EXPECT_GE(deadline, before);
+  EXPECT_LE(deadline,
+            std::chrono::steady_clock::now() + std::chrono::seconds{10});
+}
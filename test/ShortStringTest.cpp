@@ -0,0 +1,75 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include "global/ValueId.h"
+#include "util/ShortString.h"
+
+// _____________________________________________________________________________
+TEST(ShortString, fromContentAndGetContent) {
+  for (std::string_view content : {"", "a", "abc", "Beta", "1234567", "a b"}) {
+    auto shortString = ShortString::fromContent(content);
+    ASSERT_TRUE(shortString.has_value()) << content;
+    EXPECT_EQ(shortString->getContent(), content);
+    EXPECT_EQ(shortString->toLiteral(), absl::StrCat("\"", content, "\""));
+    EXPECT_EQ(shortString->toBits() >> ShortString::numDataBits, 0u);
+    EXPECT_EQ(ShortString::fromBits(shortString->toBits()), shortString);
+  }
+  for (std::string_view content : std::vector<std::string_view>{
+           "12345678", "\xC3\xA4", std::string_view{"a\0b", 3}}) {
+    EXPECT_FALSE(ShortString::fromContent(content).has_value()) << content;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ShortString, fromLiteral) {
+  EXPECT_EQ(ShortString::fromLiteral("\"abc\"")->getContent(), "abc");
+  EXPECT_EQ(ShortString::fromLiteral("\"\"")->getContent(), "");
+  EXPECT_FALSE(ShortString::fromLiteral("abc").has_value());
+  EXPECT_FALSE(ShortString::fromLiteral("\"").has_value());
+  EXPECT_FALSE(ShortString::fromLiteral("<abc>").has_value());
+  EXPECT_FALSE(ShortString::fromLiteral("\"12345678\"").has_value());
+}
+
+// _____________________________________________________________________________
+TEST(ShortString, order) {
+  std::vector<std::string_view> contents{"",   "A",   "AB", "B",
+                                         "Ba", "a",   "ab", "abcdefg",
+                                         "b"};
+  for (size_t i = 1; i < contents.size(); ++i) {
+    auto a = ShortString::fromContent(contents[i - 1]).value();
+    auto b = ShortString::fromContent(contents[i]).value();
+    EXPECT_LT(a, b);
+    EXPECT_LT(ValueId::makeFromShortString(a),
+              ValueId::makeFromShortString(b));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ShortString, getPrefixRange) {
+  auto matches = [](std::string_view prefix, std::string_view content) {
+    auto [lower, upper] = ShortString::getPrefixRange(prefix).value();
+    auto bits = ShortString::fromContent(content).value().toBits();
+    return bits >= lower && bits < upper;
+  };
+  EXPECT_TRUE(matches("", ""));
+  EXPECT_TRUE(matches("", "abcdefg"));
+  EXPECT_TRUE(matches("ab", "ab"));
+  EXPECT_TRUE(matches("ab", "abc"));
+  EXPECT_TRUE(matches("ab", "ab\x7F"));
+  EXPECT_TRUE(matches("abcdefg", "abcdefg"));
+  EXPECT_FALSE(matches("ab", "a"));
+  EXPECT_FALSE(matches("ab", "ac"));
+  EXPECT_FALSE(matches("ab", "Ab"));
+  EXPECT_FALSE(matches("abcdefg", "abcdefh"));
+  EXPECT_FALSE(ShortString::getPrefixRange("abcdefgh").has_value());
+}
+
+// _____________________________________________________________________________
+TEST(ShortString, valueId) {
+  auto shortString = ShortString::fromContent("abc").value();
+  auto id = ValueId::makeFromShortString(shortString);
+  EXPECT_EQ(id.getDatatype(), Datatype::ShortString);
+  EXPECT_EQ(id.getShortString(), shortString);
+}
@@ -208,4 +208,101 @@ TEST(Simple8bTest, testEncodeDecode242times0) {
   delete[] encoded;
   delete[] decoded;
 }
+// _____________________________________________________________________________
+TEST(Simple8bTest, computeSkipPointers) {
+  // Mix long streaks of zeros (selectors 0 and 1) with values of different
+  // widths, so that the codewords store very different numbers of elements.
+  std::vector<uint64_t> plain;
+  for (size_t i = 0; i < 2000; ++i) {
+    if (i % 700 < 300) {
+      plain.push_back(0);
+    } else {
+      plain.push_back((i * 7919) % (1ull << (i % 40)));
+    }
+  }
+  std::vector<uint64_t> encoded(plain.size());
+  size_t encodedSize =
+      Simple8bCode::encode(plain.data(), plain.size(), encoded.data());
+  for (size_t chunkSize : {1ul, 7ul, 128ul, 1000ul, 5000ul}) {
+    auto pointers = Simple8bCode::computeSkipPointers(
+        encoded.data(), plain.size(), chunkSize);
+    ASSERT_EQ(pointers.size(), (plain.size() + chunkSize - 1) / chunkSize);
+    ASSERT_EQ(pointers.at(0), Simple8bSkipPointer{});
+    for (size_t chunk = 0; chunk < pointers.size(); ++chunk) {
+      const auto& pointer = pointers[chunk];
+      ASSERT_LE(pointer.firstElementInCodeword_, chunk * chunkSize);
+      ASSERT_LT(pointer.codewordIndex_ * sizeof(uint64_t), encodedSize);
+      // Decoding from the pointer yields the remainder of the list, and the
+      // first element of the chunk is stored in the first codeword.
+      size_t nofElements = plain.size() - pointer.firstElementInCodeword_;
+      std::vector<uint64_t> decoded(nofElements + 239);
+      Simple8bCode::decode(encoded.data() + pointer.codewordIndex_,
+                           nofElements, decoded.data());
+      for (size_t i = 0; i < nofElements; ++i) {
+        ASSERT_EQ(plain[pointer.firstElementInCodeword_ + i], decoded[i]);
+      }
+      if (chunk + 1 < pointers.size() && chunkSize > 240) {
+        ASSERT_LT(pointer.codewordIndex_, pointers[chunk + 1].codewordIndex_);
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Simple8bTest, decodeMatchesDecodeWithSelectorTable) {
+  // Use every selector: streaks of zeros and values of all widths.
+  std::vector<uint64_t> plain;
+  for (size_t i = 0; i < 5000; ++i) {
+    if (i % 1000 < 250) {
+      plain.push_back(0);
+    } else {
+      plain.push_back((i * 2654435761ull) % (1ull << ((i / 37) % 61)));
+    }
+  }
+  std::vector<uint64_t> encoded(plain.size());
+  Simple8bCode::encode(plain.data(), plain.size(), encoded.data());
+  for (size_t nofElements : {0ul, 1ul, 17ul, 240ul, 1001ul, plain.size()}) {
+    std::vector<uint64_t> expected(nofElements + 239);
+    Simple8bCode::decodeWithSelectorTable(encoded.data(), nofElements,
+                                          expected.data());
+    std::vector<uint64_t> decoded(nofElements + 239);
+    Simple8bCode::decode(encoded.data(), nofElements, decoded.data());
+    for (size_t i = 0; i < nofElements; ++i) {
+      ASSERT_EQ(plain[i], expected[i]);
+      ASSERT_EQ(plain[i], decoded[i]);
+    }
+
+    // With a conversion function.
+    auto timesTwo = [](uint64_t x) { return 2 * x; };
+    std::vector<uint64_t> converted(nofElements + 239);
+    Simple8bCode::decode(encoded.data(), nofElements, converted.data(),
+                         timesTwo);
+    for (size_t i = 0; i < nofElements; ++i) {
+      ASSERT_EQ(2 * plain[i], converted[i]);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Simple8bTest, decodeGaps) {
+  // Gaps of different sizes, including long streaks of zero gaps.
+  std::vector<uint64_t> gaps;
+  for (size_t i = 0; i < 3000; ++i) {
+    gaps.push_back(i % 500 < 200 ? 0 : (i * 7) % (1ull << (i % 20)));
+  }
+  std::vector<uint64_t> encoded(gaps.size());
+  Simple8bCode::encode(gaps.data(), gaps.size(), encoded.data());
+  for (uint64_t base : {0ull, 42ull}) {
+    for (size_t nofElements : {0ul, 1ul, 3ul, 5ul, 100ul, gaps.size()}) {
+      std::vector<uint64_t> decoded(nofElements + 239);
+      Simple8bCode::decodeGaps(encoded.data(), nofElements, decoded.data(),
+                               base);
+      uint64_t expected = base;
+      for (size_t i = 0; i < nofElements; ++i) {
+        expected += gaps[i];
+        ASSERT_EQ(expected, decoded[i]) << i;
+      }
+    }
+  }
+}
 }  // namespace ad_utility
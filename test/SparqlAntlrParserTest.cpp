@@ -585,7 +585,10 @@ TEST(SparqlParser, DataBlock) {
   auto expectDataBlockFails = ExpectParseFails<&Parser::dataBlock>();
   expectDataBlock("?test { \"foo\" }",
                   m::Values({Var{"?test"}}, {{lit("\"foo\"")}}));
-  expectDataBlock("?test { 10.0 }", m::Values({Var{"?test"}}, {{10.0}}));
+  expectDataBlock(
+      "?test { 10.0 }",
+      m::Values({Var{"?test"}}, {{Decimal::parse("10.0").value()}}));
+  expectDataBlock("?test { 1e1 }", m::Values({Var{"?test"}}, {{10.0}}));
   expectDataBlock("?test { UNDEF }",
                   m::Values({Var{"?test"}}, {{TripleComponent::UNDEF{}}}));
   expectDataBlock("?test { false true }",
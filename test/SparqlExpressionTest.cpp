@@ -9,6 +9,7 @@
 
 #include "./SparqlExpressionTestHelpers.h"
 #include "./util/GTestHelpers.h"
+#include "./util/TripleComponentTestHelpers.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
 #include "engine/sparqlExpressions/GroupConcatExpression.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
@@ -579,6 +580,63 @@ TEST(SparqlExpression, binaryStringOperations) {
       S{"", "x", "", "ullo", "ll", "Hällo", "Hällox", "l"});
 }
 
+// _____________________________________________________________________________________
+TEST(SparqlExpression, stringFiltersOnVariables) {
+  auto F = Id::makeFromBool(false);
+  auto T = Id::makeFromBool(true);
+  auto lit = ad_utility::testing::tripleComponentLiteral;
+  auto test = [&](auto makeExpression, std::string variable,
+                  std::string pattern, bool childAsStr, const Ids& expected,
+                  source_location l = source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    TestContext ctx;
+    SparqlExpression::Ptr child =
+        std::make_unique<VariableExpression>(Variable{std::move(variable)});
+    if (childAsStr) {
+      child = makeStrExpression(std::move(child));
+    }
+    auto expression = makeExpression(
+        std::move(child), std::make_unique<StringLiteralExpression>(
+                              lit(absl::StrCat("\"", pattern, "\""))));
+    auto result = expression->evaluate(&ctx.context);
+    EXPECT_THAT(std::get<VectorWithMemoryLimit<Id>>(result),
+                ::testing::ElementsAreArray(expected));
+  };
+  auto testAll = [&]() {
+    // ?vocab column is "Beta", "alpha", "älpha"
+    test(&makeContainsExpression, "?vocab", "lph", false, {F, T, T});
+    test(&makeStrStartsExpression, "?vocab", "al", false, {F, T, F});
+    // ?everything column is <notInVocabC>, "alpha", UNDEF. Like for the other
+    // string functions, IRIs and numbers are converted to strings, also
+    // without `STR()`.
+    test(&makeContainsExpression, "?everything", "InVocab", false, {T, F, U});
+    test(&makeContainsExpression, "?everything", "InVocab", true, {T, F, U});
+    // ?mixed column is 1, -0.1, <x>
+    test(&makeStrStartsExpression, "?mixed", "x", false, {F, F, T});
+    test(&makeStrStartsExpression, "?mixed", "x", true, {F, F, T});
+  };
+  testAll();
+  // The same with the precomputed matches of the complete vocabulary.
+  auto previousFraction =
+      RuntimeParameters().get<"vocabulary-matches-min-input-fraction">();
+  RuntimeParameters().set<"vocabulary-matches-min-input-fraction">(0.0);
+  testAll();
+
+  // The scan of the vocabulary can be cancelled.
+  {
+    TestContext ctx;
+    ctx.context._cancellationHandle->cancel(
+        ad_utility::CancellationState::MANUAL);
+    auto expression = makeContainsExpression(
+        std::make_unique<VariableExpression>(Variable{"?vocab"}),
+        std::make_unique<StringLiteralExpression>(lit("\"notCached\"")));
+    EXPECT_THROW(expression->evaluate(&ctx.context),
+                 ad_utility::CancellationException);
+  }
+  RuntimeParameters().set<"vocabulary-matches-min-input-fraction">(
+      previousFraction);
+}
+
 // ______________________________________________________________________________
 static auto checkSubstr =
     std::bind_front(testNaryExpression, makeSubstrExpression);
@@ -2,6 +2,8 @@
 //                  Chair of Algorithms and Data Structures.
 //  Author: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 
+#include "absl/cleanup/cleanup.h"
+#include "engine/sparqlExpressions/ParallelEvaluation.h"
 #include "engine/sparqlExpressions/SparqlExpressionTypes.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -39,3 +41,54 @@ TEST(SparqlExpressionTypes, printIdOrString) {
   PrintTo(idOrString, &str);
   ASSERT_EQ(str.str(), "bimm");
 }
+
+// _____________________________________________________________________________
+TEST(SparqlExpressionTypes, evaluateInChunks) {
+  using sparqlExpression::detail::evaluateInChunks;
+  auto identity = [](size_t begin, size_t end) {
+    return std::pair{begin, end};
+  };
+  auto previousNumThreads =
+      RuntimeParameters().get<"parallel-expression-num-threads">();
+  auto previousMinInputSize =
+      RuntimeParameters().get<"parallel-expression-min-input-size">();
+  auto cleanup =
+      absl::Cleanup{[previousNumThreads, previousMinInputSize]() {
+        RuntimeParameters().set<"parallel-expression-num-threads">(
+            previousNumThreads);
+        RuntimeParameters().set<"parallel-expression-min-input-size">(
+            previousMinInputSize);
+      }};
+  // Below the minimal input size, there is a single chunk.
+  RuntimeParameters().set<"parallel-expression-num-threads">(4);
+  RuntimeParameters().set<"parallel-expression-min-input-size">(100);
+  EXPECT_THAT(evaluateInChunks(99, identity),
+              ::testing::ElementsAre(std::pair{0u, 99u}));
+  EXPECT_THAT(evaluateInChunks(0, identity),
+              ::testing::ElementsAre(std::pair{0u, 0u}));
+
+  // Otherwise the chunks are consecutive and cover the complete input.
+  for (size_t numRows : {100u, 101u, 1000u, 12345u}) {
+    auto chunks = evaluateInChunks(numRows, identity);
+    ASSERT_GT(chunks.size(), 1u);
+    EXPECT_EQ(chunks.front().first, 0u);
+    EXPECT_EQ(chunks.back().second, numRows);
+    for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+      EXPECT_LT(chunks[i].first, chunks[i].second);
+      EXPECT_EQ(chunks[i].second, chunks[i + 1].first);
+    }
+  }
+
+  // Exceptions are propagated.
+  auto throwing = [](size_t begin, size_t) {
+    if (begin > 0) {
+      throw std::runtime_error("chunk failed");
+    }
+    return begin;
+  };
+  EXPECT_THROW(evaluateInChunks(1000, throwing), std::runtime_error);
+
+  // With a single thread, there is a single chunk.
+  RuntimeParameters().set<"parallel-expression-num-threads">(1);
+  EXPECT_EQ(evaluateInChunks(1000, identity).size(), 1u);
+}
@@ -0,0 +1,135 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../src/index/TrigramIndex.h"
+#include "../src/util/File.h"
+#include "absl/strings/str_cat.h"
+#include "util/MemorySize/MemorySize.h"
+
+using ::testing::ElementsAre;
+using V = std::vector<std::string>;
+using namespace ad_utility::memory_literals;
+
+namespace {
+// The words of a small vocabulary, as they are stored in the vocabulary.
+const std::vector<std::string> words{
+    "\"Berlin\"@de",  "<http://example.org/berlin>", "\"Bern\"",
+    "\"Oberlin\"",    "\"Brandenburg\"",             "\"ab\"",
+    "\"Düsseldorf\"", "\"Berliner Mauer\"@en"};
+
+// Build the index for the `words` in the file with the given `filename` and
+// open it. The file can already be deleted while the index is still in use.
+TrigramIndex createIndex(const std::vector<std::string>& words,
+                         const std::string& filename,
+                         ad_utility::MemorySize memoryLimit = 1_GB) {
+  {
+    TrigramIndex::Builder builder{filename, memoryLimit,
+                                  ad_utility::makeUnlimitedAllocator<Id>()};
+    for (const auto& word : words) {
+      builder.push(word);
+    }
+    std::move(builder).finish();
+  }
+  TrigramIndex index;
+  index.readFromFile(filename);
+  return index;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getTrigrams) {
+  using T = TrigramIndex::Trigram;
+  auto trigram = [](char a, char b, char c) {
+    return (T{static_cast<uint8_t>(a)} << 16) |
+           (T{static_cast<uint8_t>(b)} << 8) | T{static_cast<uint8_t>(c)};
+  };
+  EXPECT_TRUE(TrigramIndex::getTrigrams("").empty());
+  EXPECT_TRUE(TrigramIndex::getTrigrams("ab").empty());
+  EXPECT_THAT(TrigramIndex::getTrigrams("aBc"),
+              ElementsAre(trigram('a', 'b', 'c')));
+  // Duplicates are removed and the result is sorted.
+  EXPECT_THAT(TrigramIndex::getTrigrams("abab"),
+              ElementsAre(trigram('a', 'b', 'a'), trigram('b', 'a', 'b')));
+  EXPECT_EQ(TrigramIndex::getTrigrams("ABAB"),
+            TrigramIndex::getTrigrams("abab"));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, getCandidates) {
+  std::string filename = "trigramIndexTest.getCandidates.dat";
+  auto index = createIndex(words, filename);
+  ad_utility::deleteFile(filename);
+  ASSERT_EQ(index.numWords(), words.size());
+  EXPECT_THAT(index.getCandidates(V{"berlin"}).value(),
+              ElementsAre(0, 1, 3, 7));
+  EXPECT_THAT(index.getCandidates(V{"BERL"}).value(), ElementsAre(0, 1, 3, 7));
+  EXPECT_THAT(index.getCandidates(V{"ber", "mauer"}).value(), ElementsAre(7));
+  // The trigrams are only a necessary condition.
+  EXPECT_THAT(index.getCandidates(V{"berlinerl"}).value(), ElementsAre(7));
+  EXPECT_THAT(index.getCandidates(V{"üss"}).value(), ElementsAre(6));
+  // The quotes, language tags, and angle brackets are not indexed.
+  EXPECT_TRUE(index.getCandidates(V{"n\"@"}).value().empty());
+  EXPECT_TRUE(index.getCandidates(V{"<ht"}).value().empty());
+  EXPECT_TRUE(index.getCandidates(V{"xyz"}).value().empty());
+  // No trigrams, no candidates.
+  EXPECT_FALSE(index.getCandidates(V{}).has_value());
+  EXPECT_FALSE(index.getCandidates(V{"ab", ""}).has_value());
+
+  EXPECT_EQ(index.getNumCandidatesUpperBound(V{"berlin"}), 4u);
+  EXPECT_EQ(index.getNumCandidatesUpperBound(V{"ber", "mauer"}), 1u);
+  EXPECT_EQ(index.getNumCandidatesUpperBound(V{"xyz"}), 0u);
+  EXPECT_FALSE(index.getNumCandidatesUpperBound(V{"ab"}).has_value());
+
+  EXPECT_TRUE(index.isLiteral(0));
+  EXPECT_FALSE(index.isLiteral(1));
+  EXPECT_TRUE(index.isLiteral(7));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, longPostingLists) {
+  // Many words, s.t. the posting lists span many codewords of the
+  // `Simple8bCode` and contain large gaps.
+  std::vector<std::string> manyWords;
+  for (size_t i = 0; i < 100'000; ++i) {
+    manyWords.push_back(i % 7 == 0 ? absl::StrCat("\"label ", i, " seven\"")
+                                   : absl::StrCat("<http://x/", i, ">"));
+  }
+  manyWords.push_back("\"seven\"");
+  // The memory limit is smaller than the more than 20 MB of pairs of trigram
+  // and word index, so the pairs are sorted externally in several blocks.
+  std::string filename = "trigramIndexTest.longPostingLists.dat";
+  auto index = createIndex(manyWords, filename, 10_MB);
+  ad_utility::deleteFile(filename);
+  auto candidates = index.getCandidates(V{"seven"}).value();
+  ASSERT_EQ(candidates.size(), 100'000 / 7 + 2);
+  for (size_t i = 0; i + 1 < candidates.size(); ++i) {
+    ASSERT_EQ(candidates[i], 7 * i);
+  }
+  EXPECT_EQ(candidates.back(), 100'000u);
+  EXPECT_THAT(index.getCandidates(V{"label 9996 "}).value(),
+              ElementsAre(9996));
+}
+
+// _____________________________________________________________________________
+TEST(TrigramIndex, readFromFile) {
+  std::string filename = "trigramIndexTest.readFromFile.dat";
+  auto index = createIndex(words, filename);
+  // A second index that is opened from the same file.
+  TrigramIndex index2;
+  index2.readFromFile(filename);
+  ad_utility::deleteFile(filename);
+  EXPECT_EQ(index2.numWords(), words.size());
+  EXPECT_EQ(index2.getCandidates(V{"berlin"}),
+            index.getCandidates(V{"berlin"}));
+  EXPECT_EQ(index2.isLiteral(1), index.isLiteral(1));
+
+  // An index without any trigrams.
+  auto emptyIndex = createIndex(V{"\"ab\"", "<c>"}, filename);
+  ad_utility::deleteFile(filename);
+  EXPECT_EQ(emptyIndex.numWords(), 2u);
+  EXPECT_TRUE(emptyIndex.getCandidates(V{"abc"}).value().empty());
+  EXPECT_TRUE(emptyIndex.isLiteral(0));
+}
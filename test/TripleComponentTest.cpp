@@ -110,6 +110,9 @@ TEST(TripleComponent, toRdfLiteral) {
             R"("42"^^<http://www.w3.org/2001/XMLSchema#int>)");
 
   object = -43.3;
+  ASSERT_EQ(object.toRdfLiteral(),
+            R"("-43.3"^^<http://www.w3.org/2001/XMLSchema#decimal>)");
+  object = Decimal::parse("-43.30").value();
   ASSERT_EQ(object.toRdfLiteral(),
             R"("-43.3"^^<http://www.w3.org/2001/XMLSchema#decimal>)");
   object = DateOrLargeYear{123456, DateOrLargeYear::Type::Year};
@@ -122,6 +125,9 @@ TEST(TripleComponent, toValueIdIfNotString) {
   ASSERT_EQ(tc.toValueIdIfNotString().value(), I(42));
   tc = 131.4;
   ASSERT_EQ(tc.toValueIdIfNotString().value(), D(131.4));
+  auto decimal = Decimal::parse("131.4").value();
+  tc = decimal;
+  ASSERT_EQ(tc.toValueIdIfNotString().value(), Id::makeFromDecimal(decimal));
 
   DateOrLargeYear date{123456, DateOrLargeYear::Type::Year};
   tc = date;
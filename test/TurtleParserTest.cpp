@@ -202,7 +202,7 @@ TEST(TurtleParserTest, rdfLiteral) {
   literals.emplace_back(R"("42.1234"^^)"s + "<" + XSD_DOUBLE_TYPE + ">");
   expected.emplace_back(42.1234);
   literals.push_back(R"("-142.321"^^)"s + "<" + XSD_DECIMAL_TYPE + ">");
-  expected.emplace_back(-142.321);
+  expected.emplace_back(Decimal::parse("-142.321").value());
   literals.push_back(R"("-142321"^^)"s + "<" + XSD_INT_TYPE + ">");
   expected.emplace_back(-142321);
   literals.push_back(R"("+144321"^^)"s + "<" + XSD_INTEGER_TYPE + ">");
@@ -366,9 +366,12 @@ TEST(TurtleParserTest, numericLiteral) {
   std::vector<std::string> literals{"2",   "-2",     "42.209",   "-42.239",
                                     ".74", "2.3e12", "2.34E-14", "-0.3e2",
                                     "3E2", "-14E-1", ".1E1",     "-.2E0"};
-  std::vector<TripleComponent> expected{2,   -2,     42.209,   -42.239,
-                                        .74, 2.3e12, 2.34e-14, -0.3e2,
-                                        3e2, -14e-1, .1e1,     -.2e0};
+  auto dec = [](std::string_view input) {
+    return TripleComponent{Decimal::parse(input).value()};
+  };
+  std::vector<TripleComponent> expected{
+      2,      -2,  dec("42.209"), dec("-42.239"), dec(".74"), 2.3e12,
+      2.34e-14, -0.3e2, 3e2,      -14e-1,         .1e1,       -.2e0};
 
   auto checkRe2 = checkParseResult<Re2Parser, &Re2Parser::numericLiteral>;
   auto checkCtre = checkParseResult<CtreParser, &CtreParser::numericLiteral>;
@@ -609,10 +612,91 @@ TEST(TurtleParserTest, collection) {
   runCommonTests(checkParseResult<CtreParser, &CtreParser::collection, 22>);
 }
 
+// _______________________________________________________________________
+TEST(TurtleParserTest, nTriple) {
+  auto runCommonTests = []<typename Parser>() {
+    auto check = checkParseResult<Parser, &Parser::nTriple>;
+    auto noFastPath = [](const std::string& input) {
+      EXPECT_FALSE((parseRule<Parser, &Parser::nTriple>(input).has_value()))
+          << input;
+    };
+    check("<s> <p> <o> .", "<o>", {},
+          std::vector<TurtleTriple>{{"<s>", "<p>", "<o>"}});
+    check("<s>\t<p>  <o>.\n<next>", "<o>", 13,
+          std::vector<TurtleTriple>{{"<s>", "<p>", "<o>"}});
+    check(R"(<s> <p> "a\"b\\" .)", lit(R"("a\"b\\")"));
+    check(R"(<s> <p> "chat"@en-US .)", lit(R"("chat")", "@en-US"));
+    check(R"(<s> <p> "42"^^<http://www.w3.org/2001/XMLSchema#int> .)", 42);
+    check(R"(<s> <p> "x"^^<http://example.org/type> .)",
+          lit(R"("x")", "^^<http://example.org/type>"));
+    // The IRIs are unescaped in the same way as in the general rules.
+    check(R"(<s\u0020> <p> <o> .)", "<o>", {},
+          std::vector<TurtleTriple>{{"<s >", "<p>", "<o>"}});
+
+    // Statements that are no (complete) N-Triples lines are left to the
+    // general rules.
+    noFastPath("_:b <p> <o> .");
+    noFastPath("<s> <p> _:b .");
+    noFastPath("<s> <p> 42 .");
+    noFastPath("<s> <p> <o> ; <p2> <o2> .");
+    noFastPath("<s> <p> <o>");
+    noFastPath("<s> <p> \"unterminated .");
+    noFastPath("<s> <p <o> .");
+    noFastPath("@prefix a: <bim> .");
+    noFastPath("a:s <p> <o> .");
+    // Raw newlines in literals and invalid characters in IRIs are left to the
+    // general rules, which report them as errors or handle them leniently.
+    noFastPath("<s> <p> \"multi\nline\" .");
+    noFastPath("<s> <p> \"multi\rline\" .");
+    noFastPath("<s> <p> <o{}> .");
+    noFastPath("<s|> <p> <o> .");
+    noFastPath("<s> <p^> <o> .");
+    noFastPath("<s> <p> <o\"> .");
+    noFastPath("<s> <p> <o`> .");
+    noFastPath("<s\x01> <p> <o> .");
+    noFastPath(R"(<s\n> <p> <o> .)");
+    noFastPath(R"(<s\u12> <p> <o> .)");
+    // The same checks for IRIs and literals that are longer than one block of
+    // the `NTriplesScanner`.
+    std::string longString(100, 'a');
+    check(absl::StrCat("<s> <p> <", longString, "> ."),
+          absl::StrCat("<", longString, ">"));
+    noFastPath(absl::StrCat("<s> <p> <", longString, " ", longString, "> ."));
+    noFastPath(
+        absl::StrCat("<s> <p> \"", longString, "\n", longString, "\" ."));
+  };
+  runCommonTests.template operator()<Re2Parser>();
+  runCommonTests.template operator()<CtreParser>();
+
+  // When `parseAsNTriples()` is set, the results have to be the same as
+  // without it, also for input that is not N-Triples.
+  auto parseAll = []<typename Parser>(const std::string& input,
+                                      bool parseAsNTriples) {
+    Parser parser;
+    parser.setBlankNodePrefixOnlyForTesting(0);
+    parser.parseAsNTriples() = parseAsNTriples;
+    parser.setInputStream(input);
+    return parser.parseAndReturnAllTriples();
+  };
+  std::string input = R"(@prefix x: <http://x.org/> .
+<s> <p> <o> .
+<s> <p> "lit"@en .
+<s> <p> "1999-12-31"^^<http://www.w3.org/2001/XMLSchema#date> .
+<s> <p> "true"^^<http://www.w3.org/2001/XMLSchema#boolean> .
+_:a <p> _:b .
+x:s x:p "a", "b" ; x:q [ x:r <o> ] .
+<s> <p> "escaped \" quote" .
+)";
+  EXPECT_EQ((parseAll.template operator()<Re2Parser>(input, true)),
+            (parseAll.template operator()<Re2Parser>(input, false)));
+  EXPECT_EQ((parseAll.template operator()<CtreParser>(input, true)),
+            (parseAll.template operator()<CtreParser>(input, false)));
+}
+
 // Sort a vector of triples to get a deterministic order for comparison.
 void sortTriples(std::vector<TurtleTriple>& triples) {
   auto toRef = [](const TurtleTriple& t) {
-    return std::tie(t.subject_, t.predicate_, t.object_.getString());
+    return std::tuple{t.subject_, t.predicate_, t.object_.toRdfLiteral()};
   };
   std::ranges::sort(triples, std::less{}, toRef);
 }
@@ -691,6 +775,44 @@ TEST(TurtleParserTest, TurtleStreamAndParallelParser) {
   ad_utility::deleteFile(filename);
 }
 
+// _______________________________________________________________________
+TEST(TurtleParserTest, NTriplesStreamAndParallelParser) {
+  std::string filename{"turtleParserNTriplesFastPath.dat"};
+  std::vector<TurtleTriple> expectedTriples;
+  {
+    auto of = ad_utility::makeOfstream(filename);
+    for (size_t i = 0; i < 1'000; ++i) {
+      auto subject = absl::StrCat("<", i / 1000, ">");
+      auto predicate = absl::StrCat("<", i / 100, ">");
+      auto object = absl::StrCat("\"", i, "\"");
+      of << subject << ' ' << predicate << ' ' << object << " .\n";
+      expectedTriples.emplace_back(subject, predicate, lit(object));
+    }
+  }
+  sortTriples(expectedTriples);
+
+  // Use a small buffer, s.t. many lines are split between two batches.
+  FILE_BUFFER_SIZE = 1000;
+  auto testWithParser = [&]<typename Parser>(bool useBatchInterface) {
+    Parser parser{filename, true};
+    std::vector<TurtleTriple> result;
+    if (useBatchInterface) {
+      while (auto batch = parser.getBatch()) {
+        std::ranges::move(batch.value(), std::back_inserter(result));
+      }
+    } else {
+      TurtleTriple next;
+      while (parser.getLine(next)) {
+        result.push_back(next);
+      }
+    }
+    sortTriples(result);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(expectedTriples));
+  };
+  forAllParsers(testWithParser);
+  ad_utility::deleteFile(filename);
+}
+
 // _______________________________________________________________________
 TEST(TurtleParserTest, emptyInput) {
   std::string filename{"turtleParserEmptyInput.dat"};
@@ -823,7 +945,7 @@ TEST(TurtleParserTest, stopParsingOnOutsideFailure) {
     }
     ad_utility::Timer t{ad_utility::Timer::Stopped};
     {
-      [[maybe_unused]] Parser parserChild{filename, 10ms};
+      [[maybe_unused]] Parser parserChild{filename, false, 10ms};
       t.cont();
     }
     EXPECT_LE(t.msecs(), 20ms);
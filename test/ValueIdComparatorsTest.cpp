@@ -21,7 +21,8 @@ TEST(ValueIdComparators, GetRangeForDatatype) {
                                   Datatype::Undefined,
                                   Datatype::LocalVocabIndex,
                                   Datatype::TextRecordIndex,
-                                  Datatype::WordVocabIndex};
+                                  Datatype::WordVocabIndex,
+                                  Datatype::Decimal};
   auto ids = makeRandomIds();
   std::sort(ids.begin(), ids.end(), compareByBits);
   for (auto datatype : datatypes) {
@@ -106,7 +107,7 @@ auto testGetRangesForId(auto begin, auto end, ValueId id,
 }
 
 // Test that `getRangesFromId` works correctly for `ValueId`s of the numeric
-// types (`Int` and `Double`)
+// types (`Int`, `Double`, and `Decimal`)
 TEST(ValueIdComparators, NumericTypes) {
   auto impl = [](Datatype datatype, auto isTypeMatching, auto applyComparator) {
     auto ids = makeRandomIds();
@@ -126,28 +127,27 @@ TEST(ValueIdComparators, NumericTypes) {
   };
   auto isTypeMatching = [&](ValueId id) {
     auto type = id.getDatatype();
-    return type == Datatype::Double || type == Datatype::Int;
+    return type == Datatype::Double || type == Datatype::Int ||
+           type == Datatype::Decimal;
   };
 
   auto applyComparator = [&](auto comparator, ValueId aId, ValueId bId) {
-    std::variant<int64_t, double> aValue, bValue;
-    if (aId.getDatatype() == Datatype::Double) {
-      aValue = aId.getDouble();
-    } else {
-      aValue = aId.getInt();
-    }
-    if (bId.getDatatype() == Datatype::Double) {
-      bValue = bId.getDouble();
-    } else {
-      bValue = bId.getInt();
-    }
-
-    return std::visit([&](auto a, auto b) { return comparator(a, b); }, aValue,
-                      bValue);
+    auto getValue = [](ValueId id) -> std::variant<int64_t, double, Decimal> {
+      if (id.getDatatype() == Datatype::Double) {
+        return id.getDouble();
+      } else if (id.getDatatype() == Datatype::Decimal) {
+        return id.getDecimal();
+      } else {
+        return id.getInt();
+      }
+    };
+    return std::visit([&](auto a, auto b) { return comparator(a, b); },
+                      getValue(aId), getValue(bId));
   };
 
   impl(Datatype::Double, isTypeMatching, applyComparator);
   impl(Datatype::Int, isTypeMatching, applyComparator);
+  impl(Datatype::Decimal, isTypeMatching, applyComparator);
 }
 
 // Test that `getRangesFromId` works correctly for the undefined ID.
@@ -276,6 +276,21 @@ TEST(ValueIdComparators, undefinedWithItself) {
   ASSERT_EQ(compareIds<CompareByType>(u, u, Comparison::GE), True);
 }
 
+// _______________________________________________________________________
+TEST(ValueIdComparators, compareByTypeIsTransitive) {
+  using enum ComparisonResult;
+  using enum ComparisonForIncompatibleTypes;
+  auto I = ad_utility::testing::IntId;
+  auto V = ad_utility::testing::VocabId;
+  auto Dec = Id::makeFromDecimal(Decimal::parse("2.5").value());
+  // All the numeric types come before the `VocabIndex`es, no matter which of
+  // them is smaller.
+  ASSERT_EQ(compareIds<CompareByType>(Dec, I(3), Comparison::LT), True);
+  ASSERT_EQ(compareIds<CompareByType>(I(3), V(0), Comparison::LT), True);
+  ASSERT_EQ(compareIds<CompareByType>(Dec, V(0), Comparison::LT), True);
+  ASSERT_EQ(compareIds<CompareByType>(V(0), Dec, Comparison::GT), True);
+}
+
 // _______________________________________________________________________
 TEST(ValueIdComparators, contractViolations) {
   auto u = ValueId::makeUndefined();
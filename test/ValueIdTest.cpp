@@ -294,6 +294,11 @@ TEST(ValueId, toDebugString) {
   test(ValueId::makeFromDate(
            DateOrLargeYear{123456, DateOrLargeYear::Type::Year}),
        "Date:123456");
+  test(ValueId::makeFromGeoPoint(GeoPoint{1.5, 2.0}), "GeoPoint:POINT(2 1.5)");
+  test(ValueId::makeFromDecimal(Decimal::parse("-1.50").value()),
+       "Decimal:-1.5");
+  test(ValueId::makeFromShortString(ShortString::fromContent("abc").value()),
+       "ShortString:\"abc\"");
   // make an ID with an invalid datatype
   ASSERT_ANY_THROW(test(ValueId::max(), "blim"));
 }
@@ -38,6 +38,11 @@ inline auto overflowingNBitGenerator =
 inline auto underflowingNBitGenerator =
     ad_utility::SlowRandomIntGenerator<int64_t>(
         std::numeric_limits<int64_t>::min(), ValueId::IntegerType::min() - 1);
+inline auto decimalUnitsGenerator = ad_utility::SlowRandomIntGenerator<int64_t>(
+    Decimal::minUnits, Decimal::maxUnits);
+// Decimals with a small absolute value, some of which are equal to integers.
+inline auto smallDecimalUnitsGenerator =
+    ad_utility::SlowRandomIntGenerator<int64_t>(-5'000'000, 5'000'000);
 
 // Some helper functions to convert uint64_t values directly to and from index
 // type `ValueId`s.
@@ -54,6 +59,10 @@ inline ValueId makeWordVocabId(uint64_t value) {
   return ValueId::makeFromWordVocabIndex(WordVocabIndex::make(value));
 }
 
+inline ValueId makeDecimalId(int64_t units) {
+  return ValueId::makeFromDecimal(Decimal::fromUnits(units));
+}
+
 inline uint64_t getVocabIndex(ValueId id) { return id.getVocabIndex().get(); }
 inline uint64_t getLocalVocabIndex(ValueId id) {
   return id.getLocalVocabIndex().get();
@@ -110,6 +119,12 @@ inline auto makeRandomIds = []() {
   addIdsFromGenerator(nonOverflowingNBitGenerator, &ValueId::makeFromInt, ids);
   addIdsFromGenerator(overflowingNBitGenerator, &ValueId::makeFromInt, ids);
   addIdsFromGenerator(underflowingNBitGenerator, &ValueId::makeFromInt, ids);
+  addIdsFromGenerator(decimalUnitsGenerator, &makeDecimalId, ids);
+  addIdsFromGenerator(smallDecimalUnitsGenerator, &makeDecimalId, ids);
+  for (int64_t i = -2; i <= 2; ++i) {
+    ids.push_back(ValueId::makeFromInt(i));
+    ids.push_back(makeDecimalId(i * Decimal::unitsPerOne));
+  }
 
   for (size_t i = 0; i < numElements; ++i) {
     ids.push_back(ValueId::makeUndefined());
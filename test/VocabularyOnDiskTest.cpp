@@ -159,3 +159,37 @@ TEST(VocabularyOnDisk, ErrorOnNonAscendingIds) {
 TEST(VocabularyOnDisk, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
+
+TEST(VocabularyOnDisk, GetWords) {
+  std::vector<std::string> words{"game", "4", "nobody", "33", "alpha"};
+  std::vector<uint64_t> ids{2, 4, 8, 16, 42};
+  // A long word that exceeds the maximal size of a single read.
+  words.emplace_back(VocabularyOnDisk::MAX_NUM_BYTES_PER_READ + 5, 'x');
+  ids.push_back(43);
+  using O = std::optional<std::string>;
+  auto testVocabulary = [&](const VocabularyOnDisk& vocabulary) {
+    std::vector<uint64_t> requested{0, 2, 2, 3, 8, 16, 42, 43, 44};
+    auto result = vocabulary.getWords(requested);
+    std::vector<O> expected{std::nullopt, O{"game"},       O{"game"},
+                            std::nullopt, O{"nobody"},     O{"33"},
+                            O{"alpha"},   O{words.back()}, std::nullopt};
+    EXPECT_EQ(result, expected);
+    EXPECT_TRUE(vocabulary.getWords({}).empty());
+    // The batched access is consistent with the access operator.
+    std::vector<uint64_t> allIds = ids;
+    result = vocabulary.getWords(allIds);
+    for (size_t i = 0; i < allIds.size(); ++i) {
+      EXPECT_EQ(result[i], vocabulary[allIds[i]]);
+    }
+  };
+  VocabularyCreator creator1{"GetWords1" + suffix};
+  testVocabulary(creator1.createVocabularyImpl(words, ids));
+  VocabularyCreator creator2{"GetWords2" + suffix};
+  testVocabulary(creator2.createVocabularyFromDiskImpl(words, ids));
+
+  VocabularyCreator creator3{"GetWords3" + suffix};
+  auto empty = creator3.createVocabularyFromDiskImpl({});
+  std::vector<uint64_t> requested{0, 3};
+  EXPECT_EQ(empty.getWords(requested),
+            (std::vector<O>{std::nullopt, std::nullopt}));
+}
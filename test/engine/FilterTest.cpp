@@ -0,0 +1,80 @@
+//  Copyright 2024, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../IndexTestHelpers.h"
+#include "engine/Filter.h"
+#include "engine/IndexScan.h"
+#include "engine/QueryPlanner.h"
+#include "global/Constants.h"
+#include "parser/SparqlParser.h"
+
+using namespace ad_utility::testing;
+
+// _____________________________________________________________________________
+TEST(Filter, geoBoundingBoxRestrictsScan) {
+  // Two points around Freiburg, two points that are far away, and a literal
+  // that is not a point and therefore never matches.
+  std::string turtle;
+  auto addPoint = [&turtle](std::string_view subject, std::string_view point) {
+    absl::StrAppend(&turtle, subject, " <location> \"POINT(", point, ")\"^^<",
+                    GEO_WKT_LITERAL, "> . ");
+  };
+  addPoint("<a>", "7.85 47.99");
+  addPoint("<b>", "7.9 48.01");
+  addPoint("<c>", "13.4 52.52");
+  addPoint("<d>", "-73.98 40.75");
+  turtle += "<e> <location> \"abc\" .";
+  auto qec = getQec(turtle);
+  auto getId = makeGetId(qec->getIndex());
+
+  auto previousMaxNumRanges =
+      RuntimeParameters().get<"geo-filter-max-num-ranges">();
+  auto previousFactor =
+      RuntimeParameters().get<"replanning-min-deviation-factor">();
+  // A restricted scan must not trigger the planning of the query again.
+  RuntimeParameters().set<"replanning-min-deviation-factor">(1.5);
+  qec->_replanOnSizeDeviation = true;
+  auto cleanup = absl::Cleanup{[&]() {
+    RuntimeParameters().set<"geo-filter-max-num-ranges">(previousMaxNumRanges);
+    RuntimeParameters().set<"replanning-min-deviation-factor">(previousFactor);
+    qec->_replanOnSizeDeviation = false;
+  }};
+
+  const std::string query = absl::StrCat(
+      "PREFIX geof: ", GEOF_PREFIX.second,
+      "> PREFIX geo: <http://www.opengis.net/ont/geosparql#> "
+      "SELECT ?x ?p WHERE { ?x <location> ?p FILTER("
+      "geof:distance(?p, \"POINT(7.85 47.99)\"^^geo:wktLiteral) <= 20) }");
+  for (size_t maxNumRanges : {size_t{0}, size_t{64}}) {
+    RuntimeParameters().set<"geo-filter-max-num-ranges">(maxNumRanges);
+    qec->getQueryTreeCache().clearAll();
+    ParsedQuery pq = SparqlParser::parseQuery(query);
+    auto qet = QueryPlanner{qec}.createExecutionTree(pq);
+    auto* filter = dynamic_cast<Filter*>(qet.getRootOperation().get());
+    ASSERT_NE(filter, nullptr);
+    const auto& scan = *filter->getChildren().at(0)->getRootOperation();
+    ASSERT_NE(dynamic_cast<const IndexScan*>(&scan), nullptr);
+
+    auto result = qet.getResult();
+    auto subjects = result->idTable().getColumn(
+        qet.getVariableColumn(Variable{"?x"}));
+    EXPECT_THAT(subjects, ::testing::UnorderedElementsAre(getId("<a>"),
+                                                          getId("<b>")));
+    bool isRestricted = maxNumRanges > 0;
+    EXPECT_EQ(filter->runtimeInfo().details_.contains("num-geo-ranges"),
+              isRestricted);
+    EXPECT_EQ(scan.wasRestrictedAfterPlanning(), isRestricted);
+    EXPECT_EQ(absl::StrContains(scan.getCacheKey(), "RANGES"), isRestricted);
+    if (isRestricted) {
+      // The scan has read only the two points around Freiburg and the literal
+      // that is not a point.
+      EXPECT_EQ(scan.runtimeInfo().numRows_, 3u);
+    }
+  }
+}
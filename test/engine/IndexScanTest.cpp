@@ -6,6 +6,7 @@
 
 #include "../IndexTestHelpers.h"
 #include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
 #include "engine/IndexScan.h"
 #include "parser/ParsedQuery.h"
 
@@ -344,3 +345,164 @@ TEST(IndexScan, additionalColumn) {
   AD_EXPECT_THROW_WITH_MESSAGE(scan.computeResultOnlyForTesting(),
                                ::testing::ContainsRegex("IdTable.h"));
 }
+
+// _____________________________________________________________________________
+TEST(IndexScan, estimateJoinSizeBySampling) {
+  // Two triples per block, and a new block for each relation (see above), so
+  // the <p> relation has the blocks `[<a>, <a>], [<a>, <b>], [<b>]`.
+  std::string kg =
+      "<a> <p> <A>. <a> <p> <A2>. "
+      "<a> <p> <A3> . <b> <p> <B>. "
+      "<b> <p> <B2> ."
+      "<b> <q> <xb>. <b> <q> <xb2> . <c> <q> <xc> .";
+  auto qec = getQec(kg);
+  SparqlTriple xpy{Tc{Var{"?x"}}, "<p>", Tc{Var{"?y"}}};
+  SparqlTriple xqz{Tc{Var{"?x"}}, "<q>", Tc{Var{"?z"}}};
+  IndexScan s1{qec, Permutation::PSO, xpy};
+  IndexScan s2{qec, Permutation::PSO, xqz};
+
+  auto setNumBlocks = [](size_t numBlocks) {
+    RuntimeParameters().set<"join-sampling-num-blocks">(numBlocks);
+  };
+  absl::Cleanup cleanup{
+      [&setNumBlocks,
+       previous = RuntimeParameters().get<"join-sampling-num-blocks">()] {
+        setNumBlocks(previous);
+      }};
+  // With all the blocks sampled, the estimate is exact.
+  setNumBlocks(100);
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s1, s2), 4u);
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s2, s1), 4u);
+  // Only the middle block of <p> is sampled, which has one of the two <b>s of
+  // the five rows of <p>, so the estimate is `1 * 2 * 5 / 2`.
+  setNumBlocks(1);
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s1, s2), 5u);
+  setNumBlocks(0);
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s1, s2), std::nullopt);
+
+  // Scans for predicates that don't exist.
+  setNumBlocks(8);
+  SparqlTriple xrz{Tc{Var{"?x"}}, "<r>", Tc{Var{"?z"}}};
+  IndexScan s3{qec, Permutation::PSO, xrz};
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s1, s3), 0u);
+
+  // All the rows have the same subject, so each block of `<r>` matches all
+  // the blocks of `<t>`. Only some of them are read, and the result is
+  // extrapolated.
+  auto qec2 = getQec(
+      "<a> <r> <1> . <a> <r> <2> . <a> <r> <3> . <a> <r> <4> . <a> <r> <5> . "
+      "<a> <r> <6> . <a> <t> <1> . <a> <t> <2> . <a> <t> <3> . <a> <t> <4> .");
+  SparqlTriple xry{Tc{Var{"?x"}}, "<r>", Tc{Var{"?y"}}};
+  SparqlTriple xtz{Tc{Var{"?x"}}, "<t>", Tc{Var{"?z"}}};
+  IndexScan s4{qec2, Permutation::PSO, xry};
+  IndexScan s5{qec2, Permutation::PSO, xtz};
+  setNumBlocks(100);
+  EXPECT_EQ(IndexScan::estimateJoinSizeBySampling(s4, s5), 24u);
+  setNumBlocks(1);
+  auto estimate = IndexScan::estimateJoinSizeBySampling(s4, s5);
+  ASSERT_TRUE(estimate.has_value());
+  EXPECT_GE(estimate.value(), 12u);
+  EXPECT_LE(estimate.value(), 48u);
+
+  // The sampling is aborted if the query is cancelled.
+  qec->getQueryTreeCache().clearAll();
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  handle->cancel(ad_utility::CancellationState::MANUAL);
+  s1.recursivelySetCancellationHandle(handle);
+  EXPECT_THROW(IndexScan::estimateJoinSizeBySampling(s1, s2),
+               ad_utility::CancellationException);
+}
+
+// _____________________________________________________________________________
+TEST(IndexScan, semiJoinFilter) {
+  std::string kg =
+      "<a> <p> <A>. <a> <p> <A2>. "
+      "<a> <p> <A3> . <b> <p> <B>. "
+      "<b> <p> <B2> . <c> <p> <C> .";
+  auto qec = getQec(kg);
+  auto getId = makeGetId(qec->getIndex());
+  auto makeFilter = [&getId](const std::vector<std::string>& values) {
+    auto filter = std::make_shared<std::vector<Id>>();
+    for (const auto& value : values) {
+      filter->push_back(getId(value));
+    }
+    std::ranges::sort(*filter);
+    return filter;
+  };
+  SparqlTriple xpy{Tc{Var{"?x"}}, "<p>", Tc{Var{"?y"}}};
+  IndexScan scan{qec, Permutation::PSO, xpy};
+  auto cacheKey = scan.getCacheKey();
+
+  // Only the first column can be restricted.
+  EXPECT_FALSE(scan.pushDownSemiJoinFilter(Var{"?y"}, makeFilter({"<A>"})));
+  EXPECT_FALSE(scan.pushDownSemiJoinFilter(Var{"?z"}, makeFilter({"<a>"})));
+  EXPECT_EQ(scan.getCacheKey(), cacheKey);
+
+  EXPECT_TRUE(
+      scan.pushDownSemiJoinFilter(Var{"?x"}, makeFilter({"<a>", "<c>"})));
+  EXPECT_NE(scan.getCacheKey(), cacheKey);
+  auto result = scan.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector({{getId("<a>"), getId("<A>")},
+                                   {getId("<a>"), getId("<A2>")},
+                                   {getId("<a>"), getId("<A3>")},
+                                   {getId("<c>"), getId("<C>")}}));
+  // A second filter is intersected with the first one.
+  EXPECT_TRUE(
+      scan.pushDownSemiJoinFilter(Var{"?x"}, makeFilter({"<b>", "<c>"})));
+  result = scan.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(),
+            makeIdTableFromVector({{getId("<c>"), getId("<C>")}}));
+  // The block of <b> doesn't have to be read.
+  EXPECT_EQ(scan.runtimeInfo().details_["num-blocks-read"], 1);
+
+  // A scan with a LIMIT can't be restricted.
+  IndexScan scanWithLimit{qec, Permutation::PSO, xpy};
+  scanWithLimit.setLimit({2});
+  EXPECT_FALSE(
+      scanWithLimit.pushDownSemiJoinFilter(Var{"?x"}, makeFilter({"<a>"})));
+
+  // The values of the filter don't exist in the relation.
+  IndexScan scan2{qec, Permutation::PSO, xpy};
+  EXPECT_TRUE(scan2.pushDownSemiJoinFilter(Var{"?x"}, makeFilter({"<p>"})));
+  EXPECT_TRUE(scan2.computeResultOnlyForTesting().idTable().empty());
+}
+
+// _____________________________________________________________________________
+TEST(IndexScan, restrictFirstColumnToRanges) {
+  std::string kg =
+      "<a> <p> 1 . <b> <p> 2 . <c> <p> 3 . "
+      "<d> <p> 4 . <e> <p> 5 . <f> <p> 6 .";
+  auto qec = getQec(kg);
+  auto getId = makeGetId(qec->getIndex());
+  auto I = IntId;
+  SparqlTriple xpy{Tc{Var{"?x"}}, "<p>", Tc{Var{"?y"}}};
+  IndexScan scan{qec, Permutation::POS, xpy};
+  auto cacheKey = scan.getCacheKey();
+
+  // Only the first column can be restricted.
+  EXPECT_FALSE(scan.canBeRestrictedToRanges(Var{"?x"}));
+  EXPECT_FALSE(scan.restrictFirstColumnToRanges(Var{"?x"}, {{I(1), I(3)}}));
+  EXPECT_EQ(scan.getCacheKey(), cacheKey);
+
+  EXPECT_TRUE(scan.canBeRestrictedToRanges(Var{"?y"}));
+  EXPECT_TRUE(scan.restrictFirstColumnToRanges(
+      Var{"?y"}, {{I(1), I(3)}, {I(5), I(6)}}));
+  EXPECT_NE(scan.getCacheKey(), cacheKey);
+  auto result = scan.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{I(1), getId("<a>")},
+                                                     {I(2), getId("<b>")},
+                                                     {I(5), getId("<e>")}}));
+  // Further ranges are intersected with the previous ones.
+  EXPECT_TRUE(scan.restrictFirstColumnToRanges(Var{"?y"}, {{I(2), I(6)}}));
+  result = scan.computeResultOnlyForTesting();
+  EXPECT_EQ(result.idTable(), makeIdTableFromVector({{I(2), getId("<b>")},
+                                                     {I(5), getId("<e>")}}));
+  EXPECT_TRUE(scan.restrictFirstColumnToRanges(Var{"?y"}, {{I(3), I(5)}}));
+  EXPECT_TRUE(scan.computeResultOnlyForTesting().idTable().empty());
+
+  // A scan with a LIMIT can't be restricted.
+  IndexScan scanWithLimit{qec, Permutation::POS, xpy};
+  scanWithLimit.setLimit({2});
+  EXPECT_FALSE(scanWithLimit.canBeRestrictedToRanges(Var{"?y"}));
+}
@@ -0,0 +1,118 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "../IndexTestHelpers.h"
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/MaterializedView.h"
+#include "engine/Values.h"
+#include "parser/ParsedQuery.h"
+
+using namespace ad_utility::testing;
+
+namespace {
+using Var = Variable;
+
+// Compare the `IdTable`s and the local vocabularies of two results.
+void expectEqualResults(const ResultTable& a, const ResultTable& b) {
+  EXPECT_EQ(a.idTable(), b.idTable());
+  EXPECT_EQ(a.sortedBy(), b.sortedBy());
+  ASSERT_EQ(a.localVocab().size(), b.localVocab().size());
+  for (size_t i = 0; i < a.localVocab().size(); ++i) {
+    auto index = LocalVocabIndex::make(i);
+    EXPECT_EQ(a.localVocab().getWord(index), b.localVocab().getWord(index));
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(MaterializedView, computeWriteAndRead) {
+  auto qec = getQec("<a> <p> <b> . <a> <p> <c> . <b> <p> <c> . <c> <q> <a> .");
+  // A `VALUES` clause with an IRI that is not contained in the index, such
+  // that the result has a local vocabulary.
+  parsedQuery::SparqlValues values;
+  values._variables = {Var{"?x"}, Var{"?y"}};
+  values._values.push_back({TripleComponent{"<a>"}, TripleComponent{"<new>"}});
+  values._values.push_back({TripleComponent{"<b>"}, TripleComponent{"<c>"}});
+  auto qet = ad_utility::makeExecutionTree<Values>(qec, values);
+
+  auto view = MaterializedView::compute("values", "SELECT ...", *qet);
+  EXPECT_EQ(view.name(), "values");
+  EXPECT_EQ(view.query(), "SELECT ...");
+  EXPECT_EQ(view.cacheKey(), qet->getCacheKey());
+  EXPECT_EQ(view.variableColumns(), qet->getVariableColumns());
+  EXPECT_EQ(view.result().size(), 2u);
+  EXPECT_EQ(view.result().localVocab().size(), 1u);
+  EXPECT_TRUE(view.isValidForIndex(qec->getIndex()));
+  // An index with different triples, but with the same number of triples.
+  auto otherQec =
+      getQec("<a> <p> <b> . <a> <p> <d> . <b> <p> <c> . <c> <q> <a> .");
+  EXPECT_FALSE(view.isValidForIndex(otherQec->getIndex()));
+
+  std::string basename = "materializedViewTest";
+  std::string filename = MaterializedView::getFilename(basename, view.name());
+  EXPECT_EQ(filename, "materializedViewTest.materialized-view.values");
+  view.writeToFile(filename);
+  // The view is written to a temporary file first, which is then renamed.
+  EXPECT_FALSE(std::filesystem::exists(filename + ".tmp"));
+  EXPECT_THAT(MaterializedView::findNames(basename),
+              ::testing::ElementsAre("values"));
+  auto view2 = MaterializedView::readFromFile(filename, makeAllocator());
+  EXPECT_EQ(view2.name(), view.name());
+  EXPECT_EQ(view2.query(), view.query());
+  EXPECT_EQ(view2.cacheKey(), view.cacheKey());
+  EXPECT_EQ(view2.variableColumns(), view.variableColumns());
+  EXPECT_TRUE(view2.isValidForIndex(qec->getIndex()));
+  EXPECT_FALSE(view2.isValidForIndex(otherQec->getIndex()));
+  expectEqualResults(view2.result(), view.result());
+  EXPECT_EQ(view2.toJson(), view.toJson());
+  EXPECT_EQ(view.toJson()["variables"],
+            (std::vector<std::string>{"?x", "?y"}));
+
+  std::filesystem::remove(filename);
+  EXPECT_THAT(MaterializedView::findNames(basename), ::testing::IsEmpty());
+
+  // Only letters, digits, `-`, and `_` are allowed in the names of views.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      MaterializedView::compute("../view", "SELECT ...", *qet),
+      ::testing::HasSubstr("not a valid name"));
+  EXPECT_ANY_THROW(MaterializedView::compute("", "SELECT ...", *qet));
+}
+
+// _____________________________________________________________________________
+TEST(MaterializedView, pinInCache) {
+  auto qec = getQec("<x> <r> <y> . <x> <r> <z> . <y> <r> <z> .");
+  auto makeScan = [qec]() {
+    return ad_utility::makeExecutionTree<IndexScan>(
+        qec, Permutation::Enum::PSO,
+        SparqlTriple{Var{"?s"}, "<r>", Var{"?o"}});
+  };
+  auto scan = makeScan();
+  auto view = MaterializedView::compute("scan", "SELECT ...", *scan);
+  auto& cache = qec->getQueryTreeCache();
+  cache.clearAll();
+  view.pinInCache(cache);
+  EXPECT_EQ(cache.numPinnedEntries(), 1u);
+  // Pinning the same view again replaces the entry.
+  view.pinInCache(cache);
+  EXPECT_EQ(cache.numPinnedEntries(), 1u);
+
+  // A subtree with the same cache key uses the result of the view, also for
+  // the estimates of the query planner.
+  auto scan2 = makeScan();
+  EXPECT_EQ(scan2->getCostEstimate(), 0u);
+  EXPECT_EQ(scan2->getSizeEstimate(), 3u);
+  auto result = scan2->getResult();
+  EXPECT_EQ(result.get(), &view.result());
+  EXPECT_EQ(scan2->getRootOperation()->runtimeInfo().cacheStatus_,
+            ad_utility::CacheStatus::cachedPinned);
+
+  cache.erase(view.cacheKey());
+  EXPECT_EQ(cache.numPinnedEntries(), 0u);
+}
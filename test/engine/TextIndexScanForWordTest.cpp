@@ -124,4 +124,25 @@ TEST(TextIndexScanForWord, KnownEmpty) {
   TextIndexScanForWord s5{qec, Variable{"?text1"}, "testing"};
   ASSERT_TRUE(!s5.knownEmptyResult());
 }
+
+TEST(TextIndexScanForWord, TopKWordPostings) {
+  auto qec = getQec(kg, true, true, true, 16_B, true);
+  const Index& index = qec->getIndex();
+
+  for (std::string term : {"test*", "test", "testing", "sentence"}) {
+    IdTable all = index.getWordPostingsForTerm(term, makeAllocator());
+    auto topK = index.getTopKWordPostingsForTerm(term, 100);
+    ASSERT_EQ(topK.cids_.size(), all.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+      EXPECT_EQ(Id::makeFromTextRecordIndex(topK.cids_[i]), all(i, 0));
+      EXPECT_EQ(Id::makeFromWordVocabIndex(
+                    WordVocabIndex::make(topK.wids_.at(0)[i])),
+                all(i, 1));
+    }
+    EXPECT_EQ(index.getTopKWordPostingsForTerm(term, 1).cids_.size(), 1u);
+    EXPECT_TRUE(index.getTopKWordPostingsForTerm(term, 0).cids_.empty());
+  }
+  EXPECT_TRUE(
+      index.getTopKWordPostingsForTerm("nonExistentWord", 3).cids_.empty());
+}
 }  // namespace
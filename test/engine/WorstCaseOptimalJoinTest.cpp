@@ -0,0 +1,137 @@
+//  Copyright 2024, University of Freiburg,
+//                  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../IndexTestHelpers.h"
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/WorstCaseOptimalJoin.h"
+#include "parser/ParsedQuery.h"
+
+using namespace ad_utility::testing;
+
+namespace {
+using Var = Variable;
+using Edge = std::pair<size_t, size_t>;
+
+std::string iri(size_t i) { return absl::StrCat("<n", i, ">"); }
+
+// A directed graph with `numNodes` nodes and many triangles. The edges are
+// stored with the predicate `<p>`, and all the nodes have a `<label>`.
+std::vector<Edge> makeEdges(size_t numNodes) {
+  std::vector<Edge> edges;
+  for (size_t i = 0; i < numNodes; ++i) {
+    for (size_t offset : {1, 2, 5}) {
+      edges.emplace_back(i, (i + offset) % numNodes);
+    }
+  }
+  return edges;
+}
+
+std::string makeTurtle(const std::vector<Edge>& edges, size_t numNodes) {
+  std::string turtle;
+  for (const auto& [from, to] : edges) {
+    absl::StrAppend(&turtle, iri(from), " <p> ", iri(to), " .\n");
+  }
+  for (size_t i = 0; i < numNodes; ++i) {
+    absl::StrAppend(&turtle, iri(i), " <label> \"", i, "\" .\n");
+  }
+  return turtle;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(WorstCaseOptimalJoin, isSupportedTriple) {
+  auto supported = [](TripleComponent s, std::string p, TripleComponent o) {
+    return WorstCaseOptimalJoin::isSupportedTriple(
+        SparqlTriple{std::move(s), p, std::move(o)});
+  };
+  EXPECT_TRUE(supported(Var{"?x"}, "<p>", Var{"?y"}));
+  EXPECT_FALSE(supported(Var{"?x"}, "<p>", Var{"?x"}));
+  EXPECT_FALSE(supported(Var{"?x"}, "<p>", iri(3)));
+  EXPECT_FALSE(supported(iri(3), "<p>", Var{"?y"}));
+  EXPECT_FALSE(supported(Var{"?x"}, "?p", Var{"?y"}));
+  EXPECT_FALSE(supported(Var{"?x"}, HAS_PREDICATE_PREDICATE, Var{"?y"}));
+}
+
+// _____________________________________________________________________________
+TEST(WorstCaseOptimalJoin, triangles) {
+  const size_t numNodes = 12;
+  auto edges = makeEdges(numNodes);
+  // Small blocks, such that each relation is stored in several blocks.
+  auto qec = getQec(makeTurtle(edges, numNodes), true, true, true, 16_B);
+  auto getId = makeGetId(qec->getIndex());
+
+  WorstCaseOptimalJoin join{qec,
+                            {SparqlTriple{Var{"?x"}, "<p>", Var{"?y"}},
+                             SparqlTriple{Var{"?y"}, "<p>", Var{"?z"}},
+                             SparqlTriple{Var{"?x"}, "<p>", Var{"?z"}}}};
+  EXPECT_EQ(join.getResultWidth(), 3u);
+  EXPECT_EQ(join.getChildren().size(), 3u);
+  EXPECT_THAT(join.getDescriptor(),
+              ::testing::StartsWith("WorstCaseOptimalJoin on "));
+
+  // The triangles computed by brute force, in the column order of the result.
+  const auto& varToCol = join.getExternallyVisibleVariableColumns();
+  std::array<size_t, 3> columns{varToCol.at(Var{"?x"}).columnIndex_,
+                                varToCol.at(Var{"?y"}).columnIndex_,
+                                varToCol.at(Var{"?z"}).columnIndex_};
+  std::set<Edge> edgeSet(edges.begin(), edges.end());
+  std::vector<std::vector<Id>> expected;
+  for (const auto& [x, y] : edges) {
+    for (const auto& [y2, z] : edges) {
+      if (y == y2 && edgeSet.contains({x, z})) {
+        std::vector<Id> row(3);
+        row[columns[0]] = getId(iri(x));
+        row[columns[1]] = getId(iri(y));
+        row[columns[2]] = getId(iri(z));
+        expected.push_back(std::move(row));
+      }
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+  std::ranges::sort(expected);
+
+  auto result = join.getResult();
+  const auto& table = result->idTable();
+  std::vector<std::vector<Id>> actual;
+  for (const auto& row : table) {
+    actual.emplace_back(row.begin(), row.end());
+  }
+  // The result is sorted by all its columns.
+  EXPECT_EQ(actual, expected);
+  EXPECT_EQ(result->sortedBy(), (std::vector<ColumnIndex>{0, 1, 2}));
+
+  // The blocks were read lazily by the children.
+  for (auto* child : join.getChildren()) {
+    const auto& info = child->getRootOperation()->runtimeInfo();
+    EXPECT_EQ(info.status_, RuntimeInformation::Status::lazilyMaterialized);
+    EXPECT_LE(info.details_["num-blocks-read"].get<size_t>(),
+              info.details_["num-blocks-all"].get<size_t>());
+  }
+}
+
+// _____________________________________________________________________________
+TEST(WorstCaseOptimalJoin, emptyResults) {
+  auto qec = getQec("<a> <p> <b> . <b> <p> <c> . <c> <q> <a> .");
+  // There is no triangle.
+  WorstCaseOptimalJoin join{qec,
+                            {SparqlTriple{Var{"?x"}, "<p>", Var{"?y"}},
+                             SparqlTriple{Var{"?y"}, "<p>", Var{"?z"}},
+                             SparqlTriple{Var{"?z"}, "<p>", Var{"?x"}}}};
+  EXPECT_EQ(join.getResult()->idTable().size(), 0u);
+
+  // A predicate that doesn't exist.
+  WorstCaseOptimalJoin join2{qec,
+                             {SparqlTriple{Var{"?x"}, "<p>", Var{"?y"}},
+                              SparqlTriple{Var{"?y"}, "<p>", Var{"?z"}},
+                              SparqlTriple{Var{"?z"}, "<r>", Var{"?x"}}}};
+  EXPECT_EQ(join2.getResult()->idTable().size(), 0u);
+
+  // Unsupported triples are not allowed.
+  EXPECT_ANY_THROW((WorstCaseOptimalJoin{
+      qec, {SparqlTriple{Var{"?x"}, "<p>", TripleComponent{"<a>"}}}}));
+}